@@ -504,6 +504,7 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
                       &tile->shred.adtl_dests_leader[ i ] );
     }
     tile->shred.adtl_dests_leader_cnt = config->tiles.shred.additional_shred_destinations_leader_cnt;
+    tile->shred.net_fanout            = !strcmp( config->net.provider, "xdp" );
 
   } else if( FD_UNLIKELY( !strcmp( tile->name, "store" ) ) ) {
     tile->store.disable_blockstore_from_slot = config->development.bench.disable_blockstore_from_slot;
@@ -10,6 +10,7 @@
 #include "../../../util/pod/fd_pod_format.h"
 #include "../../../discof/restore/utils/fd_ssctrl.h"
 #include "../../../discof/restore/utils/fd_ssmsg.h"
+#include "../../../ballet/lthash/fd_lthash.h"
 #include "../../../flamenco/accdb/fd_accdb_fsck.h"
 #include "../../../funk/fd_funk.h"
 #include "../../../vinyl/fd_vinyl.h"
@@ -71,19 +72,33 @@ snapshot_load_topo( config_t * config ) {
   fd_topo_tile_t * snapdc_tile = fd_topob_tile( topo, "snapdc", "snapdc", "metric_in", ULONG_MAX, 0, 0 );
   snapdc_tile->allow_shutdown = 1;
 
-  /* "snapin": Snapshot parser tile */
+  /* "snapin": Snapshot parser tiles */
+  int vinyl_enabled = config->firedancer.vinyl.enabled;
+  ulong snapin_tile_cnt = config->firedancer.layout.snapin_tile_count;
+  if( FD_UNLIKELY( !snapin_tile_cnt ) ) FD_LOG_ERR(( "[layout.snapin_tile_count] must be non-zero" ));
+  if( FD_UNLIKELY( snapin_tile_cnt>1UL && vinyl_enabled ) ) FD_LOG_ERR(( "[layout.snapin_tile_count] greater than 1 is not supported with [vinyl.enabled]" ));
   fd_topob_wksp( topo, "snapin" );
-  fd_topo_tile_t * snapin_tile = fd_topob_tile( topo, "snapin", "snapin", "metric_in", ULONG_MAX, 0, 0 );
-  snapin_tile->allow_shutdown = 1;
+  for( ulong i=0UL; i<snapin_tile_cnt; i++ ) {
+    fd_topo_tile_t * snapin_tile = fd_topob_tile( topo, "snapin", "snapin", "metric_in", ULONG_MAX, 0, 0 );
+    snapin_tile->allow_shutdown = 1;
+  }
+  fd_topo_tile_t * snapin_tile = &topo->tiles[ fd_topo_find_tile( topo, "snapin", 0UL ) ];
 
   /* "snapwr": Snapshot writer tile */
-  int vinyl_enabled = config->firedancer.vinyl.enabled;
   if( vinyl_enabled ) {
     fd_topob_wksp( topo, "snapwr" );
     fd_topo_tile_t * snapwr_tile = fd_topob_tile( topo, "snapwr", "snapwr", "metric_in", ULONG_MAX, 0, 0 );
     snapwr_tile->allow_shutdown = 1;
   }
 
+  /* "snapla": Accounts lthash tiles */
+  ulong snapla_tile_cnt = ( vinyl_enabled || snapin_tile_cnt>1UL ) ? 0UL : config->firedancer.layout.snapla_tile_count;
+  if( snapla_tile_cnt ) fd_topob_wksp( topo, "snapla" );
+  for( ulong i=0UL; i<snapla_tile_cnt; i++ ) {
+    fd_topo_tile_t * snapla_tile = fd_topob_tile( topo, "snapla", "snapla", "metric_in", ULONG_MAX, 0, 0 );
+    snapla_tile->allow_shutdown = 1;
+  }
+
   fd_topob_wksp( topo, "snapct_ld"    );
   fd_topob_wksp( topo, "snapld_dc"    );
   fd_topob_wksp( topo, "snapdc_in"    );
@@ -91,6 +106,11 @@ snapshot_load_topo( config_t * config ) {
   fd_topob_wksp( topo, "snapin_manif" );
   fd_topob_wksp( topo, "snapct_repr"  );
   if( vinyl_enabled ) fd_topob_wksp( topo, "snapin_wr" );
+  if( snapla_tile_cnt ) {
+    fd_topob_wksp( topo, "snapin_la" );
+    fd_topob_wksp( topo, "snapla_in" );
+  }
+  if( snapin_tile_cnt>1UL ) fd_topob_wksp( topo, "snapin_sh" );
 
   fd_topob_link( topo, "snapct_ld",   "snapct_ld",     128UL,   sizeof(fd_ssctrl_init_t),       1UL );
   fd_topob_link( topo, "snapld_dc",   "snapld_dc",     16384UL, USHORT_MAX,                     1UL );
@@ -101,6 +121,11 @@ snapshot_load_topo( config_t * config ) {
   if( vinyl_enabled ) {
     fd_topob_link( topo, "snapin_wr", "snapin_wr", 4UL, 16UL<<20, 1UL );
   }
+  if( snapla_tile_cnt ) {
+    fd_topob_link( topo, "snapin_la", "snapin_la", 256UL, USHORT_MAX, 1UL );
+    for( ulong i=0UL; i<snapla_tile_cnt; i++ ) fd_topob_link( topo, "snapla_in", "snapla_in", 4UL, sizeof(fd_lthash_value_t), 1UL );
+  }
+  for( ulong i=1UL; i<snapin_tile_cnt; i++ ) fd_topob_link( topo, "snapin_sh", "snapin_sh", 4UL, sizeof(fd_lthash_value_t), 1UL );
 
   fd_topob_tile_in ( topo, "snapct",  0UL, "metric_in", "snapin_ct",    0UL, FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
   fd_topob_tile_in ( topo, "snapct",  0UL, "metric_in", "snapld_dc",    0UL, FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
@@ -110,7 +135,21 @@ snapshot_load_topo( config_t * config ) {
   fd_topob_tile_out( topo, "snapld",  0UL,              "snapld_dc",    0UL                                       );
   fd_topob_tile_in ( topo, "snapdc",  0UL, "metric_in", "snapld_dc",    0UL, FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
   fd_topob_tile_out( topo, "snapdc",  0UL,              "snapdc_in",    0UL                                       );
-  fd_topob_tile_in ( topo, "snapin",  0UL, "metric_in", "snapdc_in",    0UL, FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
+  for( ulong i=0UL; i<snapin_tile_cnt; i++ ) {
+    fd_topob_tile_in ( topo, "snapin", i,   "metric_in", "snapdc_in", 0UL,   FD_TOPOB_RELIABLE, FD_TOPOB_POLLED );
+  }
+  for( ulong i=1UL; i<snapin_tile_cnt; i++ ) {
+    fd_topob_tile_out( topo, "snapin", i,                "snapin_sh", i-1UL                                     );
+    fd_topob_tile_in ( topo, "snapin", 0UL, "metric_in", "snapin_sh", i-1UL, FD_TOPOB_RELIABLE, FD_TOPOB_POLLED );
+  }
+  if( snapla_tile_cnt ) {
+    fd_topob_tile_out( topo, "snapin", 0UL, "snapin_la", 0UL );
+    for( ulong i=0UL; i<snapla_tile_cnt; i++ ) {
+      fd_topob_tile_in ( topo, "snapla", i,   "metric_in", "snapin_la", 0UL, FD_TOPOB_RELIABLE, FD_TOPOB_POLLED );
+      fd_topob_tile_out( topo, "snapla", i,                "snapla_in", i                                       );
+      fd_topob_tile_in ( topo, "snapin", 0UL, "metric_in", "snapla_in", i,   FD_TOPOB_RELIABLE, FD_TOPOB_POLLED );
+    }
+  }
   fd_topob_tile_out( topo, "snapin",  0UL,              "snapin_ct",    0UL                                       );
   fd_topob_tile_out( topo, "snapin",  0UL,              "snapin_manif", 0UL                                       );
   if( vinyl_enabled ) {
@@ -119,10 +158,19 @@ snapshot_load_topo( config_t * config ) {
   }
 
   /* snapin funk / txncache access */
-  fd_topob_tile_uses( topo, snapin_tile, funk_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  for( ulong i=0UL; i<snapin_tile_cnt; i++ ) {
+    fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "snapin", i ) ], funk_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  }
   fd_topob_tile_uses( topo, snapin_tile, txncache_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   snapin_tile->snapin.funk_obj_id     = funk_obj->id;
   snapin_tile->snapin.txncache_obj_id = txncache_obj->id;
+  if( snapin_tile_cnt>1UL ) {
+    fd_topo_obj_t * sync_obj = fd_topob_obj( topo, "fseq", "snapin" );
+    for( ulong i=0UL; i<snapin_tile_cnt; i++ ) {
+      fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "snapin", i ) ], sync_obj, i ? FD_SHMEM_JOIN_MODE_READ_ONLY : FD_SHMEM_JOIN_MODE_READ_WRITE );
+    }
+    FD_TEST( fd_pod_insertf_ulong( topo->props, sync_obj->id, "snapin_sync" ) );
+  }
   if( config->firedancer.vinyl.enabled ) {
     ulong vinyl_map_obj_id  = fd_pod_query_ulong( topo->props, "vinyl.meta_map",  ULONG_MAX ); FD_TEST( vinyl_map_obj_id !=ULONG_MAX );
     ulong vinyl_pool_obj_id = fd_pod_query_ulong( topo->props, "vinyl.meta_pool", ULONG_MAX ); FD_TEST( vinyl_pool_obj_id!=ULONG_MAX );
@@ -641,7 +689,11 @@ snapshot_load_cmd_fn( args_t *   args,
 
     double progress = 100.0 * (double)snapct_metrics[ MIDX( GAUGE, SNAPCT, FULL_BYTES_READ ) ] / (double)snapct_metrics[ MIDX( GAUGE, SNAPCT, FULL_BYTES_TOTAL ) ];
 
-    ulong acc_cnt      = snapin_metrics[ MIDX( GAUGE, SNAPIN, ACCOUNTS_INSERTED    ) ];
+    ulong acc_cnt      = 0UL;
+    for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+      if( strcmp( topo->tiles[ i ].name, "snapin" ) ) continue;
+      acc_cnt += fd_metrics_tile( topo->tiles[ i ].metrics )[ MIDX( GAUGE, SNAPIN, ACCOUNTS_INSERTED ) ];
+    }
 
     if( watch ) {
       printf( "%5.1f %% comp=%4.0fMB/s snap=%4.0fMB/s",
@@ -24,6 +24,7 @@ extern fd_topo_obj_callbacks_t fd_obj_cb_fec_sets;
 extern fd_topo_obj_callbacks_t fd_obj_cb_txncache;
 extern fd_topo_obj_callbacks_t fd_obj_cb_banks;
 extern fd_topo_obj_callbacks_t fd_obj_cb_funk;
+extern fd_topo_obj_callbacks_t fd_obj_cb_progcache_warm;
 extern fd_topo_obj_callbacks_t fd_obj_cb_bank_hash_cmp;
 
 extern fd_topo_obj_callbacks_t fd_obj_cb_vinyl_meta;
@@ -47,6 +48,7 @@ fd_topo_obj_callbacks_t * CALLBACKS[] = {
   &fd_obj_cb_txncache,
   &fd_obj_cb_banks,
   &fd_obj_cb_funk,
+  &fd_obj_cb_progcache_warm,
   &fd_obj_cb_bank_hash_cmp,
   &fd_obj_cb_vinyl_meta,
   &fd_obj_cb_vinyl_meta_ele,
@@ -117,6 +119,7 @@ extern fd_topo_run_tile_t fd_tile_snapld;
 extern fd_topo_run_tile_t fd_tile_snapdc;
 extern fd_topo_run_tile_t fd_tile_snapin;
 extern fd_topo_run_tile_t fd_tile_snapwr;
+extern fd_topo_run_tile_t fd_tile_snapla;
 
 fd_topo_run_tile_t * TILES[] = {
   &fd_tile_net,
@@ -164,6 +167,7 @@ fd_topo_run_tile_t * TILES[] = {
   &fd_tile_snapdc,
   &fd_tile_snapin,
   &fd_tile_snapwr,
+  &fd_tile_snapla,
   &fd_tile_genesi,
   &fd_tile_ipecho,
   &fd_tile_vinyl,
@@ -5,6 +5,12 @@
 #include "../../flamenco/runtime/fd_bank.h"
 #include "../../flamenco/runtime/fd_runtime.h"
 #include "../../flamenco/runtime/fd_txncache_shmem.h"
+#include "../../flamenco/progcache/fd_progcache_warm.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 #define VAL(name) (__extension__({                                                             \
   ulong __x = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "obj.%lu.%s", obj->id, name );      \
@@ -102,6 +108,90 @@ fd_topo_obj_callbacks_t fd_obj_cb_funk = {
   .new       = funk_new,
 };
 
+/* progcache_warm: program cache warm start store, loaded from disk on
+   boot and saved back with the contents of the program cache on
+   shutdown */
+
+static ulong
+progcache_warm_align( fd_topo_t const *     topo,
+                      fd_topo_obj_t const * obj ) {
+  (void)topo; (void)obj;
+  return fd_progcache_warm_align();
+}
+
+static ulong
+progcache_warm_footprint( fd_topo_t const *     topo,
+                          fd_topo_obj_t const * obj ) {
+  return fd_progcache_warm_footprint( VAL("entry_max"), VAL("data_max") );
+}
+
+static void
+progcache_warm_new( fd_topo_t const *     topo,
+                    fd_topo_obj_t const * obj ) {
+  fd_progcache_warm_t * warm = fd_progcache_warm_join( fd_progcache_warm_new( fd_topo_obj_laddr( topo, obj->id ), VAL("entry_max"), VAL("data_max") ) );
+  FD_TEST( warm );
+
+  char const * path = fd_pod_queryf_cstr( topo->props, NULL, "obj.%lu.path", obj->id );
+  FD_TEST( path );
+  int fd = open( path, O_RDONLY|O_CLOEXEC );
+  if( FD_UNLIKELY( -1==fd ) ) {
+    if( FD_LIKELY( errno==ENOENT ) ) FD_LOG_NOTICE(( "program cache warm start file `%s` does not exist, starting cold", path ));
+    else                             FD_LOG_WARNING(( "open(%s) failed (%i-%s), starting cold", path, errno, fd_io_strerror( errno ) ));
+  } else {
+    ulong load_cnt = fd_progcache_warm_load( warm, fd );
+    FD_LOG_NOTICE(( "loaded %lu programs from program cache warm start file `%s`", load_cnt, path ));
+    if( FD_UNLIKELY( -1==close( fd ) ) ) FD_LOG_ERR(( "close(%s) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+  }
+
+  FD_TEST( fd_progcache_warm_leave( warm ) );
+}
+
+static int
+progcache_warm_save_fd( fd_topo_t const *     topo,
+                        fd_topo_obj_t const * obj ) {
+  /* Not truncated until saved, so the file survives a crash */
+  char const * path = fd_pod_queryf_cstr( topo->props, NULL, "obj.%lu.path", obj->id );
+  FD_TEST( path );
+  int fd = open( path, O_WRONLY|O_CREAT|O_CLOEXEC, S_IRUSR|S_IWUSR );
+  if( FD_UNLIKELY( -1==fd ) ) {
+    FD_LOG_WARNING(( "open(%s) failed (%i-%s), program cache will not be saved on shutdown", path, errno, fd_io_strerror( errno ) ));
+  }
+  return fd;
+}
+
+static void
+progcache_warm_save( fd_topo_t const *     topo,
+                     fd_topo_obj_t const * obj,
+                     int                   fd ) {
+  fd_progcache_admin_t cache[1];
+  FD_TEST( fd_progcache_admin_join( cache, fd_topo_obj_laddr( topo, VAL("progcache") ) ) );
+
+  ulong save_cnt;
+  int   err = fd_progcache_warm_save( cache, fd, &save_cnt );
+  if( FD_LIKELY( !err ) ) {
+    long sz = lseek( fd, 0L, SEEK_CUR );
+    if( FD_UNLIKELY( -1L==sz || -1==ftruncate( fd, sz ) ) ) {
+      FD_LOG_WARNING(( "failed to truncate program cache warm start file (%i-%s)", errno, fd_io_strerror( errno ) ));
+    } else {
+      FD_LOG_NOTICE(( "saved %lu programs to program cache warm start file", save_cnt ));
+    }
+  } else if( FD_UNLIKELY( -1==ftruncate( fd, 0L ) ) ) {
+    /* Don't leave a partial file with a stale header behind */
+    FD_LOG_WARNING(( "failed to truncate program cache warm start file (%i-%s)", errno, fd_io_strerror( errno ) ));
+  }
+
+  fd_progcache_admin_leave( cache, NULL );
+}
+
+fd_topo_obj_callbacks_t fd_obj_cb_progcache_warm = {
+  .name      = "progcache_warm",
+  .footprint = progcache_warm_footprint,
+  .align     = progcache_warm_align,
+  .new       = progcache_warm_new,
+  .save_fd   = progcache_warm_save_fd,
+  .save      = progcache_warm_save,
+};
+
 /* cnc: a tile admin message queue */
 
 static ulong
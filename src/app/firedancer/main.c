@@ -21,6 +21,7 @@ extern fd_topo_obj_callbacks_t fd_obj_cb_fec_sets;
 extern fd_topo_obj_callbacks_t fd_obj_cb_txncache;
 extern fd_topo_obj_callbacks_t fd_obj_cb_banks;
 extern fd_topo_obj_callbacks_t fd_obj_cb_funk;
+extern fd_topo_obj_callbacks_t fd_obj_cb_progcache_warm;
 extern fd_topo_obj_callbacks_t fd_obj_cb_bank_hash_cmp;
 
 fd_topo_obj_callbacks_t * CALLBACKS[] = {
@@ -39,6 +40,7 @@ fd_topo_obj_callbacks_t * CALLBACKS[] = {
   &fd_obj_cb_txncache,
   &fd_obj_cb_banks,
   &fd_obj_cb_funk,
+  &fd_obj_cb_progcache_warm,
   &fd_obj_cb_bank_hash_cmp,
   NULL,
 };
@@ -91,6 +93,7 @@ extern fd_topo_run_tile_t fd_tile_snapld;
 extern fd_topo_run_tile_t fd_tile_snapdc;
 extern fd_topo_run_tile_t fd_tile_snapin;
 extern fd_topo_run_tile_t fd_tile_snapwr;
+extern fd_topo_run_tile_t fd_tile_snapla;
 
 fd_topo_run_tile_t * TILES[] = {
   &fd_tile_net,
@@ -123,6 +126,7 @@ fd_topo_run_tile_t * TILES[] = {
   &fd_tile_snapdc,
   &fd_tile_snapin,
   &fd_tile_snapwr,
+  &fd_tile_snapla,
   &fd_tile_genesi,
   &fd_tile_ipecho,
   NULL,
@@ -22,6 +22,7 @@
 #include "../../discof/restore/utils/fd_ssctrl.h"
 #include "../../discof/restore/utils/fd_ssmsg.h"
 #include "../../flamenco/progcache/fd_progcache_admin.h"
+#include "../../flamenco/progcache/fd_progcache_warm.h"
 #include "../../vinyl/meta/fd_vinyl_meta.h"
 
 #include <sys/random.h>
@@ -133,6 +134,26 @@ setup_topo_progcache( fd_topo_t *  topo,
   return obj;
 }
 
+fd_topo_obj_t *
+setup_topo_progcache_warm( fd_topo_t *           topo,
+                           char const *          wksp_name,
+                           fd_topo_obj_t const * progcache_obj,
+                           ulong                 max_entries,
+                           ulong                 max_data_sz,
+                           char const *          path ) {
+  fd_topo_obj_t * obj = fd_topob_obj( topo, "progcache_warm", wksp_name );
+  if( FD_UNLIKELY( obj->wksp_id!=progcache_obj->wksp_id ) ) FD_LOG_ERR(( "progcache_warm must be in the same wksp as progcache" ));
+  FD_TEST( fd_pod_insert_ulong(  topo->props, "progcache_warm", obj->id ) );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, progcache_obj->id, "obj.%lu.progcache", obj->id ) );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, max_entries,       "obj.%lu.entry_max", obj->id ) );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, max_data_sz,       "obj.%lu.data_max",  obj->id ) );
+  FD_TEST( fd_pod_insertf_cstr(  topo->props, path,              "obj.%lu.path",      obj->id ) );
+  if( FD_UNLIKELY( !fd_progcache_warm_footprint( max_entries, max_data_sz ) ) ) {
+    FD_LOG_ERR(( "Invalid [runtime.program_cache] parameters: warm_start_size_mib is too small" ));
+  }
+  return obj;
+}
+
 fd_topo_obj_t *
 setup_topo_store( fd_topo_t *  topo,
                   char const * wksp_name,
@@ -281,6 +302,13 @@ fd_topo_initialize( config_t * config ) {
 
   int snapshots_enabled = !!config->gossip.entrypoints_cnt;
   int vinyl_enabled     = !!config->firedancer.vinyl.enabled;
+  ulong snapin_tile_cnt = config->firedancer.layout.snapin_tile_count;
+  /* Streaming lthash verification needs to read back replaced account
+     versions, which is only supported with funk.  Sharded snapin tiles
+     verify the lthash inline instead. */
+  ulong snapla_tile_cnt = ( vinyl_enabled || snapin_tile_cnt>1UL ) ? 0UL : config->firedancer.layout.snapla_tile_count;
+  if( FD_UNLIKELY( !snapin_tile_cnt ) ) FD_LOG_ERR(( "[layout.snapin_tile_count] must be non-zero" ));
+  if( FD_UNLIKELY( snapin_tile_cnt>1UL && vinyl_enabled ) ) FD_LOG_ERR(( "[layout.snapin_tile_count] greater than 1 is not supported with [vinyl.enabled]" ));
 
   fd_topo_t * topo = fd_topob_new( &config->topo, config->name );
 
@@ -374,12 +402,18 @@ fd_topo_initialize( config_t * config ) {
     fd_topob_wksp( topo, "snapdc"      );
     fd_topob_wksp( topo, "snapin"      );
     if( vinyl_enabled ) fd_topob_wksp( topo, "snapwr" );
+    if( snapla_tile_cnt ) fd_topob_wksp( topo, "snapla" );
 
     fd_topob_wksp( topo, "snapct_ld"   );
     fd_topob_wksp( topo, "snapld_dc"   );
     fd_topob_wksp( topo, "snapdc_in"   );
     fd_topob_wksp( topo, "snapin_ct"   );
     if( vinyl_enabled ) fd_topob_wksp( topo, "snapin_wr" );
+    if( snapla_tile_cnt ) {
+      fd_topob_wksp( topo, "snapin_la" );
+      fd_topob_wksp( topo, "snapla_in" );
+    }
+    if( snapin_tile_cnt>1UL ) fd_topob_wksp( topo, "snapin_sh" );
 
     if( FD_LIKELY( config->tiles.gui.enabled ) ) fd_topob_wksp( topo, "snapct_gui"  );
     if( FD_LIKELY( config->tiles.gui.enabled ) ) fd_topob_wksp( topo, "snapin_gui"  );
@@ -415,6 +449,11 @@ fd_topo_initialize( config_t * config ) {
     if( vinyl_enabled ) {
       /**/             fd_topob_link( topo, "snapin_wr",    "snapin_wr",    4UL,                                      16UL<<20,                      1UL );
     }
+    if( snapla_tile_cnt ) {
+      /**/             fd_topob_link( topo, "snapin_la",    "snapin_la",    256UL,                                    USHORT_MAX,                    1UL );
+      FOR(snapla_tile_cnt) fd_topob_link( topo, "snapla_in", "snapla_in",   4UL,                                      sizeof(fd_lthash_value_t),     1UL );
+    }
+    FOR(snapin_tile_cnt-1UL) fd_topob_link( topo, "snapin_sh", "snapin_sh", 4UL,                                      sizeof(fd_lthash_value_t),     1UL );
   }
 
   /**/                 fd_topob_link( topo, "genesi_out",   "genesi_out",   2UL,                                      10UL*1024UL*1024UL+32UL+sizeof(fd_lthash_value_t), 1UL );
@@ -426,7 +465,7 @@ fd_topo_initialize( config_t * config ) {
   FOR(quic_tile_cnt)   fd_topob_link( topo, "quic_verify",  "quic_verify",  config->tiles.verify.receive_buffer_size, FD_TPU_REASM_MTU,              config->tiles.quic.txn_reassembly_count );
   FOR(verify_tile_cnt) fd_topob_link( topo, "verify_dedup", "verify_dedup", config->tiles.verify.receive_buffer_size, FD_TPU_PARSED_MTU,             1UL );
   /**/                 fd_topob_link( topo, "dedup_resolv", "dedup_resolv", 65536UL,                                  FD_TPU_PARSED_MTU,             1UL );
-  FOR(resolv_tile_cnt) fd_topob_link( topo, "resolv_pack",  "resolv_pack",  65536UL,                                  FD_TPU_RESOLVED_MTU,           1UL );
+  FOR(resolv_tile_cnt) fd_topob_link( topo, "resolv_pack",  "resolv_pack",  65536UL,                                  FD_TPU_RESOLVED_MTU,           FD_RESOLV_BATCH_MAX );
   /**/                 fd_topob_link( topo, "replay_stake", "replay_stake", 128UL,                                    FD_STAKE_OUT_MTU,              1UL ); /* TODO: This should be 2 but requires fixing STEM_BURST */
   /**/                 fd_topob_link( topo, "replay_out",   "replay_out",   8192UL,                                   sizeof(fd_replay_message_t),   1UL );
   /**/                 fd_topob_link( topo, "pack_poh",     "pack_poh",     128UL,                                    sizeof(fd_done_packing_t),     1UL );
@@ -499,8 +538,9 @@ fd_topo_initialize( config_t * config ) {
     /**/               fd_topob_tile( topo, "snapct", "snapct", "metric_in", tile_to_cpu[ topo->tile_cnt ],    0,        0 )->allow_shutdown = 1;
     /**/               fd_topob_tile( topo, "snapld", "snapld", "metric_in", tile_to_cpu[ topo->tile_cnt ],    0,        0 )->allow_shutdown = 1;
     /**/               fd_topob_tile( topo, "snapdc", "snapdc", "metric_in", tile_to_cpu[ topo->tile_cnt ],    0,        0 )->allow_shutdown = 1;
-    /**/               fd_topob_tile( topo, "snapin", "snapin", "metric_in", tile_to_cpu[ topo->tile_cnt ],    0,        0 )->allow_shutdown = 1;
+    FOR(snapin_tile_cnt) fd_topob_tile( topo, "snapin", "snapin", "metric_in", tile_to_cpu[ topo->tile_cnt ],  0,        0 )->allow_shutdown = 1;
     if(vinyl_enabled)  fd_topob_tile( topo, "snapwr", "snapwr", "metric_in", tile_to_cpu[ topo->tile_cnt ],    0,        0 )->allow_shutdown = 1;
+    FOR(snapla_tile_cnt) fd_topob_tile( topo, "snapla", "snapla", "metric_in", tile_to_cpu[ topo->tile_cnt ],  0,        0 )->allow_shutdown = 1;
   }
 
   /**/                 fd_topob_tile( topo, "genesi",  "genesi",  "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        0 )->allow_shutdown = 1;
@@ -583,7 +623,16 @@ fd_topo_initialize( config_t * config ) {
     /**/              fd_topob_tile_in (    topo, "snapdc",  0UL,          "metric_in", "snapld_dc",    0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
     /**/              fd_topob_tile_out(    topo, "snapdc",  0UL,                       "snapdc_in",    0UL                                                );
 
-    /**/              fd_topob_tile_in (    topo, "snapin",  0UL,          "metric_in", "snapdc_in",    0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
+    FOR(snapin_tile_cnt) fd_topob_tile_in ( topo, "snapin",  i,            "metric_in", "snapdc_in",    0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
+    /* Other snapin shards ack control messages to snapin 0 */
+    FOR(snapin_tile_cnt-1UL) fd_topob_tile_out( topo, "snapin", i+1UL,                    "snapin_sh",    i                                                  );
+    FOR(snapin_tile_cnt-1UL) fd_topob_tile_in ( topo, "snapin", 0UL,           "metric_in", "snapin_sh",    i,            FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
+    if( snapla_tile_cnt ) {
+      /**/            fd_topob_tile_out(    topo, "snapin",  0UL,                       "snapin_la",    0UL                                                );
+      FOR(snapla_tile_cnt) fd_topob_tile_in ( topo, "snapla",  i,            "metric_in", "snapin_la",    0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
+      FOR(snapla_tile_cnt) fd_topob_tile_out( topo, "snapla",  i,                         "snapla_in",    i                                                  );
+      FOR(snapla_tile_cnt) fd_topob_tile_in ( topo, "snapin",  0UL,          "metric_in", "snapla_in",    i,            FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
+    }
     /**/              fd_topob_tile_out(    topo, "snapin",  0UL,                       "snapin_ct",    0UL                                                );
     /**/              fd_topob_tile_out(    topo, "snapin",  0UL,                       "snapin_manif", 0UL                                                );
     if( FD_LIKELY( config->tiles.gui.enabled ) ) {
@@ -842,6 +891,18 @@ fd_topo_initialize( config_t * config ) {
   FOR(exec_tile_cnt)   fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "exec",   i   ) ], progcache_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   FOR(bank_tile_cnt)   fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "bank",   i   ) ], progcache_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
 
+  if( FD_UNLIKELY( strcmp( config->firedancer.runtime.program_cache.warm_start_path, "" ) ) ) {
+    /* The warm store lives next to the program cache, so the
+       supervisor can save the cache while joined to a single wksp. */
+    fd_topo_obj_t * progcache_warm_obj = setup_topo_progcache_warm( topo, "progcache", progcache_obj,
+        fd_progcache_est_rec_max( config->firedancer.runtime.program_cache.warm_start_size_mib<<20,
+                                  config->firedancer.runtime.program_cache.mean_cache_entry_size ),
+        config->firedancer.runtime.program_cache.warm_start_size_mib<<20,
+        config->firedancer.runtime.program_cache.warm_start_path );
+    FOR(exec_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "exec", i ) ], progcache_warm_obj, FD_SHMEM_JOIN_MODE_READ_ONLY );
+    FOR(bank_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "bank", i ) ], progcache_warm_obj, FD_SHMEM_JOIN_MODE_READ_ONLY );
+  }
+
   if( FD_LIKELY( config->tiles.gui.enabled ) ) {
     fd_topob_wksp( topo, "gui" );
 
@@ -909,10 +970,21 @@ fd_topo_initialize( config_t * config ) {
   }
   FOR(bank_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "bank", i ) ], txncache_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   FOR(exec_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "exec", i ) ], txncache_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  /* resolv only queries, but queries take the (shared memory) lock */
+  FOR(resolv_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "resolv", i ) ], txncache_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   FD_TEST( fd_pod_insertf_ulong( topo->props, txncache_obj->id, "txncache" ) );
 
   fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "genesi", 0UL ) ], funk_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
-  if( FD_LIKELY( snapshots_enabled ) ) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "snapin", 0UL ) ], funk_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  if( FD_LIKELY( snapshots_enabled ) ) {
+    FOR(snapin_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "snapin", i ) ], funk_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+    if( snapin_tile_cnt>1UL ) {
+      /* snapin 0 signals other shards when it completed processing a
+         control message, see fd_snapin_tile_private.h */
+      fd_topo_obj_t * sync_obj = fd_topob_obj( topo, "fseq", "snapin" );
+      FOR(snapin_tile_cnt) fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "snapin", i ) ], sync_obj, i ? FD_SHMEM_JOIN_MODE_READ_ONLY : FD_SHMEM_JOIN_MODE_READ_WRITE );
+      FD_TEST( fd_pod_insertf_ulong( topo->props, sync_obj->id, "snapin_sync" ) );
+    }
+  }
 
   if( FD_UNLIKELY( rpc_enabled ) ) {
     fd_topob_tile_uses( topo, &topo->tiles[ fd_topo_find_tile( topo, "rpcsrv", 0UL ) ], funk_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
@@ -1018,6 +1090,10 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
     tile->snapct.max_full_snapshots_to_keep           = config->firedancer.snapshots.max_full_snapshots_to_keep;
     tile->snapct.max_incremental_snapshots_to_keep    = config->firedancer.snapshots.max_incremental_snapshots_to_keep;
     tile->snapct.full_effective_age_cancel_threshold  = config->firedancer.snapshots.full_effective_age_cancel_threshold;
+    tile->snapct.download_peer_cnt                    = config->firedancer.snapshots.download_peer_count;
+    if( FD_UNLIKELY( !tile->snapct.download_peer_cnt || tile->snapct.download_peer_cnt>FD_SSCTRL_ALT_MAX+1UL ) ) {
+      FD_LOG_ERR(( "[snapshots.download_peer_count] must be in [1,%lu]", FD_SSCTRL_ALT_MAX+1UL ));
+    }
     tile->snapct.sources.gossip.allow_any             = config->firedancer.snapshots.sources.gossip.allow_any;
     tile->snapct.sources.gossip.allow_list_cnt        = config->firedancer.snapshots.sources.gossip.allow_list_cnt;
     tile->snapct.sources.gossip.block_list_cnt        = config->firedancer.snapshots.sources.gossip.block_list_cnt;
@@ -1066,6 +1142,8 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
 
     strcpy( tile->snapwr.vinyl_path, config->paths.accounts );
 
+  } else if( FD_UNLIKELY( !strcmp( tile->name, "snapla" ) ) ) {
+
   } else if( FD_UNLIKELY( !strcmp( tile->name, "repair" ) ) ) {
     tile->repair.max_pending_shred_sets    = config->tiles.shred.max_pending_shred_sets;
     tile->repair.repair_intake_listen_port = config->tiles.repair.repair_intake_listen_port;
@@ -1130,6 +1208,7 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
     tile->exec.funk_obj_id      = fd_pod_query_ulong( config->topo.props, "funk",      ULONG_MAX ); FD_TEST( tile->exec.funk_obj_id     !=ULONG_MAX );
     tile->exec.txncache_obj_id  = fd_pod_query_ulong( config->topo.props, "txncache",  ULONG_MAX ); FD_TEST( tile->exec.txncache_obj_id !=ULONG_MAX );
     tile->exec.progcache_obj_id = fd_pod_query_ulong( config->topo.props, "progcache", ULONG_MAX ); FD_TEST( tile->exec.progcache_obj_id!=ULONG_MAX );
+    tile->exec.progcache_warm_obj_id = fd_pod_query_ulong( config->topo.props, "progcache_warm", ULONG_MAX );
 
     tile->exec.max_live_slots = config->firedancer.runtime.max_live_slots;
 
@@ -1175,7 +1254,9 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
 
   } else if( FD_UNLIKELY( !strcmp( tile->name, "resolv" ) ) ) {
 
-    tile->resolv.funk_obj_id = fd_pod_query_ulong( config->topo.props, "funk", ULONG_MAX );
+    tile->resolv.funk_obj_id     = fd_pod_query_ulong( config->topo.props, "funk",     ULONG_MAX );
+    tile->resolv.txncache_obj_id = fd_pod_query_ulong( config->topo.props, "txncache", ULONG_MAX );
+    tile->resolv.max_live_slots  = config->firedancer.runtime.max_live_slots;
 
   } else if( FD_UNLIKELY( !strcmp( tile->name, "pack" ) ) ) {
 
@@ -1203,6 +1284,7 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
     tile->bank.txncache_obj_id  = fd_pod_query_ulong( config->topo.props, "txncache",  ULONG_MAX );
     tile->bank.funk_obj_id      = fd_pod_query_ulong( config->topo.props, "funk",      ULONG_MAX );
     tile->bank.progcache_obj_id = fd_pod_query_ulong( config->topo.props, "progcache", ULONG_MAX );
+    tile->bank.progcache_warm_obj_id = fd_pod_query_ulong( config->topo.props, "progcache_warm", ULONG_MAX );
 
     tile->bank.max_live_slots = config->firedancer.runtime.max_live_slots;
 
@@ -1244,6 +1326,7 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
                       &tile->shred.adtl_dests_leader[ i ] );
     }
     tile->shred.adtl_dests_leader_cnt = config->tiles.shred.additional_shred_destinations_leader_cnt;
+    tile->shred.net_fanout            = !strcmp( config->net.provider, "xdp" );
 
   } else if( FD_UNLIKELY( !strcmp( tile->name, "sign" ) ) ) {
 
@@ -1276,6 +1359,7 @@ fd_topo_configure_tile( fd_topo_tile_t * tile,
       FD_LOG_ERR(( "failed to parse rpc listen address `%s`", config->tiles.rpc.rpc_listen_address ));
     tile->rpc.listen_port = config->tiles.rpc.rpc_listen_port;
     tile->rpc.max_http_connections      = config->tiles.rpc.max_http_connections;
+    tile->rpc.max_websocket_connections = config->tiles.rpc.max_websocket_connections;
     tile->rpc.max_http_request_length   = config->tiles.rpc.max_http_request_length;
     tile->rpc.send_buffer_size_mb       = config->tiles.rpc.send_buffer_size_mb;
 
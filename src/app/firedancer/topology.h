@@ -37,6 +37,14 @@ setup_topo_progcache( fd_topo_t *  topo,
                       ulong        max_database_transactions,
                       ulong        heap_size_gib );
 
+fd_topo_obj_t *
+setup_topo_progcache_warm( fd_topo_t *           topo,
+                           char const *          wksp_name,
+                           fd_topo_obj_t const * progcache_obj,
+                           ulong                 max_entries,
+                           ulong                 max_data_sz,
+                           char const *          path );
+
 fd_topo_obj_t *
 setup_topo_store( fd_topo_t *  topo,
                   char const * wksp_name,
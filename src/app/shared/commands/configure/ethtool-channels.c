@@ -9,6 +9,12 @@
 
 #define NAME "ethtool-channels"
 
+/* RSS queue modes, see net.xdp.rss_queue_mode */
+
+#define MODE_SIMPLE    (0)
+#define MODE_DEDICATED (1)
+#define MODE_STEERED   (2)
+
 static int
 enabled( fd_config_t const * config ) {
 
@@ -75,15 +81,45 @@ device_read_slaves( char const * device,
   FD_TEST( devices[ 0 ]!=NULL );
 }
 
-/* Attempts to initialize the device in simple or dedicated mode.  If
-   strict is true, FD_LOG_ERR's on failure.  Otherwise, returns 1 on
-   failure. Returns 0 on success. */
+/* ntuple_ports writes the UDP destination ports that are steered to
+   queue 0 in the given mode to ports.  Returns the number of ports.
+
+   In dedicated mode, this is every port that Firedancer listens on.  In
+   steered mode, this is only the consensus critical ports (turbine,
+   repair, gossip), such that transaction traffic (which is shared
+   between the other queues by RSS) cannot cause drops on queue 0.
+
+   FIXME Centrally define listen port list to avoid this configure stage
+   from going out of sync with port mappings. */
+static uint
+ntuple_ports( fd_config_t const * config,
+              int                 mode,
+              ushort              ports[ 32 ] ) {
+  uint num_ports = 0;
+  if( mode==MODE_SIMPLE ) return 0;
+  ports[ num_ports++ ] = config->tiles.shred.shred_listen_port;
+  if( mode==MODE_DEDICATED ) {
+    ports[ num_ports++ ] = config->tiles.quic.quic_transaction_listen_port;
+    ports[ num_ports++ ] = config->tiles.quic.regular_transaction_listen_port;
+  }
+  if( config->is_firedancer ) {
+    ports[ num_ports++ ] = config->gossip.port;
+    ports[ num_ports++ ] = config->tiles.repair.repair_intake_listen_port;
+    ports[ num_ports++ ] = config->tiles.repair.repair_serve_listen_port;
+    if( mode==MODE_DEDICATED ) ports[ num_ports++ ] = config->tiles.send.send_src_port;
+  }
+  return num_ports;
+}
+
+/* Attempts to initialize the device in simple, dedicated, or steered
+   mode.  If strict is true, FD_LOG_ERR's on failure.  Otherwise,
+   returns 1 on failure. Returns 0 on success. */
 static int
 init_device( char const *        device,
              fd_config_t const * config,
-             int                 dedicated_mode,
+             int                 mode,
              int                 strict ) {
-  FD_TEST( dedicated_mode || strict );
+  FD_TEST( mode==MODE_DEDICATED || strict );
 
   fd_ethtool_ioctl_t ioc __attribute__((cleanup(fd_ethtool_ioctl_fini)));
   if( FD_UNLIKELY( &ioc != fd_ethtool_ioctl_init( &ioc, device ) ) )
@@ -92,7 +128,7 @@ init_device( char const *        device,
   /* This should happen first, otherwise changing the number of channels may fail */
   FD_TEST( 0==fd_ethtool_ioctl_rxfh_set_default( &ioc ) );
 
-  uint const num_channels = !dedicated_mode ? config->layout.net_tile_count : 0 /* maximum allowed */;
+  uint const num_channels = mode!=MODE_DEDICATED ? config->layout.net_tile_count : 0 /* maximum allowed */;
   int ret = fd_ethtool_ioctl_channels_set_num( &ioc, num_channels );
   if( FD_UNLIKELY( 0!=ret ) ) {
     if( strict ) {
@@ -110,8 +146,11 @@ init_device( char const *        device,
 
   FD_TEST( 0==fd_ethtool_ioctl_ntuple_clear( &ioc ) );
 
-  if( dedicated_mode ) {
-    /* Remove queue 0 from the rxfh table.  This queue is dedicated for xdp. */
+  if( mode!=MODE_SIMPLE ) {
+    /* Remove queue 0 from the rxfh table.  In dedicated mode, this
+       queue is dedicated for xdp.  In steered mode, this queue is
+       dedicated for consensus traffic, and the other net tiles' queues
+       take all other traffic. */
     if( FD_UNLIKELY( 0!=fd_ethtool_ioctl_rxfh_set_suffix( &ioc, 1 ) ) ) {
       if( strict ) FD_LOG_ERR(( "error configuring network device (%s), failed to isolate queue zero. Try `net.xdp.rss_queue_mode=\"simple\"`", device ));
       else         return 1;
@@ -122,19 +161,11 @@ init_device( char const *        device,
       else         return 1;
     }
 
-    /* FIXME Centrally define listen port list to avoid this configure
-       stage from going out of sync with port mappings. */
-    uint rule_idx = 0;
-    int error =
-         ( 0!=fd_ethtool_ioctl_ntuple_set_udp_dport( &ioc, rule_idx++, config->tiles.shred.shred_listen_port, 0 ) )
-      || ( 0!=fd_ethtool_ioctl_ntuple_set_udp_dport( &ioc, rule_idx++, config->tiles.quic.quic_transaction_listen_port, 0 ) )
-      || ( 0!=fd_ethtool_ioctl_ntuple_set_udp_dport( &ioc, rule_idx++, config->tiles.quic.regular_transaction_listen_port, 0 ) );
-    if( !error && config->is_firedancer ) {
-      error =
-           ( 0!=fd_ethtool_ioctl_ntuple_set_udp_dport( &ioc, rule_idx++, config->gossip.port, 0 ) )
-        || ( 0!=fd_ethtool_ioctl_ntuple_set_udp_dport( &ioc, rule_idx++, config->tiles.repair.repair_intake_listen_port, 0 ) )
-        || ( 0!=fd_ethtool_ioctl_ntuple_set_udp_dport( &ioc, rule_idx++, config->tiles.repair.repair_serve_listen_port, 0 ) )
-        || ( 0!=fd_ethtool_ioctl_ntuple_set_udp_dport( &ioc, rule_idx++, config->tiles.send.send_src_port, 0 ) );
+    ushort ports[ 32 ];
+    uint   num_ports = ntuple_ports( config, mode, ports );
+    int    error     = 0;
+    for( uint rule_idx=0U; !error && rule_idx<num_ports; rule_idx++ ) {
+      error = ( 0!=fd_ethtool_ioctl_ntuple_set_udp_dport( &ioc, rule_idx, ports[ rule_idx ], 0 ) );
     }
     if( FD_UNLIKELY( error ) ) {
       if( strict ) FD_LOG_ERR(( "error configuring network device (%s), failed to install ntuple rules. Try `net.xdp.rss_queue_mode=\"simple\"`", device ));
@@ -151,8 +182,12 @@ init( fd_config_t const * config ) {
     (0==strcmp( config->net.xdp.rss_queue_mode, "dedicated" ));
   int try_dedicated = only_dedicated ||
     (0==strcmp( config->net.xdp.rss_queue_mode, "auto" ) && 1UL==config->layout.net_tile_count );
+  int steered =
+    (0==strcmp( config->net.xdp.rss_queue_mode, "steered" ));
   if( FD_UNLIKELY( only_dedicated && 1UL!=config->layout.net_tile_count ) )
     FD_LOG_ERR(( "`layout.net_tile_count` must be 1 when `net.xdp.rss_queue_mode` is \"dedicated\"" ));
+  if( FD_UNLIKELY( steered && config->layout.net_tile_count<2UL ) )
+    FD_LOG_ERR(( "`layout.net_tile_count` must be at least 2 when `net.xdp.rss_queue_mode` is \"steered\"" ));
 
   /* if using a bonded device, we need to set channels on the
      underlying devices. */
@@ -161,6 +196,19 @@ init( fd_config_t const * config ) {
   char const * bond_devices[ 16 ];
   if( is_bonded ) device_read_slaves( config->net.interface, line, bond_devices );
 
+  /* Steered mode is never attempted automatically, and requires
+     success. */
+  if( steered ) {
+    if( is_bonded ) {
+      for( ulong i=0UL; bond_devices[ i ]!=NULL; i++ ) {
+        init_device( bond_devices[ i ], config, MODE_STEERED, 1 );
+      }
+    } else {
+      init_device( config->net.interface, config, MODE_STEERED, 1 );
+    }
+    return;
+  }
+
   /* If the mode was auto, we will try to init in dedicated mode but will
      not fail the stage if this is not successful.  If the mode was
      dedicated, we will require success. */
@@ -168,10 +216,10 @@ init( fd_config_t const * config ) {
     int failed = 0;
     if( is_bonded ) {
       for( ulong i=0UL; !failed && bond_devices[ i ]!=NULL; i++ ) {
-        failed = init_device( bond_devices[ i ], config, 1, only_dedicated );
+        failed = init_device( bond_devices[ i ], config, MODE_DEDICATED, only_dedicated );
       }
     } else {
-      failed = init_device( config->net.interface, config, 1, only_dedicated );
+      failed = init_device( config->net.interface, config, MODE_DEDICATED, only_dedicated );
     }
     if( !failed ) return;
     FD_TEST( !only_dedicated );
@@ -182,10 +230,10 @@ init( fd_config_t const * config ) {
   /* Require success for simple mode, either configured or as fallback */
   if( is_bonded ) {
     for( ulong i=0UL; bond_devices[ i ]!=NULL; i++ ) {
-      init_device( bond_devices[ i ], config, 0, 1 );
+      init_device( bond_devices[ i ], config, MODE_SIMPLE, 1 );
     }
   } else {
-    init_device( config->net.interface, config, 0, 1 );
+    init_device( config->net.interface, config, MODE_SIMPLE, 1 );
   }
 }
 
@@ -221,14 +269,14 @@ check_device_is_modified( char const * device ) {
 static int
 check_device_is_configured( char const *        device,
                             fd_config_t const * config,
-                            int                 dedicated_mode ) {
+                            int                 mode ) {
   fd_ethtool_ioctl_t ioc __attribute__((cleanup(fd_ethtool_ioctl_fini)));
   if( FD_UNLIKELY( &ioc != fd_ethtool_ioctl_init( &ioc, device ) ) )
     FD_LOG_ERR(( "error configuring network device (%s), unable to init ethtool ioctl", device ));
 
   fd_ethtool_ioctl_channels_t channels;
   FD_TEST( 0==fd_ethtool_ioctl_channels_get_num( &ioc, &channels ) );
-  if( channels.current!=(dedicated_mode ? channels.max : config->layout.net_tile_count) ) return 0;
+  if( channels.current!=(mode==MODE_DEDICATED ? channels.max : config->layout.net_tile_count) ) return 0;
 
   uint rxfh_queue_cnt;
   FD_TEST( 0==fd_ethtool_ioctl_rxfh_get_queue_cnt( &ioc, &rxfh_queue_cnt ) );
@@ -237,41 +285,26 @@ check_device_is_configured( char const *        device,
   uint rxfh_table[ FD_ETHTOOL_MAX_RXFH_TABLE_CNT ] = { 0 };
   uint rxfh_table_ele_cnt;
   FD_TEST( 0==fd_ethtool_ioctl_rxfh_get_table( &ioc, rxfh_table, &rxfh_table_ele_cnt ) );
-  int rxfh_error = (dedicated_mode && 0U==rxfh_table_ele_cnt);
-  for( uint j=0U, q=!!dedicated_mode; !rxfh_error && j<rxfh_table_ele_cnt; j++) {
+  uint const rxfh_start = mode!=MODE_SIMPLE;
+  int rxfh_error = (mode!=MODE_SIMPLE && 0U==rxfh_table_ele_cnt);
+  for( uint j=0U, q=rxfh_start; !rxfh_error && j<rxfh_table_ele_cnt; j++) {
     rxfh_error = (rxfh_table[ j ]!=q++);
-    if( FD_UNLIKELY( q>=rxfh_queue_cnt ) ) q = !!dedicated_mode;
+    if( FD_UNLIKELY( q>=rxfh_queue_cnt ) ) q = rxfh_start;
   }
   if( rxfh_error ) return 0;
 
-  if( dedicated_mode ) {
+  if( mode!=MODE_SIMPLE ) {
     int ntuple_feature_active;
     FD_TEST( 0==fd_ethtool_ioctl_feature_test( &ioc, FD_ETHTOOL_FEATURE_NTUPLE, &ntuple_feature_active ) );
     if( !ntuple_feature_active ) return 0;
   }
 
-  if( !dedicated_mode ) {
-    int ntuple_rules_empty;
-    FD_TEST( 0==fd_ethtool_ioctl_ntuple_validate_udp_dport( &ioc, NULL, 0, 0, &ntuple_rules_empty ) );
-    if( !ntuple_rules_empty ) return 0;
-  } else {
-    /* FIXME Centrally define listen port list to avoid this configure
-       stage from going out of sync with port mappings. */
-    uint num_ports = 0;
-    ushort ports[ 32 ];
-    ports[ num_ports++ ] = config->tiles.shred.shred_listen_port;
-    ports[ num_ports++ ] = config->tiles.quic.quic_transaction_listen_port;
-    ports[ num_ports++ ] = config->tiles.quic.regular_transaction_listen_port;
-    if( config->is_firedancer ) {
-      ports[ num_ports++ ] = config->gossip.port;
-      ports[ num_ports++ ] = config->tiles.repair.repair_intake_listen_port;
-      ports[ num_ports++ ] = config->tiles.repair.repair_serve_listen_port;
-      ports[ num_ports++ ] = config->tiles.send.send_src_port;
-    }
-    int ports_valid;
-    FD_TEST( 0==fd_ethtool_ioctl_ntuple_validate_udp_dport( &ioc, ports, num_ports, 0, &ports_valid ));
-    if( !ports_valid ) return 0;
-  }
+  /* In simple mode, checks that no ntuple rules are installed */
+  ushort ports[ 32 ];
+  uint   num_ports = ntuple_ports( config, mode, ports );
+  int    ports_valid;
+  FD_TEST( 0==fd_ethtool_ioctl_ntuple_validate_udp_dport( &ioc, ports, num_ports, 0, &ports_valid ));
+  if( !ports_valid ) return 0;
 
   return 1;
 }
@@ -283,32 +316,46 @@ check( fd_config_t const * config,
     (0==strcmp( config->net.xdp.rss_queue_mode, "dedicated" ));
   int check_dedicated = only_dedicated ||
     (0==strcmp( config->net.xdp.rss_queue_mode, "auto" ) && 1UL==config->layout.net_tile_count );
+  int steered =
+    (0==strcmp( config->net.xdp.rss_queue_mode, "steered" ));
 
   int is_bonded = device_is_bonded( config->net.interface );
   char line[ 4096 ];
   char const * bond_devices[ 16 ];
   if( is_bonded ) device_read_slaves( config->net.interface, line, bond_devices );
 
+  if( steered ) {
+    int is_configured = 1;
+    if( is_bonded ) {
+      for( ulong i=0UL; is_configured && bond_devices[ i ]!=NULL; i++ ) {
+        is_configured = check_device_is_configured( bond_devices[ i ], config, MODE_STEERED );
+      }
+    } else {
+      is_configured = check_device_is_configured( config->net.interface, config, MODE_STEERED );
+    }
+    if( is_configured ) CONFIGURE_OK();
+  }
+
   if( check_dedicated ) {
     int is_configured = 1;
     if( is_bonded ) {
       for( ulong i=0UL; is_configured && bond_devices[ i ]!=NULL; i++ ) {
-        is_configured = check_device_is_configured( bond_devices[ i ], config, 1 );
+        is_configured = check_device_is_configured( bond_devices[ i ], config, MODE_DEDICATED );
       }
     } else {
-      is_configured = check_device_is_configured( config->net.interface, config, 1 );
+      is_configured = check_device_is_configured( config->net.interface, config, MODE_DEDICATED );
     }
     if( is_configured ) CONFIGURE_OK();
   }
 
-  if( !only_dedicated ) {
+  if( !only_dedicated && !steered ) {
     int is_configured = 1;
     if( is_bonded ) {
       for( ulong i=0UL; is_configured && bond_devices[ i ]!=NULL; i++ ) {
-        is_configured = check_device_is_configured( bond_devices[ i ], config, 0 );
+        is_configured = check_device_is_configured( bond_devices[ i ], config, MODE_SIMPLE );
       }
     } else {
-      is_configured = check_device_is_configured( config->net.interface, config, 0 );
+      is_configured = check_device_is_configured( config->net.interface, config, MODE_SIMPLE );
     }
     if( is_configured ) CONFIGURE_OK();
   }
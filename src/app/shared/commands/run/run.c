@@ -17,6 +17,7 @@
 
 #include <dirent.h>
 #include <sched.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h> /* getenv */
 #include <poll.h>
@@ -74,10 +75,32 @@ extern char fd_log_private_path[ 1024 ]; /* empty string on start */
 
 static pid_t pid_namespace;
 
+/* The topology object persisted on shutdown, if any.  See save_fd in
+   fd_topo_obj_callbacks_t. */
+
+static fd_topo_t const *               save_topo;
+static fd_topo_obj_t const *           save_obj;
+static fd_topo_obj_callbacks_t const * save_cb;
+static int                             save_fd = -1;
+
+/* The signal that asked the supervisor to shut down, 0 if none yet.
+   When there is an object to save, parent_signal only records the
+   signal and the supervisor saves the object and exits once the PID
+   namespace is reaped (file I/O and walking shared memory are not
+   async-signal-safe). */
+
+static volatile sig_atomic_t parent_signal_sig;
+
 #define FD_LOG_ERR_NOEXIT(a) do { long _fd_log_msg_now = fd_log_wallclock(); fd_log_private_1( 4, _fd_log_msg_now, __FILE__, __LINE__, __func__, fd_log_private_0 a ); } while(0)
 
 extern int * fd_log_private_shared_lock;
 
+static void
+parent_exit( int sig ) {
+  if( FD_LIKELY( sig==SIGINT ) ) fd_sys_util_exit_group( 128+SIGINT );
+  else                           fd_sys_util_exit_group( 0          );
+}
+
 static void
 parent_signal( int sig ) {
   if( FD_LIKELY( pid_namespace ) ) kill( pid_namespace, SIGKILL );
@@ -87,14 +110,21 @@ parent_signal( int sig ) {
      particularly if one of those processes might have just died.  The
      signal handler is re-entrant so this also avoids a deadlock since
      the log lock is not re-entrant. */
-  int lock = 0;
+  static int lock;
+  lock = 0;
   fd_log_private_shared_lock = &lock;
 
   if( -1!=fd_log_private_logfile_fd() ) FD_LOG_ERR_NOEXIT(( "Received signal %s\nLog at \"%s\"", fd_io_strsignal( sig ), fd_log_private_path ));
   else                                  FD_LOG_ERR_NOEXIT(( "Received signal %s",                fd_io_strsignal( sig ) ));
 
-  if( FD_LIKELY( sig==SIGINT ) ) fd_sys_util_exit_group( 128+SIGINT );
-  else                           fd_sys_util_exit_group( 0          );
+  /* Let the supervisor loop save the object, unless a save is already
+     pending and the user insists on exiting. */
+  if( FD_LIKELY( save_fd!=-1 && pid_namespace && !parent_signal_sig ) ) {
+    parent_signal_sig = sig;
+    return;
+  }
+
+  parent_exit( sig );
 }
 
 static void
@@ -792,6 +822,52 @@ fdctl_setup_netns( config_t * config,
     FD_LOG_ERR(( "failed to restore network namespace (fd=%d) (%i-%s)", original_netns_, errno, fd_io_strerror( errno ) ));
 }
 
+/* open_save_obj prepares the supervisor to save the topology object
+   with a save callback (if any) on shutdown.  Joins the workspace of
+   the object and returns the file descriptor to save it to, or -1 if
+   there is nothing to save. */
+
+static int
+open_save_obj( config_t * config ) {
+  fd_topo_t *                     topo = &config->topo;
+  fd_topo_obj_t const *           obj  = NULL;
+  fd_topo_obj_callbacks_t const * cb   = NULL;
+  for( ulong i=0UL; i<topo->obj_cnt; i++ ) {
+    for( ulong j=0UL; CALLBACKS[ j ]; j++ ) {
+      if( FD_LIKELY( !CALLBACKS[ j ]->save || strcmp( CALLBACKS[ j ]->name, topo->objs[ i ].name ) ) ) continue;
+      if( FD_UNLIKELY( obj ) ) FD_LOG_ERR(( "topology has more than one object to save on shutdown (%s, %s)", obj->name, topo->objs[ i ].name ));
+      obj = &topo->objs[ i ];
+      cb  = CALLBACKS[ j ];
+    }
+  }
+  if( FD_LIKELY( !obj ) ) return -1;
+
+  /* Switch to non-root uid/gid so the saved file is owned by the
+     validator user. */
+  uint gid = getgid();
+  uint uid = getuid();
+  if( FD_LIKELY( gid!=config->gid && -1==setegid( config->gid ) ) )
+    FD_LOG_ERR(( "setegid() failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  if( FD_LIKELY( uid!=config->uid && -1==seteuid( config->uid ) ) )
+    FD_LOG_ERR(( "seteuid() failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+
+  int fd = cb->save_fd( topo, obj );
+
+  if( FD_UNLIKELY( seteuid( uid ) ) ) FD_LOG_ERR(( "seteuid() failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  if( FD_UNLIKELY( setegid( gid ) ) ) FD_LOG_ERR(( "setegid() failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+
+  if( FD_UNLIKELY( -1==fd ) ) return -1;
+
+  /* The supervisor is sandboxed and cannot map memory later */
+  fd_topo_join_workspace( topo, &topo->workspaces[ obj->wksp_id ], FD_SHMEM_JOIN_MODE_READ_WRITE );
+
+  save_topo = topo;
+  save_obj  = obj;
+  save_cb   = cb;
+  save_fd   = fd;
+  return fd;
+}
+
 /* The boot sequence is a little bit involved...
 
    A process tree is created that looks like,
@@ -868,10 +944,12 @@ run_firedancer( config_t * config,
 
   if( FD_UNLIKELY( close( config->log.lock_fd ) ) ) FD_LOG_ERR(( "close() failed (%i-%s)", errno, fd_io_strerror( errno ) ));
 
+  int _save_fd = open_save_obj( config );
+
   struct sock_filter seccomp_filter[ 128UL ];
-  populate_sock_filter_policy_main( 128UL, seccomp_filter, (uint)fd_log_private_logfile_fd(), (uint)pid_namespace );
+  populate_sock_filter_policy_main( 128UL, seccomp_filter, (uint)fd_log_private_logfile_fd(), (uint)pid_namespace, (uint)_save_fd );
 
-  int allow_fds[ 4 ];
+  int allow_fds[ 5 ];
   ulong allow_fds_cnt = 0;
   allow_fds[ allow_fds_cnt++ ] = 2; /* stderr */
   if( FD_LIKELY( fd_log_private_logfile_fd()!=-1 ) )
@@ -879,6 +957,8 @@ run_firedancer( config_t * config,
   allow_fds[ allow_fds_cnt++ ] = pipefd; /* read end of main pipe */
   if( FD_UNLIKELY( parent_pipefd!=-1 ) )
     allow_fds[ allow_fds_cnt++ ] = parent_pipefd; /* write end of parent pipe */
+  if( FD_UNLIKELY( _save_fd!=-1 ) )
+    allow_fds[ allow_fds_cnt++ ] = _save_fd; /* object saved on shutdown */
 
   if( FD_LIKELY( config->development.sandbox ) ) {
     fd_sandbox_enter( config->uid,
@@ -908,7 +988,23 @@ run_firedancer( config_t * config,
   /* the only clean way to exit is SIGINT or SIGTERM on this parent process,
      so if wait4() completes, it must be an error */
   int wstatus;
-  if( FD_UNLIKELY( -1==wait4( pid_namespace, &wstatus, (int)__WALL, NULL ) ) )
+  int wait_err;
+  do {
+    wait_err = -1==wait4( pid_namespace, &wstatus, (int)__WALL, NULL );
+  } while( FD_UNLIKELY( wait_err && errno==EINTR ) );
+
+  /* On SIGINT or SIGTERM with an object to save, parent_signal has
+     killed the PID namespace.  The kernel kills all processes in it
+     before its init process can be reaped, so once the wait completes
+     no tile is touching shared memory anymore.  The object may still
+     be left mid-update by a killed tile, which the save callback is
+     responsible for detecting. */
+  if( FD_UNLIKELY( parent_signal_sig ) ) {
+    if( FD_LIKELY( !wait_err ) ) save_cb->save( save_topo, save_obj, save_fd );
+    parent_exit( parent_signal_sig );
+  }
+
+  if( FD_UNLIKELY( wait_err ) )
     FD_LOG_ERR(( "main wait4() failed (%i-%s)\nLog at \"%s\"", errno, fd_io_strerror( errno ), fd_log_private_path ));
 
   if( FD_UNLIKELY( WIFSIGNALED( wstatus ) ) ) fd_sys_util_exit_group( WTERMSIG( wstatus ) ? WTERMSIG( wstatus ) : 1 );
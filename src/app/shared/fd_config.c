@@ -539,9 +539,12 @@ fd_config_validate( fd_config_t const * config ) {
     if( 0==strcmp( config->net.xdp.rss_queue_mode, "dedicated" ) ) {
       if( FD_UNLIKELY( config->layout.net_tile_count != 1 ) )
         FD_LOG_ERR(( "`layout.net_tile_count` must be 1 when `net.xdp.rss_queue_mode` is \"dedicated\"" ));
+    } else if( 0==strcmp( config->net.xdp.rss_queue_mode, "steered" ) ) {
+      if( FD_UNLIKELY( config->layout.net_tile_count < 2 ) )
+        FD_LOG_ERR(( "`layout.net_tile_count` must be at least 2 when `net.xdp.rss_queue_mode` is \"steered\"" ));
     } else if( 0!=strcmp( config->net.xdp.rss_queue_mode, "simple" ) &&
                0!=strcmp( config->net.xdp.rss_queue_mode, "auto" ) ) {
-      FD_LOG_ERR(( "invalid `net.xdp.rss_queue_mode`: \"%s\"; must be \"simple\", \"dedicated\", or \"auto\"",
+      FD_LOG_ERR(( "invalid `net.xdp.rss_queue_mode`: \"%s\"; must be \"simple\", \"dedicated\", \"steered\", or \"auto\"",
                    config->net.xdp.rss_queue_mode  ));
     }
   } else if( 0==strcmp( config->net.provider, "socket" ) ) {
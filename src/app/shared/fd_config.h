@@ -115,6 +115,8 @@ struct fd_configf {
     uint exec_tile_count; /* TODO: redundant ish with bank tile cnt */
     uint sign_tile_count;
     uint gossvf_tile_count;
+    uint snapla_tile_count;
+    uint snapin_tile_count;
   } layout;
 
   struct {
@@ -125,6 +127,8 @@ struct fd_configf {
     struct {
       ulong heap_size_mib;
       ulong mean_cache_entry_size;
+      char  warm_start_path[ PATH_MAX ];
+      ulong warm_start_size_mib;
     } program_cache;
   } runtime;
 
@@ -154,6 +158,7 @@ struct fd_configf {
     uint max_full_snapshots_to_keep;
     uint max_incremental_snapshots_to_keep;
     uint full_effective_age_cancel_threshold;
+    uint download_peer_count;
   } snapshots;
 
   struct {
@@ -180,7 +185,7 @@ struct fd_config_net {
     uint xdp_rx_queue_size;
     uint xdp_tx_queue_size;
     uint flush_timeout_micros;
-    char rss_queue_mode[ 16 ]; /* "simple", "dedicated", or "auto" */
+    char rss_queue_mode[ 16 ]; /* "simple", "dedicated", "steered", or "auto" */
   } xdp;
 
   struct {
@@ -439,6 +444,7 @@ struct fd_config {
       char   rpc_listen_address[ 16 ];
       ushort rpc_listen_port;
       ulong  max_http_connections;
+      ulong  max_websocket_connections;
       ulong  max_http_request_length;
       ulong  send_buffer_size_mb;
     } rpc;
@@ -31,7 +31,8 @@ mcache_align( fd_topo_t const *     topo FD_FN_UNUSED,
 static void
 mcache_new( fd_topo_t const *     topo,
             fd_topo_obj_t const * obj ) {
-  FD_TEST( fd_mcache_new( fd_topo_obj_laddr( topo, obj->id ), VAL("depth"), 0UL, 0UL ) );
+  ulong prod_cnt = fd_pod_queryf_ulong( topo->props, 1UL, "obj.%lu.prod_cnt", obj->id );
+  FD_TEST( fd_mcache_new_mp( fd_topo_obj_laddr( topo, obj->id ), VAL("depth"), 0UL, 0UL, prod_cnt ) );
 }
 
 fd_topo_obj_callbacks_t fd_obj_cb_mcache = {
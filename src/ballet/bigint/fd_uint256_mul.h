@@ -199,3 +199,88 @@ fd_uint256_mul_mod_p( fd_uint256_t *       r,
               fp ## _t const * b ) {                  \
     return fd_uint256_mul_mod_p( r, a, b, p, p_inv ); \
   }
+
+#if FD_HAS_INT128
+
+/* fd_uint256_mul_acc computes t += a * b, where t is a 576-bit
+   accumulator (9 limbs, little endian).  Together with
+   fd_uint256_redc_mod_p, this computes sums of products with a single
+   Montgomery reduction (lazy reduction).  The caller is responsible
+   for t not overflowing (e.g. with a, b < p < 2^254, t can hold 2^10
+   products). */
+
+INLINE void
+fd_uint256_mul_acc( ulong                t[9],
+                    fd_uint256_t const * a,
+                    fd_uint256_t const * b ) {
+  for( int i=0; i<4; i++ ) {
+    ulong cy = 0UL;
+    for( int j=0; j<4; j++ ) {
+      uint128 x = ((uint128)a->limbs[j]) * ((uint128)b->limbs[i]) + t[i+j] + cy;
+      t[i+j] = (ulong)x;
+      cy     = (ulong)(x >> 64);
+    }
+    for( int k=i+4; k<9; k++ ) {
+      uint128 x = ((uint128)t[k]) + cy;
+      t[k] = (ulong)x;
+      cy   = (ulong)(x >> 64);
+    }
+  }
+}
+
+/* fd_uint256_redc_mod_p computes r = t / 2^256 mod p, i.e. the
+   Montgomery reduction of the accumulator t (which is clobbered).
+   t must be < k p 2^256 for a small k, e.g. the sum of k products of
+   elements < p, as the result is reduced with at most k subtractions.  Same requirements on p, p_inv as fd_uint256_mul_mod_p. */
+
+INLINE fd_uint256_t *
+fd_uint256_redc_mod_p( fd_uint256_t *       r,
+                       ulong                t[9],
+                       fd_uint256_t const * p,
+                       ulong const          p_inv ) {
+  for( int i=0; i<4; i++ ) {
+    ulong m  = t[i] * p_inv;
+    ulong cy = 0UL;
+    for( int j=0; j<4; j++ ) {
+      uint128 x = ((uint128)m) * ((uint128)p->limbs[j]) + t[i+j] + cy;
+      t[i+j] = (ulong)x;
+      cy     = (ulong)(x >> 64);
+    }
+    for( int k=i+4; k<9; k++ ) {
+      uint128 x = ((uint128)t[k]) + cy;
+      t[k] = (ulong)x;
+      cy   = (ulong)(x >> 64);
+    }
+  }
+
+  r->limbs[0] = t[4];
+  r->limbs[1] = t[5];
+  r->limbs[2] = t[6];
+  r->limbs[3] = t[7];
+  ulong hi    = t[8];
+  while( hi || fd_uint256_cmp( r, p ) >= 0 ) {
+    int b = 0;
+    fd_ulong_sub_borrow( &r->limbs[0], &b, r->limbs[0], p->limbs[0], b );
+    fd_ulong_sub_borrow( &r->limbs[1], &b, r->limbs[1], p->limbs[1], b );
+    fd_ulong_sub_borrow( &r->limbs[2], &b, r->limbs[2], p->limbs[2], b );
+    fd_ulong_sub_borrow( &r->limbs[3], &b, r->limbs[3], p->limbs[3], b );
+    hi -= (ulong)b;
+  }
+  return r;
+}
+
+/* FD_UINT256_FP_DOT_IMPL implements fp_dot( r, a, b, sz ), computing
+   r = sum_i a[i] * b[i] in Montgomery representation with a single
+   reduction.  sz must be <= 16. */
+#define FD_UINT256_FP_DOT_IMPL(fp, p, p_inv)                           \
+  static inline fp ## _t * OPTIMIZE                                    \
+  fp ## _dot( fp ## _t *       r,                                      \
+              fp ## _t const * a,                                      \
+              fp ## _t const * b,                                      \
+              ulong            sz ) {                                  \
+    ulong t[9] = { 0 };                                                \
+    for( ulong i=0; i<sz; i++ ) fd_uint256_mul_acc( t, &a[i], &b[i] ); \
+    return fd_uint256_redc_mod_p( r, t, p, p_inv );                    \
+  }
+
+#endif /* FD_HAS_INT128 */
@@ -149,11 +149,31 @@ fd_bn254_fp_set( fd_bn254_fp_t * r,
   return r;
 }
 
+/* fd_bn254_fp_add and fd_bn254_fp_sub are implemented with add/sub
+   with carry, instead of fiat-crypto.  fiat's add/sub do not get
+   inlined with their carry helpers, and they are used a lot in the
+   extension fields.  Since p < 2^254, a + b never overflows 256-bit. */
+
 static inline fd_bn254_fp_t *
 fd_bn254_fp_add( fd_bn254_fp_t * r,
                  fd_bn254_fp_t const * a,
                  fd_bn254_fp_t const * b ) {
-  fiat_bn254_add( r->limbs, a->limbs, b->limbs );
+  ulong t[4], s[4];
+  uchar c = 0;
+  int   bw = 0;
+  fd_ulong_add_carry4( &t[0], &c, a->limbs[0], b->limbs[0], 0UL, c );
+  fd_ulong_add_carry4( &t[1], &c, a->limbs[1], b->limbs[1], 0UL, c );
+  fd_ulong_add_carry4( &t[2], &c, a->limbs[2], b->limbs[2], 0UL, c );
+  fd_ulong_add_carry4( &t[3], &c, a->limbs[3], b->limbs[3], 0UL, c );
+  fd_ulong_sub_borrow( &s[0], &bw, t[0], fd_bn254_const_p->limbs[0], bw );
+  fd_ulong_sub_borrow( &s[1], &bw, t[1], fd_bn254_const_p->limbs[1], bw );
+  fd_ulong_sub_borrow( &s[2], &bw, t[2], fd_bn254_const_p->limbs[2], bw );
+  fd_ulong_sub_borrow( &s[3], &bw, t[3], fd_bn254_const_p->limbs[3], bw );
+  /* r = a+b<p ? a+b : a+b-p */
+  r->limbs[0] = fd_ulong_if( bw, t[0], s[0] );
+  r->limbs[1] = fd_ulong_if( bw, t[1], s[1] );
+  r->limbs[2] = fd_ulong_if( bw, t[2], s[2] );
+  r->limbs[3] = fd_ulong_if( bw, t[3], s[3] );
   return r;
 }
 
@@ -161,14 +181,37 @@ static inline fd_bn254_fp_t *
 fd_bn254_fp_sub( fd_bn254_fp_t * r,
                  fd_bn254_fp_t const * a,
                  fd_bn254_fp_t const * b ) {
-  fiat_bn254_sub( r->limbs, a->limbs, b->limbs );
+  ulong t[4];
+  int   bw = 0;
+  uchar c  = 0;
+  fd_ulong_sub_borrow( &t[0], &bw, a->limbs[0], b->limbs[0], bw );
+  fd_ulong_sub_borrow( &t[1], &bw, a->limbs[1], b->limbs[1], bw );
+  fd_ulong_sub_borrow( &t[2], &bw, a->limbs[2], b->limbs[2], bw );
+  fd_ulong_sub_borrow( &t[3], &bw, a->limbs[3], b->limbs[3], bw );
+  /* r = a>=b ? a-b : a-b+p */
+  ulong m = (ulong)(-(long)bw);
+  fd_ulong_add_carry4( &r->limbs[0], &c, t[0], fd_bn254_const_p->limbs[0] & m, 0UL, c );
+  fd_ulong_add_carry4( &r->limbs[1], &c, t[1], fd_bn254_const_p->limbs[1] & m, 0UL, c );
+  fd_ulong_add_carry4( &r->limbs[2], &c, t[2], fd_bn254_const_p->limbs[2] & m, 0UL, c );
+  fd_ulong_add_carry4( &r->limbs[3], &c, t[3], fd_bn254_const_p->limbs[3] & m, 0UL, c );
   return r;
 }
 
 static inline fd_bn254_fp_t *
 fd_bn254_fp_neg( fd_bn254_fp_t * r,
                  fd_bn254_fp_t const * a ) {
-  fiat_bn254_opp( r->limbs, a->limbs );
+  /* r = a==0 ? 0 : p-a */
+  ulong t[4];
+  int   bw = 0;
+  ulong m  = (ulong)(-(long)!!( a->limbs[0] | a->limbs[1] | a->limbs[2] | a->limbs[3] ));
+  fd_ulong_sub_borrow( &t[0], &bw, fd_bn254_const_p->limbs[0], a->limbs[0], bw );
+  fd_ulong_sub_borrow( &t[1], &bw, fd_bn254_const_p->limbs[1], a->limbs[1], bw );
+  fd_ulong_sub_borrow( &t[2], &bw, fd_bn254_const_p->limbs[2], a->limbs[2], bw );
+  fd_ulong_sub_borrow( &t[3], &bw, fd_bn254_const_p->limbs[3], a->limbs[3], bw );
+  r->limbs[0] = t[0] & m;
+  r->limbs[1] = t[1] & m;
+  r->limbs[2] = t[2] & m;
+  r->limbs[3] = t[3] & m;
   return r;
 }
 
@@ -593,6 +593,90 @@ fd_bn254_fp12_mul( fd_bn254_fp12_t * r,
   return r;
 }
 
+/* fd_bn254_fp6_mul_by_0 computes r = a * b, where b = b0 is in Fp2.
+   3 Fp2 mul instead of 6. */
+static inline fd_bn254_fp6_t *
+fd_bn254_fp6_mul_by_0( fd_bn254_fp6_t * r,
+                       fd_bn254_fp6_t const * a,
+                       fd_bn254_fp2_t const * b0 ) {
+  fd_bn254_fp2_mul( &r->el[0], &a->el[0], b0 );
+  fd_bn254_fp2_mul( &r->el[1], &a->el[1], b0 );
+  fd_bn254_fp2_mul( &r->el[2], &a->el[2], b0 );
+  return r;
+}
+
+/* fd_bn254_fp6_mul_by_01 computes r = a * b, where b = b0 + b1 v,
+   i.e. b2 = 0.  Karatsuba as in fd_bn254_fp6_mul, 5 Fp2 mul instead
+   of 6. */
+static inline fd_bn254_fp6_t *
+fd_bn254_fp6_mul_by_01( fd_bn254_fp6_t * r,
+                        fd_bn254_fp6_t const * a,
+                        fd_bn254_fp2_t const * b0,
+                        fd_bn254_fp2_t const * b1 ) {
+  fd_bn254_fp2_t const * a0 = &a->el[0];
+  fd_bn254_fp2_t const * a1 = &a->el[1];
+  fd_bn254_fp2_t const * a2 = &a->el[2];
+  fd_bn254_fp2_t a0b0[1], a1b1[1];
+  fd_bn254_fp2_t sa[1], sb[1];
+  fd_bn254_fp2_t r0[1], r1[1], r2[1];
+
+  fd_bn254_fp2_mul( a0b0, a0, b0 );
+  fd_bn254_fp2_mul( a1b1, a1, b1 );
+
+  /* r0 = a0b0 + xi a2b1 */
+  fd_bn254_fp2_add( sa, a1, a2 );
+  fd_bn254_fp2_mul( r0, sa, b1 );
+  fd_bn254_fp2_sub( r0, r0, a1b1 );
+  fd_bn254_fp2_mul_by_xi( r0, r0 );
+  fd_bn254_fp2_add( r0, r0, a0b0 );
+
+  /* r1 = a0b1 + a1b0 */
+  fd_bn254_fp2_add( sa, a0, a1 );
+  fd_bn254_fp2_add( sb, b0, b1 );
+  fd_bn254_fp2_mul( r1, sa, sb );
+  fd_bn254_fp2_sub( r1, r1, a0b0 );
+  fd_bn254_fp2_sub( r1, r1, a1b1 );
+
+  /* r2 = a2b0 + a1b1 */
+  fd_bn254_fp2_add( sa, a0, a2 );
+  fd_bn254_fp2_mul( r2, sa, b0 );
+  fd_bn254_fp2_sub( r2, r2, a0b0 );
+  fd_bn254_fp2_add( r2, r2, a1b1 );
+
+  fd_bn254_fp2_set( &r->el[0], r0 );
+  fd_bn254_fp2_set( &r->el[1], r1 );
+  fd_bn254_fp2_set( &r->el[2], r2 );
+  return r;
+}
+
+/* fd_bn254_fp12_mul_by_line computes r = a * l, where l is a sparse
+   element as computed by the Miller loop line functions, i.e.
+   l = l00 + (l10 + l11 v) w (all other Fp2 coefficients are 0).
+   Karatsuba as in fd_bn254_fp12_mul, 13 Fp2 mul instead of 18. */
+static inline fd_bn254_fp12_t *
+fd_bn254_fp12_mul_by_line( fd_bn254_fp12_t * r,
+                           fd_bn254_fp12_t const * a,
+                           fd_bn254_fp12_t const * l ) {
+  fd_bn254_fp2_t const * l00 = &l->el[0].el[0];
+  fd_bn254_fp2_t const * l10 = &l->el[1].el[0];
+  fd_bn254_fp2_t const * l11 = &l->el[1].el[1];
+  fd_bn254_fp6_t a0l0[1], a1l1[1], sa[1];
+  fd_bn254_fp2_t sl[1];
+
+  fd_bn254_fp6_mul_by_0 ( a0l0, &a->el[0], l00 );
+  fd_bn254_fp6_mul_by_01( a1l1, &a->el[1], l10, l11 );
+
+  fd_bn254_fp6_add( sa, &a->el[0], &a->el[1] );
+  fd_bn254_fp2_add( sl, l00, l10 );
+  fd_bn254_fp6_mul_by_01( &r->el[1], sa, sl, l11 );
+  fd_bn254_fp6_sub( &r->el[1], &r->el[1], a0l0 );
+  fd_bn254_fp6_sub( &r->el[1], &r->el[1], a1l1 );
+
+  fd_bn254_fp6_mul_by_gamma( a1l1, a1l1 );
+  fd_bn254_fp6_add( &r->el[0], a0l0, a1l1 );
+  return r;
+}
+
 static inline fd_bn254_fp12_t *
 fd_bn254_fp12_sqr( fd_bn254_fp12_t * r,
                         fd_bn254_fp12_t const * a ) {
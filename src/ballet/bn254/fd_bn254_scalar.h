@@ -67,6 +67,10 @@ fd_bn254_scalar_add( fd_bn254_scalar_t *       r,
   return r;
 }
 
+/* fd_bn254_scalar_dot computes r = a[0]*b[0] + ... + a[sz-1]*b[sz-1],
+   for sz<=16.  Uses lazy reduction, i.e. a single Montgomery reduction
+   for the whole sum, when available. */
+
 #if USE_FIAT_CRYPTO_MUL
 
 static inline fd_bn254_scalar_t *
@@ -84,9 +88,24 @@ fd_bn254_scalar_sqr( fd_bn254_scalar_t *       r,
   return r;
 }
 
+static inline fd_bn254_scalar_t *
+fd_bn254_scalar_dot( fd_bn254_scalar_t *       r,
+                     fd_bn254_scalar_t const * a,
+                     fd_bn254_scalar_t const * b,
+                     ulong                     sz ) {
+  fd_bn254_scalar_t t[1];
+  fd_memset( r, 0, sizeof(fd_bn254_scalar_t) );
+  for( ulong i=0; i<sz; i++ ) {
+    fd_bn254_scalar_mul( t, &a[i], &b[i] );
+    fd_bn254_scalar_add( r, r, t );
+  }
+  return r;
+}
+
 #else
 
 FD_UINT256_FP_MUL_IMPL(fd_bn254_scalar, fd_bn254_const_r, fd_bn254_const_r_inv)
+FD_UINT256_FP_DOT_IMPL(fd_bn254_scalar, fd_bn254_const_r, fd_bn254_const_r_inv)
 
 static inline fd_bn254_scalar_t *
 fd_bn254_scalar_sqr( fd_bn254_scalar_t *       r,
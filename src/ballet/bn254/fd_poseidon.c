@@ -35,14 +35,11 @@ static inline void
 fd_poseidon_apply_mds( fd_bn254_scalar_t   state[],
                        ulong const       width,
                        fd_poseidon_par_t const * params ) {
-  fd_bn254_scalar_t x[FD_POSEIDON_MAX_WIDTH+1] = { 0 };
-  /* Vector-matrix multiplication (state vector times mds matrix) */
+  fd_bn254_scalar_t x[FD_POSEIDON_MAX_WIDTH+1];
+  /* Vector-matrix multiplication (state vector times mds matrix).
+     Each row is reduced once (lazy reduction), see fd_bn254_scalar_dot. */
   for( ulong i=0; i<width; i++ ) {
-    for( ulong j=0; j<width; j++ ) {
-      fd_bn254_scalar_t t[1];
-      fd_bn254_scalar_mul( t, &state[j], &params->mds[ i * width + j ] );
-      fd_bn254_scalar_add( &x[i], &x[i], t );
-    }
+    fd_bn254_scalar_dot( &x[i], state, &params->mds[ i * width ], width );
   }
   for( ulong i=0; i<width; i++ ) {
     state[i] = x[i];
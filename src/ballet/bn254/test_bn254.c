@@ -250,6 +250,44 @@ int main( int     argc,
       dt = fd_log_wallclock() - dt;
       log_bench( "fd_bn254_final_exp", iter, dt );
     }
+
+    /* Per operation benchmarks (inputs don't need to be valid points) */
+    {
+      ulong iter = 10000UL;
+      long dt = fd_log_wallclock();
+      for( ulong rem=iter; rem; rem-- ) {
+        fd_bn254_fp12_mul( r, r, x );
+      }
+      dt = fd_log_wallclock() - dt;
+      log_bench( "fd_bn254_fp12_mul", iter, dt );
+    }
+    {
+      ulong iter = 1000UL;
+      long dt = fd_log_wallclock();
+      for( ulong rem=iter; rem; rem-- ) {
+        fd_bn254_fp12_inv( r, x );
+      }
+      dt = fd_log_wallclock() - dt;
+      log_bench( "fd_bn254_fp12_inv", iter, dt );
+    }
+    {
+      fd_bn254_g1_t p[FD_BN254_PAIRING_BATCH_MAX];
+      fd_bn254_g2_t q[FD_BN254_PAIRING_BATCH_MAX];
+      for( ulong j=0; j<FD_BN254_PAIRING_BATCH_MAX; j++ ) {
+        p[j].X = x->el[0].el[0].el[0]; p[j].Y = x->el[0].el[0].el[1]; p[j].Z = x->el[0].el[1].el[0];
+        q[j].X = x->el[1].el[0];       q[j].Y = x->el[1].el[1];       q[j].Z = x->el[1].el[2];
+      }
+      char cstr[128];
+      for( ulong sz=1; sz<=FD_BN254_PAIRING_BATCH_MAX; sz*=4 ) {
+        ulong iter = 100UL;
+        long dt = fd_log_wallclock();
+        for( ulong rem=iter; rem; rem-- ) {
+          fd_bn254_miller_loop( r, p, q, sz );
+        }
+        dt = fd_log_wallclock() - dt;
+        log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_bn254_miller_loop(%lu)", sz ), iter, dt );
+      }
+    }
   }
 
   {
@@ -386,13 +424,18 @@ int main( int     argc,
       log_bench( "fd_bn254_g2_decompress", iter, dt );
     }
     {
-      ulong iter = 100UL;
-      long dt = fd_log_wallclock();
-      for( ulong rem=iter; rem; rem-- ) {
-        fd_bn254_pairing_is_one_syscall( res, in, in_sz );
+      /* Multi-pairing with sz copies of the first pair of the last test */
+      char cstr[128];
+      for( ulong sz=1; sz<=8; sz*=2 ) {
+        for( ulong j=1; j<sz; j++ ) fd_memcpy( &in[192*j], &in[0], 192 );
+        ulong iter = 100UL;
+        long dt = fd_log_wallclock();
+        for( ulong rem=iter; rem; rem-- ) {
+          fd_bn254_pairing_is_one_syscall( res, in, 192*sz );
+        }
+        dt = fd_log_wallclock() - dt;
+        log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_bn254_pairing_is_one_syscall(%lu)", sz ), iter, dt );
       }
-      dt = fd_log_wallclock() - dt;
-      log_bench( "fd_bn254_pairing_is_one_syscall", iter, dt );
     }
   }
 
@@ -206,6 +206,117 @@ fd_ed25519_multi_scalar_mul_with_opts( fd_ed25519_point_t *     r,
   return r;
 }
 
+/* Pippenger (bucket method) MSM, used for large sz.
+
+   Scalars are recoded in signed radix 2^w, i.e. n = sum_k d_k 2^(kw)
+   with d_k in [-2^(w-1), 2^(w-1)).  For each window k (from the top),
+   each point a_j is added to (or subtracted from) bucket |d_kj|, then
+   the window sum sum_i i*bucket_i is computed with running sums, and
+   accumulated into r with w doublings.  The cost is ~(256/w)*(sz+2^w)
+   adds, vs ~sz*256/(WNAF_BIT_SZ+1) adds for Straus, plus the tables. */
+
+#define PIPPENGER_W_MIN   (5)
+#define PIPPENGER_W_MAX   (7)
+#define PIPPENGER_WIN_MAX ((256+PIPPENGER_W_MIN)/PIPPENGER_W_MIN)
+#define PIPPENGER_BKT_MAX (1<<(PIPPENGER_W_MAX-1))
+
+/* pippenger_w returns the window size minimizing (256/w)*(sz+2^w),
+   for sz up to FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ. */
+static inline int
+pippenger_w( ulong sz ) {
+  if( sz<160UL ) return 5;
+  if( sz<400UL ) return 6;
+  return 7;
+}
+
+/* pippenger_recode computes the win_cnt signed radix 2^w digits of
+   the scalar n into d[0], d[stride], ...  win_cnt=(256+w)/w windows
+   leave room for the final carry, so the top digit is always >=0. */
+static inline void
+pippenger_recode( schar *     d,
+                  ulong       stride,
+                  uchar const n[ 32 ],
+                  int         w,
+                  ulong       win_cnt ) {
+  int half  = 1<<(w-1);
+  int mask  = (1<<w)-1;
+  int carry = 0;
+  for( ulong k=0UL; k<win_cnt; k++ ) {
+    ulong off = k*(ulong)w;
+    ulong b   = off>>3;
+    uint  v   = 0U;
+    if( b    <32UL ) v |= (uint)n[b  ];
+    if( b+1UL<32UL ) v |= (uint)n[b+1]<<8;
+    int   dk  = (int)( (v>>(off&7UL)) & (uint)mask ) + carry;
+    carry     = dk>=half;
+    dk       -= carry<<w;
+    d[k*stride] = (schar)dk;
+  }
+}
+
+static fd_ed25519_point_t *
+fd_ed25519_multi_scalar_mul_pippenger( fd_ed25519_point_t *     r,
+                                       uchar const              n[], /* sz * 32 */
+                                       fd_ed25519_point_t const a[], /* sz */
+                                       ulong const              sz ) {
+  schar              digits[PIPPENGER_WIN_MAX][FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ];
+  fd_ed25519_point_t ai[FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ]; /* a in precomputed format */
+  fd_ed25519_point_t bkt[PIPPENGER_BKT_MAX];                         /* bkt[i] = bucket i+1 */
+  uchar              bkt_used[PIPPENGER_BKT_MAX];
+  fd_ed25519_point_t run[1], sum[1], t[1];
+
+  int   w       = pippenger_w( sz );
+  ulong win_cnt = (256UL+(ulong)w)/(ulong)w;
+  ulong bkt_cnt = 1UL<<(w-1);
+
+  for( ulong j=0UL; j<sz; j++ ) {
+    pippenger_recode( &digits[0][j], FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ, &n[32*j], w, win_cnt );
+    /* pre-compute kT, to save 1mul per bucket add */
+    fd_ed25519_point_set( &ai[j], &a[j] );
+    fd_curve25519_into_precomputed( &ai[j] );
+  }
+
+  fd_ed25519_point_set_zero( r );
+  for( ulong k=win_cnt; k--; ) {
+    fd_ed25519_point_dbln( r, r, w );
+
+    /* accumulate points into buckets.  the first point of a bucket is
+       copied, which saves 1add per non-empty bucket. */
+    memset( bkt_used, 0, bkt_cnt );
+    for( ulong j=0UL; j<sz; j++ ) {
+      int dk = digits[k][j];
+      if( !dk ) continue;
+      ulong i = (ulong)( dk>0 ? dk : -dk ) - 1UL;
+      if( FD_UNLIKELY( !bkt_used[i] ) ) {
+        if( dk>0 ) fd_ed25519_point_set( &bkt[i], &a[j] );
+        else       fd_ed25519_point_neg( &bkt[i], &a[j] );
+        bkt_used[i] = 1;
+        continue;
+      }
+      if( dk>0 ) fd_ed25519_point_add_with_opts( t, &bkt[i], &ai[j], 0, 1, 1 );
+      else       fd_ed25519_point_sub_with_opts( t, &bkt[i], &ai[j], 0, 1, 1 );
+      fd_ed25519_point_add_final_mul( &bkt[i], t );
+    }
+
+    /* window sum: sum_i (i+1)*bkt[i] = sum_i run_i, with run_i = sum_{l>=i} bkt[l] */
+    int run_used = 0;
+    int sum_used = 0;
+    for( ulong i=bkt_cnt; i--; ) {
+      if( bkt_used[i] ) {
+        if( run_used ) fd_ed25519_point_add( run, run, &bkt[i] );
+        else           fd_ed25519_point_set( run, &bkt[i] );
+        run_used = 1;
+      }
+      if( !run_used ) continue;
+      if( sum_used ) fd_ed25519_point_add( sum, sum, run );
+      else           fd_ed25519_point_set( sum, run );
+      sum_used = 1;
+    }
+    if( sum_used ) fd_ed25519_point_add( r, r, sum );
+  }
+  return r;
+}
+
 fd_ed25519_point_t *
 fd_ed25519_multi_scalar_mul( fd_ed25519_point_t *     r,
                              uchar const              n[], /* sz * 32 */
@@ -215,6 +326,20 @@ fd_ed25519_multi_scalar_mul( fd_ed25519_point_t *     r,
   fd_ed25519_point_t h[1];
   fd_ed25519_point_set_zero( r );
 
+  if( sz>=FD_BALLET_CURVE25519_MSM_PIPPENGER_MIN_SZ ) {
+    /* split into evenly sized batches, so that no batch is too small
+       to benefit from the bucket method */
+    ulong batch_cnt = (sz+FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ-1UL)/FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ;
+    for( ulong i=0; i<sz; ) {
+      ulong batch_sz = (sz-i+batch_cnt-1UL)/batch_cnt;
+      fd_ed25519_multi_scalar_mul_pippenger( h, &n[ 32*i ], &a[ i ], batch_sz );
+      fd_ed25519_point_add( r, r, h );
+      i += batch_sz;
+      batch_cnt--;
+    }
+    return r;
+  }
+
   for( ulong i=0; i<sz; i+=FD_BALLET_CURVE25519_MSM_BATCH_SZ ) {
     ulong batch_sz = fd_ulong_min(sz-i, FD_BALLET_CURVE25519_MSM_BATCH_SZ);
 
@@ -18,6 +18,13 @@
 /* Max batch size for MSM. */
 #define FD_BALLET_CURVE25519_MSM_BATCH_SZ 32
 
+/* MSMs of at least FD_BALLET_CURVE25519_MSM_PIPPENGER_MIN_SZ points use
+   the bucket method (Pippenger), in batches of at most
+   FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ points.  Smaller MSMs use
+   Straus in batches of FD_BALLET_CURVE25519_MSM_BATCH_SZ points. */
+#define FD_BALLET_CURVE25519_MSM_PIPPENGER_MIN_SZ   64
+#define FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ 512
+
 /* curve constants. these are imported from table/fd_curve25519_table_{arch}.c.
    they are (re)defined here to avoid breaking compilation when the table needs
    to be rebuilt. */
@@ -161,7 +168,9 @@ fd_ed25519_double_scalar_mul_base( fd_ed25519_point_t *       r,
                                    uchar const                n2[ 32 ] );
 
 /* fd_ed25519_multi_scalar_mul computes r = n0 * a0 + n1 * a1 + ..., and returns r.
-   n is a vector of sz scalars. a is a vector of sz points. */
+   n is a vector of sz scalars. a is a vector of sz points.
+   Large MSMs (see FD_BALLET_CURVE25519_MSM_PIPPENGER_MIN_SZ) use the
+   bucket method, ~1.6x faster than Straus for 1024 points. */
 fd_ed25519_point_t *
 fd_ed25519_multi_scalar_mul( fd_ed25519_point_t *     r,
                              uchar const              n[], /* sz * 32 */
@@ -72,6 +72,46 @@ fd_ed25519_sign( uchar         sig[ 64 ],
                  uchar const   private_key[ 32 ],
                  fd_sha512_t * sha );
 
+/* FD_ED25519_SIGN_BATCH_HEADROOM is the number of bytes of scratch
+   space fd_ed25519_sign_batch requires in front of each message. */
+
+#define FD_ED25519_SIGN_BATCH_HEADROOM (64UL)
+
+/* fd_ed25519_sign_batch signs batch_cnt messages with the same key
+   pair, producing the same signatures as batch_cnt calls to
+   fd_ed25519_sign.  The private key is expanded once for the whole
+   batch, and the public k = SHA-512(R || A || M) hashes are done with
+   the multi-buffer fd_sha512_batch API.  The nonce hashes, which cover
+   secret key material, go through sha like in fd_ed25519_sign.
+
+   sigs[i] is assumed to point to the first byte of a 64-byte memory
+   region which will hold the signature of message i on return.
+
+   bufs[i] is assumed to point to the first byte of a
+   FD_ED25519_SIGN_BATCH_HEADROOM+msg_szs[i] byte memory region.  The
+   message to sign starts at bufs[i]+FD_ED25519_SIGN_BATCH_HEADROOM,
+   and the headroom in front of it is used as scratch space so that
+   no message needs to be copied to be hashed.  On return, the headroom
+   holds public data (the signature's R and the public key) and the
+   message is unchanged.
+
+   public_key, private_key and sha are as in fd_ed25519_sign.
+
+   Does no input argument checking.  batch_cnt==0 is fine.  Sanitizes
+   the sha and stack to minimize risk of leaking private key info after
+   return.  The caller takes a write interest in sigs, bufs and sha and
+   a read interest in public_key and private_key for the duration of
+   the call. */
+
+void FD_FN_SENSITIVE
+fd_ed25519_sign_batch( uchar *       const sigs[], /* batch_cnt */
+                       uchar *       const bufs[], /* batch_cnt */
+                       ulong const         msg_szs[], /* batch_cnt */
+                       ulong               batch_cnt,
+                       uchar const         public_key[ 32 ],
+                       uchar const         private_key[ 32 ],
+                       fd_sha512_t *       sha );
+
 /* fd_ed25519_verify verifies message according to the ED25519 standard.
 
    msg is assumed to point to the first byte of a sz byte memory region
@@ -129,6 +169,58 @@ fd_ed25519_verify_batch_single_msg( uchar const   msg[], /* msg_sz */
                                     fd_sha512_t * shas[ 1 ],               /* batch_sz */
                                     uchar const   batch_sz );
 
+/* fd_ed25519_verify_batch_multi_msg verifies a batch of batch_sz
+   independent (message, signature, public key) triples, e.g. the CRDS
+   values of a gossip packet where every value has its own signer.
+
+   msgs[i] / msg_szs[i] describe the i-th message (msg_szs[i]==0 fine,
+   msgs[i]==NULL fine if msg_szs[i]==0), sigs[i] points to its 64-byte
+   signature and public_keys[i] to its 32-byte public key.
+
+   blind points to 16*batch_sz bytes that must be unpredictable to
+   whoever produced the signatures (e.g. the output of a CSPRNG seeded
+   from fd_rng_secure).  They are used as the coefficients of a random
+   linear combination of the individual verification equations, which
+   is checked with a single multi-scalar multiplication per group of
+   FD_ED25519_VERIFY_BATCH_MULTI_MSG_GROUP_SZ signatures.  If the
+   combined check fails, the group falls back to verifying each triple
+   individually with fd_ed25519_verify, so the failing entries are
+   always identified.
+
+   errs must have room for batch_sz ints.  On return, errs[i] holds
+   FD_ED25519_SUCCESS or the same FD_ED25519_ERR_* code that
+   fd_ed25519_verify would have returned for the i-th triple, with one
+   caveat.  The combined check is exact on the prime order subgroup (a
+   bad signature slips through with probability ~2^-128) but it cannot
+   see small order (torsion) components of R and A' without a full
+   scalar multiplication per point, which costs more than verifying
+   individually.  A set of signatures whose only defects are small
+   order components (e.g. valid signatures with a point of order 2
+   added to R, which anyone can produce) passes the combined check with
+   probability at most 1/2 over the choice of blind (1/2 for order 2
+   components in R, less for higher orders; torsion in A' gets
+   multiplied by z_j*k_j mod L rather than z_j*k_j, so for A' this
+   bound is heuristic).  fd_ed25519_verify rejects such signatures.
+   Honestly generated signatures never have small order components, but
+   callers whose accept set must match fd_ed25519_verify exactly (e.g.
+   anything that other validators also verify, like gossip CRDS values)
+   must verify individually instead.
+
+   Returns FD_ED25519_SUCCESS if every triple verified, or the error
+   code of the first failing triple otherwise.  batch_sz==0 is fine. */
+
+#define FD_ED25519_VERIFY_BATCH_MULTI_MSG_GROUP_SZ (15UL)
+
+int
+fd_ed25519_verify_batch_multi_msg( uchar const * const msgs[],        /* batch_sz */
+                                   ulong const         msg_szs[],     /* batch_sz */
+                                   uchar const * const sigs[],        /* batch_sz, 64 bytes each */
+                                   uchar const * const public_keys[], /* batch_sz, 32 bytes each */
+                                   uchar const         blind[],       /* 16 * batch_sz */
+                                   int                 errs[],        /* batch_sz */
+                                   ulong               batch_sz,
+                                   fd_sha512_t *       sha );
+
 /* fd_ed25519_strerror converts an FD_ED25519_SUCCESS / FD_ED25519_ERR_*
    code into a human readable cstr.  The lifetime of the returned
    pointer is infinite.  The returned pointer is always to a non-NULL
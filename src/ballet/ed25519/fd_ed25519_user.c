@@ -132,6 +132,81 @@ fd_ed25519_sign( uchar         sig[ static 64 ],
   return sig;
 }
 
+void FD_FN_SENSITIVE
+fd_ed25519_sign_batch( uchar *       const sigs[],
+                       uchar *       const bufs[],
+                       ulong const         msg_szs[],
+                       ulong               batch_cnt,
+                       uchar const         public_key[ static 32 ],
+                       uchar const         private_key[ static 32 ],
+                       fd_sha512_t *       sha ) {
+  if( FD_UNLIKELY( !batch_cnt ) ) return;
+
+  /* See fd_ed25519_sign for the RFC 8032 steps.  The expanded private
+     key (step 1) only depends on the key, so it is computed once. */
+
+  uchar s[ FD_SHA512_HASH_SZ ];
+  fd_sha512_fini( fd_sha512_append( fd_sha512_init( sha ), private_key, 32UL ), s );
+  s[ 0] &= (uchar)0xF8;
+  s[31] &= (uchar)0x7F;
+  s[31] |= (uchar)0x40;
+  uchar * h = s + 32;
+
+  /* The messages are processed in chunks that fill the SHA-512 batch
+     lanes. */
+
+  uchar r[ FD_SHA512_BATCH_MAX ][ FD_SHA512_HASH_SZ ];
+  uchar k[ FD_SHA512_BATCH_MAX ][ FD_SHA512_HASH_SZ ];
+
+  for( ulong b0=0UL; b0<batch_cnt; b0+=FD_SHA512_BATCH_MAX ) {
+    ulong cnt = fd_ulong_min( batch_cnt-b0, FD_SHA512_BATCH_MAX );
+
+    /* Step 2: r_i = SHA-512(prefix || M_i).  The prefix is secret, so
+       this goes through the caller's sha (cleared below) rather than
+       the batch API, which does not scrub its lanes or tail blocks. */
+
+    for( ulong i=0UL; i<cnt; i++ ) {
+      fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ), h, 32UL ),
+                      bufs[ b0+i ]+FD_ED25519_SIGN_BATCH_HEADROOM, msg_szs[ b0+i ] ), r[ i ] );
+    }
+
+    /* Step 3: R_i = [r_i]B */
+
+    for( ulong i=0UL; i<cnt; i++ ) {
+      uchar * buf = bufs[ b0+i ];
+      fd_curve25519_scalar_reduce( r[ i ], r[ i ] );
+      fd_ed25519_point_t R[1];
+      fd_ed25519_scalar_mul_base_const_time( R, r[ i ] );
+      fd_ed25519_point_tobytes( sigs[ b0+i ], R );
+      memcpy( buf,      sigs[ b0+i ], 32UL );
+      memcpy( buf+32UL, public_key,   32UL );
+    }
+
+    /* Step 4: k_i = SHA-512(R_i || A || M_i).  All inputs are public,
+       so these are batched. */
+
+    fd_sha512_batch_t _batch[1] __attribute__((aligned(FD_SHA512_BATCH_ALIGN)));
+    fd_sha512_batch_t * batch = fd_sha512_batch_init( _batch );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      fd_sha512_batch_add( batch, bufs[ b0+i ], 64UL+msg_szs[ b0+i ], k[ i ] );
+    }
+    fd_sha512_batch_fini( batch );
+
+    /* Steps 5 and 6: S_i = (r_i + k_i * s) mod L */
+
+    for( ulong i=0UL; i<cnt; i++ ) {
+      fd_curve25519_scalar_reduce( k[ i ], k[ i ] );
+      fd_curve25519_scalar_muladd( sigs[ b0+i ]+32, k[ i ], s, r[ i ] );
+    }
+  }
+
+  /* Sanitize */
+
+  fd_memset_explicit( s, 0, FD_SHA512_HASH_SZ );
+  fd_memset_explicit( r, 0, sizeof(r) );
+  fd_sha512_clear( sha );
+}
+
 int
 fd_ed25519_verify( uchar const   msg[], /* msg_sz */
                    ulong         msg_sz,
@@ -309,6 +384,138 @@ int fd_ed25519_verify_batch_single_msg( uchar const   msg[], /* msg_sz */
 #undef MAX
 }
 
+/* The multi-scalar multiplication below takes the base point plus
+   (R_j, A'_j) for every signature in the group, and is limited to
+   FD_BALLET_CURVE25519_MSM_BATCH_SZ points. */
+
+FD_STATIC_ASSERT( 1UL+2UL*FD_ED25519_VERIFY_BATCH_MULTI_MSG_GROUP_SZ<=FD_BALLET_CURVE25519_MSM_BATCH_SZ, msm_batch_sz );
+
+static int
+fd_ed25519_verify_batch_multi_msg_group( uchar const * const msgs[],
+                                         ulong const         msg_szs[],
+                                         uchar const * const sigs[],
+                                         uchar const * const public_keys[],
+                                         uchar const         blind[],
+                                         int                 errs[],
+                                         ulong               group_sz,
+                                         fd_sha512_t *       sha ) {
+#define MAX FD_ED25519_VERIFY_BATCH_MULTI_MSG_GROUP_SZ
+
+  /* Given random z_j, all signatures are valid (whp) iff
+       [- sum z_j S_j] B + sum [z_j] R_j + sum [z_j k_j] A'_j = 0
+     Point j+1 (resp. MAX+1+j) and its scalar hold R_j (resp. A'_j).
+     Point 0 is ignored by fd_ed25519_multi_scalar_mul_base. */
+
+  fd_ed25519_point_t pt[ 1UL+2UL*MAX ];
+  uchar              n [ 32UL*(1UL+2UL*MAX) ];
+  ulong              idx[ MAX ];
+  uchar              zS[ 32 ];
+  fd_curve25519_scalar_set( zS, fd_curve25519_scalar_zero );
+
+  /* Same checks as fd_ed25519_verify, failures are excluded from the
+     combined equation. */
+
+  ulong cnt = 0UL;
+  for( ulong j=0UL; j<group_sz; j++ ) {
+    uchar const * r          = sigs[ j ];
+    uchar const * S          = sigs[ j ] + 32;
+    uchar const * public_key = public_keys[ j ];
+
+    if( FD_UNLIKELY( !fd_curve25519_scalar_validate( S ) ) ) {
+      errs[ j ] = FD_ED25519_ERR_SIG;
+      continue;
+    }
+
+    fd_ed25519_point_t * R      = &pt[ 1UL+cnt     ];
+    fd_ed25519_point_t * Aprime = &pt[ 1UL+MAX+cnt ];
+    int res = fd_ed25519_point_frombytes_2x( Aprime, public_key, R, r );
+    if( FD_UNLIKELY( res ) ) {
+      errs[ j ] = res==1 ? FD_ED25519_ERR_PUBKEY : FD_ED25519_ERR_SIG;
+      continue;
+    }
+    if( FD_UNLIKELY( fd_ed25519_affine_is_small_order( Aprime ) ) ) {
+      errs[ j ] = FD_ED25519_ERR_PUBKEY;
+      continue;
+    }
+    if( FD_UNLIKELY( fd_ed25519_affine_is_small_order( R ) ) ) {
+      errs[ j ] = FD_ED25519_ERR_SIG;
+      continue;
+    }
+
+    uchar k[ 64 ];
+    fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
+                    r, 32UL ), public_key, 32UL ), msgs[ j ], msg_szs[ j ] ), k );
+    fd_curve25519_scalar_reduce( k, k );
+
+    /* z_j is a uniform 128-bit random scalar.  It must not be forced
+       odd (or otherwise constrained mod 8): with odd z_j two signatures
+       whose R or A' carry the same order 2 component would cancel in
+       the combined equation every time.  z_j==0 (probability 2^-128)
+       would drop the signature from the check, so it is replaced. */
+    uchar * z = &n[ 32UL*(1UL+cnt) ];
+    fd_memcpy( z, blind+16UL*j, 16UL );
+    fd_memset( z+16, 0, 16UL );
+    if( FD_UNLIKELY( !fd_ulong_load_8( z ) && !fd_ulong_load_8( z+8 ) ) ) z[ 0 ] = (uchar)1;
+
+    fd_curve25519_scalar_mul   ( &n[ 32UL*(1UL+MAX+cnt) ], z, k );
+    fd_curve25519_scalar_muladd( zS, z, S, zS );
+
+    errs[ j ] = FD_ED25519_SUCCESS;
+    idx[ cnt++ ] = j;
+  }
+
+  if( FD_UNLIKELY( !cnt ) ) return errs[ 0 ];
+
+  /* Compact the A'_j after the R_j */
+  if( cnt<MAX ) {
+    memmove( &pt[ 1UL+cnt ],     &pt[ 1UL+MAX ],     cnt*sizeof(fd_ed25519_point_t) );
+    memmove( &n [ 32UL*(1UL+cnt) ], &n[ 32UL*(1UL+MAX) ], 32UL*cnt );
+  }
+  fd_curve25519_scalar_neg( n, zS );
+
+  fd_ed25519_point_t res[1];
+  fd_ed25519_multi_scalar_mul_base( res, n, pt, 1UL+2UL*cnt );
+
+  int err_first = FD_ED25519_SUCCESS;
+  if( FD_UNLIKELY( !fd_ed25519_point_is_zero( res ) ) ) {
+    /* At least one signature is bad, find which */
+    for( ulong i=0UL; i<cnt; i++ ) {
+      ulong j = idx[ i ];
+      errs[ j ] = fd_ed25519_verify( msgs[ j ], msg_szs[ j ], sigs[ j ], public_keys[ j ], sha );
+    }
+  }
+  for( ulong j=0UL; j<group_sz; j++ ) {
+    if( FD_UNLIKELY( errs[ j ]!=FD_ED25519_SUCCESS ) ) { err_first = errs[ j ]; break; }
+  }
+  return err_first;
+#undef MAX
+}
+
+int
+fd_ed25519_verify_batch_multi_msg( uchar const * const msgs[],
+                                   ulong const         msg_szs[],
+                                   uchar const * const sigs[],
+                                   uchar const * const public_keys[],
+                                   uchar const         blind[],
+                                   int                 errs[],
+                                   ulong               batch_sz,
+                                   fd_sha512_t *       sha ) {
+  int err_first = FD_ED25519_SUCCESS;
+  for( ulong off=0UL; off<batch_sz; off+=FD_ED25519_VERIFY_BATCH_MULTI_MSG_GROUP_SZ ) {
+    ulong group_sz = fd_ulong_min( batch_sz-off, FD_ED25519_VERIFY_BATCH_MULTI_MSG_GROUP_SZ );
+    int   err;
+    if( FD_UNLIKELY( group_sz==1UL ) ) {
+      /* A lone signature is cheaper to verify directly */
+      err = errs[ off ] = fd_ed25519_verify( msgs[ off ], msg_szs[ off ], sigs[ off ], public_keys[ off ], sha );
+    } else {
+      err = fd_ed25519_verify_batch_multi_msg_group( msgs+off, msg_szs+off, sigs+off, public_keys+off,
+                                                     blind+16UL*off, errs+off, group_sz, sha );
+    }
+    if( FD_UNLIKELY( err && !err_first ) ) err_first = err;
+  }
+  return err_first;
+}
+
 char const *
 fd_ed25519_strerror( int err ) {
   switch( err ) {
@@ -902,6 +902,60 @@ test_sign( fd_rng_t *    rng,
   }
 }
 
+void
+test_sign_batch( fd_rng_t *    rng,
+                 fd_sha512_t * sha ) {
+# define BATCH_MAX (16UL)
+  uchar _buf[ BATCH_MAX ][ FD_ED25519_SIGN_BATCH_HEADROOM+256UL ];
+  uchar _sig[ BATCH_MAX ][ 64 ];
+  uchar _exp[ BATCH_MAX ][ 64 ];
+  uchar _msg[ BATCH_MAX ][ 256 ];
+  uchar * bufs[ BATCH_MAX ];
+  uchar * sigs[ BATCH_MAX ];
+  ulong   szs [ BATCH_MAX ];
+  uchar _pub[ 32 ]; uchar * pub = _pub;
+  uchar _prv[ 32 ]; uchar * prv = _prv;
+
+  for( ulong j=0UL; j<BATCH_MAX; j++ ) { bufs[ j ] = _buf[ j ]; sigs[ j ] = _sig[ j ]; }
+
+  /* Signatures match fd_ed25519_sign for every batch size (including
+     partial SHA-512 batches) and the messages are left untouched. */
+
+  for( ulong rem=256UL; rem; rem-- ) {
+    fd_ed25519_public_from_private( pub, fd_rng_b256( rng, prv ), sha );
+    ulong batch_cnt = fd_rng_ulong_roll( rng, BATCH_MAX+1UL );
+    for( ulong j=0UL; j<batch_cnt; j++ ) {
+      szs[ j ] = fd_rng_ulong_roll( rng, 257UL );
+      for( ulong b=0UL; b<szs[ j ]; b++ ) _msg[ j ][ b ] = fd_rng_uchar( rng );
+      fd_memcpy( _buf[ j ]+FD_ED25519_SIGN_BATCH_HEADROOM, _msg[ j ], szs[ j ] );
+      fd_ed25519_sign( _exp[ j ], _msg[ j ], szs[ j ], pub, prv, sha );
+    }
+    fd_ed25519_sign_batch( sigs, bufs, szs, batch_cnt, pub, prv, sha );
+    for( ulong j=0UL; j<batch_cnt; j++ ) {
+      FD_TEST( fd_memeq( _sig[ j ], _exp[ j ], 64UL ) );
+      FD_TEST( fd_memeq( _buf[ j ]+FD_ED25519_SIGN_BATCH_HEADROOM, _msg[ j ], szs[ j ] ) );
+      FD_TEST( fd_memeq( _buf[ j ]+32UL, pub, 32UL ) ); /* prefix wiped */
+    }
+  }
+
+  /* Bench signing 32 byte messages (eg. shred Merkle roots) */
+
+  for( ulong j=0UL; j<BATCH_MAX; j++ ) szs[ j ] = 32UL;
+  ulong iter = 1000UL;
+  for( ulong batch_cnt=1UL; batch_cnt<=BATCH_MAX; batch_cnt*=2UL ) {
+    long dt = fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) {
+      FD_COMPILER_FORGET( prv ); FD_COMPILER_FORGET( pub ); FD_COMPILER_FORGET( sha );
+      fd_ed25519_sign_batch( sigs, bufs, szs, batch_cnt, pub, prv, sha );
+    }
+    dt = fd_log_wallclock() - dt;
+
+    char cstr[128];
+    log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_ed25519_sign_batch(32) x%lu", batch_cnt ), iter*batch_cnt, dt );
+  }
+# undef BATCH_MAX
+}
+
 void
 test_verify( fd_rng_t *    rng,
              fd_sha512_t * sha ) {
@@ -1069,6 +1123,152 @@ test_verify( fd_rng_t *    rng,
   }
 }
 
+void
+test_verify_batch_multi_msg( fd_rng_t *    rng,
+                             fd_sha512_t * sha ) {
+# define BATCH_MAX (40UL)
+  static uchar  _msg [ BATCH_MAX ][ 256 ];
+  static uchar  _pub [ BATCH_MAX ][  32 ];
+  static uchar  _sig [ BATCH_MAX ][  64 ];
+  uchar const * msgs [ BATCH_MAX ];
+  ulong         szs  [ BATCH_MAX ];
+  uchar const * sigs [ BATCH_MAX ];
+  uchar const * pubs [ BATCH_MAX ];
+  uchar         blind[ 16UL*BATCH_MAX ];
+  int           errs [ BATCH_MAX ];
+
+  for( ulong j=0UL; j<BATCH_MAX; j++ ) {
+    uchar prv[ 32 ];
+    szs[ j ] = (ulong)fd_rng_uint_roll( rng, 257U );
+    for( ulong b=0UL; b<szs[ j ]; b++ ) _msg[ j ][ b ] = fd_rng_uchar( rng );
+    fd_ed25519_public_from_private( _pub[ j ], fd_rng_b256( rng, prv ), sha );
+    fd_ed25519_sign( _sig[ j ], _msg[ j ], szs[ j ], _pub[ j ], prv, sha );
+    msgs[ j ] = _msg[ j ]; sigs[ j ] = _sig[ j ]; pubs[ j ] = _pub[ j ];
+  }
+
+  /* All good, every batch size (including groups of 1) */
+
+  for( ulong batch_sz=0UL; batch_sz<=BATCH_MAX; batch_sz++ ) {
+    for( ulong b=0UL; b<16UL*batch_sz; b++ ) blind[ b ] = fd_rng_uchar( rng );
+    FD_TEST( fd_ed25519_verify_batch_multi_msg( msgs, szs, sigs, pubs, blind, errs, batch_sz, sha )==FD_ED25519_SUCCESS );
+    for( ulong j=0UL; j<batch_sz; j++ ) FD_TEST( errs[ j ]==FD_ED25519_SUCCESS );
+  }
+
+  /* Random corruptions must be identified exactly as fd_ed25519_verify
+     would */
+
+  for( ulong iter=0UL; iter<1000UL; iter++ ) {
+    ulong batch_sz = 1UL+(ulong)fd_rng_uint_roll( rng, (uint)BATCH_MAX );
+    for( ulong b=0UL; b<16UL*batch_sz; b++ ) blind[ b ] = fd_rng_uchar( rng );
+
+    ulong bad_cnt = (ulong)fd_rng_uint_roll( rng, 4U );
+    for( ulong i=0UL; i<bad_cnt; i++ ) {
+      ulong j = (ulong)fd_rng_uint_roll( rng, (uint)batch_sz );
+      switch( fd_rng_uint_roll( rng, 3U ) ) {
+      case 0U: { ulong idx = (ulong)fd_rng_uint_roll( rng, 512U ); _sig[ j ][ idx>>3 ] ^= (uchar)(1UL<<(idx&7UL)); break; }
+      case 1U: { ulong idx = (ulong)fd_rng_uint_roll( rng, 256U ); _pub[ j ][ idx>>3 ] ^= (uchar)(1UL<<(idx&7UL)); break; }
+      default: { if( !szs[ j ] ) break;
+                 ulong idx = (ulong)fd_rng_uint_roll( rng, 8U*(uint)szs[ j ] ); _msg[ j ][ idx>>3 ] ^= (uchar)(1UL<<(idx&7UL)); break; }
+      }
+    }
+
+    int err_first = FD_ED25519_SUCCESS;
+    for( ulong j=0UL; j<batch_sz; j++ ) {
+      int ref = fd_ed25519_verify( msgs[ j ], szs[ j ], sigs[ j ], pubs[ j ], sha );
+      if( ref && !err_first ) err_first = ref;
+    }
+    FD_TEST( fd_ed25519_verify_batch_multi_msg( msgs, szs, sigs, pubs, blind, errs, batch_sz, sha )==err_first );
+    for( ulong j=0UL; j<batch_sz; j++ ) {
+      FD_TEST( errs[ j ]==fd_ed25519_verify( msgs[ j ], szs[ j ], sigs[ j ], pubs[ j ], sha ) );
+      if( FD_UNLIKELY( errs[ j ] ) ) { /* re-sign so the next iteration starts clean */
+        uchar prv[ 32 ];
+        fd_ed25519_public_from_private( _pub[ j ], fd_rng_b256( rng, prv ), sha );
+        fd_ed25519_sign( _sig[ j ], _msg[ j ], szs[ j ], _pub[ j ], prv, sha );
+      }
+    }
+  }
+
+  /* Torsioned pair: signatures whose nonce point is R+T with T the
+     point of order 2, signed consistently over R+T (S = r + k a with
+     k = H(R+T,A,M)).  fd_ed25519_verify rejects them (it does not
+     multiply by the cofactor) but their only defect is T, so the
+     combined check sees (z_0+z_1) T.  It must reject whenever z_0+z_1
+     is odd, and over random blinds about half of the time (coefficients
+     forced odd used to cancel the pair every time). */
+
+  do {
+    static uchar const t2[ 32 ] = { 0xec,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+                                    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0x7f };
+    fd_ed25519_point_t T[1]; FD_TEST( !!fd_ed25519_point_frombytes( T, t2 ) );
+    for( ulong j=0UL; j<2UL; j++ ) {
+      uchar a[ 64 ]; uchar r[ 64 ]; uchar k[ 64 ];
+      fd_rng_b256( rng, a ); fd_rng_b256( rng, a+32 ); fd_curve25519_scalar_reduce( a, a );
+      fd_rng_b256( rng, r ); fd_rng_b256( rng, r+32 ); fd_curve25519_scalar_reduce( r, r );
+      fd_ed25519_point_t P[1];
+      fd_ed25519_point_tobytes( _pub[ j ], fd_ed25519_scalar_mul_base_const_time( P, a ) );
+      fd_ed25519_point_add( P, fd_ed25519_scalar_mul_base_const_time( P, r ), T );
+      fd_ed25519_point_tobytes( _sig[ j ], P );
+      fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
+                      _sig[ j ], 32UL ), _pub[ j ], 32UL ), _msg[ j ], szs[ j ] ), k );
+      fd_curve25519_scalar_reduce( k, k );
+      fd_curve25519_scalar_muladd( _sig[ j ]+32, k, a, r );
+      FD_TEST( fd_ed25519_verify( msgs[ j ], szs[ j ], sigs[ j ], pubs[ j ], sha )==FD_ED25519_ERR_MSG );
+    }
+
+    for( ulong b=0UL; b<32UL; b++ ) blind[ b ] = fd_rng_uchar( rng );
+    blind[  0 ] |= (uchar)1;
+    blind[ 16 ] &= (uchar)0xfe;
+    FD_TEST( fd_ed25519_verify_batch_multi_msg( msgs, szs, sigs, pubs, blind, errs, 2UL, sha )==FD_ED25519_ERR_MSG );
+    FD_TEST( errs[ 0 ]==FD_ED25519_ERR_MSG && errs[ 1 ]==FD_ED25519_ERR_MSG );
+
+    /* Same with the pair inside a larger group of good signatures */
+    for( ulong b=0UL; b<16UL*BATCH_MAX; b++ ) blind[ b ] = fd_rng_uchar( rng );
+    blind[ 16 ] = (uchar)( blind[ 0 ] ^ 1 );
+    FD_TEST( fd_ed25519_verify_batch_multi_msg( msgs, szs, sigs, pubs, blind, errs, 15UL, sha )==FD_ED25519_ERR_MSG );
+    FD_TEST( errs[ 0 ]==FD_ED25519_ERR_MSG && errs[ 1 ]==FD_ED25519_ERR_MSG );
+    for( ulong j=2UL; j<15UL; j++ ) FD_TEST( errs[ j ]==FD_ED25519_SUCCESS );
+
+    ulong reject_cnt = 0UL;
+    for( ulong iter=0UL; iter<256UL; iter++ ) {
+      for( ulong b=0UL; b<32UL; b++ ) blind[ b ] = fd_rng_uchar( rng );
+      int err = fd_ed25519_verify_batch_multi_msg( msgs, szs, sigs, pubs, blind, errs, 2UL, sha );
+      FD_TEST( err==( ((blind[ 0 ]^blind[ 16 ])&1) ? FD_ED25519_ERR_MSG : FD_ED25519_SUCCESS ) );
+      if( err ) { reject_cnt++; FD_TEST( errs[ 0 ]==FD_ED25519_ERR_MSG && errs[ 1 ]==FD_ED25519_ERR_MSG ); }
+    }
+    FD_TEST( reject_cnt>=64UL && reject_cnt<=192UL );
+
+    /* A single torsioned signature can't cancel with anything when its
+       coefficient is odd */
+    for( ulong b=0UL; b<32UL; b++ ) blind[ b ] = fd_rng_uchar( rng );
+    blind[ 0 ] |= (uchar)1;
+    FD_TEST( fd_ed25519_verify_batch_multi_msg( msgs+1, szs+1, sigs+1, pubs+1, blind, errs, 2UL, sha )==FD_ED25519_ERR_MSG );
+    FD_TEST( errs[ 0 ]==FD_ED25519_ERR_MSG && errs[ 1 ]==FD_ED25519_SUCCESS );
+
+    for( ulong j=0UL; j<2UL; j++ ) {
+      uchar prv[ 32 ];
+      fd_ed25519_public_from_private( _pub[ j ], fd_rng_b256( rng, prv ), sha );
+      fd_ed25519_sign( _sig[ j ], _msg[ j ], szs[ j ], _pub[ j ], prv, sha );
+    }
+  } while(0);
+
+  /* Bench against one-at-a-time verification */
+
+  ulong iter = 1000UL;
+  for( ulong batch_sz=1UL; batch_sz<=32UL; batch_sz<<=1 ) {
+    for( ulong j=0UL; j<batch_sz; j++ ) FD_TEST( !fd_ed25519_verify( msgs[ j ], szs[ j ], sigs[ j ], pubs[ j ], sha ) );
+    long dt = fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) {
+      fd_ed25519_verify_batch_multi_msg( msgs, szs, sigs, pubs, blind, errs, batch_sz, sha );
+    }
+    dt = fd_log_wallclock() - dt;
+    char cstr[128];
+    log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_..._verify_batch_multi_msg(%lu)", batch_sz ), iter*batch_sz, dt );
+  }
+
+  FD_LOG_NOTICE(( "fd_ed25519_verify_batch_multi_msg: ok" ));
+# undef BATCH_MAX
+}
+
 void
 test_wycheproofs( fd_sha512_t * sha ) {
   char cstr[128];
@@ -1175,7 +1375,9 @@ main( int     argc,
 
   test_public_from_private( rng, sha );
   test_sign               ( rng, sha );
+  test_sign_batch         ( rng, sha );
   test_verify             ( rng, sha );
+  test_verify_batch_multi_msg( rng, sha );
 
   test_wycheproofs( sha );
   test_cctv       ( sha );
@@ -468,11 +468,51 @@ test_multiscalar_mul( fd_rng_t * rng ) {
     FD_TEST( fd_ristretto255_point_eq( h, t ) );
   }
 
+  /* Large MSMs (bucket method) vs sum of small MSMs (Straus) */
+#undef MSM_N
+#define MSM_N 1100
+  {
+    fd_ristretto255_point_t * f = aligned_alloc( alignof(fd_ristretto255_point_t), MSM_N * sizeof(fd_ristretto255_point_t) );
+    uchar (* a)[32] = aligned_alloc( 32UL, MSM_N * 32UL );
+    FD_TEST( f && a );
+
+    fd_ristretto255_point_t _t[1]; fd_ristretto255_point_t * t = _t;
+    fd_ristretto255_point_t _u[1]; fd_ristretto255_point_t * u = _u;
+    fd_ristretto255_point_decompress( t, base_point_multiples[1] );
+    for( ulong i=0; i<MSM_N; i++ ) {
+      uchar n[32]; fd_rng_b256( rng, n ); n[31] &= 0x0f;
+      fd_ristretto255_scalar_mul( &f[i], n, t );
+      fd_rng_b256( rng, a[i] ); a[i][31] &= 0x1f;
+    }
+    /* edge cases for the signed digit recoding (note: scalars must be
+       <2^255 for Straus) */
+    memset( a[0], 0xff, 32 ); a[0][31] = 0x1f;
+    memset( a[1], 0x00, 32 );
+    memset( a[2], 0x00, 32 ); a[2][31] = 0x10;
+    memset( a[3], 0x7f, 32 ); a[3][31] = 0x00;
+
+    ulong szs[] = { FD_BALLET_CURVE25519_MSM_PIPPENGER_MIN_SZ, 200, 513, MSM_N };
+    for( ulong k=0; k<sizeof(szs)/sizeof(szs[0]); k++ ) {
+      ulong sz = szs[k];
+      FD_TEST( fd_ristretto255_multi_scalar_mul( h, (uchar *)a, f, sz )==h );
+      fd_ristretto255_point_set_zero( t );
+      for( ulong i=0; i<sz; i+=FD_BALLET_CURVE25519_MSM_BATCH_SZ ) {
+        ulong batch_sz = fd_ulong_min( sz-i, FD_BALLET_CURVE25519_MSM_BATCH_SZ );
+        FD_TEST( fd_ristretto255_multi_scalar_mul( u, a[i], &f[i], batch_sz )==u );
+        fd_ristretto255_point_add( t, t, u );
+      }
+      FD_TEST( fd_ristretto255_point_eq( h, t ) );
+    }
+
+    free( a );
+    free( f );
+  }
+
   /* Benchmarks */
   ulong iter = 10000UL;
 
 #undef MSM_N
-#define MSM_N 1024
+#define MSM_N 2048
 // to speed up decompression, we copy 15 points at a time, so we need to alloc a multiple of 15
 #define MSM_N_MALLOC (MSM_N/15+1)*15
   fd_ristretto255_point_t *   f = aligned_alloc( alignof(fd_ristretto255_point_t), MSM_N_MALLOC * sizeof(fd_ristretto255_point_t) );
@@ -488,6 +528,18 @@ test_multiscalar_mul( fd_rng_t * rng ) {
 
   for( ulong sz=32; sz<=MSM_N; sz*=2 )
   {
+    /* also bench just below the bucket method threshold */
+    if( sz==FD_BALLET_CURVE25519_MSM_PIPPENGER_MIN_SZ ) {
+      long dt = fd_log_wallclock();
+      for( ulong rem=iter/sz; rem; rem-- ) {
+        FD_COMPILER_FORGET( f ); FD_COMPILER_FORGET( a ); FD_COMPILER_FORGET( h );
+        fd_ristretto255_multi_scalar_mul( h, a, f, sz-1UL );
+      }
+      dt = fd_log_wallclock() - dt;
+      char cstr[128];
+      log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_ristretto255_multi_scalar_mul(%lu)", sz-1UL ), iter/sz, dt );
+    }
+
     long dt = fd_log_wallclock();
     for( ulong rem=iter/sz; rem; rem-- ) {
       FD_COMPILER_FORGET( f ); FD_COMPILER_FORGET( a ); FD_COMPILER_FORGET( h );
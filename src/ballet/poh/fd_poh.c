@@ -17,3 +17,28 @@ fd_poh_mixin( void *        FD_RESTRICT poh,
   fd_sha256_fini( &sha, poh );
   return poh;
 }
+
+ulong
+fd_poh_verify_entries( uchar const *          start,
+                       fd_poh_entry_t const * entry,
+                       ulong                  entry_cnt ) {
+  if( FD_UNLIKELY( !entry_cnt ) ) return ULONG_MAX;
+  if( FD_UNLIKELY( entry_cnt>FD_POH_VERIFY_ENTRY_MAX ) ) FD_LOG_CRIT(( "entry_cnt %lu too large", entry_cnt ));
+
+  uchar   poh[ FD_POH_VERIFY_ENTRY_MAX ][ FD_SHA256_HASH_SZ ] __attribute__((aligned(32)));
+  void *  hash[ FD_POH_VERIFY_ENTRY_MAX ];
+  ulong   cnt [ FD_POH_VERIFY_ENTRY_MAX ];
+  for( ulong i=0UL; i<entry_cnt; i++ ) {
+    memcpy( poh[ i ], i ? entry[ i-1UL ].hash : start, FD_SHA256_HASH_SZ );
+    hash[ i ] = poh[ i ];
+    cnt [ i ] = entry[ i ].has_mixin ? fd_ulong_sat_sub( entry[ i ].hashcnt, 1UL ) : entry[ i ].hashcnt;
+  }
+
+  fd_sha256_hash_32_repeated_multi( entry_cnt, hash, cnt );
+
+  for( ulong i=0UL; i<entry_cnt; i++ ) {
+    if( entry[ i ].has_mixin ) fd_poh_mixin( poh[ i ], entry[ i ].mixin );
+    if( FD_UNLIKELY( memcmp( poh[ i ], entry[ i ].hash, FD_SHA256_HASH_SZ ) ) ) return i;
+  }
+  return ULONG_MAX;
+}
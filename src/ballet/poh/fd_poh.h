@@ -29,6 +29,40 @@ void *
 fd_poh_mixin( void *        FD_RESTRICT poh,
               uchar const * FD_RESTRICT mixin );
 
+/* fd_poh_entry_t describes a PoH entry (a microblock header) to be
+   verified with fd_poh_verify_entries.  An entry with has_mixin set
+   (i.e. an entry with transactions) is hashcnt-1 fd_poh_append
+   iterations followed by an fd_poh_mixin of mixin.  Otherwise, it is
+   hashcnt fd_poh_append iterations.  hash is the PoH state claimed at
+   the end of the entry. */
+
+struct fd_poh_entry {
+  uchar hash [ FD_SHA256_HASH_SZ ];
+  uchar mixin[ FD_SHA256_HASH_SZ ]; /* Ignored if !has_mixin */
+  ulong hashcnt;
+  int   has_mixin;
+};
+
+typedef struct fd_poh_entry fd_poh_entry_t;
+
+/* FD_POH_VERIFY_ENTRY_MAX is the max number of entries verified by one
+   call to fd_poh_verify_entries. */
+
+#define FD_POH_VERIFY_ENTRY_MAX FD_SHA256_HASH_32_REPEATED_LANE_MAX
+
+/* fd_poh_verify_entries verifies entry_cnt in [0,FD_POH_VERIFY_ENTRY_MAX]
+   consecutive PoH entries, the first of which starts from the PoH state
+   start.  Every entry other than the first starts from the hash of the
+   previous entry, so the hash chains of all entries are independent and
+   are computed in parallel (see fd_sha256_hash_32_repeated_multi).
+   Returns the index of the first entry whose hash does not match, or
+   ULONG_MAX if all entries are valid. */
+
+ulong
+fd_poh_verify_entries( uchar const *          start,
+                       fd_poh_entry_t const * entry,
+                       ulong                  entry_cnt );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_ballet_poh_fd_poh_h */
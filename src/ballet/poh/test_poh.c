@@ -167,6 +167,61 @@ static fd_poh_test_vector_t const poh_test_vectors[] = {
 
 #undef _
 
+/* Split the steps of a test vector into entries (an entry ends with a
+   mixin, or with the last step) and check that fd_poh_verify_entries
+   accepts them and pinpoints corrupted entries. */
+static void
+test_poh_verify_entries( fd_poh_test_vector_t const * t ) {
+  fd_poh_entry_t entry[ FD_POH_VERIFY_ENTRY_MAX ];
+  ulong          entry_cnt = 0UL;
+  uchar          poh[ 32 ];
+  memcpy( poh, t->pre, 32UL );
+  memset( entry, 0, sizeof(entry) );
+  for( fd_poh_test_step_t const * step = t->steps; step->n >= 0; step++ ) {
+    fd_poh_entry_t * e = entry+entry_cnt;
+    if( step->n == 0 ) {
+      fd_poh_mixin( &poh, step->mixin );
+      memcpy( e->mixin, step->mixin, 32UL );
+      e->has_mixin = 1;
+      e->hashcnt++;
+    } else {
+      fd_poh_append( &poh, (ulong)step->n );
+      e->hashcnt += (ulong)step->n;
+    }
+    if( step->n == 0 || step[1].n < 0 ) {
+      memcpy( e->hash, poh, 32UL );
+      entry_cnt++;
+      FD_TEST( entry_cnt<=FD_POH_VERIFY_ENTRY_MAX );
+    }
+  }
+  FD_TEST( !memcmp( entry[ entry_cnt-1UL ].hash, t->post, 32UL ) );
+
+  FD_TEST( fd_poh_verify_entries( t->pre, entry, entry_cnt )==ULONG_MAX );
+  FD_TEST( fd_poh_verify_entries( t->pre, entry, 0UL       )==ULONG_MAX );
+
+  /* Corrupt the hash count, the mixin and the hash of an entry */
+  for( ulong i=0UL; i<entry_cnt; i++ ) {
+    entry[ i ].hashcnt++;
+    FD_TEST( fd_poh_verify_entries( t->pre, entry, entry_cnt )==i );
+    entry[ i ].hashcnt--;
+    if( entry[ i ].has_mixin ) {
+      entry[ i ].mixin[ 7 ] ^= 1;
+      FD_TEST( fd_poh_verify_entries( t->pre, entry, entry_cnt )==i );
+      entry[ i ].mixin[ 7 ] ^= 1;
+    }
+    entry[ i ].hash[ 31 ] ^= 1;
+    FD_TEST( fd_poh_verify_entries( t->pre, entry, entry_cnt )==i );
+    entry[ i ].hash[ 31 ] ^= 1;
+  }
+
+  /* An empty entry does not advance the PoH state */
+  memcpy( entry[ 0 ].hash, t->pre, 32UL );
+  entry[ 0 ].hashcnt   = 0UL;
+  entry[ 0 ].has_mixin = 0;
+  FD_TEST( fd_poh_verify_entries( t->pre, entry, 1UL )==ULONG_MAX );
+  FD_LOG_NOTICE(( "OK (%s, verify %lu entries)", t->name, entry_cnt ));
+}
+
 static void
 bench_poh_sequential( void ) {
   uchar poh[FD_SHA256_HASH_SZ] = {0};
@@ -201,6 +256,7 @@ int main( int argc,
 
   for( fd_poh_test_vector_t const * v = poh_test_vectors; v->name; v++ ) {
     test_poh_vector( v );
+    test_poh_verify_entries( v );
   }
 
   bench_poh_sequential();
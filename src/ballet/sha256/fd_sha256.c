@@ -559,7 +559,6 @@ fd_sha256_hash_32_repeated( void const * _data,
   }
   vu_stu( hash,      vu_bswap( w0003 ) );
   vu_stu( hash+16UL, vu_bswap( w0407 ) );
-#undef NEXT_W
 
 #else
 
@@ -607,4 +606,183 @@ fd_sha256_hash_32_repeated( void const * _data,
   return _hash;
 }
 
+#if FD_HAS_SHANI
+
+/* fd_sha256_private_hash_32_repeated_shani2 is the SHA-NI version of
+   the multi-lane kernels of fd_sha256_batch_avx{,512}.c for 2 lanes
+   (state[ 2*word + lane ] holds big endian word word of the hash in
+   lane lane).  Each sha256rnds2 depends on the previous one of the
+   same chain, so a single chain is latency bound.  Interleaving the
+   rounds of 2 independent chains roughly doubles the throughput. */
+
+#define FOUR_ROUNDS2( k, w0, w1 ) do {                                                           \
+    vu_t __k   = vu_ld( (k) );                                                                   \
+    vu_t __wk0 = vu_add( (w0), __k );                                                            \
+    vu_t __wk1 = vu_add( (w1), __k );                                                            \
+    vu_t __t0  = stateFEBA0;                                                                     \
+    vu_t __t1  = stateFEBA1;                                                                     \
+    stateFEBA0 = _mm_sha256rnds2_epu32( stateHGDC0, stateFEBA0, __wk0 );                         \
+    stateFEBA1 = _mm_sha256rnds2_epu32( stateHGDC1, stateFEBA1, __wk1 );                         \
+    stateHGDC0 = __t0;                                                                           \
+    stateHGDC1 = __t1;                                                                           \
+                                                                                                 \
+    __t0       = stateFEBA0;                                                                     \
+    __t1       = stateFEBA1;                                                                     \
+    stateFEBA0 = _mm_sha256rnds2_epu32( stateHGDC0, stateFEBA0, vu_permute( __wk0, 2,3,0,1 ) );  \
+    stateFEBA1 = _mm_sha256rnds2_epu32( stateHGDC1, stateFEBA1, vu_permute( __wk1, 2,3,0,1 ) );  \
+    stateHGDC0 = __t0;                                                                           \
+    stateHGDC1 = __t1;                                                                           \
+  } while( 0 )
+
+static void
+fd_sha256_private_hash_32_repeated_shani2( uint * state,
+                                           ulong  cnt ) {
+  vu_t w0003_0 = vu( state[ 0], state[ 2], state[ 4], state[ 6] );
+  vu_t w0407_0 = vu( state[ 8], state[10], state[12], state[14] );
+  vu_t w0003_1 = vu( state[ 1], state[ 3], state[ 5], state[ 7] );
+  vu_t w0407_1 = vu( state[ 9], state[11], state[13], state[15] );
+
+  vu_t const w080b = vu( 0x80000000U, 0U, 0U, 0U   );
+  vu_t const w0c0f = vu( 0U,          0U, 0U, 256U ); /* 32 bytes */
+
+  vu_t const initialFEBA = vu( FD_SHA256_INITIAL_F, FD_SHA256_INITIAL_E, FD_SHA256_INITIAL_B, FD_SHA256_INITIAL_A );
+  vu_t const initialHGDC = vu( FD_SHA256_INITIAL_H, FD_SHA256_INITIAL_G, FD_SHA256_INITIAL_D, FD_SHA256_INITIAL_C );
+
+  for( ulong iter=0UL; iter<cnt; iter++ ) {
+    vu_t stateFEBA0 = initialFEBA; vu_t stateHGDC0 = initialHGDC;
+    vu_t stateFEBA1 = initialFEBA; vu_t stateHGDC1 = initialHGDC;
+
+    /*                                                                                                                */ FOUR_ROUNDS2( fd_sha256_K+ 0UL, w0003_0, w0003_1 );
+    /*                                                                                                                */ FOUR_ROUNDS2( fd_sha256_K+ 4UL, w0407_0, w0407_1 );
+    /*                                                                                                                */ FOUR_ROUNDS2( fd_sha256_K+ 8UL, w080b, w080b );
+    /*                                                                                                                */ FOUR_ROUNDS2( fd_sha256_K+12UL, w0c0f, w0c0f );
+    vu_t w1013_0 = NEXT_W( w0003_0, w0407_0, w080b,   w0c0f   ); vu_t w1013_1 = NEXT_W( w0003_1, w0407_1, w080b,   w0c0f   ); FOUR_ROUNDS2( fd_sha256_K+16UL, w1013_0, w1013_1 );
+    vu_t w1417_0 = NEXT_W( w0407_0, w080b,   w0c0f,   w1013_0 ); vu_t w1417_1 = NEXT_W( w0407_1, w080b,   w0c0f,   w1013_1 ); FOUR_ROUNDS2( fd_sha256_K+20UL, w1417_0, w1417_1 );
+    vu_t w181b_0 = NEXT_W( w080b,   w0c0f,   w1013_0, w1417_0 ); vu_t w181b_1 = NEXT_W( w080b,   w0c0f,   w1013_1, w1417_1 ); FOUR_ROUNDS2( fd_sha256_K+24UL, w181b_0, w181b_1 );
+    vu_t w1c1f_0 = NEXT_W( w0c0f,   w1013_0, w1417_0, w181b_0 ); vu_t w1c1f_1 = NEXT_W( w0c0f,   w1013_1, w1417_1, w181b_1 ); FOUR_ROUNDS2( fd_sha256_K+28UL, w1c1f_0, w1c1f_1 );
+    vu_t w2023_0 = NEXT_W( w1013_0, w1417_0, w181b_0, w1c1f_0 ); vu_t w2023_1 = NEXT_W( w1013_1, w1417_1, w181b_1, w1c1f_1 ); FOUR_ROUNDS2( fd_sha256_K+32UL, w2023_0, w2023_1 );
+    vu_t w2427_0 = NEXT_W( w1417_0, w181b_0, w1c1f_0, w2023_0 ); vu_t w2427_1 = NEXT_W( w1417_1, w181b_1, w1c1f_1, w2023_1 ); FOUR_ROUNDS2( fd_sha256_K+36UL, w2427_0, w2427_1 );
+    vu_t w282b_0 = NEXT_W( w181b_0, w1c1f_0, w2023_0, w2427_0 ); vu_t w282b_1 = NEXT_W( w181b_1, w1c1f_1, w2023_1, w2427_1 ); FOUR_ROUNDS2( fd_sha256_K+40UL, w282b_0, w282b_1 );
+    vu_t w2c2f_0 = NEXT_W( w1c1f_0, w2023_0, w2427_0, w282b_0 ); vu_t w2c2f_1 = NEXT_W( w1c1f_1, w2023_1, w2427_1, w282b_1 ); FOUR_ROUNDS2( fd_sha256_K+44UL, w2c2f_0, w2c2f_1 );
+    vu_t w3033_0 = NEXT_W( w2023_0, w2427_0, w282b_0, w2c2f_0 ); vu_t w3033_1 = NEXT_W( w2023_1, w2427_1, w282b_1, w2c2f_1 ); FOUR_ROUNDS2( fd_sha256_K+48UL, w3033_0, w3033_1 );
+    vu_t w3437_0 = NEXT_W( w2427_0, w282b_0, w2c2f_0, w3033_0 ); vu_t w3437_1 = NEXT_W( w2427_1, w282b_1, w2c2f_1, w3033_1 ); FOUR_ROUNDS2( fd_sha256_K+52UL, w3437_0, w3437_1 );
+    vu_t w383b_0 = NEXT_W( w282b_0, w2c2f_0, w3033_0, w3437_0 ); vu_t w383b_1 = NEXT_W( w282b_1, w2c2f_1, w3033_1, w3437_1 ); FOUR_ROUNDS2( fd_sha256_K+56UL, w383b_0, w383b_1 );
+    vu_t w3c3f_0 = NEXT_W( w2c2f_0, w3033_0, w3437_0, w383b_0 ); vu_t w3c3f_1 = NEXT_W( w2c2f_1, w3033_1, w3437_1, w383b_1 ); FOUR_ROUNDS2( fd_sha256_K+60UL, w3c3f_0, w3c3f_1 );
+
+    stateFEBA0 = vu_add( stateFEBA0, initialFEBA ); stateHGDC0 = vu_add( stateHGDC0, initialHGDC );
+    stateFEBA1 = vu_add( stateFEBA1, initialFEBA ); stateHGDC1 = vu_add( stateHGDC1, initialHGDC );
+
+    w0003_0 = vu_permute2( stateFEBA0, stateHGDC0, 3, 2, 3, 2 ); w0407_0 = vu_permute2( stateFEBA0, stateHGDC0, 1, 0, 1, 0 );
+    w0003_1 = vu_permute2( stateFEBA1, stateHGDC1, 3, 2, 3, 2 ); w0407_1 = vu_permute2( stateFEBA1, stateHGDC1, 1, 0, 1, 0 );
+  }
+
+  uint out[ 16 ] __attribute__((aligned(16)));
+  vu_st( out,     w0003_0 ); vu_st( out+ 4, w0407_0 );
+  vu_st( out+ 8, w0003_1 ); vu_st( out+12, w0407_1 );
+  for( ulong word=0UL; word<8UL; word++ ) {
+    state[ 2UL*word     ] = out[ word     ];
+    state[ 2UL*word+1UL ] = out[ word+8UL ];
+  }
+}
+
+#undef FOUR_ROUNDS2
+
+#endif /* FD_HAS_SHANI */
+
+#if FD_HAS_AVX || FD_HAS_SHANI
+
+/* fd_sha256_private_hash_32_repeated_lanes implements
+   fd_sha256_hash_32_repeated_multi on top of a kernel that advances
+   all lane_cnt lanes of a transposed state by the same number of
+   iterations.  Whenever a chain is done, its lane is refilled with the
+   next chain, so the lanes stay busy even when the chains have very
+   different lengths (e.g. PoH ticks vs. microblocks).  Once a single
+   chain is left, it is finished with fd_sha256_hash_32_repeated. */
+
+static void
+fd_sha256_private_hash_32_repeated_lanes( ulong          chain_cnt,
+                                          void * const * hash,
+                                          ulong const *  cnt,
+                                          ulong          lane_cnt, /* in [2,FD_SHA256_HASH_32_REPEATED_LANE_MAX] */
+                                          void        (* advance)( uint * state, ulong cnt ) ) {
+  uint  state     [ 8UL*FD_SHA256_HASH_32_REPEATED_LANE_MAX ] __attribute__((aligned(64)));
+  ulong lane_chain[ FD_SHA256_HASH_32_REPEATED_LANE_MAX ];
+  ulong lane_rem  [ FD_SHA256_HASH_32_REPEATED_LANE_MAX ];
+  for( ulong lane=0UL; lane<lane_cnt; lane++ ) lane_rem[ lane ] = 0UL;
+
+  ulong next_chain = 0UL;
+  ulong busy_cnt;
+  ulong busy;
+  for(;;) {
+
+    /* Load the next chains into idle lanes and find how far all busy
+       lanes can be advanced */
+
+    ulong step = ULONG_MAX;
+    busy_cnt   = 0UL;
+    busy       = 0UL;
+    for( ulong lane=0UL; lane<lane_cnt; lane++ ) {
+      if( !lane_rem[ lane ] ) {
+        while( next_chain<chain_cnt && !cnt[ next_chain ] ) next_chain++;
+        if( next_chain<chain_cnt ) {
+          uchar const * h = (uchar const *)hash[ next_chain ];
+          for( ulong word=0UL; word<8UL; word++ ) state[ word*lane_cnt+lane ] = fd_uint_bswap( FD_LOAD( uint, h+4UL*word ) );
+          lane_chain[ lane ] = next_chain;
+          lane_rem  [ lane ] = cnt[ next_chain ];
+          next_chain++;
+        }
+      }
+      if( lane_rem[ lane ] ) {
+        step = fd_ulong_min( step, lane_rem[ lane ] );
+        busy_cnt++;
+        busy = lane;
+      }
+    }
+    if( FD_UNLIKELY( busy_cnt<2UL ) ) break;
+
+    advance( state, step );
+
+    for( ulong lane=0UL; lane<lane_cnt; lane++ ) {
+      if( !lane_rem[ lane ] ) continue;
+      lane_rem[ lane ] -= step;
+      if( lane_rem[ lane ] ) continue;
+      uchar * h = (uchar *)hash[ lane_chain[ lane ] ];
+      for( ulong word=0UL; word<8UL; word++ ) FD_STORE( uint, h+4UL*word, fd_uint_bswap( state[ word*lane_cnt+lane ] ) );
+    }
+  }
+
+  if( busy_cnt ) {
+    uchar * h = (uchar *)hash[ lane_chain[ busy ] ];
+    for( ulong word=0UL; word<8UL; word++ ) FD_STORE( uint, h+4UL*word, fd_uint_bswap( state[ word*lane_cnt+busy ] ) );
+    fd_sha256_hash_32_repeated( h, h, lane_rem[ busy ] );
+  }
+}
+
+#endif /* FD_HAS_AVX || FD_HAS_SHANI */
+
+void
+fd_sha256_hash_32_repeated_multi( ulong          chain_cnt,
+                                  void * const * hash,
+                                  ulong const *  cnt ) {
+
+  /* With SHA-NI, 2 interleaved chains hash about as fast as 8 AVX-512
+     lanes (and as 16 AVX lanes would).  So SHA-NI is preferred unless
+     there are enough chains to fill most of the AVX-512 lanes. */
+
+#if FD_HAS_AVX512 && FD_HAS_SHANI
+  if( chain_cnt<8UL ) fd_sha256_private_hash_32_repeated_lanes( chain_cnt, hash, cnt,  2UL, fd_sha256_private_hash_32_repeated_shani2 );
+  else                fd_sha256_private_hash_32_repeated_lanes( chain_cnt, hash, cnt, 16UL, fd_sha256_private_hash_32_repeated_avx512 );
+#elif FD_HAS_AVX512
+  fd_sha256_private_hash_32_repeated_lanes( chain_cnt, hash, cnt, 16UL, fd_sha256_private_hash_32_repeated_avx512 );
+#elif FD_HAS_SHANI
+  fd_sha256_private_hash_32_repeated_lanes( chain_cnt, hash, cnt,  2UL, fd_sha256_private_hash_32_repeated_shani2 );
+#elif FD_HAS_AVX
+  fd_sha256_private_hash_32_repeated_lanes( chain_cnt, hash, cnt,  8UL, fd_sha256_private_hash_32_repeated_avx    );
+#else
+  for( ulong chain_idx=0UL; chain_idx<chain_cnt; chain_idx++ )
+    fd_sha256_hash_32_repeated( hash[ chain_idx ], hash[ chain_idx ], cnt[ chain_idx ] );
+#endif
+}
+
+#undef NEXT_W
 #undef fd_sha256_core
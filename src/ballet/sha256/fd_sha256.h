@@ -167,6 +167,45 @@ fd_sha256_hash_32_repeated( void const * data,
                             void *       hash,
                             ulong        cnt );
 
+/* fd_sha256_hash_32_repeated_multi advances chain_cnt independent hash
+   chains.  It is equivalent to:
+
+   for( ulong i=0UL; i<chain_cnt; i++ ) fd_sha256_hash_32_repeated( hash[i], hash[i], cnt[i] );
+
+   but runs the chains side by side in the lanes of the fastest
+   SHA-256 implementation available (16 lanes with AVX-512, 2
+   interleaved chains with SHA-NI or 8 lanes with AVX).  This is what
+   PoH verification needs, as every entry of a block starts its own
+   chain from the hash of the previous entry.  Chains can have very
+   different lengths (a chain is reloaded into a lane as soon as the
+   previous chain in that lane is done).  hash[i] is the 32-byte start
+   of chain i on entry and its end on return.  cnt[i]==0 is fine
+   (hash[i] is left unchanged).  The hash regions should not overlap. */
+
+void
+fd_sha256_hash_32_repeated_multi( ulong          chain_cnt,
+                                  void * const * hash,
+                                  ulong const *  cnt );
+
+/* FD_SHA256_HASH_32_REPEATED_LANE_MAX is the max number of lanes used
+   by fd_sha256_hash_32_repeated_multi.  Callers batching up chains
+   should use batches of at least this many chains to keep all lanes
+   busy. */
+
+#define FD_SHA256_HASH_32_REPEATED_LANE_MAX (16UL)
+
+/* fd_sha256_private_hash_32_repeated_{avx,avx512} advance all 8 / 16
+   lanes of a transposed set of hash chains (state[ word*lane_cnt+lane ]
+   is the big endian 32-bit word word of the hash in lane lane, state
+   is 64-byte aligned) by cnt iterations.  Internal use only. */
+
+#if FD_HAS_AVX
+void fd_sha256_private_hash_32_repeated_avx   ( uint * state, ulong cnt );
+#endif
+#if FD_HAS_AVX512
+void fd_sha256_private_hash_32_repeated_avx512( uint * state, ulong cnt );
+#endif
+
 FD_PROTOTYPES_END
 
 #if 0 /* SHA256 batch API details */
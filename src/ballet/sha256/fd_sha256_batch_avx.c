@@ -299,3 +299,102 @@ fd_sha256_private_batch_avx( ulong          batch_cnt,
   default: break;
   }
 }
+
+void
+fd_sha256_private_hash_32_repeated_avx( uint * state,
+                                        ulong  cnt ) {
+
+  /* state[ 8*word + lane ] holds big endian word word of the hash in
+     lane lane.  Each iteration hashes the 32 bytes held in each lane.
+     A 32-byte message fits in a single block where only the first 8
+     message words vary.  The rest is the message terminator, zero
+     padding and the message size in bits. */
+
+  wu_t s0 = wu_ld( state    ); wu_t s1 = wu_ld( state+ 8 ); wu_t s2 = wu_ld( state+16 ); wu_t s3 = wu_ld( state+24 );
+  wu_t s4 = wu_ld( state+32 ); wu_t s5 = wu_ld( state+40 ); wu_t s6 = wu_ld( state+48 ); wu_t s7 = wu_ld( state+56 );
+
+  for( ulong iter=0UL; iter<cnt; iter++ ) {
+
+    wu_t x0 = s0;                      wu_t x1 = s1;         wu_t x2 = s2;         wu_t x3 = s3;
+    wu_t x4 = s4;                      wu_t x5 = s5;         wu_t x6 = s6;         wu_t x7 = s7;
+    wu_t x8 = wu_bcast( 0x80000000U ); wu_t x9 = wu_zero();  wu_t xa = wu_zero();  wu_t xb = wu_zero();
+    wu_t xc = wu_zero();               wu_t xd = wu_zero();  wu_t xe = wu_zero();  wu_t xf = wu_bcast( 256U );
+
+    wu_t a = wu_bcast( FD_SHA256_INITIAL_A ); wu_t b = wu_bcast( FD_SHA256_INITIAL_B );
+    wu_t c = wu_bcast( FD_SHA256_INITIAL_C ); wu_t d = wu_bcast( FD_SHA256_INITIAL_D );
+    wu_t e = wu_bcast( FD_SHA256_INITIAL_E ); wu_t f = wu_bcast( FD_SHA256_INITIAL_F );
+    wu_t g = wu_bcast( FD_SHA256_INITIAL_G ); wu_t h = wu_bcast( FD_SHA256_INITIAL_H );
+
+#   define Sigma0(x)  wu_xor( wu_rol(x,30), wu_xor( wu_rol(x,19), wu_rol(x,10) ) )
+#   define Sigma1(x)  wu_xor( wu_rol(x,26), wu_xor( wu_rol(x,21), wu_rol(x, 7) ) )
+#   define sigma0(x)  wu_xor( wu_rol(x,25), wu_xor( wu_rol(x,14), wu_shr(x, 3) ) )
+#   define sigma1(x)  wu_xor( wu_rol(x,15), wu_xor( wu_rol(x,13), wu_shr(x,10) ) )
+#   define Ch(x,y,z)  wu_xor( wu_and(x,y), wu_andnot(x,z) )
+#   define Maj(x,y,z) wu_xor( wu_and(x,y), wu_xor( wu_and(x,z), wu_and(y,z) ) )
+#   define SHA_CORE(xi,ki)                                                       \
+    T1 = wu_add( wu_add(xi,ki), wu_add( wu_add( h, Sigma1(e) ), Ch(e, f, g) ) ); \
+    T2 = wu_add( Sigma0(a), Maj(a, b, c) );                                      \
+    h = g;                                                                       \
+    g = f;                                                                       \
+    f = e;                                                                       \
+    e = wu_add( d, T1 );                                                         \
+    d = c;                                                                       \
+    c = b;                                                                       \
+    b = a;                                                                       \
+    a = wu_add( T1, T2 )
+
+    wu_t T1;
+    wu_t T2;
+
+    SHA_CORE( x0, wu_bcast( fd_sha256_K[ 0] ) );
+    SHA_CORE( x1, wu_bcast( fd_sha256_K[ 1] ) );
+    SHA_CORE( x2, wu_bcast( fd_sha256_K[ 2] ) );
+    SHA_CORE( x3, wu_bcast( fd_sha256_K[ 3] ) );
+    SHA_CORE( x4, wu_bcast( fd_sha256_K[ 4] ) );
+    SHA_CORE( x5, wu_bcast( fd_sha256_K[ 5] ) );
+    SHA_CORE( x6, wu_bcast( fd_sha256_K[ 6] ) );
+    SHA_CORE( x7, wu_bcast( fd_sha256_K[ 7] ) );
+    SHA_CORE( x8, wu_bcast( fd_sha256_K[ 8] ) );
+    SHA_CORE( x9, wu_bcast( fd_sha256_K[ 9] ) );
+    SHA_CORE( xa, wu_bcast( fd_sha256_K[10] ) );
+    SHA_CORE( xb, wu_bcast( fd_sha256_K[11] ) );
+    SHA_CORE( xc, wu_bcast( fd_sha256_K[12] ) );
+    SHA_CORE( xd, wu_bcast( fd_sha256_K[13] ) );
+    SHA_CORE( xe, wu_bcast( fd_sha256_K[14] ) );
+    SHA_CORE( xf, wu_bcast( fd_sha256_K[15] ) );
+    for( ulong i=16UL; i<64UL; i+=16UL ) {
+      x0 = wu_add( wu_add( x0, sigma0(x1) ), wu_add( sigma1(xe), x9 ) ); SHA_CORE( x0, wu_bcast( fd_sha256_K[i     ] ) );
+      x1 = wu_add( wu_add( x1, sigma0(x2) ), wu_add( sigma1(xf), xa ) ); SHA_CORE( x1, wu_bcast( fd_sha256_K[i+ 1UL] ) );
+      x2 = wu_add( wu_add( x2, sigma0(x3) ), wu_add( sigma1(x0), xb ) ); SHA_CORE( x2, wu_bcast( fd_sha256_K[i+ 2UL] ) );
+      x3 = wu_add( wu_add( x3, sigma0(x4) ), wu_add( sigma1(x1), xc ) ); SHA_CORE( x3, wu_bcast( fd_sha256_K[i+ 3UL] ) );
+      x4 = wu_add( wu_add( x4, sigma0(x5) ), wu_add( sigma1(x2), xd ) ); SHA_CORE( x4, wu_bcast( fd_sha256_K[i+ 4UL] ) );
+      x5 = wu_add( wu_add( x5, sigma0(x6) ), wu_add( sigma1(x3), xe ) ); SHA_CORE( x5, wu_bcast( fd_sha256_K[i+ 5UL] ) );
+      x6 = wu_add( wu_add( x6, sigma0(x7) ), wu_add( sigma1(x4), xf ) ); SHA_CORE( x6, wu_bcast( fd_sha256_K[i+ 6UL] ) );
+      x7 = wu_add( wu_add( x7, sigma0(x8) ), wu_add( sigma1(x5), x0 ) ); SHA_CORE( x7, wu_bcast( fd_sha256_K[i+ 7UL] ) );
+      x8 = wu_add( wu_add( x8, sigma0(x9) ), wu_add( sigma1(x6), x1 ) ); SHA_CORE( x8, wu_bcast( fd_sha256_K[i+ 8UL] ) );
+      x9 = wu_add( wu_add( x9, sigma0(xa) ), wu_add( sigma1(x7), x2 ) ); SHA_CORE( x9, wu_bcast( fd_sha256_K[i+ 9UL] ) );
+      xa = wu_add( wu_add( xa, sigma0(xb) ), wu_add( sigma1(x8), x3 ) ); SHA_CORE( xa, wu_bcast( fd_sha256_K[i+10UL] ) );
+      xb = wu_add( wu_add( xb, sigma0(xc) ), wu_add( sigma1(x9), x4 ) ); SHA_CORE( xb, wu_bcast( fd_sha256_K[i+11UL] ) );
+      xc = wu_add( wu_add( xc, sigma0(xd) ), wu_add( sigma1(xa), x5 ) ); SHA_CORE( xc, wu_bcast( fd_sha256_K[i+12UL] ) );
+      xd = wu_add( wu_add( xd, sigma0(xe) ), wu_add( sigma1(xb), x6 ) ); SHA_CORE( xd, wu_bcast( fd_sha256_K[i+13UL] ) );
+      xe = wu_add( wu_add( xe, sigma0(xf) ), wu_add( sigma1(xc), x7 ) ); SHA_CORE( xe, wu_bcast( fd_sha256_K[i+14UL] ) );
+      xf = wu_add( wu_add( xf, sigma0(x0) ), wu_add( sigma1(xd), x8 ) ); SHA_CORE( xf, wu_bcast( fd_sha256_K[i+15UL] ) );
+    }
+
+#   undef SHA_CORE
+#   undef Sigma0
+#   undef Sigma1
+#   undef sigma0
+#   undef sigma1
+#   undef Ch
+#   undef Maj
+
+    s0 = wu_add( a, wu_bcast( FD_SHA256_INITIAL_A ) ); s1 = wu_add( b, wu_bcast( FD_SHA256_INITIAL_B ) );
+    s2 = wu_add( c, wu_bcast( FD_SHA256_INITIAL_C ) ); s3 = wu_add( d, wu_bcast( FD_SHA256_INITIAL_D ) );
+    s4 = wu_add( e, wu_bcast( FD_SHA256_INITIAL_E ) ); s5 = wu_add( f, wu_bcast( FD_SHA256_INITIAL_F ) );
+    s6 = wu_add( g, wu_bcast( FD_SHA256_INITIAL_G ) ); s7 = wu_add( h, wu_bcast( FD_SHA256_INITIAL_H ) );
+  }
+
+  wu_st( state,   s0 ); wu_st( state+ 8, s1 ); wu_st( state+16, s2 ); wu_st( state+24, s3 );
+  wu_st( state+32, s4 ); wu_st( state+40, s5 ); wu_st( state+48, s6 ); wu_st( state+56, s7 );
+}
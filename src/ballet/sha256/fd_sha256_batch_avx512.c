@@ -308,3 +308,102 @@ fd_sha256_private_batch_avx512( ulong          batch_cnt,
   default: break;
   }
 }
+
+void
+fd_sha256_private_hash_32_repeated_avx512( uint * state,
+                                           ulong  cnt ) {
+
+  /* state[ 16*word + lane ] holds big endian word word of the hash in
+     lane lane.  Each iteration hashes the 32 bytes held in each lane.
+     A 32-byte message fits in a single block where only the first 8
+     message words vary.  The rest is the message terminator, zero
+     padding and the message size in bits. */
+
+  wwu_t s0 = wwu_ld( state    ); wwu_t s1 = wwu_ld( state+ 16 ); wwu_t s2 = wwu_ld( state+ 32 ); wwu_t s3 = wwu_ld( state+ 48 );
+  wwu_t s4 = wwu_ld( state+ 64 ); wwu_t s5 = wwu_ld( state+ 80 ); wwu_t s6 = wwu_ld( state+ 96 ); wwu_t s7 = wwu_ld( state+112 );
+
+  for( ulong iter=0UL; iter<cnt; iter++ ) {
+
+    wwu_t x0 = s0;                       wwu_t x1 = s1;          wwu_t x2 = s2;          wwu_t x3 = s3;
+    wwu_t x4 = s4;                       wwu_t x5 = s5;          wwu_t x6 = s6;          wwu_t x7 = s7;
+    wwu_t x8 = wwu_bcast( 0x80000000U ); wwu_t x9 = wwu_zero();  wwu_t xa = wwu_zero();  wwu_t xb = wwu_zero();
+    wwu_t xc = wwu_zero();               wwu_t xd = wwu_zero();  wwu_t xe = wwu_zero();  wwu_t xf = wwu_bcast( 256U );
+
+    wwu_t a = wwu_bcast( FD_SHA256_INITIAL_A ); wwu_t b = wwu_bcast( FD_SHA256_INITIAL_B );
+    wwu_t c = wwu_bcast( FD_SHA256_INITIAL_C ); wwu_t d = wwu_bcast( FD_SHA256_INITIAL_D );
+    wwu_t e = wwu_bcast( FD_SHA256_INITIAL_E ); wwu_t f = wwu_bcast( FD_SHA256_INITIAL_F );
+    wwu_t g = wwu_bcast( FD_SHA256_INITIAL_G ); wwu_t h = wwu_bcast( FD_SHA256_INITIAL_H );
+
+#   define Sigma0(x)  wwu_xor( wwu_rol(x,30), wwu_xor( wwu_rol(x,19), wwu_rol(x,10) ) )
+#   define Sigma1(x)  wwu_xor( wwu_rol(x,26), wwu_xor( wwu_rol(x,21), wwu_rol(x, 7) ) )
+#   define sigma0(x)  wwu_xor( wwu_rol(x,25), wwu_xor( wwu_rol(x,14), wwu_shr(x, 3) ) )
+#   define sigma1(x)  wwu_xor( wwu_rol(x,15), wwu_xor( wwu_rol(x,13), wwu_shr(x,10) ) )
+#   define Ch(x,y,z)  wwu_xor( wwu_and(x,y), wwu_andnot(x,z) )
+#   define Maj(x,y,z) wwu_xor( wwu_and(x,y), wwu_xor( wwu_and(x,z), wwu_and(y,z) ) )
+#   define SHA_CORE(xi,ki)                                                           \
+    T1 = wwu_add( wwu_add(xi,ki), wwu_add( wwu_add( h, Sigma1(e) ), Ch(e, f, g) ) ); \
+    T2 = wwu_add( Sigma0(a), Maj(a, b, c) );                                         \
+    h = g;                                                                           \
+    g = f;                                                                           \
+    f = e;                                                                           \
+    e = wwu_add( d, T1 );                                                            \
+    d = c;                                                                           \
+    c = b;                                                                           \
+    b = a;                                                                           \
+    a = wwu_add( T1, T2 )
+
+    wwu_t T1;
+    wwu_t T2;
+
+    SHA_CORE( x0, wwu_bcast( fd_sha256_K[ 0] ) );
+    SHA_CORE( x1, wwu_bcast( fd_sha256_K[ 1] ) );
+    SHA_CORE( x2, wwu_bcast( fd_sha256_K[ 2] ) );
+    SHA_CORE( x3, wwu_bcast( fd_sha256_K[ 3] ) );
+    SHA_CORE( x4, wwu_bcast( fd_sha256_K[ 4] ) );
+    SHA_CORE( x5, wwu_bcast( fd_sha256_K[ 5] ) );
+    SHA_CORE( x6, wwu_bcast( fd_sha256_K[ 6] ) );
+    SHA_CORE( x7, wwu_bcast( fd_sha256_K[ 7] ) );
+    SHA_CORE( x8, wwu_bcast( fd_sha256_K[ 8] ) );
+    SHA_CORE( x9, wwu_bcast( fd_sha256_K[ 9] ) );
+    SHA_CORE( xa, wwu_bcast( fd_sha256_K[10] ) );
+    SHA_CORE( xb, wwu_bcast( fd_sha256_K[11] ) );
+    SHA_CORE( xc, wwu_bcast( fd_sha256_K[12] ) );
+    SHA_CORE( xd, wwu_bcast( fd_sha256_K[13] ) );
+    SHA_CORE( xe, wwu_bcast( fd_sha256_K[14] ) );
+    SHA_CORE( xf, wwu_bcast( fd_sha256_K[15] ) );
+    for( ulong i=16UL; i<64UL; i+=16UL ) {
+      x0 = wwu_add( wwu_add( x0, sigma0(x1) ), wwu_add( sigma1(xe), x9 ) ); SHA_CORE( x0, wwu_bcast( fd_sha256_K[i     ] ) );
+      x1 = wwu_add( wwu_add( x1, sigma0(x2) ), wwu_add( sigma1(xf), xa ) ); SHA_CORE( x1, wwu_bcast( fd_sha256_K[i+ 1UL] ) );
+      x2 = wwu_add( wwu_add( x2, sigma0(x3) ), wwu_add( sigma1(x0), xb ) ); SHA_CORE( x2, wwu_bcast( fd_sha256_K[i+ 2UL] ) );
+      x3 = wwu_add( wwu_add( x3, sigma0(x4) ), wwu_add( sigma1(x1), xc ) ); SHA_CORE( x3, wwu_bcast( fd_sha256_K[i+ 3UL] ) );
+      x4 = wwu_add( wwu_add( x4, sigma0(x5) ), wwu_add( sigma1(x2), xd ) ); SHA_CORE( x4, wwu_bcast( fd_sha256_K[i+ 4UL] ) );
+      x5 = wwu_add( wwu_add( x5, sigma0(x6) ), wwu_add( sigma1(x3), xe ) ); SHA_CORE( x5, wwu_bcast( fd_sha256_K[i+ 5UL] ) );
+      x6 = wwu_add( wwu_add( x6, sigma0(x7) ), wwu_add( sigma1(x4), xf ) ); SHA_CORE( x6, wwu_bcast( fd_sha256_K[i+ 6UL] ) );
+      x7 = wwu_add( wwu_add( x7, sigma0(x8) ), wwu_add( sigma1(x5), x0 ) ); SHA_CORE( x7, wwu_bcast( fd_sha256_K[i+ 7UL] ) );
+      x8 = wwu_add( wwu_add( x8, sigma0(x9) ), wwu_add( sigma1(x6), x1 ) ); SHA_CORE( x8, wwu_bcast( fd_sha256_K[i+ 8UL] ) );
+      x9 = wwu_add( wwu_add( x9, sigma0(xa) ), wwu_add( sigma1(x7), x2 ) ); SHA_CORE( x9, wwu_bcast( fd_sha256_K[i+ 9UL] ) );
+      xa = wwu_add( wwu_add( xa, sigma0(xb) ), wwu_add( sigma1(x8), x3 ) ); SHA_CORE( xa, wwu_bcast( fd_sha256_K[i+10UL] ) );
+      xb = wwu_add( wwu_add( xb, sigma0(xc) ), wwu_add( sigma1(x9), x4 ) ); SHA_CORE( xb, wwu_bcast( fd_sha256_K[i+11UL] ) );
+      xc = wwu_add( wwu_add( xc, sigma0(xd) ), wwu_add( sigma1(xa), x5 ) ); SHA_CORE( xc, wwu_bcast( fd_sha256_K[i+12UL] ) );
+      xd = wwu_add( wwu_add( xd, sigma0(xe) ), wwu_add( sigma1(xb), x6 ) ); SHA_CORE( xd, wwu_bcast( fd_sha256_K[i+13UL] ) );
+      xe = wwu_add( wwu_add( xe, sigma0(xf) ), wwu_add( sigma1(xc), x7 ) ); SHA_CORE( xe, wwu_bcast( fd_sha256_K[i+14UL] ) );
+      xf = wwu_add( wwu_add( xf, sigma0(x0) ), wwu_add( sigma1(xd), x8 ) ); SHA_CORE( xf, wwu_bcast( fd_sha256_K[i+15UL] ) );
+    }
+
+#   undef SHA_CORE
+#   undef Sigma0
+#   undef Sigma1
+#   undef sigma0
+#   undef sigma1
+#   undef Ch
+#   undef Maj
+
+    s0 = wwu_add( a, wwu_bcast( FD_SHA256_INITIAL_A ) ); s1 = wwu_add( b, wwu_bcast( FD_SHA256_INITIAL_B ) );
+    s2 = wwu_add( c, wwu_bcast( FD_SHA256_INITIAL_C ) ); s3 = wwu_add( d, wwu_bcast( FD_SHA256_INITIAL_D ) );
+    s4 = wwu_add( e, wwu_bcast( FD_SHA256_INITIAL_E ) ); s5 = wwu_add( f, wwu_bcast( FD_SHA256_INITIAL_F ) );
+    s6 = wwu_add( g, wwu_bcast( FD_SHA256_INITIAL_G ) ); s7 = wwu_add( h, wwu_bcast( FD_SHA256_INITIAL_H ) );
+  }
+
+  wwu_st( state,    s0 ); wwu_st( state+ 16, s1 ); wwu_st( state+ 32, s2 ); wwu_st( state+ 48, s3 );
+  wwu_st( state+ 64, s4 ); wwu_st( state+ 80, s5 ); wwu_st( state+ 96, s6 ); wwu_st( state+112, s7 );
+}
@@ -146,6 +146,63 @@ main( int     argc,
     for( ulong b=0UL; b<32UL; b++ ) FD_TEST( in_hash[b]==hash[b] );
   }
 
+  /* test fd_sha256_hash_32_repeated_multi */
+# define CHAIN_MAX (64UL)
+  do {
+    static uchar chain_in [ CHAIN_MAX ][ 32 ];
+    static uchar chain_out[ CHAIN_MAX ][ 32 ];
+    void *       chain_hash[ CHAIN_MAX ];
+    ulong        chain_cnt [ CHAIN_MAX ];
+    for( ulong trial=0UL; trial<200UL; trial++ ) {
+      ulong chain_max = fd_rng_ulong_roll( rng, CHAIN_MAX+1UL );
+      for( ulong chain_idx=0UL; chain_idx<chain_max; chain_idx++ ) {
+        for( ulong b=0UL; b<32UL; b++ ) chain_in[ chain_idx ][ b ] = fd_rng_uchar( rng );
+        memcpy( chain_out[ chain_idx ], chain_in[ chain_idx ], 32UL );
+        chain_hash[ chain_idx ] = chain_out[ chain_idx ];
+        switch( fd_rng_uint_roll( rng, 4U ) ) { /* mix of empty, short and long chains */
+        case 0U:  chain_cnt[ chain_idx ] = 0UL;                                break;
+        case 1U:  chain_cnt[ chain_idx ] = 1UL+fd_rng_ulong_roll( rng, 4UL );  break;
+        default:  chain_cnt[ chain_idx ] = fd_rng_ulong_roll( rng, 2000UL );   break;
+        }
+      }
+      fd_sha256_hash_32_repeated_multi( chain_max, chain_hash, chain_cnt );
+      for( ulong chain_idx=0UL; chain_idx<chain_max; chain_idx++ ) {
+        fd_sha256_hash_32_repeated( chain_in[ chain_idx ], hash, chain_cnt[ chain_idx ] );
+        FD_TEST( !memcmp( chain_out[ chain_idx ], hash, 32UL ) );
+      }
+    }
+
+#   if FD_HAS_AVX
+    /* The AVX kernel is not used by fd_sha256_hash_32_repeated_multi
+       on AVX-512 targets */
+    uint state[ 8UL*8UL ] __attribute__((aligned(64)));
+    for( ulong lane=0UL; lane<8UL; lane++ ) {
+      for( ulong b=0UL; b<32UL; b++ ) chain_in[ lane ][ b ] = fd_rng_uchar( rng );
+      for( ulong word=0UL; word<8UL; word++ ) state[ 8UL*word+lane ] = fd_uint_bswap( FD_LOAD( uint, chain_in[ lane ]+4UL*word ) );
+    }
+    fd_sha256_private_hash_32_repeated_avx( state, 1000UL );
+    for( ulong lane=0UL; lane<8UL; lane++ ) {
+      fd_sha256_hash_32_repeated( chain_in[ lane ], hash, 1000UL );
+      for( ulong word=0UL; word<8UL; word++ ) FD_TEST( fd_uint_bswap( state[ 8UL*word+lane ] )==FD_LOAD( uint, hash+4UL*word ) );
+    }
+#   endif
+
+    /* benchmark 2 to CHAIN_MAX chains of equal length */
+    FD_LOG_NOTICE(( "Benchmarking multi-chain poh" ));
+    for( ulong chain_max=2UL; chain_max<=CHAIN_MAX; chain_max<<=1 ) {
+      for( ulong chain_idx=0UL; chain_idx<chain_max; chain_idx++ ) {
+        chain_hash[ chain_idx ] = chain_out[ chain_idx ];
+        chain_cnt [ chain_idx ] = 100000UL;
+      }
+      long dt = -fd_log_wallclock();
+      fd_sha256_hash_32_repeated_multi( chain_max, chain_hash, chain_cnt );
+      dt += fd_log_wallclock();
+      float hashes_per_sec = ((float)(chain_max*100000UL) * 1e-6f ) / ((float)dt * 1e-9f) ;
+      FD_LOG_NOTICE(( "~%6.3f M poh hashes / sec / core with fd_sha256_hash_32_repeated_multi (%2lu chains)", (double)hashes_per_sec, chain_max ));
+    }
+  } while(0);
+# undef CHAIN_MAX
+
   /* do a benchmark on PoH-style hashing */
   FD_LOG_NOTICE(( "Benchmarking poh" ));
   for( ulong b=0UL; b<32UL; b++ ) in_hash[b] = fd_rng_uchar( rng );
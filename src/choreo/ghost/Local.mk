@@ -4,5 +4,6 @@ $(call add-objs,fd_ghost,fd_choreo)
 ifdef FD_HAS_HOSTED
 $(call make-unit-test,test_ghost,test_ghost,fd_choreo fd_flamenco fd_tango fd_ballet fd_util)
 $(call run-unit-test,test_ghost)
+$(call make-unit-test,bench_ghost,bench_ghost,fd_choreo fd_flamenco fd_tango fd_ballet fd_util)
 endif
 endif
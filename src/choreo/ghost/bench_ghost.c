@@ -0,0 +1,133 @@
+#include "fd_ghost.h"
+
+/* bench_ghost measures fd_ghost ancestry queries and replay votes on a
+   synthetic tree: a single chain --depth slots long, with a short fork
+   of --fork-len slots branching off every --fork-every slots. */
+
+static fd_hash_t
+bench_hash( ulong slot ) {
+  return (fd_hash_t){ .ul = { slot, 1UL } };
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz   = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",    NULL,      "gigantic" );
+  ulong        page_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",   NULL,             1UL );
+  ulong        near_cpu   = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",   NULL, fd_log_cpu_id() );
+  ulong        depth      = fd_env_strip_cmdline_ulong( &argc, &argv, "--depth",      NULL,        262144UL );
+  ulong        fork_every = fd_env_strip_cmdline_ulong( &argc, &argv, "--fork-every", NULL,            64UL );
+  ulong        fork_len   = fd_env_strip_cmdline_ulong( &argc, &argv, "--fork-len",   NULL,             4UL );
+  ulong        voter_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--voters",     NULL,          1024UL );
+  ulong        iter_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter",       NULL,       1048576UL );
+  uint         rng_seed   = fd_env_strip_cmdline_uint ( &argc, &argv, "--rng-seed",   NULL,           1234U );
+
+  if( FD_UNLIKELY( !depth || !fork_every || !voter_cnt ) ) FD_LOG_ERR(( "--depth, --fork-every and --voters must be positive" ));
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+
+  ulong fork_cnt = depth / fork_every;
+  ulong ele_max  = fd_ulong_pow2_up( 1UL + depth + fork_cnt*fork_len ); /* map chain_cnt must be a power of 2 */
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --near-cpu %lu)", page_cnt, _page_sz, near_cpu ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( fd_shmem_numa_idx( near_cpu ) ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  void * mem = fd_wksp_alloc_laddr( wksp, fd_ghost_align(), fd_ghost_footprint( ele_max ), 1UL );
+  if( FD_UNLIKELY( !mem ) ) FD_LOG_ERR(( "workspace too small for %lu eles, increase --page-cnt", ele_max ));
+  fd_ghost_t * ghost = fd_ghost_join( fd_ghost_new( mem, ele_max, 0UL ) );
+  FD_TEST( ghost );
+
+  fd_voter_t * voters = fd_wksp_alloc_laddr( wksp, alignof(fd_voter_t), voter_cnt*sizeof(fd_voter_t), 1UL );
+  FD_TEST( voters );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, rng_seed, 0UL ) );
+
+  /* Build the tree.  Main chain slots are spaced out so forks can use
+     the slots in between. */
+
+  FD_LOG_NOTICE(( "Building tree (--depth %lu, --fork-every %lu, --fork-len %lu)", depth, fork_every, fork_len ));
+
+  ulong stride = fork_len + 1UL;
+  fd_hash_t hash = bench_hash( 0UL );
+  fd_ghost_init( ghost, 0UL, &hash );
+  long dt = -fd_log_wallclock();
+  for( ulong i=1UL; i<=depth; i++ ) {
+    fd_hash_t parent_hash = bench_hash( (i-1UL)*stride );
+    hash                  = bench_hash( i*stride );
+    FD_TEST( fd_ghost_insert( ghost, &parent_hash, i*stride, &hash, 0UL ) );
+    if( i%fork_every ) continue;
+    for( ulong j=1UL; j<=fork_len; j++ ) {
+      parent_hash = bench_hash( (i-1UL)*stride + j-1UL );
+      hash        = bench_hash( (i-1UL)*stride + j );
+      FD_TEST( fd_ghost_insert( ghost, &parent_hash, (i-1UL)*stride + j, &hash, 0UL ) );
+    }
+  }
+  dt += fd_log_wallclock();
+  ulong ele_cnt = fd_ghost_pool_used( fd_ghost_pool_const( ghost ) );
+  FD_LOG_NOTICE(( "insert: %.3f ns/ele (%lu eles)", (double)dt / (double)ele_cnt, ele_cnt ));
+
+  /* Ancestry queries between random eles (fork tips included). */
+
+  fd_hash_t * keys = fd_wksp_alloc_laddr( wksp, alignof(fd_hash_t), iter_cnt*2UL*sizeof(fd_hash_t), 1UL );
+  FD_TEST( keys );
+  ulong slot_max = depth*stride;
+  for( ulong i=0UL; i<2UL*iter_cnt; i++ ) {
+    fd_hash_t const * key;
+    do key = fd_ghost_hash( ghost, fd_rng_ulong_roll( rng, slot_max+1UL ) ); while( !key );
+    keys[i] = *key;
+  }
+
+  ulong found = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<iter_cnt; i++ ) found += (ulong)fd_ghost_is_ancestor( ghost, &keys[2UL*i], &keys[2UL*i+1UL] );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "is_ancestor: %.3f ns/query (%lu / %lu true)", (double)dt / (double)iter_cnt, found, iter_cnt ));
+
+  ulong sum = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<iter_cnt; i++ ) sum += fd_ghost_gca( ghost, &keys[2UL*i], &keys[2UL*i+1UL] )->slot;
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "gca: %.3f ns/query (checksum %lu)", (double)dt / (double)iter_cnt, sum ));
+
+  /* Replay votes.  Every voter first votes for the middle of the chain,
+     then the voters repeatedly move their votes a few slots down the
+     chain, sometimes hopping onto a fork. */
+
+  ulong start = depth/2UL + 1UL;
+  for( ulong i=0UL; i<voter_cnt; i++ ) {
+    voters[i] = (fd_voter_t){ .key = { .ul = { i } }, .stake = 1UL + fd_rng_ulong_roll( rng, 1000UL ), .replay_vote = { .slot = FD_SLOT_NULL } };
+    hash      = bench_hash( start*stride );
+    fd_ghost_replay_vote( ghost, &voters[i], &hash );
+  }
+
+  ulong vote_cnt = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong i=start+1UL; i<=depth; i++ ) {
+    for( ulong j=0UL; j<voter_cnt; j+=8UL ) {
+      ulong slot = i*stride;
+      if( (i%fork_every)==0UL && fork_len && (j&8UL) ) slot = (i-1UL)*stride + fork_len;
+      hash = bench_hash( slot );
+      fd_ghost_replay_vote( ghost, &voters[ (j + i) % voter_cnt ], &hash );
+      vote_cnt++;
+    }
+    if( vote_cnt>=iter_cnt ) break;
+  }
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "replay_vote: %.3f ns/vote (%lu votes)", (double)dt / (double)vote_cnt, vote_cnt ));
+
+  FD_TEST( !fd_ghost_verify( ghost ) );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_wksp_free_laddr( keys );
+  fd_wksp_free_laddr( voters );
+  fd_wksp_free_laddr( fd_ghost_delete( fd_ghost_leave( ghost ) ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
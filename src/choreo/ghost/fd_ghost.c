@@ -181,6 +181,9 @@ fd_ghost_init( fd_ghost_t * ghost, ulong root_slot, fd_hash_t * hash ) {
   root->parent          = null;
   root->child           = null;
   root->sibling         = null;
+  root->depth           = 0;
+  root->jump            = null;
+  root->jump_depth      = 0;
   root->weight          = 0;
   root->replay_stake    = 0;
   root->gossip_stake    = 0;
@@ -239,6 +242,9 @@ fd_ghost_verify( fd_ghost_t const * ghost ) {
     ulong                  weight = 0;
     fd_ghost_ele_t const * child  = fd_ghost_child_const( ghost, parent );
     while( FD_LIKELY( child && child->sibling != null ) ) {
+#   if FD_GHOST_USE_HANDHOLDING
+      FD_TEST( child->depth == parent->depth + 1UL );
+#   endif
       weight += child->weight;
       child = fd_ghost_sibling_const( ghost, child );
     }
@@ -310,6 +316,28 @@ fd_ghost_insert( fd_ghost_t * ghost, fd_hash_t const * parent_hash, ulong slot,
   ele->rooted_stake    = 0;
   ele->valid           = 1;
   ele->parent = fd_ghost_pool_idx( pool, parent );
+
+  /* Link the skew-binary jump pointer.  The jump ancestor is either the
+     parent or the parent's jump's jump (this is what makes the jump
+     depths skew binary).  In the latter case the parent's jump is no
+     shallower than ele's jump, so if ele's jump has not been pruned,
+     neither has the parent's and it is safe to dereference.  If ele's
+     jump has been pruned, the pointer is left null and never
+     followed. */
+
+  ele->depth      = parent->depth + 1UL;
+  ele->jump_depth = fd_ghost_jump_depth( ele->depth );
+  if( FD_LIKELY( ele->jump_depth == parent->depth ) ) {
+    ele->jump = ele->parent;
+  } else if( FD_UNLIKELY( ele->jump_depth < root->depth ) ) {
+    ele->jump = null;
+  } else {
+    ele->jump = fd_ghost_pool_ele( pool, parent->jump )->jump;
+  }
+# if FD_GHOST_USE_HANDHOLDING
+  FD_TEST( ele->jump == null || fd_ghost_pool_ele( pool, ele->jump )->depth == ele->jump_depth );
+# endif
+
   if( FD_LIKELY( parent->child == null ) ) {
     parent->child = fd_ghost_pool_idx( pool, ele ); /* left-child */
   } else {
@@ -365,6 +393,32 @@ fd_ghost_head( fd_ghost_t const * ghost, fd_ghost_ele_t const * root ) {
   return head;
 }
 
+/* gca returns the greatest common ancestor of ele1 and ele2, which are
+   both assumed to be in ghost.  Lifts the deeper ele to the depth of
+   the shallower one, then lifts both in lockstep.  Eles at the same
+   depth have jumps of the same length, so the pair can jump together
+   whenever their jumps land on different eles (ie. strictly below the
+   gca), and otherwise steps to the parents. */
+
+static fd_ghost_ele_t const *
+gca( fd_ghost_t const * ghost, fd_ghost_ele_t const * ele1, fd_ghost_ele_t const * ele2 ) {
+  fd_ghost_ele_t const * pool  = fd_ghost_pool_const( ghost );
+  ulong                  root  = fd_ghost_root_const( ghost )->depth;
+  ulong                  depth = fd_ulong_min( ele1->depth, ele2->depth );
+
+  ele1 = fd_ghost_ancestor( ghost, ele1, depth );
+  ele2 = fd_ghost_ancestor( ghost, ele2, depth );
+  while( FD_LIKELY( ele1 != ele2 ) ) {
+    int jump = ele1->jump_depth >= root && ele1->jump != ele2->jump;
+    ele1 = fd_ghost_pool_ele_const( pool, fd_ulong_if( jump, ele1->jump, ele1->parent ) );
+    ele2 = fd_ghost_pool_ele_const( pool, fd_ulong_if( jump, ele2->jump, ele2->parent ) );
+  }
+# if FD_GHOST_USE_HANDHOLDING
+  if( FD_UNLIKELY( !ele1 ) ) FD_LOG_CRIT(( "invariant violation" ));
+# endif
+  return ele1;
+}
+
 void
 fd_ghost_replay_vote( fd_ghost_t * ghost, fd_voter_t * voter, fd_hash_t const * hash ) {
   fd_ghost_ele_t *       pool = fd_ghost_pool( ghost );
@@ -408,14 +462,25 @@ fd_ghost_replay_vote( fd_ghost_t * ghost, fd_voter_t * voter, fd_hash_t const *
      pruned (because we published a new root). */
 
   fd_ghost_ele_t * prev = fd_ghost_query( ghost, &vote.hash );
+  fd_ghost_ele_t * curr = fd_ghost_query( ghost, hash );
+  if( FD_UNLIKELY( !curr ) ) FD_LOG_CRIT(( "corrupt ghost" ));
+
+  /* The voter's stake is subtracted from and added back to the weight
+     of every common ancestor of prev and curr, so stop both the
+     subtraction and addition traversals at their gca (stop is NULL if
+     there is no previous vote, in which case the addition traverses all
+     the way up to the root). */
+
+  fd_ghost_ele_t const * stop = NULL;
   if( FD_LIKELY( prev && vote.slot != FD_SLOT_NULL ) ) { /* no previous vote or pruned */
 #   if LOGGING
     FD_LOG_INFO(( "[%s] subtracting (%s, %lu, %lu, %s)", __func__, FD_BASE58_ENC_32_ALLOCA( &voter->key ), voter->stake, vote.slot, FD_BASE58_ENC_32_ALLOCA( &vote.hash ) ));
 #   endif
+    stop   = gca( ghost, prev, curr );
     int cf = __builtin_usubl_overflow( prev->replay_stake, voter->stake, &prev->replay_stake );
     if( FD_UNLIKELY( cf ) ) FD_LOG_CRIT(( "[%s] sub overflow. prev->replay_stake %lu voter->stake %lu", __func__, prev->replay_stake, voter->stake ));
     fd_ghost_ele_t * ancestor = prev;
-    while( FD_LIKELY( ancestor ) ) {
+    while( FD_LIKELY( ancestor != stop ) ) {
       cf = __builtin_usubl_overflow( ancestor->weight, voter->stake, &ancestor->weight );
       if( FD_UNLIKELY( cf ) ) FD_LOG_CRIT(( "[%s] sub overflow. ancestor->weight %lu latest_vote->stake %lu", __func__, ancestor->weight, voter->stake ));
       ancestor = fd_ghost_pool_ele( pool, ancestor->parent );
@@ -428,16 +493,13 @@ fd_ghost_replay_vote( fd_ghost_t * ghost, fd_voter_t * voter, fd_hash_t const *
      vote is switched from a previous vote that was on a missing ele
      (pruned), or the regular case */
 
-  fd_ghost_ele_t * curr = fd_ghost_query( ghost, hash );
-  if( FD_UNLIKELY( !curr ) ) FD_LOG_CRIT(( "corrupt ghost" ));
-
 # if LOGGING
   FD_LOG_INFO(( "[%s] adding (%s, %lu, %lu)", __func__, FD_BASE58_ENC_32_ALLOCA( &voter->key ), voter->stake, slot ));
 # endif
   int cf = __builtin_uaddl_overflow( curr->replay_stake, voter->stake, &curr->replay_stake );
   if( FD_UNLIKELY( cf ) ) FD_LOG_ERR(( "[%s] add overflow. ele->stake %lu latest_vote->stake %lu", __func__, curr->replay_stake, voter->stake ));
   fd_ghost_ele_t * ancestor = curr;
-  while( FD_LIKELY( ancestor ) ) {
+  while( FD_LIKELY( ancestor != stop ) ) {
     int cf = __builtin_uaddl_overflow( ancestor->weight, voter->stake, &ancestor->weight );
     if( FD_UNLIKELY( cf ) ) FD_LOG_ERR(( "[%s] add overflow. ancestor->weight %lu latest_vote->stake %lu", __func__, ancestor->weight, voter->stake ));
     ancestor = fd_ghost_parent( ghost, ancestor );
@@ -519,7 +581,6 @@ fd_ghost_publish( fd_ghost_t * ghost, fd_hash_t const * hash ) {
 
 fd_ghost_ele_t const *
 fd_ghost_gca( fd_ghost_t const * ghost, fd_hash_t const * hash1, fd_hash_t const * hash2 ) {
-  fd_ghost_ele_t const * pool = fd_ghost_pool_const( ghost );
   fd_ghost_ele_t const * ele1 = fd_ghost_query_const( ghost, hash1 );
   fd_ghost_ele_t const * ele2 = fd_ghost_query_const( ghost, hash2 );
 
@@ -528,14 +589,7 @@ fd_ghost_gca( fd_ghost_t const * ghost, fd_hash_t const * hash1, fd_hash_t const
   if( FD_UNLIKELY( !ele2 ) ) { FD_LOG_WARNING(( "hash2 %s missing", FD_BASE58_ENC_32_ALLOCA(hash2) )); return NULL; }
 # endif
 
-  /* Find the greatest common ancestor. */
-
-  while( FD_LIKELY( ele1 && ele2 ) ) {
-    if( FD_UNLIKELY( memcmp( &ele1->key, &ele2->key, sizeof(fd_hash_t) ) == 0 ) ) return ele1;
-    if( ele1->slot > ele2->slot ) ele1 = fd_ghost_pool_ele_const( pool, ele1->parent );
-    else                          ele2 = fd_ghost_pool_ele_const( pool, ele2->parent );
-  }
-  FD_LOG_CRIT(( "invariant violation" )); /* unreachable */
+  return gca( ghost, ele1, ele2 );
 }
 
 int
@@ -556,17 +610,11 @@ fd_ghost_is_ancestor( fd_ghost_t const * ghost, fd_hash_t const * ancestor, fd_h
   if( FD_UNLIKELY( !curr                  ) ) { FD_LOG_WARNING(( "[%s] hash %s not in ghost.",           __func__, FD_BASE58_ENC_32_ALLOCA(hash) )); return 0; }
 # endif
 
-  /* Look for `ancestor` in the fork ancestry.
-
-     Stop looking when there is either no ancestry remaining or there is
-     no reason to look further because we've searched past the
-     `ancestor`. */
+  /* `ancestor` is an ancestor of `hash` iff it is the ele at its depth
+     in `hash`'s ancestry. */
 
-  while( FD_LIKELY( curr && curr->slot >= anc->slot ) ) {
-    if( FD_UNLIKELY( memcmp( &curr->key, &anc->key, sizeof(fd_hash_t) ) == 0 ) ) return 1; /* optimize for depth > 1 */
-    curr = fd_ghost_pool_ele_const( fd_ghost_pool_const( ghost ), curr->parent );
-  }
-  return 0; /* not found */
+  if( FD_UNLIKELY( curr->depth < anc->depth ) ) return 0;
+  return fd_ghost_ancestor( ghost, curr, anc->depth ) == anc;
 }
 
 int
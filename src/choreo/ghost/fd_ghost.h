@@ -128,6 +128,17 @@
    (`child_idx`), its immediate-right sibling (`sibling_idx`), and its
    parent (`parent_idx`).
 
+   Each ele also maintains a skew-binary jump pointer (`jump`) to the
+   ancestor at depth `jump_depth`.  The jump depth is a pure function of
+   the ele's depth (see fd_ghost_jump_depth), chosen so that any
+   ancestor of an ele can be reached in O(log h) jump and parent hops,
+   where h is the height of ghost.  This keeps fd_ghost_is_ancestor
+   and fd_ghost_gca logarithmic on long forks.  Depths are counted from
+   the root passed to fd_ghost_init and are not renumbered on publish,
+   so a jump pointer may refer to an ele that has since been pruned.
+   Such a pointer is never followed, because its jump_depth is less
+   than the depth of the current root.
+
    This tree structure is gaddr-safe and supports accesses and
    operations from processes with separate local ghost joins. */
 
@@ -140,6 +151,9 @@ struct __attribute__((aligned(128UL))) fd_ghost_ele {
   ulong     parent;       /* pool idx of the parent */
   ulong     child;        /* pool idx of the left-child */
   ulong     sibling;      /* pool idx of the right-sibling */
+  ulong     depth;        /* distance from the root ghost was initialized with */
+  ulong     jump;         /* pool idx of the skew-binary jump ancestor */
+  ulong     jump_depth;   /* depth of the jump ancestor */
   ulong     weight;       /* total stake from replay votes for this slot or any of its descendants */
   ulong     replay_stake; /* total stake from replay votes for this slot */
   ulong     gossip_stake; /* total stake from gossip votes for this slot */
@@ -329,6 +343,41 @@ FD_FN_PURE static inline fd_ghost_ele_t const * fd_ghost_child_const  ( fd_ghost
 FD_FN_PURE static inline fd_ghost_ele_t       * fd_ghost_sibling      ( fd_ghost_t       * ghost, fd_ghost_ele_t       * ele ) { return fd_ghost_pool_ele      ( fd_ghost_pool      ( ghost ), ele->sibling ); }
 FD_FN_PURE static inline fd_ghost_ele_t const * fd_ghost_sibling_const( fd_ghost_t const * ghost, fd_ghost_ele_t const * ele ) { return fd_ghost_pool_ele_const( fd_ghost_pool_const( ghost ), ele->sibling ); }
 
+/* fd_ghost_jump_depth returns the depth of the jump ancestor of an ele
+   at depth `depth`, which must be positive.  The jump length is found
+   by repeatedly stripping the largest 2^k-1 that fits in depth (ie.
+   decomposing depth in skew binary): the jump spans the last such
+   term once depth is itself of the form 2^k-1.  For example, the ele
+   at depth 10 = 7 + 3 jumps 3 to depth 7, and the ele at depth 14 =
+   7 + 7 jumps 7 to depth 7. */
+
+FD_FN_CONST static inline ulong
+fd_ghost_jump_depth( ulong depth ) {
+  ulong rem = depth;
+  for(;;) {
+    ulong term = fd_ulong_mask_lsb( fd_ulong_find_msb( rem+1UL ) );
+    if( FD_LIKELY( rem==term ) ) return depth - term;
+    rem -= term;
+  }
+}
+
+/* fd_ghost_ancestor returns the ancestor of ele at the given depth, or
+   ele itself if depth==ele->depth.  Assumes ele is in ghost and depth
+   is in [root->depth, ele->depth].  O(log h), where h is the height of
+   ghost. */
+
+FD_FN_PURE static inline fd_ghost_ele_t const *
+fd_ghost_ancestor( fd_ghost_t const *     ghost,
+                   fd_ghost_ele_t const * ele,
+                   ulong                  depth ) {
+  fd_ghost_ele_t const * pool = fd_ghost_pool_const( ghost );
+  while( ele->depth > depth ) {
+    ulong next = fd_ulong_if( ele->jump_depth >= depth, ele->jump, ele->parent );
+    ele = fd_ghost_pool_ele_const( pool, next );
+  }
+  return ele;
+}
+
 /* fd_ghost_{query,query_const} returns the ele keyed by `hash_id`,
    NULL if not found. */
 
@@ -372,14 +421,15 @@ fd_ghost_head( fd_ghost_t const * ghost, fd_ghost_ele_t const * root );
 /* fd_ghost_gca returns the greatest common ancestor of block1, block2
    in ghost.  Assumes block1 or block2 are present in ghost (warns and
    returns NULL with handholding enabled).  This is guaranteed to be
-   non-NULL if block1 and block2 are both present. */
+   non-NULL if block1 and block2 are both present.  O(log h), where h
+   is the height of ghost. */
 
 fd_ghost_ele_t const *
 fd_ghost_gca( fd_ghost_t const * ghost, fd_hash_t const * bid1, fd_hash_t const * bid2 );
 
 /* fd_ghost_is_ancestor returns 1 if `ancestor` is `slot`'s ancestor, 0
    otherwise.  Also returns 0 if either `ancestor` or `slot` are not in
-   ghost. */
+   ghost.  O(log h), where h is the height of ghost. */
 
 int
 fd_ghost_is_ancestor( fd_ghost_t const * ghost, fd_hash_t const * ancestor, fd_hash_t const * slot );
@@ -414,9 +464,12 @@ fd_ghost_insert( fd_ghost_t * ghost, fd_hash_t const * parent_hash, ulong slot,
    Assumes slot is present in ghost (if handholding is enabled,
    explicitly checks and errors).
 
-   TODO the implementation can be made more efficient by
-   short-circuiting and doing fewer traversals.  Currently this is
-   bounded to O(h), where h is the height of ghost. */
+   The stake moved from the previous vote to the new one cancels out at
+   their greatest common ancestor and above, so only the eles strictly
+   below it on either side are updated.  For a voter voting along a
+   fork this is O(log h + d), where h is the height of ghost and d the
+   distance between the two votes, instead of O(h).  A voter whose
+   previous vote is not in ghost still costs O(h). */
 
 void
 fd_ghost_replay_vote( fd_ghost_t * ghost, fd_voter_t * voter, fd_hash_t const * hash_id );
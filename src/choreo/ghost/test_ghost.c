@@ -326,6 +326,115 @@ test_ghost_gca( fd_wksp_t * wksp ) {
   FD_TEST( fd_ghost_gca( ghost, &hash_6, &hash_6 )->slot == 6 );
 }
 
+/* test_ghost_ancestry builds a random tree of long, occasionally
+   forking chains, periodically publishing new roots and moving votes
+   around, and checks fd_ghost_gca, fd_ghost_is_ancestor and the subtree
+   weights against naive parent walks. */
+
+static fd_hash_t
+ancestry_hash( ulong slot ) {
+  return (fd_hash_t){ .ul = { slot, 1UL } };
+}
+
+static fd_ghost_ele_t const *
+ancestry_query( fd_ghost_t const * ghost, ulong slot ) {
+  fd_hash_t const * hash = fd_ghost_hash( ghost, slot );
+  return hash ? fd_ghost_query_const( ghost, hash ) : NULL;
+}
+
+static fd_ghost_ele_t const *
+naive_gca( fd_ghost_t const * ghost, fd_ghost_ele_t const * ele1, fd_ghost_ele_t const * ele2 ) {
+  while( ele1!=ele2 ) {
+    if( ele1->slot > ele2->slot ) ele1 = fd_ghost_parent_const( ghost, ele1 );
+    else                          ele2 = fd_ghost_parent_const( ghost, ele2 );
+  }
+  return ele1;
+}
+
+void
+test_ghost_ancestry( fd_wksp_t * wksp ) {
+  ulong  node_max = 1024;
+  void * mem      = fd_wksp_alloc_laddr( wksp, fd_ghost_align(), fd_ghost_footprint( node_max ), 1UL );
+  FD_TEST( mem );
+  fd_ghost_t * ghost = fd_ghost_join( fd_ghost_new( mem, node_max, 0UL ) );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 1234U, 0UL ) );
+
+# define VOTER_CNT (16UL)
+  fd_voter_t voters[ VOTER_CNT ];
+  for( ulong i=0UL; i<VOTER_CNT; i++ ) {
+    voters[i] = (fd_voter_t){ .key = { .ul = { i } }, .stake = 1UL + fd_rng_ulong_roll( rng, 100UL ), .replay_vote = { .slot = FD_SLOT_NULL } };
+  }
+
+  fd_hash_t hash = ancestry_hash( 0UL );
+  fd_ghost_init( ghost, 0UL, &hash );
+
+  ulong tip = 0UL;
+  for( ulong slot=1UL; slot<8192UL; slot++ ) {
+    ulong root = fd_ghost_root_const( ghost )->slot;
+
+    /* Mostly extend the current tip, but sometimes fork off a random
+       live slot (which then becomes the tip). */
+
+    ulong parent = tip;
+    if( fd_rng_uint_roll( rng, 8U )==0U ) {
+      do parent = root + fd_rng_ulong_roll( rng, slot-root ); while( !fd_ghost_hash( ghost, parent ) );
+    }
+    fd_hash_t parent_hash = ancestry_hash( parent );
+    hash                  = ancestry_hash( slot );
+    FD_TEST( fd_ghost_insert( ghost, &parent_hash, slot, &hash, 0UL ) );
+    tip = slot;
+
+    fd_voter_t * voter = &voters[ fd_rng_ulong_roll( rng, VOTER_CNT ) ];
+    ulong        vote  = root + fd_rng_ulong_roll( rng, slot-root+1UL );
+    if( fd_ghost_hash( ghost, vote ) ) {
+      hash = ancestry_hash( vote );
+      fd_ghost_replay_vote( ghost, voter, &hash );
+    }
+
+    /* Compare a few random pairs against a naive walk. */
+
+    for( ulong i=0UL; i<4UL; i++ ) {
+      ulong s1 = root + fd_rng_ulong_roll( rng, slot-root+1UL );
+      ulong s2 = root + fd_rng_ulong_roll( rng, slot-root+1UL );
+      fd_ghost_ele_t const * ele1 = ancestry_query( ghost, s1 );
+      fd_ghost_ele_t const * ele2 = ancestry_query( ghost, s2 );
+      if( !ele1 || !ele2 ) continue;
+      fd_ghost_ele_t const * g = naive_gca( ghost, ele1, ele2 );
+      FD_TEST( fd_ghost_gca( ghost, &ele1->key, &ele2->key )==g );
+      FD_TEST( fd_ghost_is_ancestor( ghost, &ele1->key, &ele2->key )==(g==ele1) );
+      FD_TEST( fd_ghost_is_ancestor( ghost, &ele2->key, &ele1->key )==(g==ele2) );
+    }
+
+    /* Keep the tree at most a few hundred slots deep. */
+
+    if( slot%64UL==0UL ) {
+      fd_ghost_ele_t const * newr = ancestry_query( ghost, tip );
+      for( ulong i=0UL; i<32UL && newr->parent!=fd_ghost_pool_idx_null( fd_ghost_pool_const( ghost ) ); i++ ) newr = fd_ghost_parent_const( ghost, newr );
+      if( newr!=fd_ghost_root_const( ghost ) ) FD_TEST( fd_ghost_publish( ghost, &newr->key )==newr );
+    }
+  }
+
+  /* Every weight is exactly the replay stake of its subtree. */
+
+  fd_ghost_ele_t const * root = fd_ghost_root_const( ghost );
+  for( ulong slot=root->slot; slot<=tip; slot++ ) {
+    fd_ghost_ele_t const * ele = ancestry_query( ghost, slot );
+    if( !ele ) continue;
+    ulong weight = ele->replay_stake;
+    for( fd_ghost_ele_t const * child = fd_ghost_child_const( ghost, ele ); child; child = fd_ghost_sibling_const( ghost, child ) ) {
+      FD_TEST( child->depth==ele->depth+1UL );
+      weight += child->weight;
+    }
+    FD_TEST( ele->weight==weight );
+  }
+  FD_TEST( !fd_ghost_verify( ghost ) );
+# undef VOTER_CNT
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_wksp_free_laddr( fd_ghost_delete( fd_ghost_leave( ghost ) ) );
+}
+
 /*void
 test_ghost_print( fd_wksp_t * wksp ) {
   ulong  node_max = 16;
@@ -1119,6 +1228,7 @@ main( int argc, char ** argv ) {
   test_ghost_publish_left( wksp );
   test_ghost_publish_right( wksp );
   test_ghost_gca( wksp );
+  test_ghost_ancestry( wksp );
   test_ghost_vote_leaves( wksp );
   test_ghost_head_full_tree( wksp );
   test_ghost_head( wksp );
@@ -15,6 +15,10 @@
 #define DST_PROTO_GOSSIP   (5UL)
 #define DST_PROTO_SEND     (6UL)
 
+/* DST_PROTO_OUTGOING_FANOUT marks an outgoing fan-out TX message (one
+   payload, many destinations).  See fd_net_tile.h. */
+#define DST_PROTO_OUTGOING_FANOUT (7UL)
+
 #define POH_PKT_TYPE_MICROBLOCK    (0UL)
 #define POH_PKT_TYPE_BECAME_LEADER (1UL)
 #define POH_PKT_TYPE_FEAT_ACT_SLOT (2UL)
@@ -68,6 +68,7 @@ const char * FD_METRICS_TILE_KIND_NAMES[FD_METRICS_TILE_KIND_CNT] = {
     "exec",
     "snapwr",
     "benchs",
+    "snapla",
 };
 
 const ulong FD_METRICS_TILE_KIND_SIZES[FD_METRICS_TILE_KIND_CNT] = {
@@ -103,6 +104,7 @@ const ulong FD_METRICS_TILE_KIND_SIZES[FD_METRICS_TILE_KIND_CNT] = {
     FD_METRICS_EXEC_TOTAL,
     FD_METRICS_SNAPWR_TOTAL,
     FD_METRICS_BENCHS_TOTAL,
+    FD_METRICS_SNAPLA_TOTAL,
 };
 const fd_metrics_meta_t * FD_METRICS_TILE_KIND_METRICS[FD_METRICS_TILE_KIND_CNT] = {
     FD_METRICS_NET,
@@ -137,4 +139,5 @@ const fd_metrics_meta_t * FD_METRICS_TILE_KIND_METRICS[FD_METRICS_TILE_KIND_CNT]
     FD_METRICS_EXEC,
     FD_METRICS_SNAPWR,
     FD_METRICS_BENCHS,
+    FD_METRICS_SNAPLA,
 };
@@ -9,4 +9,10 @@ const fd_metrics_meta_t FD_METRICS_EXEC[FD_METRICS_EXEC_TOTAL] = {
     DECLARE_METRIC( EXEC_PROGCACHE_FILL_FAILS, COUNTER ),
     DECLARE_METRIC( EXEC_PROGCACHE_DUP_INSERTS, COUNTER ),
     DECLARE_METRIC( EXEC_PROGCACHE_INVALIDATIONS, COUNTER ),
+    DECLARE_METRIC( EXEC_PROGCACHE_WARM_HITS, COUNTER ),
+    DECLARE_METRIC( EXEC_PROGCACHE_WARM_MISSES, COUNTER ),
+    DECLARE_METRIC( EXEC_ACCOUNTS_CLEAN, COUNTER ),
+    DECLARE_METRIC( EXEC_ACCOUNT_STAGE_TOT_SZ, COUNTER ),
+    DECLARE_METRIC( EXEC_ACCOUNT_COMMIT_TOT_SZ, COUNTER ),
+    DECLARE_METRIC_HISTOGRAM_NONE( EXEC_TXN_ACCOUNT_COPY_SZ ),
 };
@@ -48,7 +48,45 @@
 #define FD_METRICS_COUNTER_EXEC_PROGCACHE_INVALIDATIONS_DESC "Number of program cache invalidations"
 #define FD_METRICS_COUNTER_EXEC_PROGCACHE_INVALIDATIONS_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_EXEC_TOTAL (7UL)
+#define FD_METRICS_COUNTER_EXEC_PROGCACHE_WARM_HITS_OFF  (23UL)
+#define FD_METRICS_COUNTER_EXEC_PROGCACHE_WARM_HITS_NAME "exec_progcache_warm_hits"
+#define FD_METRICS_COUNTER_EXEC_PROGCACHE_WARM_HITS_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_EXEC_PROGCACHE_WARM_HITS_DESC "Number of program cache fills served from the warm start store"
+#define FD_METRICS_COUNTER_EXEC_PROGCACHE_WARM_HITS_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_EXEC_PROGCACHE_WARM_MISSES_OFF  (24UL)
+#define FD_METRICS_COUNTER_EXEC_PROGCACHE_WARM_MISSES_NAME "exec_progcache_warm_misses"
+#define FD_METRICS_COUNTER_EXEC_PROGCACHE_WARM_MISSES_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_EXEC_PROGCACHE_WARM_MISSES_DESC "Number of program cache fills not found in the warm start store"
+#define FD_METRICS_COUNTER_EXEC_PROGCACHE_WARM_MISSES_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_EXEC_ACCOUNTS_CLEAN_OFF  (25UL)
+#define FD_METRICS_COUNTER_EXEC_ACCOUNTS_CLEAN_NAME "exec_accounts_clean"
+#define FD_METRICS_COUNTER_EXEC_ACCOUNTS_CLEAN_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_EXEC_ACCOUNTS_CLEAN_DESC "Number of writable transaction accounts that were never modified and not written back"
+#define FD_METRICS_COUNTER_EXEC_ACCOUNTS_CLEAN_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_EXEC_ACCOUNT_STAGE_TOT_SZ_OFF  (26UL)
+#define FD_METRICS_COUNTER_EXEC_ACCOUNT_STAGE_TOT_SZ_NAME "exec_account_stage_tot_sz"
+#define FD_METRICS_COUNTER_EXEC_ACCOUNT_STAGE_TOT_SZ_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_EXEC_ACCOUNT_STAGE_TOT_SZ_DESC "Total number of bytes copied into staging on the first modification of a writable account"
+#define FD_METRICS_COUNTER_EXEC_ACCOUNT_STAGE_TOT_SZ_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_EXEC_ACCOUNT_COMMIT_TOT_SZ_OFF  (27UL)
+#define FD_METRICS_COUNTER_EXEC_ACCOUNT_COMMIT_TOT_SZ_NAME "exec_account_commit_tot_sz"
+#define FD_METRICS_COUNTER_EXEC_ACCOUNT_COMMIT_TOT_SZ_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_EXEC_ACCOUNT_COMMIT_TOT_SZ_DESC "Total number of bytes copied into the accounts database when committing transactions"
+#define FD_METRICS_COUNTER_EXEC_ACCOUNT_COMMIT_TOT_SZ_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_HISTOGRAM_EXEC_TXN_ACCOUNT_COPY_SZ_OFF  (28UL)
+#define FD_METRICS_HISTOGRAM_EXEC_TXN_ACCOUNT_COPY_SZ_NAME "exec_txn_account_copy_sz"
+#define FD_METRICS_HISTOGRAM_EXEC_TXN_ACCOUNT_COPY_SZ_TYPE (FD_METRICS_TYPE_HISTOGRAM)
+#define FD_METRICS_HISTOGRAM_EXEC_TXN_ACCOUNT_COPY_SZ_DESC "Number of account bytes copied (staging and commit) per committed transaction"
+#define FD_METRICS_HISTOGRAM_EXEC_TXN_ACCOUNT_COPY_SZ_CVT  (FD_METRICS_CONVERTER_NONE)
+#define FD_METRICS_HISTOGRAM_EXEC_TXN_ACCOUNT_COPY_SZ_MIN  (128UL)
+#define FD_METRICS_HISTOGRAM_EXEC_TXN_ACCOUNT_COPY_SZ_MAX  (10485760UL)
+
+#define FD_METRICS_EXEC_TOTAL (13UL)
 extern const fd_metrics_meta_t FD_METRICS_EXEC[FD_METRICS_EXEC_TOTAL];
 
 #endif /* HEADER_fd_src_disco_metrics_generated_fd_metrics_exec_h */
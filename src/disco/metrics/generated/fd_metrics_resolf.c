@@ -16,4 +16,5 @@ const fd_metrics_meta_t FD_METRICS_RESOLF[FD_METRICS_RESOLF_TOTAL] = {
     DECLARE_METRIC( RESOLF_BLOCKHASH_EXPIRED, COUNTER ),
     DECLARE_METRIC( RESOLF_TRANSACTION_BUNDLE_PEER_FAILURE, COUNTER ),
     DECLARE_METRIC( RESOLF_DB_RACES, COUNTER ),
+    DECLARE_METRIC( RESOLF_ALREADY_PROCESSED, COUNTER ),
 };
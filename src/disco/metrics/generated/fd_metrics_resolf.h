@@ -56,7 +56,13 @@
 #define FD_METRICS_COUNTER_RESOLF_DB_RACES_DESC "Number of database races encountered (diagnostic counter, not indicative of issues)"
 #define FD_METRICS_COUNTER_RESOLF_DB_RACES_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_RESOLF_TOTAL (14UL)
+#define FD_METRICS_COUNTER_RESOLF_ALREADY_PROCESSED_OFF  (30UL)
+#define FD_METRICS_COUNTER_RESOLF_ALREADY_PROCESSED_NAME "resolf_already_processed"
+#define FD_METRICS_COUNTER_RESOLF_ALREADY_PROCESSED_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_RESOLF_ALREADY_PROCESSED_DESC "Count of transactions dropped because they were already processed on the rooted fork"
+#define FD_METRICS_COUNTER_RESOLF_ALREADY_PROCESSED_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_RESOLF_TOTAL (15UL)
 extern const fd_metrics_meta_t FD_METRICS_RESOLF[FD_METRICS_RESOLF_TOTAL];
 
 #endif /* HEADER_fd_src_disco_metrics_generated_fd_metrics_resolf_h */
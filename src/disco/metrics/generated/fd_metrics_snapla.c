@@ -0,0 +1,7 @@
+/* THIS FILE IS GENERATED BY gen_metrics.py. DO NOT HAND EDIT. */
+#include "fd_metrics_snapla.h"
+
+const fd_metrics_meta_t FD_METRICS_SNAPLA[FD_METRICS_SNAPLA_TOTAL] = {
+    DECLARE_METRIC( SNAPLA_ACCOUNTS_HASHED, COUNTER ),
+    DECLARE_METRIC( SNAPLA_BYTES_HASHED, COUNTER ),
+};
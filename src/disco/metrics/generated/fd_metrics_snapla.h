@@ -0,0 +1,24 @@
+#ifndef HEADER_fd_src_disco_metrics_generated_fd_metrics_snapla_h
+#define HEADER_fd_src_disco_metrics_generated_fd_metrics_snapla_h
+
+/* THIS FILE IS GENERATED BY gen_metrics.py. DO NOT HAND EDIT. */
+
+#include "../fd_metrics_base.h"
+#include "fd_metrics_enums.h"
+
+#define FD_METRICS_COUNTER_SNAPLA_ACCOUNTS_HASHED_OFF  (16UL)
+#define FD_METRICS_COUNTER_SNAPLA_ACCOUNTS_HASHED_NAME "snapla_accounts_hashed"
+#define FD_METRICS_COUNTER_SNAPLA_ACCOUNTS_HASHED_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_SNAPLA_ACCOUNTS_HASHED_DESC "Number of account versions hashed for snapshot lthash verification"
+#define FD_METRICS_COUNTER_SNAPLA_ACCOUNTS_HASHED_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_COUNTER_SNAPLA_BYTES_HASHED_OFF  (17UL)
+#define FD_METRICS_COUNTER_SNAPLA_BYTES_HASHED_NAME "snapla_bytes_hashed"
+#define FD_METRICS_COUNTER_SNAPLA_BYTES_HASHED_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_SNAPLA_BYTES_HASHED_DESC "Number of account data bytes hashed for snapshot lthash verification"
+#define FD_METRICS_COUNTER_SNAPLA_BYTES_HASHED_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_SNAPLA_TOTAL (2UL)
+extern const fd_metrics_meta_t FD_METRICS_SNAPLA[FD_METRICS_SNAPLA_TOTAL];
+
+#endif /* HEADER_fd_src_disco_metrics_generated_fd_metrics_snapla_h */
@@ -6,6 +6,7 @@
 
 #include "../fd_disco_base.h"
 #include "../../tango/dcache/fd_dcache.h"
+#include "../../util/net/fd_net_headers.h"
 
 struct fd_topo;
 typedef struct fd_topo fd_topo_t;
@@ -61,6 +62,108 @@ fd_net_rx_translate_frag( fd_net_rx_bounds_t const * bounds,
 
 FD_PROTOTYPES_END
 
+/* Fan-out TX messages
+
+   A fan-out TX message asks the XDP net tile to send the same UDP
+   payload to many destinations (e.g. shred retransmission to turbine
+   children).  The producer copies the payload into the TX link once,
+   instead of once per destination, and the net tile writes a fresh set
+   of headers and a copy of the payload into an XDP frame for each
+   destination.  Each net tile sends to the destinations whose netmux
+   hash maps to it, so fan-out messages are load balanced across net
+   tiles the same way as regular outgoing packets.
+
+   Fan-out messages are published with sig
+
+     fd_disco_netmux_sig( 0U, 0U, 0U, DST_PROTO_OUTGOING_FANOUT, sizeof(fd_ip4_udp_hdrs_t) )
+
+   and have the following layout:
+
+     fd_net_fanout_hdr_t  header, including an Ethernet+IPv4+UDP header
+                          template
+     uchar[ payload_sz ]  UDP payload
+     padding              to alignof(fd_net_fanout_dst_t)
+     fd_net_fanout_dst_t  dst_cnt destinations
+
+   Only the XDP net tile understands fan-out messages.  Other net tile
+   implementations (e.g. the sock tile) ignore them. */
+
+struct __attribute__((packed)) fd_net_fanout_hdr {
+  ushort            dst_cnt;
+  ushort            payload_sz;
+
+  /* Header template.  ip4->daddr, ip4->net_id, ip4->check, and
+     udp->net_dport are overwritten for each destination.  If
+     ip4->saddr is zero, it is filled in by the net tile. */
+  fd_ip4_udp_hdrs_t hdrs[1];
+};
+
+typedef struct fd_net_fanout_hdr fd_net_fanout_hdr_t;
+
+struct fd_net_fanout_dst {
+  uint   ip4;     /* destination IPv4 address, net order */
+  ushort port;    /* destination UDP port, host order */
+  ushort net_id;  /* IPv4 identification, host order */
+};
+
+typedef struct fd_net_fanout_dst fd_net_fanout_dst_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_net_fanout_dst_off returns the offset of the destination list
+   from the first byte of a fan-out message with the given payload
+   size. */
+
+FD_FN_CONST static inline ulong
+fd_net_fanout_dst_off( ulong payload_sz ) {
+  return fd_ulong_align_up( sizeof(fd_net_fanout_hdr_t)+payload_sz, alignof(fd_net_fanout_dst_t) );
+}
+
+/* fd_net_fanout_sz returns the size of a fan-out message with the given
+   payload size and destination count. */
+
+FD_FN_CONST static inline ulong
+fd_net_fanout_sz( ulong payload_sz,
+                  ulong dst_cnt ) {
+  return fd_net_fanout_dst_off( payload_sz ) + dst_cnt*sizeof(fd_net_fanout_dst_t);
+}
+
+/* fd_net_fanout_dst_max returns the max number of destinations of a
+   fan-out message with the given payload size that fits in a frag of
+   FD_NET_MTU bytes.  Returns 0 if the payload doesn't fit. */
+
+FD_FN_CONST static inline ulong
+fd_net_fanout_dst_max( ulong payload_sz ) {
+  ulong dst_off = fd_net_fanout_dst_off( payload_sz );
+  if( FD_UNLIKELY( dst_off>=FD_NET_MTU ) ) return 0UL;
+  return fd_ulong_min( (FD_NET_MTU-dst_off)/sizeof(fd_net_fanout_dst_t), USHORT_MAX );
+}
+
+/* fd_net_fanout_{payload,dst} return pointers to the payload and the
+   first destination of a fan-out message. */
+
+FD_FN_CONST static inline uchar *
+fd_net_fanout_payload( fd_net_fanout_hdr_t * hdr ) {
+  return (uchar *)( hdr+1 );
+}
+
+FD_FN_CONST static inline uchar const *
+fd_net_fanout_payload_const( fd_net_fanout_hdr_t const * hdr ) {
+  return (uchar const *)( hdr+1 );
+}
+
+FD_FN_PURE static inline fd_net_fanout_dst_t *
+fd_net_fanout_dst( fd_net_fanout_hdr_t * hdr ) {
+  return (fd_net_fanout_dst_t *)( (ulong)hdr + fd_net_fanout_dst_off( hdr->payload_sz ) );
+}
+
+FD_FN_PURE static inline fd_net_fanout_dst_t const *
+fd_net_fanout_dst_const( fd_net_fanout_hdr_t const * hdr ) {
+  return (fd_net_fanout_dst_t const *)( (ulong)hdr + fd_net_fanout_dst_off( hdr->payload_sz ) );
+}
+
+FD_PROTOTYPES_END
+
 /* Topology APIs */
 
 FD_PROTOTYPES_BEGIN
@@ -141,6 +141,7 @@ add_xdp_rx_link( fd_topo_t *  topo,
   link->depth    = depth;
   link->mtu      = FD_NET_MTU;
   link->burst    = 0UL;
+  link->prod_cnt = 1UL;
 
   fd_topo_obj_t * obj = fd_topob_obj( topo, "mcache", "net_umem" );
   link->mcache_obj_id = obj->id;
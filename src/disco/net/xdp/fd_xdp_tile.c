@@ -10,6 +10,7 @@
 #include <linux/if_xdp.h>
 
 #include "../fd_net_common.h"
+#include "../fd_net_tile.h"
 #include "../../metrics/fd_metrics.h"
 #include "../../netlink/fd_netlink_tile.h" /* neigh4_solicit */
 #include "../../topo/fd_topo.h"
@@ -190,8 +191,13 @@ typedef struct {
     uint   use_gre;           /* The tx packet will be GRE-encapsulated */
     uint   gre_outer_src_ip;  /* For GRE: Outer iphdr's src_ip in net order */
     uint   gre_outer_dst_ip;  /* For GRE: Outer iphdr's dst_ip in net order */
+
+    uint   fanout;            /* The frag is a fan-out message (see fd_net_tile.h) */
   } tx_op;
 
+  /* Speculative copy of an incoming fan-out message */
+  uchar fanout_buf[ FD_NET_MTU ] __attribute__((aligned(64)));
+
   /* Round-robin cycle serivce operations */
   uint rr_idx;
 
@@ -623,33 +629,23 @@ net_tx_route( fd_net_ctx_t * ctx,
   return 1;
 }
 
-/* before_frag is called when a new metadata descriptor for a TX job is
-   found.  This callback determines whether this net tile is responsible
-   for the TX job.  If so, it prepares the TX op for the during_frag and
-   after_frag callbacks. */
-
-static inline int
-before_frag( fd_net_ctx_t * ctx,
-             ulong          in_idx,
-             ulong          seq,
-             ulong          sig ) {
-  (void)in_idx; (void)seq;
+/* net_tx_prepare determines whether this net tile is responsible for
+   sending a packet to dst_ip.  target_idx is the net tile selected by
+   the netmux hash of the packet.  If so, resolves the route and
+   allocates a TX frame.  Returns 1 if tx_op was prepared for a send
+   (tx_op.frame is set) and 0 if the packet should be skipped. */
 
-  /* Find interface index of next packet */
-  ulong proto = fd_disco_netmux_sig_proto( sig );
-  if( FD_UNLIKELY( proto!=DST_PROTO_OUTGOING ) ) return 1;
+static int
+net_tx_prepare( fd_net_ctx_t * ctx,
+                uint           dst_ip,
+                uint           target_idx ) {
 
-  /* Load balance TX */
-  uint net_tile_cnt = ctx->net_tile_cnt;
-  uint hash         = (uint)fd_disco_netmux_sig_hash( sig );
-  uint target_idx   = hash % net_tile_cnt;
-  uint net_tile_id  = ctx->net_tile_id;
-  uint dst_ip       = fd_disco_netmux_sig_ip( sig );
+  uint net_tile_id = ctx->net_tile_id;
 
   /* Skip if another net tile is responsible for this packet.
      Fast path for net tiles other than net_tile 0. */
 
-  if( net_tile_id!=0 && net_tile_id!=target_idx ) return 1; /* ignore */
+  if( net_tile_id!=0 && net_tile_id!=target_idx ) return 0; /* ignore */
 
 
   ctx->tx_op.use_gre          = 0;
@@ -658,7 +654,7 @@ before_frag( fd_net_ctx_t * ctx,
   uint is_gre_inf             = 0;
 
   if( FD_UNLIKELY( !net_tx_route( ctx, dst_ip, &is_gre_inf ) ) ) {
-    return 1; /* metrics incremented by net_tx_route */
+    return 0; /* metrics incremented by net_tx_route */
   }
 
   uint xsk_idx     = ctx->tx_op.xsk_idx;
@@ -667,19 +663,19 @@ before_frag( fd_net_ctx_t * ctx,
     uint inner_src_ip = ctx->tx_op.src_ip;
     if( FD_UNLIKELY( !inner_src_ip ) ) {
       ctx->metrics.tx_gre_route_fail_cnt++;
-      return 1;
+      return 0;
     }
     /* Find the MAC addrs for the eth hdr, and src ip for outer ip4 hdr if not found in netdev tbl */
     ctx->tx_op.src_ip  = 0;
     is_gre_inf         = 0;
     if( FD_UNLIKELY( !net_tx_route( ctx, ctx->tx_op.gre_outer_dst_ip, &is_gre_inf ) ) ) {
       ctx->metrics.tx_gre_route_fail_cnt++;
-      return 1;
+      return 0;
     }
     if( is_gre_inf ) {
       /* Only one layer of tunnelling supported */
       ctx->metrics.tx_gre_route_fail_cnt++;
-      return 1;
+      return 0;
     }
     if( !ctx->tx_op.gre_outer_src_ip ) {
       ctx->tx_op.gre_outer_src_ip = ctx->tx_op.src_ip;
@@ -692,20 +688,20 @@ before_frag( fd_net_ctx_t * ctx,
   if( FD_UNLIKELY( xsk_idx>=ctx->xsk_cnt ) ) {
     /* Packet does not route to an XDP interface */
     ctx->metrics.tx_no_xdp_cnt++;
-    return 1;
+    return 0;
   }
 
   if( xsk_idx==XSK_IDX_LO ) target_idx = 0; /* loopback always targets tile 0 */
 
   /* Skip if another net tile is responsible for this packet */
 
-  if( net_tile_id!=target_idx ) return 1; /* ignore */
+  if( net_tile_id!=target_idx ) return 0; /* ignore */
 
   /* Skip if TX is blocked */
 
   if( FD_UNLIKELY( !net_tx_ready( ctx, xsk_idx ) ) ) {
     ctx->metrics.tx_full_fail_cnt++;
-    return 1;
+    return 0;
   }
 
   /* Allocate buffer for receive */
@@ -717,11 +713,40 @@ before_frag( fd_net_ctx_t * ctx,
 
   ctx->tx_op.frame = frame;
 
-  return 0; /* continue */
+  return 1;
+}
+
+/* before_frag is called when a new metadata descriptor for a TX job is
+   found.  This callback determines whether this net tile is responsible
+   for the TX job.  If so, it prepares the TX op for the during_frag and
+   after_frag callbacks.  Fan-out messages are accepted by all net tiles,
+   each of which sends to its share of the destinations. */
+
+static inline int
+before_frag( fd_net_ctx_t * ctx,
+             ulong          in_idx,
+             ulong          seq,
+             ulong          sig ) {
+  (void)in_idx; (void)seq;
+
+  ulong proto = fd_disco_netmux_sig_proto( sig );
+  if( proto==DST_PROTO_OUTGOING_FANOUT ) {
+    ctx->tx_op.fanout = 1;
+    return 0; /* continue */
+  }
+  if( FD_UNLIKELY( proto!=DST_PROTO_OUTGOING ) ) return 1;
+  ctx->tx_op.fanout = 0;
+
+  /* Load balance TX */
+  uint target_idx = (uint)fd_disco_netmux_sig_hash( sig ) % ctx->net_tile_cnt;
+  uint dst_ip     = fd_disco_netmux_sig_ip( sig );
+
+  return !net_tx_prepare( ctx, dst_ip, target_idx );
 }
 
 /* during_frag is called when before_frag has committed to transmit an
-   outgoing packet. */
+   outgoing packet.  Speculatively copies the packet into the XDP frame,
+   or for fan-out messages, into fanout_buf. */
 
 static inline void
 during_frag( fd_net_ctx_t * ctx,
@@ -734,6 +759,13 @@ during_frag( fd_net_ctx_t * ctx,
   if( FD_UNLIKELY( chunk<ctx->in[ in_idx ].chunk0 || chunk>ctx->in[ in_idx ].wmark || sz>FD_NET_MTU ) )
     FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz, ctx->in[ in_idx ].chunk0, ctx->in[ in_idx ].wmark ));
 
+  if( ctx->tx_op.fanout ) {
+    /* Message is validated in after_frag, once it is known to not have
+       been overrun */
+    fd_memcpy( ctx->fanout_buf, fd_chunk_to_laddr_const( ctx->in[ in_idx ].mem, chunk ), sz );
+    return;
+  }
+
   if( FD_UNLIKELY( sz<( sizeof(fd_eth_hdr_t)+sizeof(fd_ip4_hdr_t) ) ) )
     FD_LOG_ERR(( "packet too small %lu (in_idx=%lu)", sz, in_idx ));
 
@@ -760,18 +792,15 @@ during_frag( fd_net_ctx_t * ctx,
   }
 }
 
-/* after_frag is called when the during_frag memcpy was _not_ overrun. */
+/* net_tx_submit finishes the packet in the frame allocated by
+   net_tx_prepare (Ethernet addresses, GRE encapsulation, IPv4 source
+   address) and submits it to the XDP TX ring.  sz is the size of the
+   un-encapsulated packet in the frame.  On failure, tx_op.frame is left
+   allocated (metrics incremented). */
 
 static void
-after_frag( fd_net_ctx_t *      ctx,
-            ulong               in_idx,
-            ulong               seq,
-            ulong               sig,
-            ulong               sz,
-            ulong               tsorig,
-            ulong               tspub,
-            fd_stem_context_t * stem ) {
-  (void)in_idx; (void)seq; (void)sig; (void)tsorig; (void)tspub; (void)stem;
+net_tx_submit( fd_net_ctx_t * ctx,
+               ulong          sz ) {
 
   /* Current send operation */
 
@@ -883,6 +912,121 @@ after_frag( fd_net_ctx_t *      ctx,
 
 }
 
+/* net_tx_frame_release returns the TX frame of a send operation that
+   was not submitted to the free list. */
+
+static void
+net_tx_frame_release( fd_net_ctx_t * ctx ) {
+  fd_net_free_ring_t * free      = &ctx->free_tx;
+  ulong                alloc_seq = free->prod;
+  free->queue[ alloc_seq % free->depth ] = (ulong)ctx->tx_op.frame;
+  free->prod = fd_seq_inc( alloc_seq, 1UL );
+  ctx->tx_op.frame = NULL;
+}
+
+/* net_tx_copy_payload copies sz bytes of packet payload from src into
+   an XDP frame at dst.  A fan-out payload is copied into many frames
+   that the net tile does not read again (the NIC reads them via DMA),
+   so full cache lines are written with non-temporal stores to avoid
+   evicting the net tile's working set. */
+
+static inline void
+net_tx_copy_payload( uchar *       dst,
+                     uchar const * src,
+                     ulong         sz ) {
+#if FD_HAS_AVX
+  /* dst[0:off] is the partial first cache line, dst[off:body_sz] are
+     full cache lines, dst[body_sz:sz] is the partial last cache line. */
+  ulong off     = fd_ulong_min( fd_ulong_align_up( (ulong)dst, 64UL ) - (ulong)dst, sz );
+  ulong body_sz = off + fd_ulong_align_dn( sz-off, 64UL );
+  fd_memcpy( dst, src, off );
+  for( ; off<body_sz; off+=64UL ) {
+#  if FD_HAS_AVX512
+    _mm512_stream_si512( (void *)(dst+off     ), _mm512_loadu_si512( (void const *)(src+off     ) ) );
+#  else
+    _mm256_stream_si256( (void *)(dst+off     ), _mm256_loadu_si256( (void const *)(src+off     ) ) );
+    _mm256_stream_si256( (void *)(dst+off+32UL), _mm256_loadu_si256( (void const *)(src+off+32UL) ) );
+#  endif
+  }
+  fd_memcpy( dst+off, src+off, sz-off );
+  _mm_sfence(); /* order streaming stores before the TX ring submit */
+#else
+  fd_memcpy( dst, src, sz );
+#endif
+}
+
+/* net_tx_fanout sends the fan-out message in fanout_buf (sz bytes) to
+   all destinations that this net tile is responsible for.  See
+   fd_net_tile.h for the message format. */
+
+static void
+net_tx_fanout( fd_net_ctx_t * ctx,
+               ulong          sz ) {
+  fd_net_fanout_hdr_t const * msg = (fd_net_fanout_hdr_t const *)ctx->fanout_buf;
+  if( FD_UNLIKELY( sz<sizeof(fd_net_fanout_hdr_t) ) )
+    FD_LOG_ERR(( "fan-out message too small %lu", sz ));
+
+  ulong dst_cnt    = msg->dst_cnt;
+  ulong payload_sz = msg->payload_sz;
+  ulong pkt_sz     = sizeof(fd_ip4_udp_hdrs_t) + payload_sz;
+  if( FD_UNLIKELY( fd_net_fanout_sz( payload_sz, dst_cnt )>sz || pkt_sz>FD_ETH_PAYLOAD_MAX ) )
+    FD_LOG_ERR(( "fan-out message corrupt: sz=%lu dst_cnt=%lu payload_sz=%lu", sz, dst_cnt, payload_sz ));
+
+  uchar const *               payload = fd_net_fanout_payload_const( msg );
+  fd_net_fanout_dst_t const * dst     = fd_net_fanout_dst_const( msg );
+
+  for( ulong j=0UL; j<dst_cnt; j++ ) {
+    uint   dst_ip     = dst[ j ].ip4;
+    ushort dst_port   = dst[ j ].port;
+    ulong  sig        = fd_disco_netmux_sig( dst_ip, dst_port, dst_ip, DST_PROTO_OUTGOING, sizeof(fd_ip4_udp_hdrs_t) );
+    uint   target_idx = (uint)fd_disco_netmux_sig_hash( sig ) % ctx->net_tile_cnt;
+    if( !net_tx_prepare( ctx, dst_ip, target_idx ) ) continue;
+
+    fd_ip4_udp_hdrs_t hdrs = *msg->hdrs;
+    hdrs.ip4->daddr     = dst_ip;
+    hdrs.ip4->net_id    = fd_ushort_bswap( dst[ j ].net_id );
+    hdrs.ip4->check     = 0U;
+    hdrs.ip4->check     = fd_ip4_hdr_check_fast( hdrs.ip4 );
+    hdrs.udp->net_dport = fd_ushort_bswap( dst_port );
+
+    /* Same frame layout as produced by during_frag */
+    uchar * frame = ctx->tx_op.frame;
+    uchar * ip4;
+    if( ctx->tx_op.use_gre ) {
+      ip4 = frame + sizeof(fd_eth_hdr_t) + sizeof(fd_ip4_hdr_t) + sizeof(fd_gre_hdr_t);
+    } else {
+      fd_memcpy( frame, hdrs.eth, sizeof(fd_eth_hdr_t) );
+      ip4 = frame + sizeof(fd_eth_hdr_t);
+    }
+    fd_memcpy( ip4, hdrs.ip4, sizeof(fd_ip4_hdr_t)+sizeof(fd_udp_hdr_t) );
+    net_tx_copy_payload( ip4+sizeof(fd_ip4_hdr_t)+sizeof(fd_udp_hdr_t), payload, payload_sz );
+
+    net_tx_submit( ctx, pkt_sz );
+    if( FD_UNLIKELY( ctx->tx_op.frame ) ) net_tx_frame_release( ctx );
+  }
+}
+
+/* after_frag is called when the during_frag memcpy was _not_ overrun. */
+
+static void
+after_frag( fd_net_ctx_t *      ctx,
+            ulong               in_idx,
+            ulong               seq,
+            ulong               sig,
+            ulong               sz,
+            ulong               tsorig,
+            ulong               tspub,
+            fd_stem_context_t * stem ) {
+  (void)in_idx; (void)seq; (void)sig; (void)tsorig; (void)tspub; (void)stem;
+
+  if( ctx->tx_op.fanout ) {
+    net_tx_fanout( ctx, sz );
+    return;
+  }
+
+  net_tx_submit( ctx, sz );
+}
+
 /* net_rx_packet is called when a new Ethernet frame is available.
    Attempts to copy out the frame to a downstream tile. */
 
@@ -1123,11 +1267,7 @@ before_credit( fd_net_ctx_t *      ctx,
 
   if( ctx->tx_op.frame ) {
     *charge_busy = 1;
-    fd_net_free_ring_t * free      = &ctx->free_tx;
-    ulong                alloc_seq = free->prod;
-    free->queue[ alloc_seq % free->depth ] = (ulong)ctx->tx_op.frame;
-    free->prod = fd_seq_inc( alloc_seq, 1UL );
-    ctx->tx_op.frame = NULL;
+    net_tx_frame_release( ctx );
   }
 
   /* Check if new packets are available or if TX frames are free again
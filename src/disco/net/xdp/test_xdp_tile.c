@@ -837,6 +837,76 @@ main( int     argc,
     tx_chunk = fd_dcache_compact_next( tx_chunk, during_frag_expected_sz, tx_chunk0, tx_wmark );
   }
 
+  /* Fan-out TX: one payload to a plain destination, a GRE destination,
+     and an unroutable destination */
+
+  do {
+    ulong const payload_sz = FD_SHRED_MAX_SZ;
+    ulong const dst_cnt    = 3UL;
+    fd_net_fanout_hdr_t * msg = fd_chunk_to_laddr( ctx->in[ 0 ].mem, tx_chunk );
+    msg->dst_cnt    = (ushort)dst_cnt;
+    msg->payload_sz = (ushort)payload_sz;
+    fd_ip4_udp_hdr_init( msg->hdrs, payload_sz, 0U, SHRED_PORT );
+    uchar * payload = fd_net_fanout_payload( msg );
+    for( ulong j=0UL; j<payload_sz; j++ ) payload[ j ] = (uchar)( j*7UL+3UL );
+    fd_net_fanout_dst_t * dst = fd_net_fanout_dst( msg );
+    dst[ 0 ] = (fd_net_fanout_dst_t){ .ip4 = random_ip,   .port = 1001, .net_id = 11 };
+    dst[ 1 ] = (fd_net_fanout_dst_t){ .ip4 = gre1_dst_ip, .port = 1002, .net_id = 12 };
+    dst[ 2 ] = (fd_net_fanout_dst_t){ .ip4 = banned_ip,   .port = 1003, .net_id = 13 };
+    ulong msg_sz = fd_net_fanout_sz( payload_sz, dst_cnt );
+    FD_TEST( msg_sz<=FD_NET_MTU );
+    FD_TEST( fd_net_fanout_dst_max( payload_sz )>=dst_cnt );
+
+    xsk->if_idx = IF_IDX_ETH1;
+    ulong sig = fd_disco_netmux_sig( 0U, 0U, 0U, DST_PROTO_OUTGOING_FANOUT, sizeof(fd_ip4_udp_hdrs_t) );
+    FD_TEST( before_frag( ctx, 0, tx_seq, sig )==0 );
+    FD_TEST( !ctx->tx_op.frame );
+    during_frag( ctx, 0, tx_seq, sig, tx_chunk, msg_sz, 0 );
+    ulong tx_metric_before = ctx->metrics.tx_submit_cnt;
+    ulong route_fail_before = ctx->metrics.tx_route_fail_cnt;
+    long  free_before       = fd_seq_diff( ctx->free_tx.prod, ctx->free_tx.cons );
+    after_frag( ctx, 0, tx_seq, sig, msg_sz, 0, 0, NULL );
+    FD_TEST( ctx->metrics.tx_submit_cnt==tx_metric_before+2UL );
+    FD_TEST( ctx->metrics.tx_route_fail_cnt==route_fail_before+1UL );
+    FD_TEST( fd_seq_diff( ctx->free_tx.prod, ctx->free_tx.cons )==free_before-2L );
+    FD_TEST( !ctx->tx_op.frame );
+
+    /* Plain destination */
+    struct xdp_desc * desc = &xsk->ring_tx.packet_ring[ xdp_tx_ring_prod-2U ];
+    FD_TEST( desc->len==sizeof(fd_ip4_udp_hdrs_t)+payload_sz );
+    fd_ip4_udp_hdrs_t const * hdrs = (fd_ip4_udp_hdrs_t const *)( (ulong)desc->addr + (ulong)ctx->umem_frame0 );
+    FD_TEST( fd_memeq( hdrs->eth->dst, eth1_dst_mac_addr, 6 ) );
+    FD_TEST( fd_memeq( hdrs->eth->src, eth1_src_mac_addr, 6 ) );
+    FD_TEST( hdrs->eth->net_type==fd_ushort_bswap( FD_ETH_HDR_TYPE_IP ) );
+    FD_TEST( hdrs->ip4->saddr==default_src_ip );
+    FD_TEST( hdrs->ip4->daddr==random_ip );
+    FD_TEST( hdrs->ip4->net_id==fd_ushort_bswap( 11 ) );
+    FD_TEST( fd_ip4_hdr_check( hdrs->ip4 )==0 );
+    FD_TEST( hdrs->udp->net_sport==fd_ushort_bswap( SHRED_PORT ) );
+    FD_TEST( hdrs->udp->net_dport==fd_ushort_bswap( 1001 ) );
+    FD_TEST( fd_memeq( hdrs+1, payload, payload_sz ) );
+
+    /* GRE destination */
+    desc = &xsk->ring_tx.packet_ring[ xdp_tx_ring_prod-1U ];
+    ulong gre_overhead = sizeof(fd_ip4_hdr_t)+sizeof(fd_gre_hdr_t);
+    FD_TEST( desc->len==sizeof(fd_ip4_udp_hdrs_t)+gre_overhead+payload_sz );
+    uchar const * frame = (uchar const *)( (ulong)desc->addr + (ulong)ctx->umem_frame0 );
+    fd_ip4_hdr_t const * outer_ip4 = (fd_ip4_hdr_t const *)( frame+sizeof(fd_eth_hdr_t) );
+    fd_ip4_hdr_t const * inner_ip4 = (fd_ip4_hdr_t const *)( frame+sizeof(fd_eth_hdr_t)+gre_overhead );
+    fd_udp_hdr_t const * inner_udp = (fd_udp_hdr_t const *)( inner_ip4+1 );
+    FD_TEST( outer_ip4->saddr==gre1_outer_src_ip );
+    FD_TEST( outer_ip4->daddr==gre1_outer_dst_ip );
+    FD_TEST( inner_ip4->saddr==gre1_src_ip );
+    FD_TEST( inner_ip4->daddr==gre1_dst_ip );
+    FD_TEST( inner_ip4->net_id==fd_ushort_bswap( 12 ) );
+    FD_TEST( fd_ip4_hdr_check( inner_ip4 )==0 );
+    FD_TEST( inner_udp->net_dport==fd_ushort_bswap( 1002 ) );
+    FD_TEST( fd_memeq( inner_udp+1, payload, payload_sz ) );
+
+    tx_seq++;
+    tx_chunk = fd_dcache_compact_next( tx_chunk, msg_sz, tx_chunk0, tx_wmark );
+  } while(0);
+
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
 }
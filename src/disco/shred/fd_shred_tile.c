@@ -184,6 +184,17 @@ typedef struct {
   fd_ip4_udp_hdrs_t data_shred_net_hdr  [1];
   fd_ip4_udp_hdrs_t parity_shred_net_hdr[1];
 
+  /* If net_fanout is set, all copies of a shred are sent to the net
+     tile as fan-out messages (see fd_net_tile.h) instead of one packet
+     per destination.  fanout tracks the message being built for the
+     current shred. */
+  int net_fanout;
+  struct {
+    fd_shred_t const *    shred;
+    fd_net_fanout_hdr_t * msg;      /* in net_out dcache, NULL if no destinations added yet */
+    ulong                 dst_max;
+  } fanout;
+
   ulong shredder_fec_set_idx;     /* In [0, shredder_max_fec_set_idx) */
   ulong shredder_max_fec_set_idx; /* exclusive */
 
@@ -760,6 +771,76 @@ send_shred( fd_shred_ctx_t                 * ctx,
   ctx->net_out_chunk = fd_dcache_compact_next( chunk, pkt_sz, ctx->net_out_chunk0, ctx->net_out_wmark );
 }
 
+/* shred_fanout_{begin,add,end} send a shred to a list of destinations.
+   Without net_fanout, shred_fanout_add sends one packet per destination
+   via send_shred.  With net_fanout, destinations are accumulated into
+   fan-out messages that are published to the net tile when full and in
+   shred_fanout_end. */
+
+static inline void
+shred_fanout_begin( fd_shred_ctx_t *   ctx,
+                    fd_shred_t const * shred ) {
+  ctx->fanout.shred = shred;
+  ctx->fanout.msg   = NULL;
+}
+
+static void
+shred_fanout_publish( fd_shred_ctx_t *    ctx,
+                      fd_stem_context_t * stem,
+                      ulong               tsorig ) {
+  fd_net_fanout_hdr_t * msg = ctx->fanout.msg;
+  ulong msg_sz = fd_net_fanout_sz( msg->payload_sz, msg->dst_cnt );
+  ulong tspub  = fd_frag_meta_ts_comp( fd_tickcount() );
+  ulong sig    = fd_disco_netmux_sig( 0U, 0U, 0U, DST_PROTO_OUTGOING_FANOUT, sizeof(fd_ip4_udp_hdrs_t) );
+  ulong const chunk = ctx->net_out_chunk;
+  fd_stem_publish( stem, NET_OUT_IDX, sig, chunk, msg_sz, 0UL, tsorig, tspub );
+  ctx->net_out_chunk = fd_dcache_compact_next( chunk, msg_sz, ctx->net_out_chunk0, ctx->net_out_wmark );
+  ctx->fanout.msg    = NULL;
+}
+
+static inline void
+shred_fanout_add( fd_shred_ctx_t *                 ctx,
+                  fd_stem_context_t *              stem,
+                  fd_shred_dest_weighted_t const * dest,
+                  ulong                            tsorig ) {
+  if( !ctx->net_fanout ) {
+    send_shred( ctx, stem, ctx->fanout.shred, dest, tsorig );
+    return;
+  }
+
+  if( FD_UNLIKELY( !dest->ip4 ) ) return;
+
+  fd_net_fanout_hdr_t * msg = ctx->fanout.msg;
+  if( !msg ) {
+    /* First destination, copy the shred into the message */
+    fd_shred_t const * shred   = ctx->fanout.shred;
+    int                is_data = fd_shred_is_data( fd_shred_type( shred->variant ) );
+    ulong              shred_sz = fd_ulong_if( is_data, FD_SHRED_MIN_SZ, FD_SHRED_MAX_SZ );
+
+    msg = ctx->fanout.msg = fd_chunk_to_laddr( ctx->net_out_mem, ctx->net_out_chunk );
+    msg->dst_cnt    = 0;
+    msg->payload_sz = (ushort)shred_sz;
+    *msg->hdrs      = *( is_data ? ctx->data_shred_net_hdr : ctx->parity_shred_net_hdr );
+    fd_memcpy( fd_net_fanout_payload( msg ), shred, shred_sz );
+    ctx->fanout.dst_max = fd_net_fanout_dst_max( shred_sz );
+  }
+
+  fd_net_fanout_dst( msg )[ msg->dst_cnt ] = (fd_net_fanout_dst_t) {
+    .ip4    = dest->ip4,
+    .port   = dest->port,
+    .net_id = ctx->net_id++
+  };
+  msg->dst_cnt++;
+  if( FD_UNLIKELY( msg->dst_cnt>=ctx->fanout.dst_max ) ) shred_fanout_publish( ctx, stem, tsorig );
+}
+
+static inline void
+shred_fanout_end( fd_shred_ctx_t *    ctx,
+                  fd_stem_context_t * stem,
+                  ulong               tsorig ) {
+  if( ctx->fanout.msg ) shred_fanout_publish( ctx, stem, tsorig );
+}
+
 static void
 after_frag( fd_shred_ctx_t *    ctx,
             ulong               in_idx,
@@ -949,8 +1030,10 @@ after_frag( fd_shred_ctx_t *    ctx,
           fd_shred_dest_idx_t * dests = fd_shred_dest_compute_children( sdest, &shred, 1UL, ctx->scratchpad_dests, 1UL, fanout, fanout, max_dest_cnt );
           if( FD_UNLIKELY( !dests ) ) break;
 
-          for( ulong i=0UL; i<ctx->adtl_dests_retransmit_cnt; i++ ) send_shred( ctx, stem, *out_shred, ctx->adtl_dests_retransmit+i, ctx->tsorig );
-          for( ulong j=0UL; j<*max_dest_cnt; j++ ) send_shred( ctx, stem, *out_shred, fd_shred_dest_idx_to_dest( sdest, dests[ j ] ), ctx->tsorig );
+          shred_fanout_begin( ctx, *out_shred );
+          for( ulong i=0UL; i<ctx->adtl_dests_retransmit_cnt; i++ ) shred_fanout_add( ctx, stem, ctx->adtl_dests_retransmit+i, ctx->tsorig );
+          for( ulong j=0UL; j<*max_dest_cnt; j++ ) shred_fanout_add( ctx, stem, fd_shred_dest_idx_to_dest( sdest, dests[ j ] ), ctx->tsorig );
+          shred_fanout_end( ctx, stem, ctx->tsorig );
         } while( 0 );
       }
 
@@ -1149,28 +1232,33 @@ after_frag( fd_shred_ctx_t *    ctx,
     ulong out_stride;
     ulong max_dest_cnt[1];
     fd_shred_dest_idx_t * dests;
+    fd_shred_dest_weighted_t const * adtl_dests;
+    ulong                            adtl_dest_cnt;
     if( FD_LIKELY( ctx->in_kind[ in_idx ]==IN_KIND_NET ) ) {
-      for( ulong i=0UL; i<k; i++ ) {
-        for( ulong j=0UL; j<ctx->adtl_dests_retransmit_cnt; j++ ) send_shred( ctx, stem, new_shreds[ i ], ctx->adtl_dests_retransmit+j, ctx->tsorig );
-      }
+      adtl_dests    = ctx->adtl_dests_retransmit;
+      adtl_dest_cnt = ctx->adtl_dests_retransmit_cnt;
       out_stride = k;
       /* In the case of feature activation, the fanout used below is
           the same as the one calculated/modified previously at the
           beginning of after_frag() for IN_KIND_NET in this slot. */
       dests = fd_shred_dest_compute_children( sdest, new_shreds, k, ctx->scratchpad_dests, k, fanout, fanout, max_dest_cnt );
     } else {
-      for( ulong i=0UL; i<k; i++ ) {
-        for( ulong j=0UL; j<ctx->adtl_dests_leader_cnt; j++ ) send_shred( ctx, stem, new_shreds[ i ], ctx->adtl_dests_leader+j, ctx->tsorig );
-      }
+      adtl_dests    = ctx->adtl_dests_leader;
+      adtl_dest_cnt = ctx->adtl_dests_leader_cnt;
       out_stride = 1UL;
       *max_dest_cnt = 1UL;
       dests = fd_shred_dest_compute_first   ( sdest, new_shreds, k, ctx->scratchpad_dests );
     }
-    if( FD_UNLIKELY( !dests ) ) return;
+    /* The additional destinations get every shred, even if the turbine
+       destinations can't be computed. */
+    if( FD_UNLIKELY( !dests ) ) *max_dest_cnt = 0UL;
 
     /* Send only the ones we didn't receive. */
     for( ulong i=0UL; i<k; i++ ) {
-      for( ulong j=0UL; j<*max_dest_cnt; j++ ) send_shred( ctx, stem, new_shreds[ i ], fd_shred_dest_idx_to_dest( sdest, dests[ j*out_stride+i ]), ctx->tsorig );
+      shred_fanout_begin( ctx, new_shreds[ i ] );
+      for( ulong j=0UL; j<adtl_dest_cnt;  j++ ) shred_fanout_add( ctx, stem, adtl_dests+j, ctx->tsorig );
+      for( ulong j=0UL; j<*max_dest_cnt; j++ ) shred_fanout_add( ctx, stem, fd_shred_dest_idx_to_dest( sdest, dests[ j*out_stride+i ]), ctx->tsorig );
+      shred_fanout_end( ctx, stem, ctx->tsorig );
     }
   }
 }
@@ -1343,7 +1431,8 @@ unprivileged_init( fd_topo_t *      topo,
 
   ctx->stake_ci = fd_stake_ci_join( fd_stake_ci_new( _stake_ci, ctx->identity_key ) );
 
-  ctx->net_id   = (ushort)0;
+  ctx->net_id     = (ushort)0;
+  ctx->net_fanout = tile->shred.net_fanout;
 
   fd_ip4_udp_hdr_init( ctx->data_shred_net_hdr,   FD_SHRED_MIN_SZ, 0, tile->shred.shred_listen_port );
   fd_ip4_udp_hdr_init( ctx->parity_shred_net_hdr, FD_SHRED_MAX_SZ, 0, tile->shred.shred_listen_port );
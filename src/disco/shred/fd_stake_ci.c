@@ -2,20 +2,31 @@
 #include "fd_shred_dest.h"
 #include "../../util/net/fd_ip4.h" /* Just for debug */
 
+/* These sorts are keyed by 32-byte pubkeys (possibly after an 8-byte
+   stake), so radix sorts are much faster than comparison sorts.  The
+   radix bytes are in significance order, complemented for descending
+   orders. */
+
 #define SORT_NAME sort_pubkey
 #define SORT_KEY_T fd_shred_dest_weighted_t
+#define SORT_RADIX_SZ 32UL
+#define SORT_RADIX_BYTE(e,i) ((e).pubkey.uc[ (i) ])
 #define SORT_BEFORE(a,b) (memcmp( (a).pubkey.uc, (b).pubkey.uc, 32UL )<0)
-#include "../../util/tmpl/fd_sort.c"
+#include "../../util/tmpl/fd_sort_radix.c"
 
 #define SORT_NAME sort_weights_by_stake_id
 #define SORT_KEY_T fd_stake_weight_t
+#define SORT_RADIX_SZ 40UL
+#define SORT_RADIX_BYTE(e,i) ((uchar)~( (i)<8UL ? (uchar)( (e).stake >> (56UL-8UL*(i)) ) : (e).key.uc[ (i)-8UL ] ))
 #define SORT_BEFORE(a,b) ((a).stake > (b).stake ? 1 : ((a).stake < (b).stake ? 0 : memcmp( (a).key.uc, (b).key.uc, 32UL )>0))
-#include "../../util/tmpl/fd_sort.c"
+#include "../../util/tmpl/fd_sort_radix.c"
 
 #define SORT_NAME sort_weights_by_id
 #define SORT_KEY_T fd_stake_weight_t
+#define SORT_RADIX_SZ 32UL
+#define SORT_RADIX_BYTE(e,i) ((uchar)~(e).key.uc[ (i) ])
 #define SORT_BEFORE(a,b) (memcmp( (a).key.uc, (b).key.uc, 32UL )>0)
-#include "../../util/tmpl/fd_sort.c"
+#include "../../util/tmpl/fd_sort_radix.c"
 
 /* We don't have or need real contact info for the local validator, but
    we want to be able to distinguish it from staked nodes with no
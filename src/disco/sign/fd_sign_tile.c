@@ -16,6 +16,15 @@
 
 #define MAX_IN (32UL)
 
+/* Signing requests are not signed as soon as they arrive.  Instead,
+   they are authorized and queued, and the queue is signed in one
+   fd_ed25519_sign_batch call once every in has been polled without
+   finding a new request (or once the queue is full).  Keyguard clients
+   block on their request, so the queue naturally fills up with at most
+   one request per in when several tiles are signing concurrently. */
+
+#define SIGN_BATCH_MAX (8UL)
+
 /* fd_sign_in_ctx_t is a context object for each in (producer) mcache
    connected to the sign tile. */
 
@@ -36,8 +45,25 @@ struct fd_sign_in_ctx {
 };
 typedef struct fd_sign_in_ctx fd_sign_in_ctx_t;
 
+/* fd_sign_req_t is a queued signing request.  The message to sign is
+   staged in buf after FD_ED25519_SIGN_BATCH_HEADROOM bytes of scratch
+   space used by fd_ed25519_sign_batch. */
+
+struct fd_sign_req {
+  ulong in_idx;
+  ulong sig;
+  ulong sz;
+  ulong tsorig;
+  ulong out_chunk;
+  uchar buf[ FD_ED25519_SIGN_BATCH_HEADROOM+FD_KEYGUARD_SIGN_REQ_MTU ];
+};
+typedef struct fd_sign_req fd_sign_req_t;
+
 typedef struct {
-  uchar             _data[ FD_KEYGUARD_SIGN_REQ_MTU ];
+  fd_sign_req_t     req[ SIGN_BATCH_MAX ];
+  ulong             req_cnt;
+  ulong             idle_cnt; /* number of polls since the last request was queued */
+  ulong             in_cnt;
 
   /* Pre-staged with the public key base58 encoded, followed by "-" in the first bytes */
   ulong public_key_base58_sz;
@@ -87,6 +113,11 @@ derive_fields( fd_sign_ctx_t * ctx ) {
 
 static void FD_FN_SENSITIVE
 during_housekeeping_sensitive( fd_sign_ctx_t * ctx ) {
+  /* Queued requests were authorized against the current identity, so
+     they must be signed before the key is switched.  The switch is
+     retried on the next housekeeping. */
+  if( FD_UNLIKELY( ctx->req_cnt ) ) return;
+
   if( FD_UNLIKELY( fd_keyswitch_state_query( ctx->keyswitch )==FD_KEYSWITCH_STATE_SWITCH_PENDING ) ) {
     memcpy( ctx->private_key, ctx->keyswitch->bytes, 32UL );
     explicit_bzero( ctx->keyswitch->bytes, 32UL );
@@ -133,7 +164,7 @@ during_frag_sensitive( void * _ctx,
   }
 
   void * src = fd_chunk_to_laddr( ctx->in[ in_idx ].mem, chunk );
-  fd_memcpy( ctx->_data, src, sz );
+  fd_memcpy( ctx->req[ ctx->req_cnt ].buf+FD_ED25519_SIGN_BATCH_HEADROOM, src, sz );
 }
 
 
@@ -159,6 +190,7 @@ after_frag_sensitive( void *              _ctx,
                       fd_stem_context_t * stem ) {
   (void)seq;
   (void)tspub;
+  (void)stem;
 
   fd_sign_ctx_t * ctx = (fd_sign_ctx_t *)_ctx;
 
@@ -170,47 +202,54 @@ after_frag_sensitive( void *              _ctx,
 
   int role = ctx->in[ in_idx ].role;
 
+  fd_sign_req_t * req = &ctx->req[ ctx->req_cnt ];
+  uchar *         msg = req->buf+FD_ED25519_SIGN_BATCH_HEADROOM;
+
   fd_keyguard_authority_t authority = {0};
   memcpy( authority.identity_pubkey, ctx->public_key, 32 );
 
-  if( FD_UNLIKELY( !fd_keyguard_payload_authorize( &authority, ctx->_data, sz, role, sign_type ) ) ) {
+  if( FD_UNLIKELY( !fd_keyguard_payload_authorize( &authority, msg, sz, role, sign_type ) ) ) {
     FD_LOG_EMERG(( "fd_keyguard_payload_authorize failed (role=%d sign_type=%d)", role, sign_type ));
   }
 
-  long sign_duration = -fd_tickcount();
-
-  uchar * dst = fd_chunk_to_laddr( ctx->out[ in_idx ].out_mem, ctx->out[ in_idx ].out_chunk );
+  /* Rewrite the payload in place into the message to sign. */
 
   switch( sign_type ) {
   case FD_KEYGUARD_SIGN_TYPE_ED25519: {
-    fd_ed25519_sign( dst, ctx->_data, sz, ctx->public_key, ctx->private_key, ctx->sha512 );
     break;
   }
   case FD_KEYGUARD_SIGN_TYPE_SHA256_ED25519: {
     uchar hash[ 32 ];
-    fd_sha256_hash( ctx->_data, sz, hash );
-    fd_ed25519_sign( dst, hash, 32UL, ctx->public_key, ctx->private_key, ctx->sha512 );
+    fd_sha256_hash( msg, sz, hash );
+    memcpy( msg, hash, 32UL );
+    sz = 32UL;
     break;
   }
   case FD_KEYGUARD_SIGN_TYPE_PUBKEY_CONCAT_ED25519: {
-    memcpy( ctx->concat+ctx->public_key_base58_sz+1UL, ctx->_data, 9UL );
-    fd_ed25519_sign( dst, ctx->concat, ctx->public_key_base58_sz+1UL+9UL, ctx->public_key, ctx->private_key, ctx->sha512 );
+    memmove( msg+ctx->public_key_base58_sz+1UL, msg, 9UL );
+    memcpy( msg, ctx->concat, ctx->public_key_base58_sz+1UL );
+    sz = ctx->public_key_base58_sz+1UL+9UL;
     break;
   }
   case FD_KEYGUARD_SIGN_TYPE_FD_METRICS_REPORT_CONCAT_ED25519: {
-    memcpy( ctx->event_concat+18UL, ctx->_data, 32UL );
-    fd_ed25519_sign( dst, ctx->event_concat, 18UL+32UL, ctx->public_key, ctx->private_key, ctx->sha512 );
+    memmove( msg+18UL, msg, 32UL );
+    memcpy( msg, ctx->event_concat, 18UL );
+    sz = 18UL+32UL;
     break;
   }
   default:
     FD_LOG_EMERG(( "invalid sign type: %d", sign_type ));
   }
 
-  sign_duration += fd_tickcount();
-  fd_histf_sample( ctx->sign_duration, (ulong)sign_duration );
-
-  fd_stem_publish( stem, in_idx, sig, ctx->out[ in_idx ].out_chunk, 64UL, 0UL, tsorig, 0UL );
+  req->in_idx    = in_idx;
+  req->sig       = sig;
+  req->sz        = sz;
+  req->tsorig    = tsorig;
+  req->out_chunk = ctx->out[ in_idx ].out_chunk;
   ctx->out[ in_idx ].out_chunk = fd_dcache_compact_next( ctx->out[ in_idx ].out_chunk, 64UL, ctx->out[ in_idx ].out_chunk0, ctx->out[ in_idx ].out_wmark );
+
+  ctx->req_cnt++;
+  ctx->idle_cnt = 0UL;
 }
 
 static void
@@ -225,6 +264,52 @@ after_frag( void *              _ctx,
   after_frag_sensitive( _ctx, in_idx, seq, sig, sz, tsorig, tspub, stem );
 }
 
+static void FD_FN_SENSITIVE
+sign_batch_sensitive( fd_sign_ctx_t *     ctx,
+                      fd_stem_context_t * stem ) {
+  ulong   req_cnt = ctx->req_cnt;
+  uchar * sigs[ SIGN_BATCH_MAX ];
+  uchar * bufs[ SIGN_BATCH_MAX ];
+  ulong   szs [ SIGN_BATCH_MAX ];
+  for( ulong i=0UL; i<req_cnt; i++ ) {
+    fd_sign_req_t * req = &ctx->req[ i ];
+    sigs[ i ] = fd_chunk_to_laddr( ctx->out[ req->in_idx ].out_mem, req->out_chunk );
+    bufs[ i ] = req->buf;
+    szs [ i ] = req->sz;
+  }
+
+  long sign_duration = -fd_tickcount();
+  fd_ed25519_sign_batch( sigs, bufs, szs, req_cnt, ctx->public_key, ctx->private_key, ctx->sha512 );
+  sign_duration += fd_tickcount();
+
+  for( ulong i=0UL; i<req_cnt; i++ ) {
+    fd_sign_req_t * req = &ctx->req[ i ];
+    fd_histf_sample( ctx->sign_duration, (ulong)sign_duration/req_cnt );
+    fd_stem_publish( stem, req->in_idx, req->sig, req->out_chunk, 64UL, 0UL, req->tsorig, 0UL );
+  }
+  ctx->req_cnt = 0UL;
+}
+
+static inline void
+after_credit( fd_sign_ctx_t *     ctx,
+              fd_stem_context_t * stem,
+              int *               opt_poll_in,
+              int *               charge_busy ) {
+  (void)opt_poll_in;
+
+  if( FD_LIKELY( !ctx->req_cnt ) ) return;
+
+  /* Keep polling until every in has come up empty since the last
+     request was queued, so a burst of requests is signed together. */
+  if( FD_LIKELY( ctx->req_cnt<SIGN_BATCH_MAX && ctx->idle_cnt<ctx->in_cnt ) ) {
+    ctx->idle_cnt++;
+    return;
+  }
+
+  *charge_busy = 1;
+  sign_batch_sensitive( ctx, stem );
+}
+
 static void FD_FN_SENSITIVE
 privileged_init_sensitive( fd_topo_t *      topo,
                            fd_topo_tile_t * tile ) {
@@ -273,6 +358,10 @@ unprivileged_init_sensitive( fd_topo_t *      topo,
   FD_TEST( tile->in_cnt<=MAX_IN );
   FD_TEST( tile->in_cnt==tile->out_cnt );
 
+  ctx->req_cnt  = 0UL;
+  ctx->idle_cnt = 0UL;
+  ctx->in_cnt   = tile->in_cnt;
+
   fd_histf_join( fd_histf_new( ctx->sign_duration, FD_MHIST_SECONDS_MIN( SIGN, SIGN_DURATION_SECONDS ),
                                                        FD_MHIST_SECONDS_MAX( SIGN, SIGN_DURATION_SECONDS ) ) );
 
@@ -381,7 +470,7 @@ populate_allowed_fds( fd_topo_t const *      topo,
   return out_cnt;
 }
 
-#define STEM_BURST (1UL)
+#define STEM_BURST SIGN_BATCH_MAX
 
 /* See explanation in fd_pack */
 #define STEM_LAZY  (128L*3000L)
@@ -391,6 +480,7 @@ populate_allowed_fds( fd_topo_t const *      topo,
 
 #define STEM_CALLBACK_DURING_HOUSEKEEPING during_housekeeping
 #define STEM_CALLBACK_METRICS_WRITE       metrics_write
+#define STEM_CALLBACK_AFTER_CREDIT        after_credit
 #define STEM_CALLBACK_DURING_FRAG         during_frag
 #define STEM_CALLBACK_AFTER_FRAG          after_frag
 
@@ -0,0 +1,4 @@
+ifdef FD_HAS_HOSTED
+$(call make-unit-test,test_stem_mp,test_stem_mp,fd_disco fd_tango fd_util)
+$(call run-unit-test,test_stem_mp)
+endif
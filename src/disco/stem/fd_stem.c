@@ -163,7 +163,17 @@
       AFTER_POLL_OVERRUN
    Is called when an overrun is detected while polling for new frags.
    This callback is not called when an overrun is detected in
-   during_frag. */
+   during_frag.
+
+   Outs can be multi-producer mcaches (see fd_mcache_new_mp and
+   fd_topob_link_mp) shared with other tiles.  fd_stem_publish and
+   fd_stem_advance then claim sequence numbers from the mcache's shared
+   counter, and the stem checks the shared counter against the credits
+   of the reliable consumers every run loop iteration (instead of only
+   counting its own publishes), reserving a burst for each of the other
+   producers, which are assumed to have a burst of at most STEM_BURST.
+   Multi-producer ins need no special handling, as they look like any
+   other mcache to consumers. */
 
 #if !FD_HAS_ALLOCA
 #error "fd_stem requires alloca"
@@ -227,6 +237,8 @@ STEM_(scratch_footprint)( ulong in_cnt,
   l = FD_LAYOUT_APPEND( l, alignof(ulong),             out_cnt*sizeof(ulong)                ); /* cr_avail */
   l = FD_LAYOUT_APPEND( l, alignof(ulong),             out_cnt*sizeof(ulong)                ); /* out_depth */
   l = FD_LAYOUT_APPEND( l, alignof(ulong),             out_cnt*sizeof(ulong)                ); /* out_seq */
+  l = FD_LAYOUT_APPEND( l, alignof(ulong *),           out_cnt*sizeof(ulong *)              ); /* out_mp */
+  l = FD_LAYOUT_APPEND( l, alignof(ulong),             out_cnt*sizeof(ulong)                ); /* out_mp_lim */
   l = FD_LAYOUT_APPEND( l, alignof(ulong const *),     cons_cnt*sizeof(ulong const *)       ); /* cons_fseq */
   l = FD_LAYOUT_APPEND( l, alignof(ulong *),           cons_cnt*sizeof(ulong *)             ); /* cons_slow */
   l = FD_LAYOUT_APPEND( l, alignof(ulong),             cons_cnt*sizeof(ulong)               ); /* cons_out */
@@ -259,6 +271,9 @@ STEM_(run1)( ulong                        in_cnt,
   /* out frag stream state */
   ulong *        out_depth; /* ==fd_mcache_depth( out_mcache[out_idx] ) for out_idx in [0, out_cnt) */
   ulong *        out_seq;  /* next mux frag sequence number to publish for out_idx in [0, out_cnt) ]*/
+  ulong **       out_mp;     /* out_mp[out_idx] is the shared claim counter of out_idx if it is a multi-producer mcache, NULL otherwise */
+  ulong *        out_mp_lim; /* out_mp_lim[out_idx] is the sequence number multi-producer out_idx may be claimed up to (exclusive) */
+  ulong          out_mp_cnt; /* number of multi-producer outs */
 
   /* out flow control state */
   ulong *        cr_avail;     /* number of flow control credits available to publish downstream across all outs */
@@ -327,6 +342,9 @@ STEM_(run1)( ulong                        in_cnt,
 
   out_depth  = (ulong *)FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong), out_cnt*sizeof(ulong) );
   out_seq    = (ulong *)FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong), out_cnt*sizeof(ulong) );
+  out_mp     = (ulong **)FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong *), out_cnt*sizeof(ulong *) );
+  out_mp_lim = (ulong *)FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong), out_cnt*sizeof(ulong) );
+  out_mp_cnt = 0UL;
 
   ulong cr_max = fd_ulong_if( !out_cnt, 128UL, ULONG_MAX );
 
@@ -338,6 +356,20 @@ STEM_(run1)( ulong                        in_cnt,
     out_seq[ out_idx ] = 0UL;
 
     cr_avail[ out_idx ] = out_depth[ out_idx ];
+
+    /* Multi-producer outs have no credits until the first credit
+       update */
+    out_mp    [ out_idx ] = NULL;
+    out_mp_lim[ out_idx ] = 0UL;
+    if( FD_UNLIKELY( fd_mcache_prod_cnt( out_mcache[ out_idx ] )>1UL ) ) {
+#if FD_HAS_ATOMIC
+      out_mp    [ out_idx ] = fd_mcache_mp_next_laddr( out_mcache[ out_idx ] );
+      out_mp_lim[ out_idx ] = fd_mcache_mp_query( out_mp[ out_idx ] );
+      out_mp_cnt++;
+#else
+      FD_LOG_ERR(( "multi-producer out_mcache[%lu] requires FD_HAS_ATOMIC", out_idx ));
+#endif
+    }
   }
 
   cons_fseq = (ulong const **)FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong const *), cons_cnt*sizeof(ulong const *) );
@@ -433,11 +465,28 @@ STEM_(run1)( ulong                        in_cnt,
           min_cr_avail = cr_max;
           for( ulong out_idx=0; out_idx<out_cnt; out_idx++ ) {
             cr_avail[ out_idx ] = out_depth[ out_idx ];
+
+            /* Multi-producer outs count credits against the shared
+               claim counter (out_seq only tracks our own claims) */
+            if( FD_UNLIKELY( out_mp[ out_idx ] ) ) {
+              out_seq   [ out_idx ] = fd_mcache_mp_query( out_mp[ out_idx ] );
+              out_mp_lim[ out_idx ] = fd_seq_inc( out_seq[ out_idx ], out_depth[ out_idx ] );
+            }
           }
 
           for( ulong cons_idx=0UL; cons_idx<cons_cnt; cons_idx++ ) {
             ulong out_idx = cons_out[ cons_idx ];
-            ulong cons_cr_avail = (ulong)fd_long_max( (long)out_depth[ out_idx ]-fd_long_max( fd_seq_diff( out_seq[ out_idx ], cons_seq[ cons_idx ] ), 0L ), 0L );
+            ulong cons_cr_avail;
+            if( FD_LIKELY( !out_mp[ out_idx ] ) ) {
+              cons_cr_avail = (ulong)fd_long_max( (long)out_depth[ out_idx ]-fd_long_max( fd_seq_diff( out_seq[ out_idx ], cons_seq[ cons_idx ] ), 0L ), 0L );
+            } else {
+              cons_cr_avail = fd_mcache_mp_cr_avail( out_seq[ out_idx ], cons_seq[ cons_idx ], out_depth[ out_idx ],
+                                                     fd_mcache_prod_cnt( out_mcache[ out_idx ] ), burst );
+              if( FD_LIKELY( cons_seq[ cons_idx ]!=STEM_SHUTDOWN_SEQ ) ) {
+                ulong lim = fd_seq_inc( out_seq[ out_idx ], cons_cr_avail );
+                if( fd_seq_lt( lim, out_mp_lim[ out_idx ] ) ) out_mp_lim[ out_idx ] = lim;
+              }
+            }
 
             /* If a reliable consumer exits, they can set the credit
                return fseq to STEM_SHUTDOWN_SEQ to indicate they are no
@@ -510,6 +559,7 @@ STEM_(run1)( ulong                        in_cnt,
       .cr_avail            = cr_avail,
       .min_cr_avail        = &min_cr_avail,
       .cr_decrement_amount = fd_ulong_if( out_cnt>0UL, 1UL, 0UL ),
+      .mp_next             = fd_ptr_if( !!out_mp_cnt, out_mp, NULL ),
     };
 #endif
 
@@ -526,6 +576,21 @@ STEM_(run1)( ulong                        in_cnt,
      different threads of execution.  We only count the transition
      from not backpressured to backpressured. */
 
+    /* Other producers of multi-producer outs consume credits as well.
+       Reading the shared claim counter before every iteration (which
+       publishes at most a burst) bounds the number of in flight frags
+       to the depth, as every producer reserves a burst for each of the
+       others. */
+
+    if( FD_UNLIKELY( out_mp_cnt ) ) {
+      for( ulong out_idx=0UL; out_idx<out_cnt; out_idx++ ) {
+        if( FD_LIKELY( !out_mp[ out_idx ] ) ) continue;
+        ulong out_cr_avail = (ulong)fd_long_max( fd_seq_diff( out_mp_lim[ out_idx ], fd_mcache_mp_query( out_mp[ out_idx ] ) ), 0L );
+        cr_avail[ out_idx ] = fd_ulong_min( cr_avail[ out_idx ], out_cr_avail );
+        min_cr_avail        = fd_ulong_min( min_cr_avail,        out_cr_avail );
+      }
+    }
+
     if( FD_UNLIKELY( min_cr_avail<burst ) ) {
       metric_backp_cnt += (ulong)!metric_in_backp;
       metric_in_backp   = 1UL;
@@ -13,6 +13,13 @@ struct fd_stem_context {
    ulong *           cr_avail;
    ulong *           min_cr_avail;
    ulong             cr_decrement_amount;
+
+   /* mp_next is NULL if none of the outs is a multi-producer mcache.
+      Otherwise, mp_next[ out_idx ] is the shared claim counter of out
+      out_idx (see fd_mcache_mp_next_laddr) or NULL if out out_idx has a
+      single producer.  Sequence numbers of multi-producer outs are
+      claimed from the shared counter instead of taken from seqs. */
+   ulong **          mp_next;
 };
 
 typedef struct fd_stem_context fd_stem_context_t;
@@ -31,6 +38,18 @@ struct __attribute__((aligned(64))) fd_stem_tile_in {
 
 typedef struct fd_stem_tile_in fd_stem_tile_in_t;
 
+/* fd_stem_out_seq returns the sequence number to publish the next frag
+   of out out_idx at, claiming it if out_idx is a multi-producer out. */
+
+static inline ulong
+fd_stem_out_seq( fd_stem_context_t * stem,
+                 ulong               out_idx ) {
+#if FD_HAS_ATOMIC
+  if( FD_UNLIKELY( stem->mp_next && stem->mp_next[ out_idx ] ) ) return fd_mcache_mp_claim( stem->mp_next[ out_idx ], 1UL );
+#endif
+  return stem->seqs[ out_idx ];
+}
+
 static inline void
 fd_stem_publish( fd_stem_context_t * stem,
                  ulong               out_idx,
@@ -41,7 +60,7 @@ fd_stem_publish( fd_stem_context_t * stem,
                  ulong               tsorig,
                  ulong               tspub ) {
   ulong * seqp = &stem->seqs[ out_idx ];
-  ulong   seq  = *seqp;
+  ulong   seq  = fd_stem_out_seq( stem, out_idx );
   fd_mcache_publish( stem->mcaches[ out_idx ], stem->depths[ out_idx ], seq, sig, chunk, sz, ctl, tsorig, tspub );
   stem->cr_avail[ out_idx ] -= stem->cr_decrement_amount;
   *stem->min_cr_avail        = fd_ulong_min( stem->cr_avail[ out_idx ], *stem->min_cr_avail );
@@ -52,7 +71,7 @@ static inline ulong
 fd_stem_advance( fd_stem_context_t * stem,
                  ulong               out_idx ) {
   ulong * seqp = &stem->seqs[ out_idx ];
-  ulong   seq  = *seqp;
+  ulong   seq  = fd_stem_out_seq( stem, out_idx );
   stem->cr_avail[ out_idx ] -= stem->cr_decrement_amount;
   *stem->min_cr_avail        = fd_ulong_min( stem->cr_avail[ out_idx ], *stem->min_cr_avail );
   *seqp = fd_seq_inc( seq, 1UL );
@@ -0,0 +1,177 @@
+#include "fd_stem.h"
+
+#if FD_HAS_HOSTED && FD_HAS_ATOMIC && FD_HAS_ALLOCA
+
+#include <pthread.h>
+
+/* test_stem_mp runs PROD_CNT stems that publish to one shared
+   multi-producer mcache, with a reliable consumer (this thread) that
+   is occasionally slow.  It checks that the consumer sees every frag
+   of every producer exactly once and in order, that the stems never
+   overrun it, and that the shared claim counter never runs more than a
+   depth ahead of the consumer's fseq. */
+
+#define PROD_CNT (3UL)
+#define DEPTH    (64UL)
+#define BURST    (4UL)
+#define FRAG_CNT (10000UL)
+
+#define SCRATCH_SZ (4096UL)
+
+struct test_ctx {
+  ulong      prod_idx;
+  ulong      frag_cnt; /* number of frags published so far */
+  fd_rng_t * rng;
+};
+
+typedef struct test_ctx test_ctx_t;
+
+static inline int
+should_shutdown( test_ctx_t * ctx ) {
+  return ctx->frag_cnt>=FRAG_CNT;
+}
+
+/* after_credit publishes a random number of frags in [1,BURST] per run
+   loop iteration, so the stems use their full burst. */
+
+static inline void
+after_credit( test_ctx_t *        ctx,
+              fd_stem_context_t * stem,
+              int *               opt_poll_in,
+              int *               charge_busy ) {
+  (void)opt_poll_in;
+
+  ulong cnt = fd_ulong_min( 1UL+(ulong)fd_rng_uint_roll( ctx->rng, (uint)BURST ), FRAG_CNT-ctx->frag_cnt );
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_stem_publish( stem, 0UL, (ctx->prod_idx<<32) | ctx->frag_cnt, 0UL, 0UL, 0UL, 0UL, 0UL );
+    ctx->frag_cnt++;
+  }
+  *charge_busy = 1;
+}
+
+#define STEM_BURST                    BURST
+#define STEM_CALLBACK_CONTEXT_TYPE    test_ctx_t
+#define STEM_CALLBACK_CONTEXT_ALIGN   alignof(test_ctx_t)
+#define STEM_CALLBACK_SHOULD_SHUTDOWN should_shutdown
+#define STEM_CALLBACK_AFTER_CREDIT    after_credit
+
+#include "fd_stem.c"
+
+static uchar metrics_scratch[ PROD_CNT ][ FD_METRICS_FOOTPRINT( 0, 1 ) ] __attribute__((aligned(FD_METRICS_ALIGN)));
+static uchar stem_scratch   [ PROD_CNT ][ SCRATCH_SZ                   ] __attribute__((aligned(FD_STEM_SCRATCH_ALIGN)));
+
+static fd_frag_meta_t * mcache;
+static ulong *          fseq;
+
+static void *
+prod_main( void * _prod_idx ) {
+  ulong prod_idx = (ulong)_prod_idx;
+
+  fd_metrics_register( fd_metrics_new( metrics_scratch[ prod_idx ], 0UL, 1UL ) );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, (uint)prod_idx, 0UL ) );
+
+  test_ctx_t ctx[1] = {{ .prod_idx = prod_idx, .frag_cnt = 0UL, .rng = rng }};
+
+  fd_frag_meta_t * out_mcache[1] = { mcache };
+  ulong            cons_out  [1] = { 0UL    };
+  ulong *          cons_fseq [1] = { fseq   };
+
+  stem_run1( 0UL, NULL, NULL, 1UL, out_mcache, 1UL, cons_out, cons_fseq, BURST, 0L, rng, stem_scratch[ prod_idx ], ctx );
+
+  FD_TEST( ctx->frag_cnt==FRAG_CNT );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  return NULL;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 1234U, 0UL ) );
+
+  FD_TEST( stem_scratch_footprint( 0UL, 1UL, 1UL )<=SCRATCH_SZ );
+
+  static uchar mcache_mem[ 65536 ] __attribute__((aligned(FD_MCACHE_ALIGN)));
+  static uchar fseq_mem  [ 128   ] __attribute__((aligned(FD_FSEQ_ALIGN)));
+  FD_TEST( fd_mcache_footprint( DEPTH, 0UL )<=sizeof(mcache_mem) );
+  FD_TEST( fd_fseq_footprint()<=sizeof(fseq_mem) );
+
+  mcache = fd_mcache_join( fd_mcache_new_mp( mcache_mem, DEPTH, 0UL, 0UL, PROD_CNT ) );
+  fseq   = fd_fseq_join  ( fd_fseq_new     ( fseq_mem,   0UL                       ) );
+  FD_TEST( mcache && fseq );
+  FD_TEST( fd_mcache_prod_cnt( mcache )==PROD_CNT );
+
+  ulong const * _next = fd_mcache_mp_next_laddr( mcache );
+
+  pthread_t thr[ PROD_CNT ];
+  for( ulong prod_idx=0UL; prod_idx<PROD_CNT; prod_idx++ )
+    FD_TEST( !pthread_create( &thr[ prod_idx ], NULL, prod_main, (void *)prod_idx ) );
+
+  ulong expect[ PROD_CNT ] = {0};
+  ulong seq                = 0UL;
+  ulong rem                = PROD_CNT*FRAG_CNT;
+  while( rem ) {
+    fd_frag_meta_t const * mline     = mcache + fd_mcache_line_idx( seq, DEPTH );
+    ulong                  seq_found = fd_frag_meta_seq_query( mline );
+    if( FD_UNLIKELY( !fd_seq_eq( seq_found, seq ) ) ) {
+      FD_TEST( fd_seq_lt( seq_found, seq ) ); /* not overrun */
+      FD_SPIN_PAUSE();
+      continue;
+    }
+
+    FD_COMPILER_MFENCE();
+    ulong sig = mline->sig;
+    FD_COMPILER_MFENCE();
+    FD_TEST( fd_seq_eq( fd_frag_meta_seq_query( mline ), seq_found ) );
+
+    ulong prod_idx = sig>>32;
+    FD_TEST( prod_idx<PROD_CNT );
+    FD_TEST( (sig & 0xFFFFFFFFUL)==expect[ prod_idx ] );
+    expect[ prod_idx ]++;
+
+    /* The consumer's fseq is at seq, so nothing should have been
+       claimed past seq+DEPTH */
+
+    FD_TEST( fd_seq_diff( fd_mcache_mp_query( _next ), seq )<=(long)DEPTH );
+
+    seq = fd_seq_inc( seq, 1UL );
+    fd_fseq_update( fseq, seq );
+    rem--;
+
+    /* Occasionally stall to backpressure the producers */
+
+    if( FD_UNLIKELY( !(fd_rng_uint( rng ) & 1023U) ) ) {
+      long deadline = fd_log_wallclock() + 20000L;
+      while( fd_log_wallclock()<deadline ) FD_SPIN_PAUSE();
+    }
+  }
+
+  for( ulong prod_idx=0UL; prod_idx<PROD_CNT; prod_idx++ ) {
+    FD_TEST( !pthread_join( thr[ prod_idx ], NULL ) );
+    FD_TEST( expect[ prod_idx ]==FRAG_CNT );
+  }
+  FD_TEST( fd_mcache_mp_query( _next )==PROD_CNT*FRAG_CNT );
+
+  fd_fseq_delete  ( fd_fseq_leave  ( fseq   ) );
+  fd_mcache_delete( fd_mcache_leave( mcache ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED, FD_HAS_ATOMIC and FD_HAS_ALLOCA capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
@@ -56,7 +56,8 @@ typedef struct {
    fragments referred to by the mcache entries.
 
    A link belongs to exactly one workspace.  A link has exactly one
-   producer, and 1 or more consumers.  Each consumer is either reliable
+   producer (or up to prod_cnt producers for a multi-producer link, see
+   fd_topob_link_mp), and 1 or more consumers.  Each consumer is either reliable
    or not reliable.  A link has a depth and a MTU, which correspond to
    the depth and MTU of the mcache and dcache respectively.  A MTU of
    zero means no dcache is needed, as there is no data. */
@@ -68,6 +69,7 @@ typedef struct {
   ulong depth;    /* The depth of the mcache representing the link. */
   ulong mtu;      /* The MTU of data fragments in the mcache.  A value of 0 means there is no dcache. */
   ulong burst;    /* The max amount of MTU sized data fragments that might be bursted to the dcache. */
+  ulong prod_cnt; /* The max number of producers of the link, 1 unless this is a multi-producer link. */
 
   ulong mcache_obj_id;
   ulong dcache_obj_id;
@@ -309,6 +311,7 @@ struct fd_topo_tile {
       fd_topo_ip_port_t adtl_dests_retransmit[ FD_TOPO_ADTL_DESTS_MAX ];
       ulong             adtl_dests_leader_cnt;
       fd_topo_ip_port_t adtl_dests_leader[ FD_TOPO_ADTL_DESTS_MAX ];
+      int               net_fanout; /* send shreds as net fan-out messages (XDP net tile only) */
     } shred;
 
     struct {
@@ -344,6 +347,7 @@ struct fd_topo_tile {
       ushort listen_port;
 
       ulong max_http_connections;
+      ulong max_websocket_connections;
       ulong send_buffer_size_mb;
       ulong max_http_request_length;
 
@@ -404,6 +408,7 @@ struct fd_topo_tile {
       ulong funk_obj_id;
       ulong txncache_obj_id;
       ulong progcache_obj_id;
+      ulong progcache_warm_obj_id; /* ULONG_MAX if disabled */
 
       ulong max_live_slots;
 
@@ -536,6 +541,7 @@ struct fd_topo_tile {
       uint max_full_snapshots_to_keep;
       uint max_incremental_snapshots_to_keep;
       uint full_effective_age_cancel_threshold;
+      uint download_peer_cnt;
     } snapct;
 
     struct {
@@ -574,10 +580,13 @@ struct fd_topo_tile {
       ulong txncache_obj_id;
       ulong funk_obj_id;
       ulong progcache_obj_id;
+      ulong progcache_warm_obj_id; /* ULONG_MAX if disabled */
     } bank;
 
     struct {
       ulong funk_obj_id;
+      ulong txncache_obj_id;
+      ulong max_live_slots;
     } resolv;
 
     struct {
@@ -673,6 +682,17 @@ struct fd_topo_obj_callbacks {
   ulong (* align     )( fd_topo_t const * topo, fd_topo_obj_t const * obj );
   ulong (* loose     )( fd_topo_t const * topo, fd_topo_obj_t const * obj );
   void  (* new       )( fd_topo_t const * topo, fd_topo_obj_t const * obj );
+
+  /* Optional.  Objects with a save callback are persisted when the
+     validator is stopped with SIGINT or SIGTERM.  save_fd is called by
+     the supervisor process on boot, before it enters the sandbox, and
+     returns a file descriptor to save the object to, or -1 if the
+     object should not be saved.  save is called by the supervisor
+     after all tiles have exited, with only the workspace of the object
+     joined, and may only write to, seek and truncate fd.  At most one
+     object of a topology can be saved. */
+  int   (* save_fd   )( fd_topo_t const * topo, fd_topo_obj_t const * obj );
+  void  (* save      )( fd_topo_t const * topo, fd_topo_obj_t const * obj, int fd );
 };
 
 typedef struct fd_topo_obj_callbacks fd_topo_obj_callbacks_t;
@@ -817,6 +837,30 @@ fd_topo_link_consumer_cnt( fd_topo_t const *      topo,
   return cnt;
 }
 
+/* Given a link and one of its producer tiles, return the index of the
+   tile among the producers of the link (ordered by tile id), in
+   [0,link->prod_cnt).  Producers of a multi-producer link use this to
+   select their part of the link's dcache (see
+   fd_dcache_compact_part_chunk0).  Returns ULONG_MAX if the tile does
+   not produce into the link. */
+FD_FN_PURE static inline ulong
+fd_topo_link_producer_idx( fd_topo_t const *      topo,
+                           fd_topo_link_t const * link,
+                           fd_topo_tile_t const * tile ) {
+  ulong idx = 0UL;
+  for( ulong i=0; i<topo->tile_cnt; i++ ) {
+    fd_topo_tile_t const * producer = &topo->tiles[ i ];
+    for( ulong j=0; j<producer->out_cnt; j++ ) {
+      if( FD_UNLIKELY( producer->out_link_id[ j ] == link->id ) ) {
+        if( producer==tile ) return idx;
+        idx++;
+      }
+    }
+  }
+
+  return ULONG_MAX;
+}
+
 /* Given a link, count the number of reliable consumers of that link
    among all the tiles in the topology. */
 FD_FN_PURE static inline ulong
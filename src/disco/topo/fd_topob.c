@@ -88,6 +88,7 @@ fd_topob_link( fd_topo_t *  topo,
   link->depth    = depth;
   link->mtu      = mtu;
   link->burst    = burst;
+  link->prod_cnt = 1UL;
 
   fd_topo_obj_t * obj = fd_topob_obj( topo, "mcache", wksp_name );
   link->mcache_obj_id = obj->id;
@@ -105,6 +106,29 @@ fd_topob_link( fd_topo_t *  topo,
   return link;
 }
 
+fd_topo_link_t *
+fd_topob_link_mp( fd_topo_t *  topo,
+                  char const * link_name,
+                  char const * wksp_name,
+                  ulong        depth,
+                  ulong        mtu,
+                  ulong        burst,
+                  ulong        prod_cnt ) {
+  if( FD_UNLIKELY( !prod_cnt ) ) FD_LOG_ERR(( "zero prod_cnt for link %s", link_name ));
+
+  fd_topo_link_t * link = fd_topob_link( topo, link_name, wksp_name, depth, mtu, burst );
+  link->prod_cnt = prod_cnt;
+  FD_TEST( fd_pod_insertf_ulong( topo->props, prod_cnt, "obj.%lu.prod_cnt", link->mcache_obj_id ) );
+
+  if( mtu ) {
+    ulong data_sz = fd_dcache_req_data_sz( mtu, depth, burst, 1 );
+    if( FD_UNLIKELY( !data_sz || data_sz>ULONG_MAX/prod_cnt ) ) FD_LOG_ERR(( "dcache of link %s too large", link_name ));
+    FD_TEST( fd_pod_insertf_ulong( topo->props, prod_cnt*data_sz, "obj.%lu.data_sz", link->dcache_obj_id ) );
+  }
+
+  return link;
+}
+
 void
 fd_topob_tile_uses( fd_topo_t *      topo,
                     fd_topo_tile_t * tile,
@@ -312,7 +336,8 @@ validate( fd_topo_t const * topo ) {
       FD_LOG_ERR(( "workspace %lu has id %lu", i, topo->workspaces[ i ].id ));
   }
 
-  /* Each link has exactly one producer */
+  /* Each link has exactly one producer (up to prod_cnt for
+     multi-producer links) */
   for( ulong i=0UL; i<topo->link_cnt; i++ ) {
     ulong producer_cnt = 0;
     for( ulong j=0UL; j<topo->tile_cnt; j++ ) {
@@ -320,7 +345,7 @@ validate( fd_topo_t const * topo ) {
         if( topo->tiles[ j ].out_link_id[ k ]==i ) producer_cnt++;
       }
     }
-    if( FD_UNLIKELY( producer_cnt>1UL || ( producer_cnt==0UL && !topo->links[ i ].permit_no_producers ) ) )
+    if( FD_UNLIKELY( producer_cnt>fd_ulong_max( topo->links[ i ].prod_cnt, 1UL ) || ( producer_cnt==0UL && !topo->links[ i ].permit_no_producers ) ) )
       FD_LOG_ERR(( "link %lu (%s:%lu) has %lu producers", i, topo->links[ i ].name, topo->links[ i ].kind_id, producer_cnt ));
   }
 
@@ -385,6 +410,7 @@ fd_topob_auto_layout( fd_topo_t * topo,
     "snapld", /* FIREDANCER only */
     "snapdc", /* FIREDANCER only */
     "snapin", /* FIREDANCER only */
+    "snapla", /* FIREDANCER only */
     "arch_f", /* FIREDANCER only */
     "arch_w", /* FIREDANCER only */
     "vinyl",  /* FIREDANCER only */
@@ -80,6 +80,22 @@ fd_topob_link( fd_topo_t *  topo,
                ulong        mtu,
                ulong        burst );
 
+/* Same as fd_topob_link, but the link can have up to prod_cnt
+   producers, which publish into a shared multi-producer mcache (see
+   fd_mcache_new_mp).  Consumers see a single link.  If the link has a
+   dcache, it is sized such that each producer gets its own part for a
+   full depth of burst frags (see fd_dcache_compact_part_chunk0 and
+   fd_topo_link_producer_idx). */
+
+fd_topo_link_t *
+fd_topob_link_mp( fd_topo_t *  topo,
+                  char const * link_name,
+                  char const * wksp_name,
+                  ulong        depth,
+                  ulong        mtu,
+                  ulong        burst,
+                  ulong        prod_cnt );
+
 /* Add a tile to the topology.  This creates various objects needed for
    a standard tile, including tile scratch memory, metrics memory and so
    on.  These objects will be created and linked to the respective
@@ -14,6 +14,7 @@
 #include "../../flamenco/runtime/fd_runtime.h"
 #include "../../flamenco/runtime/fd_bank.h"
 #include "../../flamenco/runtime/fd_exec_stack.h"
+#include "../../flamenco/progcache/fd_progcache_warm.h"
 
 typedef struct {
   ulong kind_id;
@@ -194,6 +195,7 @@ handle_microblock( fd_bank_ctx_t *     ctx,
     txn->flags = (txn->flags & 0x00FFFFFFU) | ((uint)(-txn_ctx->exec_err)<<24);
 
     if( FD_UNLIKELY( !(txn_ctx->flags & FD_TXN_P_FLAGS_SANITIZE_SUCCESS ) ) ) {
+      fd_exec_txn_ctx_teardown( txn_ctx );
       fd_pack_rebate_sum_add_txn( ctx->rebater, txn, NULL, 1UL );
       ctx->metrics.txn_result[ fd_bank_err_from_runtime_err( txn_ctx->exec_err ) ]++;
       continue;
@@ -416,6 +418,7 @@ handle_bundle( fd_bank_ctx_t *     ctx,
     }
   } else {
     for( ulong i=0UL; i<txn_cnt; i++ ) {
+      fd_exec_txn_ctx_teardown( &ctx->txn_ctx[ i ] );
       uint requested_exec_plus_acct_data_cus = txns[ i ].pack_cu.requested_exec_plus_acct_data_cus;
       uint non_execution_cus                 = txns[ i ].pack_cu.non_execution_cus;
       txns[ i ].bank_cu.actual_consumed_cus  = 0U;
@@ -535,6 +538,11 @@ unprivileged_init( fd_topo_t *      topo,
   FD_TEST( shprogcache );
   fd_progcache_t * progcache = fd_progcache_join( ctx->progcache, shprogcache, pc_scratch, FD_PROGCACHE_SCRATCH_FOOTPRINT );
   FD_TEST( progcache );
+  if( tile->bank.progcache_warm_obj_id!=ULONG_MAX ) {
+    fd_progcache_warm_t * progcache_warm = fd_progcache_warm_join( fd_topo_obj_laddr( topo, tile->bank.progcache_warm_obj_id ) );
+    FD_TEST( progcache_warm );
+    fd_progcache_set_warm( progcache, progcache_warm );
+  }
 
   void * _txncache_shmem = fd_topo_obj_laddr( topo, tile->bank.txncache_obj_id );
   fd_txncache_shmem_t * txncache_shmem = fd_txncache_shmem_join( _txncache_shmem );
@@ -549,6 +557,7 @@ unprivileged_init( fd_topo_t *      topo,
       ctx->txn_ctx[ i ].bundle.prev_txn_ctxs[ j ] = &ctx->txn_ctx[ j ];
     }
 
+    ctx->txn_ctx[ i ].accounts_cnt     = 0UL;  /* nothing to tear down yet */
     ctx->txn_ctx[ i ].bank_hash_cmp    = NULL; /* TODO - do we need this? */
     ctx->txn_ctx[ i ].progcache        = ctx->txn_ctx[ i ]._progcache;
     ctx->txn_ctx[ i ].status_cache     = txncache;
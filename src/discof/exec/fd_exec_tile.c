@@ -7,7 +7,9 @@
 #include "../../flamenco/runtime/fd_bank.h"
 #include "../../flamenco/runtime/fd_exec_stack.h"
 #include "../../flamenco/runtime/fd_runtime.h"
+#include "../../flamenco/progcache/fd_progcache_warm.h"
 #include "../../disco/metrics/fd_metrics.h"
+#include "../../util/hist/fd_histf.h"
 
 #include "../../funk/fd_funk.h"
 
@@ -71,6 +73,13 @@ typedef struct fd_exec_tile_ctx {
   fd_exec_stack_t       exec_stack;
   fd_exec_accounts_t    exec_accounts;
 
+  struct {
+    ulong      accounts_clean_cnt;
+    ulong      account_stage_tot_sz;
+    ulong      account_commit_tot_sz;
+    fd_histf_t txn_account_copy_sz[1];
+  } metrics;
+
   /* tracing_mem is staging memory to dump instructions/transactions
      into protobuf files.  tracing_mem is staging memory to output vm
      execution traces.
@@ -104,6 +113,13 @@ metrics_write( fd_exec_tile_ctx_t * ctx ) {
   FD_MCNT_SET( EXEC, PROGCACHE_FILL_TOT_SZ,   progcache->metrics->fill_tot_sz    );
   FD_MCNT_SET( EXEC, PROGCACHE_INVALIDATIONS, progcache->metrics->invalidate_cnt );
   FD_MCNT_SET( EXEC, PROGCACHE_DUP_INSERTS,   progcache->metrics->dup_insert_cnt );
+  FD_MCNT_SET( EXEC, PROGCACHE_WARM_HITS,     progcache->metrics->warm_hit_cnt   );
+  FD_MCNT_SET( EXEC, PROGCACHE_WARM_MISSES,   progcache->metrics->warm_miss_cnt  );
+
+  FD_MCNT_SET( EXEC, ACCOUNTS_CLEAN,          ctx->metrics.accounts_clean_cnt    );
+  FD_MCNT_SET( EXEC, ACCOUNT_STAGE_TOT_SZ,    ctx->metrics.account_stage_tot_sz  );
+  FD_MCNT_SET( EXEC, ACCOUNT_COMMIT_TOT_SZ,   ctx->metrics.account_commit_tot_sz );
+  FD_MHIST_COPY( EXEC, TXN_ACCOUNT_COPY_SZ,   ctx->metrics.txn_account_copy_sz   );
 }
 
 static inline int
@@ -143,6 +159,13 @@ returnable_frag( fd_exec_tile_ctx_t * ctx,
         if( FD_LIKELY( ctx->txn_ctx->flags & FD_TXN_P_FLAGS_EXECUTE_SUCCESS ) ) {
           fd_funk_txn_xid_t xid = (fd_funk_txn_xid_t){ .ul = { fd_bank_slot_get( bank ), bank->idx } };
           fd_runtime_finalize_txn( ctx->funk, ctx->progcache, ctx->txncache, &xid, ctx->txn_ctx, bank, ctx->capture_ctx, NULL );
+
+          ctx->metrics.accounts_clean_cnt    += ctx->txn_ctx->accounts_clean_cnt;
+          ctx->metrics.account_stage_tot_sz  += ctx->txn_ctx->accounts_stage_sz;
+          ctx->metrics.account_commit_tot_sz += ctx->txn_ctx->accounts_commit_sz;
+          fd_histf_sample( ctx->metrics.txn_account_copy_sz, ctx->txn_ctx->accounts_stage_sz + ctx->txn_ctx->accounts_commit_sz );
+        } else {
+          fd_exec_txn_ctx_teardown( ctx->txn_ctx );
         }
 
         if( FD_LIKELY( ctx->exec_sig_out->idx!=ULONG_MAX ) ) {
@@ -172,6 +195,20 @@ returnable_frag( fd_exec_tile_ctx_t * ctx,
         ctx->exec_replay_out->chunk = fd_dcache_compact_next( ctx->exec_replay_out->chunk, sizeof(*out_msg), ctx->exec_replay_out->chunk0, ctx->exec_replay_out->wmark );
         break;
       }
+      case FD_EXEC_TT_POH_VERIFY: {
+        fd_exec_poh_verify_msg_t * msg = fd_chunk_to_laddr( ctx->replay_in->mem, chunk );
+        ulong bad_idx = fd_poh_verify_entries( msg->start, msg->entry, msg->entry_cnt );
+        if( FD_UNLIKELY( bad_idx!=ULONG_MAX ) ) {
+          FD_LOG_INFO(( "PoH verification failed for entry %s", FD_BASE58_ENC_32_ALLOCA( msg->entry[ bad_idx ].hash ) ));
+        }
+        fd_exec_task_done_msg_t * out_msg = fd_chunk_to_laddr( ctx->exec_replay_out->mem, ctx->exec_replay_out->chunk );
+        out_msg->bank_idx             = msg->bank_idx;
+        out_msg->poh_verify->poh_idx  = msg->poh_idx;
+        out_msg->poh_verify->err      = (bad_idx!=ULONG_MAX);
+        fd_stem_publish( stem, ctx->exec_replay_out->idx, (FD_EXEC_TT_POH_VERIFY<<32)|ctx->tile_idx, ctx->exec_replay_out->chunk, sizeof(*out_msg), 0UL, 0UL, 0UL );
+        ctx->exec_replay_out->chunk = fd_dcache_compact_next( ctx->exec_replay_out->chunk, sizeof(*out_msg), ctx->exec_replay_out->chunk0, ctx->exec_replay_out->wmark );
+        break;
+      }
       default: FD_LOG_CRIT(( "unexpected signature %lu", sig ));
     }
   } else FD_LOG_CRIT(( "invalid in_idx %lu", in_idx ));
@@ -280,6 +317,13 @@ unprivileged_init( fd_topo_t *      topo,
     FD_LOG_CRIT(( "fd_progcache_join() failed" ));
   }
 
+  fd_progcache_warm_t const * progcache_warm = NULL;
+  if( tile->exec.progcache_warm_obj_id!=ULONG_MAX ) {
+    progcache_warm = fd_progcache_warm_join( fd_topo_obj_laddr( topo, tile->exec.progcache_warm_obj_id ) );
+    if( FD_UNLIKELY( !progcache_warm ) ) FD_LOG_CRIT(( "fd_progcache_warm_join() failed" ));
+  }
+  fd_progcache_set_warm( ctx->progcache, progcache_warm );
+
   void * _txncache_shmem = fd_topo_obj_laddr( topo, tile->exec.txncache_obj_id );
   fd_txncache_shmem_t * txncache_shmem = fd_txncache_shmem_join( _txncache_shmem );
   FD_TEST( txncache_shmem );
@@ -299,10 +343,16 @@ unprivileged_init( fd_topo_t *      topo,
   if( FD_UNLIKELY( !ctx->txn_ctx->progcache ) ) {
     FD_LOG_CRIT(( "fd_progcache_join() failed" ));
   }
+  fd_progcache_set_warm( ctx->txn_ctx->progcache, progcache_warm );
   ctx->txn_ctx->status_cache     = ctx->txncache;
   ctx->txn_ctx->bank_hash_cmp    = ctx->bank_hash_cmp;
   ctx->txn_ctx->bundle.is_bundle = 0;
 
+  memset( &ctx->metrics, 0, sizeof(ctx->metrics) );
+  fd_histf_join( fd_histf_new( ctx->metrics.txn_account_copy_sz,
+                               FD_MHIST_MIN( EXEC, TXN_ACCOUNT_COPY_SZ ),
+                               FD_MHIST_MAX( EXEC, TXN_ACCOUNT_COPY_SZ ) ) );
+
   /********************************************************************/
   /* Capture context                                                 */
   /********************************************************************/
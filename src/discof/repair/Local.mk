@@ -4,6 +4,8 @@ $(call add-objs,fd_policy,fd_discof)
 $(call add-hdrs,fd_policy.h)
 $(call add-objs,fd_inflight,fd_discof)
 $(call add-hdrs,fd_inflight.h)
+$(call make-unit-test,test_policy,test_policy,fd_discof fd_disco fd_flamenco fd_tango fd_ballet fd_util)
+$(call run-unit-test,test_policy)
 $(call add-objs,fd_repair,fd_discof)
 $(call add-hdrs,fd_repair.h)
 $(call add-objs,fd_repair_metrics,fd_discof)
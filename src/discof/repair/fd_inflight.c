@@ -13,16 +13,18 @@ fd_inflights_new( void * shmem ) {
   fd_inflights_t * table = FD_SCRATCH_ALLOC_APPEND( l, fd_inflights_align(),      sizeof(fd_inflights_t) );
   void *           pool  = FD_SCRATCH_ALLOC_APPEND( l, fd_inflight_pool_align(),  fd_inflight_pool_footprint(FD_INFLIGHT_REQ_MAX) );
   void *           map   = FD_SCRATCH_ALLOC_APPEND( l, fd_inflight_map_align(),   fd_inflight_map_footprint(FD_INFLIGHT_REQ_MAX) );
-  void *           dlist = FD_SCRATCH_ALLOC_APPEND( l, fd_inflight_dlist_align(), fd_inflight_dlist_footprint() );
+  void *           treap = FD_SCRATCH_ALLOC_APPEND( l, fd_inflight_treap_align(), fd_inflight_treap_footprint(FD_INFLIGHT_REQ_MAX) );
   FD_TEST( FD_SCRATCH_ALLOC_FINI( l, fd_inflights_align() ) == (ulong)shmem + footprint );
 
   table->pool  = fd_inflight_pool_join ( fd_inflight_pool_new ( pool, FD_INFLIGHT_REQ_MAX    ) );
   table->map   = fd_inflight_map_join  ( fd_inflight_map_new  ( map,  FD_INFLIGHT_REQ_MAX, 0 ) );
-  table->dlist = fd_inflight_dlist_join( fd_inflight_dlist_new( dlist ) );
+  table->treap = fd_inflight_treap_join( fd_inflight_treap_new( treap, FD_INFLIGHT_REQ_MAX    ) );
 
   FD_TEST( table->pool );
   FD_TEST( table->map );
-  FD_TEST( table->dlist );
+  FD_TEST( table->treap );
+
+  fd_inflight_treap_seed( table->pool, FD_INFLIGHT_REQ_MAX, 0UL );
 
   return shmem;
 }
@@ -51,22 +53,19 @@ fd_inflights_join( void * shmem ) {
 }
 
 void
-fd_inflights_request_insert( fd_inflights_t * table, ulong nonce, fd_pubkey_t const * pubkey, ulong slot, ulong shred_idx ) {
-  if( FD_UNLIKELY( !fd_inflight_pool_free( table->pool ) ) ) {
-    fd_inflight_t * evict = fd_inflight_dlist_ele_pop_head( table->dlist, table->pool );
-    fd_inflight_map_ele_remove( table->map, &evict->nonce, NULL, table->pool );
-    fd_inflight_pool_ele_release( table->pool, evict );
-  }
+fd_inflights_request_insert( fd_inflights_t * table, ulong nonce, fd_pubkey_t const * pubkey, ulong slot, ulong shred_idx, long now, long rto ) {
+  if( FD_UNLIKELY( fd_inflights_full( table ) ) ) FD_LOG_CRIT(( "inflight table full" ));
 
   fd_inflight_t * inflight_req = fd_inflight_pool_ele_acquire( table->pool );
   inflight_req->nonce        = nonce;
-  inflight_req->timestamp_ns = fd_log_wallclock();
+  inflight_req->timestamp_ns = now;
+  inflight_req->deadline_ns  = now + rto;
   inflight_req->pubkey       = *pubkey;
   inflight_req->slot         = slot;
   inflight_req->shred_idx    = shred_idx;
 
-  fd_inflight_map_ele_insert     ( table->map,   inflight_req, table->pool );
-  fd_inflight_dlist_ele_push_tail( table->dlist, inflight_req, table->pool );
+  fd_inflight_map_ele_insert  ( table->map,   inflight_req, table->pool );
+  fd_inflight_treap_ele_insert( table->treap, inflight_req, table->pool );
 }
 
 long
@@ -78,8 +77,7 @@ fd_inflights_request_remove( fd_inflights_t * table, ulong nonce, fd_pubkey_t *
 
     *peer_out = inflight_req->pubkey;
     /* Remove the element from the inflight table */
-    fd_inflight_map_ele_remove  ( table->map, &nonce, NULL, table->pool );
-    fd_inflight_dlist_ele_remove( table->dlist, inflight_req, table->pool );
+    fd_inflight_treap_ele_remove( table->treap, inflight_req, table->pool );
     fd_inflight_pool_ele_release( table->pool, inflight_req );
     return rtt;
   }
@@ -87,12 +85,14 @@ fd_inflights_request_remove( fd_inflights_t * table, ulong nonce, fd_pubkey_t *
 }
 
 void
-fd_inflights_request_pop( fd_inflights_t * table, ulong * nonce_out, ulong * slot_out, ulong * shred_idx_out ) {
-  fd_inflight_t * inflight_req = fd_inflight_dlist_ele_pop_head( table->dlist, table->pool );
+fd_inflights_request_pop( fd_inflights_t * table, ulong * nonce_out, ulong * slot_out, ulong * shred_idx_out, fd_pubkey_t * peer_out ) {
+  fd_inflight_t * inflight_req = fd_inflight_treap_fwd_iter_ele( fd_inflight_treap_fwd_iter_init( table->treap, table->pool ), table->pool );
+  fd_inflight_treap_ele_remove( table->treap, inflight_req, table->pool );
   fd_inflight_map_ele_remove( table->map, &inflight_req->nonce, NULL, table->pool );
   *nonce_out     = inflight_req->nonce;
   *slot_out      = inflight_req->slot;
   *shred_idx_out = inflight_req->shred_idx;
+  *peer_out      = inflight_req->pubkey;
   fd_inflight_pool_ele_release( table->pool, inflight_req );
 }
 
@@ -16,7 +16,13 @@
    Requests are key-ed by nonce as in the current strategy (see
    fd_policy.h), all requests have a unique nonce.  The chances that an
    inflight request does not get a response are non-negligible due to
-   shred tile upstream deduping duplicates. */
+   shred tile upstream deduping duplicates.
+
+   Each request times out after its own deadline (typically the RTO of
+   the peer it was sent to, see fd_policy_peer_rto), so requests are
+   also kept in a treap ordered by deadline.  Requests to fast peers
+   can then be re-requested without waiting behind requests to slow
+   ones. */
 
 /* Max number of pending requests */
 #define FD_INFLIGHT_REQ_MAX (1<<20)
@@ -25,14 +31,20 @@ struct __attribute__((aligned(128UL))) fd_inflight {
   ulong         nonce;         /* unique identifier for the request */
   ulong         next;          /* reserved for internal use by fd_pool and fd_map_chain */
   long          timestamp_ns;  /* timestamp when request was created (nanoseconds) */
+  long          deadline_ns;   /* timestamp after which the request has timed out (nanoseconds) */
   fd_pubkey_t   pubkey;        /* public key of the peer */
 
   ulong         slot;          /* slot of the request */
   ulong         shred_idx;     /* shred index of the request */
 
-  /* Reserved for DLL eviction */
-  ulong          prevll;      /* pool index of previous element in DLL */
-  ulong          nextll;      /* pool index of next element in DLL */
+  /* Reserved for the deadline treap (with O(1) earliest deadline
+     lookup) */
+  ulong         parent;
+  ulong         left;
+  ulong         right;
+  ulong         prio;
+  ulong         prevll;
+  ulong         nextll;
 };
 typedef struct fd_inflight fd_inflight_t;
 
@@ -45,16 +57,21 @@ typedef struct fd_inflight fd_inflight_t;
 #define MAP_ELE_T    fd_inflight_t
 #include "../../util/tmpl/fd_map_chain.c"
 
-#define DLIST_NAME      fd_inflight_dlist
-#define DLIST_ELE_T     fd_inflight_t
-#define DLIST_PREV      prevll
-#define DLIST_NEXT      nextll
-#include "../../util/tmpl/fd_dlist.c"
+#define TREAP_NAME      fd_inflight_treap
+#define TREAP_T         fd_inflight_t
+#define TREAP_QUERY_T   void *                                         /* We don't use query ... */
+#define TREAP_CMP(a,b)  (__extension__({ (void)(a); (void)(b); -1; })) /* which means we don't need to give a real
+                                                                          implementation to cmp either */
+#define TREAP_LT(e0,e1) ((e0)->deadline_ns<(e1)->deadline_ns)
+#define TREAP_OPTIMIZE_ITERATION 1
+#define TREAP_PREV      prevll
+#define TREAP_NEXT      nextll
+#include "../../util/tmpl/fd_treap.c"
 
 struct fd_inflights {
   fd_inflight_t       * pool;
   fd_inflight_map_t   * map;
-  fd_inflight_dlist_t * dlist;
+  fd_inflight_treap_t * treap;
 };
 typedef struct fd_inflights fd_inflights_t;
 
@@ -72,7 +89,7 @@ fd_inflights_footprint( void ) {
       alignof(fd_inflights_t),   sizeof(fd_inflights_t)                             ),
       fd_inflight_pool_align(),  fd_inflight_pool_footprint ( FD_INFLIGHT_REQ_MAX ) ),
       fd_inflight_map_align(),   fd_inflight_map_footprint  ( FD_INFLIGHT_REQ_MAX ) ),
-      fd_inflight_dlist_align(), fd_inflight_dlist_footprint()                      ),
+      fd_inflight_treap_align(), fd_inflight_treap_footprint( FD_INFLIGHT_REQ_MAX ) ),
     fd_inflights_align() );
 }
 
@@ -82,8 +99,23 @@ fd_inflights_new( void * shmem );
 fd_inflights_t *
 fd_inflights_join( void * shmem );
 
+/* fd_inflights_full returns 1 if no more requests can be inserted, 0
+   otherwise. */
+
+static inline int
+fd_inflights_full( fd_inflights_t * table ) {
+  return !fd_inflight_pool_free( table->pool );
+}
+
+/* fd_inflights_request_insert records a request for shred_idx of slot
+   sent to pubkey with the given nonce at wallclock now.  The request
+   times out rto ns after now.  The table must not be full.  Callers make room by popping
+   the request closest to timing out (fd_inflights_request_pop) and
+   releasing it like a timed out one, so that the peer's inflight count
+   stays balanced. */
+
 void
-fd_inflights_request_insert( fd_inflights_t * table, ulong nonce, fd_pubkey_t const * pubkey, ulong slot, ulong shred_idx );
+fd_inflights_request_insert( fd_inflights_t * table, ulong nonce, fd_pubkey_t const * pubkey, ulong slot, ulong shred_idx, long now, long rto );
 
 long
 fd_inflights_request_remove( fd_inflights_t * table, ulong nonce, fd_pubkey_t * peer_out );
@@ -91,18 +123,19 @@ fd_inflights_request_remove( fd_inflights_t * table, ulong nonce, fd_pubkey_t *
 /* Important! Caller must guarantee that the request list is not empty.
    This function cannot fail and will always try to populate the output
    parameters. Typical use should only call this after
-   fd_inflights_should_drain returns true. */
+   fd_inflights_should_drain returns true.  Pops the request with the
+   earliest deadline. */
 
 void
-fd_inflights_request_pop( fd_inflights_t * table, ulong * nonce_out, ulong * slot_out, ulong * shred_idx_out );
+fd_inflights_request_pop( fd_inflights_t * table, ulong * nonce_out, ulong * slot_out, ulong * shred_idx_out, fd_pubkey_t * peer_out );
 
 static inline int
 fd_inflights_should_drain( fd_inflights_t * table, long now ) {
-  /* peek at head */
-  if( FD_UNLIKELY( fd_inflight_dlist_is_empty( table->dlist, table->pool ) ) ) return 0;
+  /* peek at earliest deadline */
+  if( FD_UNLIKELY( !fd_inflight_treap_ele_cnt( table->treap ) ) ) return 0;
 
-  fd_inflight_t * inflight_req = fd_inflight_dlist_ele_peek_head( table->dlist, table->pool );
-  if( FD_UNLIKELY( inflight_req->timestamp_ns + FD_POLICY_DEDUP_TIMEOUT < now ) ) return 1;
+  fd_inflight_t const * inflight_req = fd_inflight_treap_fwd_iter_ele_const( fd_inflight_treap_fwd_iter_init( table->treap, table->pool ), table->pool );
+  if( FD_UNLIKELY( inflight_req->deadline_ns < now ) ) return 1;
   return 0;
 }
 
@@ -157,24 +157,55 @@ passes_throttle_threshold( fd_policy_t * policy, fd_forest_blk_t * ele ) {
   return 0;
 }
 
+static inline fd_peer_dlist_t *
+select_dlist( fd_policy_t * policy ) {
+  return bucket_stages[policy->peers.select.stage] == FD_POLICY_LATENCY_FAST ? policy->peers.fast : policy->peers.slow;
+}
+
+/* select_better returns 1 if peer a (with window open a_open) should be
+   preferred over peer b. */
+
+static inline int
+select_better( fd_policy_peer_t const * a, int a_open, fd_policy_peer_t const * b, int b_open ) {
+  if( a_open != b_open ) return a_open;
+  long a_score = fd_policy_peer_score( a );
+  long b_score = fd_policy_peer_score( b );
+  if( a_score != b_score ) return a_score < b_score;
+  return a->stake > b->stake;
+}
+
 fd_pubkey_t const *
 fd_policy_peer_select( fd_policy_t * policy ) {
-  fd_peer_dlist_t * best_dlist  = policy->peers.fast;
-  fd_peer_dlist_t * worst_dlist = policy->peers.slow;
-  fd_peer_t       * pool        = policy->peers.pool;
+  fd_peer_t * pool = policy->peers.pool;
 
   if( FD_UNLIKELY( fd_peer_pool_used( policy->peers.pool ) == 0 ) ) return NULL;
 
-  fd_peer_dlist_t * dlist = bucket_stages[policy->peers.select.stage] == FD_POLICY_LATENCY_FAST ? best_dlist : worst_dlist;
-
-  while( FD_UNLIKELY( fd_peer_dlist_iter_done( policy->peers.select.iter, dlist, pool ) ) ) {
-    policy->peers.select.stage = (policy->peers.select.stage + 1) % (sizeof(bucket_stages) / sizeof(uint));
-    dlist = bucket_stages[policy->peers.select.stage] == FD_POLICY_LATENCY_FAST ? best_dlist : worst_dlist;
-    policy->peers.select.iter = fd_peer_dlist_iter_fwd_init( dlist, pool );
+  fd_peer_t *              best      = NULL;
+  fd_policy_peer_t const * best_peer = NULL;
+  int                      best_open = 0;
+  for( ulong i = 0; i < FD_POLICY_SELECT_CNT; i++ ) {
+    fd_peer_dlist_t * dlist = select_dlist( policy );
+    if( FD_UNLIKELY( fd_peer_dlist_iter_done( policy->peers.select.iter, dlist, pool ) ) ) {
+      if( best ) break; /* don't let a selection span stages */
+      while( fd_peer_dlist_iter_done( policy->peers.select.iter, dlist, pool ) ) {
+        policy->peers.select.stage = (policy->peers.select.stage + 1) % (sizeof(bucket_stages) / sizeof(uint));
+        dlist = select_dlist( policy );
+        policy->peers.select.iter = fd_peer_dlist_iter_fwd_init( dlist, pool );
+      }
+    }
+    fd_peer_t * ele = fd_peer_dlist_iter_ele( policy->peers.select.iter, dlist, pool );
+    policy->peers.select.iter = fd_peer_dlist_iter_fwd_next( policy->peers.select.iter, dlist, pool );
+
+    fd_policy_peer_t const * peer = fd_policy_peer_map_query( policy->peers.map, ele->identity, NULL );
+    if( FD_UNLIKELY( !peer ) ) { if( !best ) best = ele; continue; }
+    int open = fd_policy_peer_window_open( peer );
+    if( !best_peer || select_better( peer, open, best_peer, best_open ) ) {
+      best      = ele;
+      best_peer = peer;
+      best_open = open;
+    }
   }
-  fd_peer_t * select = fd_peer_dlist_iter_ele( policy->peers.select.iter, dlist, pool );
-  policy->peers.select.iter = fd_peer_dlist_iter_fwd_next( policy->peers.select.iter, dlist, pool );
-  return &select->identity;
+  return &best->identity;
 }
 
 fd_repair_msg_t const *
@@ -280,6 +311,13 @@ fd_policy_peer_insert( fd_policy_t * policy, fd_pubkey_t const * key, fd_ip4_por
     peer->last_resp_ts  = 0;
     peer->total_lat     = 0;
     peer->stake         = 0;
+    peer->srtt          = 0;
+    peer->rttvar        = 0;
+    peer->yield         = 1.0;
+    peer->cwnd          = FD_POLICY_CWND_INIT;
+    peer->inflight      = 0;
+    peer->tmo_cnt       = 0;
+    peer->cut_ts        = 0;
 
     fd_peer_t * peer_ele = fd_peer_pool_ele_acquire( policy->peers.pool );
     peer->pool_idx = fd_peer_pool_idx( policy->peers.pool, peer_ele );
@@ -299,26 +337,43 @@ int
 fd_policy_peer_remove( fd_policy_t * policy, fd_pubkey_t const * key ) {
   fd_policy_peer_t * peer = fd_policy_peer_map_query( policy->peers.map, *key, NULL );
   if( FD_UNLIKELY( !peer ) ) return 0;
-  fd_peer_t * peer_ele = fd_peer_pool_ele( policy->peers.pool, peer->pool_idx );
+  fd_peer_t *       peer_ele = fd_peer_pool_ele( policy->peers.pool, peer->pool_idx );
+  fd_peer_dlist_t * bucket   = fd_policy_peer_latency_bucket( policy, peer );
   fd_policy_peer_map_remove( policy->peers.map, peer );
 
   if( FD_UNLIKELY( policy->peers.select.iter == fd_peer_pool_idx( policy->peers.pool, peer_ele ) ) ) {
     /* In general removal during iteration is safe, except when the iterator is on the peer to be removed. */
-    fd_peer_dlist_t * dlist = bucket_stages[policy->peers.select.stage] == FD_POLICY_LATENCY_FAST ? policy->peers.fast : policy->peers.slow;
-    policy->peers.select.iter = fd_peer_dlist_iter_fwd_next( policy->peers.select.iter, dlist, policy->peers.pool );
+    policy->peers.select.iter = fd_peer_dlist_iter_fwd_next( policy->peers.select.iter, select_dlist( policy ), policy->peers.pool );
   }
 
-  fd_peer_dlist_t * bucket = fd_policy_peer_latency_bucket( policy, peer->total_lat, peer->res_cnt );
   fd_peer_dlist_ele_remove( bucket, peer_ele, policy->peers.pool );
   fd_peer_pool_ele_release( policy->peers.pool, peer_ele );
   return 1;
 }
 
+/* peer_rebucket moves peer to the latency bucket matching its current
+   score if it is no longer in prev_bucket. */
+
+static void
+peer_rebucket( fd_policy_t * policy, fd_policy_peer_t const * peer, fd_peer_dlist_t * prev_bucket ) {
+  fd_peer_dlist_t * new_bucket = fd_policy_peer_latency_bucket( policy, peer );
+  if( FD_LIKELY( prev_bucket == new_bucket ) ) return;
+
+  fd_peer_t * peer_ele = fd_peer_pool_ele( policy->peers.pool, peer->pool_idx );
+  if( FD_UNLIKELY( policy->peers.select.iter == peer->pool_idx ) ) {
+    /* Don't let the iterator follow the peer into the other bucket. */
+    policy->peers.select.iter = fd_peer_dlist_iter_fwd_next( policy->peers.select.iter, prev_bucket, policy->peers.pool );
+  }
+  fd_peer_dlist_ele_remove   ( prev_bucket, peer_ele, policy->peers.pool );
+  fd_peer_dlist_ele_push_tail( new_bucket,  peer_ele, policy->peers.pool );
+}
+
 void
 fd_policy_peer_request_update( fd_policy_t * policy, fd_pubkey_t const * to ) {
   fd_policy_peer_t * active = fd_policy_peer_query( policy, to );
   if( FD_LIKELY( active ) ) {
     active->req_cnt++;
+    active->inflight++;
     active->last_req_ts = fd_tickcount();
     if( FD_UNLIKELY( active->first_req_ts == 0 ) ) active->first_req_ts = active->last_req_ts;
   }
@@ -329,18 +384,47 @@ fd_policy_peer_response_update( fd_policy_t * policy, fd_pubkey_t const * to, lo
   fd_policy_peer_t * peer = fd_policy_peer_query( policy, to );
   if( FD_LIKELY( peer ) ) {
     long now = fd_tickcount();
-    fd_peer_dlist_t * prev_bucket = fd_policy_peer_latency_bucket( policy, peer->total_lat, peer->res_cnt );
+    fd_peer_dlist_t * prev_bucket = fd_policy_peer_latency_bucket( policy, peer );
+    if( FD_UNLIKELY( !peer->res_cnt ) ) {
+      peer->srtt   = rtt;
+      peer->rttvar = rtt / 2;
+    } else {
+      peer->rttvar = (3L*peer->rttvar + (long)fd_long_abs( peer->srtt - rtt )) / 4L;
+      peer->srtt   = (7L*peer->srtt   + rtt                            ) / 8L;
+    }
     peer->res_cnt++;
     if( FD_UNLIKELY( peer->first_resp_ts == 0 ) ) peer->first_resp_ts = now;
     peer->last_resp_ts = now;
     peer->total_lat   += rtt;
-    fd_peer_dlist_t * new_bucket = fd_policy_peer_latency_bucket( policy, peer->total_lat, peer->res_cnt  );
+    peer->inflight     = fd_ulong_sat_sub( peer->inflight, 1UL );
+    peer->yield       += (1.0 - peer->yield) * FD_POLICY_YIELD_ALPHA;
+    peer->cwnd        += 1.0 / peer->cwnd; /* additive increase, ~1 per window */
+    if( FD_UNLIKELY( peer->cwnd > FD_POLICY_CWND_MAX ) ) peer->cwnd = FD_POLICY_CWND_MAX;
+    peer_rebucket( policy, peer, prev_bucket );
+  }
+}
+
+void
+fd_policy_peer_timeout_update( fd_policy_t * policy, fd_pubkey_t const * to, long now, int lost ) {
+  fd_policy_peer_t * peer = fd_policy_peer_query( policy, to );
+  if( FD_LIKELY( peer ) ) {
+    peer->inflight = fd_ulong_sat_sub( peer->inflight, 1UL );
+    if( FD_UNLIKELY( !lost ) ) return;
+
+    fd_peer_dlist_t * prev_bucket = fd_policy_peer_latency_bucket( policy, peer );
+    peer->tmo_cnt++;
+    peer->yield   -= peer->yield * FD_POLICY_YIELD_ALPHA;
+    if( FD_UNLIKELY( peer->yield < FD_POLICY_YIELD_MIN ) ) peer->yield = FD_POLICY_YIELD_MIN;
+
+    /* Multiplicative decrease, at most once per RTO so that a burst of
+       timeouts from one lost window only halves it once. */
 
-    if( prev_bucket != new_bucket ) {
-      fd_peer_t * peer_ele = fd_peer_pool_ele( policy->peers.pool, peer->pool_idx );
-      fd_peer_dlist_ele_remove   ( prev_bucket, peer_ele, policy->peers.pool );
-      fd_peer_dlist_ele_push_tail( new_bucket,  peer_ele, policy->peers.pool );
+    if( FD_LIKELY( now - peer->cut_ts >= fd_policy_peer_rto( peer ) ) ) {
+      peer->cwnd  *= 0.5;
+      if( FD_UNLIKELY( peer->cwnd < FD_POLICY_CWND_MIN ) ) peer->cwnd = FD_POLICY_CWND_MIN;
+      peer->cut_ts = now;
     }
+    peer_rebucket( policy, peer, prev_bucket );
   }
 }
 
@@ -6,14 +6,16 @@
    needs to request via repair.  It also determines which peer(s) the
    validator should request the shred from.
 
-   The default policy implementation is round-robin DFS with time-based
-   dedup: round-robin through all the repair peers we know about, and
-   depth-first search down the repair forest (see fd_forest.h).  This
-   policy also dedups identical repair requests that occur within a
-   specified amount of time window of each other (configurable on init
-   as a hyperparameter).  With the DFS strategy, the smaller the tree,
-   the sooner an element will be iterated again (when the DFS restarts
-   from the root of the tree). */
+   The default policy implementation is scored round-robin DFS with
+   time-based dedup: cycle through the repair peers we know about,
+   picking the best scoring of the next few, preferring peers with room
+   in their in-flight window (see fd_policy_peer_select), and depth-first
+   search down the repair forest (see fd_forest.h).  This policy also
+   dedups identical repair requests that occur within a specified
+   amount of time window of each other (configurable on init as a
+   hyperparameter).  With the DFS strategy, the smaller the tree, the
+   sooner an element will be iterated again (when the DFS restarts from
+   the root of the tree). */
 
 #include "../../flamenco/types/fd_types_custom.h"
 #include "../forest/fd_forest.h"
@@ -104,6 +106,21 @@ struct fd_policy_peer {
   long  total_lat; /* total RTT over all responses in ns */
   ulong stake;
 
+  /* below are for scoring and congestion control (see
+     fd_policy_peer_{score,rto,window}).  srtt and rttvar follow the
+     RFC 6298 estimator, yield is an EWMA of the fraction of requests
+     answered before timing out and cwnd is an AIMD window of requests
+     inflight to this peer.  The window only steers peer selection, it
+     is not a hard limit (see fd_policy_peer_select). */
+
+  long   srtt;     /* smoothed RTT in ns, 0 if no responses yet */
+  long   rttvar;   /* smoothed RTT mean deviation in ns */
+  double yield;    /* in [FD_POLICY_YIELD_MIN,1], EWMA of responses per request */
+  double cwnd;     /* in [FD_POLICY_CWND_MIN,FD_POLICY_CWND_MAX] */
+  ulong  inflight; /* requests sent to this peer that have not been answered or timed out */
+  ulong  tmo_cnt;  /* count of requests to this peer that timed out */
+  long   cut_ts;   /* wallclock of the last multiplicative window decrease */
+
   ulong pool_idx;
 };
 typedef struct fd_policy_peer fd_policy_peer_t;
@@ -137,7 +154,7 @@ typedef struct fd_peer fd_peer_t;
 #include "../../util/tmpl/fd_dlist.c"
 
 /* fd_policy_peers implements the data structures and bookkeeping for
-   selecting repair peers via round-robin. */
+   selecting repair peers via scored round-robin. */
 
 struct fd_policy_peers {
   fd_peer_t        * pool;  /* memory pool of repair peer pubkeys, contains entries of both dlist */
@@ -155,13 +172,25 @@ typedef struct fd_policy_peers fd_policy_peers_t;
 #define FD_POLICY_LATENCY_SLOW 3
 
 /* Policy parameters start */
-#define FD_POLICY_LATENCY_THRESH 80e6L /* less than this is a BEST peer, otherwise a WORST peer */
+#define FD_POLICY_LATENCY_THRESH 80e6L /* score less than this is a BEST peer, otherwise a WORST peer */
 #define FD_POLICY_DEDUP_TIMEOUT  100e6L /* how long wait to request the same shred */
 
+#define FD_POLICY_RTO_MIN        20e6L  /* bounds on the per-peer re-request timeout */
+#define FD_POLICY_RTO_MAX        400e6L
+#define FD_POLICY_YIELD_MIN      (1e-3) /* floor on yield so scores stay finite */
+#define FD_POLICY_YIELD_ALPHA    (1./16.)
+#define FD_POLICY_CWND_INIT      (8.)   /* AIMD window bounds, in requests */
+#define FD_POLICY_CWND_MIN       (1.)
+#define FD_POLICY_CWND_MAX       (512.)
+#define FD_POLICY_SELECT_CNT     (4UL)  /* peers considered per selection */
+
 /* Round robins through ALL the worst peers once, then round robins
    through ALL the best peers once, then round robins through ALL the
    best peers again, etc. All peers are initially added to the worst
-   bucket, and moved once round trip times have been recorded. */
+   bucket, and moved once round trip times have been recorded.  Each
+   selection consumes up to FD_POLICY_SELECT_CNT peers of the current
+   stage and returns the best of them, so peers are still visited every
+   cycle but better peers win more requests. */
 
 static const uint bucket_stages[7] = {
    FD_POLICY_LATENCY_SLOW, /* do a cycle through worst peers 1/7 times to see if any improvements are made */
@@ -193,7 +222,7 @@ typedef struct fd_policy fd_policy_t;
 
 FD_FN_CONST static inline ulong
 fd_policy_align( void ) {
-  return alignof(fd_policy_t);
+  return 128UL; /* at least the max of the member pools, maps and lists */
 }
 
 FD_FN_CONST static inline ulong
@@ -266,21 +295,72 @@ fd_policy_peer_query( fd_policy_t * policy, fd_pubkey_t const * key );
 int
 fd_policy_peer_remove( fd_policy_t * policy, fd_pubkey_t const * key );
 
+/* fd_policy_peer_score returns the expected time in ns spent per
+   useful response from peer, i.e. its smoothed RTT divided by its
+   yield.  Lower is better.  Peers without RTT samples are scored as if
+   their RTT was FD_POLICY_LATENCY_THRESH, so they rank ahead of known
+   slow peers (and get probed) but behind known fast ones. */
+
+FD_FN_PURE static inline long
+fd_policy_peer_score( fd_policy_peer_t const * peer ) {
+  long srtt = peer->res_cnt ? peer->srtt : (long)FD_POLICY_LATENCY_THRESH;
+  return (long)( (double)srtt / peer->yield );
+}
+
+/* fd_policy_peer_rto returns how long in ns to wait for a response
+   from peer before re-requesting, srtt + 4 rttvar clamped to
+   [FD_POLICY_RTO_MIN,FD_POLICY_RTO_MAX].  Peers without RTT samples
+   get FD_POLICY_DEDUP_TIMEOUT. */
+
+FD_FN_PURE static inline long
+fd_policy_peer_rto( fd_policy_peer_t const * peer ) {
+  if( FD_UNLIKELY( !peer->res_cnt ) ) return (long)FD_POLICY_DEDUP_TIMEOUT;
+  return fd_long_min( fd_long_max( peer->srtt + 4L*peer->rttvar, (long)FD_POLICY_RTO_MIN ), (long)FD_POLICY_RTO_MAX );
+}
+
+/* fd_policy_peer_window_open returns 1 if peer has room in its AIMD
+   window for another request and 0 otherwise. */
+
+FD_FN_PURE static inline int
+fd_policy_peer_window_open( fd_policy_peer_t const * peer ) {
+  return (double)peer->inflight < peer->cwnd;
+}
+
+/* fd_policy_peer_select returns the peer the next request should be
+   sent to, or NULL if there are no peers.  It considers the next
+   FD_POLICY_SELECT_CNT peers of the current round-robin stage and picks
+   one with an open window over one without, then the lowest score,
+   then the highest stake.  If all of them have closed windows, the
+   best of them is still returned: requests are not held back, as the
+   forest iteration that produced them would otherwise stall. */
+
 fd_pubkey_t const *
 fd_policy_peer_select( fd_policy_t * policy );
 
+/* fd_policy_peer_{request,response,timeout}_update update the stats of
+   peer to on sending it a request, on receiving a response rtt ns after
+   the request and on the request timing out at wallclock now (i.e.
+   after fd_policy_peer_rto).  Every request_update should eventually
+   be matched by one response_update or timeout_update.  lost is 0 if
+   the timeout should not count against the peer (e.g. the shred was
+   received elsewhere, so the response may have been deduped), in which
+   case only the peer's inflight count is released. */
+
 void
 fd_policy_peer_request_update( fd_policy_t * policy, fd_pubkey_t const * to );
 
 static inline fd_peer_dlist_t *
-fd_policy_peer_latency_bucket( fd_policy_t * policy, long total_rtt /* ns */, ulong res_cnt ) {
-   if( res_cnt == 0 || (long)(total_rtt / (long)res_cnt) > FD_POLICY_LATENCY_THRESH ) return policy->peers.slow;
+fd_policy_peer_latency_bucket( fd_policy_t * policy, fd_policy_peer_t const * peer ) {
+   if( peer->res_cnt == 0 || fd_policy_peer_score( peer ) > FD_POLICY_LATENCY_THRESH ) return policy->peers.slow;
    return policy->peers.fast;
 }
 
 void
 fd_policy_peer_response_update( fd_policy_t * policy, fd_pubkey_t const * to, long rtt );
 
+void
+fd_policy_peer_timeout_update( fd_policy_t * policy, fd_pubkey_t const * to, long now, int lost );
+
 int
 fd_policy_passes_throttle_threshold( fd_policy_t * policy, fd_forest_blk_t * ele );
 
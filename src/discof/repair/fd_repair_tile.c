@@ -463,6 +463,44 @@ fd_repair_send_sign_request( ctx_t                 * ctx,
   sign_out->credits--;
 }
 
+/* inflight_timeout releases a shred request that timed out at now from
+   the peer it was sent to.  Returns 1 if the shred is still missing, 0
+   otherwise. */
+
+static int
+inflight_timeout( ctx_t *             ctx,
+                  long                now,
+                  ulong               slot,
+                  ulong               shred_idx,
+                  fd_pubkey_t const * peer ) {
+  fd_forest_blk_t * blk     = fd_forest_query( ctx->forest, slot );
+  int               missing = blk && !fd_forest_blk_idxs_test( blk->idxs, shred_idx );
+  /* Only count it against the peer if we still don't have the shred,
+     otherwise the response may have been deduped by the shred tile. */
+  fd_policy_peer_timeout_update( ctx->policy, peer, now, missing );
+  return missing;
+}
+
+/* inflight_insert records a shred request in the inflights table.  If
+   the table is full, the request closest to timing out is evicted and
+   released from its peer like a timed out one. */
+
+static void
+inflight_insert( ctx_t *             ctx,
+                 ulong               nonce,
+                 fd_pubkey_t const * to,
+                 ulong               slot,
+                 ulong               shred_idx,
+                 long                rto ) {
+  long now = fd_log_wallclock();
+  if( FD_UNLIKELY( fd_inflights_full( ctx->inflight ) ) ) {
+    ulong evict_nonce; ulong evict_slot; ulong evict_shred_idx; fd_pubkey_t evict_peer;
+    fd_inflights_request_pop( ctx->inflight, &evict_nonce, &evict_slot, &evict_shred_idx, &evict_peer );
+    inflight_timeout( ctx, now, evict_slot, evict_shred_idx, &evict_peer );
+  }
+  fd_inflights_request_insert( ctx->inflight, nonce, to, slot, shred_idx, now, rto );
+}
+
 static inline int
 before_frag( ctx_t * ctx,
              ulong   in_idx,
@@ -652,13 +690,13 @@ after_sign( ctx_t             * ctx,
          peers. The only thing we can do is to add this artificially to
          the inflights table, pretend we've sent it and let the inflight
          timeout request it down the line. */
-      fd_inflights_request_insert( ctx->inflight, pending->msg.shred.nonce, &pending->msg.shred.to, pending->msg.shred.slot, pending->msg.shred.shred_idx );
+      inflight_insert( ctx, pending->msg.shred.nonce, &pending->msg.shred.to, pending->msg.shred.slot, pending->msg.shred.shred_idx, (long)FD_POLICY_DEDUP_TIMEOUT );
     }
     return;
   }
   /* Happy path - all is well, our peer didn't drop out from beneath us. */
   if( FD_LIKELY( is_regular_req ) ) {
-    fd_inflights_request_insert( ctx->inflight, pending->msg.shred.nonce, &pending->msg.shred.to, pending->msg.shred.slot, pending->msg.shred.shred_idx );
+    inflight_insert( ctx, pending->msg.shred.nonce, &pending->msg.shred.to, pending->msg.shred.slot, pending->msg.shred.shred_idx, fd_policy_peer_rto( active ) );
     fd_policy_peer_request_update( ctx->policy, &pending->msg.shred.to );
   }
   send_packet( ctx, stem, 1, active->ip4, active->port, src_ip4, pending->buf, pending->buflen, fd_frag_meta_ts_comp( fd_tickcount() ) );
@@ -928,18 +966,17 @@ after_credit( ctx_t *             ctx,
   }
 
   if( FD_UNLIKELY( fd_inflights_should_drain( ctx->inflight, now ) ) ) {
-    ulong nonce; ulong slot; ulong shred_idx;
+    ulong nonce; ulong slot; ulong shred_idx; fd_pubkey_t timed_out;
     *charge_busy = 1;
-    fd_inflights_request_pop( ctx->inflight, &nonce, &slot, &shred_idx );
-    fd_forest_blk_t * blk = fd_forest_query( ctx->forest, slot );
-    if( FD_UNLIKELY( blk && !fd_forest_blk_idxs_test( blk->idxs, shred_idx ) ) ) {
+    fd_inflights_request_pop( ctx->inflight, &nonce, &slot, &shred_idx, &timed_out );
+    if( FD_UNLIKELY( inflight_timeout( ctx, now, slot, shred_idx, &timed_out ) ) ) {
       fd_pubkey_t const * peer = fd_policy_peer_select( ctx->policy );
       ctx->metrics->rerequest++;
       if( FD_UNLIKELY( !peer ) ) {
         /* No peers. But we CANNOT lose this request. */
         /* Add this request to the inflights table, pretend we've sent it and let the inflight timeout request it down the line. */
         fd_hash_t hash = { .ul[0] = 0 };
-        fd_inflights_request_insert( ctx->inflight, ctx->policy->nonce++, &hash, slot, shred_idx );
+        inflight_insert( ctx, ctx->policy->nonce++, &hash, slot, shred_idx, (long)FD_POLICY_DEDUP_TIMEOUT );
       } else {
         fd_repair_msg_t * msg = fd_repair_shred( ctx->protocol, peer, (ulong)((ulong)now / 1e6L), ctx->policy->nonce++, slot, shred_idx );
         fd_repair_send_sign_request( ctx, sign_out, msg, NULL );
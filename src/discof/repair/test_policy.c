@@ -1,8 +1,347 @@
 #include "fd_policy.h"
+#include "fd_inflight.h"
+
+#define PEER_MAX (64UL)
+
+static fd_policy_t *
+policy_new( fd_wksp_t * wksp ) {
+  void * mem = fd_wksp_alloc_laddr( wksp, fd_policy_align(), fd_policy_footprint( 1024UL, PEER_MAX ), 1UL );
+  FD_TEST( mem );
+  fd_policy_t * policy = fd_policy_join( fd_policy_new( mem, 1024UL, PEER_MAX, 0UL ) );
+  FD_TEST( policy );
+  return policy;
+}
+
+static void
+policy_free( fd_policy_t * policy ) {
+  fd_wksp_free_laddr( fd_policy_delete( fd_policy_leave( policy ) ) );
+}
+
+static fd_pubkey_t
+peer_key( ulong i ) {
+  fd_pubkey_t key = {0};
+  key.ul[0] = i + 1UL;
+  key.ul[1] = fd_ulong_hash( i );
+  return key;
+}
+
+static ulong
+bucket_cnt( fd_policy_t * policy, fd_peer_dlist_t * dlist ) {
+  ulong cnt = 0UL;
+  for( fd_peer_dlist_iter_t iter = fd_peer_dlist_iter_fwd_init( dlist, policy->peers.pool );
+       !fd_peer_dlist_iter_done( iter, dlist, policy->peers.pool );
+       iter = fd_peer_dlist_iter_fwd_next( iter, dlist, policy->peers.pool ) ) cnt++;
+  return cnt;
+}
+
+static void
+test_peer_stats( fd_wksp_t * wksp ) {
+  fd_policy_t * policy = policy_new( wksp );
+  fd_ip4_port_t addr = { .addr = 1U, .port = 1 };
+
+  fd_pubkey_t key = peer_key( 0UL );
+  FD_TEST( fd_policy_peer_insert( policy, &key, &addr ) );
+  fd_policy_peer_t * peer = fd_policy_peer_query( policy, &key );
+  FD_TEST( peer );
+
+  /* New peers are unscored: default timeout, full yield, slow bucket */
+
+  FD_TEST( fd_policy_peer_rto( peer )   == (long)FD_POLICY_DEDUP_TIMEOUT  );
+  FD_TEST( fd_policy_peer_score( peer ) == (long)FD_POLICY_LATENCY_THRESH );
+  FD_TEST( fd_policy_peer_latency_bucket( policy, peer ) == policy->peers.slow );
+  FD_TEST( peer->cwnd == FD_POLICY_CWND_INIT );
+
+  /* RTT estimator converges on a constant RTT and the RTO hits its
+     floor once the variance dies out */
+
+  for( ulong i = 0; i < 64; i++ ) {
+    fd_policy_peer_request_update( policy, &key );
+    fd_policy_peer_response_update( policy, &key, 10000000L );
+  }
+  FD_TEST( peer->srtt == 10000000L );
+  FD_TEST( peer->rttvar < 100000L );
+  FD_TEST( fd_policy_peer_rto( peer ) == (long)FD_POLICY_RTO_MIN );
+  FD_TEST( peer->inflight == 0UL );
+  FD_TEST( fd_policy_peer_latency_bucket( policy, peer ) == policy->peers.fast );
+  FD_TEST( bucket_cnt( policy, policy->peers.fast ) == 1UL );
+
+  /* Jittery RTT widens the RTO, bounded above */
+
+  for( ulong i = 0; i < 64; i++ ) fd_policy_peer_response_update( policy, &key, (i & 1UL) ? 10000000L : 90000000L );
+  FD_TEST( fd_policy_peer_rto( peer ) > peer->srtt + 2L*40000000L );
+  FD_TEST( fd_policy_peer_rto( peer ) <= (long)FD_POLICY_RTO_MAX );
+  for( ulong i = 0; i < 64; i++ ) fd_policy_peer_response_update( policy, &key, (i & 1UL) ? 1000000L : 1000000000L );
+  FD_TEST( fd_policy_peer_rto( peer ) == (long)FD_POLICY_RTO_MAX );
+  for( ulong i = 0; i < 256; i++ ) fd_policy_peer_response_update( policy, &key, 10000000L );
+
+  /* AIMD window: additive increase of ~1 per window of responses */
+
+  double cwnd = peer->cwnd;
+  ulong  acks = (ulong)cwnd;
+  for( ulong i = 0; i < acks; i++ ) fd_policy_peer_response_update( policy, &key, 10000000L );
+  FD_TEST( peer->cwnd > cwnd + 0.9 && peer->cwnd < cwnd + 1.1 );
+
+  /* Window closes once cwnd requests are inflight */
+
+  ulong req_cnt = 0UL;
+  while( fd_policy_peer_window_open( peer ) ) { fd_policy_peer_request_update( policy, &key ); req_cnt++; }
+  FD_TEST( req_cnt == (ulong)peer->cwnd + 1UL || req_cnt == (ulong)peer->cwnd );
+  FD_TEST( peer->inflight == req_cnt );
+
+  /* Timeouts halve the window at most once per RTO and decay yield.
+     Timeouts that are not losses only release the inflight slot. */
+
+  long   now   = 1000000000L;
+  cwnd         = peer->cwnd;
+  double yield = peer->yield;
+  fd_policy_peer_timeout_update( policy, &key, now, 0 );
+  FD_TEST( peer->cwnd == cwnd && peer->yield == yield && peer->tmo_cnt == 0UL && peer->inflight == req_cnt - 1UL );
+  fd_policy_peer_timeout_update( policy, &key, now, 1 );
+  FD_TEST( peer->cwnd == cwnd * 0.5 && peer->yield < yield && peer->tmo_cnt == 1UL );
+  FD_TEST( fd_policy_peer_window_open( peer ) == 0 );
+  fd_policy_peer_timeout_update( policy, &key, now + 1L, 1 );
+  FD_TEST( peer->cwnd == cwnd * 0.5 && peer->tmo_cnt == 2UL );
+  now += fd_policy_peer_rto( peer );
+  fd_policy_peer_timeout_update( policy, &key, now, 1 );
+  FD_TEST( peer->cwnd == cwnd * 0.25 );
+  for( ulong i = 0; i < 64; i++ ) { now += (long)FD_POLICY_RTO_MAX; fd_policy_peer_timeout_update( policy, &key, now, 1 ); }
+  FD_TEST( peer->cwnd == FD_POLICY_CWND_MIN );
+  FD_TEST( peer->inflight == 0UL );
+  FD_TEST( peer->yield >= FD_POLICY_YIELD_MIN );
+
+  /* A peer that stops responding is demoted to the slow bucket */
+
+  FD_TEST( fd_policy_peer_latency_bucket( policy, peer ) == policy->peers.slow );
+  FD_TEST( bucket_cnt( policy, policy->peers.fast ) == 0UL );
+  FD_TEST( bucket_cnt( policy, policy->peers.slow ) == 1UL );
+
+  FD_TEST( fd_policy_peer_remove( policy, &key ) );
+  FD_TEST( !fd_policy_peer_query( policy, &key ) );
+  FD_TEST( !fd_policy_peer_select( policy ) );
+  policy_free( policy );
+}
+
+static void
+test_select_tiebreak( fd_wksp_t * wksp ) {
+  fd_policy_t * policy = policy_new( wksp );
+  fd_ip4_port_t addr = { .addr = 1U, .port = 1 };
+
+  /* Unscored peers tie on score, so the higher stake wins each round */
+
+  for( ulong i = 0; i < FD_POLICY_SELECT_CNT; i++ ) {
+    fd_pubkey_t key = peer_key( i );
+    FD_TEST( fd_policy_peer_insert( policy, &key, &addr ) );
+    fd_policy_peer_query( policy, &key )->stake = 100UL * (i + 1UL);
+  }
+  fd_pubkey_t top = peer_key( FD_POLICY_SELECT_CNT - 1UL );
+  fd_pubkey_t const * sel = fd_policy_peer_select( policy );
+  FD_TEST( sel && !memcmp( sel, &top, sizeof(fd_pubkey_t) ) );
+
+  /* A full window loses to any open one, regardless of stake */
+
+  fd_policy_peer_t * peer = fd_policy_peer_query( policy, &top );
+  while( fd_policy_peer_window_open( peer ) ) fd_policy_peer_request_update( policy, &top );
+  fd_pubkey_t second = peer_key( FD_POLICY_SELECT_CNT - 2UL );
+  sel = fd_policy_peer_select( policy );
+  FD_TEST( sel && !memcmp( sel, &second, sizeof(fd_pubkey_t) ) );
+
+  /* If every window is full, still return a peer */
+
+  for( ulong i = 0; i < FD_POLICY_SELECT_CNT; i++ ) {
+    fd_pubkey_t key = peer_key( i );
+    peer = fd_policy_peer_query( policy, &key );
+    while( fd_policy_peer_window_open( peer ) ) fd_policy_peer_request_update( policy, &key );
+  }
+  FD_TEST( fd_policy_peer_select( policy ) );
+  policy_free( policy );
+}
+
+/* Simulated peer set.  Each peer has a true RTT and drop rate, the
+   simulation sends req_per_ms requests per ms to fd_policy_peer_select
+   and delivers responses or timeouts at the right simulated time. */
+
+struct sim_peer {
+  long  lat;     /* ns */
+  float drop;    /* probability a request is never answered */
+  ulong sent;
+  ulong recv;
+};
+typedef struct sim_peer sim_peer_t;
+
+struct sim_event {
+  long  ts;
+  ulong peer;
+  int   lost;
+};
+typedef struct sim_event sim_event_t;
+
+#define SIM_PEER_CNT  (48UL)
+#define SIM_EVENT_MAX (1UL<<14)
+
+static sim_event_t events[ SIM_EVENT_MAX ];
+
+static void
+test_simulated_peers( fd_wksp_t * wksp ) {
+  fd_policy_t * policy = policy_new( wksp );
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 1234U, 0UL ) );
+  fd_ip4_port_t addr = { .addr = 1U, .port = 1 };
+
+  /* A third of the peers are fast and reliable, a third are slow and a
+     third drop most requests. */
+
+  sim_peer_t peers[ SIM_PEER_CNT ];
+  for( ulong i = 0; i < SIM_PEER_CNT; i++ ) {
+    switch( i % 3UL ) {
+    case 0:  peers[i] = (sim_peer_t){ .lat =  20000000L + (long)fd_rng_ulong_roll( rng, 20000000UL ), .drop = 0.01f }; break;
+    case 1:  peers[i] = (sim_peer_t){ .lat = 150000000L + (long)fd_rng_ulong_roll( rng, 50000000UL ), .drop = 0.01f }; break;
+    default: peers[i] = (sim_peer_t){ .lat =  20000000L + (long)fd_rng_ulong_roll( rng, 20000000UL ), .drop = 0.8f  }; break;
+    }
+    fd_pubkey_t key = peer_key( i );
+    FD_TEST( fd_policy_peer_insert( policy, &key, &addr ) );
+    fd_policy_peer_query( policy, &key )->stake = fd_rng_ulong_roll( rng, 1000UL );
+  }
+
+  ulong event_cnt  = 0UL;
+  ulong req_per_ms = 8UL;
+  ulong sent       = 0UL;
+  ulong closed     = 0UL;
+  for( long now = 0L; now < 4000000000L; now += 1000000L ) {
+
+    /* Deliver due responses and timeouts */
+
+    for( ulong i = 0; i < event_cnt; ) {
+      if( events[i].ts > now ) { i++; continue; }
+      fd_pubkey_t key = peer_key( events[i].peer );
+      if( events[i].lost ) {
+        fd_policy_peer_timeout_update( policy, &key, now, 1 );
+      } else {
+        fd_policy_peer_response_update( policy, &key, peers[ events[i].peer ].lat );
+        peers[ events[i].peer ].recv++;
+      }
+      events[i] = events[--event_cnt];
+    }
+
+    /* Send new requests */
+
+    for( ulong r = 0; r < req_per_ms; r++ ) {
+      fd_pubkey_t const * to = fd_policy_peer_select( policy );
+      FD_TEST( to );
+      ulong i = to->ul[0] - 1UL;
+      FD_TEST( i < SIM_PEER_CNT );
+      fd_policy_peer_t * peer = fd_policy_peer_query( policy, to );
+      closed += !fd_policy_peer_window_open( peer );
+
+      FD_TEST( event_cnt < SIM_EVENT_MAX );
+      int lost = fd_rng_float_c( rng ) < peers[i].drop;
+      events[ event_cnt++ ] = (sim_event_t){ .ts = now + (lost ? fd_policy_peer_rto( peer ) : peers[i].lat), .peer = i, .lost = lost };
+      fd_policy_peer_request_update( policy, to );
+      peers[i].sent++;
+      sent++;
+    }
+  }
+
+  ulong cls_sent[3] = {0}; ulong cls_recv[3] = {0};
+  for( ulong i = 0; i < SIM_PEER_CNT; i++ ) {
+    cls_sent[ i % 3UL ] += peers[i].sent;
+    cls_recv[ i % 3UL ] += peers[i].recv;
+    FD_TEST( peers[i].sent ); /* nobody is starved of probes */
+  }
+  FD_LOG_NOTICE(( "sent %lu (fast %lu, slow %lu, lossy %lu), yield %.3f, sent to full windows %lu",
+                  sent, cls_sent[0], cls_sent[1], cls_sent[2],
+                  (double)(cls_recv[0]+cls_recv[1]+cls_recv[2]) / (double)sent, closed ));
+
+  /* Round robin would split requests evenly.  Scoring should steer most
+     of them to the fast reliable peers. */
+
+  FD_TEST( cls_sent[0] > sent / 2UL );
+  FD_TEST( cls_sent[2] < sent / 6UL );
+  FD_TEST( bucket_cnt( policy, policy->peers.fast ) + bucket_cnt( policy, policy->peers.slow ) == SIM_PEER_CNT );
+  FD_TEST( bucket_cnt( policy, policy->peers.fast ) >= SIM_PEER_CNT / 3UL );
+
+  /* Peers can leave mid-selection without derailing the iterator */
+
+  for( ulong i = 0; i < SIM_PEER_CNT; i += 2UL ) {
+    fd_pubkey_t key = peer_key( i );
+    FD_TEST( fd_policy_peer_remove( policy, &key ) );
+    for( ulong r = 0; r < 3UL; r++ ) {
+      fd_pubkey_t const * to = fd_policy_peer_select( policy );
+      FD_TEST( to && fd_policy_peer_query( policy, to ) );
+    }
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  policy_free( policy );
+}
+
+static void
+test_inflights( fd_wksp_t * wksp ) {
+  void * mem = fd_wksp_alloc_laddr( wksp, fd_inflights_align(), fd_inflights_footprint(), 1UL );
+  FD_TEST( mem );
+  fd_inflights_t * inflights = fd_inflights_join( fd_inflights_new( mem ) );
+  FD_TEST( inflights );
+
+  /* Requests time out in deadline order, not send order */
+
+  fd_pubkey_t slow = peer_key( 0UL );
+  fd_pubkey_t fast = peer_key( 1UL );
+  long sent = fd_log_wallclock();
+  fd_inflights_request_insert( inflights, 1UL, &slow, 10UL, 0UL, sent, (long)FD_POLICY_RTO_MAX );
+  fd_inflights_request_insert( inflights, 2UL, &fast, 10UL, 1UL, sent, (long)FD_POLICY_RTO_MIN );
+  fd_inflights_request_insert( inflights, 3UL, &fast, 10UL, 2UL, sent, (long)FD_POLICY_RTO_MIN );
+  FD_TEST( !fd_inflights_should_drain( inflights, sent ) );
+
+  fd_pubkey_t peer;
+  FD_TEST( fd_inflights_request_remove( inflights, 3UL, &peer ) > 0L );
+  FD_TEST( !memcmp( &peer, &fast, sizeof(fd_pubkey_t) ) );
+  FD_TEST( !fd_inflights_request_query( inflights, 3UL ) );
+
+  long now = sent + (long)FD_POLICY_RTO_MIN + 1L;
+  FD_TEST( fd_inflights_should_drain( inflights, now ) );
+  ulong nonce; ulong slot; ulong shred_idx;
+  fd_inflights_request_pop( inflights, &nonce, &slot, &shred_idx, &peer );
+  FD_TEST( nonce == 2UL && slot == 10UL && shred_idx == 1UL && !memcmp( &peer, &fast, sizeof(fd_pubkey_t) ) );
+  FD_TEST( !fd_inflights_should_drain( inflights, now ) );
+
+  now += (long)FD_POLICY_RTO_MAX;
+  FD_TEST( fd_inflights_should_drain( inflights, now ) );
+  fd_inflights_request_pop( inflights, &nonce, &slot, &shred_idx, &peer );
+  FD_TEST( nonce == 1UL && !memcmp( &peer, &slow, sizeof(fd_pubkey_t) ) );
+  FD_TEST( !fd_inflights_should_drain( inflights, now ) );
+
+  /* A full table hands out the request closest to timing out for
+     eviction.  All requests are sent at the same time, so only the
+     RTO decides which one that is. */
+
+  for( ulong i=0UL; i<FD_INFLIGHT_REQ_MAX; i++ ) {
+    FD_TEST( !fd_inflights_full( inflights ) );
+    int early = i==FD_INFLIGHT_REQ_MAX/2UL;
+    fd_inflights_request_insert( inflights, 10UL+i, early ? &fast : &slow, 11UL, i, now, early ? (long)FD_POLICY_RTO_MIN : (long)FD_POLICY_RTO_MAX );
+  }
+  FD_TEST( fd_inflights_full( inflights ) );
+  fd_inflights_request_pop( inflights, &nonce, &slot, &shred_idx, &peer );
+  FD_TEST( nonce == 10UL+FD_INFLIGHT_REQ_MAX/2UL && !memcmp( &peer, &fast, sizeof(fd_pubkey_t) ) );
+  FD_TEST( !fd_inflights_full( inflights ) );
+
+  fd_wksp_free_laddr( mem );
+}
 
 int
 main( int argc, char ** argv ) {
   fd_boot( &argc, &argv );
 
+  char const * page_sz  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "gigantic" );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 1UL        );
+  ulong        numa_idx = fd_shmem_numa_idx( 0 );
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( page_sz ), page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  test_peer_stats( wksp );
+  test_select_tiebreak( wksp );
+  test_simulated_peers( wksp );
+  test_inflights( wksp );
+
+  fd_wksp_delete_anonymous( wksp );
+  FD_LOG_NOTICE(( "pass" ));
   fd_halt();
+  return 0;
 }
@@ -1,6 +1,8 @@
 #ifndef HEADER_fd_src_discof_replay_fd_exec_h
 #define HEADER_fd_src_discof_replay_fd_exec_h
 
+#include "../../ballet/poh/fd_poh.h"
+
 /* FIXME: SIMD-0180 - set the correct epochs */
 #define FD_SIMD0180_ACTIVE_EPOCH_TESTNET (829)
 #define FD_SIMD0180_ACTIVE_EPOCH_MAINNET (841)
@@ -31,9 +33,24 @@ struct fd_exec_txn_sigverify_msg {
 };
 typedef struct fd_exec_txn_sigverify_msg fd_exec_txn_sigverify_msg_t;
 
+/* A batch of consecutive PoH entries, see fd_sched_poh_batch_t. */
+
+struct fd_exec_poh_verify_msg {
+  ulong          bank_idx;
+  ulong          poh_idx;
+  uchar          start[ FD_SHA256_HASH_SZ ];
+  ulong          entry_cnt;
+  fd_poh_entry_t entry[ FD_POH_VERIFY_ENTRY_MAX ];
+};
+typedef struct fd_exec_poh_verify_msg fd_exec_poh_verify_msg_t;
+
+/* Don't grow the replay_exec link MTU for PoH verify tasks. */
+FD_STATIC_ASSERT( sizeof(fd_exec_poh_verify_msg_t)<=sizeof(fd_exec_txn_exec_msg_t), poh_verify_msg_sz );
+
 union fd_exec_task_msg {
   fd_exec_txn_exec_msg_t      txn_exec;
   fd_exec_txn_sigverify_msg_t txn_sigverify;
+  fd_exec_poh_verify_msg_t    poh_verify;
 };
 typedef union fd_exec_task_msg fd_exec_task_msg_t;
 
@@ -54,11 +71,18 @@ struct fd_exec_txn_sigverify_done_msg {
 };
 typedef struct fd_exec_txn_sigverify_done_msg fd_exec_txn_sigverify_done_msg_t;
 
+struct fd_exec_poh_verify_done_msg {
+  ulong poh_idx;
+  int   err;
+};
+typedef struct fd_exec_poh_verify_done_msg fd_exec_poh_verify_done_msg_t;
+
 struct fd_exec_task_done_msg {
   ulong bank_idx;
   union {
     fd_exec_txn_exec_done_msg_t      txn_exec[ 1 ];
     fd_exec_txn_sigverify_done_msg_t txn_sigverify[ 1 ];
+    fd_exec_poh_verify_done_msg_t    poh_verify[ 1 ];
   };
 };
 typedef struct fd_exec_task_done_msg fd_exec_task_done_msg_t;
@@ -1006,6 +1006,7 @@ fini_leader_bank( fd_replay_tile_t *  ctx,
   ulong curr_slot = fd_bank_slot_get( ctx->leader_bank );
 
   fd_sched_block_add_done( ctx->sched, ctx->leader_bank->idx, ctx->leader_bank->parent_idx, curr_slot );
+  *fd_sched_get_poh( ctx->sched, ctx->leader_bank->idx ) = *fd_bank_poh_query( ctx->leader_bank );
 
   /* Do hashing and other end-of-block processing */
   fd_funk_txn_map_t * txn_map = fd_funk_txn_map( ctx->accdb->funk );
@@ -1458,6 +1459,7 @@ boot_genesis( fd_replay_tile_t *  ctx,
 
   ctx->published_root_slot = 0UL;
   fd_sched_block_add_done( ctx->sched, bank->idx, ULONG_MAX, 0UL );
+  *fd_sched_get_poh( ctx->sched, bank->idx ) = *fd_bank_poh_query( bank );
 
   fd_bank_block_height_set( bank, 1UL );
 
@@ -1574,6 +1576,7 @@ on_snapshot_message( fd_replay_tile_t *  ctx,
     }
 
     fd_sched_block_add_done( ctx->sched, bank->idx, ULONG_MAX, snapshot_slot );
+    *fd_sched_get_poh( ctx->sched, bank->idx ) = *fd_bank_poh_query( bank );
     FD_TEST( bank->idx==0UL );
 
     fd_funk_txn_xid_t xid = { .ul = { snapshot_slot, FD_REPLAY_BOOT_BANK_IDX } };
@@ -1683,6 +1686,24 @@ dispatch_task( fd_replay_tile_t *  ctx,
       exec_out->chunk = fd_dcache_compact_next( exec_out->chunk, sizeof(*exec_msg), exec_out->chunk0, exec_out->wmark );
       break;
     };
+    case FD_SCHED_TT_POH_VERIFY: {
+      fd_sched_poh_batch_t const * batch = fd_sched_get_poh_batch( ctx->sched, task->poh_verify->poh_idx );
+
+      fd_bank_t * bank = fd_banks_bank_query( ctx->banks, task->poh_verify->bank_idx );
+      bank->refcnt++;
+
+      fd_replay_out_link_t *     exec_out = ctx->exec_out;
+      fd_exec_poh_verify_msg_t * exec_msg = fd_chunk_to_laddr( exec_out->mem, exec_out->chunk );
+      exec_msg->bank_idx  = task->poh_verify->bank_idx;
+      exec_msg->poh_idx   = task->poh_verify->poh_idx;
+      exec_msg->entry_cnt = batch->entry_cnt;
+      memcpy( exec_msg->start, batch->start.uc, sizeof(exec_msg->start) );
+      memcpy( exec_msg->entry, batch->entry, batch->entry_cnt*sizeof(fd_poh_entry_t) );
+      ulong msg_sz = sizeof(*exec_msg)-(FD_POH_VERIFY_ENTRY_MAX-batch->entry_cnt)*sizeof(fd_poh_entry_t);
+      fd_stem_publish( stem, exec_out->idx, (FD_EXEC_TT_POH_VERIFY<<32) | task->poh_verify->exec_idx, exec_out->chunk, msg_sz, 0UL, 0UL, 0UL );
+      exec_out->chunk = fd_dcache_compact_next( exec_out->chunk, msg_sz, exec_out->chunk0, exec_out->wmark );
+      break;
+    }
     default: {
       FD_LOG_CRIT(( "unexpected task type %lu", task->task_type ));
     }
@@ -1717,7 +1738,8 @@ replay( fd_replay_tile_t *  ctx,
       break;
     }
     case FD_SCHED_TT_TXN_EXEC:
-    case FD_SCHED_TT_TXN_SIGVERIFY: {
+    case FD_SCHED_TT_TXN_SIGVERIFY:
+    case FD_SCHED_TT_POH_VERIFY: {
       /* Likely/common case: we have a transaction we actually need to
          execute. */
       dispatch_task( ctx, stem, task );
@@ -1855,6 +1877,13 @@ process_fec_set( fd_replay_tile_t * ctx,
   sched_fec->slot                   = reasm_fec->slot;
   sched_fec->parent_slot            = reasm_fec->slot - reasm_fec->parent_off;
   sched_fec->is_first_in_block      = reasm_fec->fec_set_idx==0U;
+  if( FD_UNLIKELY( sched_fec->is_first_in_block ) ) {
+    /* PoH parameters only change at genesis, so the parent's are the
+       block's. */
+    fd_bank_t * parent_bank    = fd_banks_bank_query( ctx->banks, sched_fec->parent_bank_idx );
+    sched_fec->hashes_per_tick = fd_bank_hashes_per_tick_get( parent_bank );
+    sched_fec->ticks_per_slot  = fd_bank_ticks_per_slot_get ( parent_bank );
+  }
   fd_funk_txn_xid_copy( sched_fec->alut_ctx->xid, fd_funk_last_publish( ctx->accdb->funk ) );
   sched_fec->alut_ctx->accdb[0]     = ctx->accdb[0];
   sched_fec->alut_ctx->els          = ctx->published_root_slot;
@@ -2121,6 +2150,20 @@ process_exec_task_done( fd_replay_tile_t *        ctx,
       fd_sched_task_done( ctx->sched, FD_SCHED_TT_TXN_SIGVERIFY, msg->txn_sigverify->txn_idx, exec_tile_idx );
       break;
     }
+    case FD_EXEC_TT_POH_VERIFY: {
+      if( FD_UNLIKELY( msg->poh_verify->err && !(bank->flags&FD_BANK_FLAGS_DEAD) ) ) {
+        /* The PoH hash chain of a valid block has to verify.
+           Otherwise, we should mark the block as dead.  Also freeze the
+           bank if possible. */
+        fd_banks_mark_bank_dead( ctx->banks, bank );
+        fd_sched_block_abandon( ctx->sched, bank->idx );
+      }
+      if( FD_UNLIKELY( (bank->flags&FD_BANK_FLAGS_DEAD) && bank->refcnt==0UL ) ) {
+        fd_banks_mark_bank_frozen( ctx->banks, bank );
+      }
+      fd_sched_task_done( ctx->sched, FD_SCHED_TT_POH_VERIFY, msg->poh_verify->poh_idx, exec_tile_idx );
+      break;
+    }
     default: FD_LOG_CRIT(( "unexpected sig 0x%lx", sig ));
   }
 
@@ -3,12 +3,19 @@
 #include "../../flamenco/runtime/fd_runtime.h" /* for fd_runtime_load_txn_address_lookup_tables */
 
 #include "../../flamenco/runtime/sysvar/fd_sysvar_slot_hashes.h" /* for ALUTs */
+#include "../../ballet/bmtree/fd_bmtree.h" /* for PoH mixins */
 
 
 #define FD_SCHED_MAX_DEPTH                 (FD_RDISP_MAX_DEPTH>>2)
 #define FD_SCHED_MAX_STAGING_LANES_LOG     (2)
 #define FD_SCHED_MAX_STAGING_LANES         (1UL<<FD_SCHED_MAX_STAGING_LANES_LOG)
 
+/* Max number of batches of PoH entries that are waiting for or in
+   verification, across all blocks.  A mainnet block has a few hundred
+   to a few thousand entries, so this covers several blocks.  If the
+   pool runs dry, the parser verifies entries inline. */
+#define FD_SCHED_MAX_POH_BATCH             (512UL)
+
 /* 64 ticks per slot, and a single gigantic microblock containing min
    size transactions. */
 FD_STATIC_ASSERT( FD_MAX_TXN_PER_SLOT_SHRED==((FD_SHRED_DATA_PAYLOAD_MAX_PER_SLOT-65UL*sizeof(fd_microblock_hdr_t))/FD_TXN_MIN_SERIALIZED_SZ), max_txn_per_slot_shred );
@@ -38,6 +45,13 @@ FD_STATIC_ASSERT( FD_TXN_MTU>=sizeof(ulong),               resize buffer for res
 #define SET_MAX  FD_SCHED_MAX_DEPTH
 #include "../../util/tmpl/fd_set.c"
 
+struct fd_sched_poh_task {
+  fd_sched_poh_batch_t batch[ 1 ];
+  ulong                bank_idx; /* Block the batch belongs to. */
+  ulong                next;     /* Next batch in the block's queue, or in the free list. */
+};
+typedef struct fd_sched_poh_task fd_sched_poh_task_t;
+
 struct fd_sched_block {
   ulong               slot;
   ulong               parent_slot;
@@ -53,12 +67,24 @@ struct fd_sched_block {
   uint                txn_sigverify_in_flight_cnt;
   uint                txn_sigverify_done_cnt;
   uint                txn_done_cnt; /* A transaction is considered done when all types of tasks associated with it are done. */
+  uint                poh_queued_cnt;    /* Number of sealed PoH batches waiting for dispatch. */
+  uint                poh_in_flight_cnt; /* Number of PoH batches being verified. */
+  ulong               poh_head_idx;      /* Queue of sealed PoH batches in block order, ignored if poh_queued_cnt==0. */
+  ulong               poh_tail_idx;
+  ulong               poh_open_idx;      /* PoH batch being filled by the parser, or ULONG_MAX. */
   ulong               txn_idx[ FD_MAX_TXN_PER_SLOT ]; /* Indexed by parse order. */
   uint                shred_cnt;
 
   /* Parser state. */
   uchar               txn[ FD_TXN_MAX_SZ ] __attribute__((aligned(alignof(fd_txn_t))));
   fd_hash_t           poh;          /* Latest PoH hash we've seen from the ingested FEC sets. */
+  fd_hash_t           poh_start;    /* PoH hash at the start of the current microblock. */
+  fd_poh_entry_t      poh_entry[1]; /* PoH entry of the current microblock, waiting for its mixin. */
+  ulong               hashcnt_per_tick; /* Max hash_cnt of a single entry, 0 if unbounded (PoH hashing disabled). */
+  ulong               hashcnt_max;      /* Max sum of hash_cnt over the block's entries. */
+  ulong               hashcnt_tot;      /* Sum of hash_cnt over the entries parsed so far. */
+  uchar               poh_mixin[ FD_BMTREE_COMMIT_FOOTPRINT(0) ] __attribute__((aligned(FD_BMTREE_COMMIT_ALIGN)));
+                                    /* Merkle tree over the signatures of the current microblock. */
   ulong               mblks_rem;    /* Number of microblocks remaining in the current batch. */
   ulong               txns_rem;     /* Number of transactions remaining in the current microblock. */
   fd_acct_addr_t      aluts[ 256 ]; /* Resolve ALUT accounts into this buffer for more parallelism. */
@@ -118,6 +144,7 @@ struct fd_sched_metrics {
   uint  txn_abandoned_exec_done_cnt;
   uint  txn_abandoned_done_cnt;
   uint  txn_max_in_flight_cnt;
+  uint  poh_inline_cnt;
   ulong txn_weighted_in_flight_cnt;
   ulong txn_weighted_in_flight_tickcount;
   ulong txn_none_in_flight_tickcount;
@@ -125,6 +152,8 @@ struct fd_sched_metrics {
   ulong txn_exec_done_cnt;
   ulong txn_sigverify_done_cnt;
   ulong txn_done_cnt;
+  ulong poh_entry_cnt;
+  ulong poh_batch_done_cnt;
   ulong bytes_ingested_cnt;
   ulong bytes_ingested_unparsed_cnt;
   ulong bytes_dropped_cnt;
@@ -154,6 +183,8 @@ struct fd_sched {
   ulong               txn_to_bank_idx[ FD_SCHED_MAX_DEPTH ]; /* Index of the bank that the txn belongs to. */
   txn_bitset_t        exec_done_set[ txn_bitset_word_cnt ];      /* Indexed by txn_idx. */
   txn_bitset_t        sigverify_done_set[ txn_bitset_word_cnt ]; /* Indexed by txn_idx. */
+  ulong               poh_free_idx; /* Free list of PoH batches. */
+  fd_sched_poh_task_t poh_pool[ FD_SCHED_MAX_POH_BATCH ];
   fd_sched_block_t *  block_pool; /* Just a flat array. */
 };
 typedef struct fd_sched fd_sched_t;
@@ -172,6 +203,15 @@ fd_sched_parse( fd_sched_t * sched, fd_sched_block_t * block, fd_sched_alut_ctx_
 FD_WARN_UNUSED static int
 fd_sched_parse_txn( fd_sched_t * sched, fd_sched_block_t * block, fd_sched_alut_ctx_t * alut_ctx );
 
+static int
+poh_entry_push( fd_sched_t * sched, fd_sched_block_t * block, fd_hash_t const * start );
+
+static void
+poh_batch_seal( fd_sched_t * sched, fd_sched_block_t * block );
+
+static void
+poh_batch_release_all( fd_sched_t * sched, fd_sched_block_t * block );
+
 static void
 try_activate_block( fd_sched_t * sched );
 
@@ -206,9 +246,14 @@ block_is_void( fd_sched_block_t * block ) {
   return block->fec_eos && block->txn_parsed_cnt==0;
 }
 
+static inline int
+block_poh_is_done( fd_sched_block_t * block ) {
+  return !block->poh_queued_cnt && !block->poh_in_flight_cnt && block->poh_open_idx==ULONG_MAX;
+}
+
 static inline int
 block_should_signal_end( fd_sched_block_t * block ) {
-  return block->fec_eos && block->txn_parsed_cnt==block->txn_done_cnt && block->block_start_done && !block->block_end_signaled;
+  return block->fec_eos && block->txn_parsed_cnt==block->txn_done_cnt && block_poh_is_done( block ) && block->block_start_done && !block->block_end_signaled;
 }
 
 static inline int
@@ -225,18 +270,19 @@ block_is_dispatchable( fd_sched_block_t * block ) {
   ulong sigverify_queued_cnt = block->txn_parsed_cnt-block->txn_sigverify_in_flight_cnt-block->txn_sigverify_done_cnt;
   return exec_queued_cnt>0UL ||
          sigverify_queued_cnt>0UL ||
+         block->poh_queued_cnt>0U ||
          !block->block_start_signaled ||
          block_will_signal_end( block );
 }
 
 static inline int
 block_is_in_flight( fd_sched_block_t * block ) {
-  return block->txn_exec_in_flight_cnt || block->txn_sigverify_in_flight_cnt || (block->block_end_signaled && !block->block_end_done);
+  return block->txn_exec_in_flight_cnt || block->txn_sigverify_in_flight_cnt || block->poh_in_flight_cnt || (block->block_end_signaled && !block->block_end_done);
 }
 
 static inline int
 block_is_done( fd_sched_block_t * block ) {
-  return block->fec_eos && block->txn_parsed_cnt==block->txn_done_cnt && block->block_start_done && block->block_end_done;
+  return block->fec_eos && block->txn_parsed_cnt==block->txn_done_cnt && block_poh_is_done( block ) && block->block_start_done && block->block_end_done;
 }
 
 static inline int
@@ -276,8 +322,8 @@ block_should_deactivate( fd_sched_block_t * block ) {
 
 FD_FN_UNUSED static void
 print_block( fd_sched_block_t * block ) {
-  FD_LOG_INFO(( "block slot %lu, parent_slot %lu, staged %d (lane %lu), dying %d, in_rdisp %d, fec_eos %d, rooted %d, block_start_signaled %d, block_end_signaled %d, block_start_done %d, block_end_done %d, txn_parsed_cnt %u, txn_exec_in_flight_cnt %u, txn_exec_done_cnt %u, txn_sigverify_in_flight_cnt %u, txn_sigverify_done_cnt %u, txn_done_cnt %u, shred_cnt %u, mblks_rem %lu, txns_rem %lu, fec_buf_sz %u, fec_buf_soff %u, fec_eob %d, fec_sob %d",
-                block->slot, block->parent_slot, block->staged, block->staging_lane, block->dying, block->in_rdisp, block->fec_eos, block->rooted, block->block_start_signaled, block->block_end_signaled, block->block_start_done, block->block_end_done, block->txn_parsed_cnt, block->txn_exec_in_flight_cnt, block->txn_exec_done_cnt, block->txn_sigverify_in_flight_cnt, block->txn_sigverify_done_cnt, block->txn_done_cnt, block->shred_cnt, block->mblks_rem, block->txns_rem, block->fec_buf_sz, block->fec_buf_soff, block->fec_eob, block->fec_sob ));
+  FD_LOG_INFO(( "block slot %lu, parent_slot %lu, staged %d (lane %lu), dying %d, in_rdisp %d, fec_eos %d, rooted %d, block_start_signaled %d, block_end_signaled %d, block_start_done %d, block_end_done %d, txn_parsed_cnt %u, txn_exec_in_flight_cnt %u, txn_exec_done_cnt %u, txn_sigverify_in_flight_cnt %u, txn_sigverify_done_cnt %u, txn_done_cnt %u, poh_queued_cnt %u, poh_in_flight_cnt %u, poh_open_idx %lu, shred_cnt %u, mblks_rem %lu, txns_rem %lu, fec_buf_sz %u, fec_buf_soff %u, fec_eob %d, fec_sob %d",
+                block->slot, block->parent_slot, block->staged, block->staging_lane, block->dying, block->in_rdisp, block->fec_eos, block->rooted, block->block_start_signaled, block->block_end_signaled, block->block_start_done, block->block_end_done, block->txn_parsed_cnt, block->txn_exec_in_flight_cnt, block->txn_exec_done_cnt, block->txn_sigverify_in_flight_cnt, block->txn_sigverify_done_cnt, block->txn_done_cnt, block->poh_queued_cnt, block->poh_in_flight_cnt, block->poh_open_idx, block->shred_cnt, block->mblks_rem, block->txns_rem, block->fec_buf_sz, block->fec_buf_soff, block->fec_eob, block->fec_sob ));
 }
 
 FD_FN_UNUSED static void
@@ -366,6 +412,9 @@ fd_sched_new( void * mem, ulong block_cnt_max, ulong exec_cnt ) {
   txn_bitset_new( sched->exec_done_set );
   txn_bitset_new( sched->sigverify_done_set );
 
+  for( ulong i=0UL; i<FD_SCHED_MAX_POH_BATCH; i++ ) sched->poh_pool[ i ].next = fd_ulong_if( i+1UL<FD_SCHED_MAX_POH_BATCH, i+1UL, ULONG_MAX );
+  sched->poh_free_idx = 0UL;
+
   return sched;
 }
 
@@ -446,6 +495,14 @@ fd_sched_fec_ingest( fd_sched_t * sched, fd_sched_fec_t * fec ) {
     add_block( sched, fec->bank_idx, fec->parent_bank_idx );
     block->slot        = fec->slot;
     block->parent_slot = fec->parent_slot;
+    /* PoH of the block chains off of the last PoH hash of the parent. */
+    block->poh         = block_pool_ele( sched, fec->parent_bank_idx )->poh;
+    /* A block holds the ticks of every slot since its parent, skipped
+       slots included, and no tick takes more than hashes_per_tick
+       hashes. */
+    block->hashcnt_per_tick = fec->hashes_per_tick;
+    block->hashcnt_max      = fd_ulong_sat_mul( fd_ulong_sat_mul( fec->hashes_per_tick, fec->ticks_per_slot ), fec->slot-fec->parent_slot );
+    block->hashcnt_tot      = 0UL;
 
     if( FD_UNLIKELY( block->dying ) ) {
       /* The child of a dead block is also dead.  We added it to our
@@ -618,12 +675,34 @@ fd_sched_fec_ingest( fd_sched_t * sched, fd_sched_fec_t * fec ) {
     return 0;
   }
 
+  /* There won't be any more PoH entries for the block.  So release the
+     last partially filled batch for verification. */
+  if( block->fec_eos ) poh_batch_seal( sched, block );
+
   /* Check if we need to set the active block. */
   check_or_set_active_block( sched );
 
   return 1;
 }
 
+/* Dispatch the PoH batch at the head of the block's queue to a fully
+   idle exec tile.  A PoH verify task occupies the sigverify slot of the
+   exec tile. */
+static void
+poh_verify_dispatch( fd_sched_t * sched, fd_sched_block_t * block, ulong exec_fully_ready_bitset, fd_sched_task_t * out ) {
+  int   exec_tile_idx = fd_ulong_find_lsb( exec_fully_ready_bitset );
+  ulong poh_idx       = block->poh_head_idx;
+  block->poh_head_idx = sched->poh_pool[ poh_idx ].next;
+  block->poh_queued_cnt--;
+  block->poh_in_flight_cnt++;
+  out->task_type = FD_SCHED_TT_POH_VERIFY;
+  out->poh_verify->bank_idx = (ulong)(block-sched->block_pool);
+  out->poh_verify->poh_idx  = poh_idx;
+  out->poh_verify->exec_idx = (ulong)exec_tile_idx;
+  sched->sigverify_ready_bitset[ 0 ] = fd_ulong_clear_bit( sched->sigverify_ready_bitset[ 0 ], exec_tile_idx );
+  if( FD_UNLIKELY( (~sched->txn_exec_ready_bitset[ 0 ])&(~sched->sigverify_ready_bitset[ 0 ])&fd_ulong_mask_lsb( (int)sched->exec_cnt ) ) ) FD_LOG_CRIT(( "invariant violation: txn_exec_ready_bitset 0x%lx sigverify_ready_bitset 0x%lx", sched->txn_exec_ready_bitset[ 0 ], sched->sigverify_ready_bitset[ 0 ] ));
+}
+
 ulong
 fd_sched_task_next_ready( fd_sched_t * sched, fd_sched_task_t * out ) {
   FD_TEST( sched->canary==FD_SCHED_MAGIC );
@@ -709,6 +788,11 @@ fd_sched_task_next_ready( fd_sched_t * sched, fd_sched_task_t * out ) {
         if( FD_UNLIKELY( (~sched->txn_exec_ready_bitset[ 0 ])&(~sched->sigverify_ready_bitset[ 0 ])&fd_ulong_mask_lsb( (int)sched->exec_cnt ) ) ) FD_LOG_CRIT(( "invariant violation: txn_exec_ready_bitset 0x%lx sigverify_ready_bitset 0x%lx", sched->txn_exec_ready_bitset[ 0 ], sched->sigverify_ready_bitset[ 0 ] ));
         return 1UL;
       }
+      /* Same goes for PoH verify tasks. */
+      if( FD_LIKELY( block->poh_queued_cnt>0U && fd_ulong_popcnt( exec_fully_ready_bitset )>fd_int_if( block->txn_exec_in_flight_cnt>0U, 0, 1 ) ) ) {
+        poh_verify_dispatch( sched, block, exec_fully_ready_bitset, out );
+        return 1UL;
+      }
       return 0UL;
     }
     out->task_type = FD_SCHED_TT_TXN_EXEC;
@@ -732,7 +816,7 @@ fd_sched_task_next_ready( fd_sched_t * sched, fd_sched_task_t * out ) {
 
     ulong total_exec_busy_cnt = sched->exec_cnt-(ulong)fd_ulong_popcnt( sched->txn_exec_ready_bitset[ 0 ]&sched->sigverify_ready_bitset[ 0 ] );
     if( FD_UNLIKELY( (~sched->txn_exec_ready_bitset[ 0 ])&(~sched->sigverify_ready_bitset[ 0 ])&fd_ulong_mask_lsb( (int)sched->exec_cnt ) ) ) FD_LOG_CRIT(( "invariant violation: txn_exec_ready_bitset 0x%lx sigverify_ready_bitset 0x%lx", sched->txn_exec_ready_bitset[ 0 ], sched->sigverify_ready_bitset[ 0 ] ));
-    if( FD_UNLIKELY( block->txn_exec_in_flight_cnt+block->txn_sigverify_in_flight_cnt!=total_exec_busy_cnt ) ) {
+    if( FD_UNLIKELY( block->txn_exec_in_flight_cnt+block->txn_sigverify_in_flight_cnt+block->poh_in_flight_cnt!=total_exec_busy_cnt ) ) {
       /* Ideally we'd simply assert that the two sides of the equation
          are equal.  But abandoned blocks throw a wrench into this.  We
          allow abandoned blocks to have in-flight transactions that are
@@ -752,6 +836,7 @@ fd_sched_task_next_ready( fd_sched_t * sched, fd_sched_task_t * out ) {
           }
           total_in_flight += staged_block->txn_exec_in_flight_cnt;
           total_in_flight += staged_block->txn_sigverify_in_flight_cnt;
+          total_in_flight += staged_block->poh_in_flight_cnt;
         }
       }
       if( FD_UNLIKELY( total_in_flight!=total_exec_busy_cnt ) ) {
@@ -783,6 +868,13 @@ fd_sched_task_next_ready( fd_sched_t * sched, fd_sched_task_t * out ) {
     return 1UL;
   }
 
+  /* Same goes for PoH verify tasks, which are dispatched after all the
+     sigverify tasks that are available. */
+  if( FD_LIKELY( block->poh_queued_cnt>0U && fd_ulong_popcnt( exec_fully_ready_bitset )>fd_int_if( block->fec_eos||block->txn_exec_in_flight_cnt>0U||sched->exec_cnt==1UL, 0, 1 ) ) ) {
+    poh_verify_dispatch( sched, block, exec_fully_ready_bitset, out );
+    return 1UL;
+  }
+
   if( FD_UNLIKELY( block_should_signal_end( block ) ) ) {
     FD_TEST( block->block_start_signaled );
     out->task_type = FD_SCHED_TT_BLOCK_END;
@@ -827,6 +919,11 @@ fd_sched_task_done( fd_sched_t * sched, ulong task_type, ulong txn_idx, ulong ex
       bank_idx = sched->txn_to_bank_idx[ txn_idx ];
       break;
     }
+    case FD_SCHED_TT_POH_VERIFY: {
+      FD_TEST( txn_idx<FD_SCHED_MAX_POH_BATCH );
+      bank_idx = sched->poh_pool[ txn_idx ].bank_idx;
+      break;
+    }
     default: FD_LOG_CRIT(( "unsupported task_type %lu", task_type ));
   }
   fd_sched_block_t * block = block_pool_ele( sched, bank_idx );
@@ -902,6 +999,17 @@ fd_sched_task_done( fd_sched_t * sched, ulong task_type, ulong txn_idx, ulong ex
         sched->metrics->txn_done_cnt++;
       }
 
+      FD_TEST( !fd_ulong_extract_bit( sched->sigverify_ready_bitset[ 0 ], exec_tile_idx ) );
+      sched->sigverify_ready_bitset[ 0 ] = fd_ulong_set_bit( sched->sigverify_ready_bitset[ 0 ], exec_tile_idx );
+      break;
+    }
+    case FD_SCHED_TT_POH_VERIFY: {
+      FD_TEST( block->poh_in_flight_cnt );
+      block->poh_in_flight_cnt--;
+      sched->metrics->poh_batch_done_cnt++;
+      sched->poh_pool[ txn_idx ].next = sched->poh_free_idx;
+      sched->poh_free_idx = txn_idx;
+
       FD_TEST( !fd_ulong_extract_bit( sched->sigverify_ready_bitset[ 0 ], exec_tile_idx ) );
       sched->sigverify_ready_bitset[ 0 ] = fd_ulong_set_bit( sched->sigverify_ready_bitset[ 0 ], exec_tile_idx );
       break;
@@ -1149,6 +1257,13 @@ fd_sched_get_poh( fd_sched_t * sched, ulong bank_idx ) {
   return &block->poh;
 }
 
+fd_sched_poh_batch_t const *
+fd_sched_get_poh_batch( fd_sched_t * sched, ulong poh_idx ) {
+  FD_TEST( sched->canary==FD_SCHED_MAGIC );
+  FD_TEST( poh_idx<FD_SCHED_MAX_POH_BATCH );
+  return sched->poh_pool[ poh_idx ].batch;
+}
+
 uint
 fd_sched_get_shred_cnt( fd_sched_t * sched, ulong bank_idx ) {
   FD_TEST( sched->canary==FD_SCHED_MAGIC );
@@ -1177,6 +1292,9 @@ add_block( fd_sched_t * sched,
   block->txn_sigverify_done_cnt      = 0U;
   block->txn_done_cnt                = 0U;
   block->shred_cnt                   = 0U;
+  block->poh_queued_cnt              = 0U;
+  block->poh_in_flight_cnt           = 0U;
+  block->poh_open_idx                = ULONG_MAX;
 
   block->mblks_rem    = 0UL;
   block->txns_rem     = 0UL;
@@ -1258,9 +1376,36 @@ fd_sched_parse( fd_sched_t * sched, fd_sched_block_t * block, fd_sched_alut_ctx_
       fd_microblock_hdr_t * hdr = (fd_microblock_hdr_t *)fd_type_pun( block->fec_buf+block->fec_buf_soff );
       block->fec_buf_soff      += (uint)sizeof(fd_microblock_hdr_t);
 
+      /* hash_cnt comes straight from the leader and sizes the PoH
+         verify work for the entry.  Reject the block before anything
+         gets queued if an entry spans more than a tick, or if the block
+         would hash more than its slots' worth of ticks. */
+      if( FD_UNLIKELY( block->hashcnt_per_tick &&
+                       ( hdr->hash_cnt>block->hashcnt_per_tick ||
+                         hdr->hash_cnt>block->hashcnt_max-block->hashcnt_tot ) ) ) {
+        FD_LOG_INFO(( "entry hash_cnt %lu exceeds bounds (hashes_per_tick %lu, %lu of %lu hashes used) for slot %lu",
+                      hdr->hash_cnt, block->hashcnt_per_tick, block->hashcnt_tot, block->hashcnt_max, block->slot ));
+        return FD_SCHED_PARSER_BAD_BLOCK;
+      }
+      block->hashcnt_tot += hdr->hash_cnt;
+
+      block->poh_start = block->poh;
       memcpy( block->poh.hash, hdr->hash, sizeof(block->poh.hash) );
       block->txns_rem = hdr->txn_cnt;
       block->mblks_rem--;
+
+      /* An entry without transactions is complete right away.
+         Otherwise, the mixin is the Merkle root over the signatures of
+         all the transactions in the entry, and the entry is complete
+         once the last transaction is parsed. */
+      memcpy( block->poh_entry->hash, hdr->hash, sizeof(block->poh_entry->hash) );
+      block->poh_entry->hashcnt   = hdr->hash_cnt;
+      block->poh_entry->has_mixin = block->txns_rem>0UL;
+      if( FD_LIKELY( block->txns_rem>0UL ) ) {
+        fd_bmtree_commit_init( block->poh_mixin, 32UL, 1UL, 0UL );
+      } else if( FD_UNLIKELY( poh_entry_push( sched, block, &block->poh_start ) ) ) {
+        return FD_SCHED_PARSER_BAD_BLOCK;
+      }
       continue;
     }
     if( block->txns_rem==0UL && block->mblks_rem==0UL && block->fec_sob ) {
@@ -1346,9 +1491,80 @@ fd_sched_parse_txn( fd_sched_t * sched, fd_sched_block_t * block, fd_sched_alut_
   block->txn_sigverify_done_cnt++;
 #endif
   block->txns_rem--;
+
+  fd_bmtree_commit_t * mixin = (fd_bmtree_commit_t *)fd_type_pun( block->poh_mixin );
+  for( ulong j=0UL; j<txn->signature_cnt; j++ ) {
+    fd_bmtree_node_t node[1];
+    fd_bmtree_hash_leaf( node, txn_p->payload+txn->signature_off+64UL*j, 64UL, 1UL );
+    fd_bmtree_commit_append( mixin, node, 1UL );
+  }
+  if( FD_UNLIKELY( !block->txns_rem ) ) {
+    memcpy( block->poh_entry->mixin, fd_bmtree_commit_fini( mixin ), sizeof(block->poh_entry->mixin) );
+    if( FD_UNLIKELY( poh_entry_push( sched, block, &block->poh_start ) ) ) return FD_SCHED_PARSER_BAD_BLOCK;
+  }
   return FD_SCHED_PARSER_OK;
 }
 
+/* Append the completed PoH entry of the current microblock, which
+   starts at PoH hash start, to the batch being filled for the block.
+   If there are no free batches, the entry is verified inline.  Returns
+   0 on success, and -1 if the entry failed inline verification. */
+static int
+poh_entry_push( fd_sched_t * sched, fd_sched_block_t * block, fd_hash_t const * start ) {
+  sched->metrics->poh_entry_cnt++;
+
+  if( FD_UNLIKELY( block->poh_open_idx==ULONG_MAX ) ) {
+    if( FD_UNLIKELY( sched->poh_free_idx==ULONG_MAX ) ) {
+      /* Verifying inline stalls the replay tile, but this should be
+         rare and there is no reason to block ingest on it. */
+      sched->metrics->poh_inline_cnt++;
+      if( FD_UNLIKELY( fd_poh_verify_entries( start->uc, block->poh_entry, 1UL )!=ULONG_MAX ) ) {
+        FD_LOG_INFO(( "PoH verification failed for entry %s, slot %lu", FD_BASE58_ENC_32_ALLOCA( block->poh_entry->hash ), block->slot ));
+        return -1;
+      }
+      return 0;
+    }
+    block->poh_open_idx = sched->poh_free_idx;
+    fd_sched_poh_task_t * task = sched->poh_pool+block->poh_open_idx;
+    sched->poh_free_idx    = task->next;
+    task->bank_idx         = (ulong)(block-sched->block_pool);
+    task->next             = ULONG_MAX;
+    task->batch->start     = *start;
+    task->batch->entry_cnt = 0UL;
+  }
+
+  fd_sched_poh_task_t * task = sched->poh_pool+block->poh_open_idx;
+  task->batch->entry[ task->batch->entry_cnt++ ] = *block->poh_entry;
+  if( FD_UNLIKELY( task->batch->entry_cnt==FD_POH_VERIFY_ENTRY_MAX ) ) poh_batch_seal( sched, block );
+  return 0;
+}
+
+/* Move the batch being filled for the block, if any, to the back of
+   the block's queue of batches waiting for dispatch. */
+static void
+poh_batch_seal( fd_sched_t * sched, fd_sched_block_t * block ) {
+  ulong poh_idx = block->poh_open_idx;
+  if( FD_UNLIKELY( poh_idx==ULONG_MAX ) ) return;
+  block->poh_open_idx = ULONG_MAX;
+  if( FD_LIKELY( block->poh_queued_cnt ) ) sched->poh_pool[ block->poh_tail_idx ].next = poh_idx;
+  else                                     block->poh_head_idx                          = poh_idx;
+  block->poh_tail_idx = poh_idx;
+  block->poh_queued_cnt++;
+}
+
+/* Release all batches of the block that are not in-flight. */
+static void
+poh_batch_release_all( fd_sched_t * sched, fd_sched_block_t * block ) {
+  poh_batch_seal( sched, block );
+  while( block->poh_queued_cnt ) {
+    ulong poh_idx = block->poh_head_idx;
+    block->poh_head_idx = sched->poh_pool[ poh_idx ].next;
+    block->poh_queued_cnt--;
+    sched->poh_pool[ poh_idx ].next = sched->poh_free_idx;
+    sched->poh_free_idx = poh_idx;
+  }
+}
+
 #undef CHECK
 #undef CHECK_LEFT
 
@@ -1491,12 +1707,13 @@ subtree_abandon( fd_sched_t * sched, fd_sched_block_t * block ) {
        recycled, we would basically be aliasing the same txn_id and end
        up indexing into txn_to_bank_idx[] that is already overwritten
        with new blocks. */
-    int abandon = in_order && block->txn_exec_in_flight_cnt==0 && block->txn_sigverify_in_flight_cnt==0;
+    int abandon = in_order && block->txn_exec_in_flight_cnt==0 && block->txn_sigverify_in_flight_cnt==0 && block->poh_in_flight_cnt==0;
 
     if( abandon ) {
       block->in_rdisp = 0;
       fd_rdisp_abandon_block( sched->rdisp, (ulong)(block-sched->block_pool) );
       sched->txn_pool_free_cnt += block->txn_parsed_cnt-block->txn_done_cnt; /* in_flight_cnt==0 */
+      poh_batch_release_all( sched, block );
       sched->metrics->block_abandoned_cnt++;
       sched->metrics->txn_abandoned_parsed_cnt    += block->txn_parsed_cnt;
       sched->metrics->txn_abandoned_exec_done_cnt += block->txn_exec_done_cnt;
@@ -4,6 +4,7 @@
 #include "fd_rdisp.h"
 #include "../../disco/store/fd_store.h" /* for fd_store_fec_t */
 #include "../../disco/pack/fd_microblock.h" /* for fd_txn_p_t */
+#include "../../ballet/poh/fd_poh.h" /* for fd_poh_entry_t */
 
 #include "../../flamenco/accdb/fd_accdb_user.h"
 #include "../../util/spad/fd_spad.h" /* for ALUTs */
@@ -70,6 +71,9 @@ struct fd_sched_fec {
                                            bounds and unique across equivocated blocks. */
   ulong            slot;                /* Slot number of the block. */
   ulong            parent_slot;         /* Slot number of the parent block. */
+  ulong            hashes_per_tick;     /* PoH hashes per tick of the block's bank, 0 if PoH hashing is
+                                           disabled (low power clusters).  Only read if is_first_in_block. */
+  ulong            ticks_per_slot;      /* Ticks per slot of the block's bank.  Only read if is_first_in_block. */
   fd_store_fec_t * fec;                 /* FEC set data. */
   uint             shred_cnt;           /* Number of shreds in the FEC set. */
   uint             is_last_in_batch:1;  /* Set if this is the last FEC set in the batch; relevant because the
@@ -122,6 +126,24 @@ struct fd_sched_txn_sigverify {
 };
 typedef struct fd_sched_txn_sigverify fd_sched_txn_sigverify_t;
 
+struct fd_sched_poh_verify {
+  ulong bank_idx;
+  ulong poh_idx;  /* Batch of PoH entries to verify, see fd_sched_get_poh_batch(). */
+  ulong exec_idx;
+};
+typedef struct fd_sched_poh_verify fd_sched_poh_verify_t;
+
+/* A batch of up to FD_POH_VERIFY_ENTRY_MAX consecutive PoH entries of a
+   block.  start is the PoH hash at the start of the first entry, that
+   is the hash of the previous entry in the block, or the last PoH hash
+   of the parent block. */
+struct fd_sched_poh_batch {
+  fd_hash_t      start;
+  ulong          entry_cnt;
+  fd_poh_entry_t entry[ FD_POH_VERIFY_ENTRY_MAX ];
+};
+typedef struct fd_sched_poh_batch fd_sched_poh_batch_t;
+
 struct fd_sched_task {
   ulong task_type; /* Set to one of the task types defined above. */
   union {
@@ -129,6 +151,7 @@ struct fd_sched_task {
     fd_sched_block_end_t     block_end[ 1 ];
     fd_sched_txn_exec_t      txn_exec[ 1 ];
     fd_sched_txn_sigverify_t txn_sigverify[ 1 ];
+    fd_sched_poh_verify_t    poh_verify[ 1 ];
   };
 };
 typedef struct fd_sched_task fd_sched_task_t;
@@ -209,13 +232,21 @@ fd_sched_can_ingest( fd_sched_t * sched, ulong fec_cnt );
    transactions over sigverify, and in general sigverify tasks are only
    returned when no real transaction can be dispatched.  In other words,
    the scheduler tries to exploit idle cycles in the exec tiles during
-   times of low parallelism critical path progression. */
+   times of low parallelism critical path progression.
+
+   The same goes for PoH verify tasks.  The parser batches up the PoH
+   entries (microblock headers) of a block, and each batch is verified
+   on an exec tile, where the hash chains of all entries in the batch
+   are computed in parallel.  PoH verify tasks have lower priority than
+   sigverify tasks, and the end of a block is only signaled once all of
+   its PoH entries have been verified. */
 ulong
 fd_sched_task_next_ready( fd_sched_t * sched, fd_sched_task_t * out );
 
 /* Mark a task as complete.  For transaction execution, this means that
    the effects of the execution are now visible on any core that could
-   execute a subsequent transaction. */
+   execute a subsequent transaction.  For PoH verify tasks, txn_idx is
+   the poh_idx of the task. */
 void
 fd_sched_task_done( fd_sched_t * sched, ulong task_type, ulong txn_idx, ulong exec_idx );
 
@@ -257,9 +288,16 @@ fd_sched_root_notify( fd_sched_t * sched, ulong root_idx );
 fd_txn_p_t *
 fd_sched_get_txn( fd_sched_t * sched, ulong txn_idx );
 
+/* Returns the latest PoH hash of a block.  For a block added with
+   fd_sched_block_add_done(), the caller should set this to the last PoH
+   hash of the block, as this is where PoH verification of its children
+   starts from. */
 fd_hash_t *
 fd_sched_get_poh( fd_sched_t * sched, ulong bank_idx );
 
+fd_sched_poh_batch_t const *
+fd_sched_get_poh_batch( fd_sched_t * sched, ulong poh_idx );
+
 uint
 fd_sched_get_shred_cnt( fd_sched_t * sched, ulong bank_idx );
 
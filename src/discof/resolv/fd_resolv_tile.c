@@ -8,6 +8,9 @@
 #include "../../flamenco/runtime/fd_alut_interp.h"
 #include "../../flamenco/runtime/fd_system_ids_pp.h"
 #include "../../flamenco/runtime/fd_bank.h"
+#include "../../flamenco/runtime/fd_txncache.h"
+#include "../../flamenco/runtime/fd_txncache_shmem.h"
+#include "../../ballet/blake3/fd_blake3.h"
 #include "../../util/pod/fd_pod_format.h"
 
 #if FD_HAS_AVX
@@ -108,6 +111,17 @@ typedef struct {
 
 #include "../../util/tmpl/fd_map_chain.c"
 
+/* A fd_resolv_pending_t is a transaction that is ready to be
+   published, but is held back until a batch of them can be checked
+   against the status cache together.  The transaction itself already
+   sits in its (reserved) resolv_pack dcache chunk. */
+
+typedef struct {
+  ulong     chunk;
+  ulong     tsorig;
+  fd_hash_t msg_hash; /* blake3 of the message, as in the status cache */
+} fd_resolv_pending_t;
+
 typedef struct {
   int         kind;
 
@@ -150,6 +164,28 @@ typedef struct {
 
   fd_accdb_user_t accdb[1];
 
+  /* Transactions that have already been executed on the rooted fork
+     (replays of landed transactions, typically from spammers) would be
+     rejected as AlreadyProcessed by the bank tile anyway, but only
+     after wasting a pack slot and bank time on them.  The resolv tile
+     drops them early by querying the status cache at the fork of the
+     rooted bank.  The rooted fork is an ancestor of any fork we could
+     become leader on, so this never drops a transaction that could
+     still land, but transactions that landed in slots after the root
+     are left for the bank tile to reject.
+
+     To keep up with the full TPU rate, the queries are batched: up to
+     FD_RESOLV_BATCH_MAX transactions are accumulated in pending (in
+     their resolv_pack dcache chunks) and checked together once the
+     batch is full, or once the tile has polled its ins idle_max times
+     without queueing anything. */
+  fd_txncache_t *     txncache;
+  fd_blake3_t         blake3[1];
+  ulong               pending_cnt;
+  ulong               idle_cnt;
+  ulong               idle_max;
+  fd_resolv_pending_t pending[ FD_RESOLV_BATCH_MAX ];
+
   fd_stashed_txn_m_t * pool;
   map_chain_t *        map_chain;
   lru_list_t           lru_list[1];
@@ -165,6 +201,7 @@ typedef struct {
     ulong lut[ FD_METRICS_COUNTER_RESOLV_LUT_RESOLVED_CNT ];
     ulong blockhash_expired;
     ulong bundle_peer_failure;
+    ulong already_processed;
     ulong stash[ FD_METRICS_COUNTER_RESOLV_STASH_OPERATION_CNT ];
     ulong db_race;
   } metrics;
@@ -182,12 +219,12 @@ scratch_align( void ) {
 
 FD_FN_PURE static inline ulong
 scratch_footprint( fd_topo_tile_t const * tile ) {
-  (void)tile;
   ulong l = FD_LAYOUT_INIT;
-  l = FD_LAYOUT_APPEND( l, alignof( fd_resolv_ctx_t ), sizeof( fd_resolv_ctx_t )        );
-  l = FD_LAYOUT_APPEND( l, pool_align(),               pool_footprint     ( 1UL<<16UL ) );
-  l = FD_LAYOUT_APPEND( l, map_chain_align(),          map_chain_footprint( 8192UL    ) );
-  l = FD_LAYOUT_APPEND( l, map_align(),                map_footprint()                  );
+  l = FD_LAYOUT_APPEND( l, alignof( fd_resolv_ctx_t ), sizeof( fd_resolv_ctx_t )                                );
+  l = FD_LAYOUT_APPEND( l, pool_align(),               pool_footprint     ( 1UL<<16UL )                         );
+  l = FD_LAYOUT_APPEND( l, map_chain_align(),          map_chain_footprint( 8192UL    )                         );
+  l = FD_LAYOUT_APPEND( l, map_align(),                map_footprint()                                          );
+  l = FD_LAYOUT_APPEND( l, fd_txncache_align(),        fd_txncache_footprint( tile->resolv.max_live_slots ) );
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
 
@@ -198,6 +235,7 @@ metrics_write( fd_resolv_ctx_t * ctx ) {
   FD_MCNT_ENUM_COPY( RESOLF, STASH_OPERATION,                 ctx->metrics.stash );
   FD_MCNT_SET(       RESOLF, TRANSACTION_BUNDLE_PEER_FAILURE, ctx->metrics.bundle_peer_failure );
   FD_MCNT_SET(       RESOLF, DB_RACES,                        ctx->metrics.db_race );
+  FD_MCNT_SET(       RESOLF, ALREADY_PROCESSED,               ctx->metrics.already_processed );
 }
 
 static int
@@ -336,39 +374,124 @@ peek_aluts( fd_resolv_ctx_t * ctx,
   return err;
 }
 
-static int
-publish_txn( fd_resolv_ctx_t *          ctx,
-             fd_stem_context_t *        stem,
-             fd_stashed_txn_m_t const * stashed ) {
-  fd_txn_m_t * txnm = fd_chunk_to_laddr( ctx->out_pack->mem, ctx->out_pack->chunk );
-  fd_memcpy( txnm, stashed->_, fd_txn_m_realized_footprint( (fd_txn_m_t *)stashed->_, 1, 0 ) );
+/* publish_resolved resolves the address lookup tables of the
+   transaction in the given resolv_pack chunk, if any, and publishes it
+   to pack.  Returns 1 if the transaction was published and 0 if it was
+   dropped. */
 
+static int
+publish_resolved( fd_resolv_ctx_t *   ctx,
+                  fd_stem_context_t * stem,
+                  ulong               chunk,
+                  ulong               tsorig ) {
+  fd_txn_m_t *     txnm = fd_chunk_to_laddr( ctx->out_pack->mem, chunk );
   fd_txn_t const * txnt = fd_txn_m_txn_t( txnm );
 
-  txnm->reference_slot = ctx->flushing_slot;
-
   if( FD_UNLIKELY( txnt->addr_table_adtl_cnt ) ) {
     if( FD_UNLIKELY( !ctx->bank ) ) {
       FD_MCNT_INC( RESOLF, NO_BANK_DROP, 1 );
       return 0;
     }
-    int err = peek_aluts( ctx, txnm );
-    if( FD_UNLIKELY( err ) ) return 0;
+    if( FD_UNLIKELY( peek_aluts( ctx, txnm ) ) ) return 0;
   }
 
   ulong realized_sz = fd_txn_m_realized_footprint( txnm, 1, 1 );
   ulong tspub = fd_frag_meta_ts_comp( fd_tickcount() );
-  fd_stem_publish( stem, 0UL, txnm->reference_slot, ctx->out_pack->chunk, realized_sz, 0UL, 0UL, tspub );
+  fd_stem_publish( stem, 0UL, txnm->reference_slot, chunk, realized_sz, 0UL, tsorig, tspub );
+  return 1;
+}
+
+static int
+publish_txn( fd_resolv_ctx_t *          ctx,
+             fd_stem_context_t *        stem,
+             fd_stashed_txn_m_t const * stashed ) {
+  fd_txn_m_t * txnm = fd_chunk_to_laddr( ctx->out_pack->mem, ctx->out_pack->chunk );
+  fd_memcpy( txnm, stashed->_, fd_txn_m_realized_footprint( (fd_txn_m_t *)stashed->_, 1, 0 ) );
+
+  txnm->reference_slot = ctx->flushing_slot;
+
+  if( FD_UNLIKELY( !publish_resolved( ctx, stem, ctx->out_pack->chunk, 0UL ) ) ) return 0;
+
+  ulong realized_sz = fd_txn_m_realized_footprint( txnm, 1, 1 );
   ctx->out_pack->chunk = fd_dcache_compact_next( ctx->out_pack->chunk, realized_sz, ctx->out_pack->chunk0, ctx->out_pack->wmark );
 
   return 1;
 }
 
+/* queue_txn reserves the current resolv_pack chunk for the transaction
+   in it and adds it to the pending batch. */
+
+static void
+queue_txn( fd_resolv_ctx_t * ctx,
+           fd_txn_m_t *      txnm,
+           ulong             tsorig ) {
+  fd_txn_t const * txnt    = fd_txn_m_txn_t_const( txnm );
+  uchar const *    payload = fd_txn_m_payload_const( txnm );
+
+  fd_resolv_pending_t * pending = &ctx->pending[ ctx->pending_cnt++ ];
+  pending->chunk  = ctx->out_pack->chunk;
+  pending->tsorig = tsorig;
+
+  /* https://github.com/anza-xyz/agave/blob/v2.1.7/sdk/program/src/message/versions/mod.rs#L159-L167 */
+  fd_blake3_init( ctx->blake3 );
+  fd_blake3_append( ctx->blake3, "solana-tx-message-v1", 20UL );
+  fd_blake3_append( ctx->blake3, payload+txnt->message_off, (ulong)txnm->payload_sz-(ulong)txnt->message_off );
+  fd_blake3_fini( ctx->blake3, pending->msg_hash.uc );
+
+  ulong realized_sz = fd_txn_m_realized_footprint( txnm, 1, 1 );
+  ctx->out_pack->chunk = fd_dcache_compact_next( ctx->out_pack->chunk, realized_sz, ctx->out_pack->chunk0, ctx->out_pack->wmark );
+  ctx->idle_cnt = 0UL;
+}
+
+/* flush_pending checks the pending batch against the status cache at
+   the rooted fork, drops the transactions that were already processed
+   and publishes the rest.  Requires ctx->bank to be the bank the batch
+   was queued against. */
+
+static void
+flush_pending( fd_resolv_ctx_t *   ctx,
+               fd_stem_context_t * stem ) {
+  ulong         cnt = ctx->pending_cnt;
+  uchar const * blockhashes[ FD_RESOLV_BATCH_MAX ] = {0}; /* init to appease gcc -Wmaybe-uninitialized */
+  uchar const * txnhashes  [ FD_RESOLV_BATCH_MAX ] = {0};
+  int           processed  [ FD_RESOLV_BATCH_MAX ];
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_txn_m_t const * txnm = fd_chunk_to_laddr_const( ctx->out_pack->mem, ctx->pending[ i ].chunk );
+    blockhashes[ i ] = fd_txn_m_payload_const( txnm ) + fd_txn_m_txn_t_const( txnm )->recent_blockhash_off;
+    txnhashes  [ i ] = ctx->pending[ i ].msg_hash.uc;
+  }
+
+  fd_txncache_query_batch( ctx->txncache, ctx->bank->txncache_fork_id, cnt, blockhashes, txnhashes, processed );
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    if( FD_UNLIKELY( processed[ i ] ) ) {
+      ctx->metrics.already_processed++;
+      continue;
+    }
+    publish_resolved( ctx, stem, ctx->pending[ i ].chunk, ctx->pending[ i ].tsorig );
+  }
+
+  ctx->pending_cnt = 0UL;
+  ctx->idle_cnt    = 0UL;
+}
+
 static inline void
 after_credit( fd_resolv_ctx_t *   ctx,
               fd_stem_context_t * stem,
               int *               opt_poll_in,
               int *               charge_busy ) {
+  if( FD_UNLIKELY( ctx->pending_cnt ) ) {
+    if( FD_LIKELY( ctx->pending_cnt<FD_RESOLV_BATCH_MAX && ctx->idle_cnt<ctx->idle_max ) ) {
+      ctx->idle_cnt++;
+    } else {
+      /* The flush can publish a full burst, so don't also poll. */
+      *charge_busy = 1;
+      *opt_poll_in = 0;
+      flush_pending( ctx, stem );
+      return;
+    }
+  }
+
   if( FD_LIKELY( ctx->flush_pool_idx==ULONG_MAX ) ) return;
 
   *charge_busy = 1;
@@ -447,6 +570,10 @@ after_frag( fd_resolv_ctx_t *   ctx,
       case REPLAY_SIG_ROOT_ADVANCED: {
         fd_replay_root_advanced_t const * msg = &ctx->_rooted_slot_msg;
 
+        /* The pending batch was queued against the current bank, which
+           is only guaranteed to be around until we hand it back. */
+        if( FD_UNLIKELY( ctx->pending_cnt ) ) flush_pending( ctx, stem );
+
         /* Replace current bank with new bank */
         fd_bank_t * prev_bank = ctx->bank;
 
@@ -553,23 +680,22 @@ after_frag( fd_resolv_ctx_t *   ctx,
     return;
   }
 
-  if( FD_UNLIKELY( txnt->addr_table_adtl_cnt ) ) {
-    if( FD_UNLIKELY( !ctx->bank ) ) {
-      FD_MCNT_INC( RESOLF, NO_BANK_DROP, 1 );
-      if( FD_UNLIKELY( txnm->block_engine.bundle_id ) ) ctx->bundle_failed = 1;
-      return;
-    }
+  /* Bundles are published right away, since dropping a member would
+     fail the whole bundle, and durable nonce transactions are never
+     inserted into the status cache, so only regular transactions with
+     a known blockhash are checked for having already been processed. */
 
-    int result = peek_aluts( ctx, txnm );
-    if( FD_UNLIKELY( result ) ) {
-      if( FD_UNLIKELY( txnm->block_engine.bundle_id ) ) ctx->bundle_failed = 1;
-      return;
-    }
+  if( FD_LIKELY( blockhash && !is_bundle_member && !is_durable_nonce && ctx->bank ) ) {
+    queue_txn( ctx, txnm, tsorig );
+    return;
+  }
+
+  if( FD_UNLIKELY( !publish_resolved( ctx, stem, ctx->out_pack->chunk, tsorig ) ) ) {
+    if( FD_UNLIKELY( txnm->block_engine.bundle_id ) ) ctx->bundle_failed = 1;
+    return;
   }
 
   ulong realized_sz = fd_txn_m_realized_footprint( txnm, 1, 1 );
-  ulong tspub = fd_frag_meta_ts_comp( fd_tickcount() );
-  fd_stem_publish( stem, 0UL, txnm->reference_slot, ctx->out_pack->chunk, realized_sz, 0UL, tsorig, tspub );
   ctx->out_pack->chunk = fd_dcache_compact_next( ctx->out_pack->chunk, realized_sz, ctx->out_pack->chunk0, ctx->out_pack->wmark );
 }
 
@@ -592,6 +718,13 @@ unprivileged_init( fd_topo_t *      topo,
 
   ctx->flush_pool_idx = ULONG_MAX;
 
+  /* Under load, every round_robin_cnt-th dedup frag is ours and the ins
+     are polled in turn. */
+  ctx->pending_cnt = 0UL;
+  ctx->idle_cnt    = 0UL;
+  ctx->idle_max    = tile->in_cnt*ctx->round_robin_cnt;
+  FD_TEST( fd_blake3_join( fd_blake3_new( ctx->blake3 ) ) );
+
   ctx->pool = pool_join( pool_new( FD_SCRATCH_ALLOC_APPEND( l, pool_align(), pool_footprint( 1UL<<16UL ) ), 1UL<<16UL ) );
   FD_TEST( ctx->pool );
 
@@ -606,6 +739,12 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->blockhash_map = map_join( map_new( FD_SCRATCH_ALLOC_APPEND( l, map_align(), map_footprint() ) ) );
   FD_TEST( ctx->blockhash_map );
 
+  void * _txncache = FD_SCRATCH_ALLOC_APPEND( l, fd_txncache_align(), fd_txncache_footprint( tile->resolv.max_live_slots ) );
+  fd_txncache_shmem_t * txncache_shmem = fd_txncache_shmem_join( fd_topo_obj_laddr( topo, tile->resolv.txncache_obj_id ) );
+  FD_TEST( txncache_shmem );
+  ctx->txncache = fd_txncache_join( fd_txncache_new( _txncache, txncache_shmem ) );
+  FD_TEST( ctx->txncache );
+
   FD_TEST( tile->in_cnt<=sizeof( ctx->in )/sizeof( ctx->in[ 0 ] ) );
   for( ulong i=0UL; i<tile->in_cnt; i++ ) {
     fd_topo_link_t * link = &topo->links[ tile->in_link_id[ i ] ];
@@ -673,7 +812,7 @@ populate_allowed_fds( fd_topo_t const *      topo,
   return out_cnt;
 }
 
-#define STEM_BURST (1UL)
+#define STEM_BURST FD_RESOLV_BATCH_MAX
 
 #define STEM_CALLBACK_CONTEXT_TYPE  fd_resolv_ctx_t
 #define STEM_CALLBACK_CONTEXT_ALIGN alignof(fd_resolv_ctx_t)
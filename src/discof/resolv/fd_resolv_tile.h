@@ -3,6 +3,13 @@
 
 #include "../../util/fd_util_base.h"
 
+/* FD_RESOLV_BATCH_MAX is the maximum number of transactions the resolv
+   tile holds back in its resolv_pack dcache so that it can check them
+   against the status cache together.  The resolv_pack link must be
+   created with at least this burst. */
+
+#define FD_RESOLV_BATCH_MAX (16UL)
+
 /* fd_resolv_slot_exchanged is sent by the resolv tile to replay to
    indicate that it is done with a particular root bank, and that replay
    can free it if it wants to. */
@@ -6,8 +6,11 @@ ifdef FD_HAS_ZSTD
 $(call add-objs,fd_snapdc_tile,fd_discof)
 endif
 ifdef FD_HAS_INT128
-$(call add-objs,fd_snapin_tile fd_snapin_tile_funk fd_snapin_tile_vinyl,fd_discof)
+$(call add-objs,fd_snapin_tile fd_snapin_tile_funk fd_snapin_tile_vinyl fd_snapin_tile_lthash,fd_discof)
+$(call make-unit-test,test_snapin_lthash,test_snapin_lthash,fd_discof fd_disco fd_flamenco fd_funk fd_tango fd_ballet fd_util)
+$(call run-unit-test,test_snapin_lthash)
 endif
+$(call add-objs,fd_snapla_tile,fd_discof)
 $(call add-objs,fd_snapwr_tile,fd_discof)
 endif
 ifdef FD_HAS_INT128
@@ -34,6 +37,9 @@ endif
 $(call add-objs,utils/fd_ssresolve,fd_discof)
 ifdef FD_HAS_HOSTED
 $(call add-objs,utils/fd_sshttp,fd_discof)
+$(call add-objs,utils/fd_ssrange,fd_discof)
+$(call make-unit-test,test_ssrange,utils/test_ssrange,fd_discof fd_waltz fd_flamenco fd_ballet fd_util)
+$(call run-unit-test,test_ssrange)
 endif
 $(call add-objs,utils/fd_ssarchive,fd_discof)
 $(call add-objs,utils/fd_sspeer_selector,fd_discof)
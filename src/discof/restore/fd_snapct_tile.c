@@ -92,6 +92,9 @@ struct fd_snapct_tile {
   long          deadline_nanos;
   int           flush_ack;
   fd_ip4_port_t addr;
+  ulong         alt_cnt;
+  fd_ip4_port_t alt[ FD_SSCTRL_ALT_MAX ];
+  int           alt_disabled;
 
   struct {
     int dir_fd;
@@ -402,8 +405,13 @@ init_load( fd_snapct_tile_t *  ctx,
            int full,
            int file ) {
   fd_ssctrl_init_t * out = fd_chunk_to_laddr( ctx->out_ld.mem, ctx->out_ld.chunk );
-  out->file = file;
-  if( !file ) out->addr = ctx->addr;
+  out->file    = file;
+  out->alt_cnt = 0UL;
+  if( !file ) {
+    out->addr    = ctx->addr;
+    out->alt_cnt = ctx->alt_cnt;
+    fd_memcpy( out->alt, ctx->alt, ctx->alt_cnt*sizeof(fd_ip4_port_t) );
+  }
   fd_stem_publish( stem, ctx->out_ld.idx, full ? FD_SNAPSHOT_MSG_CTRL_INIT_FULL : FD_SNAPSHOT_MSG_CTRL_INIT_INCR, ctx->out_ld.chunk, sizeof(fd_ssctrl_init_t), 0UL, 0UL, 0UL );
   ctx->out_ld.chunk = fd_dcache_compact_next( ctx->out_ld.chunk, sizeof(fd_ssctrl_init_t), ctx->out_ld.chunk0, ctx->out_ld.wmark );
 
@@ -427,6 +435,37 @@ init_load( fd_snapct_tile_t *  ctx,
   }
 }
 
+/* select_peers sets the peer to download the next snapshot from, and
+   up to download_peer_cnt-1 other peers advertising the same snapshot
+   that snapld downloads parts of the file from concurrently. */
+
+static void
+select_peers( fd_snapct_tile_t *  ctx,
+              fd_sspeer_t const * best,
+              int                 incremental ) {
+  ctx->addr    = best->addr;
+  ctx->alt_cnt = 0UL;
+  if( FD_UNLIKELY( ctx->alt_disabled ) ) return;
+
+  fd_sspeer_t alt[ FD_SSCTRL_ALT_MAX ];
+  ulong alt_max = fd_ulong_min( ctx->config.download_peer_cnt-1UL, FD_SSCTRL_ALT_MAX );
+  ctx->alt_cnt  = fd_sspeer_selector_alternates( ctx->selector, best, incremental, alt, alt_max );
+  for( ulong i=0UL; i<ctx->alt_cnt; i++ ) ctx->alt[ i ] = alt[ i ].addr;
+  if( FD_LIKELY( ctx->alt_cnt ) ) FD_LOG_INFO(( "%lu other peers serve the same snapshot", ctx->alt_cnt ));
+}
+
+/* Peers advertising the same snapshot slot and hash do not necessarily
+   serve byte-identical archives, in which case combining their data
+   fails.  After a failed download that involved alternate peers, later
+   downloads use a single peer. */
+
+static void
+disable_alternates( fd_snapct_tile_t * ctx ) {
+  if( FD_LIKELY( !ctx->alt_cnt || ctx->alt_disabled ) ) return;
+  FD_LOG_WARNING(( "failed snapshot download involved %lu other peers, downloading from a single peer from now on", ctx->alt_cnt ));
+  ctx->alt_disabled = 1;
+}
+
 static void
 log_download( fd_snapct_tile_t * ctx,
               int                full,
@@ -577,7 +616,7 @@ after_credit( fd_snapct_tile_t *  ctx,
           send_expected_slot( ctx, stem, best_incremental.ssinfo.incremental.slot );
         }
 
-        ctx->addr                            = best.addr;
+        select_peers( ctx, &best, 0 );
         ctx->state                           = FD_SNAPCT_STATE_READING_FULL_HTTP;
         ctx->predicted_incremental.full_slot = best.ssinfo.full.slot;
         init_load( ctx, stem, 1, 0 );
@@ -598,7 +637,7 @@ after_credit( fd_snapct_tile_t *  ctx,
 
       /* FIXME: predicted_incremental? */
 
-      ctx->addr = best.addr;
+      select_peers( ctx, &best, 1 );
       ctx->state = FD_SNAPCT_STATE_READING_INCREMENTAL_HTTP;
       init_load( ctx, stem, 0, 0 );
       log_download( ctx, 0, best.addr, best.ssinfo.incremental.slot );
@@ -636,6 +675,7 @@ after_credit( fd_snapct_tile_t *  ctx,
                          FD_IP4_ADDR_FMT_ARGS( ctx->addr.addr ), fd_ushort_bswap( ctx->addr.port ) ));
         fd_ssping_invalidate( ctx->ssping, ctx->addr, fd_log_wallclock() );
         fd_sspeer_selector_remove( ctx->selector, ctx->addr );
+        disable_alternates( ctx );
         break;
       }
 
@@ -688,6 +728,7 @@ after_credit( fd_snapct_tile_t *  ctx,
                          FD_IP4_ADDR_FMT_ARGS( ctx->addr.addr ), fd_ushort_bswap( ctx->addr.port ) ));
         fd_ssping_invalidate( ctx->ssping, ctx->addr, fd_log_wallclock() );
         fd_sspeer_selector_remove( ctx->selector, ctx->addr );
+        disable_alternates( ctx );
         break;
       }
 
@@ -715,7 +756,7 @@ after_credit( fd_snapct_tile_t *  ctx,
         send_expected_slot( ctx, stem, best.ssinfo.incremental.slot );
       }
 
-      ctx->addr = best.addr;
+      select_peers( ctx, &best, 1 );
       ctx->state = FD_SNAPCT_STATE_READING_INCREMENTAL_HTTP;
       init_load( ctx, stem, 0, 0 );
       log_download( ctx, 0, best.addr, best.ssinfo.incremental.slot );
@@ -799,6 +840,7 @@ after_credit( fd_snapct_tile_t *  ctx,
                          FD_IP4_ADDR_FMT_ARGS( ctx->addr.addr ), fd_ushort_bswap( ctx->addr.port ) ));
         fd_ssping_invalidate( ctx->ssping, ctx->addr, fd_log_wallclock() );
         fd_sspeer_selector_remove( ctx->selector, ctx->addr );
+        disable_alternates( ctx );
         break;
       }
       if( FD_UNLIKELY( ctx->metrics.full.bytes_total!=0UL && ctx->metrics.full.bytes_read==ctx->metrics.full.bytes_total ) ) {
@@ -820,6 +862,7 @@ after_credit( fd_snapct_tile_t *  ctx,
                          FD_IP4_ADDR_FMT_ARGS( ctx->addr.addr ), fd_ushort_bswap( ctx->addr.port ) ));
         fd_ssping_invalidate( ctx->ssping, ctx->addr, fd_log_wallclock() );
         fd_sspeer_selector_remove( ctx->selector, ctx->addr );
+        disable_alternates( ctx );
         break;
       }
       if ( FD_UNLIKELY( ctx->metrics.incremental.bytes_total!=0UL && ctx->metrics.incremental.bytes_read==ctx->metrics.incremental.bytes_total ) ) {
@@ -1274,6 +1317,8 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->deadline_nanos = fd_log_wallclock() + FD_SNAPCT_WAITING_FOR_PEERS_TIMEOUT;
   ctx->flush_ack      = 0;
   ctx->addr.l         = 0UL;
+  ctx->alt_cnt        = 0UL;
+  ctx->alt_disabled   = 0;
 
   fd_memset( ctx->http_full_snapshot_name, 0, PATH_MAX );
   fd_memset( ctx->http_incr_snapshot_name, 0, PATH_MAX );
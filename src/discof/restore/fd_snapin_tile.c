@@ -1,4 +1,5 @@
 #include "fd_snapin_tile_private.h"
+#include "fd_snapla_tile.h"
 #include "utils/fd_ssctrl.h"
 #include "utils/fd_ssmsg.h"
 #include "utils/fd_vinyl_io_wd.h"
@@ -9,6 +10,7 @@
 #include "../../flamenco/runtime/fd_system_ids.h"
 #include "../../flamenco/runtime/sysvar/fd_sysvar_slot_history.h"
 #include "../../flamenco/types/fd_types.h"
+#include "../../util/pod/fd_pod.h"
 
 #include "generated/fd_snapin_tile_seccomp.h"
 
@@ -17,7 +19,8 @@
 /* The snapin tile is a state machine that parses and loads a full
    and optionally an incremental snapshot.  It is currently responsible
    for loading accounts into an in-memory database, though this may
-   change. */
+   change.  Account insertion can be sharded across multiple snapin
+   tiles (see fd_snapin_tile_private.h). */
 
 /* 300 here is from status_cache.rs::MAX_CACHE_ENTRIES which is the most
    root slots Agave could possibly serve in a snapshot. */
@@ -73,6 +76,9 @@ scratch_footprint( fd_topo_tile_t const * tile ) {
   l = FD_LAYOUT_APPEND( l, fd_slot_delta_parser_align(),   fd_slot_delta_parser_footprint()                     );
   l = FD_LAYOUT_APPEND( l, alignof(fd_sstxncache_entry_t), sizeof(fd_sstxncache_entry_t)*FD_SNAPIN_TXNCACHE_MAX_ENTRIES );
   l = FD_LAYOUT_APPEND( l, alignof(blockhash_group_t),     sizeof(blockhash_group_t)*FD_SNAPIN_MAX_SLOT_DELTA_GROUPS    );
+  if( tile->kind_id ) {
+    l = FD_LAYOUT_APPEND( l, alignof(fd_snapshot_manifest_t), sizeof(fd_snapshot_manifest_t) );
+  }
   if( tile->snapin.use_vinyl ) {
     l = FD_LAYOUT_APPEND( l, fd_vinyl_io_wd_align(), fd_vinyl_io_wd_footprint( tile->snapin.snapwr_depth ) );
     l = FD_LAYOUT_APPEND( l, fd_vinyl_io_mm_align(), fd_vinyl_io_mm_footprint( FD_SNAPIN_IO_SPAD_MAX     ) );
@@ -160,9 +166,19 @@ static void
 transition_malformed( fd_snapin_tile_t *  ctx,
                       fd_stem_context_t * stem ) {
   ctx->state = FD_SNAPSHOT_STATE_ERROR;
+  if( FD_UNLIKELY( ctx->shard.idx ) ) return; /* reported by shard 0 */
   fd_stem_publish( stem, ctx->ct_out.idx, FD_SNAPSHOT_MSG_CTRL_ERROR, 0UL, 0UL, 0UL, 0UL, 0UL );
 }
 
+/* manifest_buf returns the buffer the manifest parser writes to.  Only
+   shard 0 publishes the manifest. */
+
+static fd_snapshot_manifest_t *
+manifest_buf( fd_snapin_tile_t * ctx ) {
+  if( FD_UNLIKELY( ctx->shard.manifest ) ) return ctx->shard.manifest;
+  return fd_chunk_to_laddr( ctx->manifest_out.mem, ctx->manifest_out.chunk );
+}
+
 static int
 populate_txncache( fd_snapin_tile_t *                     ctx,
                    fd_snapshot_manifest_blockhash_t const blockhashes[ static 301UL ],
@@ -404,6 +420,8 @@ process_manifest( fd_snapin_tile_t * ctx ) {
     FD_LOG_INFO(( "snapshot manifest slot=%lu indicates lthash[..32]=%s blake3(lthash)=%s",
                   manifest->slot, sum_enc, hash32_enc ));
   }
+  ctx->lthash.has_expected = manifest->has_accounts_lthash;
+  memcpy( ctx->lthash.expected, manifest->accounts_lthash, FD_LTHASH_LEN_BYTES );
 
   manifest->txncache_fork_id = ctx->txncache_root_fork_id.val;
 
@@ -436,6 +454,7 @@ handle_data_frag( fd_snapin_tile_t *  ctx,
 
   for(;;) {
     if( FD_UNLIKELY( sz-ctx->in.pos==0UL ) ) break;
+    if( FD_UNLIKELY( !fd_snapin_lthash_credit_ok( ctx ) ) ) break; /* snapla tiles backpressured */
 
     uchar const * data = (uchar const *)fd_chunk_to_laddr_const( ctx->in.wksp, chunk ) + ctx->in.pos;
 
@@ -462,6 +481,7 @@ handle_data_frag( fd_snapin_tile_t *  ctx,
         break;
       }
       case FD_SSPARSE_ADVANCE_STATUS_CACHE: {
+        if( FD_UNLIKELY( ctx->shard.idx ) ) break; /* loaded by shard 0 */
         fd_slot_delta_parser_advance_result_t sd_result[1];
         ulong bytes_remaining = result->status_cache.data_sz;
 
@@ -531,7 +551,7 @@ handle_data_frag( fd_snapin_tile_t *  ctx,
   return reprocess_frag;
 }
 
-static void
+static int
 handle_control_frag( fd_snapin_tile_t *  ctx,
                      fd_stem_context_t * stem,
                      ulong               sig ) {
@@ -544,12 +564,13 @@ handle_control_frag( fd_snapin_tile_t *  ctx,
       ctx->full = sig==FD_SNAPSHOT_MSG_CTRL_INIT_FULL;
       ctx->txncache_entries_len  = 0UL;
       ctx->blockhash_offsets_len = 0UL;
-      fd_txncache_reset( ctx->txncache );
+      if( FD_LIKELY( !ctx->shard.idx ) ) fd_txncache_reset( ctx->txncache );
       fd_ssparse_reset( ctx->ssparse );
-      fd_ssmanifest_parser_init( ctx->manifest_parser, fd_chunk_to_laddr( ctx->manifest_out.mem, ctx->manifest_out.chunk ) );
+      fd_ssmanifest_parser_init( ctx->manifest_parser, manifest_buf( ctx ) );
       fd_slot_delta_parser_init( ctx->slot_delta_parser );
       fd_memset( &ctx->flags,    0, sizeof(ctx->flags)    );
       fd_memset( &ctx->vinyl_op, 0, sizeof(ctx->vinyl_op) );
+      fd_snapin_lthash_reset( ctx );
       if( ctx->use_vinyl ) {
         if( sig==FD_SNAPSHOT_MSG_CTRL_INIT_INCR ) {
           fd_snapin_vinyl_txn_begin( ctx );
@@ -563,6 +584,7 @@ handle_control_frag( fd_snapin_tile_t *  ctx,
                ctx->state==FD_SNAPSHOT_STATE_FINISHING ||
                ctx->state==FD_SNAPSHOT_STATE_ERROR );
       ctx->state = FD_SNAPSHOT_STATE_IDLE;
+      if( FD_UNLIKELY( ctx->shard.idx ) ) break; /* shard 0 rolls back the database */
 
       if( ctx->use_vinyl ) {
         fd_snapin_vinyl_wd_fini( ctx );
@@ -585,9 +607,17 @@ handle_control_frag( fd_snapin_tile_t *  ctx,
                ctx->state==FD_SNAPSHOT_STATE_ERROR );
       if( FD_UNLIKELY( ctx->state!=FD_SNAPSHOT_STATE_FINISHING ) ) {
         transition_malformed( ctx, stem );
-        return;
+        return 0;
+      }
+
+      int lthash_res = fd_snapin_lthash_finish( ctx );
+      if( lthash_res>0 ) return 1; /* wait for snapla tiles */
+      if( FD_UNLIKELY( lthash_res<0 ) ) {
+        transition_malformed( ctx, stem );
+        return 0;
       }
       ctx->state = FD_SNAPSHOT_STATE_IDLE;
+      if( FD_UNLIKELY( ctx->shard.idx ) ) break; /* shard 0 manages funk txns */
 
       if( ctx->use_vinyl ) {
         fd_snapin_vinyl_wd_fini( ctx );
@@ -608,9 +638,17 @@ handle_control_frag( fd_snapin_tile_t *  ctx,
                ctx->state==FD_SNAPSHOT_STATE_ERROR );
       if( FD_UNLIKELY( ctx->state!=FD_SNAPSHOT_STATE_FINISHING ) ) {
         transition_malformed( ctx, stem );
-        return;
+        return 0;
+      }
+
+      int lthash_res = fd_snapin_lthash_finish( ctx );
+      if( lthash_res>0 ) return 1; /* wait for snapla tiles */
+      if( FD_UNLIKELY( lthash_res<0 ) ) {
+        transition_malformed( ctx, stem );
+        return 0;
       }
       ctx->state = FD_SNAPSHOT_STATE_IDLE;
+      if( FD_UNLIKELY( ctx->shard.idx ) ) break; /* shard 0 manages funk txns */
 
       if( ctx->use_vinyl ) {
         fd_snapin_vinyl_wd_fini( ctx );
@@ -646,6 +684,7 @@ handle_control_frag( fd_snapin_tile_t *  ctx,
       ctx->state = FD_SNAPSHOT_STATE_SHUTDOWN;
       metrics_write( ctx ); /* ensures that shutdown state is written to metrics workspace before the tile actually shuts down */
       if( ctx->use_vinyl ) fd_snapin_vinyl_shutdown( ctx );
+      fd_snapin_lthash_shutdown( ctx );
       break;
 
     case FD_SNAPSHOT_MSG_CTRL_ERROR:
@@ -660,16 +699,81 @@ handle_control_frag( fd_snapin_tile_t *  ctx,
 
     default:
       FD_LOG_ERR(( "unexpected control sig %lu", sig ));
-      return;
+      return 0;
   }
 
   /* Forward the control message down the pipeline */
-  fd_stem_publish( stem, ctx->ct_out.idx, sig, 0UL, 0UL, 0UL, 0UL, 0UL );
+  if( FD_LIKELY( !ctx->shard.idx ) ) fd_stem_publish( stem, ctx->ct_out.idx, sig, 0UL, 0UL, 0UL, 0UL, 0UL );
+  return 0;
+}
+
+/* shard_sync_done publishes that shard 0 completed processing a
+   control message. */
+
+static void
+shard_sync_done( fd_snapin_tile_t * ctx ) {
+  ctx->shard.ack_cnt = 0UL;
+  ctx->shard.ctrl_cnt++;
+  fd_fseq_update( ctx->shard.sync, (ctx->shard.ctrl_cnt<<1) | (ulong)( ctx->state==FD_SNAPSHOT_STATE_ERROR ) );
+}
+
+/* shard_ack acknowledges a control message to shard 0, forwarding the
+   partial LtHash sum of this shard after a snapshot completed. */
+
+static void
+shard_ack( fd_snapin_tile_t *  ctx,
+           fd_stem_context_t * stem,
+           ulong               sig ) {
+  ulong sz = 0UL;
+  if( ctx->lthash.enabled && ( sig==FD_SNAPSHOT_MSG_CTRL_NEXT || sig==FD_SNAPSHOT_MSG_CTRL_DONE ) ) {
+    sz = sizeof(fd_lthash_value_t);
+    memcpy( fd_chunk_to_laddr( ctx->sh_out.mem, ctx->sh_out.chunk ), ctx->lthash.sum, sz );
+  }
+  fd_stem_publish( stem, ctx->sh_out.idx, sig, ctx->sh_out.chunk, sz, 0UL, 0UL, 0UL );
+  ctx->sh_out.chunk = fd_dcache_compact_next( ctx->sh_out.chunk, sz, ctx->sh_out.chunk0, ctx->sh_out.wmark );
+  ctx->shard.acked = 1;
+}
+
+/* shard_follow waits until shard 0 completed processing the current
+   control message and adopts its outcome.  Returns 1 if still waiting,
+   0 otherwise. */
+
+static int
+shard_follow( fd_snapin_tile_t * ctx,
+              ulong              sig ) {
+  ulong sync = fd_fseq_query( ctx->shard.sync );
+  if( sync==ULONG_MAX || (sync>>1)<=ctx->shard.ctrl_cnt ) return 1;
+  FD_TEST( (sync>>1)==ctx->shard.ctrl_cnt+1UL );
+  ctx->shard.ctrl_cnt++;
+  ctx->shard.acked = 0;
+
+  if( FD_UNLIKELY( sync&1UL ) ) {
+    ctx->state = FD_SNAPSHOT_STATE_ERROR;
+    return 0;
+  }
+
+  /* Track the funk txn that shard 0 inserts into */
+  switch( sig ) {
+    case FD_SNAPSHOT_MSG_CTRL_FAIL:
+      if( !ctx->full ) fd_funk_txn_xid_copy( ctx->xid, fd_funk_last_publish( ctx->accdb_admin->funk ) );
+      break;
+    case FD_SNAPSHOT_MSG_CTRL_NEXT: {
+      fd_funk_txn_xid_t incremental_xid = { .ul={ LONG_MAX, LONG_MAX } };
+      fd_funk_txn_xid_copy( ctx->xid, &incremental_xid );
+      break;
+    }
+    case FD_SNAPSHOT_MSG_CTRL_DONE:
+      fd_funk_txn_xid_copy( ctx->xid, fd_funk_last_publish( ctx->accdb_admin->funk ) );
+      break;
+    default:
+      break;
+  }
+  return 0;
 }
 
 static inline int
 returnable_frag( fd_snapin_tile_t *  ctx,
-                 ulong               in_idx FD_PARAM_UNUSED,
+                 ulong               in_idx,
                  ulong               seq    FD_PARAM_UNUSED,
                  ulong               sig,
                  ulong               chunk,
@@ -678,14 +782,37 @@ returnable_frag( fd_snapin_tile_t *  ctx,
                  ulong               tsorig FD_PARAM_UNUSED,
                  ulong               tspub  FD_PARAM_UNUSED,
                  fd_stem_context_t * stem ) {
-  FD_TEST( ctx->state!=FD_SNAPSHOT_STATE_SHUTDOWN );
+  /* All ins except the first one carry partial LtHash sums from
+     snapla tiles, or control message acks from other shards */
+  if( FD_UNLIKELY( in_idx ) ) {
+    if( sz ) fd_snapin_lthash_result( ctx, chunk );
+    if( ctx->shard.cnt>1UL ) ctx->shard.ack_cnt++;
+    return 0;
+  }
 
   ctx->stem = stem;
-  if( FD_UNLIKELY( sig==FD_SNAPSHOT_MSG_DATA ) ) return handle_data_frag( ctx, chunk, sz, stem );
-  else                                           handle_control_frag( ctx, stem, sig );
+  if( FD_UNLIKELY( sig==FD_SNAPSHOT_MSG_DATA ) ) {
+    FD_TEST( ctx->state!=FD_SNAPSHOT_STATE_SHUTDOWN );
+    return handle_data_frag( ctx, chunk, sz, stem );
+  }
+
+  if( FD_UNLIKELY( ctx->shard.idx ) ) {
+    if( !ctx->shard.acked ) {
+      FD_TEST( ctx->state!=FD_SNAPSHOT_STATE_SHUTDOWN );
+      FD_TEST( !handle_control_frag( ctx, stem, sig ) );
+      shard_ack( ctx, stem, sig );
+    }
+    return shard_follow( ctx, sig );
+  }
+
+  FD_TEST( ctx->state!=FD_SNAPSHOT_STATE_SHUTDOWN );
+  if( FD_UNLIKELY( ctx->shard.ack_cnt<ctx->shard.cnt-1UL ) ) return 1; /* wait for other shards */
+  if( FD_UNLIKELY( !fd_snapin_lthash_credit_ok( ctx ) ) ) return 1;
+  int reprocess_frag = handle_control_frag( ctx, stem, sig );
   ctx->stem = NULL;
+  if( !reprocess_frag && ctx->shard.cnt>1UL ) shard_sync_done( ctx );
 
-  return 0;
+  return reprocess_frag;
 }
 
 static ulong
@@ -761,6 +888,9 @@ unprivileged_init( fd_topo_t *      topo,
   void * _sd_parser       = FD_SCRATCH_ALLOC_APPEND( l, fd_slot_delta_parser_align(),  fd_slot_delta_parser_footprint()                              );
   ctx->txncache_entries   = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_sstxncache_entry_t), sizeof(fd_sstxncache_entry_t)*FD_SNAPIN_TXNCACHE_MAX_ENTRIES );
   ctx->blockhash_offsets  = FD_SCRATCH_ALLOC_APPEND( l, alignof(blockhash_group_t),     sizeof(blockhash_group_t)*FD_SNAPIN_MAX_SLOT_DELTA_GROUPS    );
+  if( tile->kind_id ) {
+    ctx->shard.manifest   = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_snapshot_manifest_t), sizeof(fd_snapshot_manifest_t) );
+  }
   void * _io_wd = NULL;
   void * _io_mm = NULL;
   if( tile->snapin.use_vinyl ) {
@@ -776,11 +906,13 @@ unprivileged_init( fd_topo_t *      topo,
   FD_TEST( fd_accdb_admin_join( ctx->accdb_admin, fd_topo_obj_laddr( topo, tile->snapin.funk_obj_id ) ) );
   fd_funk_txn_xid_copy( ctx->xid, fd_funk_root( ctx->accdb_admin->funk ) );
 
-  void * _txncache_shmem = fd_topo_obj_laddr( topo, tile->snapin.txncache_obj_id );
-  fd_txncache_shmem_t * txncache_shmem = fd_txncache_shmem_join( _txncache_shmem );
-  FD_TEST( txncache_shmem );
-  ctx->txncache = fd_txncache_join( fd_txncache_new( _txncache, txncache_shmem ) );
-  FD_TEST( ctx->txncache );
+  if( FD_LIKELY( !tile->kind_id ) ) {
+    void * _txncache_shmem = fd_topo_obj_laddr( topo, tile->snapin.txncache_obj_id );
+    fd_txncache_shmem_t * txncache_shmem = fd_txncache_shmem_join( _txncache_shmem );
+    FD_TEST( txncache_shmem );
+    ctx->txncache = fd_txncache_join( fd_txncache_new( _txncache, txncache_shmem ) );
+    FD_TEST( ctx->txncache );
+  }
 
   ctx->txncache_entries_len = 0UL;
   ctx->blockhash_offsets_len = 0UL;
@@ -796,18 +928,62 @@ unprivileged_init( fd_topo_t *      topo,
 
   fd_memset( &ctx->metrics, 0, sizeof(ctx->metrics) );
 
-  if( FD_UNLIKELY( tile->kind_id ) ) FD_LOG_ERR(( "There can only be one `" NAME "` tile" ));
-  if( FD_UNLIKELY( tile->in_cnt!=1UL ) ) FD_LOG_ERR(( "tile `" NAME "` has %lu ins, expected 1", tile->in_cnt ));
+  ulong la_tile_cnt = fd_topo_tile_name_cnt( topo, "snapla" );
+  ulong shard_cnt   = fd_topo_tile_name_cnt( topo, NAME     );
+  ulong in_cnt      = tile->kind_id ? 1UL : la_tile_cnt+shard_cnt;
+  if( FD_UNLIKELY( shard_cnt>1UL && la_tile_cnt ) ) FD_LOG_ERR(( "`snapla` tiles are not supported with multiple `" NAME "` tiles" ));
+  if( FD_UNLIKELY( shard_cnt>1UL && tile->snapin.use_vinyl ) ) FD_LOG_ERR(( "multiple `" NAME "` tiles are not supported with vinyl" ));
+  if( FD_UNLIKELY( tile->in_cnt!=in_cnt ) ) FD_LOG_ERR(( "tile `" NAME "` has %lu ins, expected %lu", tile->in_cnt, in_cnt ));
+  if( FD_UNLIKELY( strcmp( topo->links[ tile->in_link_id[ 0UL ] ].name, "snapdc_in" ) ) ) FD_LOG_ERR(( "tile `" NAME "` first in link must be `snapdc_in`" ));
 
   ctx->ct_out       = out1( topo, tile, "snapin_ct"    );
   ctx->manifest_out = out1( topo, tile, "snapin_manif" );
   ctx->gui_out      = out1( topo, tile, "snapin_gui"   );
+  ctx->la_out       = out1( topo, tile, "snapin_la"    );
+  ctx->sh_out       = out1( topo, tile, "snapin_sh"    );
+
+  ctx->shard.cnt        = shard_cnt;
+  ctx->shard.idx        = tile->kind_id;
+  ctx->shard.chain_mask = ctx->accdb_admin->funk->rec_map->map->chain_cnt-1UL;
+  ctx->shard.map_seed   = ctx->accdb_admin->funk->rec_map->map->seed;
+  if( shard_cnt>1UL ) {
+    ulong sync_obj_id = fd_pod_query_ulong( topo->props, "snapin_sync", ULONG_MAX );
+    FD_TEST( sync_obj_id!=ULONG_MAX );
+    ctx->shard.sync = fd_fseq_join( fd_topo_obj_laddr( topo, sync_obj_id ) );
+    FD_TEST( ctx->shard.sync );
+  }
+
+  ctx->lthash.enabled  = la_tile_cnt || shard_cnt>1UL;
+  ctx->lthash.tile_cnt = la_tile_cnt;
+  if( la_tile_cnt ) {
+    if( FD_UNLIKELY( tile->snapin.use_vinyl ) ) FD_LOG_ERR(( "tile `" NAME "` does not support lthash verification with vinyl" ));
+    if( FD_UNLIKELY( ctx->la_out.idx==ULONG_MAX ) ) FD_LOG_ERR(( "tile `" NAME "` missing required out link `snapin_la`" ));
+    if( FD_UNLIKELY( ctx->la_out.mtu<=sizeof(fd_snapla_acc_hdr_t) ) ) FD_LOG_ERR(( "link `snapin_la` mtu %lu too small", ctx->la_out.mtu ));
+  }
+  for( ulong i=1UL; i<tile->in_cnt; i++ ) {
+    fd_topo_link_t const * in_link = &topo->links[ tile->in_link_id[ i ] ];
+    fd_wksp_t * in_wksp = topo->workspaces[ topo->objs[ in_link->dcache_obj_id ].wksp_id ].wksp;
+    if( FD_UNLIKELY( strcmp( in_link->name, la_tile_cnt ? "snapla_in" : "snapin_sh" ) ) ) FD_LOG_ERR(( "tile `" NAME "` has unexpected in link `%s`", in_link->name ));
+    if( FD_UNLIKELY( ctx->lthash.in_wksp && ctx->lthash.in_wksp!=in_wksp ) ) FD_LOG_ERR(( "`%s` links must share a workspace", in_link->name ));
+    ctx->lthash.in_wksp = in_wksp;
+  }
+  if( ctx->lthash.enabled ) {
+    FD_TEST( fd_lthash_adder_new( ctx->lthash.add_adder ) );
+    FD_TEST( fd_lthash_adder_new( ctx->lthash.sub_adder ) );
+    fd_lthash_zero( ctx->lthash.sum       );
+    fd_lthash_zero( ctx->lthash.sub       );
+    fd_lthash_zero( ctx->lthash.committed );
+  }
 
-  if( FD_UNLIKELY( ctx->ct_out.idx==ULONG_MAX ) )       FD_LOG_ERR(( "tile `" NAME "` missing required out link `snapin_ct`"    ));
-  if( FD_UNLIKELY( ctx->manifest_out.idx==ULONG_MAX ) ) FD_LOG_ERR(( "tile `" NAME "` missing required out link `snapin_manif`" ));
+  if( FD_LIKELY( !tile->kind_id ) ) {
+    if( FD_UNLIKELY( ctx->ct_out.idx==ULONG_MAX ) )       FD_LOG_ERR(( "tile `" NAME "` missing required out link `snapin_ct`"    ));
+    if( FD_UNLIKELY( ctx->manifest_out.idx==ULONG_MAX ) ) FD_LOG_ERR(( "tile `" NAME "` missing required out link `snapin_manif`" ));
+  } else {
+    if( FD_UNLIKELY( ctx->sh_out.idx==ULONG_MAX ) )       FD_LOG_ERR(( "tile `" NAME "` missing required out link `snapin_sh`"    ));
+  }
 
   fd_ssparse_reset( ctx->ssparse );
-  fd_ssmanifest_parser_init( ctx->manifest_parser, fd_chunk_to_laddr( ctx->manifest_out.mem, ctx->manifest_out.chunk ) );
+  fd_ssmanifest_parser_init( ctx->manifest_parser, manifest_buf( ctx ) );
   fd_slot_delta_parser_init( ctx->slot_delta_parser );
 
   fd_topo_link_t const * in_link = &topo->links[ tile->in_link_id[ 0UL ] ];
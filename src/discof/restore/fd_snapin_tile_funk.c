@@ -8,6 +8,11 @@ fd_snapin_process_account_header_funk( fd_snapin_tile_t *            ctx,
                                        fd_ssparse_advance_result_t * result ) {
   fd_funk_t * funk = ctx->accdb_admin->funk;
 
+  if( FD_UNLIKELY( !fd_snapin_shard_owns( ctx, result->account_header.pubkey ) ) ) {
+    ctx->acc_data = NULL;
+    return;
+  }
+
   fd_funk_rec_key_t id = FD_LOAD( fd_funk_rec_key_t, result->account_header.pubkey );
   fd_funk_rec_query_t query[1];
   fd_funk_rec_t * rec = fd_funk_rec_query_try( funk, ctx->xid, &id, query );
@@ -16,6 +21,16 @@ fd_snapin_process_account_header_funk( fd_snapin_tile_t *            ctx,
   fd_funk_rec_prepare_t prepare[1];
   if( FD_LIKELY( !rec ) ) {
     should_publish = 1;
+
+    /* An incremental snapshot shadows the account version loaded from
+       the full snapshot */
+    if( !ctx->full ) {
+      fd_funk_rec_query_t   query_global[1];
+      fd_funk_rec_t const * prev = fd_funk_rec_query_try_global( funk, ctx->xid, &id, NULL, query_global );
+      fd_account_meta_t const * prev_meta = prev ? fd_funk_val_const( prev, funk->wksp ) : NULL;
+      if( prev_meta ) fd_snapin_lthash_sub( ctx, result->account_header.pubkey, prev_meta );
+    }
+
     rec = fd_funk_rec_prepare( funk, ctx->xid, &id, prepare, NULL );
     FD_TEST( rec );
   }
@@ -27,9 +42,9 @@ fd_snapin_process_account_header_funk( fd_snapin_tile_t *            ctx,
       return;
     }
 
-    /* TODO: Reaching here means the existing value is a duplicate
-       account.  We need to hash the existing account and subtract that
-       hash from the running lthash. */
+    /* Reaching here means the existing value is a duplicate account
+       that is about to be replaced. */
+    fd_snapin_lthash_sub( ctx, result->account_header.pubkey, meta );
   }
 
   /* Allocate data space from heap, free old value (if any) */
@@ -52,6 +67,8 @@ fd_snapin_process_account_header_funk( fd_snapin_tile_t *            ctx,
   ctx->acc_data = (uchar*)meta + sizeof(fd_account_meta_t);
   ctx->metrics.accounts_inserted++;
 
+  fd_snapin_lthash_add_begin( ctx, result->account_header.pubkey, meta );
+
   if( FD_LIKELY( should_publish ) ) fd_funk_rec_publish( funk, prepare );
 }
 
@@ -62,6 +79,8 @@ fd_snapin_process_account_data_funk( fd_snapin_tile_t *            ctx,
 
   fd_memcpy( ctx->acc_data, result->account_data.data, result->account_data.data_sz );
   ctx->acc_data += result->account_data.data_sz;
+
+  fd_snapin_lthash_add_data( ctx, result->account_data.data, result->account_data.data_sz );
 }
 
 /* streamlined_insert inserts an unfragmented account.
@@ -102,6 +121,9 @@ streamlined_insert( fd_snapin_tile_t * ctx,
   fd_memcpy( acc_data, frame+0x88UL, data_len );
 
   ctx->metrics.accounts_inserted++;
+
+  fd_snapin_lthash_add_begin( ctx, frame+0x10UL, meta );
+  fd_snapin_lthash_add_data ( ctx, frame+0x88UL, data_len );
 }
 
 /* process_account_batch is a happy path performance optimization
@@ -118,22 +140,42 @@ fd_snapin_process_account_batch_funk( fd_snapin_tile_t *            ctx,
   fd_funk_rec_t *     rec_tbl = funk->rec_pool->ele;
   fd_funk_rec_map_shmem_private_chain_t * chain_tbl = fd_funk_rec_map_shmem_private_chain( rec_map->map, 0UL );
 
-  /* Derive map chains */
+  /* Derive map chains.  Chains owned by other shards are concurrently
+     modified and must not be accessed. */
   uint chain_idx[ FD_SSPARSE_ACC_BATCH_MAX ];
+  int  owned    [ FD_SSPARSE_ACC_BATCH_MAX ];
   ulong chain_mask = rec_map->map->chain_cnt-1UL;
   for( ulong i=0UL; i<FD_SSPARSE_ACC_BATCH_MAX; i++ ) {
     uchar const * frame  = result->account_batch.batch[ i ];
     uchar const * pubkey = frame+0x10UL;
     ulong         memo   = fd_funk_rec_key_hash1( pubkey, rec_map->map->seed );
     chain_idx[ i ] = (uint)( memo&chain_mask );
+    owned    [ i ] = fd_snapin_shard_chain_owned( ctx, chain_idx[ i ] );
+  }
+
+  /* A key could appear twice in the same batch.  All accounts in a
+     batch are from the same slot, so like in the non-batched path the
+     later version replaces the earlier one.  Skip all but the last
+     occurrence (like accounts of chains owned by other shards), such
+     that every key gets one record and is mixed into the LtHash once. */
+  for( ulong i=0UL; i<FD_SSPARSE_ACC_BATCH_MAX; i++ ) {
+    if( !owned[ i ] ) continue;
+    uchar const * pubkey = result->account_batch.batch[ i ]+0x10UL;
+    for( ulong j=i+1UL; j<FD_SSPARSE_ACC_BATCH_MAX; j++ ) {
+      if( FD_UNLIKELY( chain_idx[ j ]==chain_idx[ i ] &&
+                       0==memcmp( result->account_batch.batch[ j ]+0x10UL, pubkey, sizeof(fd_funk_rec_key_t) ) ) ) {
+        owned[ i ] = 0;
+        break;
+      }
+    }
   }
 
   /* Parallel load hash chain heads */
   uint map_node [ FD_SSPARSE_ACC_BATCH_MAX ];
   uint chain_cnt[ FD_SSPARSE_ACC_BATCH_MAX ];
   for( ulong i=0UL; i<FD_SSPARSE_ACC_BATCH_MAX; i++ ) {
-    map_node [ i ] =       chain_tbl[ chain_idx[ i ] ].head_cidx;
-    chain_cnt[ i ] = (uint)chain_tbl[ chain_idx[ i ] ].ver_cnt;
+    map_node [ i ] = owned[ i ] ?       chain_tbl[ chain_idx[ i ] ].head_cidx : UINT_MAX;
+    chain_cnt[ i ] = owned[ i ] ? (uint)chain_tbl[ chain_idx[ i ] ].ver_cnt   : 0U;
   }
   uint chain_max = 0U;
   for( ulong i=0UL; i<FD_SSPARSE_ACC_BATCH_MAX; i++ ) {
@@ -157,13 +199,14 @@ fd_snapin_process_account_batch_funk( fd_snapin_tile_t *            ctx,
 
   /* Create map entries */
   for( ulong i=0UL; i<FD_SSPARSE_ACC_BATCH_MAX; i++ ) {
+    if( !owned[ i ] ) continue;
     uchar const * frame  = result->account_batch.batch[ i ];
     uchar const * pubkey = frame+0x10UL;
     fd_funk_rec_key_t key = FD_LOAD( fd_funk_rec_key_t, pubkey );
 
     fd_funk_rec_t * r = rec[ i ];
     if( FD_LIKELY( !r ) ) {  /* optimize for new account */
-      r = fd_funk_rec_pool_acquire( funk->rec_pool, NULL, 0, NULL );
+      r = fd_funk_rec_pool_acquire( funk->rec_pool, NULL, 1, NULL ); /* shared with other shards */
       FD_TEST( r );
       memset( r, 0, sizeof(fd_funk_rec_t) );
       fd_funk_txn_xid_copy( r->pair.xid, ctx->xid );
@@ -171,10 +214,7 @@ fd_snapin_process_account_batch_funk( fd_snapin_tile_t *            ctx,
       r->prev_idx = UINT_MAX;
       r->next_idx = UINT_MAX;
 
-      /* Insert to hash map.  In theory, a key could appear twice in the
-         same batch.  All accounts in a batch are guaranteed to be from
-         the same slot though, so this is fine, assuming that accdb code
-         gracefully handles duplicate hash map entries. */
+      /* Insert to hash map */
       fd_funk_rec_map_shmem_private_chain_t * chain = &chain_tbl[ chain_idx[ i ] ];
       ulong ver_cnt    = chain->ver_cnt;
       uint  head_cidx  = chain->head_cidx;
@@ -188,6 +228,8 @@ fd_snapin_process_account_batch_funk( fd_snapin_tile_t *            ctx,
       FD_TEST( existing );
       if( existing->slot > result->account_batch.slot ) {
         rec[ i ] = NULL;  /* skip record if existing value is newer */
+      } else {
+        fd_snapin_lthash_sub( ctx, pubkey, existing );
       }
     }
   }
@@ -0,0 +1,200 @@
+/* fd_snapin_tile_lthash.c contains APIs to verify the accounts LtHash
+   of a snapshot while it is loaded (see fd_snapla_tile.h and the
+   sharding notes in fd_snapin_tile_private.h). */
+
+#include "fd_snapin_tile_private.h"
+#include "fd_snapla_tile.h"
+#include "../../ballet/blake3/fd_blake3.h"
+
+/* la_publish publishes the current snapin_la frag (if non-empty).  The
+   next frag goes to the next snapla tile, unless the current record
+   continues in the next frag. */
+
+static void
+la_publish( fd_snapin_tile_t * ctx ) {
+  ulong sz = ctx->lthash.pos;
+  if( FD_UNLIKELY( !sz ) ) return;
+
+  fd_stem_publish( ctx->stem, ctx->la_out.idx, fd_snapla_sig( FD_SNAPLA_MSG_DATA, ctx->lthash.target ), ctx->la_out.chunk, sz, 0UL, 0UL, 0UL );
+  ctx->la_out.chunk = fd_dcache_compact_next( ctx->la_out.chunk, sz, ctx->la_out.chunk0, ctx->la_out.wmark );
+  ctx->lthash.pos   = 0UL;
+
+  if( FD_LIKELY( !ctx->lthash.rec_rem ) ) {
+    ctx->lthash.target++;
+    if( ctx->lthash.target>=ctx->lthash.tile_cnt ) ctx->lthash.target = 0UL; /* cmov */
+  }
+}
+
+static void
+la_append( fd_snapin_tile_t * ctx,
+           void const *       data,
+           ulong              data_sz ) {
+  uchar const * p = data;
+  while( data_sz ) {
+    uchar * dst = (uchar *)fd_chunk_to_laddr( ctx->la_out.mem, ctx->la_out.chunk ) + ctx->lthash.pos;
+    ulong   cp  = fd_ulong_min( data_sz, ctx->la_out.mtu-ctx->lthash.pos );
+    fd_memcpy( dst, p, cp );
+    p                   += cp;
+    data_sz             -= cp;
+    ctx->lthash.pos     += cp;
+    ctx->lthash.rec_rem -= cp;
+    if( ctx->lthash.pos==ctx->la_out.mtu ) la_publish( ctx );
+  }
+}
+
+static void
+la_broadcast( fd_snapin_tile_t * ctx,
+              ulong              type ) {
+  fd_stem_publish( ctx->stem, ctx->la_out.idx, fd_snapla_sig( type, 0UL ), 0UL, 0UL, 0UL, 0UL, 0UL );
+}
+
+void
+fd_snapin_lthash_reset( fd_snapin_tile_t * ctx ) {
+  if( !ctx->lthash.enabled ) return;
+
+  /* committed stays zero on shards other than 0 */
+  if( ctx->full ) fd_lthash_zero( ctx->lthash.committed );
+  fd_lthash_adder_flush( ctx->lthash.add_adder, ctx->lthash.sum );
+  memcpy( ctx->lthash.sum, ctx->lthash.committed, sizeof(fd_lthash_value_t) );
+  fd_lthash_adder_flush( ctx->lthash.sub_adder, ctx->lthash.sub );
+  fd_lthash_zero( ctx->lthash.sub );
+  ctx->lthash.meta = NULL;
+
+  ctx->lthash.target       = 0UL;
+  ctx->lthash.pos          = 0UL;
+  ctx->lthash.rec_rem      = 0UL;
+  ctx->lthash.finish_sent  = 0;
+  ctx->lthash.pending      = 0UL;
+  ctx->lthash.has_expected = 0;
+
+  if( ctx->lthash.tile_cnt ) la_broadcast( ctx, FD_SNAPLA_MSG_RESET );
+}
+
+/* add_inline hashes the account version being inserted once all of
+   its data was copied into the database. */
+
+static void
+add_inline( fd_snapin_tile_t * ctx ) {
+  fd_account_meta_t const * meta = ctx->lthash.meta;
+  fd_lthash_adder_push_solana_account( ctx->lthash.add_adder, ctx->lthash.sum, ctx->lthash.pubkey, (uchar const *)( meta+1 ), meta->dlen, meta->lamports, meta->executable, meta->owner );
+  ctx->lthash.meta = NULL;
+}
+
+void
+fd_snapin_lthash_add_begin( fd_snapin_tile_t *        ctx,
+                            void const *              pubkey,
+                            fd_account_meta_t const * meta ) {
+  if( !ctx->lthash.enabled ) return;
+  /* Zero-lamport accounts do not contribute to the LtHash */
+  if( !meta->lamports ) return;
+
+  if( !ctx->lthash.tile_cnt ) {
+    memcpy( ctx->lthash.pubkey, pubkey, 32UL );
+    ctx->lthash.meta    = meta;
+    ctx->lthash.rec_rem = meta->dlen;
+    if( !meta->dlen ) add_inline( ctx );
+    return;
+  }
+
+  ulong rec_sz = sizeof(fd_snapla_acc_hdr_t)+meta->dlen;
+  if( rec_sz>ctx->la_out.mtu-ctx->lthash.pos ) la_publish( ctx );
+
+  fd_snapla_acc_hdr_t hdr = {
+    .lamports   = meta->lamports,
+    .data_sz    = meta->dlen,
+    .executable = !!meta->executable
+  };
+  memcpy( hdr.pubkey, pubkey,      32UL );
+  memcpy( hdr.owner,  meta->owner, 32UL );
+
+  ctx->lthash.rec_rem = rec_sz;
+  la_append( ctx, &hdr, sizeof(fd_snapla_acc_hdr_t) );
+}
+
+void
+fd_snapin_lthash_add_data( fd_snapin_tile_t * ctx,
+                           void const *       data,
+                           ulong              data_sz ) {
+  if( !ctx->lthash.rec_rem ) return;
+  FD_CRIT( data_sz<=ctx->lthash.rec_rem, "account data overflow" );
+  if( !ctx->lthash.tile_cnt ) {
+    ctx->lthash.rec_rem -= data_sz;
+    if( !ctx->lthash.rec_rem ) add_inline( ctx );
+    return;
+  }
+  la_append( ctx, data, data_sz );
+}
+
+void
+fd_snapin_lthash_sub( fd_snapin_tile_t *        ctx,
+                      void const *              pubkey,
+                      fd_account_meta_t const * meta ) {
+  if( !ctx->lthash.enabled ) return;
+  if( !meta->lamports ) return;
+
+  /* Replaced versions are rare compared to inserted ones, so they are
+     hashed here rather than streamed to snapla tiles.  This also keeps
+     the number of snapin_la frags published per parse step bounded. */
+  fd_lthash_adder_push_solana_account( ctx->lthash.sub_adder, ctx->lthash.sub, pubkey, (uchar const *)( meta+1 ), meta->dlen, meta->lamports, meta->executable, meta->owner );
+}
+
+void
+fd_snapin_lthash_result( fd_snapin_tile_t * ctx,
+                         ulong              chunk ) {
+  fd_lthash_value_t const * partial = fd_chunk_to_laddr_const( ctx->lthash.in_wksp, chunk );
+  fd_lthash_add( ctx->lthash.sum, partial );
+  if( ctx->lthash.tile_cnt ) {
+    FD_TEST( ctx->lthash.pending );
+    ctx->lthash.pending--;
+  }
+}
+
+int
+fd_snapin_lthash_finish( fd_snapin_tile_t * ctx ) {
+  if( !ctx->lthash.enabled ) return 0;
+
+  if( ctx->lthash.tile_cnt && !ctx->lthash.finish_sent ) {
+    FD_TEST( !ctx->lthash.rec_rem );
+    la_publish( ctx );
+    la_broadcast( ctx, FD_SNAPLA_MSG_FINISH );
+    ctx->lthash.finish_sent = 1;
+    ctx->lthash.pending     = ctx->lthash.tile_cnt;
+    return 1;
+  }
+  if( ctx->lthash.pending ) return 1;
+  ctx->lthash.finish_sent = 0;
+
+  FD_TEST( !ctx->lthash.rec_rem );
+  fd_lthash_adder_flush( ctx->lthash.add_adder, ctx->lthash.sum );
+  fd_lthash_adder_flush( ctx->lthash.sub_adder, ctx->lthash.sub );
+  fd_lthash_sub( ctx->lthash.sum, ctx->lthash.sub );
+  fd_lthash_zero( ctx->lthash.sub );
+
+  /* Other shards report their partial sum to shard 0 */
+  if( ctx->shard.idx ) return 0;
+
+  uchar hash32[ 32 ]; fd_blake3_hash( ctx->lthash.sum->bytes, FD_LTHASH_LEN_BYTES, hash32 );
+  FD_BASE58_ENCODE_32_BYTES( hash32, hash32_enc );
+
+  if( FD_UNLIKELY( !ctx->lthash.has_expected ) ) {
+    FD_LOG_NOTICE(( "snapshot manifest slot=%lu has no accounts lthash, skipping verification (computed blake3(lthash)=%s)",
+                    ctx->bank_slot, hash32_enc ));
+  } else if( FD_UNLIKELY( !fd_memeq( ctx->lthash.sum->bytes, ctx->lthash.expected, FD_LTHASH_LEN_BYTES ) ) ) {
+    uchar expected32[ 32 ]; fd_blake3_hash( ctx->lthash.expected, FD_LTHASH_LEN_BYTES, expected32 );
+    FD_BASE58_ENCODE_32_BYTES( expected32, expected32_enc );
+    FD_LOG_WARNING(( "snapshot slot=%lu accounts lthash mismatch: blake3(lthash) computed=%s manifest=%s",
+                     ctx->bank_slot, hash32_enc, expected32_enc ));
+    return -1;
+  } else {
+    FD_LOG_NOTICE(( "verified accounts lthash of snapshot slot=%lu blake3(lthash)=%s", ctx->bank_slot, hash32_enc ));
+  }
+
+  memcpy( ctx->lthash.committed, ctx->lthash.sum, sizeof(fd_lthash_value_t) );
+  return 0;
+}
+
+void
+fd_snapin_lthash_shutdown( fd_snapin_tile_t * ctx ) {
+  if( !ctx->lthash.tile_cnt ) return;
+  la_broadcast( ctx, FD_SNAPLA_MSG_SHUTDOWN );
+}
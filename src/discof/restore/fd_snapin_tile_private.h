@@ -10,6 +10,7 @@
 #include "utils/fd_slot_delta_parser.h"
 #include "../../flamenco/accdb/fd_accdb_admin.h"
 #include "../../flamenco/runtime/fd_txncache.h"
+#include "../../ballet/lthash/fd_lthash_adder.h"
 #include "../../disco/stem/fd_stem.h"
 #include "../../disco/topo/fd_topo.h"
 #include "../../vinyl/io/fd_vinyl_io.h"
@@ -86,6 +87,63 @@ struct fd_snapin_tile {
   fd_snapin_out_link_t ct_out;
   fd_snapin_out_link_t manifest_out;
   fd_snapin_out_link_t gui_out;
+  fd_snapin_out_link_t la_out;
+  fd_snapin_out_link_t sh_out;
+
+  /* Horizontal sharding of account insertion across multiple snapin
+     tiles (see fd_snapin_shard_owns).  Every shard parses the full
+     snapshot stream, but only inserts accounts that hash to a funk
+     rec_map chain owned by it.  Shard 0 handles the manifest, the
+     status cache, funk txns and control messages downstream.  At every
+     control message, shards 1..cnt-1 publish an ack to shard 0 (on
+     their snapin_sh link) and then wait until shard 0 finished
+     processing the message (sync fseq). */
+
+  struct {
+    ulong   cnt;        /* number of snapin tiles */
+    ulong   idx;        /* shard index (tile kind_id) */
+    ulong   chain_mask; /* funk rec_map chain_cnt-1 */
+    ulong   map_seed;   /* funk rec_map hash seed */
+
+    ulong * sync;       /* (ctrl_cnt<<1)|error, written by shard 0 */
+    ulong   ctrl_cnt;   /* control messages completed */
+    ulong   ack_cnt;    /* (shard 0) acks received for current control message */
+    int     acked;      /* (other shards) ack published for current control message */
+
+    fd_snapshot_manifest_t * manifest; /* (other shards) manifest parser scratch */
+  } shard;
+
+  /* Accounts LtHash verification.  With snapla tiles (tile_cnt>0),
+     inserted account versions are streamed to snapla tiles (see
+     fd_snapla_tile.h).  With multiple shards, every shard hashes the
+     accounts it inserted inline and reports a partial sum to shard 0.
+     Disabled if neither is the case. */
+
+  struct {
+    int   enabled;
+    ulong tile_cnt;    /* number of snapla tiles */
+    ulong target;      /* snapla tile receiving the current frag */
+    ulong pos;         /* bytes written to the current frag */
+    ulong rec_rem;     /* bytes of the current record not yet written */
+
+    int   finish_sent; /* FINISH published, waiting for partial sums */
+    ulong pending;     /* number of partial sums outstanding */
+
+    fd_wksp_t * in_wksp; /* workspace of snapla_in links */
+
+    int   has_expected;
+    uchar expected[ FD_LTHASH_LEN_BYTES ];
+
+    /* account version being inserted (inline hashing only) */
+    uchar                     pubkey[ 32 ];
+    fd_account_meta_t const * meta;
+
+    fd_lthash_adder_t add_adder[1]; /* inline hashing only */
+    fd_lthash_adder_t sub_adder[1];
+    fd_lthash_value_t sum[1];       /* sum of snapshots loaded so far */
+    fd_lthash_value_t sub[1];       /* replaced account versions */
+    fd_lthash_value_t committed[1]; /* sum at end of full snapshot */
+  } lthash;
 
   struct {
     uchar * bstream_mem;
@@ -117,6 +175,35 @@ struct fd_snapin_tile {
 
 typedef struct fd_snapin_tile fd_snapin_tile_t;
 
+/* Sharding APIs ******************************************************/
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_snapin_shard_chain_owned returns 1 if the funk rec_map chain with
+   index chain_idx is owned by this snapin tile, 0 otherwise.  Chains
+   are assigned round robin, so each shard exclusively writes a
+   disjoint subset of rec_map chains.  All versions of an account map
+   to the same chain, so duplicate resolution remains shard local. */
+
+static inline int
+fd_snapin_shard_chain_owned( fd_snapin_tile_t const * ctx,
+                             ulong                    chain_idx ) {
+  return ctx->shard.cnt==1UL || (chain_idx%ctx->shard.cnt)==ctx->shard.idx;
+}
+
+/* fd_snapin_shard_owns returns 1 if the account with the given pubkey
+   is inserted by this snapin tile, 0 otherwise. */
+
+static inline int
+fd_snapin_shard_owns( fd_snapin_tile_t const * ctx,
+                      void const *             pubkey ) {
+  if( FD_LIKELY( ctx->shard.cnt==1UL ) ) return 1;
+  ulong chain_idx = fd_funk_rec_key_hash1( pubkey, ctx->shard.map_seed ) & ctx->shard.chain_mask;
+  return fd_snapin_shard_chain_owned( ctx, chain_idx );
+}
+
+FD_PROTOTYPES_END
+
 /* Funk APIs **********************************************************/
 
 FD_PROTOTYPES_BEGIN
@@ -134,6 +221,78 @@ fd_snapin_read_account_funk( fd_snapin_tile_t *  ctx,
 
 FD_PROTOTYPES_END
 
+/* LtHash APIs ********************************************************/
+
+FD_PROTOTYPES_BEGIN
+
+/* FD_SNAPIN_LA_BURST is the number of snapin_la credits required
+   before parsing more snapshot data.  Parsing one chunk of data (at
+   most the snapin_la mtu) publishes at most 2 frags. */
+
+#define FD_SNAPIN_LA_BURST (4UL)
+
+/* fd_snapin_lthash_reset prepares LtHash accumulation for a new
+   snapshot and instructs snapla tiles (if any) to discard partial
+   results. */
+
+void
+fd_snapin_lthash_reset( fd_snapin_tile_t * ctx );
+
+/* fd_snapin_lthash_credit_ok returns 1 if the snapin_la link has
+   enough credits to process another chunk of data, 0 otherwise. */
+
+static inline int
+fd_snapin_lthash_credit_ok( fd_snapin_tile_t const * ctx ) {
+  return !ctx->lthash.tile_cnt || ctx->stem->cr_avail[ ctx->la_out.idx ]>=FD_SNAPIN_LA_BURST;
+}
+
+/* fd_snapin_lthash_add_{begin,data} add an account version that was
+   inserted into the database to the LtHash.  add_begin is called once
+   the account meta was written, followed by add_data calls adding up
+   to meta->dlen bytes (after the data was copied into the database). */
+
+void
+fd_snapin_lthash_add_begin( fd_snapin_tile_t *        ctx,
+                            void const *              pubkey,
+                            fd_account_meta_t const * meta );
+
+void
+fd_snapin_lthash_add_data( fd_snapin_tile_t * ctx,
+                           void const *       data,
+                           ulong              data_sz );
+
+/* fd_snapin_lthash_sub removes an account version that was replaced in
+   the database from the LtHash. */
+
+void
+fd_snapin_lthash_sub( fd_snapin_tile_t *        ctx,
+                      void const *              pubkey,
+                      fd_account_meta_t const * meta );
+
+/* fd_snapin_lthash_finish completes LtHash accumulation for the
+   current snapshot and compares the result with the manifest.  Returns
+   1 if partial sums from snapla tiles are still outstanding (call again
+   later), 0 on success, and -1 on mismatch.  On shards other than 0,
+   leaves the partial sum of this shard in ctx->lthash.sum and returns
+   0. */
+
+int
+fd_snapin_lthash_finish( fd_snapin_tile_t * ctx );
+
+/* fd_snapin_lthash_result accepts a partial sum from a snapla tile or
+   from another snapin shard. */
+
+void
+fd_snapin_lthash_result( fd_snapin_tile_t * ctx,
+                         ulong              chunk );
+
+/* fd_snapin_lthash_shutdown instructs snapla tiles to shut down. */
+
+void
+fd_snapin_lthash_shutdown( fd_snapin_tile_t * ctx );
+
+FD_PROTOTYPES_END
+
 /* Vinyl APIs *********************************************************/
 
 FD_PROTOTYPES_BEGIN
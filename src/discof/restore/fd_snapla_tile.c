@@ -0,0 +1,288 @@
+/* The snapla tile hashes the account records streamed by the snapin
+   tile while a snapshot is loaded (see fd_snapla_tile.h).  n snapla
+   tiles run in parallel.  The snapla tile with kind_id i only processes
+   data frags addressed to i and replies to FINISH control frags with
+   its partial LtHash sum. */
+
+#include "fd_snapla_tile.h"
+#include "../../disco/topo/fd_topo.h"
+#include "../../disco/metrics/fd_metrics.h"
+#include "../../ballet/lthash/fd_lthash_adder.h"
+#include "../../flamenco/runtime/fd_runtime_const.h"
+#include "generated/fd_snapla_tile_seccomp.h"
+
+#define NAME "snapla"
+
+/* FD_SNAPLA_REC_MAX is the max size of an account record */
+
+#define FD_SNAPLA_REC_MAX (sizeof(fd_snapla_acc_hdr_t)+FD_RUNTIME_ACC_SZ_MAX)
+
+struct fd_snapla_tile {
+  fd_lthash_adder_t adder[1];
+  fd_lthash_value_t sum[1];
+
+  ulong kind_id;
+  int   shutdown;
+
+  /* Reassembly state for records spanning multiple frags.  rec_sz is
+     the number of bytes of the current record received so far.  The
+     buffer is only used if a record does not fit into a single
+     frag. */
+
+  ulong   rec_sz;
+  uchar * rec_buf;
+
+  struct {
+    fd_wksp_t * wksp;
+    ulong       chunk0;
+    ulong       wmark;
+    ulong       mtu;
+  } in;
+
+  struct {
+    fd_wksp_t * wksp;
+    ulong       chunk0;
+    ulong       wmark;
+    ulong       chunk;
+  } out;
+
+  struct {
+    ulong accounts_hashed;
+    ulong bytes_hashed;
+  } metrics;
+};
+
+typedef struct fd_snapla_tile fd_snapla_tile_t;
+
+FD_FN_CONST static ulong
+scratch_align( void ) {
+  return alignof(fd_snapla_tile_t);
+}
+
+FD_FN_PURE static ulong
+scratch_footprint( fd_topo_tile_t const * tile ) {
+  (void)tile;
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, alignof(fd_snapla_tile_t), sizeof(fd_snapla_tile_t) );
+  l = FD_LAYOUT_APPEND( l, 64UL,                      FD_SNAPLA_REC_MAX        );
+  return FD_LAYOUT_FINI( l, scratch_align() );
+}
+
+static inline int
+should_shutdown( fd_snapla_tile_t * ctx ) {
+  return ctx->shutdown;
+}
+
+static void
+metrics_write( fd_snapla_tile_t * ctx ) {
+  FD_MCNT_SET( SNAPLA, ACCOUNTS_HASHED, ctx->metrics.accounts_hashed );
+  FD_MCNT_SET( SNAPLA, BYTES_HASHED,    ctx->metrics.bytes_hashed    );
+}
+
+static inline void
+hash_record( fd_snapla_tile_t *          ctx,
+             fd_snapla_acc_hdr_t const * hdr,
+             uchar const *               data ) {
+  fd_lthash_adder_push_solana_account( ctx->adder, ctx->sum, hdr->pubkey, data, hdr->data_sz, hdr->lamports, hdr->executable, hdr->owner );
+  ctx->metrics.accounts_hashed++;
+  ctx->metrics.bytes_hashed += hdr->data_sz;
+}
+
+/* consume processes the records in a data frag.  Records fully
+   contained in the frag are hashed in place. */
+
+static void
+consume( fd_snapla_tile_t * ctx,
+         uchar const *      p,
+         uchar const *      end ) {
+  ulong const hdr_sz = sizeof(fd_snapla_acc_hdr_t);
+  for(;;) {
+    if( FD_UNLIKELY( ctx->rec_sz ) ) {
+      /* Continue a record started in a previous frag */
+      if( ctx->rec_sz<hdr_sz ) {
+        ulong cp = fd_ulong_min( hdr_sz-ctx->rec_sz, (ulong)(end-p) );
+        fd_memcpy( ctx->rec_buf+ctx->rec_sz, p, cp );
+        ctx->rec_sz += cp; p += cp;
+        if( ctx->rec_sz<hdr_sz ) return;
+      }
+      fd_snapla_acc_hdr_t const * hdr = (fd_snapla_acc_hdr_t const *)ctx->rec_buf;
+      if( FD_UNLIKELY( hdr->data_sz>FD_RUNTIME_ACC_SZ_MAX ) ) FD_LOG_ERR(( "corrupt account record (data_sz=%lu)", hdr->data_sz ));
+      ulong rec_sz = hdr_sz+hdr->data_sz;
+      ulong cp     = fd_ulong_min( rec_sz-ctx->rec_sz, (ulong)(end-p) );
+      fd_memcpy( ctx->rec_buf+ctx->rec_sz, p, cp );
+      ctx->rec_sz += cp; p += cp;
+      if( ctx->rec_sz<rec_sz ) return;
+      hash_record( ctx, hdr, ctx->rec_buf+hdr_sz );
+      ctx->rec_sz = 0UL;
+      continue;
+    }
+
+    if( FD_UNLIKELY( p==end ) ) return;
+
+    ulong avail = (ulong)(end-p);
+    if( FD_LIKELY( avail>=hdr_sz ) ) {
+      fd_snapla_acc_hdr_t hdr = FD_LOAD( fd_snapla_acc_hdr_t, p );
+      if( FD_UNLIKELY( hdr.data_sz>FD_RUNTIME_ACC_SZ_MAX ) ) FD_LOG_ERR(( "corrupt account record (data_sz=%lu)", hdr.data_sz ));
+      if( FD_LIKELY( avail-hdr_sz>=hdr.data_sz ) ) {
+        hash_record( ctx, &hdr, p+hdr_sz );
+        p += hdr_sz+hdr.data_sz;
+        continue;
+      }
+    }
+
+    /* Record continues in the next frag */
+    fd_memcpy( ctx->rec_buf, p, avail );
+    ctx->rec_sz = avail;
+    return;
+  }
+}
+
+static inline int
+before_frag( fd_snapla_tile_t * ctx,
+             ulong              in_idx,
+             ulong              seq,
+             ulong              sig ) {
+  (void)in_idx; (void)seq;
+  return fd_snapla_sig_type( sig )==FD_SNAPLA_MSG_DATA && fd_snapla_sig_arg( sig )!=ctx->kind_id;
+}
+
+static inline void
+during_frag( fd_snapla_tile_t * ctx,
+             ulong              in_idx,
+             ulong              seq,
+             ulong              sig,
+             ulong              chunk,
+             ulong              sz,
+             ulong              ctl ) {
+  (void)in_idx; (void)seq; (void)ctl;
+  if( fd_snapla_sig_type( sig )!=FD_SNAPLA_MSG_DATA ) return;
+
+  if( FD_UNLIKELY( chunk<ctx->in.chunk0 || chunk>ctx->in.wmark || sz>ctx->in.mtu ) ) {
+    FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz, ctx->in.chunk0, ctx->in.wmark ));
+  }
+
+  uchar const * data = fd_chunk_to_laddr_const( ctx->in.wksp, chunk );
+  consume( ctx, data, data+sz );
+}
+
+static inline void
+after_frag( fd_snapla_tile_t *  ctx,
+            ulong               in_idx,
+            ulong               seq,
+            ulong               sig,
+            ulong               sz,
+            ulong               tsorig,
+            ulong               tspub,
+            fd_stem_context_t * stem ) {
+  (void)in_idx; (void)seq; (void)sz; (void)tsorig; (void)tspub;
+
+  switch( fd_snapla_sig_type( sig ) ) {
+  case FD_SNAPLA_MSG_DATA:
+    break;
+  case FD_SNAPLA_MSG_RESET:
+    fd_lthash_adder_flush( ctx->adder, ctx->sum );
+    fd_lthash_zero( ctx->sum );
+    ctx->rec_sz = 0UL;
+    break;
+  case FD_SNAPLA_MSG_FINISH: {
+    if( FD_UNLIKELY( ctx->rec_sz ) ) FD_LOG_ERR(( "incomplete account record at end of snapshot" ));
+    fd_lthash_adder_flush( ctx->adder, ctx->sum );
+    fd_memcpy( fd_chunk_to_laddr( ctx->out.wksp, ctx->out.chunk ), ctx->sum, sizeof(fd_lthash_value_t) );
+    fd_stem_publish( stem, 0UL, 0UL, ctx->out.chunk, sizeof(fd_lthash_value_t), 0UL, 0UL, 0UL );
+    ctx->out.chunk = fd_dcache_compact_next( ctx->out.chunk, sizeof(fd_lthash_value_t), ctx->out.chunk0, ctx->out.wmark );
+    fd_lthash_zero( ctx->sum );
+    break;
+  }
+  case FD_SNAPLA_MSG_SHUTDOWN:
+    ctx->shutdown = 1;
+    metrics_write( ctx );
+    break;
+  }
+}
+
+static ulong
+populate_allowed_fds( fd_topo_t const *      topo FD_PARAM_UNUSED,
+                      fd_topo_tile_t const * tile FD_PARAM_UNUSED,
+                      ulong                  out_fds_cnt,
+                      int *                  out_fds ) {
+  if( FD_UNLIKELY( out_fds_cnt<2UL ) ) FD_LOG_ERR(( "out_fds_cnt %lu", out_fds_cnt ));
+
+  ulong out_cnt = 0UL;
+  out_fds[ out_cnt++ ] = 2; /* stderr */
+  if( FD_LIKELY( -1!=fd_log_private_logfile_fd() ) ) {
+    out_fds[ out_cnt++ ] = fd_log_private_logfile_fd(); /* logfile */
+  }
+  return out_cnt;
+}
+
+static ulong
+populate_allowed_seccomp( fd_topo_t const *      topo FD_PARAM_UNUSED,
+                          fd_topo_tile_t const * tile FD_PARAM_UNUSED,
+                          ulong                  out_cnt,
+                          struct sock_filter *   out ) {
+  populate_sock_filter_policy_fd_snapla_tile( out_cnt, out, (uint)fd_log_private_logfile_fd() );
+  return sock_filter_policy_fd_snapla_tile_instr_cnt;
+}
+
+static void
+unprivileged_init( fd_topo_t *      topo,
+                   fd_topo_tile_t * tile ) {
+  void * scratch = fd_topo_obj_laddr( topo, tile->tile_obj_id );
+
+  FD_SCRATCH_ALLOC_INIT( l, scratch );
+  fd_snapla_tile_t * ctx     = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_snapla_tile_t), sizeof(fd_snapla_tile_t) );
+  void *             rec_buf = FD_SCRATCH_ALLOC_APPEND( l, 64UL,                      FD_SNAPLA_REC_MAX        );
+  memset( ctx, 0, sizeof(fd_snapla_tile_t) );
+
+  if( FD_UNLIKELY( tile->in_cnt !=1UL ) ) FD_LOG_ERR(( "tile `" NAME "` has %lu ins, expected 1",  tile->in_cnt  ));
+  if( FD_UNLIKELY( tile->out_cnt!=1UL ) ) FD_LOG_ERR(( "tile `" NAME "` has %lu outs, expected 1", tile->out_cnt ));
+
+  ctx->kind_id = tile->kind_id;
+  ctx->rec_buf = rec_buf;
+  FD_TEST( fd_lthash_adder_new( ctx->adder ) );
+  fd_lthash_zero( ctx->sum );
+
+  fd_topo_link_t const * in_link = &topo->links[ tile->in_link_id[ 0UL ] ];
+  ctx->in.wksp   = topo->workspaces[ topo->objs[ in_link->dcache_obj_id ].wksp_id ].wksp;
+  ctx->in.chunk0 = fd_dcache_compact_chunk0( ctx->in.wksp, in_link->dcache );
+  ctx->in.wmark  = fd_dcache_compact_wmark ( ctx->in.wksp, in_link->dcache, in_link->mtu );
+  ctx->in.mtu    = in_link->mtu;
+
+  fd_topo_link_t const * out_link = &topo->links[ tile->out_link_id[ 0UL ] ];
+  if( FD_UNLIKELY( out_link->mtu<sizeof(fd_lthash_value_t) ) ) FD_LOG_ERR(( "link `%s` mtu %lu too small", out_link->name, out_link->mtu ));
+  ctx->out.wksp   = topo->workspaces[ topo->objs[ out_link->dcache_obj_id ].wksp_id ].wksp;
+  ctx->out.chunk0 = fd_dcache_compact_chunk0( ctx->out.wksp, out_link->dcache );
+  ctx->out.wmark  = fd_dcache_compact_wmark ( ctx->out.wksp, out_link->dcache, out_link->mtu );
+  ctx->out.chunk  = ctx->out.chunk0;
+
+  ulong scratch_top = FD_SCRATCH_ALLOC_FINI( l, scratch_align() );
+  if( FD_UNLIKELY( scratch_top > (ulong)scratch + scratch_footprint( tile ) ) )
+    FD_LOG_ERR(( "scratch overflow %lu %lu %lu", scratch_top - (ulong)scratch - scratch_footprint( tile ), scratch_top, (ulong)scratch + scratch_footprint( tile ) ));
+}
+
+#define STEM_BURST 1UL
+
+#define STEM_LAZY  ((long)10e3)
+
+#define STEM_CALLBACK_CONTEXT_TYPE  fd_snapla_tile_t
+#define STEM_CALLBACK_CONTEXT_ALIGN alignof(fd_snapla_tile_t)
+
+#define STEM_CALLBACK_SHOULD_SHUTDOWN should_shutdown
+#define STEM_CALLBACK_METRICS_WRITE   metrics_write
+#define STEM_CALLBACK_BEFORE_FRAG     before_frag
+#define STEM_CALLBACK_DURING_FRAG     during_frag
+#define STEM_CALLBACK_AFTER_FRAG      after_frag
+
+#include "../../disco/stem/fd_stem.c"
+
+fd_topo_run_tile_t fd_tile_snapla = {
+  .name                     = NAME,
+  .populate_allowed_fds     = populate_allowed_fds,
+  .populate_allowed_seccomp = populate_allowed_seccomp,
+  .scratch_align            = scratch_align,
+  .scratch_footprint        = scratch_footprint,
+  .unprivileged_init        = unprivileged_init,
+  .run                      = stem_run,
+};
+
+#undef NAME
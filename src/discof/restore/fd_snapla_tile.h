@@ -0,0 +1,55 @@
+#ifndef HEADER_fd_src_discof_restore_fd_snapla_tile_h
+#define HEADER_fd_src_discof_restore_fd_snapla_tile_h
+
+#include "../../util/fd_util_base.h"
+
+/* The snapla ("snapshot lthash accumulate") tiles verify the accounts
+   LtHash of a snapshot while it is being loaded:
+
+     snapin (1) --snapin_la--> snapla (n) --snapla_in--> snapin (1)
+
+   For every account version that snapin inserts into the database, it
+   streams a record (fd_snapla_acc_hdr_t followed by the account data)
+   onto the snapin_la link.  The n snapla tiles hash the records with
+   fd_lthash_adder.  Each data frag is addressed to exactly one snapla
+   tile (the frag sig arg).  Records that fit into a frag are never
+   split across frags.  Larger records are spread over consecutive
+   frags addressed to the same snapla tile.  snapin moves on to the next
+   snapla tile whenever a frag ends on a record boundary.
+
+   When an account version gets replaced by a newer one (duplicate
+   accounts in a full snapshot, or accounts updated by an incremental
+   snapshot), snapin subtracts the LtHash of the replaced version
+   itself.  Older versions that are never inserted are never hashed.
+   Zero-lamport accounts have a zero LtHash and are not sent.
+
+   Control frags are broadcast to all snapla tiles.  On FINISH, each
+   snapla tile replies with the sum of all records it hashed since the
+   last RESET or FINISH (one fd_lthash_value_t frag on its snapla_in
+   link).  snapin adds up these partial sums and compares the result
+   with the accounts LtHash in the snapshot manifest. */
+
+#define FD_SNAPLA_MSG_DATA     (0UL) /* arg: kind_id of snapla tile */
+#define FD_SNAPLA_MSG_RESET    (1UL) /* discard partial sums, snapshot restarted */
+#define FD_SNAPLA_MSG_FINISH   (2UL) /* publish partial sum */
+#define FD_SNAPLA_MSG_SHUTDOWN (3UL) /* snapshot loading done */
+
+FD_FN_CONST static inline ulong fd_snapla_sig     ( ulong type, ulong arg ) { return (arg<<2) | type; }
+FD_FN_CONST static inline ulong fd_snapla_sig_type( ulong sig )             { return sig&3UL;        }
+FD_FN_CONST static inline ulong fd_snapla_sig_arg ( ulong sig )             { return sig>>2;         }
+
+/* fd_snapla_acc_hdr_t is the header of an account record on the
+   snapin_la link.  Records are not aligned. */
+
+struct fd_snapla_acc_hdr {
+  uchar pubkey[ 32 ];
+  uchar owner [ 32 ];
+  ulong lamports;
+  ulong data_sz;
+  uchar executable;
+  uchar _pad[ 7 ];
+};
+
+typedef struct fd_snapla_acc_hdr fd_snapla_acc_hdr_t;
+
+#endif /* HEADER_fd_src_discof_restore_fd_snapla_tile_h */
@@ -1,6 +1,7 @@
 #include "utils/fd_ssarchive.h"
 #include "utils/fd_ssctrl.h"
 #include "utils/fd_sshttp.h"
+#include "utils/fd_ssrange.h"
 
 #include "../../disco/topo/fd_topo.h"
 #include "../../disco/metrics/fd_metrics.h"
@@ -16,7 +17,18 @@
 
 /* The snapld tile is responsible for loading data from the local file
    or from an HTTP/TCP connection and sending it to the snapdc tile
-   for later decompression. */
+   for later decompression.
+
+   HTTP downloads start with a regular request to the peer selected by
+   snapct, which resolves the snapshot file name and size.  If snapct
+   also provided other peers advertising the same snapshot, the rest of
+   the file is then downloaded from all of these peers concurrently
+   with range requests (see utils/fd_ssrange.h). */
+
+#define FD_SNAPLD_RANGE_BUF_SZ  (32UL<<20) /* reorder buffer size */
+#define FD_SNAPLD_RANGE_SEG_MIN ( 1UL<<20) /* min range request size */
+
+FD_STATIC_ASSERT( FD_SSCTRL_ALT_MAX+1UL<=FD_SSRANGE_PEER_MAX, alt_max );
 
 typedef struct fd_snapld_tile {
 
@@ -28,11 +40,17 @@ typedef struct fd_snapld_tile {
   int load_full;
   int load_file;
   int sent_meta;
+  int ranged;
+
+  fd_ip4_port_t addr;
+  ulong         alt_cnt;
+  fd_ip4_port_t alt[ FD_SSCTRL_ALT_MAX ];
 
   int local_full_fd;
   int local_incr_fd;
 
-  fd_sshttp_t * sshttp;
+  fd_sshttp_t *  sshttp;
+  fd_ssrange_t * ssrange;
 
   struct {
     void const * base;
@@ -50,7 +68,7 @@ typedef struct fd_snapld_tile {
 
 static ulong
 scratch_align( void ) {
-  return fd_ulong_max( alignof(fd_snapld_tile_t), fd_sshttp_align() );
+  return fd_ulong_max( alignof(fd_snapld_tile_t), fd_ulong_max( fd_sshttp_align(), fd_ssrange_align() ) );
 }
 
 static ulong
@@ -58,6 +76,7 @@ scratch_footprint( fd_topo_tile_t const * tile FD_PARAM_UNUSED ) {
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND(  l, alignof(fd_snapld_tile_t),  sizeof(fd_snapld_tile_t) );
   l = FD_LAYOUT_APPEND(  l, fd_sshttp_align(),          fd_sshttp_footprint()    );
+  l = FD_LAYOUT_APPEND(  l, fd_ssrange_align(),         fd_ssrange_footprint( FD_SNAPLD_RANGE_BUF_SZ ) );
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
 
@@ -131,6 +150,7 @@ unprivileged_init( fd_topo_t *      topo,
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_snapld_tile_t * ctx  = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_snapld_tile_t),  sizeof(fd_snapld_tile_t) );
   void * _sshttp          = FD_SCRATCH_ALLOC_APPEND( l, fd_sshttp_align(),          fd_sshttp_footprint()    );
+  void * _ssrange         = FD_SCRATCH_ALLOC_APPEND( l, fd_ssrange_align(),         fd_ssrange_footprint( FD_SNAPLD_RANGE_BUF_SZ ) );
 
   fd_memcpy( ctx->config.path, tile->snapld.snapshots_path, PATH_MAX );
 
@@ -139,6 +159,9 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->sshttp = fd_sshttp_join( fd_sshttp_new( _sshttp ) );
   FD_TEST( ctx->sshttp );
 
+  ctx->ssrange = fd_ssrange_join( fd_ssrange_new( _ssrange, FD_SNAPLD_RANGE_BUF_SZ, FD_SNAPLD_RANGE_SEG_MIN ) );
+  FD_TEST( ctx->ssrange );
+
   FD_TEST( tile->in_cnt==1UL );
   fd_topo_link_t const * in_link = &topo->links[ tile->in_link_id[ 0 ] ];
   FD_TEST( 0==strcmp( in_link->name, "snapct_ld" ) );
@@ -164,6 +187,45 @@ metrics_write( fd_snapld_tile_t * ctx ) {
   FD_MGAUGE_SET( SNAPLD, STATE, (ulong)(ctx->state) );
 }
 
+/* start_ranged switches an HTTP download over to downloading the rest
+   of the file from the primary and all alternate peers concurrently,
+   once the response headers of the primary peer were received (which
+   tell the resolved name and size of the file).  off bytes of the file
+   were already received.  Small remainders are not worth the extra
+   connections and are downloaded from the primary peer. */
+
+static void
+start_ranged( fd_snapld_tile_t * ctx,
+              ulong              off ) {
+  if( FD_LIKELY( !ctx->alt_cnt ) ) return;
+
+  char const * name     = fd_sshttp_snapshot_name( ctx->sshttp );
+  ulong        total_sz = fd_sshttp_content_len( ctx->sshttp );
+  if( FD_UNLIKELY( name[ 0 ]=='\0' || total_sz-off<4UL*FD_SNAPLD_RANGE_SEG_MIN ) ) return;
+
+  char  path[ PATH_MAX ];
+  ulong path_len;
+  if( FD_UNLIKELY( !fd_cstr_printf_check( path, PATH_MAX, &path_len, "/%s", name ) ) ) return;
+
+  fd_sshttp_cancel( ctx->sshttp );
+  fd_ssrange_init( ctx->ssrange, path, path_len, off, total_sz );
+  FD_TEST( !fd_ssrange_add_peer( ctx->ssrange, ctx->addr ) );
+  for( ulong i=0UL; i<ctx->alt_cnt; i++ ) fd_ssrange_add_peer( ctx->ssrange, ctx->alt[ i ] );
+  ctx->ranged = 1;
+
+  FD_LOG_NOTICE(( "downloading `%s` from %lu peers", name, fd_ssrange_peer_cnt( ctx->ssrange ) ));
+}
+
+static void
+log_ranged( fd_snapld_tile_t * ctx ) {
+  for( ulong i=0UL; i<fd_ssrange_peer_cnt( ctx->ssrange ); i++ ) {
+    fd_ip4_port_t addr = fd_ssrange_peer_addr( ctx->ssrange, i );
+    FD_LOG_INFO(( "received %lu bytes from http://" FD_IP4_ADDR_FMT ":%hu%s",
+                  fd_ssrange_peer_bytes( ctx->ssrange, i ), FD_IP4_ADDR_FMT_ARGS( addr.addr ), fd_ushort_bswap( addr.port ),
+                  fd_ssrange_peer_failed( ctx->ssrange, i ) ? " (dropped)" : "" ));
+  }
+}
+
 static void
 after_credit( fd_snapld_tile_t *  ctx,
               fd_stem_context_t * stem,
@@ -190,6 +252,28 @@ after_credit( fd_snapld_tile_t *  ctx,
       ctx->out_dc.chunk = fd_dcache_compact_next( ctx->out_dc.chunk, (ulong)result, ctx->out_dc.chunk0, ctx->out_dc.wmark );
       *charge_busy = 1;
     }
+  } else if( ctx->ranged ) {
+    ulong data_len = ctx->out_dc.mtu;
+    int   result   = fd_ssrange_advance( ctx->ssrange, &data_len, out, fd_log_wallclock() );
+    switch( result ) {
+      case FD_SSRANGE_ADVANCE_AGAIN:
+        break;
+      case FD_SSRANGE_ADVANCE_DATA:
+        fd_stem_publish( stem, 0UL, FD_SNAPSHOT_MSG_DATA, ctx->out_dc.chunk, data_len, 0UL, 0UL, 0UL );
+        ctx->out_dc.chunk = fd_dcache_compact_next( ctx->out_dc.chunk, data_len, ctx->out_dc.chunk0, ctx->out_dc.wmark );
+        *charge_busy = 1;
+        break;
+      case FD_SSRANGE_ADVANCE_DONE:
+        log_ranged( ctx );
+        ctx->state = FD_SNAPSHOT_STATE_FINISHING;
+        break;
+      case FD_SSRANGE_ADVANCE_ERROR:
+        log_ranged( ctx );
+        ctx->state = FD_SNAPSHOT_STATE_ERROR;
+        fd_stem_publish( stem, 0UL, FD_SNAPSHOT_MSG_CTRL_ERROR, 0UL, 0UL, 0UL, 0UL, 0UL );
+        break;
+      default: FD_LOG_ERR(( "unexpected fd_ssrange_advance result %d", result ));
+    }
   } else {
     ulong data_len = ctx->out_dc.mtu;
     int   result   = fd_sshttp_advance( ctx->sshttp, &data_len, out, fd_log_wallclock() );
@@ -197,6 +281,7 @@ after_credit( fd_snapld_tile_t *  ctx,
       case FD_SSHTTP_ADVANCE_AGAIN:
         break;
       case FD_SSHTTP_ADVANCE_DATA: {
+        int first = !ctx->sent_meta;
         if( FD_UNLIKELY( !ctx->sent_meta ) ) {
           /* On the first DATA return, the HTTP headers are available
              for use.  We need to send this metadata downstream, but
@@ -217,6 +302,7 @@ after_credit( fd_snapld_tile_t *  ctx,
           fd_stem_publish( stem, 0UL, FD_SNAPSHOT_MSG_DATA, ctx->out_dc.chunk, data_len, 0UL, 0UL, 0UL );
           ctx->out_dc.chunk = fd_dcache_compact_next( ctx->out_dc.chunk, data_len, ctx->out_dc.chunk0, ctx->out_dc.wmark );
         }
+        if( FD_UNLIKELY( first ) ) start_ranged( ctx, data_len );
         *charge_busy = 1;
         break;
       }
@@ -254,6 +340,10 @@ returnable_frag( fd_snapld_tile_t *  ctx,
       ctx->load_file = msg->file;
       ctx->state = FD_SNAPSHOT_STATE_PROCESSING;
       ctx->sent_meta = 0;
+      ctx->ranged    = 0;
+      ctx->addr      = msg->addr;
+      ctx->alt_cnt   = fd_ulong_min( msg->alt_cnt, FD_SSCTRL_ALT_MAX );
+      fd_memcpy( ctx->alt, msg->alt, ctx->alt_cnt*sizeof(fd_ip4_port_t) );
       if( ctx->load_file ) {
         if( FD_UNLIKELY( 0!=lseek( ctx->load_full ? ctx->local_full_fd : ctx->local_incr_fd, 0, SEEK_SET ) ) )
           FD_LOG_ERR(( "lseek(0) failed (%i-%s)", errno, fd_io_strerror( errno ) ));
@@ -269,6 +359,7 @@ returnable_frag( fd_snapld_tile_t *  ctx,
                ctx->state==FD_SNAPSHOT_STATE_FINISHING  ||
                ctx->state==FD_SNAPSHOT_STATE_ERROR );
       fd_sshttp_cancel( ctx->sshttp );
+      fd_ssrange_cancel( ctx->ssrange );
       ctx->state = FD_SNAPSHOT_STATE_IDLE;
       break;
 
@@ -327,7 +418,7 @@ fd_topo_run_tile_t fd_tile_snapld = {
   .run                      = stem_run,
   .keep_host_networking     = 1,
   .allow_connect            = 1,
-  .rlimit_file_cnt          = 5UL, /* stderr, log, http, full/incr local files */
+  .rlimit_file_cnt          = 4UL+FD_SSRANGE_PEER_MAX, /* stderr, log, full/incr local files, http */
 };
 
 #undef NAME
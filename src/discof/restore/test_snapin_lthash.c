@@ -0,0 +1,237 @@
+#include "fd_snapin_tile_private.h"
+#include "../../flamenco/runtime/fd_hashes.h"
+
+#define WKSP_TAG (1UL)
+
+/* Tests accounts LtHash verification of snapshots with duplicate
+   accounts (inline hashing, no snapla tiles).  The LtHash of a loaded
+   snapshot must only cover the newest version of every account. */
+
+static fd_snapin_tile_t ctx[1];
+
+/* Test account content is derived from (key,slot) */
+
+static uchar acc_data[ 1UL<<12 ];
+static uchar frames  [ FD_SSPARSE_ACC_BATCH_MAX ][ 0x88UL+(1UL<<10) ];
+
+static void
+acc_fill( uchar * data,
+          ulong   key,
+          ulong   slot,
+          ulong   data_sz ) {
+  for( ulong i=0UL; i<data_sz; i++ ) data[ i ] = (uchar)fd_ulong_hash( (key<<32)^(slot<<16)^i );
+}
+
+static void
+acc_pubkey( uchar * pubkey,
+            ulong   key ) {
+  memset( pubkey, 0, 32UL );
+  FD_STORE( ulong, pubkey,      key );
+  FD_STORE( ulong, pubkey+24UL, ~key );
+}
+
+static void
+acc_owner( uchar * owner,
+           ulong   key ) {
+  memset( owner, (int)( key&0xffUL ), 32UL );
+}
+
+/* acc_lthash adds the LtHash of an account version to sum */
+
+static void
+acc_lthash( fd_lthash_value_t * sum,
+            ulong               key,
+            ulong               slot,
+            ulong               lamports,
+            ulong               data_sz ) {
+  fd_pubkey_t       pubkey; acc_pubkey( pubkey.uc, key );
+  fd_account_meta_t meta = {0};
+  meta.lamports   = lamports;
+  meta.dlen       = (uint)data_sz;
+  meta.executable = (uchar)( key&1UL );
+  acc_owner( meta.owner, key );
+  acc_fill( acc_data, key, slot, data_sz );
+  fd_lthash_value_t value[1];
+  fd_hashes_account_lthash( &pubkey, &meta, acc_data, value );
+  fd_lthash_add( sum, value );
+}
+
+/* insert_frag inserts an account version through the fragmented
+   (header, data...) path, splitting the data into two frags. */
+
+static void
+insert_frag( ulong key,
+             ulong slot,
+             ulong lamports,
+             ulong data_sz ) {
+  uchar pubkey[ 32 ]; acc_pubkey( pubkey, key );
+  uchar owner [ 32 ]; acc_owner ( owner,  key );
+  acc_fill( acc_data, key, slot, data_sz );
+
+  fd_ssparse_advance_result_t result[1];
+  result->account_header.slot       = slot;
+  result->account_header.data_len   = data_sz;
+  result->account_header.pubkey     = pubkey;
+  result->account_header.lamports   = lamports;
+  result->account_header.rent_epoch = ULONG_MAX;
+  result->account_header.owner      = owner;
+  result->account_header.executable = (int)( key&1UL );
+  result->account_header.hash       = NULL;
+  fd_snapin_process_account_header_funk( ctx, result );
+
+  ulong split = data_sz/3UL;
+  result->account_data.owner   = owner;
+  result->account_data.data    = acc_data;
+  result->account_data.data_sz = split;
+  if( split ) fd_snapin_process_account_data_funk( ctx, result );
+  result->account_data.data    = acc_data+split;
+  result->account_data.data_sz = data_sz-split;
+  if( data_sz-split ) fd_snapin_process_account_data_funk( ctx, result );
+}
+
+/* insert_batch inserts FD_SSPARSE_ACC_BATCH_MAX account versions
+   through the batch path. */
+
+static void
+insert_batch( ulong const * keys,
+              ulong         slot,
+              ulong const * lamports,
+              ulong const * data_sz ) {
+  fd_ssparse_advance_result_t result[1];
+  for( ulong i=0UL; i<FD_SSPARSE_ACC_BATCH_MAX; i++ ) {
+    uchar * frame = frames[ i ];
+    FD_TEST( data_sz[ i ]<=sizeof(frames[ i ])-0x88UL );
+    memset( frame, 0, 0x88UL );
+    FD_STORE( ulong, frame+0x08UL, data_sz [ i ] );
+    acc_pubkey( frame+0x10UL, keys[ i ] );
+    FD_STORE( ulong, frame+0x30UL, lamports[ i ] );
+    FD_STORE( ulong, frame+0x38UL, ULONG_MAX );
+    acc_owner( frame+0x40UL, keys[ i ] );
+    frame[ 0x60UL ] = (uchar)( keys[ i ]&1UL );
+    acc_fill( frame+0x88UL, keys[ i ], slot, data_sz[ i ] );
+    result->account_batch.batch[ i ] = frame;
+  }
+  result->account_batch.batch_cnt = FD_SSPARSE_ACC_BATCH_MAX;
+  result->account_batch.slot      = slot;
+  fd_snapin_process_account_batch_funk( ctx, result );
+}
+
+static void
+expect( fd_lthash_value_t const * lthash ) {
+  ctx->lthash.has_expected = 1;
+  memcpy( ctx->lthash.expected, lthash->bytes, FD_LTHASH_LEN_BYTES );
+}
+
+static void
+test_duplicates( fd_funk_t * funk ) {
+  memset( ctx, 0, sizeof(fd_snapin_tile_t) );
+  FD_TEST( fd_accdb_admin_join( ctx->accdb_admin, funk->shmem ) );
+  fd_funk_txn_xid_copy( ctx->xid, fd_funk_root( funk ) );
+  ctx->full      = 1;
+  ctx->shard.cnt = 1UL;
+  ctx->lthash.enabled = 1;
+  FD_TEST( fd_lthash_adder_new( ctx->lthash.add_adder ) );
+  FD_TEST( fd_lthash_adder_new( ctx->lthash.sub_adder ) );
+  fd_lthash_zero( ctx->lthash.sum       );
+  fd_lthash_zero( ctx->lthash.sub       );
+  fd_lthash_zero( ctx->lthash.committed );
+
+  /* Full snapshot */
+
+  fd_snapin_lthash_reset( ctx );
+
+  insert_frag( 1UL, 10UL, 100UL,   40UL ); /* replaced by a newer version */
+  insert_frag( 1UL, 20UL, 200UL,  600UL ); /* newest */
+  insert_frag( 1UL, 15UL, 300UL,   80UL ); /* older, skipped */
+  insert_frag( 2UL, 10UL, 100UL, 1000UL );
+  insert_frag( 2UL, 20UL,   0UL,    0UL ); /* deleted */
+  insert_frag( 3UL, 10UL, 100UL,   16UL ); /* replaced in batch */
+
+  ulong keys    [ FD_SSPARSE_ACC_BATCH_MAX ] = { 100UL, 3UL, 101UL, 102UL, 103UL, 104UL, 105UL, 1UL };
+  ulong lamports[ FD_SSPARSE_ACC_BATCH_MAX ] = {   1UL, 5UL,   2UL,   3UL,   4UL,   5UL,   6UL, 9UL };
+  ulong data_sz [ FD_SSPARSE_ACC_BATCH_MAX ] = {   0UL, 700UL, 1UL,  32UL, 165UL, 200UL, 513UL, 7UL };
+  insert_batch( keys, 18UL, lamports, data_sz ); /* key 1 is older, skipped */
+
+  /* Versions of the same key within a batch, the last one wins */
+  ulong dup_keys    [ FD_SSPARSE_ACC_BATCH_MAX ] = { 200UL, 201UL, 200UL, 202UL, 203UL, 204UL, 205UL, 200UL };
+  ulong dup_lamports[ FD_SSPARSE_ACC_BATCH_MAX ] = {   1UL,   2UL,   3UL,   4UL,   5UL,   6UL,   7UL,   8UL };
+  ulong dup_data_sz [ FD_SSPARSE_ACC_BATCH_MAX ] = {  10UL,  20UL,  30UL,  40UL,  50UL,  60UL,  70UL,  80UL };
+  insert_batch( dup_keys, 19UL, dup_lamports, dup_data_sz );
+
+  fd_lthash_value_t full[1]; fd_lthash_zero( full );
+  acc_lthash( full, 1UL, 20UL, 200UL, 600UL );
+  for( ulong i=0UL; i<FD_SSPARSE_ACC_BATCH_MAX-1UL; i++ ) acc_lthash( full, keys[ i ], 18UL, lamports[ i ], data_sz[ i ] );
+  for( ulong i=1UL; i<FD_SSPARSE_ACC_BATCH_MAX; i++ ) {
+    if( i!=2UL ) acc_lthash( full, dup_keys[ i ], 19UL, dup_lamports[ i ], dup_data_sz[ i ] );
+  }
+
+  expect( full );
+  FD_TEST( fd_snapin_lthash_finish( ctx )==0 );
+  FD_TEST( fd_memeq( ctx->lthash.committed->bytes, full->bytes, FD_LTHASH_LEN_BYTES ) );
+
+  /* Incremental snapshot shadowing versions of the full snapshot */
+
+  fd_funk_txn_xid_t incr_xid = { .ul = { 30UL, 0UL } };
+  fd_accdb_attach_child( ctx->accdb_admin, ctx->xid, &incr_xid );
+  fd_funk_txn_xid_copy( ctx->xid, &incr_xid );
+  ctx->full = 0;
+  fd_snapin_lthash_reset( ctx );
+
+  insert_frag( 1UL, 25UL, 400UL, 10UL ); /* replaced by a newer version */
+  insert_frag( 1UL, 30UL, 500UL, 20UL ); /* newest */
+  insert_frag( 3UL, 30UL,   0UL,  0UL ); /* deleted */
+  insert_frag( 4UL, 30UL,   7UL, 70UL );
+
+  /* Versions of a key of the full snapshot within a batch, the full
+     snapshot version is only removed once */
+  ulong incr_keys    [ FD_SSPARSE_ACC_BATCH_MAX ] = { 200UL, 300UL, 200UL, 301UL, 302UL, 303UL, 304UL, 305UL };
+  ulong incr_lamports[ FD_SSPARSE_ACC_BATCH_MAX ] = {   1UL,   2UL,   3UL,   4UL,   5UL,   6UL,   7UL,   8UL };
+  ulong incr_data_sz [ FD_SSPARSE_ACC_BATCH_MAX ] = {  11UL,  21UL,  31UL,  41UL,  51UL,  61UL,  71UL,  81UL };
+  insert_batch( incr_keys, 30UL, incr_lamports, incr_data_sz );
+
+  fd_lthash_value_t incr[1]; memcpy( incr, full, sizeof(fd_lthash_value_t) );
+  fd_lthash_value_t old [1]; fd_lthash_zero( old );
+  acc_lthash( old,    1UL, 20UL, 200UL, 600UL );
+  acc_lthash( old,    3UL, 18UL,   5UL, 700UL );
+  acc_lthash( old,  200UL, 19UL,   8UL,  80UL );
+  fd_lthash_sub( incr, old );
+  acc_lthash( incr, 1UL, 30UL, 500UL,  20UL );
+  acc_lthash( incr, 4UL, 30UL,   7UL,  70UL );
+  for( ulong i=1UL; i<FD_SSPARSE_ACC_BATCH_MAX; i++ ) acc_lthash( incr, incr_keys[ i ], 30UL, incr_lamports[ i ], incr_data_sz[ i ] );
+  expect( incr );
+  FD_TEST( fd_snapin_lthash_finish( ctx )==0 );
+
+  fd_lthash_adder_delete( ctx->lthash.add_adder );
+  fd_lthash_adder_delete( ctx->lthash.sub_adder );
+  fd_accdb_admin_leave( ctx->accdb_admin, NULL );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "gigantic"      );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 1UL             );
+  ulong        near_cpu = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu", NULL, fd_log_cpu_id() );
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  FD_TEST( wksp );
+
+  ulong  txn_max = 4UL;
+  ulong  rec_max = 1024UL;
+  void * shfunk  = fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint( txn_max, rec_max ), WKSP_TAG );
+  FD_TEST( fd_funk_new( shfunk, WKSP_TAG, 1234UL, txn_max, rec_max ) );
+  fd_funk_t funk[1];
+  FD_TEST( fd_funk_join( funk, shfunk ) );
+
+  test_duplicates( funk );
+
+  fd_funk_leave( funk, NULL );
+  fd_wksp_free_laddr( fd_funk_delete( shfunk ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
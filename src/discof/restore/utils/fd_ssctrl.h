@@ -70,11 +70,17 @@
 #define FD_SNAPSHOT_MSG_CTRL_SHUTDOWN          (7UL) /* No work left to do, perform final cleanup and shut down */
 #define FD_SNAPSHOT_MSG_CTRL_ERROR             (8UL) /* Some tile encountered an error with the current stream */
 
+#define FD_SSCTRL_ALT_MAX (7UL)
+
 /* Sent by snapct to tell snapld whether to load a local file or
-   download from a particular external peer. */
+   download from a particular external peer.  alt lists up to
+   FD_SSCTRL_ALT_MAX other peers advertising the same snapshot, which
+   snapld may download parts of the file from concurrently. */
 typedef struct fd_ssctrl_init {
   int           file;
   fd_ip4_port_t addr;
+  ulong         alt_cnt;
+  fd_ip4_port_t alt[ FD_SSCTRL_ALT_MAX ];
 } fd_ssctrl_init_t;
 
 /* Sent by snapld to tell snapct metadata about a downloaded snapshot. */
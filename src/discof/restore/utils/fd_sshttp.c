@@ -45,6 +45,10 @@ struct fd_sshttp_private {
   ulong content_len;
   ulong content_read;
 
+  ulong range_off; /* first requested byte, if range_sz>0 */
+  ulong range_sz;  /* requested byte count, 0 for a full GET */
+  ulong range_total;
+
   ulong magic;
 };
 
@@ -78,6 +82,7 @@ fd_sshttp_new( void * shmem ) {
 
   sshttp->state = FD_SSHTTP_STATE_INIT;
   sshttp->content_len = 0UL;
+  sshttp->range_sz    = 0UL;
   fd_cstr_fini( sshttp->snapshot_name );
 
   FD_COMPILER_MFENCE();
@@ -109,25 +114,10 @@ fd_sshttp_join( void * shhttp ) {
   return sshttp;
 }
 
-void
-fd_sshttp_init( fd_sshttp_t * http,
+static void
+sshttp_connect( fd_sshttp_t * http,
                 fd_ip4_port_t addr,
-                char const *  path,
-                ulong         path_len,
                 long          now ) {
-  FD_TEST( http->state==FD_SSHTTP_STATE_INIT );
-
-  http->hops = 4UL;
-
-  http->request_sent = 0UL;
-  FD_TEST( fd_cstr_printf_check( http->request, sizeof(http->request), &http->request_len,
-    "GET %.*s HTTP/1.1\r\n"
-    "User-Agent: Firedancer\r\n"
-    "Accept: */*\r\n"
-    "Accept-Encoding: identity\r\n"
-    "Host: " FD_IP4_ADDR_FMT "\r\n\r\n",
-    (int)path_len, path, FD_IP4_ADDR_FMT_ARGS( addr.addr ) ) );
-
   http->response_len = 0UL;
   http->content_len  = 0UL;
   http->content_read = 0UL;
@@ -153,6 +143,58 @@ fd_sshttp_init( fd_sshttp_t * http,
   http->deadline = now + 500L*1000L*1000L;
 }
 
+void
+fd_sshttp_init( fd_sshttp_t * http,
+                fd_ip4_port_t addr,
+                char const *  path,
+                ulong         path_len,
+                long          now ) {
+  FD_TEST( http->state==FD_SSHTTP_STATE_INIT );
+
+  http->hops     = 4UL;
+  http->range_sz = 0UL;
+
+  http->request_sent = 0UL;
+  FD_TEST( fd_cstr_printf_check( http->request, sizeof(http->request), &http->request_len,
+    "GET %.*s HTTP/1.1\r\n"
+    "User-Agent: Firedancer\r\n"
+    "Accept: */*\r\n"
+    "Accept-Encoding: identity\r\n"
+    "Host: " FD_IP4_ADDR_FMT "\r\n\r\n",
+    (int)path_len, path, FD_IP4_ADDR_FMT_ARGS( addr.addr ) ) );
+
+  sshttp_connect( http, addr, now );
+}
+
+void
+fd_sshttp_init_range( fd_sshttp_t * http,
+                      fd_ip4_port_t addr,
+                      char const *  path,
+                      ulong         path_len,
+                      ulong         off,
+                      ulong         sz,
+                      long          now ) {
+  FD_TEST( http->state==FD_SSHTTP_STATE_INIT );
+  FD_TEST( sz );
+
+  http->hops        = 0UL; /* the exact file was already resolved */
+  http->range_off   = off;
+  http->range_sz    = sz;
+  http->range_total = ULONG_MAX;
+
+  http->request_sent = 0UL;
+  FD_TEST( fd_cstr_printf_check( http->request, sizeof(http->request), &http->request_len,
+    "GET %.*s HTTP/1.1\r\n"
+    "User-Agent: Firedancer\r\n"
+    "Accept: */*\r\n"
+    "Accept-Encoding: identity\r\n"
+    "Range: bytes=%lu-%lu\r\n"
+    "Host: " FD_IP4_ADDR_FMT "\r\n\r\n",
+    (int)path_len, path, off, off+sz-1UL, FD_IP4_ADDR_FMT_ARGS( addr.addr ) ) );
+
+  sshttp_connect( http, addr, now );
+}
+
 void
 fd_sshttp_cancel( fd_sshttp_t * http ) {
   if( FD_LIKELY( http->state!=FD_SSHTTP_STATE_INIT && -1!=http->sockfd ) ) {
@@ -273,6 +315,89 @@ follow_redirect( fd_sshttp_t *        http,
   return FD_SSHTTP_ADVANCE_AGAIN;
 }
 
+/* begin_body transitions to downloading the response body, handing
+   out any body bytes that were received together with the headers. */
+
+static int
+begin_body( fd_sshttp_t * http,
+            ulong *       data_len,
+            uchar *       data,
+            int           parsed ) {
+  http->state = FD_SSHTTP_STATE_DL;
+  if( FD_UNLIKELY( (ulong)parsed<http->response_len ) ) {
+    if( FD_UNLIKELY( http->response_len-(ulong)parsed>http->content_len ) ) {
+      FD_LOG_WARNING(( "response body exceeds content-length %lu", http->content_len ));
+      fd_sshttp_cancel( http );
+      return FD_SSHTTP_ADVANCE_ERROR;
+    }
+    if( FD_UNLIKELY( *data_len<http->response_len-(ulong)parsed ) ) FD_LOG_ERR(( "data buffer too small %lu %lu %lu", *data_len, http->response_len, (ulong)parsed ));
+    FD_TEST( *data_len>=http->response_len-(ulong)parsed );
+    *data_len = http->response_len - (ulong)parsed;
+    fd_memcpy( data, http->response+parsed, *data_len );
+    http->content_read += *data_len;
+    return FD_SSHTTP_ADVANCE_DATA;
+  } else {
+    FD_TEST( http->response_len==(ulong)parsed );
+    return FD_SSHTTP_ADVANCE_AGAIN;
+  }
+}
+
+/* read_range_response validates the headers of a response to a range
+   request.  The peer must reply with 206 Partial Content for exactly
+   the requested range.  Peers that do not support range requests
+   reply with the full file (200) and are rejected. */
+
+static int
+read_range_response( fd_sshttp_t *       http,
+                     ulong *             data_len,
+                     uchar *             data,
+                     struct phr_header * headers,
+                     ulong               header_cnt,
+                     int                 parsed,
+                     int                 status ) {
+  if( FD_UNLIKELY( status!=206 ) ) {
+    FD_LOG_WARNING(( "unexpected response status %d to range request from http://" FD_IP4_ADDR_FMT ":%hu",
+                     status, FD_IP4_ADDR_FMT_ARGS( http->addr.addr ), fd_ushort_bswap( http->addr.port ) ));
+    fd_sshttp_cancel( http );
+    return FD_SSHTTP_ADVANCE_ERROR;
+  }
+
+  http->content_read = 0UL;
+  http->content_len  = ULONG_MAX;
+  ulong range_first  = ULONG_MAX;
+  ulong range_last   = ULONG_MAX;
+  for( ulong i=0UL; i<header_cnt; i++ ) {
+    if( headers[i].name_len==14UL && !strncasecmp( headers[i].name, "content-length", 14UL ) ) {
+      http->content_len = strtoul( headers[i].value, NULL, 10 );
+    } else if( headers[i].name_len==13UL && !strncasecmp( headers[i].name, "content-range", 13UL ) ) {
+      /* Content-Range: bytes <first>-<last>/<total> */
+      char value[ 128 ];
+      if( FD_UNLIKELY( headers[i].value_len>=sizeof(value) ) ) continue;
+      fd_memcpy( value, headers[i].value, headers[i].value_len );
+      value[ headers[i].value_len ] = '\0';
+      if( FD_UNLIKELY( strncmp( value, "bytes ", 6UL ) ) ) continue;
+      char * end;
+      range_first = strtoul( value+6UL, &end, 10 );
+      if( FD_UNLIKELY( *end!='-' ) ) { range_first = ULONG_MAX; continue; }
+      range_last = strtoul( end+1UL, &end, 10 );
+      if( FD_UNLIKELY( *end!='/' ) ) { range_first = ULONG_MAX; continue; }
+      http->range_total = strtoul( end+1UL, NULL, 10 );
+    }
+  }
+
+  if( FD_UNLIKELY( http->content_len!=http->range_sz ||
+                   range_first!=http->range_off ||
+                   range_last!=http->range_off+http->range_sz-1UL ) ) {
+    FD_LOG_WARNING(( "unexpected range in response from http://" FD_IP4_ADDR_FMT ":%hu (requested %lu-%lu)",
+                     FD_IP4_ADDR_FMT_ARGS( http->addr.addr ), fd_ushort_bswap( http->addr.port ),
+                     http->range_off, http->range_off+http->range_sz-1UL ));
+    fd_sshttp_cancel( http );
+    return FD_SSHTTP_ADVANCE_ERROR;
+  }
+
+  return begin_body( http, data_len, data, parsed );
+}
+
 static int
 read_response( fd_sshttp_t * http,
                ulong *       data_len,
@@ -317,6 +442,8 @@ read_response( fd_sshttp_t * http,
     return FD_SSHTTP_ADVANCE_AGAIN;
   }
 
+  if( FD_UNLIKELY( http->range_sz ) ) return read_range_response( http, data_len, data, headers, header_cnt, parsed, status );
+
   int is_redirect = (status==301) | (status==302) | (status==303) | (status==304) | (status==307) | (status==308);
   if( FD_UNLIKELY( is_redirect ) ) {
     return follow_redirect( http, headers, header_cnt, now );
@@ -344,18 +471,7 @@ read_response( fd_sshttp_t * http,
     return FD_SSHTTP_ADVANCE_ERROR;
   }
 
-  http->state = FD_SSHTTP_STATE_DL;
-  if( FD_UNLIKELY( (ulong)parsed<http->response_len ) ) {
-    if( FD_UNLIKELY( *data_len<http->response_len-(ulong)parsed ) ) FD_LOG_ERR(( "data buffer too small %lu %lu %lu", *data_len, http->response_len, (ulong)parsed ));
-    FD_TEST( *data_len>=http->response_len-(ulong)parsed );
-    *data_len = http->response_len - (ulong)parsed;
-    fd_memcpy( data, http->response+parsed, *data_len );
-    http->content_read += *data_len;
-    return FD_SSHTTP_ADVANCE_DATA;
-  } else {
-    FD_TEST( http->response_len==(ulong)parsed );
-    return FD_SSHTTP_ADVANCE_AGAIN;
-  }
+  return begin_body( http, data_len, data, parsed );
 }
 
 static int
@@ -371,10 +487,13 @@ read_body( fd_sshttp_t * http,
 
   long read = recvfrom( http->sockfd, data, fd_ulong_min( *data_len, http->content_len-http->content_read ), 0, NULL, NULL );
   if( FD_UNLIKELY( -1==read && errno==EAGAIN ) ) {
-    if( FD_UNLIKELY( ++http->empty_recvs>8UL ) ) {
+    if( FD_UNLIKELY( !http->range_sz && ++http->empty_recvs>8UL ) ) {
       /* If we have gone several iterations without having any data to
          read, sleep the thread for up to one millisecond, or until
-         the socket is readable again, whichever comes first. */
+         the socket is readable again, whichever comes first.  Range
+         requests are polled round robin with other connections by the
+         caller (see fd_ssrange.h), which must not block on any one of
+         them. */
       struct pollfd pfd = {
         .fd = http->sockfd,
         .events = POLLIN,
@@ -388,7 +507,12 @@ read_body( fd_sshttp_t * http,
   }
   http->empty_recvs = 0UL;
 
-  if( FD_UNLIKELY( !read ) ) return FD_SSHTTP_ADVANCE_AGAIN;
+  if( FD_UNLIKELY( !read ) ) {
+    /* The peer closed the connection before sending the full body */
+    FD_LOG_WARNING(( "connection closed after %lu of %lu bytes", http->content_read, http->content_len ));
+    fd_sshttp_cancel( http );
+    return FD_SSHTTP_ADVANCE_ERROR;
+  }
 
   *data_len = (ulong)read;
   http->content_read += (ulong)read;
@@ -406,6 +530,11 @@ fd_sshttp_content_len( fd_sshttp_t const * http ) {
   return http->content_len;
 }
 
+ulong
+fd_sshttp_range_total( fd_sshttp_t const * http ) {
+  return http->range_total;
+}
+
 int
 fd_sshttp_advance( fd_sshttp_t * http,
                    ulong *       data_len,
@@ -26,6 +26,13 @@ fd_sshttp_snapshot_name( fd_sshttp_t const * http );
 ulong
 fd_sshttp_content_len( fd_sshttp_t const * http );
 
+/* fd_sshttp_range_total returns the total size of the file, as reported
+   by the peer in response to a range request (see
+   fd_sshttp_init_range), or ULONG_MAX if unknown. */
+
+ulong
+fd_sshttp_range_total( fd_sshttp_t const * http );
+
 void
 fd_sshttp_init( fd_sshttp_t * http,
                 fd_ip4_port_t addr,
@@ -33,6 +40,24 @@ fd_sshttp_init( fd_sshttp_t * http,
                 ulong         path_len,
                 long          now );
 
+/* fd_sshttp_init_range starts downloading sz>0 bytes at offset off of
+   the file at path, using an HTTP Range request.  Redirects are not
+   followed, so path should be the resolved file name (e.g. as reported
+   by fd_sshttp_snapshot_name after a regular download).  The peer must
+   reply with 206 Partial Content for exactly the requested range,
+   otherwise fd_sshttp_advance fails with FD_SSHTTP_ADVANCE_ERROR.
+   Unlike regular downloads, advancing a range download never sleeps
+   while waiting for data. */
+
+void
+fd_sshttp_init_range( fd_sshttp_t * http,
+                      fd_ip4_port_t addr,
+                      char const *  path,
+                      ulong         path_len,
+                      ulong         off,
+                      ulong         sz,
+                      long          now );
+
 void
 fd_sshttp_cancel( fd_sshttp_t * http );
 
@@ -614,6 +614,12 @@ advance_account_garbage( fd_ssparse_t *                ssparse,
                          ulong                         data_sz,
                          fd_ssparse_advance_result_t * result ) {
   (void)data;
+  if( FD_UNLIKELY( ssparse->tar.file_bytes_consumed==ssparse->tar.file_bytes ) ) {
+    /* append vec ends exactly at the end of the file */
+    ssparse->state = FD_SSPARSE_STATE_SCROLL_TAR_HEADER;
+    return FD_SSPARSE_ADVANCE_AGAIN;
+  }
+
   ulong consume = fd_ulong_min( data_sz, ssparse->tar.file_bytes-ssparse->tar.file_bytes_consumed );
   if( FD_UNLIKELY( !consume ) ) return FD_SSPARSE_ADVANCE_ERROR;
 
@@ -334,6 +334,30 @@ fd_sspeer_selector_best( fd_sspeer_selector_t * selector,
   };
 }
 
+ulong
+fd_sspeer_selector_alternates( fd_sspeer_selector_t * selector,
+                               fd_sspeer_t const *    peer,
+                               int                    incremental,
+                               fd_sspeer_t *          out,
+                               ulong                  out_max ) {
+  ulong cnt = 0UL;
+  for( score_treap_fwd_iter_t iter = score_treap_fwd_iter_init( selector->score_treap, selector->pool );
+       !score_treap_fwd_iter_done( iter ) && cnt<out_max;
+       iter = score_treap_fwd_iter_next( iter, selector->pool ) ) {
+    fd_sspeer_private_t const * alt = score_treap_fwd_iter_ele_const( iter, selector->pool );
+    if( FD_UNLIKELY( alt->addr.l==peer->addr.l ) ) continue;
+    if( FD_LIKELY( alt->ssinfo.full.slot!=peer->ssinfo.full.slot ) ) continue;
+    if( FD_UNLIKELY( incremental && ( alt->ssinfo.incremental.base_slot!=peer->ssinfo.incremental.base_slot ||
+                                      alt->ssinfo.incremental.slot     !=peer->ssinfo.incremental.slot ) ) ) continue;
+    out[ cnt++ ] = (fd_sspeer_t){
+      .addr   = alt->addr,
+      .ssinfo = alt->ssinfo,
+      .score  = alt->score,
+    };
+  }
+  return cnt;
+}
+
 void
 fd_sspeer_selector_process_cluster_slot( fd_sspeer_selector_t * selector,
                                          ulong                  full_slot,
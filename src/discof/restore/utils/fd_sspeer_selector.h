@@ -94,6 +94,18 @@ fd_sspeer_selector_best( fd_sspeer_selector_t * selector,
                          int                    incremental,
                          ulong                  base_slot );
 
+/* Select up to out_max peers, other than the given peer, that advertise
+   the same snapshot as peer (same full slot, and if incremental is set
+   also the same incremental base slot and slot), best first.  These can
+   serve parts of the same snapshot file concurrently with peer (see
+   fd_ssrange.h).  Returns the number of peers written to out. */
+ulong
+fd_sspeer_selector_alternates( fd_sspeer_selector_t * selector,
+                               fd_sspeer_t const *    peer,
+                               int                    incremental,
+                               fd_sspeer_t *          out,
+                               ulong                  out_max );
+
 /* Updates the selector's internal cluster slot and re-score all peers
    when the cluster slot updates (moves forward) */
 void
@@ -0,0 +1,444 @@
+#include "fd_ssrange.h"
+#include "fd_sshttp.h"
+
+#include "../../../util/log/fd_log.h"
+
+#define FD_SSRANGE_BUF_ALIGN (4096UL)
+
+#define IDX_NULL (ULONG_MAX)
+
+struct fd_ssrange_seg {
+  ulong off;  /* file offset of the segment */
+  ulong sz;   /* segment size in bytes */
+  ulong rcvd; /* bytes received so far, always a prefix of the segment */
+  ulong peer; /* index of the peer downloading the segment, or IDX_NULL */
+};
+
+typedef struct fd_ssrange_seg fd_ssrange_seg_t;
+
+struct fd_ssrange_peer {
+  fd_ip4_port_t addr;
+  int           failed;
+  int           checked;   /* file size of the current response was verified */
+
+  ulong         seg;       /* segment being downloaded, or IDX_NULL if idle */
+  ulong         req_off;   /* file offset the current request started at */
+  long          req_start; /* time the current request was started */
+  long          last_recv; /* time data was last received */
+
+  ulong         rate;      /* moving average of throughput in bytes/s, 0 if unknown */
+  ulong         bytes;     /* total bytes received */
+
+  fd_sshttp_t * http;
+};
+
+typedef struct fd_ssrange_peer fd_ssrange_peer_t;
+
+struct fd_ssrange_private {
+  ulong   buf_sz;
+  ulong   seg_min;
+  uchar * buf;
+
+  char    path[ PATH_MAX ];
+  ulong   path_len;
+
+  ulong   total_sz;
+  ulong   emit_off; /* next file offset to hand out */
+  ulong   next_off; /* first file offset not covered by any segment */
+
+  ulong            seg_head; /* ring index of the oldest segment */
+  ulong            seg_cnt;
+  fd_ssrange_seg_t seg[ FD_SSRANGE_SEG_MAX ];
+
+  ulong             peer_cnt;
+  fd_ssrange_peer_t peer[ FD_SSRANGE_PEER_MAX ];
+
+  ulong magic; /* ==FD_SSRANGE_MAGIC */
+};
+
+FD_FN_CONST ulong
+fd_ssrange_align( void ) {
+  return fd_ulong_max( alignof(fd_ssrange_t), fd_ulong_max( fd_sshttp_align(), FD_SSRANGE_BUF_ALIGN ) );
+}
+
+FD_FN_CONST ulong
+fd_ssrange_footprint( ulong buf_sz ) {
+  ulong l;
+  l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, alignof(fd_ssrange_t), sizeof(fd_ssrange_t)                      );
+  l = FD_LAYOUT_APPEND( l, fd_sshttp_align(),     FD_SSRANGE_PEER_MAX*fd_sshttp_footprint() );
+  l = FD_LAYOUT_APPEND( l, FD_SSRANGE_BUF_ALIGN,  buf_sz                                    );
+  return FD_LAYOUT_FINI( l, fd_ssrange_align() );
+}
+
+void *
+fd_ssrange_new( void * shmem,
+                ulong  buf_sz,
+                ulong  seg_min ) {
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_ssrange_align() ) ) ) {
+    FD_LOG_WARNING(( "unaligned shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !seg_min || seg_min>buf_sz/4UL ) ) {
+    FD_LOG_WARNING(( "seg_min %lu must be in [1,buf_sz/4] (buf_sz %lu)", seg_min, buf_sz ));
+    return NULL;
+  }
+
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_ssrange_t * range = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_ssrange_t), sizeof(fd_ssrange_t)                      );
+  uchar * _http        = FD_SCRATCH_ALLOC_APPEND( l, fd_sshttp_align(),     FD_SSRANGE_PEER_MAX*fd_sshttp_footprint() );
+  uchar * buf          = FD_SCRATCH_ALLOC_APPEND( l, FD_SSRANGE_BUF_ALIGN,  buf_sz                                    );
+
+  range->buf_sz   = buf_sz;
+  range->seg_min  = seg_min;
+  range->buf      = buf;
+  range->path_len = 0UL;
+  range->total_sz = 0UL;
+  range->emit_off = 0UL;
+  range->next_off = 0UL;
+  range->seg_head = 0UL;
+  range->seg_cnt  = 0UL;
+  range->peer_cnt = 0UL;
+
+  for( ulong i=0UL; i<FD_SSRANGE_PEER_MAX; i++ ) {
+    range->peer[ i ].http = fd_sshttp_join( fd_sshttp_new( _http+i*fd_sshttp_footprint() ) );
+    FD_TEST( range->peer[ i ].http );
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( range->magic ) = FD_SSRANGE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return (void *)range;
+}
+
+fd_ssrange_t *
+fd_ssrange_join( void * shrange ) {
+  if( FD_UNLIKELY( !shrange ) ) {
+    FD_LOG_WARNING(( "NULL shrange" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shrange, fd_ssrange_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shrange" ));
+    return NULL;
+  }
+
+  fd_ssrange_t * range = (fd_ssrange_t *)shrange;
+
+  if( FD_UNLIKELY( range->magic!=FD_SSRANGE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return range;
+}
+
+void *
+fd_ssrange_leave( fd_ssrange_t * range ) {
+  if( FD_UNLIKELY( !range ) ) {
+    FD_LOG_WARNING(( "NULL range" ));
+    return NULL;
+  }
+
+  return (void *)range;
+}
+
+void *
+fd_ssrange_delete( void * shrange ) {
+  if( FD_UNLIKELY( !shrange ) ) {
+    FD_LOG_WARNING(( "NULL shrange" ));
+    return NULL;
+  }
+
+  fd_ssrange_t * range = (fd_ssrange_t *)shrange;
+
+  if( FD_UNLIKELY( range->magic!=FD_SSRANGE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  fd_ssrange_cancel( range );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( range->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return (void *)range;
+}
+
+void
+fd_ssrange_init( fd_ssrange_t * range,
+                 char const *   path,
+                 ulong          path_len,
+                 ulong          off,
+                 ulong          total_sz ) {
+  FD_TEST( path_len<PATH_MAX );
+  FD_TEST( off<=total_sz );
+
+  fd_ssrange_cancel( range );
+
+  fd_memcpy( range->path, path, path_len );
+  range->path[ path_len ] = '\0';
+  range->path_len = path_len;
+
+  range->total_sz = total_sz;
+  range->emit_off = off;
+  range->next_off = off;
+  range->seg_head = 0UL;
+  range->seg_cnt  = 0UL;
+  range->peer_cnt = 0UL;
+}
+
+int
+fd_ssrange_add_peer( fd_ssrange_t * range,
+                     fd_ip4_port_t  addr ) {
+  if( FD_UNLIKELY( range->peer_cnt==FD_SSRANGE_PEER_MAX ) ) return -1;
+  for( ulong i=0UL; i<range->peer_cnt; i++ ) {
+    if( FD_UNLIKELY( range->peer[ i ].addr.l==addr.l ) ) return -1;
+  }
+
+  fd_ssrange_peer_t * peer = &range->peer[ range->peer_cnt++ ];
+  peer->addr   = addr;
+  peer->failed = 0;
+  peer->seg    = IDX_NULL;
+  peer->rate   = 0UL;
+  peer->bytes  = 0UL;
+  return 0;
+}
+
+void
+fd_ssrange_cancel( fd_ssrange_t * range ) {
+  for( ulong i=0UL; i<range->peer_cnt; i++ ) {
+    fd_sshttp_cancel( range->peer[ i ].http );
+    range->peer[ i ].seg = IDX_NULL;
+  }
+}
+
+static void
+fail_peer( fd_ssrange_t *      range,
+           fd_ssrange_peer_t * peer,
+           char const *        reason ) {
+  FD_LOG_WARNING(( "dropping snapshot peer http://" FD_IP4_ADDR_FMT ":%hu from download of `%s` (%s)",
+                   FD_IP4_ADDR_FMT_ARGS( peer->addr.addr ), fd_ushort_bswap( peer->addr.port ), range->path, reason ));
+  fd_sshttp_cancel( peer->http );
+  if( FD_LIKELY( peer->seg!=IDX_NULL ) ) range->seg[ peer->seg ].peer = IDX_NULL;
+  peer->seg    = IDX_NULL;
+  peer->failed = 1;
+}
+
+/* assign gives an idle peer a segment to download.  Unassigned parts
+   of existing segments (left behind by failed or slow peers) are
+   preferred, oldest first.  Otherwise, a new segment sized by the
+   throughput of the peer is created, if it fits into the reorder
+   buffer.  Returns 1 if the peer was assigned a segment, 0 if there is
+   no work for the peer at the moment. */
+
+static int
+assign( fd_ssrange_t *      range,
+        fd_ssrange_peer_t * peer,
+        long                now ) {
+  ulong idx = IDX_NULL;
+  for( ulong i=0UL; i<range->seg_cnt; i++ ) {
+    ulong j = (range->seg_head+i)%FD_SSRANGE_SEG_MAX;
+    if( range->seg[ j ].peer==IDX_NULL && range->seg[ j ].rcvd<range->seg[ j ].sz ) {
+      idx = j;
+      break;
+    }
+  }
+
+  if( FD_LIKELY( idx==IDX_NULL ) ) {
+    if( FD_UNLIKELY( range->next_off==range->total_sz || range->seg_cnt==FD_SSRANGE_SEG_MAX ) ) return 0;
+
+    ulong want = range->seg_min;
+    if( FD_LIKELY( peer->rate ) ) want = (ulong)( (double)peer->rate*(double)FD_SSRANGE_SEG_TARGET_NANOS*1e-9 );
+    want = fd_ulong_max( fd_ulong_min( want, range->buf_sz/4UL ), range->seg_min );
+
+    /* Segments never wrap around the end of the reorder buffer, such
+       that every segment is contiguous in memory. */
+    ulong sz = fd_ulong_min( fd_ulong_min( want, range->total_sz-range->next_off ),
+                             range->buf_sz-range->next_off%range->buf_sz );
+    if( FD_UNLIKELY( range->next_off+sz>range->emit_off+range->buf_sz ) ) return 0;
+
+    idx = (range->seg_head+range->seg_cnt)%FD_SSRANGE_SEG_MAX;
+    range->seg_cnt++;
+    range->seg[ idx ] = (fd_ssrange_seg_t){
+      .off  = range->next_off,
+      .sz   = sz,
+      .rcvd = 0UL,
+      .peer = IDX_NULL
+    };
+    range->next_off += sz;
+  }
+
+  fd_ssrange_seg_t * seg = &range->seg[ idx ];
+  seg->peer       = (ulong)( peer-range->peer );
+  peer->seg       = idx;
+  peer->req_off   = seg->off+seg->rcvd;
+  peer->req_start = now;
+  peer->last_recv = now;
+  peer->checked   = 0;
+  fd_sshttp_init_range( peer->http, peer->addr, range->path, range->path_len, seg->off+seg->rcvd, seg->sz-seg->rcvd, now );
+  return 1;
+}
+
+/* steal reassigns the rest of the oldest segment, which holds up the
+   download, from its current peer to the fastest idle peer, if that
+   peer is at least twice as fast. */
+
+static void
+steal( fd_ssrange_t * range,
+       long           now ) {
+  if( FD_UNLIKELY( !range->seg_cnt ) ) return;
+  fd_ssrange_seg_t * head = &range->seg[ range->seg_head ];
+  if( FD_UNLIKELY( head->peer==IDX_NULL ) ) return;
+
+  fd_ssrange_peer_t * owner = &range->peer[ head->peer ];
+  long elapsed = now-owner->req_start;
+  if( FD_LIKELY( elapsed<FD_SSRANGE_STEAL_NANOS ) ) return;
+  ulong owner_rate = (ulong)( (double)( head->off+head->rcvd-owner->req_off )*1e9/(double)elapsed );
+
+  fd_ssrange_peer_t * fastest = NULL;
+  for( ulong i=0UL; i<range->peer_cnt; i++ ) {
+    fd_ssrange_peer_t * peer = &range->peer[ i ];
+    if( FD_UNLIKELY( peer->failed || peer->seg!=IDX_NULL ) ) continue;
+    if( !fastest || peer->rate>fastest->rate ) fastest = peer;
+  }
+  if( FD_LIKELY( !fastest || fastest->rate<=2UL*owner_rate ) ) return;
+
+  FD_LOG_INFO(( "reassigning snapshot range %lu-%lu from slow peer http://" FD_IP4_ADDR_FMT ":%hu (%lu B/s) to http://" FD_IP4_ADDR_FMT ":%hu (%lu B/s)",
+                head->off+head->rcvd, head->off+head->sz-1UL,
+                FD_IP4_ADDR_FMT_ARGS( owner->addr.addr ), fd_ushort_bswap( owner->addr.port ), owner_rate,
+                FD_IP4_ADDR_FMT_ARGS( fastest->addr.addr ), fd_ushort_bswap( fastest->addr.port ), fastest->rate ));
+
+  fd_sshttp_cancel( owner->http );
+  owner->seg  = IDX_NULL;
+  owner->rate = owner->rate ? fd_ulong_min( owner->rate, owner_rate ) : owner_rate;
+  head->peer  = IDX_NULL;
+  FD_TEST( assign( range, fastest, now ) );
+}
+
+static void
+poll_peer( fd_ssrange_t *      range,
+           fd_ssrange_peer_t * peer,
+           long                now ) {
+  fd_ssrange_seg_t * seg = &range->seg[ peer->seg ];
+  ulong   len = seg->sz-seg->rcvd;
+  uchar * dst = range->buf+(seg->off+seg->rcvd)%range->buf_sz;
+
+  int result = fd_sshttp_advance( peer->http, &len, dst, now );
+  switch( result ) {
+    case FD_SSHTTP_ADVANCE_AGAIN:
+      if( FD_UNLIKELY( now-peer->last_recv>FD_SSRANGE_STALL_NANOS ) ) fail_peer( range, peer, "stalled" );
+      break;
+    case FD_SSHTTP_ADVANCE_DATA: {
+      if( FD_UNLIKELY( !peer->checked ) ) {
+        if( FD_UNLIKELY( fd_sshttp_range_total( peer->http )!=range->total_sz ) ) {
+          fail_peer( range, peer, "file size mismatch" );
+          break;
+        }
+        peer->checked = 1;
+      }
+
+      seg->rcvd       += len;
+      peer->bytes     += len;
+      peer->last_recv  = now;
+      if( FD_LIKELY( seg->rcvd<seg->sz ) ) break;
+
+      ulong elapsed = (ulong)fd_long_max( now-peer->req_start, 1L );
+      ulong rate    = (ulong)( (double)( seg->off+seg->sz-peer->req_off )*1e9/(double)elapsed );
+      peer->rate    = peer->rate ? (3UL*peer->rate+rate)/4UL : rate;
+
+      fd_sshttp_cancel( peer->http );
+      seg->peer = IDX_NULL;
+      peer->seg = IDX_NULL;
+      break;
+    }
+    case FD_SSHTTP_ADVANCE_DONE:
+      fail_peer( range, peer, "response ended early" );
+      break;
+    case FD_SSHTTP_ADVANCE_ERROR:
+      fail_peer( range, peer, "request failed" );
+      break;
+    default: FD_LOG_ERR(( "unexpected fd_sshttp_advance result %d", result ));
+  }
+}
+
+int
+fd_ssrange_advance( fd_ssrange_t * range,
+                    ulong *        data_len,
+                    uchar *        data,
+                    long           now ) {
+  if( FD_UNLIKELY( range->emit_off==range->total_sz ) ) {
+    fd_ssrange_cancel( range );
+    return FD_SSRANGE_ADVANCE_DONE;
+  }
+
+  ulong alive_cnt = 0UL;
+  for( ulong i=0UL; i<range->peer_cnt; i++ ) {
+    fd_ssrange_peer_t * peer = &range->peer[ i ];
+    if( FD_UNLIKELY( peer->failed ) ) continue;
+    if( FD_LIKELY( peer->seg!=IDX_NULL ) ) poll_peer( range, peer, now );
+    alive_cnt += !peer->failed;
+  }
+  if( FD_UNLIKELY( !alive_cnt ) ) {
+    FD_LOG_WARNING(( "all peers failed downloading `%s`", range->path ));
+    return FD_SSRANGE_ADVANCE_ERROR;
+  }
+
+  int blocked = 0;
+  for( ulong i=0UL; i<range->peer_cnt; i++ ) {
+    fd_ssrange_peer_t * peer = &range->peer[ i ];
+    if( FD_UNLIKELY( peer->failed || peer->seg!=IDX_NULL ) ) continue;
+    blocked |= !assign( range, peer, now );
+  }
+  if( FD_UNLIKELY( blocked ) ) steal( range, now );
+
+  if( FD_UNLIKELY( !range->seg_cnt ) ) return FD_SSRANGE_ADVANCE_AGAIN;
+  fd_ssrange_seg_t * head = &range->seg[ range->seg_head ];
+  ulong avail = head->off+head->rcvd-range->emit_off;
+  if( FD_LIKELY( !avail ) ) return FD_SSRANGE_ADVANCE_AGAIN;
+
+  ulong sz = fd_ulong_min( avail, *data_len );
+  fd_memcpy( data, range->buf+range->emit_off%range->buf_sz, sz );
+  range->emit_off += sz;
+  if( FD_LIKELY( range->emit_off==head->off+head->sz ) ) {
+    range->seg_head = (range->seg_head+1UL)%FD_SSRANGE_SEG_MAX;
+    range->seg_cnt--;
+  }
+
+  *data_len = sz;
+  return FD_SSRANGE_ADVANCE_DATA;
+}
+
+ulong
+fd_ssrange_peer_cnt( fd_ssrange_t const * range ) {
+  return range->peer_cnt;
+}
+
+fd_ip4_port_t
+fd_ssrange_peer_addr( fd_ssrange_t const * range,
+                      ulong                peer_idx ) {
+  FD_TEST( peer_idx<range->peer_cnt );
+  return range->peer[ peer_idx ].addr;
+}
+
+ulong
+fd_ssrange_peer_bytes( fd_ssrange_t const * range,
+                       ulong                peer_idx ) {
+  FD_TEST( peer_idx<range->peer_cnt );
+  return range->peer[ peer_idx ].bytes;
+}
+
+int
+fd_ssrange_peer_failed( fd_ssrange_t const * range,
+                        ulong                peer_idx ) {
+  FD_TEST( peer_idx<range->peer_cnt );
+  return range->peer[ peer_idx ].failed;
+}
@@ -0,0 +1,139 @@
+#ifndef HEADER_fd_src_discof_restore_utils_fd_ssrange_h
+#define HEADER_fd_src_discof_restore_utils_fd_ssrange_h
+
+/* The snapshot range downloader (ssrange) downloads one snapshot file
+   from multiple peers concurrently, using HTTP Range requests (see
+   fd_sshttp_init_range), and hands out the file contents in order.
+
+   The file is split into segments that are assigned to peers on
+   demand.  Each peer downloads at most one segment at a time over its
+   own connection.  Received data is stored in a reorder buffer (a ring
+   of buf_sz bytes indexed by file offset), and segments are only
+   assigned within buf_sz bytes of the oldest byte not yet handed out.
+
+   Throughput is measured per peer and the size of the next segment
+   assigned to a peer is proportional to its throughput (targeting
+   about FD_SSRANGE_SEG_TARGET_NANOS per request), between seg_min and
+   a quarter of the reorder buffer.  If the oldest segment holds up the
+   download while a much faster peer is idle, the remainder of that
+   segment is reassigned to the faster peer.
+
+   Peers that fail (connection errors, stalls, unsupported or
+   inconsistent range responses, e.g. because they serve a different
+   file under the same name) are dropped, and their in-flight segment
+   is reassigned.  The download fails once all peers are dropped.
+
+   The reorder buffer and the peer connections are part of the ssrange
+   footprint. */
+
+#include "../../../util/fd_util_base.h"
+#include "../../../util/net/fd_net_headers.h"
+
+#define FD_SSRANGE_MAGIC (0xF17EDA2CE5524A00) /* FIREDANCE SSRANGE V0 */
+
+#define FD_SSRANGE_PEER_MAX (8UL)
+#define FD_SSRANGE_SEG_MAX  (64UL)
+
+#define FD_SSRANGE_SEG_TARGET_NANOS (1L*1000L*1000L*1000L) /* 1 second */
+#define FD_SSRANGE_STALL_NANOS      (10L*1000L*1000L*1000L) /* 10 seconds */
+#define FD_SSRANGE_STEAL_NANOS      (100L*1000L*1000L)      /* 100 milliseconds */
+
+#define FD_SSRANGE_ADVANCE_ERROR (-1)
+#define FD_SSRANGE_ADVANCE_AGAIN ( 0)
+#define FD_SSRANGE_ADVANCE_DATA  ( 1)
+#define FD_SSRANGE_ADVANCE_DONE  ( 2)
+
+struct fd_ssrange_private;
+typedef struct fd_ssrange_private fd_ssrange_t;
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST ulong
+fd_ssrange_align( void );
+
+FD_FN_CONST ulong
+fd_ssrange_footprint( ulong buf_sz );
+
+/* fd_ssrange_new formats a memory region as an ssrange with a reorder
+   buffer of buf_sz bytes.  seg_min is the minimum segment size, and
+   must be at most buf_sz/4. */
+
+void *
+fd_ssrange_new( void * shmem,
+                ulong  buf_sz,
+                ulong  seg_min );
+
+fd_ssrange_t *
+fd_ssrange_join( void * shrange );
+
+void *
+fd_ssrange_leave( fd_ssrange_t * range );
+
+void *
+fd_ssrange_delete( void * shrange );
+
+/* fd_ssrange_init starts downloading the file at path (the resolved
+   file name, see fd_sshttp_snapshot_name) of total_sz bytes, starting
+   at offset off.  Peers are added with fd_ssrange_add_peer before the
+   first call to fd_ssrange_advance.  Any previous download must be
+   finished or cancelled. */
+
+void
+fd_ssrange_init( fd_ssrange_t * range,
+                 char const *   path,
+                 ulong          path_len,
+                 ulong          off,
+                 ulong          total_sz );
+
+/* fd_ssrange_add_peer adds a peer serving the file to the current
+   download.  Returns 0 on success, or -1 if FD_SSRANGE_PEER_MAX peers
+   were already added or the peer was already added. */
+
+int
+fd_ssrange_add_peer( fd_ssrange_t * range,
+                     fd_ip4_port_t  addr );
+
+/* fd_ssrange_cancel closes all peer connections of the current
+   download. */
+
+void
+fd_ssrange_cancel( fd_ssrange_t * range );
+
+/* fd_ssrange_advance makes progress on all peer connections and copies
+   up to *data_len bytes of the file (following the bytes returned
+   previously) into data.  Returns FD_SSRANGE_ADVANCE_DATA with
+   *data_len set to the number of bytes copied, ..._AGAIN if no data is
+   available yet, ..._DONE once the whole file was handed out, or
+   ..._ERROR if all peers failed. */
+
+int
+fd_ssrange_advance( fd_ssrange_t * range,
+                    ulong *        data_len,
+                    uchar *        data,
+                    long           now );
+
+/* Accessors for the current download.  Peers are indexed in the order
+   they were successfully added with fd_ssrange_add_peer (rejected peers
+   get no index).  fd_ssrange_peer_addr returns the address of the peer
+   with the given index.  fd_ssrange_peer_bytes returns the number of
+   bytes received from it.  fd_ssrange_peer_failed returns whether it
+   was dropped. */
+
+ulong
+fd_ssrange_peer_cnt( fd_ssrange_t const * range );
+
+fd_ip4_port_t
+fd_ssrange_peer_addr( fd_ssrange_t const * range,
+                      ulong                peer_idx );
+
+ulong
+fd_ssrange_peer_bytes( fd_ssrange_t const * range,
+                       ulong                peer_idx );
+
+int
+fd_ssrange_peer_failed( fd_ssrange_t const * range,
+                        ulong                peer_idx );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_discof_restore_utils_fd_ssrange_h */
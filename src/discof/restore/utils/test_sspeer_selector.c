@@ -111,6 +111,21 @@ test_basic_peer_selection( fd_sspeer_selector_t * selector ) {
   FD_TEST( best.ssinfo.incremental.slot==1700UL );
   FD_TEST( best.ssinfo.incremental.base_slot==1000UL );
   FD_TEST( best.score==2L*1000L*1000L );
+
+  /* Test selecting peers serving the same snapshot */
+  fd_sspeer_t alt[ 8 ];
+  FD_TEST( fd_sspeer_selector_alternates( selector, &best, 0, alt, 8UL )==4UL );
+  for( ulong i=0UL; i<4UL; i++ ) {
+    FD_TEST( alt[ i ].addr.l!=addr7.l );
+    FD_TEST( alt[ i ].ssinfo.full.slot==1000UL );
+    if( i ) FD_TEST( alt[ i-1UL ].score<=alt[ i ].score );
+  }
+  FD_TEST( fd_sspeer_selector_alternates( selector, &best, 0, alt, 2UL )==2UL );
+  FD_TEST( fd_sspeer_selector_alternates( selector, &best, 1, alt, 8UL )==0UL );
+
+  fd_sspeer_t peer1 = { .addr = addr, .ssinfo = { .full = { .slot = 1000UL }, .incremental = { .base_slot = 1000UL, .slot = 1500UL } } };
+  FD_TEST( fd_sspeer_selector_alternates( selector, &peer1, 1, alt, 8UL )==1UL );
+  FD_TEST( alt[ 0 ].addr.l==addr2.l );
 }
 
 int
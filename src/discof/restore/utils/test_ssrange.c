@@ -0,0 +1,277 @@
+#define _GNU_SOURCE
+#include "fd_ssrange.h"
+
+#include "../../../util/fd_util.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+/* A minimal HTTP server stand-in serving range requests for one file
+   over loopback.  Servers are pumped from the test loop (no threads),
+   and each server sends at most rate body bytes per connection and
+   pump, which emulates peers with different throughput. */
+
+#define CONTENT_SZ ((1UL<<20)+12345UL)
+#define PATH       "/snapshot-1000-11111111111111111111111111111111.tar.zst"
+
+#define MODE_OK       (0) /* serves ranges of the file */
+#define MODE_NO_RANGE (1) /* ignores the Range header */
+#define MODE_MISSING  (2) /* does not have the file */
+#define MODE_OTHER    (3) /* serves a different file under the same name */
+
+#define CONN_MAX (16UL)
+
+static uchar content[ CONTENT_SZ ];
+static uchar output [ CONTENT_SZ ];
+
+typedef struct {
+  int   fd;
+  char  req[ 4096 ];
+  ulong req_len;
+  int   replied;
+  char  hdr[ 256 ];
+  ulong hdr_len;
+  ulong hdr_sent;
+  ulong pos;
+  ulong end;
+} conn_t;
+
+typedef struct {
+  int           lfd;
+  fd_ip4_port_t addr;
+  int           mode;
+  ulong         rate;
+  conn_t        conn[ CONN_MAX ];
+} srv_t;
+
+static void
+srv_init( srv_t * srv,
+          int     mode,
+          ulong   rate ) {
+  srv->mode = mode;
+  srv->rate = rate;
+  for( ulong i=0UL; i<CONN_MAX; i++ ) srv->conn[ i ].fd = -1;
+
+  srv->lfd = socket( AF_INET, SOCK_STREAM|SOCK_NONBLOCK, 0 );
+  FD_TEST( srv->lfd>=0 );
+  struct sockaddr_in addr = { .sin_family = AF_INET, .sin_addr = { .s_addr = FD_IP4_ADDR( 127, 0, 0, 1 ) } };
+  FD_TEST( !bind( srv->lfd, fd_type_pun_const( &addr ), sizeof(addr) ) );
+  FD_TEST( !listen( srv->lfd, 16 ) );
+  socklen_t addr_len = sizeof(addr);
+  FD_TEST( !getsockname( srv->lfd, fd_type_pun( &addr ), &addr_len ) );
+  srv->addr.addr = addr.sin_addr.s_addr;
+  srv->addr.port = addr.sin_port;
+}
+
+static void
+srv_fini( srv_t * srv ) {
+  for( ulong i=0UL; i<CONN_MAX; i++ ) if( srv->conn[ i ].fd>=0 ) close( srv->conn[ i ].fd );
+  close( srv->lfd );
+}
+
+static void
+conn_close( conn_t * conn ) {
+  close( conn->fd );
+  conn->fd = -1;
+}
+
+static void
+conn_reply( srv_t *  srv,
+            conn_t * conn ) {
+  ulong first = 0UL;
+  ulong last  = CONTENT_SZ-1UL;
+  char * range = strstr( conn->req, "Range: bytes=" );
+  if( range ) {
+    char * end;
+    first = strtoul( range+13, &end, 10 );
+    FD_TEST( *end=='-' );
+    last  = strtoul( end+1, NULL, 10 );
+    FD_TEST( first<=last && last<CONTENT_SZ );
+  }
+
+  int len;
+  switch( srv->mode ) {
+    case MODE_OK:
+    case MODE_OTHER:
+      len = snprintf( conn->hdr, sizeof(conn->hdr), "HTTP/1.1 206 Partial Content\r\nContent-Length: %lu\r\nContent-Range: bytes %lu-%lu/%lu\r\n\r\n",
+                      last-first+1UL, first, last, CONTENT_SZ+(ulong)(srv->mode==MODE_OTHER) );
+      break;
+    case MODE_NO_RANGE:
+      first = 0UL;
+      last  = CONTENT_SZ-1UL;
+      len = snprintf( conn->hdr, sizeof(conn->hdr), "HTTP/1.1 200 OK\r\nContent-Length: %lu\r\n\r\n", CONTENT_SZ );
+      break;
+    default:
+      first = 1UL;
+      last  = 0UL;
+      len = snprintf( conn->hdr, sizeof(conn->hdr), "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n" );
+      break;
+  }
+  FD_TEST( len>0 && (ulong)len<sizeof(conn->hdr) );
+  conn->hdr_len  = (ulong)len;
+  conn->hdr_sent = 0UL;
+  conn->pos      = first;
+  conn->end      = last+1UL;
+  conn->replied  = 1;
+}
+
+static void
+srv_pump( srv_t * srv ) {
+  int fd = accept4( srv->lfd, NULL, NULL, SOCK_NONBLOCK );
+  if( fd>=0 ) {
+    ulong i = 0UL;
+    while( i<CONN_MAX && srv->conn[ i ].fd>=0 ) i++;
+    FD_TEST( i<CONN_MAX );
+    srv->conn[ i ] = (conn_t){ .fd = fd };
+  } else {
+    FD_TEST( errno==EAGAIN );
+  }
+
+  for( ulong i=0UL; i<CONN_MAX; i++ ) {
+    conn_t * conn = &srv->conn[ i ];
+    if( conn->fd<0 ) continue;
+
+    if( !conn->replied ) {
+      long n = recv( conn->fd, conn->req+conn->req_len, sizeof(conn->req)-1UL-conn->req_len, 0 );
+      if( n<0 && errno==EAGAIN ) continue;
+      if( n<=0 ) { conn_close( conn ); continue; }
+      conn->req_len += (ulong)n;
+      conn->req[ conn->req_len ] = '\0';
+      if( !strstr( conn->req, "\r\n\r\n" ) ) continue;
+      FD_TEST( !strncmp( conn->req, "GET " PATH " HTTP/1.1\r\n", strlen( "GET " PATH " HTTP/1.1\r\n" ) ) );
+      conn_reply( srv, conn );
+    }
+
+    if( conn->hdr_sent<conn->hdr_len ) {
+      long n = send( conn->fd, conn->hdr+conn->hdr_sent, conn->hdr_len-conn->hdr_sent, MSG_NOSIGNAL );
+      if( n<0 && errno==EAGAIN ) continue;
+      if( n<0 ) { conn_close( conn ); continue; }
+      conn->hdr_sent += (ulong)n;
+      if( conn->hdr_sent<conn->hdr_len ) continue;
+    }
+
+    if( conn->pos<conn->end ) {
+      long n = send( conn->fd, content+conn->pos, fd_ulong_min( srv->rate, conn->end-conn->pos ), MSG_NOSIGNAL );
+      if( n<0 && errno==EAGAIN ) continue;
+      if( n<0 ) { conn_close( conn ); continue; }
+      conn->pos += (ulong)n;
+    }
+
+    if( conn->pos>=conn->end ) {
+      /* Wait for the client to close the connection */
+      char c;
+      long n = recv( conn->fd, &c, 1UL, 0 );
+      if( !(n<0 && errno==EAGAIN) ) conn_close( conn );
+    }
+  }
+}
+
+static int
+download( fd_ssrange_t * range,
+          srv_t *        srv,
+          ulong          srv_cnt,
+          ulong          off ) {
+  fd_ssrange_init( range, PATH, strlen( PATH ), off, CONTENT_SZ );
+  for( ulong i=0UL; i<srv_cnt; i++ ) FD_TEST( !fd_ssrange_add_peer( range, srv[ i ].addr ) );
+  FD_TEST( fd_ssrange_add_peer( range, srv[ 0 ].addr )==-1 );
+  FD_TEST( fd_ssrange_peer_cnt( range )==srv_cnt );
+  for( ulong i=0UL; i<srv_cnt; i++ ) FD_TEST( fd_ssrange_peer_addr( range, i ).l==srv[ i ].addr.l );
+
+  ulong out_sz = off;
+  long  deadline = fd_log_wallclock() + 30L*1000L*1000L*1000L;
+  while( fd_log_wallclock()<deadline ) {
+    for( ulong i=0UL; i<srv_cnt; i++ ) srv_pump( &srv[ i ] );
+
+    ulong len = fd_ulong_min( 4096UL, CONTENT_SZ-out_sz );
+    int result = fd_ssrange_advance( range, &len, output+out_sz, fd_log_wallclock() );
+    switch( result ) {
+      case FD_SSRANGE_ADVANCE_AGAIN: break;
+      case FD_SSRANGE_ADVANCE_DATA:
+        FD_TEST( len && out_sz+len<=CONTENT_SZ );
+        out_sz += len;
+        break;
+      case FD_SSRANGE_ADVANCE_DONE:
+        FD_TEST( out_sz==CONTENT_SZ );
+        FD_TEST( fd_memeq( output+off, content+off, CONTENT_SZ-off ) );
+        return 0;
+      case FD_SSRANGE_ADVANCE_ERROR:
+        fd_ssrange_cancel( range );
+        return -1;
+      default: FD_LOG_ERR(( "unexpected result %d", result ));
+    }
+  }
+  FD_LOG_ERR(( "download timed out at %lu/%lu bytes", out_sz, CONTENT_SZ ));
+}
+
+static uchar mem[ 1UL<<21 ] __attribute__((aligned(4096)));
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 1234U, 0UL ) );
+  for( ulong i=0UL; i<CONTENT_SZ; i++ ) content[ i ] = fd_rng_uchar( rng );
+
+  ulong buf_sz  = 256UL<<10;
+  ulong seg_min = 16UL<<10;
+  FD_TEST( fd_ssrange_footprint( buf_sz )<=sizeof(mem) );
+  FD_TEST( !fd_ssrange_new( mem, buf_sz, buf_sz ) );
+  fd_ssrange_t * range = fd_ssrange_join( fd_ssrange_new( mem, buf_sz, seg_min ) );
+  FD_TEST( range );
+
+  /* Peers of different speed, faster peers take a larger share */
+  srv_t srv[ 4 ];
+  srv_init( &srv[ 0 ], MODE_OK, 64UL<<10 );
+  srv_init( &srv[ 1 ], MODE_OK, 16UL<<10 );
+  srv_init( &srv[ 2 ], MODE_OK, 512UL    );
+  FD_TEST( !download( range, srv, 3UL, 0UL ) );
+  FD_TEST( !fd_ssrange_peer_failed( range, 0UL ) && !fd_ssrange_peer_failed( range, 1UL ) && !fd_ssrange_peer_failed( range, 2UL ) );
+  FD_TEST( fd_ssrange_peer_bytes( range, 0UL )>fd_ssrange_peer_bytes( range, 2UL ) );
+  FD_LOG_NOTICE(( "received %lu/%lu/%lu bytes from peers", fd_ssrange_peer_bytes( range, 0UL ), fd_ssrange_peer_bytes( range, 1UL ), fd_ssrange_peer_bytes( range, 2UL ) ));
+
+  /* Resume after bytes already received from a single peer */
+  FD_TEST( !download( range, srv, 1UL, 70000UL ) );
+  FD_TEST( fd_ssrange_peer_bytes( range, 0UL )==CONTENT_SZ-70000UL );
+  for( ulong i=0UL; i<3UL; i++ ) srv_fini( &srv[ i ] );
+
+  /* Peers that cannot serve ranges of the same file are dropped */
+  srv_init( &srv[ 0 ], MODE_NO_RANGE, 64UL<<10 );
+  srv_init( &srv[ 1 ], MODE_MISSING,  64UL<<10 );
+  srv_init( &srv[ 2 ], MODE_OTHER,    64UL<<10 );
+  srv_init( &srv[ 3 ], MODE_OK,       32UL<<10 );
+  FD_TEST( !download( range, srv, 4UL, 0UL ) );
+  FD_TEST( fd_ssrange_peer_failed( range, 0UL ) );
+  FD_TEST( fd_ssrange_peer_failed( range, 1UL ) );
+  FD_TEST( fd_ssrange_peer_failed( range, 2UL ) );
+  FD_TEST( !fd_ssrange_peer_failed( range, 3UL ) );
+  FD_TEST( fd_ssrange_peer_bytes( range, 3UL )==CONTENT_SZ );
+
+  /* The download fails once all peers were dropped */
+  FD_TEST( download( range, srv, 3UL, 0UL )==-1 );
+  for( ulong i=0UL; i<4UL; i++ ) srv_fini( &srv[ i ] );
+
+  /* Rejected duplicate peers get no index */
+  fd_ip4_port_t peer_addr[ 3 ];
+  for( ulong i=0UL; i<3UL; i++ ) peer_addr[ i ] = (fd_ip4_port_t){ .addr = FD_IP4_ADDR( 127, 0, 0, 1 ), .port = fd_ushort_bswap( (ushort)( 9000UL+i ) ) };
+  fd_ssrange_init( range, PATH, strlen( PATH ), 0UL, CONTENT_SZ );
+  FD_TEST( !fd_ssrange_add_peer( range, peer_addr[ 0 ] ) );
+  FD_TEST( !fd_ssrange_add_peer( range, peer_addr[ 1 ] ) );
+  FD_TEST( fd_ssrange_add_peer( range, peer_addr[ 0 ] )==-1 );
+  FD_TEST( !fd_ssrange_add_peer( range, peer_addr[ 2 ] ) );
+  FD_TEST( fd_ssrange_peer_cnt( range )==3UL );
+  for( ulong i=0UL; i<3UL; i++ ) FD_TEST( fd_ssrange_peer_addr( range, i ).l==peer_addr[ i ].l );
+  fd_ssrange_cancel( range );
+
+  FD_TEST( fd_ssrange_delete( fd_ssrange_leave( range ) )==mem );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
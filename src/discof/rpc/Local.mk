@@ -1,3 +1,9 @@
+ifdef FD_HAS_HOSTED
+$(call add-objs,fd_rpc_pubsub,fd_discof)
+$(call make-unit-test,test_rpc_pubsub,test_rpc_pubsub,fd_discof fd_waltz fd_ballet fd_util)
+$(call run-unit-test,test_rpc_pubsub)
+endif
+
 ifdef FD_HAS_ALLOCA
 ifdef FD_HAS_INT128
 $(call add-objs,fd_rpc_tile,fd_discof)
@@ -0,0 +1,256 @@
+#include "fd_rpc_pubsub.h"
+#include "../../util/fd_util.h"
+
+#define IDX_NULL (ULONG_MAX)
+
+/* A list holds the connections subscribed to one kind of notification
+   in a dense array, so that a notification can be multicast straight
+   from it and a connection can leave in O(1) by swapping in the last
+   entry. */
+
+struct fd_rpc_pubsub_list {
+  ulong   sub_id;
+  ulong   cnt;
+  ulong * conn_ids;  /* cnt subscribed connections, max_ws_conn_cnt long */
+  ulong * conn_pos;  /* index of each connection in conn_ids, IDX_NULL if not subscribed */
+};
+
+typedef struct fd_rpc_pubsub_list fd_rpc_pubsub_list_t;
+
+struct __attribute__((aligned(FD_RPC_PUBSUB_ALIGN))) fd_rpc_pubsub_private {
+  ulong magic;
+
+  ulong max_ws_conn_cnt;
+  ulong next_sub_id;
+
+  fd_rpc_pubsub_list_t list[ FD_RPC_PUBSUB_KIND_CNT ];
+
+  int     notify_kind;      /* Kind between notify_begin and notify_end, -1 if none */
+  ulong * notify_conn_ids;  /* Recipients for fd_http_server_ws_multicast, max_ws_conn_cnt long */
+};
+
+static char const * const notification_method[ FD_RPC_PUBSUB_KIND_CNT ] = {
+  [ FD_RPC_PUBSUB_KIND_SLOT ] = "slotNotification",
+  [ FD_RPC_PUBSUB_KIND_ROOT ] = "rootNotification",
+};
+
+FD_FN_CONST ulong
+fd_rpc_pubsub_align( void ) {
+  return FD_RPC_PUBSUB_ALIGN;
+}
+
+FD_FN_CONST ulong
+fd_rpc_pubsub_footprint( ulong max_ws_conn_cnt ) {
+  if( FD_UNLIKELY( !max_ws_conn_cnt || max_ws_conn_cnt>=UINT_MAX ) ) return 0UL;
+
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, FD_RPC_PUBSUB_ALIGN, sizeof(fd_rpc_pubsub_t)                                   );
+  l = FD_LAYOUT_APPEND( l, alignof(ulong),      (2UL*FD_RPC_PUBSUB_KIND_CNT+1UL)*max_ws_conn_cnt*sizeof(ulong) );
+  return FD_LAYOUT_FINI( l, FD_RPC_PUBSUB_ALIGN );
+}
+
+void *
+fd_rpc_pubsub_new( void * shmem,
+                   ulong  max_ws_conn_cnt ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_rpc_pubsub_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_rpc_pubsub_footprint( max_ws_conn_cnt ) ) ) {
+    FD_LOG_WARNING(( "invalid max_ws_conn_cnt %lu", max_ws_conn_cnt ));
+    return NULL;
+  }
+
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_rpc_pubsub_t * pubsub = FD_SCRATCH_ALLOC_APPEND( l, FD_RPC_PUBSUB_ALIGN, sizeof(fd_rpc_pubsub_t)                                   );
+  ulong *           ids    = FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong),      (2UL*FD_RPC_PUBSUB_KIND_CNT+1UL)*max_ws_conn_cnt*sizeof(ulong) );
+
+  pubsub->max_ws_conn_cnt = max_ws_conn_cnt;
+  pubsub->next_sub_id     = 0UL;
+
+  for( ulong kind=0UL; kind<FD_RPC_PUBSUB_KIND_CNT; kind++ ) {
+    fd_rpc_pubsub_list_t * list = &pubsub->list[ kind ];
+    list->sub_id   = IDX_NULL;
+    list->cnt      = 0UL;
+    list->conn_ids = ids; ids += max_ws_conn_cnt;
+    list->conn_pos = ids; ids += max_ws_conn_cnt;
+    for( ulong i=0UL; i<max_ws_conn_cnt; i++ ) list->conn_pos[ i ] = IDX_NULL;
+  }
+
+  pubsub->notify_kind     = -1;
+  pubsub->notify_conn_ids = ids;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( pubsub->magic ) = FD_RPC_PUBSUB_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return (void *)pubsub;
+}
+
+fd_rpc_pubsub_t *
+fd_rpc_pubsub_join( void * shpubsub ) {
+
+  if( FD_UNLIKELY( !shpubsub ) ) {
+    FD_LOG_WARNING(( "NULL shpubsub" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shpubsub, fd_rpc_pubsub_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shpubsub" ));
+    return NULL;
+  }
+
+  fd_rpc_pubsub_t * pubsub = (fd_rpc_pubsub_t *)shpubsub;
+
+  if( FD_UNLIKELY( pubsub->magic!=FD_RPC_PUBSUB_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return pubsub;
+}
+
+void *
+fd_rpc_pubsub_leave( fd_rpc_pubsub_t * pubsub ) {
+
+  if( FD_UNLIKELY( !pubsub ) ) {
+    FD_LOG_WARNING(( "NULL pubsub" ));
+    return NULL;
+  }
+
+  return (void *)pubsub;
+}
+
+void *
+fd_rpc_pubsub_delete( void * shpubsub ) {
+
+  if( FD_UNLIKELY( !shpubsub ) ) {
+    FD_LOG_WARNING(( "NULL shpubsub" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shpubsub, fd_rpc_pubsub_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shpubsub" ));
+    return NULL;
+  }
+
+  fd_rpc_pubsub_t * pubsub = (fd_rpc_pubsub_t *)shpubsub;
+
+  if( FD_UNLIKELY( pubsub->magic!=FD_RPC_PUBSUB_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( pubsub->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return (void *)pubsub;
+}
+
+/* list_remove unsubscribes connection ws_conn_id from list, which it
+   must be subscribed to. */
+
+static void
+list_remove( fd_rpc_pubsub_list_t * list,
+             ulong                  ws_conn_id ) {
+  ulong pos  = list->conn_pos[ ws_conn_id ];
+  ulong last = list->conn_ids[ --list->cnt ];
+  list->conn_ids[ pos  ] = last;
+  list->conn_pos[ last ] = pos;
+  list->conn_pos[ ws_conn_id ] = IDX_NULL;
+}
+
+ulong
+fd_rpc_pubsub_subscribe( fd_rpc_pubsub_t * pubsub,
+                         ulong             ws_conn_id,
+                         int               kind ) {
+  FD_TEST( ws_conn_id<pubsub->max_ws_conn_cnt );
+  FD_TEST( kind>=0 && kind<FD_RPC_PUBSUB_KIND_CNT );
+  fd_rpc_pubsub_list_t * list = &pubsub->list[ kind ];
+
+  if( FD_UNLIKELY( list->conn_pos[ ws_conn_id ]!=IDX_NULL ) ) return list->sub_id;
+
+  if( FD_UNLIKELY( !list->cnt ) ) list->sub_id = pubsub->next_sub_id++;
+  list->conn_pos[ ws_conn_id ]   = list->cnt;
+  list->conn_ids[ list->cnt++ ] = ws_conn_id;
+  return list->sub_id;
+}
+
+int
+fd_rpc_pubsub_unsubscribe( fd_rpc_pubsub_t * pubsub,
+                           ulong             ws_conn_id,
+                           int               kind,
+                           ulong             sub_id ) {
+  FD_TEST( ws_conn_id<pubsub->max_ws_conn_cnt );
+  if( FD_UNLIKELY( kind<0 || kind>=FD_RPC_PUBSUB_KIND_CNT ) ) return -1;
+  fd_rpc_pubsub_list_t * list = &pubsub->list[ kind ];
+
+  if( FD_UNLIKELY( list->conn_pos[ ws_conn_id ]==IDX_NULL || list->sub_id!=sub_id ) ) return -1;
+  list_remove( list, ws_conn_id );
+  return 0;
+}
+
+void
+fd_rpc_pubsub_ws_close( fd_rpc_pubsub_t * pubsub,
+                        ulong             ws_conn_id ) {
+  FD_TEST( ws_conn_id<pubsub->max_ws_conn_cnt );
+  for( ulong kind=0UL; kind<FD_RPC_PUBSUB_KIND_CNT; kind++ ) {
+    fd_rpc_pubsub_list_t * list = &pubsub->list[ kind ];
+    if( list->conn_pos[ ws_conn_id ]!=IDX_NULL ) list_remove( list, ws_conn_id );
+  }
+}
+
+int
+fd_rpc_pubsub_notify_begin( fd_rpc_pubsub_t *  pubsub,
+                            fd_http_server_t * http,
+                            int                kind ) {
+  FD_TEST( kind>=0 && kind<FD_RPC_PUBSUB_KIND_CNT );
+  fd_rpc_pubsub_list_t const * list = &pubsub->list[ kind ];
+  if( FD_LIKELY( !list->cnt ) ) return -1;
+
+  pubsub->notify_kind = kind;
+  fd_http_server_printf( http, "{\"jsonrpc\":\"2.0\",\"method\":\"%s\",\"params\":{\"subscription\":%lu,\"result\":",
+                         notification_method[ kind ], list->sub_id );
+  return 0;
+}
+
+int
+fd_rpc_pubsub_notify_end( fd_rpc_pubsub_t *  pubsub,
+                          fd_http_server_t * http ) {
+  FD_TEST( pubsub->notify_kind>=0 );
+  fd_rpc_pubsub_list_t const * list = &pubsub->list[ pubsub->notify_kind ];
+  pubsub->notify_kind = -1;
+
+  fd_http_server_printf( http, "}}" );
+
+  /* The multicast might close subscribers that are too slow, which
+     (through the ws_close callback) reorders the list, so multicast
+     from a copy. */
+  ulong cnt = list->cnt;
+  fd_memcpy( pubsub->notify_conn_ids, list->conn_ids, cnt*sizeof(ulong) );
+  return fd_http_server_ws_multicast( http, pubsub->notify_conn_ids, cnt );
+}
+
+ulong
+fd_rpc_pubsub_conn_sub_cnt( fd_rpc_pubsub_t const * pubsub,
+                            ulong                   ws_conn_id ) {
+  FD_TEST( ws_conn_id<pubsub->max_ws_conn_cnt );
+  ulong cnt = 0UL;
+  for( ulong kind=0UL; kind<FD_RPC_PUBSUB_KIND_CNT; kind++ ) cnt += (ulong)( pubsub->list[ kind ].conn_pos[ ws_conn_id ]!=IDX_NULL );
+  return cnt;
+}
+
+ulong
+fd_rpc_pubsub_subscriber_cnt( fd_rpc_pubsub_t const * pubsub,
+                              int                     kind ) {
+  FD_TEST( kind>=0 && kind<FD_RPC_PUBSUB_KIND_CNT );
+  return pubsub->list[ kind ].cnt;
+}
@@ -0,0 +1,118 @@
+#ifndef HEADER_fd_src_discof_rpc_fd_rpc_pubsub_h
+#define HEADER_fd_src_discof_rpc_fd_rpc_pubsub_h
+
+/* fd_rpc_pubsub tracks the PubSub subscriptions (slotSubscribe and
+   rootSubscribe) of the RPC tile's WebSocket clients and fans out
+   notifications to them.
+
+   Neither subscription takes parameters, so as in Agave all clients of
+   one kind share a single subscription and get the same subscription
+   ID.  Each kind keeps a list of its subscribed connections.  A
+   notification is rendered into the http server staging buffer once,
+   compressed at most once, and then queued as the same frame to every
+   subscriber, instead of being encoded once per connection.
+
+   All memory is preallocated, so subscribing never fails. */
+
+#include "../../waltz/http/fd_http_server.h"
+
+#define FD_RPC_PUBSUB_ALIGN (128UL)
+
+#define FD_RPC_PUBSUB_MAGIC (0xF17EDA2CEB5B5B00UL) /* FIREDANCER PUBSUB V0 */
+
+#define FD_RPC_PUBSUB_KIND_SLOT (0)
+#define FD_RPC_PUBSUB_KIND_ROOT (1)
+#define FD_RPC_PUBSUB_KIND_CNT  (2)
+
+struct fd_rpc_pubsub_private;
+typedef struct fd_rpc_pubsub_private fd_rpc_pubsub_t;
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST ulong
+fd_rpc_pubsub_align( void );
+
+FD_FN_CONST ulong
+fd_rpc_pubsub_footprint( ulong max_ws_conn_cnt );
+
+void *
+fd_rpc_pubsub_new( void * shmem,
+                   ulong  max_ws_conn_cnt );
+
+fd_rpc_pubsub_t *
+fd_rpc_pubsub_join( void * shpubsub );
+
+void *
+fd_rpc_pubsub_leave( fd_rpc_pubsub_t * pubsub );
+
+void *
+fd_rpc_pubsub_delete( void * shpubsub );
+
+/* fd_rpc_pubsub_subscribe subscribes WebSocket connection ws_conn_id
+   (in [0,max_ws_conn_cnt)) to notifications of the given kind
+   (FD_RPC_PUBSUB_KIND_*), and returns the subscription ID.  Subscribing
+   a connection to a kind it is already subscribed to returns the
+   existing ID.  A kind gets a fresh ID whenever it gains a subscriber
+   after having none. */
+
+ulong
+fd_rpc_pubsub_subscribe( fd_rpc_pubsub_t * pubsub,
+                         ulong             ws_conn_id,
+                         int               kind );
+
+/* fd_rpc_pubsub_unsubscribe removes the subscription of connection
+   ws_conn_id with the given ID.  Returns 0 on success, and -1 if the
+   connection holds no subscription of that kind with that ID. */
+
+int
+fd_rpc_pubsub_unsubscribe( fd_rpc_pubsub_t * pubsub,
+                           ulong             ws_conn_id,
+                           int               kind,
+                           ulong             sub_id );
+
+/* fd_rpc_pubsub_ws_close removes all subscriptions of connection
+   ws_conn_id.  Should be called when the connection is closed, as the
+   connection ID will be reused. */
+
+void
+fd_rpc_pubsub_ws_close( fd_rpc_pubsub_t * pubsub,
+                        ulong             ws_conn_id );
+
+/* fd_rpc_pubsub_notify_{begin,end} send a notification to all
+   subscribers of the given kind.  begin returns -1 if nobody is
+   subscribed, in which case nothing is staged and the caller should
+   skip rendering the notification altogether.  Otherwise, begin stages
+   the start of the notification envelope
+
+     {"jsonrpc":"2.0","method":"<kind>Notification","params":{"subscription":<id>,"result":
+
+   to the http server and returns 0, and the caller then stages the
+   JSON result value and calls end.  end closes the envelope and queues
+   the message to every subscriber with fd_http_server_ws_multicast,
+   returning its result.  The caller should not modify subscriptions
+   between begin and end. */
+
+int
+fd_rpc_pubsub_notify_begin( fd_rpc_pubsub_t *  pubsub,
+                            fd_http_server_t * http,
+                            int                kind );
+
+int
+fd_rpc_pubsub_notify_end( fd_rpc_pubsub_t *  pubsub,
+                          fd_http_server_t * http );
+
+/* Accessors, mostly for testing.  conn_sub_cnt returns the number of
+   subscriptions held by connection ws_conn_id, and subscriber_cnt the
+   number of connections subscribed to the given kind. */
+
+ulong
+fd_rpc_pubsub_conn_sub_cnt( fd_rpc_pubsub_t const * pubsub,
+                            ulong                   ws_conn_id );
+
+ulong
+fd_rpc_pubsub_subscriber_cnt( fd_rpc_pubsub_t const * pubsub,
+                              int                     kind );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_discof_rpc_fd_rpc_pubsub_h */
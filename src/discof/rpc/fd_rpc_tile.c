@@ -1,5 +1,6 @@
 #include "../replay/fd_replay_tile.h"
 #include "../genesis/fd_genesi_tile.h"
+#include "fd_rpc_pubsub.h"
 #include "../../disco/topo/fd_topo.h"
 #include "../../disco/keyguard/fd_keyload.h"
 #include "../../disco/keyguard/fd_keyswitch.h"
@@ -16,7 +17,8 @@
 
 #include "generated/fd_rpc_tile_seccomp.h"
 
-#define FD_HTTP_SERVER_RPC_MAX_REQUEST_LEN 8192UL
+#define FD_HTTP_SERVER_RPC_MAX_REQUEST_LEN       8192UL
+#define FD_HTTP_SERVER_RPC_MAX_WS_SEND_FRAME_CNT 1024UL
 
 #define IN_KIND_REPLAY (0)
 #define IN_KIND_GENESI (0)
@@ -106,16 +108,23 @@
 #define FD_RPC_ERROR_SLOT_NOT_EPOCH_BOUNDARY                     (-32018)
 #define FD_RPC_ERROR_LONG_TERM_STORAGE_UNREACHABLE               (-32019)
 
+// Standard JSON-RPC 2.0 errors
+#define FD_RPC_ERROR_PARSE_ERROR                                 (-32700)
+#define FD_RPC_ERROR_INVALID_REQUEST                             (-32600)
+#define FD_RPC_ERROR_METHOD_NOT_FOUND                            (-32601)
+#define FD_RPC_ERROR_INVALID_PARAMS                              (-32602)
+#define FD_RPC_ERROR_INTERNAL_ERROR                              (-32603)
+
 static fd_http_server_params_t
 derive_http_params( fd_topo_tile_t const * tile ) {
   return (fd_http_server_params_t) {
     .max_connection_cnt    = tile->rpc.max_http_connections,
-    .max_ws_connection_cnt = 0UL,
+    .max_ws_connection_cnt = tile->rpc.max_websocket_connections,
     .max_request_len       = FD_HTTP_SERVER_RPC_MAX_REQUEST_LEN,
-    .max_ws_recv_frame_len = 0UL,
-    .max_ws_send_frame_cnt = 0UL,
+    .max_ws_recv_frame_len = FD_HTTP_SERVER_RPC_MAX_REQUEST_LEN,
+    .max_ws_send_frame_cnt = FD_HTTP_SERVER_RPC_MAX_WS_SEND_FRAME_CNT,
     .outgoing_buffer_sz    = tile->rpc.send_buffer_size_mb * (1UL<<20UL),
-    .compress_websocket    = 0,
+    .compress_websocket    = 1,
   };
 }
 
@@ -163,6 +172,7 @@ typedef struct bank_info bank_info_t;
 
 struct fd_rpc_tile {
   fd_http_server_t * http;
+  fd_rpc_pubsub_t *  pubsub; /* NULL if WebSockets are disabled */
 
   bank_info_t * banks;
 
@@ -195,16 +205,25 @@ scratch_align( void ) {
   return alignof( fd_rpc_tile_t );
 }
 
+FD_FN_PURE static inline ulong
+pubsub_footprint( fd_topo_tile_t const * tile ) {
+  if( FD_UNLIKELY( !tile->rpc.max_websocket_connections ) ) return 0UL;
+  return fd_rpc_pubsub_footprint( tile->rpc.max_websocket_connections );
+}
+
 FD_FN_PURE static inline ulong
 scratch_footprint( fd_topo_tile_t const * tile ) {
   ulong http_fp = fd_http_server_footprint( derive_http_params( tile ) );
   if( FD_UNLIKELY( !http_fp ) ) FD_LOG_ERR(( "Invalid [tiles.rpc] config parameters" ));
+  ulong pubsub_fp = pubsub_footprint( tile );
+  if( FD_UNLIKELY( tile->rpc.max_websocket_connections && !pubsub_fp ) ) FD_LOG_ERR(( "Invalid [tiles.rpc] config parameters" ));
 
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof( fd_rpc_tile_t ), sizeof( fd_rpc_tile_t )                      );
   l = FD_LAYOUT_APPEND( l, fd_http_server_align(),   http_fp                                      );
   l = FD_LAYOUT_APPEND( l, fd_alloc_align(),         fd_alloc_footprint()                         );
   l = FD_LAYOUT_APPEND( l, alignof(bank_info_t),     tile->rpc.max_live_slots*sizeof(bank_info_t) );
+  l = FD_LAYOUT_APPEND( l, fd_rpc_pubsub_align(),    pubsub_fp                                    );
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
 
@@ -234,6 +253,29 @@ before_credit( fd_rpc_tile_t *     ctx,
   }
 }
 
+/* notify_{slot,root} send slotNotification and rootNotification
+   messages to PubSub subscribers.  As neither subscription takes any
+   parameters, every subscriber shares the one subscription, and the
+   message is rendered once. */
+
+static void
+notify_slot( fd_rpc_tile_t * ctx,
+             ulong           slot,
+             ulong           parent_slot,
+             ulong           root_slot ) {
+  if( FD_LIKELY( !ctx->pubsub || fd_rpc_pubsub_notify_begin( ctx->pubsub, ctx->http, FD_RPC_PUBSUB_KIND_SLOT ) ) ) return;
+  fd_http_server_printf( ctx->http, "{\"parent\":%lu,\"root\":%lu,\"slot\":%lu}", parent_slot, root_slot, slot );
+  if( FD_UNLIKELY( fd_rpc_pubsub_notify_end( ctx->pubsub, ctx->http ) ) ) FD_LOG_WARNING(( "dropped slotNotification (send buffer full)" ));
+}
+
+static void
+notify_root( fd_rpc_tile_t * ctx,
+             ulong           root_slot ) {
+  if( FD_LIKELY( !ctx->pubsub || fd_rpc_pubsub_notify_begin( ctx->pubsub, ctx->http, FD_RPC_PUBSUB_KIND_ROOT ) ) ) return;
+  fd_http_server_printf( ctx->http, "%lu", root_slot );
+  if( FD_UNLIKELY( fd_rpc_pubsub_notify_end( ctx->pubsub, ctx->http ) ) ) FD_LOG_WARNING(( "dropped rootNotification (send buffer full)" ));
+}
+
 static inline int
 returnable_frag( fd_rpc_tile_t *     ctx,
                  ulong               in_idx,
@@ -277,6 +319,12 @@ returnable_frag( fd_rpc_tile_t *     ctx,
         bank->rent.exemption_threshold     = slot_completed->rent.exemption_threshold;
         bank->rent.burn_percent            = slot_completed->rent.burn_percent;
 
+        notify_slot( ctx, slot_completed->slot, slot_completed->parent_slot, slot_completed->root_slot );
+        break;
+      }
+      case REPLAY_SIG_ROOT_ADVANCED: {
+        fd_replay_root_advanced_t const * root_advanced = fd_chunk_to_laddr_const( ctx->in[ in_idx ].mem, chunk );
+        notify_root( ctx, ctx->banks[ root_advanced->bank_idx ].slot );
         break;
       }
       case REPLAY_SIG_RESET: {
@@ -856,6 +904,18 @@ static fd_http_server_response_t
 rpc_http_request( fd_http_server_request_t const * request ) {
   fd_rpc_tile_t * ctx = (fd_rpc_tile_t *)request->ctx;
 
+  if( FD_UNLIKELY( request->method==FD_HTTP_SERVER_METHOD_GET && request->headers.upgrade_websocket && ctx->pubsub ) ) {
+    return (fd_http_server_response_t){
+      .status            = 200,
+      .upgrade_websocket = 1,
+#ifdef FD_HAS_ZSTD
+      .compress_websocket = request->headers.compress_websocket,
+#else
+      .compress_websocket = 0,
+#endif
+    };
+  }
+
   if( FD_UNLIKELY( request->method!=FD_HTTP_SERVER_METHOD_POST ) ) {
     return (fd_http_server_response_t){
       .status = 400,
@@ -945,6 +1005,105 @@ bad_request:
   return (fd_http_server_response_t){ .status = 400 };
 }
 
+/* PubSub requests arrive as JSON-RPC messages on a WebSocket, and are
+   answered on the same connection.  A request_id of ULONG_MAX is sent
+   back as a null id, for requests too malformed to have one. */
+
+static void
+ws_reply_error( fd_rpc_tile_t * ctx,
+                ulong           ws_conn_id,
+                ulong           request_id,
+                int             code,
+                char const *    message ) {
+  fd_http_server_printf( ctx->http, "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":%d,\"message\":\"%s\"},\"id\":", code, message );
+  if( FD_LIKELY( request_id!=ULONG_MAX ) ) fd_http_server_printf( ctx->http, "%lu}", request_id );
+  else                                     fd_http_server_printf( ctx->http, "null}" );
+  FD_TEST( !fd_http_server_ws_send( ctx->http, ws_conn_id ) );
+}
+
+static void
+ws_subscribe( fd_rpc_tile_t * ctx,
+              ulong           ws_conn_id,
+              ulong           request_id,
+              int             kind ) {
+  ulong sub_id = fd_rpc_pubsub_subscribe( ctx->pubsub, ws_conn_id, kind );
+  fd_http_server_printf( ctx->http, "{\"jsonrpc\":\"2.0\",\"result\":%lu,\"id\":%lu}", sub_id, request_id );
+  FD_TEST( !fd_http_server_ws_send( ctx->http, ws_conn_id ) );
+}
+
+static void
+ws_unsubscribe( fd_rpc_tile_t * ctx,
+                ulong           ws_conn_id,
+                ulong           request_id,
+                int             kind,
+                cJSON const *   params ) {
+  cJSON const * sub_id = params && cJSON_GetArraySize( params )==1 ? cJSON_GetArrayItem( params, 0 ) : NULL;
+  if( FD_UNLIKELY( !cJSON_IsNumber( sub_id ) ) ) {
+    ws_reply_error( ctx, ws_conn_id, request_id, FD_RPC_ERROR_INVALID_PARAMS, "Invalid params" );
+    return;
+  }
+
+  if( FD_UNLIKELY( fd_rpc_pubsub_unsubscribe( ctx->pubsub, ws_conn_id, kind, sub_id->valueulong ) ) ) {
+    ws_reply_error( ctx, ws_conn_id, request_id, FD_RPC_ERROR_INVALID_PARAMS, "Invalid subscription id." );
+    return;
+  }
+
+  fd_http_server_printf( ctx->http, "{\"jsonrpc\":\"2.0\",\"result\":true,\"id\":%lu}", request_id );
+  FD_TEST( !fd_http_server_ws_send( ctx->http, ws_conn_id ) );
+}
+
+static void
+rpc_ws_message( ulong         ws_conn_id,
+                uchar const * data,
+                ulong         data_len,
+                void *        _ctx ) {
+  fd_rpc_tile_t * ctx = (fd_rpc_tile_t *)_ctx;
+
+  const char * parse_end;
+  cJSON * json = cJSON_ParseWithLengthOpts( (char const *)data, data_len, &parse_end, 0 );
+  if( FD_UNLIKELY( !json ) ) {
+    ws_reply_error( ctx, ws_conn_id, ULONG_MAX, FD_RPC_ERROR_PARSE_ERROR, "Parse error" );
+    return;
+  }
+
+  const cJSON * jsonrpc = cJSON_GetObjectItemCaseSensitive( json, "jsonrpc" );
+  const cJSON * id      = cJSON_GetObjectItemCaseSensitive( json, "id" );
+  const cJSON * params  = cJSON_GetObjectItemCaseSensitive( json, "params" );
+  const cJSON * _method = cJSON_GetObjectItemCaseSensitive( json, "method" );
+  if( FD_UNLIKELY( !cJSON_IsString( jsonrpc ) || strcmp( jsonrpc->valuestring, "2.0" ) ||
+                   !cJSON_IsNumber( id ) ||
+                   ( params && !cJSON_IsArray( params ) ) ||
+                   !cJSON_IsString( _method ) || _method->valuestring==NULL ) ) {
+    ws_reply_error( ctx, ws_conn_id, cJSON_IsNumber( id ) ? id->valueulong : ULONG_MAX, FD_RPC_ERROR_INVALID_REQUEST, "Invalid request" );
+    cJSON_Delete( json );
+    return;
+  }
+  ulong request_id = id->valueulong;
+
+  /* Only subscriptions that can be served from replay's slot and root
+     notifications are supported.  accountSubscribe, programSubscribe
+     and signatureSubscribe need account writes and transaction
+     statuses, which replay does not publish to this tile. */
+
+  char const * method = _method->valuestring;
+  if( FD_LIKELY(      !strcmp( method, "slotSubscribe"   ) ) ) ws_subscribe  ( ctx, ws_conn_id, request_id, FD_RPC_PUBSUB_KIND_SLOT         );
+  else if( FD_LIKELY( !strcmp( method, "rootSubscribe"   ) ) ) ws_subscribe  ( ctx, ws_conn_id, request_id, FD_RPC_PUBSUB_KIND_ROOT         );
+  else if( FD_LIKELY( !strcmp( method, "slotUnsubscribe" ) ) ) ws_unsubscribe( ctx, ws_conn_id, request_id, FD_RPC_PUBSUB_KIND_SLOT, params );
+  else if( FD_LIKELY( !strcmp( method, "rootUnsubscribe" ) ) ) ws_unsubscribe( ctx, ws_conn_id, request_id, FD_RPC_PUBSUB_KIND_ROOT, params );
+  else ws_reply_error( ctx, ws_conn_id, request_id, FD_RPC_ERROR_METHOD_NOT_FOUND, "Method not found" );
+
+  cJSON_Delete( json );
+}
+
+static void
+rpc_ws_close( ulong  ws_conn_id,
+              int    reason,
+              void * _ctx ) {
+  (void)reason;
+  fd_rpc_tile_t * ctx = (fd_rpc_tile_t *)_ctx;
+  fd_rpc_pubsub_ws_close( ctx->pubsub, ws_conn_id );
+}
+
 static void
 privileged_init( fd_topo_t *      topo,
                  fd_topo_tile_t * tile ) {
@@ -963,7 +1122,9 @@ privileged_init( fd_topo_t *      topo,
   fd_memcpy( ctx->identity_pubkey, identity_key, 32UL );
 
   fd_http_server_callbacks_t callbacks = {
-    .request = rpc_http_request,
+    .request    = rpc_http_request,
+    .ws_close   = rpc_ws_close,
+    .ws_message = rpc_ws_message,
   };
   ctx->http = fd_http_server_join( fd_http_server_new( _http, http_params, callbacks, ctx ) );
   fd_http_server_listen( ctx->http, tile->rpc.listen_addr, tile->rpc.listen_port );
@@ -1010,6 +1171,7 @@ unprivileged_init( fd_topo_t *      topo,
                         FD_SCRATCH_ALLOC_APPEND( l, fd_http_server_align(),   fd_http_server_footprint( derive_http_params( tile ) ) );
   void * _alloc       = FD_SCRATCH_ALLOC_APPEND( l, fd_alloc_align(),         fd_alloc_footprint()                                   );
   void * _banks       = FD_SCRATCH_ALLOC_APPEND( l, alignof(bank_info_t),     tile->rpc.max_live_slots*sizeof(bank_info_t)           );
+  void * _pubsub      = FD_SCRATCH_ALLOC_APPEND( l, fd_rpc_pubsub_align(),    pubsub_footprint( tile )                               );
 
   fd_alloc_t * alloc = fd_alloc_join( fd_alloc_new( _alloc, 1UL ), 1UL );
   FD_TEST( alloc );
@@ -1028,6 +1190,12 @@ unprivileged_init( fd_topo_t *      topo,
 
   ctx->banks = _banks;
 
+  ctx->pubsub = NULL;
+  if( FD_LIKELY( tile->rpc.max_websocket_connections ) ) {
+    ctx->pubsub = fd_rpc_pubsub_join( fd_rpc_pubsub_new( _pubsub, tile->rpc.max_websocket_connections ) );
+    FD_TEST( ctx->pubsub );
+  }
+
   FD_TEST( fd_cstr_printf_check( ctx->version_string, sizeof( ctx->version_string ), NULL, "%s", fdctl_version_string ) );
 
   FD_TEST( tile->in_cnt<=sizeof( ctx->in )/sizeof( ctx->in[ 0 ] ) );
@@ -1061,7 +1229,7 @@ populate_allowed_seccomp( fd_topo_t const *      topo,
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_rpc_tile_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_rpc_tile_t ), sizeof( fd_rpc_tile_t ) );
 
-  populate_sock_filter_policy_fd_rpc_tile( out_cnt, out, (uint)fd_log_private_logfile_fd(), (uint)fd_http_server_fd( ctx->http ) );
+  populate_sock_filter_policy_fd_rpc_tile( out_cnt, out, (uint)fd_log_private_logfile_fd(), (uint)fd_http_server_fd( ctx->http ), (uint)fd_http_server_epoll_fd( ctx->http ) );
   return sock_filter_policy_fd_rpc_tile_instr_cnt;
 }
 
@@ -1074,22 +1242,23 @@ populate_allowed_fds( fd_topo_t const *      topo,
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_rpc_tile_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_rpc_tile_t ), sizeof( fd_rpc_tile_t ) );
 
-  if( FD_UNLIKELY( out_fds_cnt<3UL ) ) FD_LOG_ERR(( "out_fds_cnt %lu", out_fds_cnt ));
+  if( FD_UNLIKELY( out_fds_cnt<4UL ) ) FD_LOG_ERR(( "out_fds_cnt %lu", out_fds_cnt ));
 
   ulong out_cnt = 0UL;
   out_fds[ out_cnt++ ] = 2; /* stderr */
   if( FD_LIKELY( -1!=fd_log_private_logfile_fd() ) )
     out_fds[ out_cnt++ ] = fd_log_private_logfile_fd(); /* logfile */
   out_fds[ out_cnt++ ] = fd_http_server_fd( ctx->http ); /* rpc listen socket */
+  out_fds[ out_cnt++ ] = fd_http_server_epoll_fd( ctx->http ); /* rpc epoll instance */
   return out_cnt;
 }
 
 static ulong
 rlimit_file_cnt( fd_topo_t const *      topo FD_PARAM_UNUSED,
                  fd_topo_tile_t const * tile ) {
-  /* pipefd, socket, stderr, logfile, and one spare for new accept() connections */
-  ulong base = 5UL;
-  return base+tile->rpc.max_http_connections;
+  /* pipefd, socket, epoll, stderr, logfile, and one spare for new accept() connections */
+  ulong base = 6UL;
+  return base+tile->rpc.max_http_connections+tile->rpc.max_websocket_connections;
 }
 
 #define STEM_BURST (1UL)
@@ -0,0 +1,228 @@
+#include "fd_rpc_pubsub.h"
+#include "../../util/fd_util.h"
+#include "../../util/net/fd_ip4.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#define WS_CONN_MAX (4UL)
+
+static fd_http_server_t * http;
+static fd_rpc_pubsub_t *  pubsub;
+
+static ulong ws_conn_ids[ WS_CONN_MAX ];
+static ulong ws_open_cnt;
+
+static fd_http_server_response_t
+request( fd_http_server_request_t const * request ) {
+  FD_TEST( request->headers.upgrade_websocket );
+  return (fd_http_server_response_t){ .status = 200, .upgrade_websocket = 1 };
+}
+
+static void
+ws_open( ulong  ws_conn_id,
+         void * ctx ) {
+  (void)ctx;
+  ws_conn_ids[ ws_open_cnt++ ] = ws_conn_id;
+}
+
+static void
+ws_close( ulong  ws_conn_id,
+          int    reason,
+          void * ctx ) {
+  (void)reason; (void)ctx;
+  fd_rpc_pubsub_ws_close( pubsub, ws_conn_id );
+}
+
+static int
+client_connect( ushort port ) {
+  int fd = socket( AF_INET, SOCK_STREAM|SOCK_CLOEXEC, 0 );
+  FD_TEST( fd>=0 );
+  struct sockaddr_in addr = {
+    .sin_family      = AF_INET,
+    .sin_port        = fd_ushort_bswap( port ),
+    .sin_addr.s_addr = FD_IP4_ADDR( 127, 0, 0, 1 ),
+  };
+  FD_TEST( !connect( fd, fd_type_pun( &addr ), sizeof(addr) ) );
+
+  static char const upgrade[] =
+    "GET / HTTP/1.1\r\n"
+    "Host: localhost\r\n"
+    "Upgrade: websocket\r\n"
+    "Connection: Upgrade\r\n"
+    "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+    "Sec-WebSocket-Version: 13\r\n\r\n";
+  FD_TEST( send( fd, upgrade, sizeof(upgrade)-1UL, MSG_NOSIGNAL )==(long)(sizeof(upgrade)-1UL) );
+
+  /* Read the 101 response */
+  char  buf[ 1024 ];
+  ulong sz = 0UL;
+  for(;;) {
+    fd_http_server_poll( http, 0 );
+    long res = recv( fd, buf+sz, sizeof(buf)-1UL-sz, MSG_DONTWAIT );
+    if( res==-1L && errno==EAGAIN ) continue;
+    FD_TEST( res>0L );
+    sz += (ulong)res;
+    buf[ sz ] = '\0';
+    if( strstr( buf, "\r\n\r\n" ) ) break;
+  }
+  FD_TEST( !strncmp( buf, "HTTP/1.1 101", 12UL ) );
+  return fd;
+}
+
+/* client_recv drives the server until a text frame arrives on fd, and
+   returns its payload (NUL terminated), or returns NULL if nothing
+   arrives within a few polls. */
+
+static char *
+client_recv( int fd ) {
+  static char frame[ 4096 ];
+  ulong sz = 0UL;
+  for( ulong iter=0UL; iter<1000UL; iter++ ) {
+    fd_http_server_poll( http, 0 );
+    long res = recv( fd, frame+sz, sizeof(frame)-1UL-sz, MSG_DONTWAIT );
+    if( res==-1L && errno==EAGAIN ) {
+      if( !sz ) continue;
+      break;
+    }
+    FD_TEST( res>0L );
+    sz += (ulong)res;
+  }
+  if( !sz ) return NULL;
+
+  FD_TEST( sz>=2UL );
+  FD_TEST( (uchar)frame[ 0 ]==0x81 ); /* FIN, text */
+  ulong len = (uchar)frame[ 1 ];
+  ulong hdr = 2UL;
+  if( len==126UL ) { len = ((ulong)(uchar)frame[ 2 ]<<8) | (ulong)(uchar)frame[ 3 ]; hdr = 4UL; }
+  FD_TEST( sz==hdr+len );
+  frame[ sz ] = '\0';
+  return frame+hdr;
+}
+
+static void
+notify( int          kind,
+        char const * result ) {
+  FD_TEST( !fd_rpc_pubsub_notify_begin( pubsub, http, kind ) );
+  fd_http_server_printf( http, "%s", result );
+  FD_TEST( !fd_rpc_pubsub_notify_end( pubsub, http ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_http_server_params_t params = {
+    .max_connection_cnt    = WS_CONN_MAX,
+    .max_ws_connection_cnt = WS_CONN_MAX,
+    .max_request_len       = 1024UL,
+    .max_ws_recv_frame_len = 1024UL,
+    .max_ws_send_frame_cnt = 16UL,
+    .outgoing_buffer_sz    = 1UL<<16,
+  };
+  fd_http_server_callbacks_t callbacks = {
+    .request  = request,
+    .ws_open  = ws_open,
+    .ws_close = ws_close,
+  };
+
+  void * http_mem = aligned_alloc( fd_http_server_align(), fd_ulong_align_up( fd_http_server_footprint( params ), fd_http_server_align() ) );
+  FD_TEST( http_mem );
+  http = fd_http_server_join( fd_http_server_new( http_mem, params, callbacks, NULL ) );
+  FD_TEST( http );
+  FD_TEST( fd_http_server_listen( http, FD_IP4_ADDR( 127, 0, 0, 1 ), 0 ) );
+
+  FD_TEST( !fd_rpc_pubsub_footprint( 0UL ) );
+  ulong  footprint  = fd_rpc_pubsub_footprint( WS_CONN_MAX );
+  void * pubsub_mem = aligned_alloc( fd_rpc_pubsub_align(), fd_ulong_align_up( footprint, fd_rpc_pubsub_align() ) );
+  FD_TEST( pubsub_mem );
+  pubsub = fd_rpc_pubsub_join( fd_rpc_pubsub_new( pubsub_mem, WS_CONN_MAX ) );
+  FD_TEST( pubsub );
+
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  FD_TEST( !getsockname( fd_http_server_fd( http ), fd_type_pun( &addr ), &addr_len ) );
+  ushort port = fd_ushort_bswap( addr.sin_port );
+
+  int fds[ 3 ];
+  for( ulong i=0UL; i<3UL; i++ ) fds[ i ] = client_connect( port );
+  while( ws_open_cnt<3UL ) fd_http_server_poll( http, 0 );
+  ulong c0 = ws_conn_ids[ 0 ]; ulong c1 = ws_conn_ids[ 1 ]; ulong c2 = ws_conn_ids[ 2 ];
+
+  /* All subscribers of a kind share one subscription and its ID */
+
+  int const slot = FD_RPC_PUBSUB_KIND_SLOT;
+  int const root = FD_RPC_PUBSUB_KIND_ROOT;
+
+  ulong slot_id = fd_rpc_pubsub_subscribe( pubsub, c0, slot );
+  FD_TEST( fd_rpc_pubsub_subscribe( pubsub, c1, slot )==slot_id );
+  FD_TEST( fd_rpc_pubsub_subscribe( pubsub, c0, slot )==slot_id ); /* Already subscribed */
+  ulong root_id = fd_rpc_pubsub_subscribe( pubsub, c2, root );
+  FD_TEST( root_id!=slot_id );
+  FD_TEST( fd_rpc_pubsub_subscriber_cnt( pubsub, slot )==2UL );
+  FD_TEST( fd_rpc_pubsub_subscriber_cnt( pubsub, root )==1UL );
+  FD_TEST( fd_rpc_pubsub_conn_sub_cnt( pubsub, c0 )==1UL );
+
+  /* A notification reaches exactly the subscribers of its kind */
+
+  notify( slot, "{\"parent\":9,\"root\":8,\"slot\":10}" );
+  char expected[ 256 ];
+  FD_TEST( fd_cstr_printf_check( expected, sizeof(expected), NULL,
+    "{\"jsonrpc\":\"2.0\",\"method\":\"slotNotification\",\"params\":{\"subscription\":%lu,\"result\":{\"parent\":9,\"root\":8,\"slot\":10}}}", slot_id ) );
+  char * msg = client_recv( fds[ 0 ] ); FD_TEST( msg && !strcmp( msg, expected ) );
+  msg        = client_recv( fds[ 1 ] ); FD_TEST( msg && !strcmp( msg, expected ) );
+  FD_TEST( !client_recv( fds[ 2 ] ) );
+
+  notify( root, "8" );
+  FD_TEST( fd_cstr_printf_check( expected, sizeof(expected), NULL,
+    "{\"jsonrpc\":\"2.0\",\"method\":\"rootNotification\",\"params\":{\"subscription\":%lu,\"result\":8}}", root_id ) );
+  msg = client_recv( fds[ 2 ] ); FD_TEST( msg && !strcmp( msg, expected ) );
+  FD_TEST( !client_recv( fds[ 0 ] ) );
+
+  /* Unsubscribe needs the right connection, kind, and ID */
+
+  FD_TEST( fd_rpc_pubsub_unsubscribe( pubsub, c2, slot, slot_id )==-1 );
+  FD_TEST( fd_rpc_pubsub_unsubscribe( pubsub, c0, root, slot_id )==-1 );
+  FD_TEST( fd_rpc_pubsub_unsubscribe( pubsub, c0, FD_RPC_PUBSUB_KIND_CNT, slot_id )==-1 );
+  FD_TEST( !fd_rpc_pubsub_unsubscribe( pubsub, c0, slot, slot_id ) );
+  FD_TEST( fd_rpc_pubsub_unsubscribe( pubsub, c0, slot, slot_id )==-1 );
+  FD_TEST( fd_rpc_pubsub_subscriber_cnt( pubsub, slot )==1UL );
+  notify( slot, "1" );
+  FD_TEST( !client_recv( fds[ 0 ] ) );
+  FD_TEST( client_recv( fds[ 1 ] ) );
+
+  /* A connection can hold one subscription of each kind */
+
+  FD_TEST( fd_rpc_pubsub_subscribe( pubsub, c1, root )==root_id );
+  FD_TEST( fd_rpc_pubsub_conn_sub_cnt( pubsub, c1 )==2UL );
+  FD_TEST( !fd_rpc_pubsub_unsubscribe( pubsub, c1, root, root_id ) );
+
+  /* Closing a connection drops its subscriptions */
+
+  fd_http_server_ws_close( http, c2, FD_HTTP_SERVER_CONNECTION_CLOSE_OK );
+  FD_TEST( !fd_rpc_pubsub_conn_sub_cnt( pubsub, c2 ) );
+  FD_TEST( !fd_rpc_pubsub_subscriber_cnt( pubsub, root ) );
+  FD_TEST( fd_rpc_pubsub_subscriber_cnt( pubsub, slot )==1UL );
+  FD_TEST( fd_rpc_pubsub_notify_begin( pubsub, http, root )==-1 );
+
+  fd_rpc_pubsub_ws_close( pubsub, c1 );
+  FD_TEST( !fd_rpc_pubsub_subscriber_cnt( pubsub, slot ) );
+
+  /* A kind that gained subscribers again gets a fresh ID */
+
+  ulong id = fd_rpc_pubsub_subscribe( pubsub, c0, slot );
+  FD_TEST( id!=slot_id && id!=root_id );
+
+  for( ulong i=0UL; i<3UL; i++ ) FD_TEST( !close( fds[ i ] ) );
+  fd_http_server_unlisten( http );
+  free( fd_rpc_pubsub_delete( fd_rpc_pubsub_leave( pubsub ) ) );
+  free( fd_http_server_delete( fd_http_server_leave( http ) ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
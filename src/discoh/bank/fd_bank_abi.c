@@ -359,19 +359,11 @@ fd_bank_abi_resolve_address_lookup_tables( void const *     bank,
 
     if( FD_UNLIKELY( (data_sz<56UL) | (data_sz>(56UL+256UL*32UL)) ) ) return FD_BANK_ABI_TXN_INIT_ERR_INVALID_ACCOUNT_DATA;
 
-    fd_bincode_decode_ctx_t bincode = {
-      .data    = data,
-      .dataend = data+data_sz,
-    };
-
-    ulong total_sz = 0UL;
-    result = fd_address_lookup_table_state_decode_footprint( &bincode, &total_sz );
+    fd_address_lookup_table_state_view_t table;
+    result = fd_address_lookup_table_state_view_init( &table, data, data_sz );
     if( FD_UNLIKELY( result!=FD_BINCODE_SUCCESS ) ) return FD_BANK_ABI_TXN_INIT_ERR_INVALID_ACCOUNT_DATA;
 
-    fd_address_lookup_table_state_t table[1];
-    fd_address_lookup_table_state_decode( table, &bincode );
-
-    result = fd_address_lookup_table_state_is_lookup_table( table );
+    result = fd_address_lookup_table_state_view_is_lookup_table( table );
     if( FD_UNLIKELY( !result ) ) return FD_BANK_ABI_TXN_INIT_ERR_ACCOUNT_UNINITIALIZED;
 
     if( FD_UNLIKELY( (data_sz-56UL)%32UL ) ) return FD_BANK_ABI_TXN_INIT_ERR_INVALID_ACCOUNT_DATA;
@@ -386,12 +378,14 @@ fd_bank_abi_resolve_address_lookup_tables( void const *     bank,
        fraction of transactions that could actually still be valid
        (those deactivated between 512 and 512*(1+skip_rate) slots ago. */
 
-    ulong deactivation_slot = table->inner.lookup_table.meta.deactivation_slot;
+    fd_lookup_table_meta_view_t meta = fd_address_lookup_table_view_meta( fd_address_lookup_table_state_view_lookup_table( table ) );
+
+    ulong deactivation_slot = fd_lookup_table_meta_view_deactivation_slot( meta );
     if( FD_UNLIKELY( deactivation_slot!=ULONG_MAX && (deactivation_slot+512UL)<slot ) ) return FD_BANK_ABI_TXN_INIT_ERR_ACCOUNT_NOT_FOUND;
 
-    ulong active_addresses_len = fd_ulong_if( slot>table->inner.lookup_table.meta.last_extended_slot,
+    ulong active_addresses_len = fd_ulong_if( slot>fd_lookup_table_meta_view_last_extended_slot( meta ),
                                               addresses_len,
-                                              table->inner.lookup_table.meta.last_extended_slot_start_index );
+                                              fd_lookup_table_meta_view_last_extended_slot_start_index( meta ) );
     for( ulong j=0UL; j<lut->writable_cnt; j++ ) {
       uchar idx = payload[ lut->writable_off+j ];
       if( FD_UNLIKELY( idx>=active_addresses_len ) ) return FD_BANK_ABI_TXN_INIT_ERR_INVALID_LOOKUP_INDEX;
@@ -2,15 +2,22 @@
 #include "../../ballet/chacha/fd_chacha_rng.h"
 #include "../../ballet/wsample/fd_wsample.h"
 
+/* Radix sorts on (stake, id) descending and id descending.  The radix
+   bytes are in significance order, complemented for descending order. */
+
 #define SORT_NAME sort_vote_weights_by_stake_id
 #define SORT_KEY_T fd_vote_stake_weight_t
+#define SORT_RADIX_SZ 40UL
+#define SORT_RADIX_BYTE(e,i) ((uchar)~( (i)<8UL ? (uchar)( (e).stake >> (56UL-8UL*(i)) ) : (e).id_key.uc[ (i)-8UL ] ))
 #define SORT_BEFORE(a,b) ((a).stake > (b).stake ? 1 : ((a).stake < (b).stake ? 0 : memcmp( (a).id_key.uc, (b).id_key.uc, 32UL )>0))
-#include "../../util/tmpl/fd_sort.c"
+#include "../../util/tmpl/fd_sort_radix.c"
 
 #define SORT_NAME sort_vote_weights_by_id
 #define SORT_KEY_T fd_vote_stake_weight_t
+#define SORT_RADIX_SZ 32UL
+#define SORT_RADIX_BYTE(e,i) ((uchar)~(e).id_key.uc[ (i) ])
 #define SORT_BEFORE(a,b) (memcmp( (a).id_key.uc, (b).id_key.uc, 32UL )>0)
-#include "../../util/tmpl/fd_sort.c"
+#include "../../util/tmpl/fd_sort_radix.c"
 
 ulong
 fd_epoch_leaders_align( void ) {
@@ -12,6 +12,9 @@ ifdef FD_HAS_SECP256K1
 $(call add-hdrs,fd_progcache_user.h)
 $(call add-objs,fd_progcache_user,fd_flamenco)
 
+$(call add-hdrs,fd_progcache_warm.h)
+$(call add-objs,fd_progcache_warm,fd_flamenco)
+
 $(call make-unit-test,test_progcache,test_progcache,fd_flamenco fd_funk fd_ballet fd_util)
 $(call run-unit-test,test_progcache)
 
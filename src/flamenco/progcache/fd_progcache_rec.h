@@ -16,6 +16,14 @@ struct fd_progcache_rec {
      Matches the XID's slot number for in-preparation transactions. */
   ulong slot;
 
+  /* SHA-256 of the ELF binary and fd_progcache_feature_hash of the
+     feature set this entry was loaded with.  Used to persist entries
+     across restarts (see fd_progcache_warm.h).  Zero for
+     non-executable entries and entries loaded by clients without a
+     warm store attached. */
+  uchar progdata_hash[ 32 ];
+  ulong feature_hash;
+
   uint entry_pc;
   uint text_cnt;
   uint text_off;
@@ -1,6 +1,8 @@
 #include "fd_prog_load.h"
 #include "fd_progcache_user.h"
 #include "fd_progcache_rec.h"
+#include "fd_progcache_warm.h"
+#include "../../ballet/sha256/fd_sha256.h"
 
 FD_TL fd_progcache_metrics_t fd_progcache_metrics_default;
 
@@ -557,9 +559,34 @@ fd_progcache_insert( fd_progcache_t *           cache,
                   rec_align, rec_footprint ));
     }
 
-    rec = fd_progcache_rec_new( rec_mem, elf_info, &config, load_slot, features, progdata, progdata_sz, cache->scratch, cache->scratch_sz );
+    /* Use verified program image from warm start store if possible.
+       The program content and environment are only identified (hashed)
+       if a warm store is attached, which is the case whenever the cache
+       is persisted across restarts. */
+
+    uchar progdata_hash[ 32 ] = {0};
+    ulong feature_hash        = 0UL;
+    if( cache->warm ) {
+      fd_sha256_hash( progdata, progdata_sz, progdata_hash );
+      feature_hash = fd_progcache_feature_hash( features, load_slot );
+      fd_progcache_rec_t const * warm_rec = fd_progcache_warm_query( cache->warm, prog_addr, progdata_hash, feature_hash, rec_footprint );
+      if( warm_rec ) {
+        rec = fd_memcpy( rec_mem, warm_rec, rec_footprint );
+        cache->metrics->warm_hit_cnt++;
+      } else {
+        cache->metrics->warm_miss_cnt++;
+      }
+    }
+
+    if( !rec ) {
+      rec = fd_progcache_rec_new( rec_mem, elf_info, &config, load_slot, features, progdata, progdata_sz, cache->scratch, cache->scratch_sz );
+    }
     if( !rec ) {
       fd_funk_val_flush( funk_rec, funk->alloc, funk->wksp );
+    } else {
+      rec->slot         = load_slot;
+      rec->feature_hash = feature_hash;
+      memcpy( rec->progdata_hash, progdata_hash, 32UL );
     }
 
   }
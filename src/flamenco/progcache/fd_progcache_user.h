@@ -67,10 +67,15 @@ struct fd_progcache_metrics {
   ulong fill_fail_cnt;
   ulong dup_insert_cnt;
   ulong invalidate_cnt;
+  ulong warm_hit_cnt;
+  ulong warm_miss_cnt;
 };
 
 typedef struct fd_progcache_metrics fd_progcache_metrics_t;
 
+struct fd_progcache_warm_private;
+typedef struct fd_progcache_warm_private fd_progcache_warm_t;
+
 /* fd_progcache_t is a thread-local client to a program cache funk
    instance.  This struct is quite large and therefore not local/stack
    declaration-friendly. */
@@ -84,6 +89,9 @@ struct fd_progcache {
 
   fd_progcache_metrics_t * metrics;
 
+  /* Optional warm start store (see fd_progcache_warm.h), NULL if none */
+  fd_progcache_warm_t const * warm;
+
   uchar * scratch;
   ulong   scratch_sz;
 };
@@ -136,6 +144,19 @@ void *
 fd_progcache_leave( fd_progcache_t * cache,
                     void **          opt_shfunk );
 
+/* fd_progcache_set_warm attaches a warm start store to the caller's
+   program cache client (detaches if warm is NULL).  Cache fills will
+   use program images from the warm store instead of loading and
+   verifying programs where possible.  Only entries filled by clients
+   with a warm store attached (which may be empty) can be persisted
+   with fd_progcache_warm_save. */
+
+static inline void
+fd_progcache_set_warm( fd_progcache_t *            cache,
+                       fd_progcache_warm_t const * warm ) {
+  cache->warm = warm;
+}
+
 /* Record-level operations ********************************************/
 
 /* fd_progcache_peek queries the program cache for an existing cache
@@ -0,0 +1,404 @@
+#include "fd_progcache_warm.h"
+#include "../../util/io/fd_io.h"
+
+/* fd_progcache_warm_ent_t is a slot in the warm store's open addressed
+   index.  rec_sz==0 marks an empty slot. */
+
+struct fd_progcache_warm_ent {
+  uchar prog_addr    [ 32 ];
+  uchar progdata_hash[ 32 ];
+  ulong feature_hash;
+  ulong rec_off;  /* offset of image relative to the warm store */
+  ulong rec_sz;
+};
+
+typedef struct fd_progcache_warm_ent fd_progcache_warm_ent_t;
+
+struct __attribute__((aligned(FD_PROGCACHE_WARM_ALIGN))) fd_progcache_warm_private {
+  ulong magic;      /* ==FD_PROGCACHE_WARM_MAGIC */
+  ulong entry_max;
+  ulong entry_cnt;
+  ulong slot_cnt;   /* power of 2, >=2*entry_max */
+  ulong data_off;   /* offset of data region relative to the warm store */
+  ulong data_max;
+  ulong data_sz;
+
+  /* slot_cnt fd_progcache_warm_ent_t follow, then data_max bytes of
+     program images. */
+};
+
+static inline fd_progcache_warm_ent_t *
+fd_progcache_warm_ent( fd_progcache_warm_t * warm ) {
+  return (fd_progcache_warm_ent_t *)( warm+1 );
+}
+
+static inline fd_progcache_warm_ent_t const *
+fd_progcache_warm_ent_const( fd_progcache_warm_t const * warm ) {
+  return (fd_progcache_warm_ent_t const *)( warm+1 );
+}
+
+static inline ulong
+fd_progcache_warm_slot_cnt( ulong entry_max ) {
+  return fd_ulong_pow2_up( fd_ulong_max( 2UL*entry_max, 2UL ) );
+}
+
+ulong
+fd_progcache_feature_hash( fd_features_t const * features,
+                           ulong                 slot ) {
+  ulong active[ (FD_FEATURE_ID_CNT+63UL)/64UL ] = {0};
+  for( fd_feature_id_t const * id = fd_feature_iter_init();
+                                   !fd_feature_iter_done( id );
+                               id = fd_feature_iter_next( id ) ) {
+    if( slot>=fd_features_get( features, id ) ) active[ id->index>>6 ] |= 1UL<<( id->index & 63UL );
+  }
+  return fd_hash( FD_PROGCACHE_WARM_VERSION, active, sizeof(active) );
+}
+
+FD_FN_CONST ulong
+fd_progcache_warm_align( void ) {
+  return FD_PROGCACHE_WARM_ALIGN;
+}
+
+FD_FN_CONST ulong
+fd_progcache_warm_footprint( ulong entry_max,
+                             ulong data_max ) {
+  if( FD_UNLIKELY( !entry_max || entry_max>(1UL<<32) ) ) return 0UL;
+  if( FD_UNLIKELY( data_max>(1UL<<44) ) ) return 0UL;
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, FD_PROGCACHE_WARM_ALIGN,          sizeof(fd_progcache_warm_t) );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_progcache_warm_ent_t), fd_progcache_warm_slot_cnt( entry_max )*sizeof(fd_progcache_warm_ent_t) );
+  l = FD_LAYOUT_APPEND( l, fd_progcache_rec_align(),         data_max );
+  return FD_LAYOUT_FINI( l, FD_PROGCACHE_WARM_ALIGN );
+}
+
+void *
+fd_progcache_warm_new( void * shmem,
+                       ulong  entry_max,
+                       ulong  data_max ) {
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_progcache_warm_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !fd_progcache_warm_footprint( entry_max, data_max ) ) ) {
+    FD_LOG_WARNING(( "invalid entry_max (%lu) or data_max (%lu)", entry_max, data_max ));
+    return NULL;
+  }
+
+  ulong slot_cnt = fd_progcache_warm_slot_cnt( entry_max );
+
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_progcache_warm_t *     warm = FD_SCRATCH_ALLOC_APPEND( l, FD_PROGCACHE_WARM_ALIGN,          sizeof(fd_progcache_warm_t) );
+  fd_progcache_warm_ent_t * ent  = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_progcache_warm_ent_t), slot_cnt*sizeof(fd_progcache_warm_ent_t) );
+  uchar *                   data = FD_SCRATCH_ALLOC_APPEND( l, fd_progcache_rec_align(),         data_max );
+  FD_SCRATCH_ALLOC_FINI( l, FD_PROGCACHE_WARM_ALIGN );
+
+  memset( warm, 0, sizeof(fd_progcache_warm_t) );
+  memset( ent,  0, slot_cnt*sizeof(fd_progcache_warm_ent_t) );
+  warm->entry_max = entry_max;
+  warm->slot_cnt  = slot_cnt;
+  warm->data_off  = (ulong)data - (ulong)warm;
+  warm->data_max  = data_max;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( warm->magic ) = FD_PROGCACHE_WARM_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_progcache_warm_t *
+fd_progcache_warm_join( void * shwarm ) {
+  if( FD_UNLIKELY( !shwarm ) ) {
+    FD_LOG_WARNING(( "NULL shwarm" ));
+    return NULL;
+  }
+  fd_progcache_warm_t * warm = shwarm;
+  if( FD_UNLIKELY( warm->magic!=FD_PROGCACHE_WARM_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+  return warm;
+}
+
+void *
+fd_progcache_warm_leave( fd_progcache_warm_t * warm ) {
+  if( FD_UNLIKELY( !warm ) ) {
+    FD_LOG_WARNING(( "NULL warm" ));
+    return NULL;
+  }
+  return warm;
+}
+
+void *
+fd_progcache_warm_delete( void * shwarm ) {
+  if( FD_UNLIKELY( !shwarm ) ) {
+    FD_LOG_WARNING(( "NULL shwarm" ));
+    return NULL;
+  }
+  fd_progcache_warm_t * warm = shwarm;
+  if( FD_UNLIKELY( warm->magic!=FD_PROGCACHE_WARM_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( warm->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+  return shwarm;
+}
+
+ulong
+fd_progcache_warm_entry_cnt( fd_progcache_warm_t const * warm ) {
+  return warm->entry_cnt;
+}
+
+/* fd_progcache_warm_slot returns the index slot for the given key,
+   which is either the slot holding the key or the empty slot where the
+   key would be inserted.  Assumes the index is not full. */
+
+static ulong
+fd_progcache_warm_slot( fd_progcache_warm_t const * warm,
+                        void const *                prog_addr,
+                        uchar const                 progdata_hash[ 32 ],
+                        ulong                       feature_hash ) {
+  fd_progcache_warm_ent_t const * ent  = fd_progcache_warm_ent_const( warm );
+  ulong                           mask = warm->slot_cnt-1UL;
+  ulong idx = fd_hash( feature_hash, progdata_hash, 32UL ) & mask;
+  for(;;) {
+    fd_progcache_warm_ent_t const * e = ent+idx;
+    if( !e->rec_sz ) return idx;
+    if( e->feature_hash==feature_hash &&
+        !memcmp( e->progdata_hash, progdata_hash, 32UL ) &&
+        !memcmp( e->prog_addr,     prog_addr,     32UL ) ) return idx;
+    idx = (idx+1UL) & mask;
+  }
+}
+
+fd_progcache_rec_t const *
+fd_progcache_warm_query( fd_progcache_warm_t const * warm,
+                         void const *                prog_addr,
+                         uchar const                 progdata_hash[ 32 ],
+                         ulong                       feature_hash,
+                         ulong                       rec_sz ) {
+  fd_progcache_warm_ent_t const * e = fd_progcache_warm_ent_const( warm ) +
+      fd_progcache_warm_slot( warm, prog_addr, progdata_hash, feature_hash );
+  if( FD_UNLIKELY( !e->rec_sz || e->rec_sz!=rec_sz ) ) return NULL;
+  return (fd_progcache_rec_t const *)( (ulong)warm + e->rec_off );
+}
+
+/* fd_progcache_warm_rec_sane checks that a program image read from a
+   file only references memory inside its rec_sz bytes, in the layout
+   fd_progcache_rec_new produces, before it can reach the VM.  The file
+   checksum only guards against accidental corruption. */
+
+static int
+fd_progcache_warm_rec_sane( fd_progcache_rec_t const * rec,
+                            ulong                      rec_sz ) {
+  if( FD_UNLIKELY( rec_sz<sizeof(fd_progcache_rec_t) ) ) return 0;
+  if( FD_UNLIKELY( !rec->executable || rec->invalidate ) ) return 0;
+
+  /* rodata follows the header (and calldests) and ends in bounds */
+  ulong rodata_off = rec->rodata_off;
+  ulong rodata_sz  = rec->rodata_sz;
+  if( FD_UNLIKELY( rodata_off<sizeof(fd_progcache_rec_t) || !fd_ulong_is_aligned( rodata_off, 8UL ) ) ) return 0;
+  if( FD_UNLIKELY( rodata_off+rodata_sz>rec_sz ) ) return 0;
+
+  /* text is a range of rodata holding text_cnt instructions, entry_pc
+     is one of them */
+  ulong text_off = rec->text_off;
+  ulong text_sz  = rec->text_sz;
+  ulong text_cnt = rec->text_cnt;
+  if( FD_UNLIKELY( text_off+text_sz>rodata_sz ) ) return 0;
+  if( FD_UNLIKELY( text_cnt!=text_sz/8UL || rec->entry_pc>=text_cnt ) ) return 0;
+
+  /* calldests is present iff the sBPF version uses it, and is a set of
+     text_cnt elements between the header and rodata */
+  int has_calldests = !fd_sbpf_enable_stricter_elf_headers_enabled( rec->sbpf_version );
+  if( FD_UNLIKELY( has_calldests!=!!rec->calldests_off ) ) return 0;
+  if( has_calldests ) {
+    ulong calldests_off = rec->calldests_off;
+    if( FD_UNLIKELY( calldests_off<sizeof(fd_progcache_rec_t) ||
+                     !fd_ulong_is_aligned( calldests_off, fd_sbpf_calldests_align() ) ||
+                     calldests_off+fd_sbpf_calldests_footprint( text_cnt )>rodata_off ) ) return 0;
+    fd_sbpf_calldests_private_t const * hdr = (fd_sbpf_calldests_private_t const *)( (ulong)rec + calldests_off );
+    if( FD_UNLIKELY( hdr->max!=text_cnt || hdr->word_cnt!=fd_sbpf_calldests_private_word_cnt( text_cnt ) ) ) return 0;
+  }
+
+  return 1;
+}
+
+ulong
+fd_progcache_warm_load( fd_progcache_warm_t * warm,
+                        int                   fd ) {
+  fd_progcache_warm_file_hdr_t hdr[1];
+  ulong rsz;
+  int err = fd_io_read( fd, hdr, sizeof(hdr), sizeof(hdr), &rsz );
+  if( FD_UNLIKELY( err ) ) {
+    if( err>0 ) FD_LOG_WARNING(( "failed to read progcache warm file header (%i-%s)", err, fd_io_strerror( err ) ));
+    return 0UL;
+  }
+  if( FD_UNLIKELY( hdr->magic!=FD_PROGCACHE_WARM_MAGIC ) ) {
+    FD_LOG_WARNING(( "progcache warm file has bad magic, ignoring" ));
+    return 0UL;
+  }
+  if( FD_UNLIKELY( hdr->version!=FD_PROGCACHE_WARM_VERSION ) ) {
+    FD_LOG_NOTICE(( "progcache warm file has version %lu (expected %lu), ignoring", hdr->version, FD_PROGCACHE_WARM_VERSION ));
+    return 0UL;
+  }
+
+  fd_progcache_warm_ent_t * ent      = fd_progcache_warm_ent( warm );
+  ulong                     load_cnt = 0UL;
+  for( ulong i=0UL; i<hdr->entry_cnt; i++ ) {
+    fd_progcache_warm_file_entry_t fe[1];
+    err = fd_io_read( fd, fe, sizeof(fe), sizeof(fe), &rsz );
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "progcache warm file truncated at entry %lu", i ));
+      break;
+    }
+
+    /* Stage the image at the end of the data region.  It becomes part
+       of the store only once it is validated and indexed. */
+
+    ulong data_off = fd_ulong_align_up( warm->data_sz, fd_progcache_rec_align() );
+    if( FD_UNLIKELY( !fe->rec_sz || fe->rec_sz>warm->data_max ) ) {
+      FD_LOG_WARNING(( "progcache warm file entry %lu has invalid size %lu", i, fe->rec_sz ));
+      break;
+    }
+    if( FD_UNLIKELY( warm->entry_cnt>=warm->entry_max || data_off+fe->rec_sz>warm->data_max ) ) {
+      FD_LOG_NOTICE(( "progcache warm store full, skipping remaining %lu entries", hdr->entry_cnt-i ));
+      break;
+    }
+    uchar * data = (uchar *)warm + warm->data_off + data_off;
+    err = fd_io_read( fd, data, fe->rec_sz, fe->rec_sz, &rsz );
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "progcache warm file truncated at entry %lu", i ));
+      break;
+    }
+    fd_progcache_rec_t * rec = (fd_progcache_rec_t *)data;
+    if( FD_UNLIKELY( fd_hash( FD_PROGCACHE_WARM_MAGIC, data, fe->rec_sz )!=fe->rec_hash ||
+                     !fd_progcache_warm_rec_sane( rec, fe->rec_sz ) ) ) {
+      FD_LOG_WARNING(( "progcache warm file entry %lu is corrupt", i ));
+      break;
+    }
+
+    fd_progcache_warm_ent_t * e = ent + fd_progcache_warm_slot( warm, fe->prog_addr, fe->progdata_hash, fe->feature_hash );
+    if( FD_UNLIKELY( e->rec_sz ) ) continue; /* duplicate */
+    memcpy( e->prog_addr,     fe->prog_addr,     32UL );
+    memcpy( e->progdata_hash, fe->progdata_hash, 32UL );
+    e->feature_hash = fe->feature_hash;
+    e->rec_off      = warm->data_off + data_off;
+    e->rec_sz       = fe->rec_sz;
+    warm->data_sz   = data_off + fe->rec_sz;
+    warm->entry_cnt++;
+    load_cnt++;
+  }
+
+  return load_cnt;
+}
+
+/* fd_progcache_warm_save_ok returns 1 if the given cache entry should
+   be persisted.  Entries filled by clients without a warm store lack
+   the content hashes required to match them up on the next boot. */
+
+static inline int
+fd_progcache_warm_save_ok( fd_funk_rec_t const *      rec,
+                           fd_progcache_rec_t const * prec ) {
+  static uchar const zero_hash[ 32 ] = {0};
+  return fd_funk_val_sz( rec )>=sizeof(fd_progcache_rec_t) &&
+         prec->executable && !prec->invalidate &&
+         !!memcmp( prec->progdata_hash, zero_hash, 32UL );
+}
+
+/* fd_progcache_warm_save_chains walks the rec_map chains of the
+   program cache and writes the entries that should be persisted to fd
+   (or only counts them if fd==-1).  The save usually runs right after
+   the tiles using the cache were killed, possibly in the middle of an
+   update, so every chain is read like a seqlock: chains that are
+   locked are skipped, and an entry is only written if its chain did
+   not change while the entry was hashed. */
+
+static int
+fd_progcache_warm_save_chains( fd_funk_t * funk,
+                               int         fd,
+                               ulong *     entry_cnt ) {
+  fd_wksp_t *                                   wksp      = fd_funk_wksp( funk );
+  fd_funk_rec_map_shmem_t *                     shmap     = funk->rec_map->map;
+  fd_funk_rec_map_shmem_private_chain_t const * chain_tbl = fd_funk_rec_map_shmem_private_chain_const( shmap, 0UL );
+  ulong                                         chain_cnt = fd_funk_rec_map_chain_cnt( funk->rec_map );
+  fd_funk_rec_t const *                         rec_tbl   = funk->rec_pool->ele;
+  ulong                                         rec_max   = fd_funk_rec_pool_ele_max( funk->rec_pool );
+
+  *entry_cnt = 0UL;
+  for( ulong chain_idx=0UL; chain_idx<chain_cnt; chain_idx++ ) {
+    fd_funk_rec_map_shmem_private_chain_t const * chain = chain_tbl + chain_idx;
+    ulong ver_cnt = FD_VOLATILE_CONST( chain->ver_cnt );
+    if( FD_UNLIKELY( fd_funk_rec_map_private_vcnt_ver( ver_cnt )&1UL ) ) continue; /* chain is locked */
+    FD_COMPILER_MFENCE();
+
+    ulong ele_cnt = fd_funk_rec_map_private_vcnt_cnt( ver_cnt );
+    uint  ele_idx = chain->head_cidx;
+    for( ulong i=0UL; i<ele_cnt && ele_idx<rec_max; i++, ele_idx=rec_tbl[ ele_idx ].map_next ) {
+      fd_funk_rec_t const * rec = &rec_tbl[ ele_idx ];
+      if( FD_UNLIKELY( !rec->val_gaddr ) ) continue;
+      fd_progcache_rec_t const * prec = fd_funk_val_const( rec, wksp );
+      if( !fd_progcache_warm_save_ok( rec, prec ) ) continue;
+
+      ulong rec_sz = fd_funk_val_sz( rec );
+      fd_progcache_warm_file_entry_t fe[1];
+      memcpy( fe->prog_addr,     rec->pair.key->uc,   32UL );
+      memcpy( fe->progdata_hash, prec->progdata_hash, 32UL );
+      fe->feature_hash = prec->feature_hash;
+      fe->rec_sz       = rec_sz;
+      if( fd>=0 ) fe->rec_hash = fd_hash( FD_PROGCACHE_WARM_MAGIC, prec, rec_sz );
+
+      FD_COMPILER_MFENCE();
+      if( FD_UNLIKELY( FD_VOLATILE_CONST( chain->ver_cnt )!=ver_cnt ) ) break; /* chain changed under us */
+
+      (*entry_cnt)++;
+      if( fd<0 ) continue;
+
+      ulong wsz;
+      int err = fd_io_write( fd, fe, sizeof(fe), sizeof(fe), &wsz );
+      if( FD_LIKELY( !err ) ) err = fd_io_write( fd, prec, rec_sz, rec_sz, &wsz );
+      if( FD_UNLIKELY( err ) ) {
+        FD_LOG_WARNING(( "failed to write progcache warm file (%i-%s)", err, fd_io_strerror( err ) ));
+        return err;
+      }
+    }
+  }
+  return 0;
+}
+
+int
+fd_progcache_warm_save( fd_progcache_admin_t * cache,
+                        int                    fd,
+                        ulong *                opt_entry_cnt ) {
+  fd_funk_t * funk = cache->funk;
+
+  /* The entry count in the header is an upper bound if the cache
+     changes between the two passes (the load stops at the end of the
+     file). */
+
+  fd_progcache_warm_file_hdr_t hdr[1] = {{
+    .magic   = FD_PROGCACHE_WARM_MAGIC,
+    .version = FD_PROGCACHE_WARM_VERSION
+  }};
+  fd_progcache_warm_save_chains( funk, -1, &hdr->entry_cnt );
+
+  ulong wsz;
+  int err = fd_io_write( fd, hdr, sizeof(hdr), sizeof(hdr), &wsz );
+  if( FD_UNLIKELY( err ) ) {
+    FD_LOG_WARNING(( "failed to write progcache warm file (%i-%s)", err, fd_io_strerror( err ) ));
+    return err;
+  }
+
+  ulong save_cnt;
+  err = fd_progcache_warm_save_chains( funk, fd, &save_cnt );
+  if( FD_UNLIKELY( err ) ) return err;
+
+  if( opt_entry_cnt ) *opt_entry_cnt = save_cnt;
+  return 0;
+}
@@ -0,0 +1,173 @@
+#ifndef HEADER_fd_src_flamenco_progcache_fd_progcache_warm_h
+#define HEADER_fd_src_flamenco_progcache_fd_progcache_warm_h
+
+/* fd_progcache_warm.h provides a persistent "warm start" store for the
+   program cache.
+
+   ### Background
+
+   The program cache lives in a wksp heap and starts out empty on every
+   boot (and after a snapshot load or a cache reset).  Every hot program
+   then has to be loaded and verified again the first time it is run,
+   which makes the first few hundred slots after a restart slow.
+
+   ### Warm store
+
+   fd_progcache_warm_save dumps the executable entries of a program
+   cache to a file.  On the next boot, fd_progcache_warm_load reads that
+   file into a fd_progcache_warm_t, and program cache clients that have
+   the warm store attached (fd_progcache_set_warm) copy the verified and
+   relocated program image from the warm store on a cache miss, instead
+   of running the ELF loader and bytecode verifier.
+
+   The warm store is consulted only as a substitute for
+   fd_progcache_rec_new, so the fork and epoch logic of the program
+   cache is unaffected.  An image is only used if all of the following
+   match the program being loaded:
+   - program account address
+   - SHA-256 of the program's ELF binary (this subsumes the programdata
+     deploy slot, and unlike the funk txn the program data was last
+     written in, is stable across restarts)
+   - hash of the set of features active at the load slot (determines
+     sBPF versions, syscalls and verifier behavior)
+   - FD_PROGCACHE_WARM_VERSION, which must be bumped whenever the
+     layout of fd_progcache_rec_t or the behavior of the sBPF loader or
+     verifier changes
+
+   Hashing the ELF binary is a small fraction of the cost of loading
+   and verifying it.
+
+   ### File format
+
+   A header (fd_progcache_warm_file_hdr_t) followed by entry_cnt
+   entries, each consisting of a fd_progcache_warm_file_entry_t header
+   followed by rec_sz bytes of fd_progcache_rec_t image.  All integers
+   are little endian.  Each image is covered by a checksum, and loading
+   stops at the first corrupt or truncated entry.
+
+   ### Concurrency
+
+   A warm store is populated once by fd_progcache_warm_load before any
+   program cache client uses it and is read-only afterwards. */
+
+#include "fd_progcache_admin.h"
+#include "fd_progcache_rec.h"
+#include "../features/fd_features.h"
+
+#define FD_PROGCACHE_WARM_ALIGN   (128UL)
+#define FD_PROGCACHE_WARM_MAGIC   (0xf17eda2ce7a3ca00UL) /* firedancer warm cache ver 0 */
+#define FD_PROGCACHE_WARM_VERSION (1UL)
+
+struct fd_progcache_warm_file_hdr {
+  ulong magic;     /* ==FD_PROGCACHE_WARM_MAGIC */
+  ulong version;   /* ==FD_PROGCACHE_WARM_VERSION */
+  ulong entry_cnt;
+};
+
+typedef struct fd_progcache_warm_file_hdr fd_progcache_warm_file_hdr_t;
+
+struct fd_progcache_warm_file_entry {
+  uchar prog_addr    [ 32 ];
+  uchar progdata_hash[ 32 ];
+  ulong feature_hash;
+  ulong rec_sz;
+  ulong rec_hash;  /* fd_hash( FD_PROGCACHE_WARM_MAGIC, rec, rec_sz ) */
+};
+
+typedef struct fd_progcache_warm_file_entry fd_progcache_warm_file_entry_t;
+
+struct fd_progcache_warm_private;
+typedef struct fd_progcache_warm_private fd_progcache_warm_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_progcache_feature_hash returns a hash of the set of features that
+   are active at the given slot. */
+
+FD_FN_PURE ulong
+fd_progcache_feature_hash( fd_features_t const * features,
+                           ulong                 slot );
+
+/* Constructors *******************************************************/
+
+/* fd_progcache_warm_{align,footprint} return the alignment and
+   footprint of a warm store that can hold up to entry_max cache
+   entries totaling up to data_max bytes.  Returns 0 if the parameters
+   are invalid. */
+
+FD_FN_CONST ulong
+fd_progcache_warm_align( void );
+
+FD_FN_CONST ulong
+fd_progcache_warm_footprint( ulong entry_max,
+                             ulong data_max );
+
+/* fd_progcache_warm_new formats a memory region as an empty warm
+   store.  fd_progcache_warm_join joins the caller to a warm store.
+   fd_progcache_warm_{leave,delete} are the usual inverses.  These
+   return NULL on failure (logs details). */
+
+void *
+fd_progcache_warm_new( void * shmem,
+                       ulong  entry_max,
+                       ulong  data_max );
+
+fd_progcache_warm_t *
+fd_progcache_warm_join( void * shwarm );
+
+void *
+fd_progcache_warm_leave( fd_progcache_warm_t * warm );
+
+void *
+fd_progcache_warm_delete( void * shwarm );
+
+/* fd_progcache_warm_entry_cnt returns the number of entries in a warm
+   store. */
+
+FD_FN_PURE ulong
+fd_progcache_warm_entry_cnt( fd_progcache_warm_t const * warm );
+
+/* File I/O ***********************************************************/
+
+/* fd_progcache_warm_load reads a warm cache file from the current
+   position of fd into warm.  Entries that don't fit, duplicates and
+   files with a different FD_PROGCACHE_WARM_VERSION are skipped.  Stops
+   at the first corrupt or truncated entry (logs warning).  Returns the
+   number of entries added to warm. */
+
+ulong
+fd_progcache_warm_load( fd_progcache_warm_t * warm,
+                        int                   fd );
+
+/* fd_progcache_warm_save writes all executable entries of the given
+   program cache as a warm cache file to fd.  The program cache may have
+   been left mid-update by a killed user: entries on rec_map chains that
+   are locked or change while being read are skipped.  Returns 0 on
+   success and an errno
+   compatible error code on failure (logs details).  On success, if
+   opt_entry_cnt is non-NULL, *opt_entry_cnt is set to the number of
+   entries written. */
+
+int
+fd_progcache_warm_save( fd_progcache_admin_t * cache,
+                        int                    fd,
+                        ulong *                opt_entry_cnt );
+
+/* Queries ************************************************************/
+
+/* fd_progcache_warm_query looks up a program image in the warm store.
+   rec_sz is the footprint the caller expects the image to have (see
+   fd_progcache_rec_footprint).  Returns a pointer to the first byte of
+   the fd_progcache_rec_t image on success (lifetime of the warm join)
+   or NULL if no matching image exists. */
+
+fd_progcache_rec_t const *
+fd_progcache_warm_query( fd_progcache_warm_t const * warm,
+                         void const *                prog_addr,
+                         uchar const                 progdata_hash[ 32 ],
+                         ulong                       feature_hash,
+                         ulong                       rec_sz );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_progcache_fd_progcache_warm_h */
@@ -3,11 +3,15 @@
 
 #include "fd_progcache_admin.h"
 #include "fd_progcache_user.h"
+#include "fd_progcache_warm.h"
 #include "../accdb/fd_accdb_admin.h"
 #include "../accdb/fd_accdb_user.h"
 #include "../runtime/fd_system_ids.h"
 #include "../runtime/fd_txn_account.h"
 #include "../features/fd_features.h"
+#include "../../ballet/sha256/fd_sha256.h"
+#include <stdio.h>  /* tmpfile */
+#include <unistd.h> /* lseek, ftruncate, pread, write */
 
 /* Load in programdata for tests */
 FD_IMPORT_BINARY( valid_program_data,        "src/ballet/sbpf/fixtures/hello_solana_program.so" );
@@ -812,6 +816,193 @@ test_root_nonroot_prio( fd_wksp_t * wksp ) {
 }
 
 
+/* test_warm: Persist the program cache to a warm cache file, load it
+   into a fresh program cache, and ensure that the program image is
+   taken from the warm store instead of being re-verified. */
+
+static void
+test_warm( fd_wksp_t * wksp ) {
+  FILE * file = tmpfile();
+  FD_TEST( file );
+  int fd = fileno( file );
+
+  fd_funk_txn_xid_t fork_a = { .ul = { 1UL, 1UL } };
+  fd_funk_rec_key_t key    = test_key( 1UL );
+  fd_prog_load_env_t load_env = {
+    .slot        = 1UL,
+    .epoch       = 0UL,
+    .epoch_slot0 = 0UL
+  };
+
+  ulong  warm_footprint = fd_progcache_warm_footprint( 4UL, 1UL<<20 );
+  void * warm_mem       = fd_wksp_alloc_laddr( wksp, fd_progcache_warm_align(), warm_footprint, 1UL );
+  FD_TEST( warm_mem );
+  fd_progcache_warm_t * warm = fd_progcache_warm_join( fd_progcache_warm_new( warm_mem, 4UL, 1UL<<20 ) );
+  FD_TEST( warm );
+
+  /* Cold cache fill without a warm store is not persisted */
+
+  test_env_t * env = test_env_create( wksp );
+  load_env.features = env->features;
+  test_env_txn_prepare( env, NULL, &fork_a );
+  create_test_account( env, &fork_a, &key,
+                       &fd_solana_bpf_loader_program_id,
+                       valid_program_data,
+                       valid_program_data_sz,
+                       1 );
+  fd_progcache_rec_t const * rec = fd_progcache_pull( env->progcache, env->accdb->funk, &fork_a, &key, &load_env );
+  FD_TEST( rec && rec->executable );
+  FD_TEST( rec->feature_hash==0UL );
+
+  ulong save_cnt = ULONG_MAX;
+  FD_TEST( !fd_progcache_warm_save( env->progcache_admin, fd, &save_cnt ) );
+  FD_TEST( save_cnt==0UL );
+  FD_TEST( lseek( fd, 0L, SEEK_SET )==0L );
+  FD_TEST( !ftruncate( fd, 0L ) );
+
+  test_env_txn_cancel( env, &fork_a );
+  test_env_destroy( env );
+
+  /* Cold cache fill with an empty warm store, then save */
+
+  env = test_env_create( wksp );
+  load_env.features = env->features;
+  fd_progcache_set_warm( env->progcache, warm );
+  test_env_txn_prepare( env, NULL, &fork_a );
+  create_test_account( env, &fork_a, &key,
+                       &fd_solana_bpf_loader_program_id,
+                       valid_program_data,
+                       valid_program_data_sz,
+                       1 );
+  ulong warm_miss_cnt = env->progcache->metrics->warm_miss_cnt;
+  rec = fd_progcache_pull( env->progcache, env->accdb->funk, &fork_a, &key, &load_env );
+  FD_TEST( rec && rec->executable );
+  FD_TEST( env->progcache->metrics->warm_miss_cnt==warm_miss_cnt+1UL );
+  ulong feature_hash = fd_progcache_feature_hash( env->features, load_env.slot );
+  FD_TEST( rec->feature_hash==feature_hash );
+
+  /* Entries on a rec_map chain left locked (e.g. by a killed tile) are
+     not saved */
+
+  fd_funk_rec_t const * frec = query_rec_exact( env, &fork_a, &key );
+  FD_TEST( frec );
+  struct {
+    fd_funk_rec_map_txn_t txn[1];
+    fd_funk_rec_map_txn_private_info_t info[1];
+  } _map_txn;
+  fd_funk_rec_map_txn_t * map_txn = fd_funk_rec_map_txn_init( _map_txn.txn, env->progcache->funk->rec_map, 1UL );
+  fd_funk_rec_map_txn_add( map_txn, &frec->pair, 1 );
+  FD_TEST( fd_funk_rec_map_txn_try( map_txn, FD_MAP_FLAG_BLOCKING )==FD_MAP_SUCCESS );
+  FD_TEST( !fd_progcache_warm_save( env->progcache_admin, fd, &save_cnt ) );
+  FD_TEST( save_cnt==0UL );
+  FD_TEST( fd_funk_rec_map_txn_test( map_txn )==FD_MAP_SUCCESS );
+  fd_funk_rec_map_txn_fini( map_txn );
+  FD_TEST( lseek( fd, 0L, SEEK_SET )==0L );
+  FD_TEST( !ftruncate( fd, 0L ) );
+
+  FD_TEST( !fd_progcache_warm_save( env->progcache_admin, fd, &save_cnt ) );
+  FD_TEST( save_cnt==1UL );
+
+  ulong  rec_sz   = fd_funk_val_sz( query_rec_exact( env, &fork_a, &key ) );
+  uchar * rec_cpy = fd_wksp_alloc_laddr( wksp, fd_progcache_rec_align(), rec_sz, 1UL );
+  FD_TEST( rec_cpy );
+  fd_memcpy( rec_cpy, rec, rec_sz );
+
+  test_env_txn_cancel( env, &fork_a );
+  test_env_destroy( env );
+
+  /* Images whose offsets point outside of the image are rejected, even
+     with a valid checksum */
+
+  ulong   file_sz  = sizeof(fd_progcache_warm_file_hdr_t)+sizeof(fd_progcache_warm_file_entry_t)+rec_sz;
+  uchar * file_buf = fd_wksp_alloc_laddr( wksp, 8UL, file_sz, 1UL );
+  FD_TEST( file_buf );
+  FD_TEST( pread( fd, file_buf, file_sz, 0L )==(long)file_sz );
+  fd_progcache_warm_file_entry_t * fe    = (fd_progcache_warm_file_entry_t *)( file_buf+sizeof(fd_progcache_warm_file_hdr_t) );
+  fd_progcache_rec_t *             image = (fd_progcache_rec_t *)( fe+1 );
+  fd_progcache_rec_t               good  = *image;
+  for( ulong i=0UL; i<6UL; i++ ) {
+    *image = good;
+    switch( i ) {
+    case 0: image->entry_pc      = good.text_cnt;                     break;
+    case 1: image->text_off      = good.rodata_sz;                    break;
+    case 2: image->text_cnt      = good.text_cnt+1U;                  break;
+    case 3: image->rodata_sz     = (uint)rec_sz;                      break;
+    case 4: image->calldests_off = good.calldests_off ? 0U : 8U;      break;
+    case 5: image->rodata_off    = (uint)sizeof(fd_progcache_rec_t)-8U; break;
+    }
+    fe->rec_hash = fd_hash( FD_PROGCACHE_WARM_MAGIC, image, rec_sz );
+    FILE * bad_file = tmpfile();
+    FD_TEST( bad_file );
+    FD_TEST( write( fileno( bad_file ), file_buf, file_sz )==(long)file_sz );
+    FD_TEST( lseek( fileno( bad_file ), 0L, SEEK_SET )==0L );
+    FD_TEST( fd_progcache_warm_load( warm, fileno( bad_file ) )==0UL );
+    FD_TEST( fd_progcache_warm_entry_cnt( warm )==0UL );
+    fclose( bad_file );
+  }
+  fd_wksp_free_laddr( file_buf );
+
+  /* Load warm store */
+
+  FD_TEST( lseek( fd, 0L, SEEK_SET )==0L );
+  FD_TEST( fd_progcache_warm_load( warm, fd )==1UL );
+  FD_TEST( fd_progcache_warm_entry_cnt( warm )==1UL );
+
+  /* Mismatching environments are not served */
+
+  uchar progdata_hash[ 32 ];
+  fd_sha256_hash( valid_program_data, valid_program_data_sz, progdata_hash );
+  FD_TEST(  fd_progcache_warm_query( warm, &key, progdata_hash, feature_hash,     rec_sz ) );
+  FD_TEST( !fd_progcache_warm_query( warm, &key, progdata_hash, feature_hash+1UL, rec_sz ) );
+  FD_TEST( !fd_progcache_warm_query( warm, &key, progdata_hash, feature_hash,     rec_sz+8UL ) );
+  fd_funk_rec_key_t key2 = test_key( 2UL );
+  FD_TEST( !fd_progcache_warm_query( warm, &key2, progdata_hash, feature_hash, rec_sz ) );
+  progdata_hash[ 0 ]++;
+  FD_TEST( !fd_progcache_warm_query( warm, &key, progdata_hash, feature_hash, rec_sz ) );
+
+  /* Warm cache fill */
+
+  env = test_env_create( wksp );
+  load_env.features = env->features;
+  fd_progcache_set_warm( env->progcache, warm );
+  test_env_txn_prepare( env, NULL, &fork_a );
+  create_test_account( env, &fork_a, &key,
+                       &fd_solana_bpf_loader_program_id,
+                       valid_program_data,
+                       valid_program_data_sz,
+                       1 );
+  ulong warm_hit_cnt = env->progcache->metrics->warm_hit_cnt;
+  rec = fd_progcache_pull( env->progcache, env->accdb->funk, &fork_a, &key, &load_env );
+  FD_TEST( rec && rec->executable );
+  FD_TEST( env->progcache->metrics->warm_hit_cnt==warm_hit_cnt+1UL );
+  FD_TEST( !memcmp( rec, rec_cpy, rec_sz ) );
+
+  /* A different program at the same address is loaded cold */
+
+  fd_funk_txn_xid_t fork_b = { .ul = { 2UL, 1UL } };
+  test_env_txn_prepare( env, &fork_a, &fork_b );
+  create_test_account( env, &fork_b, &key,
+                       &fd_solana_bpf_loader_program_id,
+                       bigger_valid_program_data,
+                       bigger_valid_program_data_sz,
+                       1 );
+  fd_progcache_invalidate( env->progcache, &fork_b, &key, 2UL );
+  fd_funk_txn_xid_t fork_c = { .ul = { 3UL, 1UL } };
+  test_env_txn_prepare( env, &fork_b, &fork_c );
+  warm_miss_cnt = env->progcache->metrics->warm_miss_cnt;
+  load_env.slot = 3UL;
+  rec = fd_progcache_pull( env->progcache, env->accdb->funk, &fork_c, &key, &load_env );
+  FD_TEST( rec && rec->executable );
+  FD_TEST( env->progcache->metrics->warm_miss_cnt==warm_miss_cnt+1UL );
+
+  test_env_txn_cancel( env, &fork_a );
+  test_env_destroy( env );
+
+  fd_wksp_free_laddr( fd_progcache_warm_delete( fd_progcache_warm_leave( warm ) ) );
+  fd_wksp_free_laddr( rec_cpy );
+  fclose( file );
+}
+
 
 struct test_case {
   char const * name;
@@ -865,6 +1056,7 @@ main( int     argc,
     TEST( test_publish_gc2 ),
     TEST( test_publish_trivial ),
     TEST( test_root_nonroot_prio ),
+    TEST( test_warm ),
     {0}
   };
 # undef TEST
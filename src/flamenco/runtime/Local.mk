@@ -55,6 +55,11 @@ $(call make-unit-test,test_txncache,test_txncache,fd_flamenco fd_ballet fd_util)
 ifdef FD_HAS_ATOMIC
 $(call add-hdrs,fd_runtime.h fd_runtime_init.h fd_runtime_err.h fd_runtime_const.h fd_runtime_stack.h fd_exec_stack.h)
 $(call add-objs,fd_runtime fd_runtime_init,fd_flamenco)
+# fd_runtime pulls in the secp256k1 precompile (like test_runtime_alut)
+ifdef FD_HAS_SECP256K1
+$(call make-unit-test,test_runtime_commit,test_runtime_commit,fd_flamenco fd_funk fd_ballet fd_util)
+$(call run-unit-test,test_runtime_commit)
+endif
 endif
 
 endif
@@ -201,7 +201,10 @@ fd_exec_txn_ctx_setup_basic( fd_exec_txn_ctx_t * ctx ) {
 
 void
 fd_exec_txn_ctx_teardown( fd_exec_txn_ctx_t * ctx ) {
-  (void)ctx;
+  /* Discard the staged changes of accounts that were not committed */
+  for( ulong i=0UL; i<ctx->accounts_cnt; i++ ) {
+    fd_txn_account_release_stage_val( &ctx->accounts[ i ] );
+  }
 }
 
 void
@@ -120,6 +120,12 @@ struct fd_exec_txn_ctx {
   ulong                           execution_fee;                               /* Execution fee paid by the fee payer in the transaction */
   ulong                           priority_fee;                                /* Priority fee paid by the fee payer in the transaction */
 
+  /* Writable account copy accounting, filled in at commit by
+     fd_runtime_finalize_txn. */
+  ulong                           accounts_clean_cnt;                          /* Writable accounts never modified and not written back */
+  ulong                           accounts_stage_sz;                           /* Bytes copied into staging on first modification */
+  ulong                           accounts_commit_sz;                          /* Bytes copied into the accounts database at commit */
+
   fd_capture_ctx_t * capture_ctx;
 
   /* The instr_infos for the entire transaction are allocated at the start of
@@ -225,6 +231,12 @@ fd_exec_txn_ctx_delete( void * mem );
 void
 fd_exec_txn_ctx_setup_basic( fd_exec_txn_ctx_t * ctx );
 
+/* fd_exec_txn_ctx_teardown releases what the accounts of the
+   transaction still hold on to in the accounts database (the values of
+   staged accounts that were not committed).  Must be called once the
+   transaction is finalized or dropped, before the accounts database
+   moves on. */
+
 void
 fd_exec_txn_ctx_teardown( fd_exec_txn_ctx_t * txn_ctx );
 
@@ -1350,6 +1350,8 @@ fd_execute_instr( fd_exec_txn_ctx_t * txn_ctx,
 void
 fd_executor_reclaim_account( fd_exec_txn_ctx_t * txn_ctx,
                              fd_txn_account_t *  account ) {
+  /* Accounts that were never modified are not written back */
+  if( !fd_txn_account_is_dirty( account ) ) return;
   fd_txn_account_set_slot( account, txn_ctx->slot );
   if( FD_UNLIKELY( fd_txn_account_get_lamports( account )==0UL ) ) {
     fd_txn_account_set_data_len( account, 0UL );
@@ -1451,25 +1453,28 @@ fd_executor_setup_txn_account( fd_exec_txn_ctx_t * txn_ctx,
   int                 is_writable  = fd_exec_txn_ctx_account_is_writable_idx( txn_ctx, idx ) || idx==FD_FEE_PAYER_TXN_IDX;
   fd_account_meta_t * account_meta = NULL;
 
+  uchar * stage_mem = NULL;
   if( is_writable ) {
-    /* If the account is writable or a fee payer, then we need to create
-       staging regions for the account. If the account exists, we need to
-       copy the account data into the staging area; otherwise, we need to
-       initialize a new metadata. */
+    /* If the account is writable or a fee payer, then we need a staging
+       region for the account.  If the account exists, the account is
+       set up copy-on-write: it keeps referencing the database record
+       and is only copied when it is first modified (most writable
+       accounts only see a lamport change or nothing at all), into a
+       value allocated from the database heap that is published as is
+       at commit.  Otherwise, we need to initialize a new metadata in
+       the staging area. */
 
     uchar * new_raw_data = txn_ctx->exec_accounts->accounts_mem[idx];
-    ulong   dlen         = !!meta ? meta->dlen : 0UL;
 
     if( FD_LIKELY( meta ) ) {
-      /* Account exists, copy the data into the staging area */
-      fd_memcpy( new_raw_data, (uchar *)meta, sizeof(fd_account_meta_t)+dlen );
+      account_meta = (fd_account_meta_t *)meta;
+      stage_mem    = new_raw_data;
     } else {
       /* Account did not exist, set up metadata */
-      fd_account_meta_init( (fd_account_meta_t *)new_raw_data );
+      account_meta = (fd_account_meta_t *)new_raw_data;
+      fd_account_meta_init( account_meta );
     }
 
-    account_meta = (fd_account_meta_t *)new_raw_data;
-
   } else {
     /* If the account is not writable, then we can simply initialize
        the txn account with the read-only accountsdb record. However,
@@ -1492,6 +1497,10 @@ fd_executor_setup_txn_account( fd_exec_txn_ctx_t * txn_ctx,
       is_writable ) ) ) ) {
     FD_LOG_CRIT(( "Failed to join txn account" ));
   }
+  if( stage_mem ) {
+    fd_txn_account_set_stage_mem  ( txn_account, stage_mem );
+    fd_txn_account_set_stage_alloc( txn_account, fd_funk_alloc( txn_ctx->funk ) );
+  }
 
   return txn_account;
 }
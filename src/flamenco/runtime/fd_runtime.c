@@ -703,9 +703,27 @@ fd_runtime_pre_execute_check( fd_exec_txn_ctx_t * txn_ctx ) {
 }
 
 /* fd_runtime_finalize_account is a helper used to commit the data from
-   a writable transaction account back into the accountsdb. */
+   a writable transaction account back into the accountsdb.  Accounts
+   that were staged into a database value hand that value over to the
+   record instead of being copied.  Returns the number of bytes copied
+   into the accountsdb. */
+
+/* fd_runtime_finalize_account_val makes val (allocated from the funk
+   heap, val_max bytes of which record_sz are in use) the value of rec.
+   Assumes rec has no value. */
 
 static void
+fd_runtime_finalize_account_val( fd_funk_t *     funk,
+                                 fd_funk_rec_t * rec,
+                                 void *          val,
+                                 ulong           record_sz,
+                                 ulong           val_max ) {
+  rec->val_gaddr = fd_wksp_gaddr_fast( fd_funk_wksp( funk ), val );
+  rec->val_sz    = (uint)( fd_ulong_min( record_sz, FD_FUNK_REC_VAL_MAX ) & FD_FUNK_REC_VAL_MAX );
+  rec->val_max   = (uint)( fd_ulong_min( val_max,   FD_FUNK_REC_VAL_MAX ) & FD_FUNK_REC_VAL_MAX );
+}
+
+static ulong
 fd_runtime_finalize_account( fd_funk_t *               funk,
                              fd_funk_txn_xid_t const * xid,
                              fd_txn_account_t *        acc,
@@ -720,6 +738,9 @@ fd_runtime_finalize_account( fd_funk_t *               funk,
 
   int err = FD_FUNK_SUCCESS;
 
+  ulong  val_max = 0UL;
+  void * val     = fd_txn_account_take_stage_val( acc, &val_max );
+
   if( !prev_rec || !fd_funk_txn_xid_eq( prev_rec->pair.xid, xid ) ) {
 
     fd_funk_rec_key_t     funk_key = fd_funk_acc_key( key );
@@ -729,6 +750,12 @@ fd_runtime_finalize_account( fd_funk_t *               funk,
       FD_LOG_ERR(( "fd_runtime_finalize_account: failed to prepare record (%i-%s)", err, fd_funk_strerror( err ) ));
     }
 
+    if( FD_LIKELY( val ) ) {
+      fd_runtime_finalize_account_val( funk, rec, val, record_sz, val_max );
+      fd_funk_rec_publish( funk, prepare );
+      return 0UL;
+    }
+
     if( FD_UNLIKELY( !fd_funk_val_truncate(
         rec,
         fd_funk_alloc( funk ),
@@ -745,6 +772,12 @@ fd_runtime_finalize_account( fd_funk_t *               funk,
 
   } else {
 
+    if( FD_LIKELY( val ) ) {
+      fd_funk_val_flush( prev_rec, fd_funk_alloc( funk ), fd_funk_wksp( funk ) );
+      fd_runtime_finalize_account_val( funk, prev_rec, val, record_sz, val_max );
+      return 0UL;
+    }
+
     if( FD_UNLIKELY( !fd_funk_val_truncate(
         prev_rec,
         fd_funk_alloc( funk ),
@@ -759,6 +792,7 @@ fd_runtime_finalize_account( fd_funk_t *               funk,
 
   }
 
+  return record_sz;
 }
 
 /* fd_runtime_buffer_solcap_account_update buffers an account
@@ -830,9 +864,10 @@ fd_runtime_buffer_solcap_account_update( fd_txn_account_t *        account,
 
    The function handles FD_ACC_MGR_ERR_UNKNOWN_ACCOUNT gracefully (uses
    zero hash).  On other funk errors, the function will FD_LOG_ERR.
-   All non-optional pointers must be valid. */
+   All non-optional pointers must be valid.  Returns the number of bytes
+   copied into Funk. */
 
-static void
+static ulong
 fd_runtime_save_account( fd_funk_t *               funk,
                          fd_funk_txn_xid_t const * xid,
                          fd_txn_account_t *        account,
@@ -874,7 +909,29 @@ fd_runtime_save_account( fd_funk_t *               funk,
   fd_runtime_buffer_solcap_account_update( account, bank, capture_ctx );
 
   /* Save the new version of the account to Funk */
-  fd_runtime_finalize_account( funk, xid, account, funk_prev_rec );
+  return fd_runtime_finalize_account( funk, xid, account, funk_prev_rec );
+}
+
+void
+fd_runtime_commit_account( fd_funk_t *               funk,
+                           fd_funk_txn_xid_t const * xid,
+                           fd_exec_txn_ctx_t *       txn_ctx,
+                           fd_txn_account_t *        acc,
+                           fd_bank_t *               bank,
+                           fd_capture_ctx_t *        capture_ctx ) {
+  /* Accounts that were never modified still reference the current
+     database record: there is nothing to hash or write back. */
+  if( !fd_txn_account_is_dirty( acc ) ) {
+    txn_ctx->accounts_clean_cnt++;
+    fd_runtime_buffer_solcap_account_update( acc, bank, capture_ctx );
+    return;
+  }
+
+  /* Reclaim any accounts that have 0-lamports, now that any related
+     cache updates have been applied. */
+  fd_executor_reclaim_account( txn_ctx, acc );
+
+  txn_ctx->accounts_commit_sz += fd_runtime_save_account( funk, xid, acc, bank, capture_ctx );
 }
 
 /* fd_runtime_finalize_txn is a helper used by the non-tpool transaction
@@ -899,6 +956,14 @@ fd_runtime_finalize_txn( fd_funk_t *               funk,
 
   FD_ATOMIC_FETCH_AND_ADD( fd_bank_signature_count_modify( bank ), TXN( &txn_ctx->txn )->signature_cnt );
 
+  txn_ctx->accounts_clean_cnt = 0UL;
+  txn_ctx->accounts_stage_sz  = 0UL;
+  txn_ctx->accounts_commit_sz = 0UL;
+  for( ushort i=0; i<txn_ctx->accounts_cnt; i++ ) {
+    if( !fd_exec_txn_ctx_account_is_writable_idx( txn_ctx, i ) && i!=FD_FEE_PAYER_TXN_IDX ) continue;
+    txn_ctx->accounts_stage_sz += txn_ctx->accounts[i].stage_sz;
+  }
+
   if( FD_UNLIKELY( txn_ctx->exec_err ) ) {
 
     /* Save the fee_payer. Everything but the fee balance should be reset.
@@ -915,12 +980,12 @@ fd_runtime_finalize_txn( fd_funk_t *               funk,
 
        We should always rollback the nonce account first. Note that the nonce account may be the fee payer (case 2). */
     if( txn_ctx->nonce_account_idx_in_txn!=ULONG_MAX ) {
-      fd_runtime_save_account( funk, xid, txn_ctx->rollback_nonce_account, bank, capture_ctx );
+      txn_ctx->accounts_commit_sz += fd_runtime_save_account( funk, xid, txn_ctx->rollback_nonce_account, bank, capture_ctx );
     }
 
     /* Now, we must only save the fee payer if the nonce account was not the fee payer (because that was already saved above) */
     if( FD_LIKELY( txn_ctx->nonce_account_idx_in_txn!=FD_FEE_PAYER_TXN_IDX ) ) {
-      fd_runtime_save_account( funk, xid, txn_ctx->rollback_fee_payer_account, bank, capture_ctx );
+      txn_ctx->accounts_commit_sz += fd_runtime_save_account( funk, xid, txn_ctx->rollback_fee_payer_account, bank, capture_ctx );
     }
   } else {
 
@@ -965,11 +1030,7 @@ fd_runtime_finalize_txn( fd_funk_t *               funk,
         fd_stakes_update_stake_delegation( acc_rec, bank );
       }
 
-      /* Reclaim any accounts that have 0-lamports, now that any related
-         cache updates have been applied. */
-      fd_executor_reclaim_account( txn_ctx, &txn_ctx->accounts[i] );
-
-      fd_runtime_save_account( funk, xid, &txn_ctx->accounts[i], bank, capture_ctx );
+      fd_runtime_commit_account( funk, xid, txn_ctx, acc_rec, bank, capture_ctx );
     }
 
     /* We need to queue any existing program accounts that may have
@@ -983,6 +1044,10 @@ fd_runtime_finalize_txn( fd_funk_t *               funk,
       }
   }
 
+  /* Free the staged copies that were not handed to the accounts
+     database (all of them if the transaction failed). */
+  fd_exec_txn_ctx_teardown( txn_ctx );
+
   int is_vote = fd_txn_is_simple_vote_transaction( TXN( &txn_ctx->txn ), txn_ctx->txn.payload );
   if( !is_vote ){
     ulong * nonvote_txn_count = fd_bank_nonvote_txn_count_modify( bank );
@@ -304,6 +304,20 @@ fd_runtime_prepare_and_execute_txn( fd_banks_t *         banks,
                                     uchar *              dumping_mem,
                                     uchar *              tracing_mem );
 
+/* fd_runtime_commit_account writes writable transaction account acc
+   back to the accounts database at xid and mixes it into the bank
+   lthash.  Accounts that were never modified are skipped (and counted
+   in txn_ctx->accounts_clean_cnt).  Bytes copied into the database are
+   added to txn_ctx->accounts_commit_sz. */
+
+void
+fd_runtime_commit_account( fd_funk_t *               funk,
+                           fd_funk_txn_xid_t const * xid,
+                           fd_exec_txn_ctx_t *       txn_ctx,
+                           fd_txn_account_t *        acc,
+                           fd_bank_t *               bank,
+                           fd_capture_ctx_t *        capture_ctx );
+
 void
 fd_runtime_finalize_txn( fd_funk_t *               funk,
                          fd_progcache_t *          progcache,
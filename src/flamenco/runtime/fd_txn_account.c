@@ -45,6 +45,14 @@ fd_txn_account_new( void *              mem,
   txn_account->data       = data;
   txn_account->is_mutable = is_mutable;
 
+  txn_account->stage_mem     = NULL;
+  txn_account->is_dirty      = 0;
+  txn_account->stage_sz      = 0UL;
+  txn_account->stage_alloc   = NULL;
+  txn_account->stage_val     = NULL;
+  txn_account->stage_val_max = 0UL;
+  txn_account->spill_mem     = NULL;
+
   return mem;
 }
 
@@ -257,6 +265,133 @@ fd_txn_account_release_write_private( fd_txn_account_t * acct ) {
   }
 }
 
+/* copy-on-write staging */
+
+void
+fd_txn_account_set_stage_mem( fd_txn_account_t * acct,
+                              uchar *            stage_mem ) {
+  if( FD_UNLIKELY( !acct->is_mutable ) ) {
+    FD_LOG_CRIT(( "account is not mutable" ));
+  }
+  if( FD_UNLIKELY( acct->is_dirty ) ) {
+    FD_LOG_CRIT(( "account is already staged" ));
+  }
+  acct->stage_mem = stage_mem;
+}
+
+void
+fd_txn_account_set_stage_alloc( fd_txn_account_t * acct,
+                                fd_alloc_t *       alloc ) {
+  if( FD_UNLIKELY( !acct->stage_mem ) ) {
+    FD_LOG_CRIT(( "account is not copy-on-write" ));
+  }
+  acct->stage_alloc = alloc;
+}
+
+static void
+fd_txn_account_repoint( fd_txn_account_t * acct,
+                        uchar *            mem ) {
+  acct->meta      = (fd_account_meta_t *)mem;
+  acct->data      = mem + sizeof(fd_account_meta_t);
+  acct->meta_soff = (long)( (ulong)mem - (ulong)acct );
+}
+
+/* fd_txn_account_stage_private stages acct (if it has not been staged
+   yet) with room for dlen_max bytes of data. */
+
+static ulong
+fd_txn_account_stage_private( fd_txn_account_t * acct,
+                              ulong              dlen_max ) {
+  acct->is_dirty = 1;
+
+  uchar * stage_mem = acct->stage_mem;
+  if( FD_LIKELY( !stage_mem ) ) return 0UL;
+
+  if( FD_UNLIKELY( !acct->meta ) ) {
+    FD_LOG_CRIT(( "account is not setup" ));
+  }
+
+  ulong   sz  = sizeof(fd_account_meta_t) + acct->meta->dlen;
+  uchar * dst = stage_mem;
+  if( acct->stage_alloc ) {
+    ulong  val_sz  = fd_ulong_min( fd_ulong_max( sz, sizeof(fd_account_meta_t)+dlen_max ), FD_ACC_TOT_SZ_MAX );
+    ulong  val_max = 0UL;
+    void * val     = fd_alloc_malloc_at_least( acct->stage_alloc, 16UL, val_sz, &val_max );
+    if( FD_LIKELY( val ) ) {
+      acct->stage_val     = val;
+      acct->stage_val_max = val_max;
+      acct->spill_mem     = stage_mem;
+      dst                 = val;
+    }
+  }
+  fd_memcpy( dst, acct->meta, sz );
+
+  fd_txn_account_repoint( acct, dst );
+  acct->stage_mem = NULL;
+  acct->stage_sz  = sz;
+  return sz;
+}
+
+ulong
+fd_txn_account_stage( fd_txn_account_t * acct ) {
+  return fd_txn_account_stage_private( acct, 0UL );
+}
+
+void
+fd_txn_account_reserve( fd_txn_account_t * acct,
+                        ulong              dlen_max ) {
+  if( FD_UNLIKELY( !acct->meta ) ) {
+    FD_LOG_CRIT(( "account is not setup" ));
+  }
+  if( acct->stage_mem ) {
+    fd_txn_account_stage_private( acct, dlen_max );
+    return;
+  }
+
+  dlen_max = fd_ulong_min( dlen_max, FD_RUNTIME_ACC_SZ_MAX );
+  if( FD_LIKELY( !acct->stage_val || sizeof(fd_account_meta_t)+dlen_max<=acct->stage_val_max ) ) return;
+
+  /* The stage value is too small, move the account to its staging
+     buffer, which has room for any account. */
+
+  ulong sz = sizeof(fd_account_meta_t) + acct->meta->dlen;
+  fd_memcpy( acct->spill_mem, acct->meta, sz );
+  fd_txn_account_repoint( acct, acct->spill_mem );
+  acct->stage_sz += sz;
+
+  fd_alloc_free( acct->stage_alloc, acct->stage_val );
+  acct->stage_val     = NULL;
+  acct->stage_val_max = 0UL;
+}
+
+int
+fd_txn_account_is_cow( fd_txn_account_t const * acct ) {
+  return !!acct->stage_mem;
+}
+
+void *
+fd_txn_account_take_stage_val( fd_txn_account_t * acct,
+                               ulong *            val_max ) {
+  void * val = acct->stage_val;
+  *val_max = acct->stage_val_max;
+  acct->stage_val     = NULL;
+  acct->stage_val_max = 0UL;
+  return val;
+}
+
+void
+fd_txn_account_release_stage_val( fd_txn_account_t * acct ) {
+  if( FD_LIKELY( !acct->stage_val ) ) return;
+  fd_alloc_free( acct->stage_alloc, acct->stage_val );
+  acct->stage_val     = NULL;
+  acct->stage_val_max = 0UL;
+}
+
+int
+fd_txn_account_is_dirty( fd_txn_account_t const * acct ) {
+  return acct->is_dirty;
+}
+
 fd_pubkey_t const *
 fd_txn_account_get_owner( fd_txn_account_t const * acct ) {
   if( FD_UNLIKELY( !acct->meta ) ) {
@@ -276,7 +411,8 @@ fd_txn_account_get_data( fd_txn_account_t const * acct ) {
 }
 
 uchar *
-fd_txn_account_get_data_mut( fd_txn_account_t const * acct ) {
+fd_txn_account_get_data_mut( fd_txn_account_t * acct ) {
+  fd_txn_account_stage( acct );
   return acct->data;
 }
 
@@ -318,7 +454,10 @@ fd_txn_account_set_meta( fd_txn_account_t * acct, fd_account_meta_t * meta ) {
   if( FD_UNLIKELY( !meta ) ) {
     FD_LOG_CRIT(( "account is not setup" ));
   }
-  acct->meta = meta;
+  fd_txn_account_release_stage_val( acct );
+  acct->meta      = meta;
+  acct->stage_mem = NULL;
+  acct->is_dirty  = 1;
 }
 
 void
@@ -329,6 +468,7 @@ fd_txn_account_set_executable( fd_txn_account_t * acct, int is_executable ) {
   if( FD_UNLIKELY( !acct->meta ) ) {
     FD_LOG_CRIT(( "account is not setup" ));
   }
+  fd_txn_account_stage( acct );
   acct->meta->executable = !!is_executable;
 }
 
@@ -340,6 +480,7 @@ fd_txn_account_set_owner( fd_txn_account_t * acct, fd_pubkey_t const * owner ) {
   if( FD_UNLIKELY( !acct->meta ) ) {
     FD_LOG_CRIT(( "account is not setup" ));
   }
+  fd_txn_account_stage( acct );
   fd_memcpy( acct->meta->owner, owner, sizeof(fd_pubkey_t) );
 }
 
@@ -351,6 +492,7 @@ fd_txn_account_set_lamports( fd_txn_account_t * acct, ulong lamports ) {
   if( FD_UNLIKELY( !acct->meta ) ) {
     FD_LOG_CRIT(( "account is not setup" ));
   }
+  fd_txn_account_stage( acct );
   acct->meta->lamports = lamports;
 }
 
@@ -390,6 +532,12 @@ fd_txn_account_set_data( fd_txn_account_t * acct,
   if( FD_UNLIKELY( !acct->meta ) ) {
     FD_LOG_CRIT(( "account is not setup" ));
   }
+  /* Deserializing the input region writes back every writable account
+     the program was handed, most of which are left untouched.  Avoid
+     staging (and later committing) a copy of those. */
+  if( acct->meta->dlen==data_sz && !memcmp( acct->data, data, data_sz ) ) return;
+  fd_txn_account_stage_private( acct, data_sz );
+  fd_txn_account_reserve( acct, data_sz );
   acct->meta->dlen = (uint)data_sz;
   fd_memcpy( acct->data, data, data_sz );
 }
@@ -402,6 +550,8 @@ fd_txn_account_set_data_len( fd_txn_account_t * acct, ulong data_len ) {
   if( FD_UNLIKELY( !acct->meta ) ) {
     FD_LOG_CRIT(( "account is not setup" ));
   }
+  fd_txn_account_stage_private( acct, data_len );
+  fd_txn_account_reserve( acct, data_len );
   acct->meta->dlen = (uint)data_len;
 }
 
@@ -413,6 +563,7 @@ fd_txn_account_set_slot( fd_txn_account_t * acct, ulong slot ) {
   if( FD_UNLIKELY( !acct->meta ) ) {
     FD_LOG_CRIT(( "account is not setup" ));
   }
+  fd_txn_account_stage( acct );
   acct->meta->slot = slot;
 }
 
@@ -424,6 +575,7 @@ fd_txn_account_clear_owner( fd_txn_account_t * acct ) {
   if( FD_UNLIKELY( !acct->meta ) ) {
     FD_LOG_CRIT(( "account is not setup" ));
   }
+  fd_txn_account_stage( acct );
   fd_memset( acct->meta->owner, 0, sizeof(fd_pubkey_t) );
 }
 
@@ -436,9 +588,12 @@ fd_txn_account_resize( fd_txn_account_t * acct,
   if( FD_UNLIKELY( !acct->meta ) ) {
     FD_LOG_CRIT(( "account is not setup" ));
   }
+  fd_txn_account_stage_private( acct, dlen );
+  fd_txn_account_reserve( acct, dlen );
   /* Because the memory for an account is preallocated for the transaction
-     up to the max account size, we only need to zero out bytes (for the case
-     where the account grew) and update the account dlen. */
+     up to the max account size (or was just reserved above), we only need
+     to zero out bytes (for the case where the account grew) and update the
+     account dlen. */
   ulong old_sz    = acct->meta->dlen;
   ulong new_sz    = dlen;
   ulong memset_sz = fd_ulong_sat_sub( new_sz, old_sz );
@@ -18,6 +18,27 @@ typedef struct fd_acc_mgr fd_acc_mgr_t;
    fd_txn_account_t is NOT thread-safe and only supports a single join
    at a given time.
 
+   A mutable txn account can be set up copy-on-write: meta/data point
+   at the (read-only) database record and a staging buffer is attached
+   with fd_txn_account_set_stage_mem.  The record is only copied into
+   the staging buffer on the first mutation (any setter, resize or
+   fd_txn_account_get_data_mut).  Accounts that are never mutated are
+   never copied and fd_txn_account_is_dirty reports them as clean so
+   they can be skipped at commit.  Note that pointers previously
+   returned by the const accessors keep pointing at the original record
+   after the account is staged.
+
+   If a staging allocator is attached with
+   fd_txn_account_set_stage_alloc, the record is staged into a value
+   allocated from the accounts database heap instead, which can be
+   handed to the database at commit without another copy.  Such a
+   value is sized for the record at the time it is staged (or for the
+   size passed to fd_txn_account_reserve): growing the account past it
+   moves the account to the staging buffer, which also moves its data.
+   Callers that hold on to a data pointer while the account may grow
+   (e.g. direct mapping of account data into the VM) reserve room for
+   that growth up front.
+
    TODO: Consider changing the meta/data boundary to make it more
    explicit that the caller passes in a contigious region of memory
    which has to correspond to the meta/data layout.
@@ -35,6 +56,22 @@ struct __attribute__((aligned(8UL))) fd_txn_account {
   int                             is_mutable;
   long                            meta_soff;
 
+  /* Copy-on-write state.  stage_mem is non-NULL while meta/data still
+     point at the database record; it is the buffer the record will be
+     copied into on the first mutation (at least FD_ACC_TOT_SZ_MAX
+     bytes).  is_dirty is set by any mutation.  stage_sz is the number
+     of bytes copied when the account was staged.  If stage_alloc is
+     set, the record is staged into stage_val (stage_val_max bytes
+     allocated from stage_alloc) instead and spill_mem holds on to the
+     staging buffer for when the account outgrows stage_val. */
+  uchar *                         stage_mem;
+  int                             is_dirty;
+  ulong                           stage_sz;
+  fd_alloc_t *                    stage_alloc;
+  void *                          stage_val;
+  ulong                           stage_val_max;
+  uchar *                         spill_mem;
+
   ulong                           starting_dlen;
   ulong                           starting_lamports;
 
@@ -137,6 +174,77 @@ fd_txn_account_mutable_fini( fd_txn_account_t *        acct,
                              fd_accdb_user_t *         funk,
                              fd_funk_rec_prepare_t *   prepare );
 
+/* fd_txn_account_set_stage_mem makes acct copy-on-write: the account
+   record is copied into stage_mem (which must have room for
+   FD_ACC_TOT_SZ_MAX bytes and outlive the account) the first time the
+   account is mutated.  Until then meta/data keep pointing at the record
+   acct was created with, which must not be modified. */
+
+void
+fd_txn_account_set_stage_mem( fd_txn_account_t * acct,
+                              uchar *            stage_mem );
+
+/* fd_txn_account_set_stage_alloc makes a copy-on-write acct stage its
+   record into a value allocated from alloc (which must be the accounts
+   database heap) rather than into its staging buffer.  The value is
+   either handed over with fd_txn_account_take_stage_val or freed with
+   fd_txn_account_release_stage_val.  If the allocation fails, the
+   account is staged into its staging buffer as usual. */
+
+void
+fd_txn_account_set_stage_alloc( fd_txn_account_t * acct,
+                                fd_alloc_t *       alloc );
+
+/* fd_txn_account_stage copies the account record into its staging
+   buffer (or value, see above) if it has not been copied yet and marks
+   the account dirty.  All mutators call this first; it is exposed for
+   callers that hand out writable pointers into the account (e.g. direct
+   mapping of account data into the VM).  Returns the number of bytes
+   copied (0 if already staged). */
+
+ulong
+fd_txn_account_stage( fd_txn_account_t * acct );
+
+/* fd_txn_account_reserve makes sure the data of acct can grow to
+   dlen_max bytes (capped at FD_RUNTIME_ACC_SZ_MAX) without moving,
+   staging acct if it is copy-on-write.  This may move the data of an
+   already staged account once, so it must be called before handing
+   out data pointers that have to stay valid while the account grows. */
+
+void
+fd_txn_account_reserve( fd_txn_account_t * acct,
+                        ulong              dlen_max );
+
+/* fd_txn_account_is_cow returns 1 if acct is copy-on-write and has not
+   been staged yet (i.e. its data is still the database record's) and 0
+   otherwise. */
+
+int
+fd_txn_account_is_cow( fd_txn_account_t const * acct );
+
+/* fd_txn_account_take_stage_val hands the value acct was staged into
+   over to the caller.  Returns a pointer to the value (the account
+   meta followed by the data) and stores its allocated size in
+   *val_max, or returns NULL if acct has no such value.  acct keeps
+   pointing at the value, which the caller now owns. */
+
+void *
+fd_txn_account_take_stage_val( fd_txn_account_t * acct,
+                               ulong *            val_max );
+
+/* fd_txn_account_release_stage_val frees the value acct was staged
+   into, if acct still owns one.  This discards the staged changes:
+   acct must not be used afterwards. */
+
+void
+fd_txn_account_release_stage_val( fd_txn_account_t * acct );
+
+/* fd_txn_account_is_dirty returns 1 if acct has been mutated (or
+   staged) since it was created and 0 otherwise. */
+
+int
+fd_txn_account_is_dirty( fd_txn_account_t const * acct );
+
 /* Simple accesssors and mutators. */
 
 fd_pubkey_t const *
@@ -148,8 +256,11 @@ fd_txn_account_get_meta( fd_txn_account_t const * acct );
 uchar const *
 fd_txn_account_get_data( fd_txn_account_t const * acct );
 
+/* fd_txn_account_get_data_mut stages acct (see above) and returns a
+   writable pointer to its data. */
+
 uchar *
-fd_txn_account_get_data_mut( fd_txn_account_t const * acct );
+fd_txn_account_get_data_mut( fd_txn_account_t * acct );
 
 ulong
 fd_txn_account_get_data_len( fd_txn_account_t const * acct );
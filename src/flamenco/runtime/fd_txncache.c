@@ -435,6 +435,28 @@ fd_txncache_insert( fd_txncache_t *       tc,
   fd_rwlock_unread( tc->shmem->lock );
 }
 
+/* query_chain walks the hash chain starting at head in blockcache and
+   returns 1 if txnhash was inserted on fork (or one of its ancestors),
+   and 0 otherwise.  Assumes the caller holds a read lock. */
+
+static inline int
+query_chain( fd_txncache_t const * tc,
+             blockcache_t const *  fork,
+             fd_txncache_fork_id_t fork_id,
+             blockcache_t const *  blockcache,
+             uint                  head,
+             uchar const *         txnhash ) {
+  ulong txnhash_offset = blockcache->shmem->txnhash_offset;
+  for( ; head!=UINT_MAX; head=tc->txnpages[ head/FD_TXNCACHE_TXNS_PER_PAGE ].txns[ head%FD_TXNCACHE_TXNS_PER_PAGE ]->blockcache_next ) {
+    fd_txncache_single_txn_t * txn = tc->txnpages[ head/FD_TXNCACHE_TXNS_PER_PAGE ].txns[ head%FD_TXNCACHE_TXNS_PER_PAGE ];
+
+    blockcache_t const * txn_fork = &tc->blockcache_pool[ txn->fork_id.val ];
+    int descends = (txn->fork_id.val==fork_id.val || descends_set_test( fork->descends, txn->fork_id.val )) && txn_fork->shmem->frozen>=0 && txn_fork->shmem->generation==txn->generation;
+    if( FD_LIKELY( descends && !memcmp( txnhash+txnhash_offset, txn->txnhash, 20UL ) ) ) return 1;
+  }
+  return 0;
+}
+
 int
 fd_txncache_query( fd_txncache_t *       tc,
                    fd_txncache_fork_id_t fork_id,
@@ -448,21 +470,63 @@ fd_txncache_query( fd_txncache_t *       tc,
   FD_TEST( blockcache );
   FD_TEST( blockcache->shmem->frozen==2 );
 
-  int found = 0;
+  ulong head_hash = FD_LOAD( ulong, txnhash+blockcache->shmem->txnhash_offset ) % tc->shmem->txn_per_slot_max;
+  int   found     = query_chain( tc, fork, fork_id, blockcache, blockcache->heads[ head_hash ], txnhash );
 
-  ulong txnhash_offset = blockcache->shmem->txnhash_offset;
-  ulong head_hash = FD_LOAD( ulong, txnhash+txnhash_offset ) % tc->shmem->txn_per_slot_max;
-  for( uint head=blockcache->heads[ head_hash ]; head!=UINT_MAX; head=tc->txnpages[ head/FD_TXNCACHE_TXNS_PER_PAGE ].txns[ head%FD_TXNCACHE_TXNS_PER_PAGE ]->blockcache_next ) {
-    fd_txncache_single_txn_t * txn = tc->txnpages[ head/FD_TXNCACHE_TXNS_PER_PAGE ].txns[ head%FD_TXNCACHE_TXNS_PER_PAGE ];
+  fd_rwlock_unread( tc->shmem->lock );
+  return found;
+}
 
-    blockcache_t const * txn_fork = &tc->blockcache_pool[ txn->fork_id.val ];
-    int descends = (txn->fork_id.val==fork_id.val || descends_set_test( fork->descends, txn->fork_id.val )) && txn_fork->shmem->frozen>=0 && txn_fork->shmem->generation==txn->generation;
-    if( FD_LIKELY( descends && !memcmp( txnhash+txnhash_offset, txn->txnhash, 20UL ) ) ) {
-      found = 1;
-      break;
+void
+fd_txncache_query_batch( fd_txncache_t *       tc,
+                         fd_txncache_fork_id_t fork_id,
+                         ulong                 cnt,
+                         uchar const * const * blockhashes,
+                         uchar const * const * txnhashes,
+                         int *                 found ) {
+  fd_rwlock_read( tc->shmem->lock );
+
+  blockcache_t const * fork = &tc->blockcache_pool[ fork_id.val ];
+  FD_TEST( fork->shmem->frozen>=0 );
+
+  ulong txn_per_slot_max = tc->shmem->txn_per_slot_max;
+
+  blockcache_t const * blockcache[ FD_TXNCACHE_QUERY_BATCH_MAX ];
+  uint const *         head      [ FD_TXNCACHE_QUERY_BATCH_MAX ];
+
+  for( ulong off=0UL; off<cnt; off+=FD_TXNCACHE_QUERY_BATCH_MAX ) {
+    ulong stripe_cnt = fd_ulong_min( cnt-off, FD_TXNCACHE_QUERY_BATCH_MAX );
+
+    /* Resolve every blockhash first and prefetch the hash table slot
+       each query will start from, so the cache misses on the (large,
+       randomly accessed) heads arrays overlap rather than serialize. */
+
+    for( ulong i=0UL; i<stripe_cnt; i++ ) {
+      blockcache_t const * bc = blockhash_on_fork( tc, fork, blockhashes[ off+i ] );
+      if( FD_UNLIKELY( bc && bc->shmem->frozen!=2 ) ) bc = NULL;
+      blockcache[ i ] = bc;
+      head      [ i ] = NULL;
+      if( FD_UNLIKELY( !bc ) ) continue;
+      head[ i ] = bc->heads + FD_LOAD( ulong, txnhashes[ off+i ]+bc->shmem->txnhash_offset ) % txn_per_slot_max;
+      __builtin_prefetch( head[ i ] );
+    }
+
+    /* Then prefetch the first entry of every chain ... */
+
+    uint first[ FD_TXNCACHE_QUERY_BATCH_MAX ];
+    for( ulong i=0UL; i<stripe_cnt; i++ ) {
+      first[ i ] = head[ i ] ? *head[ i ] : UINT_MAX;
+      if( FD_LIKELY( first[ i ]==UINT_MAX ) ) continue;
+      __builtin_prefetch( tc->txnpages[ first[ i ]/FD_TXNCACHE_TXNS_PER_PAGE ].txns[ first[ i ]%FD_TXNCACHE_TXNS_PER_PAGE ] );
+    }
+
+    /* ... and finally walk the chains, which are short (one entry
+       in the common case) since heads has txn_per_slot_max slots. */
+
+    for( ulong i=0UL; i<stripe_cnt; i++ ) {
+      found[ off+i ] = first[ i ]!=UINT_MAX && query_chain( tc, fork, fork_id, blockcache[ i ], first[ i ], txnhashes[ off+i ] );
     }
   }
 
   fd_rwlock_unread( tc->shmem->lock );
-  return found;
 }
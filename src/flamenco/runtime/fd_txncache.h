@@ -240,6 +240,33 @@ fd_txncache_query( fd_txncache_t *       tc,
                    uchar const *         blockhash,
                    uchar const *         txnhash );
 
+/* fd_txncache_query_batch is a batched fd_txncache_query for callers
+   outside of transaction execution, for example to filter out already
+   processed transactions before they are scheduled.  For i in
+   [0,cnt), found[i] is set to 1 if txnhashes[i] (referencing
+   blockhashes[i]) exists on the provided fork and 0 otherwise.
+
+   Unlike fd_txncache_query, the blockhash need not be known to the
+   fork: a blockhash that is not an ancestor of the fork (too old, too
+   new, or bogus) simply results in 0.  The fork itself must still be
+   valid for the duration of the call.
+
+   The lookups are processed in stripes of FD_TXNCACHE_QUERY_BATCH_MAX
+   with the memory accesses of each stripe prefetched ahead of the
+   comparisons, and a single read lock is taken for the whole batch, so
+   this is substantially cheaper per transaction than calling
+   fd_txncache_query in a loop. */
+
+#define FD_TXNCACHE_QUERY_BATCH_MAX (16UL)
+
+void
+fd_txncache_query_batch( fd_txncache_t *       tc,
+                         fd_txncache_fork_id_t fork_id,
+                         ulong                 cnt,
+                         uchar const * const * blockhashes,
+                         uchar const * const * txnhashes,
+                         int *                 found );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_flamenco_runtime_fd_txncache_h */
@@ -697,6 +697,8 @@ extend_lookup_table( fd_exec_instr_ctx_t *       ctx,
     return err;
   }
   fd_txn_account_resize( lut_acct.acct, new_table_data_sz );
+  /* Growing the account can move its data */
+  lut_data_mut = fd_txn_account_get_data_mut( lut_acct.acct );
 
   /* https://github.com/solana-labs/solana/blob/v1.17.4/programs/address-lookup-table/src/processor.rs#L307-L310 */
   err = fd_addrlut_serialize_meta( &lut->state, lut_data_mut, lut_data_mut_len );
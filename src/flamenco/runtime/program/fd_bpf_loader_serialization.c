@@ -130,6 +130,7 @@ new_input_mem_region( fd_vm_input_region_t * input_mem_regions,
   ulong vaddr_offset = *input_mem_regions_cnt==0UL ? 0UL : input_mem_regions[ *input_mem_regions_cnt-1U ].vaddr_offset +
                                                            input_mem_regions[ *input_mem_regions_cnt-1U ].address_space_reserved;
   input_mem_regions[ *input_mem_regions_cnt ].is_writable            = is_writable;
+  input_mem_regions[ *input_mem_regions_cnt ].is_cow                 = 0U;
   input_mem_regions[ *input_mem_regions_cnt ].haddr                  = (ulong)buffer;
   input_mem_regions[ *input_mem_regions_cnt ].region_sz              = (uint)region_sz;
   input_mem_regions[ *input_mem_regions_cnt ].address_space_reserved = address_space_reserved;
@@ -220,8 +221,19 @@ write_account( fd_borrowed_account_t *   account,
         uchar * data_start = *serialized_params - address_space_reserved;
         new_input_mem_region( input_mem_regions, input_mem_regions_cnt, data_start, dlen, address_space_reserved, is_writable, instr_acc_idx );
       } else {
-        /* Direct mapping: create region pointing directly to account data */
-        new_input_mem_region( input_mem_regions, input_mem_regions_cnt, data, dlen, address_space_reserved, is_writable, instr_acc_idx );
+        /* Direct mapping: create region pointing directly to account data.
+           If the account has not been staged yet, the region maps the
+           database record read-only and the account is staged on the
+           first write (see fd_vm_find_input_mem_region).  Otherwise room
+           for the region's reserved address space is made now, so the
+           data does not move while the VM runs. */
+        uchar is_cow = (uchar)( is_writable && fd_txn_account_is_cow( account->acct ) );
+        if( is_writable && !is_cow ) {
+          fd_txn_account_reserve( account->acct, address_space_reserved );
+          data = fd_txn_account_get_data( account->acct );
+        }
+        new_input_mem_region( input_mem_regions, input_mem_regions_cnt, data, dlen, address_space_reserved, (uchar)( is_writable && !is_cow ), instr_acc_idx );
+        input_mem_regions[ *input_mem_regions_cnt-1U ].is_cow = is_cow;
       }
     }
 
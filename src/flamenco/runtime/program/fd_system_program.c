@@ -740,23 +740,21 @@ fd_get_system_account_kind( fd_txn_account_t * account ) {
   }
 
   /* https://github.com/anza-xyz/solana-sdk/blob/nonce-account%40v2.2.1/nonce-account/src/lib.rs#L60-L64 */
-  fd_nonce_state_versions_t versions[1];
-  if( FD_UNLIKELY( !fd_bincode_decode_static(
-      nonce_state_versions, versions,
-      fd_txn_account_get_data( account ),
-      fd_txn_account_get_data_len( account ),
-      NULL ) ) ) {
+  fd_nonce_state_versions_view_t versions;
+  if( FD_UNLIKELY( fd_nonce_state_versions_view_init( &versions,
+                                                      fd_txn_account_get_data( account ),
+                                                      fd_txn_account_get_data_len( account ) ) ) ) {
     return FD_SYSTEM_PROGRAM_NONCE_ACCOUNT_KIND_UNKNOWN;
   }
 
-  fd_nonce_state_t * state = NULL;
-  if( fd_nonce_state_versions_is_current( versions ) ) {
-    state = &versions->inner.current;
+  fd_nonce_state_view_t state;
+  if( fd_nonce_state_versions_view_is_current( versions ) ) {
+    state = fd_nonce_state_versions_view_current( versions );
   } else {
-    state = &versions->inner.legacy;
+    state = fd_nonce_state_versions_view_legacy( versions );
   }
 
-  if( FD_LIKELY( fd_nonce_state_is_initialized( state ) ) ) {
+  if( FD_LIKELY( fd_nonce_state_view_is_initialized( state ) ) ) {
     return FD_SYSTEM_PROGRAM_NONCE_ACCOUNT_KIND_NONCE;
   }
 
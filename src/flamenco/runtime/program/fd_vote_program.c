@@ -1811,6 +1811,241 @@ initialize_account( fd_borrowed_account_t *       vote_account,
   return set_vote_account_state( vote_account, &versioned->inner.current, ctx, ctx->txn_ctx->exec_stack->vote_program.init_account.vote_lockout_mem );
 }
 
+/**********************************************************************/
+/* In-place vote state access (FD-only)                               */
+/**********************************************************************/
+
+/* The vote instructions that make up most of every block (TowerSync
+   and the deprecated Vote and VoteStateUpdate) only modify the votes,
+   root slot, epoch credits and last timestamp of a vote state (and the
+   epoch of the authorized voter when it gets cached for a new epoch).
+   For the common case of a current version vote account with a single
+   authorized voter that does not need a resize, these fields are read
+   from and written back to the account data directly, instead of
+   decoding the whole versioned vote state (which builds an authorized
+   voters treap and copies the prior voters buffer) and re-encoding it.
+   The authorized voters and prior voters are moved verbatim.
+
+   The bincode layout of VoteStateVersions::Current is:
+
+     u32           discriminant (fd_vote_state_versioned_enum_current)
+     32            node_pubkey
+     32            authorized_withdrawer
+     u8            commission
+     u64 + 13*cnt  votes (latency u8, slot u64, confirmation_count u32)
+     u8 (+ u64)    root_slot
+     u64 + 40*cnt  authorized_voters (epoch u64, pubkey)
+     1545          prior_voters (32*(pubkey,epoch_start,epoch_end), idx u64, is_empty u8)
+     u64 + 24*cnt  epoch_credits (epoch, credits, prev_credits)
+     16            last_timestamp (slot u64, timestamp i64)
+
+   Any vote account that does not match these conditions goes through
+   the generic path below, which produces the same account data. */
+
+#define VOTE_STATE_VIEW_VOTES_OFF    (69UL)
+#define VOTE_STATE_VIEW_LANDED_SZ    (13UL)
+#define VOTE_STATE_VIEW_VOTER_SZ     (40UL)
+#define VOTE_STATE_VIEW_PRIOR_SZ     (32UL*48UL+9UL)
+#define VOTE_STATE_VIEW_CREDITS_SZ   (24UL)
+#define VOTE_STATE_VIEW_TIMESTAMP_SZ (16UL)
+
+struct fd_vote_state_view {
+  ulong voters_off;  /* offset of the authorized voters */
+  ulong credits_off; /* offset of the epoch credits */
+  ulong epoch;       /* epoch the authorized voter is cached for */
+};
+
+typedef struct fd_vote_state_view fd_vote_state_view_t;
+
+/* vote_state_view_init checks whether the vote account data (of size
+   dlen) can be updated in place for an instruction executing in the
+   given epoch.  Returns view on success and NULL if the generic path
+   should be used.  Does not modify the account. */
+
+static fd_vote_state_view_t *
+vote_state_view_init( fd_vote_state_view_t * view,
+                      uchar const *          data,
+                      ulong                  dlen,
+                      ulong                  epoch ) {
+  /* Smaller accounts might need a resize or a 1_14_11 downgrade (see
+     set_vote_account_state).  This also bounds all offsets below. */
+  if( FD_UNLIKELY( dlen<size_of_versioned( 1 ) ) ) return NULL;
+  if( FD_UNLIKELY( FD_LOAD( uint, data )!=fd_vote_state_versioned_enum_current ) ) return NULL;
+
+  ulong votes_cnt = FD_LOAD( ulong, data+VOTE_STATE_VIEW_VOTES_OFF );
+  if( FD_UNLIKELY( votes_cnt>MAX_LOCKOUT_HISTORY ) ) return NULL;
+  ulong off = VOTE_STATE_VIEW_VOTES_OFF + 8UL + votes_cnt*VOTE_STATE_VIEW_LANDED_SZ;
+
+  uchar has_root = data[ off ];
+  if( FD_UNLIKELY( has_root>1 ) ) return NULL;
+  off += 1UL + 8UL*has_root;
+
+  /* A single authorized voter with epoch<=current epoch is returned by
+     get_and_update_authorized_voter and at most has its epoch bumped
+     to the current epoch (the purge then removes the old entry). */
+  ulong voters_off = off;
+  if( FD_UNLIKELY( FD_LOAD( ulong, data+off )!=1UL ) ) return NULL;
+  if( FD_UNLIKELY( FD_LOAD( ulong, data+off+8UL )>epoch ) ) return NULL;
+  off += 8UL + VOTE_STATE_VIEW_VOTER_SZ;
+
+  if( FD_UNLIKELY( data[ off+VOTE_STATE_VIEW_PRIOR_SZ-1UL ]>1 ) ) return NULL;
+  off += VOTE_STATE_VIEW_PRIOR_SZ;
+
+  ulong credits_off = off;
+  ulong credits_cnt = FD_LOAD( ulong, data+off );
+  if( FD_UNLIKELY( credits_cnt>MAX_EPOCH_CREDITS_HISTORY ) ) return NULL;
+  off += 8UL + credits_cnt*VOTE_STATE_VIEW_CREDITS_SZ + VOTE_STATE_VIEW_TIMESTAMP_SZ;
+  if( FD_UNLIKELY( off>dlen ) ) return NULL;
+
+  view->voters_off  = voters_off;
+  view->credits_off = credits_off;
+  view->epoch       = epoch;
+  return view;
+}
+
+/* vote_state_view_load is the in-place equivalent of decoding the
+   vote state.  Only the fields touched by vote processing are loaded
+   into vote_state (the authorized voters and prior voters are left
+   empty).  The votes and epoch credits deques are allocated from
+   landed_votes_mem and epoch_credits_mem. */
+
+static void
+vote_state_view_load( fd_vote_state_view_t const * view,
+                      uchar const *                data,
+                      fd_vote_state_t *            vote_state /* out */,
+                      uchar *                      landed_votes_mem,
+                      uchar *                      epoch_credits_mem ) {
+  memset( vote_state, 0, sizeof(fd_vote_state_t) );
+  memcpy( &vote_state->node_pubkey,           data+4UL,  sizeof(fd_pubkey_t) );
+  memcpy( &vote_state->authorized_withdrawer, data+36UL, sizeof(fd_pubkey_t) );
+  vote_state->commission = data[ 68 ];
+
+  /* Same deque capacities as the bincode decoder */
+  void * mem = landed_votes_mem;
+  vote_state->votes = deq_fd_landed_vote_t_join_new( &mem, 32UL );
+  ulong         votes_cnt = FD_LOAD( ulong, data+VOTE_STATE_VIEW_VOTES_OFF );
+  uchar const * p         = data + VOTE_STATE_VIEW_VOTES_OFF + 8UL;
+  for( ulong i=0UL; i<votes_cnt; i++ ) {
+    fd_landed_vote_t * vote = deq_fd_landed_vote_t_push_tail_nocopy( vote_state->votes );
+    vote->latency                    = p[ 0 ];
+    vote->lockout.slot               = FD_LOAD( ulong, p+1UL );
+    vote->lockout.confirmation_count = FD_LOAD( uint,  p+9UL );
+    p += VOTE_STATE_VIEW_LANDED_SZ;
+  }
+
+  vote_state->has_root_slot = p[ 0 ];
+  if( vote_state->has_root_slot ) vote_state->root_slot = FD_LOAD( ulong, p+1UL );
+
+  mem = epoch_credits_mem;
+  vote_state->epoch_credits = deq_fd_vote_epoch_credits_t_join_new( &mem, MAX_EPOCH_CREDITS_HISTORY );
+  ulong credits_cnt = FD_LOAD( ulong, data+view->credits_off );
+  p = data + view->credits_off + 8UL;
+  for( ulong i=0UL; i<credits_cnt; i++ ) {
+    fd_vote_epoch_credits_t * credits = deq_fd_vote_epoch_credits_t_push_tail_nocopy( vote_state->epoch_credits );
+    credits->epoch        = FD_LOAD( ulong, p      );
+    credits->credits      = FD_LOAD( ulong, p+8UL  );
+    credits->prev_credits = FD_LOAD( ulong, p+16UL );
+    p += VOTE_STATE_VIEW_CREDITS_SZ;
+  }
+
+  vote_state->last_timestamp.slot      = FD_LOAD( ulong, p     );
+  vote_state->last_timestamp.timestamp = FD_LOAD( long,  p+8UL );
+}
+
+/* vote_state_view_store is the in-place equivalent of encoding the vote
+   state into the account data (of size dlen).  It writes back the
+   fields loaded by vote_state_view_load, moving the authorized voters
+   and prior voters if the size of the votes or root slot changed. */
+
+static int
+vote_state_view_store( fd_vote_state_view_t const * view,
+                       uchar *                      data,
+                       ulong                        dlen,
+                       fd_vote_state_t const *      vote_state ) {
+  ulong votes_cnt   = deq_fd_landed_vote_t_cnt( vote_state->votes );
+  ulong credits_cnt = deq_fd_vote_epoch_credits_t_cnt( vote_state->epoch_credits );
+  ulong voters_off  = VOTE_STATE_VIEW_VOTES_OFF + 8UL + votes_cnt*VOTE_STATE_VIEW_LANDED_SZ + 1UL + 8UL*(!!vote_state->has_root_slot);
+  ulong tail_sz     = view->credits_off - view->voters_off;
+  ulong credits_off = voters_off + tail_sz;
+
+  // https://github.com/anza-xyz/agave/blob/v2.0.1/sdk/src/transaction_context.rs#L978
+  if( FD_UNLIKELY( credits_off + 8UL + credits_cnt*VOTE_STATE_VIEW_CREDITS_SZ + VOTE_STATE_VIEW_TIMESTAMP_SZ > dlen ) )
+    return FD_EXECUTOR_INSTR_ERR_ACC_DATA_TOO_SMALL;
+
+  /* Move the authorized voters and prior voters first, as the new votes
+     may overlap their old location. */
+  if( voters_off!=view->voters_off ) memmove( data+voters_off, data+view->voters_off, tail_sz );
+  FD_STORE( ulong, data+voters_off+8UL, view->epoch );
+
+  FD_STORE( ulong, data+VOTE_STATE_VIEW_VOTES_OFF, votes_cnt );
+  uchar * p = data + VOTE_STATE_VIEW_VOTES_OFF + 8UL;
+  for( deq_fd_landed_vote_t_iter_t iter = deq_fd_landed_vote_t_iter_init( vote_state->votes );
+       !deq_fd_landed_vote_t_iter_done( vote_state->votes, iter );
+       iter = deq_fd_landed_vote_t_iter_next( vote_state->votes, iter ) ) {
+    fd_landed_vote_t const * vote = deq_fd_landed_vote_t_iter_ele_const( vote_state->votes, iter );
+    p[ 0 ] = vote->latency;
+    FD_STORE( ulong, p+1UL, vote->lockout.slot               );
+    FD_STORE( uint,  p+9UL, vote->lockout.confirmation_count );
+    p += VOTE_STATE_VIEW_LANDED_SZ;
+  }
+
+  p[ 0 ] = (uchar)!!vote_state->has_root_slot;
+  if( vote_state->has_root_slot ) FD_STORE( ulong, p+1UL, vote_state->root_slot );
+
+  FD_STORE( ulong, data+credits_off, credits_cnt );
+  p = data + credits_off + 8UL;
+  for( deq_fd_vote_epoch_credits_t_iter_t iter = deq_fd_vote_epoch_credits_t_iter_init( vote_state->epoch_credits );
+       !deq_fd_vote_epoch_credits_t_iter_done( vote_state->epoch_credits, iter );
+       iter = deq_fd_vote_epoch_credits_t_iter_next( vote_state->epoch_credits, iter ) ) {
+    fd_vote_epoch_credits_t const * credits = deq_fd_vote_epoch_credits_t_iter_ele_const( vote_state->epoch_credits, iter );
+    FD_STORE( ulong, p,      credits->epoch        );
+    FD_STORE( ulong, p+8UL,  credits->credits      );
+    FD_STORE( ulong, p+16UL,  credits->prev_credits );
+    p += VOTE_STATE_VIEW_CREDITS_SZ;
+  }
+
+  FD_STORE( ulong, p,     vote_state->last_timestamp.slot      );
+  FD_STORE( long,  p+8UL, vote_state->last_timestamp.timestamp );
+
+  return FD_EXECUTOR_INSTR_SUCCESS;
+}
+
+/* verify_and_get_vote_state_view is the in-place equivalent of
+   verify_and_get_vote_state (see vote_state_view_load).  Callers use
+   the vote_state_mem scratch for the epoch credits, as it is not
+   needed by this path. */
+
+static int
+verify_and_get_vote_state_view( fd_vote_state_view_t const *  view,
+                                fd_borrowed_account_t const * vote_account,
+                                fd_pubkey_t const *           signers[FD_TXN_SIG_MAX],
+                                fd_vote_state_t *             vote_state /* out */,
+                                uchar *                       landed_votes_mem,
+                                uchar *                       epoch_credits_mem ) {
+  uchar const * data = fd_borrowed_account_get_data( vote_account );
+  vote_state_view_load( view, data, vote_state, landed_votes_mem, epoch_credits_mem );
+
+  // https://github.com/anza-xyz/agave/blob/v2.0.1/programs/vote/src/vote_state/mod.rs#L1099
+  fd_pubkey_t authorized_voter;
+  memcpy( &authorized_voter, data+view->voters_off+16UL, sizeof(fd_pubkey_t) );
+  return verify_authorized_signer( &authorized_voter, signers );
+}
+
+/* set_vote_account_state_view is the in-place equivalent of
+   set_vote_account_state. */
+
+__attribute__((warn_unused_result)) static int
+set_vote_account_state_view( fd_vote_state_view_t const * view,
+                             fd_borrowed_account_t *      vote_account,
+                             fd_vote_state_t const *      vote_state ) {
+  // https://github.com/anza-xyz/agave/blob/v2.1.14/sdk/src/transaction_context.rs#L974
+  uchar * data = NULL;
+  ulong   dlen = 0UL;
+  int err = fd_borrowed_account_get_data_mut( vote_account, &data, &dlen );
+  if( FD_UNLIKELY( err ) ) return err;
+  return vote_state_view_store( view, data, dlen, vote_state );
+}
+
 // https://github.com/anza-xyz/agave/blob/v2.0.1/programs/vote/src/vote_state/mod.rs#L1086
 static int
 verify_and_get_vote_state( fd_borrowed_account_t *       vote_account,
@@ -1858,14 +2093,28 @@ process_vote_with_account( fd_borrowed_account_t *       vote_account,
 
   int             rc;
   fd_vote_state_t vote_state;
+
+  fd_vote_state_view_t  _view[1];
+  fd_vote_state_view_t * view = vote_state_view_init( _view,
+                                                      fd_borrowed_account_get_data( vote_account ),
+                                                      fd_borrowed_account_get_data_len( vote_account ),
+                                                      clock->epoch );
+
   // https://github.com/anza-xyz/agave/blob/v2.0.1/programs/vote/src/vote_state/mod.rs#L1112
-  rc = verify_and_get_vote_state( vote_account,
-                                  clock,
-                                  signers,
-                                  &vote_state,
-                                  ctx->txn_ctx->exec_stack->vote_program.process_vote.vote_state_mem,
-                                  ctx->txn_ctx->exec_stack->vote_program.process_vote.authorized_voters_mem,
-                                  ctx->txn_ctx->exec_stack->vote_program.process_vote.landed_votes_mem );
+  rc = FD_LIKELY( view ) ?
+    verify_and_get_vote_state_view( view,
+                                    vote_account,
+                                    signers,
+                                    &vote_state,
+                                    ctx->txn_ctx->exec_stack->vote_program.process_vote.landed_votes_mem,
+                                    ctx->txn_ctx->exec_stack->vote_program.process_vote.vote_state_mem ) :
+    verify_and_get_vote_state( vote_account,
+                               clock,
+                               signers,
+                               &vote_state,
+                               ctx->txn_ctx->exec_stack->vote_program.process_vote.vote_state_mem,
+                               ctx->txn_ctx->exec_stack->vote_program.process_vote.authorized_voters_mem,
+                               ctx->txn_ctx->exec_stack->vote_program.process_vote.landed_votes_mem );
   if( FD_UNLIKELY( rc ) ) return rc;
 
 
@@ -1898,6 +2147,7 @@ process_vote_with_account( fd_borrowed_account_t *       vote_account,
   }
 
   // https://github.com/anza-xyz/agave/blob/v2.0.1/programs/vote/src/vote_state/mod.rs#L1133
+  if( FD_LIKELY( view ) ) return set_vote_account_state_view( view, vote_account, &vote_state );
   return set_vote_account_state( vote_account, &vote_state, ctx, ctx->txn_ctx->exec_stack->vote_program.process_vote.vote_lockout_mem );
 }
 
@@ -1993,14 +2243,28 @@ process_vote_state_update( fd_borrowed_account_t *       vote_account,
   }
 
   fd_vote_state_t vote_state;
+
+  fd_vote_state_view_t  _view[1];
+  fd_vote_state_view_t * view = vote_state_view_init( _view,
+                                                      fd_borrowed_account_get_data( vote_account ),
+                                                      fd_borrowed_account_get_data_len( vote_account ),
+                                                      clock->epoch );
+
   // https://github.com/anza-xyz/agave/blob/v2.0.1/programs/vote/src/vote_state/mod.rs#L1144
-  rc = verify_and_get_vote_state( vote_account,
-                                  clock,
-                                  signers,
-                                  &vote_state,
-                                  ctx->txn_ctx->exec_stack->vote_program.process_vote.vote_state_mem,
-                                  ctx->txn_ctx->exec_stack->vote_program.process_vote.authorized_voters_mem,
-                                  ctx->txn_ctx->exec_stack->vote_program.process_vote.landed_votes_mem );
+  rc = FD_LIKELY( view ) ?
+    verify_and_get_vote_state_view( view,
+                                    vote_account,
+                                    signers,
+                                    &vote_state,
+                                    ctx->txn_ctx->exec_stack->vote_program.process_vote.landed_votes_mem,
+                                    ctx->txn_ctx->exec_stack->vote_program.process_vote.vote_state_mem ) :
+    verify_and_get_vote_state( vote_account,
+                               clock,
+                               signers,
+                               &vote_state,
+                               ctx->txn_ctx->exec_stack->vote_program.process_vote.vote_state_mem,
+                               ctx->txn_ctx->exec_stack->vote_program.process_vote.authorized_voters_mem,
+                               ctx->txn_ctx->exec_stack->vote_program.process_vote.landed_votes_mem );
   if( FD_UNLIKELY( rc ) ) return rc;
 
 
@@ -2012,6 +2276,7 @@ process_vote_state_update( fd_borrowed_account_t *       vote_account,
   }
 
   // https://github.com/anza-xyz/agave/blob/v2.0.1/programs/vote/src/vote_state/mod.rs#L1153
+  if( FD_LIKELY( view ) ) return set_vote_account_state_view( view, vote_account, &vote_state );
   rc = set_vote_account_state( vote_account, &vote_state, ctx, ctx->txn_ctx->exec_stack->vote_program.process_vote.vote_lockout_mem );
 
   return rc;
@@ -2082,16 +2347,29 @@ process_tower_sync( fd_borrowed_account_t *       vote_account,
     }
   }
 
+  fd_vote_state_view_t  _view[1];
+  fd_vote_state_view_t * view = vote_state_view_init( _view,
+                                                      fd_borrowed_account_get_data( vote_account ),
+                                                      fd_borrowed_account_get_data_len( vote_account ),
+                                                      clock->epoch );
+
   // https://github.com/anza-xyz/agave/blob/v2.0.1/programs/vote/src/vote_state/mod.rs#L1194
   fd_vote_state_t vote_state;
   do {
-    int err = verify_and_get_vote_state( vote_account,
-                                         clock,
-                                         signers,
-                                         &vote_state,
-                                         ctx->txn_ctx->exec_stack->vote_program.tower_sync.vote_state_mem,
-                                         ctx->txn_ctx->exec_stack->vote_program.tower_sync.authorized_voters_mem,
-                                         ctx->txn_ctx->exec_stack->vote_program.tower_sync.vote_state_landed_votes_mem );
+    int err = FD_LIKELY( view ) ?
+      verify_and_get_vote_state_view( view,
+                                      vote_account,
+                                      signers,
+                                      &vote_state,
+                                      ctx->txn_ctx->exec_stack->vote_program.tower_sync.vote_state_landed_votes_mem,
+                                      ctx->txn_ctx->exec_stack->vote_program.tower_sync.vote_state_mem ) :
+      verify_and_get_vote_state( vote_account,
+                                 clock,
+                                 signers,
+                                 &vote_state,
+                                 ctx->txn_ctx->exec_stack->vote_program.tower_sync.vote_state_mem,
+                                 ctx->txn_ctx->exec_stack->vote_program.tower_sync.authorized_voters_mem,
+                                 ctx->txn_ctx->exec_stack->vote_program.tower_sync.vote_state_landed_votes_mem );
     if( FD_UNLIKELY( err ) ) return err;
   } while(0);
 
@@ -2102,6 +2380,7 @@ process_tower_sync( fd_borrowed_account_t *       vote_account,
   } while(0);
 
   // https://github.com/anza-xyz/agave/blob/v2.0.1/programs/vote/src/vote_state/mod.rs#L1203
+  if( FD_LIKELY( view ) ) return set_vote_account_state_view( view, vote_account, &vote_state );
   return set_vote_account_state( vote_account, &vote_state, ctx, ctx->txn_ctx->exec_stack->vote_program.process_vote.vote_lockout_mem );
 }
 
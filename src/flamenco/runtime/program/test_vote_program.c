@@ -0,0 +1,214 @@
+#include "fd_vote_program.c"
+
+/* Scratch for one decoded vote state */
+
+struct test_vote_mem {
+  uchar versioned     [ FD_VOTE_STATE_VERSIONED_FOOTPRINT ] __attribute__((aligned(FD_VOTE_STATE_VERSIONED_ALIGN)));
+  uchar authorized    [ FD_AUTHORIZED_VOTERS_FOOTPRINT    ] __attribute__((aligned(FD_AUTHORIZED_VOTERS_ALIGN)));
+  uchar landed_votes  [ FD_LANDED_VOTES_FOOTPRINT         ] __attribute__((aligned(FD_LANDED_VOTES_ALIGN)));
+  uchar epoch_credits [ FD_VOTE_STATE_VERSIONED_FOOTPRINT ] __attribute__((aligned(128UL)));
+};
+
+typedef struct test_vote_mem test_vote_mem_t;
+
+static test_vote_mem_t gen_mem[1];
+static test_vote_mem_t generic_mem[1];
+static test_vote_mem_t view_mem[1];
+
+#define TEST_DATA_SZ (4096UL)
+
+static void
+rand_pubkey( fd_rng_t *    rng,
+             fd_pubkey_t * pubkey ) {
+  for( ulong i=0UL; i<4UL; i++ ) pubkey->ul[ i ] = fd_rng_ulong( rng );
+}
+
+/* vote_slots runs cnt votes for increasing slots starting after slot
+   through the lockout and credit logic shared by both paths.  Returns
+   the last slot voted on. */
+
+static ulong
+vote_slots( fd_vote_state_t * vote_state,
+            fd_rng_t *        rng,
+            ulong             slot,
+            ulong             cnt ) {
+  for( ulong i=0UL; i<cnt; i++ ) {
+    slot += 1UL + fd_rng_ulong_roll( rng, 4UL );
+    process_next_vote_slot( vote_state, slot, slot/64UL, slot );
+  }
+  return slot;
+}
+
+/* gen_vote_state encodes a random current version vote state with a
+   single authorized voter into data, on top of random garbage.
+   Returns the last slot voted on. */
+
+static ulong
+gen_vote_state( fd_rng_t * rng,
+                uchar *    data,
+                ulong      voter_epoch ) {
+  for( ulong i=0UL; i<TEST_DATA_SZ; i++ ) data[ i ] = fd_rng_uchar( rng );
+
+  fd_vote_state_versioned_t versioned = { .discriminant = fd_vote_state_versioned_enum_current };
+  fd_vote_state_t * vote_state = &versioned.inner.current;
+  rand_pubkey( rng, &vote_state->node_pubkey           );
+  rand_pubkey( rng, &vote_state->authorized_withdrawer );
+  vote_state->commission = fd_rng_uchar( rng );
+
+  void * mem = gen_mem->landed_votes;
+  vote_state->votes = deq_fd_landed_vote_t_join_new( &mem, 32UL );
+  mem = gen_mem->epoch_credits;
+  vote_state->epoch_credits = deq_fd_vote_epoch_credits_t_join_new( &mem, MAX_EPOCH_CREDITS_HISTORY );
+
+  fd_pubkey_t voter; rand_pubkey( rng, &voter );
+  vote_state->authorized_voters = *authorized_voters_new( voter_epoch, &voter, gen_mem->authorized );
+
+  for( ulong i=0UL; i<32UL; i++ ) {
+    rand_pubkey( rng, &vote_state->prior_voters.buf[ i ].pubkey );
+    vote_state->prior_voters.buf[ i ].epoch_start = fd_rng_ulong( rng );
+    vote_state->prior_voters.buf[ i ].epoch_end   = fd_rng_ulong( rng );
+  }
+  vote_state->prior_voters.idx      = fd_rng_ulong_roll( rng, 32UL );
+  vote_state->prior_voters.is_empty = fd_rng_uchar_roll( rng, 2U );
+
+  /* Between no votes and a full tower with a root and several epochs
+     of credits */
+  ulong slot = vote_slots( vote_state, rng, fd_rng_ulong_roll( rng, 1UL<<20 ), fd_rng_ulong_roll( rng, 128UL ) );
+
+  vote_state->last_timestamp.slot      = slot;
+  vote_state->last_timestamp.timestamp = (long)fd_rng_uint( rng );
+
+  fd_bincode_encode_ctx_t encode = { .data = data, .dataend = data+TEST_DATA_SZ };
+  FD_TEST( !fd_vote_state_versioned_encode( &versioned, &encode ) );
+  return slot;
+}
+
+/* mutate applies the same random vote processing to either path's vote
+   state (rng is seeded identically for both). */
+
+static void
+mutate( fd_vote_state_t * vote_state,
+        fd_rng_t *        rng,
+        ulong             slot ) {
+  slot = vote_slots( vote_state, rng, slot, fd_rng_ulong_roll( rng, 48UL ) );
+  if( fd_rng_uint_roll( rng, 2U ) ) {
+    vote_state->last_timestamp.slot       = slot;
+    vote_state->last_timestamp.timestamp += (long)fd_rng_uint_roll( rng, 1000U );
+  }
+}
+
+/* test_roundtrip runs vote processing on a random vote state through
+   the in-place view path and through the generic decode/encode path,
+   and checks that both produce the same account data. */
+
+static void
+test_roundtrip( fd_rng_t * rng,
+                ulong      iter_cnt ) {
+  static uchar data   [ TEST_DATA_SZ ];
+  static uchar generic[ TEST_DATA_SZ ];
+  static uchar view   [ TEST_DATA_SZ ];
+
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    ulong voter_epoch = fd_rng_ulong_roll( rng, 16UL );
+    ulong epoch       = voter_epoch + fd_rng_ulong_roll( rng, 3UL );
+    ulong slot        = gen_vote_state( rng, data, voter_epoch );
+    uint  seed        = fd_rng_uint( rng );
+    fd_memcpy( generic, data, TEST_DATA_SZ );
+    fd_memcpy( view,    data, TEST_DATA_SZ );
+
+    /* Generic path (verify_and_get_vote_state, set_vote_account_state) */
+
+    fd_bincode_decode_ctx_t decode = { .data = generic, .dataend = generic+TEST_DATA_SZ };
+    ulong total_sz = 0UL;
+    FD_TEST( !fd_vote_state_versioned_decode_footprint( &decode, &total_sz ) );
+    FD_TEST( total_sz<=FD_VOTE_STATE_VERSIONED_FOOTPRINT );
+    fd_vote_state_versioned_t * versioned = fd_vote_state_versioned_decode( generic_mem->versioned, &decode );
+    convert_to_current( versioned, generic_mem->authorized, generic_mem->landed_votes );
+    fd_vote_state_t generic_state = versioned->inner.current;
+    fd_pubkey_t * generic_voter = NULL;
+    FD_TEST( !get_and_update_authorized_voter( &generic_state, epoch, &generic_voter ) );
+
+    fd_rng_t _mutate_rng[1];
+    mutate( &generic_state, fd_rng_join( fd_rng_new( _mutate_rng, seed, 0UL ) ), slot );
+    fd_rng_delete( fd_rng_leave( _mutate_rng ) );
+
+    fd_vote_state_versioned_t new_current = { .discriminant = fd_vote_state_versioned_enum_current,
+                                              .inner        = { .current = generic_state } };
+    FD_TEST( fd_vote_state_versioned_size( &new_current )<=TEST_DATA_SZ );
+    fd_bincode_encode_ctx_t encode = { .data = generic, .dataend = generic+TEST_DATA_SZ };
+    FD_TEST( !fd_vote_state_versioned_encode( &new_current, &encode ) );
+
+    /* View path (verify_and_get_vote_state_view, set_vote_account_state_view) */
+
+    fd_vote_state_view_t _view[1];
+    fd_vote_state_view_t * v = vote_state_view_init( _view, view, TEST_DATA_SZ, epoch );
+    FD_TEST( v );
+    FD_TEST( !memcmp( view+v->voters_off+16UL, generic_voter, sizeof(fd_pubkey_t) ) );
+    fd_vote_state_t view_state;
+    vote_state_view_load( v, view, &view_state, view_mem->landed_votes, view_mem->epoch_credits );
+
+    mutate( &view_state, fd_rng_join( fd_rng_new( _mutate_rng, seed, 0UL ) ), slot );
+    fd_rng_delete( fd_rng_leave( _mutate_rng ) );
+
+    FD_TEST( !vote_state_view_store( v, view, TEST_DATA_SZ, &view_state ) );
+
+    if( FD_UNLIKELY( memcmp( view, generic, TEST_DATA_SZ ) ) ) {
+      ulong off = 0UL; while( view[ off ]==generic[ off ] ) off++;
+      FD_LOG_ERR(( "iter %lu: view and generic path differ at offset %lu", iter, off ));
+    }
+  }
+}
+
+/* test_fallback checks that accounts the view path can't handle in
+   place are left to the generic path. */
+
+static void
+test_fallback( fd_rng_t * rng ) {
+  static uchar data[ TEST_DATA_SZ ];
+  fd_vote_state_view_t view[1];
+
+  gen_vote_state( rng, data, 5UL );
+  FD_TEST(  vote_state_view_init( view, data, TEST_DATA_SZ,           5UL ) );
+  FD_TEST(  vote_state_view_init( view, data, size_of_versioned( 1 ), 5UL ) );
+
+  /* Undersized account (might need a resize) */
+  FD_TEST( !vote_state_view_init( view, data, size_of_versioned( 1 )-1UL, 5UL ) );
+
+  /* Authorized voter for a future epoch */
+  FD_TEST( !vote_state_view_init( view, data, TEST_DATA_SZ, 4UL ) );
+
+  /* Older vote state version */
+  FD_STORE( uint, data, fd_vote_state_versioned_enum_v1_14_11 );
+  FD_TEST( !vote_state_view_init( view, data, TEST_DATA_SZ, 5UL ) );
+  FD_STORE( uint, data, fd_vote_state_versioned_enum_current );
+
+  /* Malformed vote count */
+  ulong votes_cnt = FD_LOAD( ulong, data+VOTE_STATE_VIEW_VOTES_OFF );
+  FD_STORE( ulong, data+VOTE_STATE_VIEW_VOTES_OFF, MAX_LOCKOUT_HISTORY+1UL );
+  FD_TEST( !vote_state_view_init( view, data, TEST_DATA_SZ, 5UL ) );
+  FD_STORE( ulong, data+VOTE_STATE_VIEW_VOTES_OFF, votes_cnt );
+
+  /* Multiple authorized voters */
+  FD_TEST( vote_state_view_init( view, data, TEST_DATA_SZ, 5UL ) );
+  FD_STORE( ulong, data+view->voters_off, 2UL );
+  FD_TEST( !vote_state_view_init( view, data, TEST_DATA_SZ, 5UL ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong iter_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt", NULL, 10000UL );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  test_roundtrip( rng, iter_cnt );
+  test_fallback( rng );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,253 @@
+/* Unit test for fd_runtime_commit_account */
+
+#include "fd_runtime.h"
+#include "fd_bank.h"
+#include "fd_hashes.h"
+#include "fd_acc_mgr.h"
+#include "fd_txn_account.h"
+#include "context/fd_exec_txn_ctx.h"
+#include "../accdb/fd_accdb_user.h"
+#include "../../funk/fd_funk.h"
+
+#define TEST_FUNK_REC_CNT (1024UL)
+#define TEST_SLOT         (100000UL)
+
+static fd_funk_t       funk_join[1];
+static fd_accdb_user_t accdb_join[1];
+
+/* create_account writes an account with data_sz bytes of data to the
+   database at xid */
+
+static void
+create_account( fd_accdb_user_t *         accdb,
+                fd_funk_txn_xid_t const * xid,
+                fd_pubkey_t const *       pubkey,
+                ulong                     lamports,
+                ulong                     data_sz ) {
+  fd_txn_account_t      acc[1];
+  fd_funk_rec_prepare_t prepare = {0};
+  FD_TEST( fd_txn_account_init_from_funk_mutable( acc, pubkey, accdb, xid, 1, data_sz, &prepare ) );
+  uchar data[ 256 ];
+  FD_TEST( data_sz<=sizeof(data) );
+  for( ulong i=0UL; i<data_sz; i++ ) data[i] = (uchar)(i*7UL);
+  fd_txn_account_set_data    ( acc, data, data_sz );
+  fd_txn_account_set_lamports( acc, lamports      );
+  fd_txn_account_mutable_fini( acc, accdb, &prepare );
+}
+
+/* setup_account sets up a writable transaction account the same way
+   fd_executor_setup_txn_account does for an existing account */
+
+static fd_txn_account_t *
+setup_account( fd_exec_txn_ctx_t *       txn_ctx,
+               ushort                    idx,
+               fd_funk_t *               funk,
+               fd_funk_txn_xid_t const * xid,
+               fd_pubkey_t const *       pubkey,
+               uchar *                   stage ) {
+  int err = FD_ACC_MGR_SUCCESS;
+  fd_account_meta_t const * meta = fd_funk_get_acc_meta_readonly( funk, xid, pubkey, NULL, &err, NULL );
+  FD_TEST( meta && err==FD_ACC_MGR_SUCCESS );
+  fd_txn_account_t * acc = fd_txn_account_join( fd_txn_account_new(
+      &txn_ctx->accounts[ idx ], pubkey, (fd_account_meta_t *)meta, 1 ) );
+  FD_TEST( acc );
+  fd_txn_account_set_stage_mem  ( acc, stage );
+  fd_txn_account_set_stage_alloc( acc, fd_funk_alloc( funk ) );
+  return acc;
+}
+
+static fd_funk_rec_t const *
+query_rec( fd_funk_t *               funk,
+           fd_funk_txn_xid_t const * xid,
+           fd_pubkey_t const *       pubkey ) {
+  fd_funk_rec_key_t   key = fd_funk_acc_key( pubkey );
+  fd_funk_rec_query_t query[1];
+  return fd_funk_rec_query_try( funk, xid, &key, query );
+}
+
+/* lthash_check verifies that the bank lthash is the sum of the hashes
+   of the given accounts at xid */
+
+static void
+lthash_check( fd_bank_t *               bank,
+              fd_funk_t *               funk,
+              fd_funk_txn_xid_t const * xid,
+              fd_pubkey_t const *       pubkeys,
+              ulong                     pubkey_cnt ) {
+  fd_lthash_value_t expected[1];
+  fd_lthash_zero( expected );
+  for( ulong i=0UL; i<pubkey_cnt; i++ ) {
+    int err = FD_ACC_MGR_SUCCESS;
+    fd_account_meta_t const * meta = fd_funk_get_acc_meta_readonly( funk, xid, &pubkeys[i], NULL, &err, NULL );
+    FD_TEST( meta && err==FD_ACC_MGR_SUCCESS );
+    fd_lthash_value_t hash[1];
+    fd_hashes_account_lthash( &pubkeys[i], meta, fd_account_meta_get_data_const( meta ), hash );
+    fd_lthash_add( expected, hash );
+  }
+  fd_lthash_value_t const * lthash = fd_bank_lthash_locking_query( bank );
+  FD_TEST( !memcmp( lthash->bytes, expected->bytes, sizeof(fd_lthash_value_t) ) );
+  fd_bank_lthash_end_locking_query( bank );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "gigantic"      );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 1UL             );
+  ulong        near_cpu = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu", NULL, fd_log_cpu_id() );
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  FD_TEST( wksp );
+
+  void * funk_mem = fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint( 16UL, TEST_FUNK_REC_CNT ), 1UL );
+  FD_TEST( funk_mem );
+  fd_funk_t * funk = fd_funk_join( funk_join, fd_funk_new( funk_mem, 1UL, 1234UL, 16UL, TEST_FUNK_REC_CNT ) );
+  FD_TEST( funk );
+  fd_accdb_user_t * accdb = fd_accdb_user_join( fd_accdb_user_new( accdb_join ), funk_mem );
+  FD_TEST( accdb );
+
+  void * banks_mem = fd_wksp_alloc_laddr( wksp, fd_banks_align(), fd_banks_footprint( 16UL, 2UL ), 1UL );
+  FD_TEST( banks_mem );
+  fd_banks_t * banks = fd_banks_join( fd_banks_new( banks_mem, 16UL, 2UL, 0, 8888UL ) );
+  FD_TEST( banks );
+  fd_bank_t * bank = fd_banks_init_bank( banks );
+  FD_TEST( bank );
+  fd_bank_slot_set( bank, TEST_SLOT );
+
+  void * txn_ctx_mem = fd_wksp_alloc_laddr( wksp, FD_EXEC_TXN_CTX_ALIGN, FD_EXEC_TXN_CTX_FOOTPRINT, 1UL );
+  fd_exec_txn_ctx_t * txn_ctx = fd_exec_txn_ctx_join( fd_exec_txn_ctx_new( txn_ctx_mem ) );
+  FD_TEST( txn_ctx );
+  txn_ctx->slot = TEST_SLOT;
+
+  uchar * stage[2];
+  for( ulong i=0UL; i<2UL; i++ ) {
+    stage[i] = fd_wksp_alloc_laddr( wksp, FD_ACCOUNT_REC_ALIGN, FD_ACC_TOT_SZ_MAX, 1UL );
+    FD_TEST( stage[i] );
+  }
+
+  /* Accounts exist in a parent database transaction, the transaction
+     under test commits into a child */
+
+  fd_funk_txn_xid_t root_xid; fd_funk_txn_xid_set_root( &root_xid );
+  fd_funk_txn_xid_t parent_xid = { .ul = { TEST_SLOT-1UL, 0UL } };
+  fd_funk_txn_xid_t xid        = { .ul = { TEST_SLOT,     0UL } };
+  fd_funk_txn_prepare( funk, &root_xid, &parent_xid );
+
+  fd_pubkey_t const pubkeys[2] = { { .ul = { 1UL } }, { .ul = { 2UL } } };
+  create_account( accdb, &parent_xid, &pubkeys[0], 1000UL, 100UL );
+  create_account( accdb, &parent_xid, &pubkeys[1], 2000UL, 200UL );
+
+  fd_funk_txn_prepare( funk, &parent_xid, &xid );
+
+  /* Seed the bank lthash with the parent state */
+
+  fd_lthash_zero( fd_bank_lthash_locking_modify( bank ) );
+  fd_bank_lthash_end_locking_modify( bank );
+  for( ulong i=0UL; i<2UL; i++ ) {
+    int err = FD_ACC_MGR_SUCCESS;
+    fd_account_meta_t const * meta = fd_funk_get_acc_meta_readonly( funk, &parent_xid, &pubkeys[i], NULL, &err, NULL );
+    FD_TEST( meta );
+    fd_lthash_value_t hash[1];
+    fd_hashes_account_lthash( &pubkeys[i], meta, fd_account_meta_get_data_const( meta ), hash );
+    fd_lthash_add( fd_bank_lthash_locking_modify( bank ), hash );
+    fd_bank_lthash_end_locking_modify( bank );
+  }
+
+  /* A writable account that is only written back with its current
+     contents (as deserialization does for every writable instruction
+     account) stays clean and is skipped at commit */
+
+  fd_txn_account_t * clean = setup_account( txn_ctx, 0, funk, &xid, &pubkeys[0], stage[0] );
+  uchar data[ 100 ];
+  fd_memcpy( data, fd_txn_account_get_data( clean ), 100UL );
+  fd_txn_account_set_data( clean, data, 100UL );
+  FD_TEST( !fd_txn_account_is_dirty( clean ) );
+
+  /* A modified account is staged into a database value */
+
+  fd_txn_account_t * dirty = setup_account( txn_ctx, 1, funk, &xid, &pubkeys[1], stage[1] );
+  fd_txn_account_set_lamports( dirty, 2500UL );
+  FD_TEST( fd_txn_account_is_dirty( dirty ) );
+  FD_TEST( dirty->stage_val );
+  void * val = dirty->stage_val;
+
+  fd_runtime_commit_account( funk, &xid, txn_ctx, clean, bank, NULL );
+  FD_TEST( txn_ctx->accounts_clean_cnt==1UL );
+  FD_TEST( txn_ctx->accounts_commit_sz==0UL );
+  FD_TEST( !query_rec( funk, &xid, &pubkeys[0] ) );
+
+  fd_runtime_commit_account( funk, &xid, txn_ctx, dirty, bank, NULL );
+  FD_TEST( txn_ctx->accounts_clean_cnt==1UL );
+  FD_TEST( txn_ctx->accounts_commit_sz==0UL ); /* published without a copy */
+  FD_TEST( !dirty->stage_val );
+
+  fd_funk_rec_t const * rec = query_rec( funk, &xid, &pubkeys[1] );
+  FD_TEST( rec );
+  FD_TEST( fd_funk_val( rec, fd_funk_wksp( funk ) )==val );
+  fd_account_meta_t const * meta = fd_funk_val( rec, fd_funk_wksp( funk ) );
+  FD_TEST( meta->lamports==2500UL );
+  FD_TEST( meta->slot    ==TEST_SLOT );
+  FD_TEST( meta->dlen    ==200UL );
+  lthash_check( bank, funk, &xid, pubkeys, 2UL );
+
+  /* Modifying the account again in the same database transaction
+     replaces the record's value */
+
+  dirty = setup_account( txn_ctx, 1, funk, &xid, &pubkeys[1], stage[1] );
+  fd_txn_account_set_lamports( dirty, 3000UL );
+  val = dirty->stage_val;
+  FD_TEST( val );
+  fd_runtime_commit_account( funk, &xid, txn_ctx, dirty, bank, NULL );
+  FD_TEST( txn_ctx->accounts_commit_sz==0UL );
+  FD_TEST( query_rec( funk, &xid, &pubkeys[1] )==rec );
+  FD_TEST( fd_funk_val( rec, fd_funk_wksp( funk ) )==val );
+  FD_TEST( ((fd_account_meta_t const *)val)->lamports==3000UL );
+  lthash_check( bank, funk, &xid, pubkeys, 2UL );
+
+  /* Room reserved when staging keeps the data in place as the account
+     grows */
+
+  dirty = setup_account( txn_ctx, 1, funk, &xid, &pubkeys[1], stage[1] );
+  fd_txn_account_reserve( dirty, 5000UL );
+  FD_TEST( fd_txn_account_is_dirty( dirty ) );
+  FD_TEST( dirty->stage_val );
+  uchar const * reserved = fd_txn_account_get_data( dirty );
+  fd_txn_account_set_data_len( dirty, 5000UL );
+  FD_TEST( dirty->stage_val );
+  FD_TEST( fd_txn_account_get_data( dirty )==reserved );
+  fd_txn_account_release_stage_val( dirty );
+
+  /* An account that outgrows its value falls back to the staging
+     buffer and is copied at commit */
+
+  dirty = setup_account( txn_ctx, 0, funk, &xid, &pubkeys[0], stage[0] );
+  fd_txn_account_set_lamports( dirty, 1000UL );
+  FD_TEST( dirty->stage_val );
+  fd_txn_account_set_data_len( dirty, 10000UL );
+  FD_TEST( !dirty->stage_val );
+  FD_TEST( fd_txn_account_get_meta( dirty )==(fd_account_meta_t *)stage[0] );
+  FD_TEST( !memcmp( fd_txn_account_get_data( dirty ), data, 100UL ) );
+  fd_runtime_commit_account( funk, &xid, txn_ctx, dirty, bank, NULL );
+  FD_TEST( txn_ctx->accounts_commit_sz==sizeof(fd_account_meta_t)+10000UL );
+  rec = query_rec( funk, &xid, &pubkeys[0] );
+  FD_TEST( rec );
+  meta = fd_funk_val( rec, fd_funk_wksp( funk ) );
+  FD_TEST( meta->dlen==10000UL );
+  FD_TEST( !memcmp( fd_account_meta_get_data_const( meta ), data, 100UL ) );
+  lthash_check( bank, funk, &xid, pubkeys, 2UL );
+
+  /* A staged value that is never committed is released */
+
+  dirty = setup_account( txn_ctx, 1, funk, &xid, &pubkeys[1], stage[1] );
+  fd_txn_account_set_lamports( dirty, 1UL );
+  FD_TEST( dirty->stage_val );
+  fd_txn_account_release_stage_val( dirty );
+  FD_TEST( !dirty->stage_val );
+  FD_TEST( ((fd_account_meta_t const *)fd_funk_val( query_rec( funk, &xid, &pubkeys[1] ), fd_funk_wksp( funk ) ))->lamports==3000UL );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -75,6 +75,48 @@ main( int argc, char ** argv ) {
   FD_TEST( fd_txn_account_get_data_len( txn_account ) == 102UL );
   FD_TEST( fd_txn_account_delete( fd_txn_account_leave( txn_account ) ) );
 
+  /* Copy-on-write: the account references the record until the first
+     mutation, which copies it into the staging buffer. */
+
+  uchar * stage = fd_wksp_alloc_laddr( wksp, 8UL, 1000UL, 1UL );
+  FD_TEST( stage );
+  for( ulong i=0UL; i<102UL; i++ ) acc_data[i] = (uchar)i;
+  txn_account = fd_txn_account_join( fd_txn_account_new( tx_acc_mem, &pubkey, meta, 1 ) );
+  FD_TEST( txn_account );
+  fd_txn_account_set_stage_mem( txn_account, stage );
+
+  FD_TEST( !fd_txn_account_is_dirty( txn_account ) );
+  FD_TEST( fd_txn_account_get_meta( txn_account ) == meta     );
+  FD_TEST( fd_txn_account_get_data( txn_account ) == acc_data );
+  FD_TEST( fd_txn_account_get_lamports( txn_account ) == 1000UL );
+  FD_TEST( !fd_txn_account_is_dirty( txn_account ) );
+
+  fd_txn_account_set_lamports( txn_account, 2000UL );
+  FD_TEST( fd_txn_account_is_dirty( txn_account ) );
+  FD_TEST( txn_account->stage_sz == sizeof(fd_account_meta_t)+102UL );
+  FD_TEST( fd_txn_account_get_meta( txn_account ) == (fd_account_meta_t *)stage );
+  FD_TEST( fd_txn_account_get_lamports( txn_account ) == 2000UL );
+  FD_TEST( meta->lamports == 1000UL );
+  FD_TEST( !memcmp( fd_txn_account_get_data( txn_account ), acc_data, 102UL ) );
+
+  /* Already staged: writes go to the staging buffer only */
+
+  FD_TEST( !fd_txn_account_stage( txn_account ) );
+  uchar * data_mut = fd_txn_account_get_data_mut( txn_account );
+  FD_TEST( data_mut == stage + sizeof(fd_account_meta_t) );
+  data_mut[0] = 0xff;
+  FD_TEST( acc_data[0] == 0 );
+  FD_TEST( fd_txn_account_delete( fd_txn_account_leave( txn_account ) ) );
+
+  /* get_data_mut also stages */
+
+  txn_account = fd_txn_account_join( fd_txn_account_new( tx_acc_mem, &pubkey, meta, 1 ) );
+  fd_txn_account_set_stage_mem( txn_account, stage );
+  FD_TEST( fd_txn_account_get_data_mut( txn_account ) == stage + sizeof(fd_account_meta_t) );
+  FD_TEST( fd_txn_account_is_dirty( txn_account ) );
+  FD_TEST( stage[ sizeof(fd_account_meta_t) ]==0 );
+  FD_TEST( fd_txn_account_delete( fd_txn_account_leave( txn_account ) ) );
+
   FD_LOG_NOTICE(( "pass" ));
 
   fd_halt();
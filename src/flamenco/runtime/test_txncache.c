@@ -108,6 +108,69 @@ test_advance_root( uchar * scratch0,
   fd_txncache_advance_root( tc, slot );
 }
 
+void
+test_query_batch( uchar * scratch0,
+                  uchar * scratch1 ) {
+  FD_LOG_NOTICE(( "TEST QUERY BATCH" ));
+
+  fd_txncache_shmem_t * shtc = fd_txncache_shmem_join( fd_txncache_shmem_new( scratch0, 4UL, 64UL ) );
+  FD_TEST( shtc );
+  fd_txncache_t * tc = fd_txncache_join( fd_txncache_new( scratch1, shtc ) );
+  FD_TEST( tc );
+
+  /* root -> slot1 -> slot2, with a competing fork off slot1 */
+
+  fd_txncache_fork_id_t root = fd_txncache_attach_child( tc, NULL_FORK );
+  fd_txncache_finalize_fork( tc, root, 0UL, BLOCKHASH(1UL) );
+
+  fd_txncache_fork_id_t slot1 = fd_txncache_attach_child( tc, root );
+  for( ulong i=0UL; i<40UL; i+=2UL ) fd_txncache_insert( tc, slot1, BLOCKHASH(1UL), TXNHASH(i) );
+  fd_txncache_finalize_fork( tc, slot1, 0UL, BLOCKHASH(2UL) );
+
+  fd_txncache_fork_id_t slot2 = fd_txncache_attach_child( tc, slot1 );
+  fd_txncache_insert( tc, slot2, BLOCKHASH(2UL), TXNHASH(41UL) );
+  fd_txncache_finalize_fork( tc, slot2, 0UL, BLOCKHASH(3UL) );
+
+  fd_txncache_fork_id_t minority = fd_txncache_attach_child( tc, slot1 );
+  fd_txncache_insert( tc, minority, BLOCKHASH(1UL), TXNHASH(1UL) );
+  fd_txncache_insert( tc, minority, BLOCKHASH(2UL), TXNHASH(43UL) );
+  fd_txncache_finalize_fork( tc, minority, 0UL, BLOCKHASH(4UL) );
+
+  /* More queries than fit in one stripe, mixing hits, misses, txns
+     only on the competing fork and blockhashes the fork does not know
+     about (its own, a sibling's, and a bogus one), which must report
+     not found rather than abort. */
+
+  ulong const          cnt = 48UL;
+  uchar const *        blockhashes[ 48 ];
+  uchar const *        txnhashes  [ 48 ];
+  int                  found      [ 48 ];
+  for( ulong i=0UL; i<cnt; i++ ) {
+    ulong bh = i<40UL ? 1UL : 2UL;
+    if( i==44UL ) bh = 3UL;
+    if( i==45UL ) bh = 4UL;
+    if( i==46UL ) bh = 99UL;
+    blockhashes[ i ] = BLOCKHASH(bh);
+    txnhashes  [ i ] = TXNHASH(i);
+    found      [ i ] = -1;
+  }
+  fd_txncache_query_batch( tc, slot2, cnt, blockhashes, txnhashes, found );
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    int expected = (i<40UL && !(i&1UL)) || i==41UL;
+    FD_TEST( found[ i ]==expected );
+    if( i<44UL ) FD_TEST( found[ i ]==fd_txncache_query( tc, slot2, blockhashes[ i ], txnhashes[ i ] ) );
+  }
+
+  fd_txncache_query_batch( tc, minority, cnt, blockhashes, txnhashes, found );
+  for( ulong i=0UL; i<cnt; i++ ) {
+    int expected = (i<40UL && !(i&1UL)) || i==1UL || i==43UL;
+    FD_TEST( found[ i ]==expected );
+  }
+
+  fd_txncache_query_batch( tc, slot2, 0UL, blockhashes, txnhashes, found );
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -125,6 +188,7 @@ main( int     argc,
   test0( scratch0, scratch1 );
   test_new_join( scratch0 );
   test_advance_root( scratch0, scratch1 );
+  test_query_batch( scratch0, scratch1 );
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
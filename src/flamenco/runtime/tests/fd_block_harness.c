@@ -493,6 +493,7 @@ fd_solfuzz_block_ctx_exec( fd_solfuzz_runner_t *     runner,
       txn_ctx->exec_err           = res;
 
       if( FD_UNLIKELY( !(txn_ctx->flags & FD_TXN_P_FLAGS_EXECUTE_SUCCESS) ) ) {
+        fd_exec_txn_ctx_teardown( txn_ctx );
         break;
       }
 
@@ -447,6 +447,7 @@ fd_solfuzz_pb_txn_run( fd_solfuzz_runner_t * runner,
       }
 
       ulong actual_end = FD_SCRATCH_ALLOC_FINI( l, 1UL );
+      fd_exec_txn_ctx_teardown( txn_ctx );
       fd_solfuzz_txn_ctx_destroy( runner );
 
       *output = txn_result;
@@ -552,6 +553,7 @@ fd_solfuzz_pb_txn_run( fd_solfuzz_runner_t * runner,
     }
 
     ulong actual_end = FD_SCRATCH_ALLOC_FINI( l, 1UL );
+    fd_exec_txn_ctx_teardown( txn_ctx );
     fd_solfuzz_txn_ctx_destroy( runner );
 
     *output = txn_result;
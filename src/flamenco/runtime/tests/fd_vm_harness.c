@@ -79,7 +79,7 @@ fd_solfuzz_vm_load_from_input_regions( fd_vm_input_region_t const *        input
   for( ulong i=0; i<input_count; i++ ) {
     fd_vm_input_region_t const * vm_region = &input[i];
     fd_exec_test_input_data_region_t * out_region = &(*output)[i];
-    out_region->is_writable = vm_region->is_writable;
+    out_region->is_writable = vm_region->is_writable | vm_region->is_cow;
     out_region->offset = vm_region->vaddr_offset;
 
     if( vm_region->region_sz > 0 ) {
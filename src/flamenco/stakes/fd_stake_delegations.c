@@ -371,27 +371,28 @@ fd_stake_delegations_refresh( fd_stake_delegations_t *  stake_delegations,
       continue;
     }
 
-    fd_stake_state_v2_t stake_state;
-    err = fd_stake_get_state( acct_rec, &stake_state );
-    if( FD_UNLIKELY( err ) ) {
+    fd_stake_state_v2_view_t stake_state;
+    err = fd_stake_state_v2_view_init( &stake_state,
+                                       fd_txn_account_get_data( acct_rec ),
+                                       fd_txn_account_get_data_len( acct_rec ) );
+    if( FD_UNLIKELY( err || !fd_stake_state_v2_view_is_stake( stake_state ) ) ) {
       fd_stake_delegation_map_idx_remove( stake_delegation_map, &stake_delegation->stake_account, ULONG_MAX, stake_delegation_pool );
       fd_stake_delegation_pool_idx_release( stake_delegation_pool, i );
+      continue;
     }
 
-    if( FD_UNLIKELY( !fd_stake_state_v2_is_stake( &stake_state ) ) ) {
-      fd_stake_delegation_map_idx_remove( stake_delegation_map, &stake_delegation->stake_account, ULONG_MAX, stake_delegation_pool );
-      fd_stake_delegation_pool_idx_release( stake_delegation_pool, i );
-    }
+    fd_stake_view_t      stake      = fd_stake_state_v2_stake_view_stake( fd_stake_state_v2_view_stake( stake_state ) );
+    fd_delegation_view_t delegation = fd_stake_view_delegation( stake );
 
     fd_stake_delegations_update(
         stake_delegations,
         &stake_delegation->stake_account,
-        &stake_state.inner.stake.stake.delegation.voter_pubkey,
-        stake_state.inner.stake.stake.delegation.stake,
-        stake_state.inner.stake.stake.delegation.activation_epoch,
-        stake_state.inner.stake.stake.delegation.deactivation_epoch,
-        stake_state.inner.stake.stake.credits_observed,
-        stake_state.inner.stake.stake.delegation.warmup_cooldown_rate );
+        fd_delegation_view_voter_pubkey( delegation ),
+        fd_delegation_view_stake( delegation ),
+        fd_delegation_view_activation_epoch( delegation ),
+        fd_delegation_view_deactivation_epoch( delegation ),
+        fd_stake_view_credits_observed( stake ),
+        fd_delegation_view_warmup_cooldown_rate( delegation ) );
   }
 }
 
@@ -187,27 +187,29 @@ fd_stakes_update_stake_delegation( fd_txn_account_t * stake_account,
     return;
   }
 
-  fd_stake_state_v2_t stake_state;
-  int err = fd_stake_get_state( stake_account, &stake_state );
+  /* Read the delegation in place (this runs for every stake account
+     written by a transaction, so avoid a full decode). */
+
+  fd_stake_state_v2_view_t stake_state;
+  int err = fd_stake_state_v2_view_init( &stake_state,
+                                         fd_txn_account_get_data( stake_account ),
+                                         fd_txn_account_get_data_len( stake_account ) );
   if( FD_UNLIKELY( err!=0 ) ) {
     fd_stake_delegations_remove( stake_delegations_delta, stake_account->pubkey );
     fd_bank_stake_delegations_delta_end_locking_modify( bank );
     return;
   }
 
-  if( FD_UNLIKELY( !fd_stake_state_v2_is_stake( &stake_state ) ) ) {
+  if( FD_UNLIKELY( !fd_stake_state_v2_view_is_stake( stake_state ) ) ) {
     fd_stake_delegations_remove( stake_delegations_delta, stake_account->pubkey );
     fd_bank_stake_delegations_delta_end_locking_modify( bank );
     return;
   }
 
-  if( FD_UNLIKELY( fd_stake_state_v2_is_uninitialized( &stake_state ) ) ) {
-    fd_stake_delegations_remove( stake_delegations_delta, stake_account->pubkey );
-    fd_bank_stake_delegations_delta_end_locking_modify( bank );
-    return;
-  }
+  fd_stake_view_t      stake      = fd_stake_state_v2_stake_view_stake( fd_stake_state_v2_view_stake( stake_state ) );
+  fd_delegation_view_t delegation = fd_stake_view_delegation( stake );
 
-  if( FD_UNLIKELY( stake_state.inner.stake.stake.delegation.stake==0UL ) ) {
+  if( FD_UNLIKELY( fd_delegation_view_stake( delegation )==0UL ) ) {
     fd_stake_delegations_remove( stake_delegations_delta, stake_account->pubkey );
     fd_bank_stake_delegations_delta_end_locking_modify( bank );
     return;
@@ -215,12 +217,12 @@ fd_stakes_update_stake_delegation( fd_txn_account_t * stake_account,
 
   fd_stake_delegations_update( stake_delegations_delta,
                                stake_account->pubkey,
-                               &stake_state.inner.stake.stake.delegation.voter_pubkey,
-                               stake_state.inner.stake.stake.delegation.stake,
-                               stake_state.inner.stake.stake.delegation.activation_epoch,
-                               stake_state.inner.stake.stake.delegation.deactivation_epoch,
-                               stake_state.inner.stake.stake.credits_observed,
-                               stake_state.inner.stake.stake.delegation.warmup_cooldown_rate );
+                               fd_delegation_view_voter_pubkey( delegation ),
+                               fd_delegation_view_stake( delegation ),
+                               fd_delegation_view_activation_epoch( delegation ),
+                               fd_delegation_view_deactivation_epoch( delegation ),
+                               fd_stake_view_credits_observed( stake ),
+                               fd_delegation_view_warmup_cooldown_rate( delegation ) );
 
   fd_bank_stake_delegations_delta_end_locking_modify( bank );
 }
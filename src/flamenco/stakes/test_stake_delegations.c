@@ -1,5 +1,29 @@
 #include "fd_stake_delegations.h"
 #include "../runtime/fd_runtime_const.h"
+#include "../runtime/fd_acc_mgr.h"
+
+/* insert_stake_account creates a funk record for a stake account with
+   the given lamports and data. */
+
+static void
+insert_stake_account( fd_funk_t *               funk,
+                      fd_funk_txn_xid_t const * xid,
+                      fd_pubkey_t const *       pubkey,
+                      ulong                     lamports,
+                      uchar const *             data,
+                      ulong                     data_sz ) {
+  fd_funk_rec_key_t     key = fd_funk_acc_key( pubkey );
+  fd_funk_rec_prepare_t prepare[1];
+  fd_funk_rec_t * rec = fd_funk_rec_prepare( funk, xid, &key, prepare, NULL );
+  FD_TEST( rec );
+  fd_account_meta_t * meta = fd_funk_val_truncate( rec, funk->alloc, funk->wksp, 16UL, sizeof(fd_account_meta_t)+data_sz, NULL );
+  FD_TEST( meta );
+  memset( meta, 0, sizeof(fd_account_meta_t) );
+  meta->dlen     = (uint)data_sz;
+  meta->lamports = lamports;
+  fd_memcpy( meta+1, data, data_sz );
+  fd_funk_rec_publish( funk, prepare );
+}
 
 int main( int argc, char ** argv ) {
   fd_boot( &argc, &argv );
@@ -164,7 +188,69 @@ int main( int argc, char ** argv ) {
   FD_TEST( stake_delegation->is_tombstone == 0 );
   FD_TEST( fd_stake_delegations_cnt( stake_delegations ) == 3UL );
 
-  /* Test stake delegations refresh */
+  /* Test stake delegations refresh.  Delegations of accounts that no
+     longer hold a delegated stake state are removed, all others are
+     updated from the stake state. */
+
+  FD_TEST( fd_stake_delegations_delete( fd_stake_delegations_leave( stake_delegations ) ) );
+  stake_delegations = fd_stake_delegations_join( fd_stake_delegations_new( stake_delegations_mem, max_stake_accounts, 0 ) );
+  FD_TEST( stake_delegations );
+
+  void * funk_mem = fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint( 4UL, 16UL ), wksp_tag );
+  FD_TEST( fd_funk_new( funk_mem, wksp_tag, 0UL, 4UL, 16UL ) );
+  fd_funk_t funk[1];
+  FD_TEST( fd_funk_join( funk, funk_mem ) );
+  fd_funk_txn_xid_t const * xid = fd_funk_root( funk );
+
+  uchar stake_data[ 200 ] = {0};
+  fd_stake_state_v2_t stake_state = { .discriminant = fd_stake_state_v2_enum_stake };
+  stake_state.inner.stake.stake.delegation.voter_pubkey         = voter_pubkey_1;
+  stake_state.inner.stake.stake.delegation.stake                = 500UL;
+  stake_state.inner.stake.stake.delegation.activation_epoch     = 1UL;
+  stake_state.inner.stake.stake.delegation.deactivation_epoch   = ULONG_MAX;
+  stake_state.inner.stake.stake.delegation.warmup_cooldown_rate = 0.25;
+  stake_state.inner.stake.stake.credits_observed                = 7UL;
+  fd_bincode_encode_ctx_t encode = { .data = stake_data, .dataend = stake_data+sizeof(stake_data) };
+  FD_TEST( !fd_stake_state_v2_encode( &stake_state, &encode ) );
+  insert_stake_account( funk, xid, &stake_account_0, 1UL, stake_data, sizeof(stake_data) );
+
+  /* Not delegated */
+  memset( stake_data, 0, sizeof(stake_data) );
+  stake_state = (fd_stake_state_v2_t){ .discriminant = fd_stake_state_v2_enum_initialized };
+  encode      = (fd_bincode_encode_ctx_t){ .data = stake_data, .dataend = stake_data+sizeof(stake_data) };
+  FD_TEST( !fd_stake_state_v2_encode( &stake_state, &encode ) );
+  insert_stake_account( funk, xid, &stake_account_1, 1UL, stake_data, sizeof(stake_data) );
+
+  /* Invalid stake state */
+  memset( stake_data, 0, sizeof(stake_data) );
+  FD_STORE( uint, stake_data, 7U );
+  insert_stake_account( funk, xid, &stake_account_2, 1UL, stake_data, sizeof(stake_data) );
+
+  /* stake_account_3 does not exist */
+
+  fd_stake_delegations_update( stake_delegations, &stake_account_0, &voter_pubkey_0, 100UL, 0UL, 0UL, 0UL, 0.0 );
+  fd_stake_delegations_update( stake_delegations, &stake_account_1, &voter_pubkey_0, 100UL, 0UL, 0UL, 0UL, 0.0 );
+  fd_stake_delegations_update( stake_delegations, &stake_account_2, &voter_pubkey_0, 100UL, 0UL, 0UL, 0UL, 0.0 );
+  fd_stake_delegations_update( stake_delegations, &stake_account_3, &voter_pubkey_0, 100UL, 0UL, 0UL, 0UL, 0.0 );
+  FD_TEST( fd_stake_delegations_cnt( stake_delegations ) == 4UL );
+
+  fd_stake_delegations_refresh( stake_delegations, funk, xid );
+
+  FD_TEST( fd_stake_delegations_cnt( stake_delegations ) == 1UL );
+  stake_delegation = fd_stake_delegations_query( stake_delegations, &stake_account_0 );
+  FD_TEST( stake_delegation );
+  FD_TEST( !memcmp( &stake_delegation->vote_account, &voter_pubkey_1, sizeof(fd_pubkey_t) ) );
+  FD_TEST( stake_delegation->stake == 500UL );
+  FD_TEST( stake_delegation->activation_epoch == 1UL );
+  FD_TEST( stake_delegation->deactivation_epoch == ULONG_MAX );
+  FD_TEST( stake_delegation->credits_observed == 7UL );
+  FD_TEST( stake_delegation->warmup_cooldown_rate == 0.25 );
+  FD_TEST( !fd_stake_delegations_query( stake_delegations, &stake_account_1 ) );
+  FD_TEST( !fd_stake_delegations_query( stake_delegations, &stake_account_2 ) );
+  FD_TEST( !fd_stake_delegations_query( stake_delegations, &stake_account_3 ) );
+
+  fd_funk_leave( funk, NULL );
+  fd_wksp_free_laddr( fd_funk_delete( funk_mem ) );
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
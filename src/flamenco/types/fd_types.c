@@ -15417,6 +15417,150 @@ int fd_rent_state_encode( fd_rent_state_t const * self, fd_bincode_encode_ctx_t
   return fd_rent_state_inner_encode( &self->inner, self->discriminant, ctx );
 }
 
+int fd_fee_calculator_view_init( fd_fee_calculator_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_fee_calculator_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_delegation_view_init( fd_delegation_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_delegation_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_stake_view_init( fd_stake_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_stake_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_stake_authorized_view_init( fd_stake_authorized_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_stake_authorized_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_stake_lockup_view_init( fd_stake_lockup_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_stake_lockup_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_stake_meta_view_init( fd_stake_meta_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_stake_meta_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_stake_flags_view_init( fd_stake_flags_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_stake_flags_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_stake_state_v2_initialized_view_init( fd_stake_state_v2_initialized_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_stake_state_v2_initialized_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_stake_state_v2_stake_view_init( fd_stake_state_v2_stake_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_stake_state_v2_stake_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_stake_state_v2_view_init( fd_stake_state_v2_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_stake_state_v2_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_nonce_data_view_init( fd_nonce_data_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_nonce_data_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_nonce_state_view_init( fd_nonce_state_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_nonce_state_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_nonce_state_versions_view_init( fd_nonce_state_versions_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_nonce_state_versions_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_lookup_table_meta_view_init( fd_lookup_table_meta_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_lookup_table_meta_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_address_lookup_table_view_init( fd_address_lookup_table_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_address_lookup_table_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
+int fd_address_lookup_table_state_view_init( fd_address_lookup_table_state_view_t * view, void const * data, ulong data_sz ) {
+  fd_bincode_decode_ctx_t ctx = { .data = data, .dataend = (uchar const *)data + data_sz };
+  ulong total_sz = 0UL;
+  int err = fd_address_lookup_table_state_decode_footprint_inner( &ctx, &total_sz );
+  if( FD_UNLIKELY( err ) ) return err;
+  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;
+  view->data = data;
+  return FD_BINCODE_SUCCESS;
+}
 #define REDBLK_T fd_clock_timestamp_vote_t_mapnode_t
 #define REDBLK_NAME fd_clock_timestamp_vote_t_map
 #define REDBLK_IMPL_STYLE 2
@@ -3901,6 +3901,129 @@ fd_rent_state_enum_uninitialized = 0,
 fd_rent_state_enum_rent_paying = 1,
 fd_rent_state_enum_rent_exempt = 2,
 };
+/* Zero-copy views: fd_X_view_init validates the bincode encoding of
+   an X at data in a single pass (without decoding it) and the
+   fd_X_view_<member> accessors then read members in place.  The
+   encoding must stay valid and unmodified while the view is in use.
+   Members of an option are only valid if fd_X_view_has_<member>, and
+   enum variant accessors only if fd_X_view_is_<variant>. */
+
+struct fd_fee_calculator_view { uchar const * data; };
+typedef struct fd_fee_calculator_view fd_fee_calculator_view_t;
+struct fd_delegation_view { uchar const * data; };
+typedef struct fd_delegation_view fd_delegation_view_t;
+struct fd_stake_view { uchar const * data; };
+typedef struct fd_stake_view fd_stake_view_t;
+struct fd_stake_authorized_view { uchar const * data; };
+typedef struct fd_stake_authorized_view fd_stake_authorized_view_t;
+struct fd_stake_lockup_view { uchar const * data; };
+typedef struct fd_stake_lockup_view fd_stake_lockup_view_t;
+struct fd_stake_meta_view { uchar const * data; };
+typedef struct fd_stake_meta_view fd_stake_meta_view_t;
+struct fd_stake_flags_view { uchar const * data; };
+typedef struct fd_stake_flags_view fd_stake_flags_view_t;
+struct fd_stake_state_v2_initialized_view { uchar const * data; };
+typedef struct fd_stake_state_v2_initialized_view fd_stake_state_v2_initialized_view_t;
+struct fd_stake_state_v2_stake_view { uchar const * data; };
+typedef struct fd_stake_state_v2_stake_view fd_stake_state_v2_stake_view_t;
+struct fd_stake_state_v2_view { uchar const * data; };
+typedef struct fd_stake_state_v2_view fd_stake_state_v2_view_t;
+struct fd_nonce_data_view { uchar const * data; };
+typedef struct fd_nonce_data_view fd_nonce_data_view_t;
+struct fd_nonce_state_view { uchar const * data; };
+typedef struct fd_nonce_state_view fd_nonce_state_view_t;
+struct fd_nonce_state_versions_view { uchar const * data; };
+typedef struct fd_nonce_state_versions_view fd_nonce_state_versions_view_t;
+struct fd_lookup_table_meta_view { uchar const * data; };
+typedef struct fd_lookup_table_meta_view fd_lookup_table_meta_view_t;
+struct fd_address_lookup_table_view { uchar const * data; };
+typedef struct fd_address_lookup_table_view fd_address_lookup_table_view_t;
+struct fd_address_lookup_table_state_view { uchar const * data; };
+typedef struct fd_address_lookup_table_state_view fd_address_lookup_table_state_view_t;
+
+int fd_fee_calculator_view_init( fd_fee_calculator_view_t * view, void const * data, ulong data_sz );
+static inline ulong fd_fee_calculator_view_lamports_per_signature( fd_fee_calculator_view_t view ) { return FD_LOAD( ulong, view.data+0UL ); }
+
+int fd_delegation_view_init( fd_delegation_view_t * view, void const * data, ulong data_sz );
+static inline fd_pubkey_t const * fd_delegation_view_voter_pubkey( fd_delegation_view_t view ) { return fd_type_pun_const( view.data+0UL ); }
+static inline ulong fd_delegation_view_stake( fd_delegation_view_t view ) { return FD_LOAD( ulong, view.data+32UL ); }
+static inline ulong fd_delegation_view_activation_epoch( fd_delegation_view_t view ) { return FD_LOAD( ulong, view.data+40UL ); }
+static inline ulong fd_delegation_view_deactivation_epoch( fd_delegation_view_t view ) { return FD_LOAD( ulong, view.data+48UL ); }
+static inline double fd_delegation_view_warmup_cooldown_rate( fd_delegation_view_t view ) { return FD_LOAD( double, view.data+56UL ); }
+
+int fd_stake_view_init( fd_stake_view_t * view, void const * data, ulong data_sz );
+static inline fd_delegation_view_t fd_stake_view_delegation( fd_stake_view_t view ) { return (fd_delegation_view_t){ .data = view.data+0UL }; }
+static inline ulong fd_stake_view_credits_observed( fd_stake_view_t view ) { return FD_LOAD( ulong, view.data+64UL ); }
+
+int fd_stake_authorized_view_init( fd_stake_authorized_view_t * view, void const * data, ulong data_sz );
+static inline fd_pubkey_t const * fd_stake_authorized_view_staker( fd_stake_authorized_view_t view ) { return fd_type_pun_const( view.data+0UL ); }
+static inline fd_pubkey_t const * fd_stake_authorized_view_withdrawer( fd_stake_authorized_view_t view ) { return fd_type_pun_const( view.data+32UL ); }
+
+int fd_stake_lockup_view_init( fd_stake_lockup_view_t * view, void const * data, ulong data_sz );
+static inline long fd_stake_lockup_view_unix_timestamp( fd_stake_lockup_view_t view ) { return FD_LOAD( long, view.data+0UL ); }
+static inline ulong fd_stake_lockup_view_epoch( fd_stake_lockup_view_t view ) { return FD_LOAD( ulong, view.data+8UL ); }
+static inline fd_pubkey_t const * fd_stake_lockup_view_custodian( fd_stake_lockup_view_t view ) { return fd_type_pun_const( view.data+16UL ); }
+
+int fd_stake_meta_view_init( fd_stake_meta_view_t * view, void const * data, ulong data_sz );
+static inline ulong fd_stake_meta_view_rent_exempt_reserve( fd_stake_meta_view_t view ) { return FD_LOAD( ulong, view.data+0UL ); }
+static inline fd_stake_authorized_view_t fd_stake_meta_view_authorized( fd_stake_meta_view_t view ) { return (fd_stake_authorized_view_t){ .data = view.data+8UL }; }
+static inline fd_stake_lockup_view_t fd_stake_meta_view_lockup( fd_stake_meta_view_t view ) { return (fd_stake_lockup_view_t){ .data = view.data+72UL }; }
+
+int fd_stake_flags_view_init( fd_stake_flags_view_t * view, void const * data, ulong data_sz );
+static inline uchar fd_stake_flags_view_bits( fd_stake_flags_view_t view ) { return FD_LOAD( uchar, view.data+0UL ); }
+
+int fd_stake_state_v2_initialized_view_init( fd_stake_state_v2_initialized_view_t * view, void const * data, ulong data_sz );
+static inline fd_stake_meta_view_t fd_stake_state_v2_initialized_view_meta( fd_stake_state_v2_initialized_view_t view ) { return (fd_stake_meta_view_t){ .data = view.data+0UL }; }
+
+int fd_stake_state_v2_stake_view_init( fd_stake_state_v2_stake_view_t * view, void const * data, ulong data_sz );
+static inline fd_stake_meta_view_t fd_stake_state_v2_stake_view_meta( fd_stake_state_v2_stake_view_t view ) { return (fd_stake_meta_view_t){ .data = view.data+0UL }; }
+static inline fd_stake_view_t fd_stake_state_v2_stake_view_stake( fd_stake_state_v2_stake_view_t view ) { return (fd_stake_view_t){ .data = view.data+120UL }; }
+static inline fd_stake_flags_view_t fd_stake_state_v2_stake_view_stake_flags( fd_stake_state_v2_stake_view_t view ) { return (fd_stake_flags_view_t){ .data = view.data+192UL }; }
+
+int fd_stake_state_v2_view_init( fd_stake_state_v2_view_t * view, void const * data, ulong data_sz );
+static inline uint fd_stake_state_v2_view_discriminant( fd_stake_state_v2_view_t view ) { return FD_LOAD( uint, view.data ); }
+static inline int fd_stake_state_v2_view_is_uninitialized( fd_stake_state_v2_view_t view ) { return fd_stake_state_v2_view_discriminant( view )==0; }
+static inline int fd_stake_state_v2_view_is_initialized( fd_stake_state_v2_view_t view ) { return fd_stake_state_v2_view_discriminant( view )==1; }
+static inline int fd_stake_state_v2_view_is_stake( fd_stake_state_v2_view_t view ) { return fd_stake_state_v2_view_discriminant( view )==2; }
+static inline int fd_stake_state_v2_view_is_rewards_pool( fd_stake_state_v2_view_t view ) { return fd_stake_state_v2_view_discriminant( view )==3; }
+static inline fd_stake_state_v2_initialized_view_t fd_stake_state_v2_view_initialized( fd_stake_state_v2_view_t view ) { return (fd_stake_state_v2_initialized_view_t){ .data = view.data+4UL }; }
+static inline fd_stake_state_v2_stake_view_t fd_stake_state_v2_view_stake( fd_stake_state_v2_view_t view ) { return (fd_stake_state_v2_stake_view_t){ .data = view.data+4UL }; }
+
+int fd_nonce_data_view_init( fd_nonce_data_view_t * view, void const * data, ulong data_sz );
+static inline fd_pubkey_t const * fd_nonce_data_view_authority( fd_nonce_data_view_t view ) { return fd_type_pun_const( view.data+0UL ); }
+static inline fd_hash_t const * fd_nonce_data_view_durable_nonce( fd_nonce_data_view_t view ) { return fd_type_pun_const( view.data+32UL ); }
+static inline fd_fee_calculator_view_t fd_nonce_data_view_fee_calculator( fd_nonce_data_view_t view ) { return (fd_fee_calculator_view_t){ .data = view.data+64UL }; }
+
+int fd_nonce_state_view_init( fd_nonce_state_view_t * view, void const * data, ulong data_sz );
+static inline uint fd_nonce_state_view_discriminant( fd_nonce_state_view_t view ) { return FD_LOAD( uint, view.data ); }
+static inline int fd_nonce_state_view_is_uninitialized( fd_nonce_state_view_t view ) { return fd_nonce_state_view_discriminant( view )==0; }
+static inline int fd_nonce_state_view_is_initialized( fd_nonce_state_view_t view ) { return fd_nonce_state_view_discriminant( view )==1; }
+static inline fd_nonce_data_view_t fd_nonce_state_view_initialized( fd_nonce_state_view_t view ) { return (fd_nonce_data_view_t){ .data = view.data+4UL }; }
+
+int fd_nonce_state_versions_view_init( fd_nonce_state_versions_view_t * view, void const * data, ulong data_sz );
+static inline uint fd_nonce_state_versions_view_discriminant( fd_nonce_state_versions_view_t view ) { return FD_LOAD( uint, view.data ); }
+static inline int fd_nonce_state_versions_view_is_legacy( fd_nonce_state_versions_view_t view ) { return fd_nonce_state_versions_view_discriminant( view )==0; }
+static inline int fd_nonce_state_versions_view_is_current( fd_nonce_state_versions_view_t view ) { return fd_nonce_state_versions_view_discriminant( view )==1; }
+static inline fd_nonce_state_view_t fd_nonce_state_versions_view_legacy( fd_nonce_state_versions_view_t view ) { return (fd_nonce_state_view_t){ .data = view.data+4UL }; }
+static inline fd_nonce_state_view_t fd_nonce_state_versions_view_current( fd_nonce_state_versions_view_t view ) { return (fd_nonce_state_view_t){ .data = view.data+4UL }; }
+
+int fd_lookup_table_meta_view_init( fd_lookup_table_meta_view_t * view, void const * data, ulong data_sz );
+static inline ulong fd_lookup_table_meta_view_deactivation_slot( fd_lookup_table_meta_view_t view ) { return FD_LOAD( ulong, view.data+0UL ); }
+static inline ulong fd_lookup_table_meta_view_last_extended_slot( fd_lookup_table_meta_view_t view ) { return FD_LOAD( ulong, view.data+8UL ); }
+static inline uchar fd_lookup_table_meta_view_last_extended_slot_start_index( fd_lookup_table_meta_view_t view ) { return FD_LOAD( uchar, view.data+16UL ); }
+static inline uchar fd_lookup_table_meta_view_has_authority( fd_lookup_table_meta_view_t view ) { return view.data[ 17UL ]; }
+static inline fd_pubkey_t const * fd_lookup_table_meta_view_authority( fd_lookup_table_meta_view_t view ) { return fd_type_pun_const( view.data+18UL ); }
+static inline ushort fd_lookup_table_meta_view__padding( fd_lookup_table_meta_view_t view ) { return FD_LOAD( ushort, view.data+18UL + (ulong)view.data[ 17UL ]*32UL ); }
+
+int fd_address_lookup_table_view_init( fd_address_lookup_table_view_t * view, void const * data, ulong data_sz );
+static inline fd_lookup_table_meta_view_t fd_address_lookup_table_view_meta( fd_address_lookup_table_view_t view ) { return (fd_lookup_table_meta_view_t){ .data = view.data+0UL }; }
+
+int fd_address_lookup_table_state_view_init( fd_address_lookup_table_state_view_t * view, void const * data, ulong data_sz );
+static inline uint fd_address_lookup_table_state_view_discriminant( fd_address_lookup_table_state_view_t view ) { return FD_LOAD( uint, view.data ); }
+static inline int fd_address_lookup_table_state_view_is_uninitialized( fd_address_lookup_table_state_view_t view ) { return fd_address_lookup_table_state_view_discriminant( view )==0; }
+static inline int fd_address_lookup_table_state_view_is_lookup_table( fd_address_lookup_table_state_view_t view ) { return fd_address_lookup_table_state_view_discriminant( view )==1; }
+static inline fd_address_lookup_table_view_t fd_address_lookup_table_state_view_lookup_table( fd_address_lookup_table_state_view_t view ) { return (fd_address_lookup_table_view_t){ .data = view.data+4UL }; }
+
 FD_PROTOTYPES_END
 
 #endif // HEADER_FD_RUNTIME_TYPES
@@ -110,10 +110,15 @@ struct fd_vote_stake_weight {
 };
 typedef struct fd_vote_stake_weight fd_vote_stake_weight_t;
 
+/* Sorts by stake descending then vote account descending (radix bytes
+   complemented for descending order). */
+
 #define SORT_NAME sort_vote_weights_by_stake_vote
 #define SORT_KEY_T fd_vote_stake_weight_t
+#define SORT_RADIX_SZ 40UL
+#define SORT_RADIX_BYTE(e,i) ((uchar)~( (i)<8UL ? (uchar)( (e).stake >> (56UL-8UL*(i)) ) : (e).vote_key.uc[ (i)-8UL ] ))
 #define SORT_BEFORE(a,b) ((a).stake > (b).stake ? 1 : ((a).stake < (b).stake ? 0 : memcmp( (a).vote_key.uc, (b).vote_key.uc, 32UL )>0))
-#include "../../util/tmpl/fd_sort.c"
+#include "../../util/tmpl/fd_sort_radix.c"
 
 struct fd_stake_weight {
   fd_pubkey_t key;      /* validator identity pubkey */
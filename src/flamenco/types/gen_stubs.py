@@ -3403,6 +3403,7 @@ class StructType(TypeNode):
         self.custom_decode_inner = (json["custom_decode_inner"] if "custom_decode_inner" in json else False)
         self.normalizer = (json["normalizer"] if "normalizer" in json else None)
         self.validator = (json["validator"] if "validator" in json else None)
+        self.produce_view = (bool(json["view"]) if "view" in json else False)
 
         # Handle alignment and packing attributes
         if "alignment" in json:
@@ -3666,6 +3667,22 @@ class StructType(TypeNode):
             print("}", file=body)
             print("", file=body)
 
+    def emitViewPrototypes(self):
+        n = self.fullname
+        if self.encoders is False:
+            raise ValueError(f"{n}: views require a decoder")
+        print(f'int {n}_view_init( {n}_view_t * view, void const * data, ulong data_sz );', file=header)
+        off = ViewOffset()
+        for f in self.fields:
+            if f.name == "init":
+                raise ValueError(f"{n}: member name init clashes with {n}_view_init")
+            if hasattr(f, "ignore_underflow") and f.ignore_underflow:
+                break
+            off = emitViewMember(n, f, off)
+            if off is None:
+                break
+        print("", file=header)
+
     def emitPostamble(self):
         for f in self.fields:
             f.emitPostamble()
@@ -3694,6 +3711,7 @@ class EnumType(TypeNode):
             self.attribute = ''
             self.alignment = 0
         self.compact = (json["compact"] if "compact" in json else False)
+        self.produce_view = (bool(json["view"]) if "view" in json else False)
 
         # Current supported repr types for enum are uint and ulong
         self.repr = (json["repr"] if "repr" in json else "uint")
@@ -4076,6 +4094,20 @@ class EnumType(TypeNode):
 
         indent = ''
 
+    def emitViewPrototypes(self):
+        n = self.fullname
+        if self.compact:
+            raise ValueError(f"{n}: views of compact enums are not supported")
+        print(f'int {n}_view_init( {n}_view_t * view, void const * data, ulong data_sz );', file=header)
+        print(f'static inline {self.repr} {n}_view_discriminant( {n}_view_t view ) {{ return FD_LOAD( {self.repr}, view.data ); }}', file=header)
+        for i, v in enumerate(self.variants):
+            name = (v if isinstance(v, str) else v.name)
+            print(f'static inline int {n}_view_is_{name}( {n}_view_t view ) {{ return {n}_view_discriminant( view )=={i}; }}', file=header)
+        for v in self.variants:
+            if not isinstance(v, str):
+                emitViewMember(n, v, ViewOffset(fixedsizetypes[self.repr]))
+        print("", file=header)
+
     def emitPostamble(self):
         for v in self.variants:
             if not isinstance(v, str):
@@ -4085,6 +4117,107 @@ class EnumType(TypeNode):
 type_map = {}
 
 # Main function that orchestrates the code generation process
+# Zero-copy views
+#
+# Types marked with "view": true in fd_types.json (and all the types
+# they contain) also get a view type fd_X_view_t.  A view is a pointer
+# to the bincode encoding of a value.  fd_X_view_init validates the
+# encoding in a single bounds checking pass (the decode_footprint pass)
+# and the generated fd_X_view_<member> accessors then read members in
+# place.  Member offsets are folded into constants where all preceding
+# members are fixed size, and are otherwise computed on access from the
+# option tags and vector lengths that precede the member.  Members that
+# follow a member of any other variable size encoding get no accessor.
+
+class ViewOffset:
+    """Byte offset of a member within a view (constant plus dynamic terms)."""
+    def __init__(self, const=0, terms=()):
+        self.const = const
+        self.terms = list(terms)
+
+    def plus(self, const=0, term=None):
+        return ViewOffset(self.const + const, self.terms + ([term] if term is not None else []))
+
+    def expr(self):
+        return ' + '.join([f'{self.const}UL'] + self.terms) if self.terms else f'{self.const}UL'
+
+def viewValueType(type_name):
+    """Return (C return type, C expression template of addr) for reading a
+    value of the given type in place, or None if not supported."""
+    if type_name == "bool":
+        return ('uchar', 'FD_LOAD( uchar, {addr} )')
+    if type_name in simpletypes or type_name == "uint128":
+        return (type_name, f'FD_LOAD( {type_name}, {{addr}} )')
+    if type_name.startswith("uchar["):
+        return ('uchar const *', '{addr}')
+    t = type_map.get(type_name)
+    if isinstance(t, OpaqueType) and t.size is not None:
+        return (f'{namespace}_{type_name}_t const *', f'fd_type_pun_const( {{addr}} )')
+    if isinstance(t, (StructType, EnumType)) and t.produce_view:
+        return (f'{namespace}_{type_name}_view_t', f'({namespace}_{type_name}_view_t){{{{ .data = {{addr}} }}}}')
+    return None
+
+def emitViewMember(n, f, off):
+    """Emit the accessors of member f (at offset off) of the view of type n.
+    Returns the offset of the next member or None if unknown."""
+    v = f'{n}_view_t view'
+    if isinstance(f, PrimitiveMember):
+        if not f.decode and not f.encode:
+            return off
+        if f.varint or f.decode != f.encode or f.type not in fixedsizetypes:
+            return None
+        rt, ld = viewValueType(f.type)
+        addr = f'view.data+{off.expr()}'
+        print(f'static inline {rt} {n}_view_{f.name}( {v} ) {{ return {ld.format(addr=addr)}; }}', file=header)
+        return off.plus(fixedsizetypes[f.type])
+    if isinstance(f, StructMember):
+        val = viewValueType(f.type)
+        if val is not None:
+            rt, ld = val
+            addr = f'view.data+{off.expr()}'
+            print(f'static inline {rt} {n}_view_{f.name}( {v} ) {{ return {ld.format(addr=addr)}; }}', file=header)
+        if f.type in fixedsizetypes:
+            return off.plus(fixedsizetypes[f.type])
+        return None
+    if isinstance(f, OptionMember):
+        val = viewValueType(f.element)
+        if val is None or f.element not in fixedsizetypes or f.ignore_underflow:
+            return None
+        rt, ld = val
+        tag  = f'view.data[ {off.expr()} ]'
+        addr = f'view.data+{off.plus(1).expr()}'
+        print(f'static inline uchar {n}_view_has_{f.name}( {v} ) {{ return {tag}; }}', file=header)
+        print(f'static inline {rt} {n}_view_{f.name}( {v} ) {{ return {ld.format(addr=addr)}; }}', file=header)
+        return off.plus(1, f'(ulong){tag}*{fixedsizetypes[f.element]}UL')
+    if isinstance(f, VectorMember) and not isinstance(f, StringMember):
+        val = viewValueType(f.element)
+        if val is None or f.element not in fixedsizetypes or f.compact or f.ignore_underflow:
+            return None
+        rt, ld = val
+        sz   = fixedsizetypes[f.element]
+        cnt  = f'FD_LOAD( ulong, view.data+{off.expr()} )'
+        addr = f'view.data+{off.plus(8).expr()}+idx*{sz}UL'
+        print(f'static inline ulong {n}_view_{f.name}_cnt( {v} ) {{ return {cnt}; }}', file=header)
+        print(f'static inline {rt} {n}_view_{f.name}( {v}, ulong idx ) {{ return {ld.format(addr=addr)}; }}', file=header)
+        return off.plus(8, f'{cnt}*{sz}UL')
+    return None
+
+
+def emitViewInit(n):
+    print(f'int {n}_view_init( {n}_view_t * view, void const * data, ulong data_sz ) {{', file=body)
+    print(f'  fd_bincode_decode_ctx_t ctx = {{ .data = data, .dataend = (uchar const *)data + data_sz }};', file=body)
+    print(f'  ulong total_sz = 0UL;', file=body)
+    print(f'  int err = {n}_decode_footprint_inner( &ctx, &total_sz );', file=body)
+    print(f'  if( FD_UNLIKELY( err ) ) return err;', file=body)
+    print(f'  if( FD_UNLIKELY( ctx.data>ctx.dataend ) ) return FD_BINCODE_ERR_OVERFLOW;', file=body)
+    print(f'  view->data = data;', file=body)
+    print(f'  return FD_BINCODE_SUCCESS;', file=body)
+    print(f'}}', file=body)
+
+def emitViewHeader(n):
+    print(f'struct {n}_view {{ uchar const * data; }};', file=header)
+    print(f'typedef struct {n}_view {n}_view_t;', file=header)
+
 def main():
     """
     Main code generation function.
@@ -4132,6 +4265,18 @@ def main():
         for sub in t.subMembers():
             sub.produce_global = True
 
+    # Propagate 'view' attribute to the struct and enum types reachable
+    # from types that produce a view, such that nested members get
+    # chainable subview accessors.
+    propagate = set(t for t in alltypes if getattr(t, 'produce_view', False))
+    while len(propagate) > 0:
+        t = propagate.pop()
+        for sub in t.subTypes():
+            if isinstance(sub, (StructType, EnumType)) and not sub.produce_view:
+                sub.produce_view = True
+                propagate.add(sub)
+    viewtypes = [t for t in alltypes if getattr(t, 'produce_view', False)]
+
     # Build lookup tables for type properties
     nametypes = {}
     for t in alltypes:
@@ -4162,6 +4307,20 @@ def main():
     for t in alltypes:
         t.emitPrototypes()
 
+    # Generate zero-copy view accessors
+    print("/* Zero-copy views: fd_X_view_init validates the bincode encoding of", file=header)
+    print("   an X at data in a single pass (without decoding it) and the", file=header)
+    print("   fd_X_view_<member> accessors then read members in place.  The", file=header)
+    print("   encoding must stay valid and unmodified while the view is in use.", file=header)
+    print("   Members of an option are only valid if fd_X_view_has_<member>, and", file=header)
+    print("   enum variant accessors only if fd_X_view_is_<variant>. */", file=header)
+    print("", file=header)
+    for t in viewtypes:
+        emitViewHeader(t.fullname)
+    print("", file=header)
+    for t in viewtypes:
+        t.emitViewPrototypes()
+
     print("FD_PROTOTYPES_END", file=header)
     print("", file=header)
     print("#endif // HEADER_" + json_object["name"].upper(), file=header)
@@ -4170,6 +4329,9 @@ def main():
     for t in alltypes:
         t.emitImpls()
 
+    for t in viewtypes:
+        emitViewInit(t.fullname)
+
     # Generate cleanup/postamble code
     for t in alltypes:
         t.emitPostamble()
@@ -0,0 +1,143 @@
+#include "fd_types.h"
+
+/* test_types_view checks the generated zero-copy views against a full
+   decode of randomly generated values. */
+
+static void
+rng_bytes( fd_rng_t * rng,
+           void *     _p,
+           ulong      sz ) {
+  uchar * p = _p;
+  for( ulong i=0UL; i<sz; i++ ) p[ i ] = fd_rng_uchar( rng );
+}
+
+static void
+test_stake_state( fd_rng_t * rng ) {
+  uchar buf[ 200 ];
+  for( ulong iter=0UL; iter<10000UL; iter++ ) {
+    fd_stake_state_v2_t state[1];
+    rng_bytes( rng, state, sizeof(fd_stake_state_v2_t) );
+    state->discriminant = fd_rng_uint_roll( rng, 4U );
+
+    fd_bincode_encode_ctx_t encode = { .data = buf, .dataend = buf+sizeof(buf) };
+    FD_TEST( !fd_stake_state_v2_encode( state, &encode ) );
+    ulong sz = (ulong)( (uchar *)encode.data - buf );
+
+    fd_stake_state_v2_view_t view;
+    FD_TEST( !fd_stake_state_v2_view_init( &view, buf, sz ) );
+    FD_TEST( fd_stake_state_v2_view_discriminant( view )==state->discriminant );
+    FD_TEST( fd_stake_state_v2_view_is_stake( view )==fd_stake_state_v2_is_stake( state ) );
+
+    if( fd_stake_state_v2_is_stake( state ) ) {
+      fd_stake_state_v2_stake_t const * expect = &state->inner.stake;
+      fd_stake_state_v2_stake_view_t    stake  = fd_stake_state_v2_view_stake( view );
+      fd_stake_meta_view_t              meta   = fd_stake_state_v2_stake_view_meta( stake );
+      fd_delegation_view_t delegation = fd_stake_view_delegation( fd_stake_state_v2_stake_view_stake( stake ) );
+      FD_TEST( fd_stake_meta_view_rent_exempt_reserve( meta )==expect->meta.rent_exempt_reserve );
+      FD_TEST( fd_pubkey_eq( fd_stake_authorized_view_withdrawer( fd_stake_meta_view_authorized( meta ) ), &expect->meta.authorized.withdrawer ) );
+      FD_TEST( fd_stake_lockup_view_unix_timestamp( fd_stake_meta_view_lockup( meta ) )==expect->meta.lockup.unix_timestamp );
+      FD_TEST( fd_pubkey_eq( fd_stake_lockup_view_custodian( fd_stake_meta_view_lockup( meta ) ), &expect->meta.lockup.custodian ) );
+      FD_TEST( fd_pubkey_eq( fd_delegation_view_voter_pubkey( delegation ), &expect->stake.delegation.voter_pubkey ) );
+      FD_TEST( fd_delegation_view_stake             ( delegation )==expect->stake.delegation.stake              );
+      FD_TEST( fd_delegation_view_activation_epoch  ( delegation )==expect->stake.delegation.activation_epoch   );
+      FD_TEST( fd_delegation_view_deactivation_epoch( delegation )==expect->stake.delegation.deactivation_epoch );
+      double warmup_cooldown_rate = fd_delegation_view_warmup_cooldown_rate( delegation );
+      FD_TEST( fd_memeq( &warmup_cooldown_rate, &expect->stake.delegation.warmup_cooldown_rate, sizeof(double) ) );
+      FD_TEST( fd_stake_view_credits_observed( fd_stake_state_v2_stake_view_stake( stake ) )==expect->stake.credits_observed );
+      FD_TEST( fd_stake_flags_view_bits( fd_stake_state_v2_stake_view_stake_flags( stake ) )==expect->stake_flags.bits );
+    }
+
+    /* Truncated encodings are rejected */
+    FD_TEST( fd_stake_state_v2_view_init( &view, buf, fd_rng_ulong_roll( rng, sz ) ) );
+  }
+}
+
+static void
+test_lookup_table( fd_rng_t * rng ) {
+  uchar buf[ 128 ];
+  for( ulong iter=0UL; iter<10000UL; iter++ ) {
+    fd_address_lookup_table_state_t state[1];
+    rng_bytes( rng, state, sizeof(fd_address_lookup_table_state_t) );
+    state->discriminant = fd_rng_uint_roll( rng, 2U );
+    state->inner.lookup_table.meta.has_authority = (uchar)fd_rng_uint_roll( rng, 2U );
+
+    fd_bincode_encode_ctx_t encode = { .data = buf, .dataend = buf+sizeof(buf) };
+    FD_TEST( !fd_address_lookup_table_state_encode( state, &encode ) );
+    ulong sz = (ulong)( (uchar *)encode.data - buf );
+
+    fd_address_lookup_table_state_view_t view;
+    FD_TEST( !fd_address_lookup_table_state_view_init( &view, buf, sz ) );
+    FD_TEST( fd_address_lookup_table_state_view_is_lookup_table( view )==fd_address_lookup_table_state_is_lookup_table( state ) );
+
+    if( fd_address_lookup_table_state_is_lookup_table( state ) ) {
+      fd_lookup_table_meta_t const * expect = &state->inner.lookup_table.meta;
+      fd_lookup_table_meta_view_t    meta   = fd_address_lookup_table_view_meta( fd_address_lookup_table_state_view_lookup_table( view ) );
+      FD_TEST( fd_lookup_table_meta_view_deactivation_slot( meta )==expect->deactivation_slot );
+      FD_TEST( fd_lookup_table_meta_view_last_extended_slot( meta )==expect->last_extended_slot );
+      FD_TEST( fd_lookup_table_meta_view_last_extended_slot_start_index( meta )==expect->last_extended_slot_start_index );
+      FD_TEST( fd_lookup_table_meta_view_has_authority( meta )==expect->has_authority );
+      if( expect->has_authority ) FD_TEST( fd_pubkey_eq( fd_lookup_table_meta_view_authority( meta ), &expect->authority ) );
+      FD_TEST( fd_lookup_table_meta_view__padding( meta )==expect->_padding );
+    }
+
+    FD_TEST( fd_address_lookup_table_state_view_init( &view, buf, fd_rng_ulong_roll( rng, sz ) ) );
+  }
+
+  /* Invalid option tag */
+  memset( buf, 0, sizeof(buf) );
+  buf[ 0 ] = 1; buf[ 4+17 ] = 2;
+  fd_address_lookup_table_state_view_t view;
+  FD_TEST( fd_address_lookup_table_state_view_init( &view, buf, sizeof(buf) )==FD_BINCODE_ERR_ENCODING );
+}
+
+static void
+test_nonce( fd_rng_t * rng ) {
+  uchar buf[ 128 ];
+  for( ulong iter=0UL; iter<10000UL; iter++ ) {
+    fd_nonce_state_versions_t state[1];
+    rng_bytes( rng, state, sizeof(fd_nonce_state_versions_t) );
+    state->discriminant                = fd_rng_uint_roll( rng, 2U );
+    state->inner.current.discriminant  = fd_rng_uint_roll( rng, 2U );
+
+    fd_bincode_encode_ctx_t encode = { .data = buf, .dataend = buf+sizeof(buf) };
+    FD_TEST( !fd_nonce_state_versions_encode( state, &encode ) );
+    ulong sz = (ulong)( (uchar *)encode.data - buf );
+
+    fd_nonce_state_versions_view_t view;
+    FD_TEST( !fd_nonce_state_versions_view_init( &view, buf, sz ) );
+    FD_TEST( fd_nonce_state_versions_view_is_current( view )==fd_nonce_state_versions_is_current( state ) );
+
+    fd_nonce_state_view_t nonce = fd_nonce_state_versions_view_is_current( view ) ?
+                                  fd_nonce_state_versions_view_current( view ) :
+                                  fd_nonce_state_versions_view_legacy ( view );
+    FD_TEST( fd_nonce_state_view_is_initialized( nonce )==fd_nonce_state_is_initialized( &state->inner.current ) );
+    if( fd_nonce_state_is_initialized( &state->inner.current ) ) {
+      fd_nonce_data_t const * expect = &state->inner.current.inner.initialized;
+      fd_nonce_data_view_t    data   = fd_nonce_state_view_initialized( nonce );
+      FD_TEST( fd_pubkey_eq( fd_nonce_data_view_authority( data ), &expect->authority ) );
+      FD_TEST( fd_memeq( fd_nonce_data_view_durable_nonce( data ), &expect->durable_nonce, sizeof(fd_hash_t) ) );
+      FD_TEST( fd_fee_calculator_view_lamports_per_signature( fd_nonce_data_view_fee_calculator( data ) )==
+               expect->fee_calculator.lamports_per_signature );
+    }
+
+    FD_TEST( fd_nonce_state_versions_view_init( &view, buf, fd_rng_ulong_roll( rng, sz ) ) );
+  }
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  test_stake_state ( rng );
+  test_lookup_table( rng );
+  test_nonce       ( rng );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
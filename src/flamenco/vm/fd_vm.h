@@ -28,6 +28,7 @@ struct __attribute__((aligned(8UL))) fd_vm_input_region {
    uint  region_sz;              /* Size of the memory region. */
    ulong address_space_reserved; /* The amount of address space reserved for the region. */
    uchar is_writable;            /* If the region can be written to or is read-only */
+   uchar is_cow;                 /* If the region is writable but still maps the account's unstaged (copy-on-write) data */
    ulong acc_region_meta_idx;    /* Index of the acc_region_meta_t struct for the account corresponding to this region. */
 };
 typedef struct fd_vm_input_region fd_vm_input_region_t;
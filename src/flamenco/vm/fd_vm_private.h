@@ -309,17 +309,33 @@ fd_vm_get_input_mem_region_idx( fd_vm_t const * vm, ulong offset ) {
   return left;
 }
 
+/* fd_vm_input_region_stage points a copy-on-write account data region
+   at the account's staged data.  The account is staged with room for
+   the region's whole reserved address space, so that the data does not
+   move when the region grows while the VM holds on to pointers into
+   it (e.g. across the translations of a syscall). */
+
+static inline void
+fd_vm_input_region_stage( fd_vm_t *              vm,
+                          fd_vm_input_region_t * region ) {
+  fd_txn_account_t * acct = vm->acc_region_metas[ region->acc_region_meta_idx ].acct;
+  fd_txn_account_reserve( acct, region->address_space_reserved );
+  region->haddr       = (ulong)fd_txn_account_get_data( acct );
+  region->is_writable = 1U;
+  region->is_cow      = 0U;
+}
+
 /* If the region is an account, handle the resizing logic. This logic
    corresponds to
    solana_transaction_context::TransactionContext::access_violation_handler
 
    https://github.com/anza-xyz/agave/blob/v3.0.1/transaction-context/src/lib.rs#L510-L581 */
 static inline void
-fd_vm_handle_input_mem_region_oob( fd_vm_t const * vm,
-                                   ulong           offset,
-                                   ulong           sz,
-                                   ulong           region_idx,
-                                   uchar           write ) {
+fd_vm_handle_input_mem_region_oob( fd_vm_t * vm,
+                                   ulong     offset,
+                                   ulong     sz,
+                                   ulong     region_idx,
+                                   uchar     write ) {
   /* If stricter_abi_and_runtime_constraints is not enabled, we don't need to
      do anything */
   if( FD_UNLIKELY( !vm->stricter_abi_and_runtime_constraints ) ) {
@@ -335,7 +351,7 @@ fd_vm_handle_input_mem_region_oob( fd_vm_t const * vm,
   fd_vm_input_region_t * region = &vm->input_mem_regions[ region_idx ];
   /* If the region is not writable, we don't need to do anything
      https://github.com/anza-xyz/agave/blob/v3.0.1/transaction-context/src/lib.rs#L526-L529 */
-  if( FD_UNLIKELY( !region->is_writable ) ) {
+  if( FD_UNLIKELY( !region->is_writable && !region->is_cow ) ) {
     return;
   }
 
@@ -369,6 +385,11 @@ fd_vm_handle_input_mem_region_oob( fd_vm_t const * vm,
         fd_ulong_sat_add( vm->instr_ctx->txn_ctx->accounts_resize_delta, new_region_sz ),
         region->region_sz );
 
+      /* Resizing modifies the account, so a copy-on-write region is
+         staged first.  Room for the region's reserved address space was
+         made when the account was staged or mapped, so the account data
+         does not move here. */
+      if( FD_UNLIKELY( region->is_cow ) ) fd_vm_input_region_stage( vm, region );
       fd_txn_account_resize( vm->acc_region_metas[ region->acc_region_meta_idx ].acct, new_region_sz );
       region->region_sz = (uint)new_region_sz;
     }
@@ -382,11 +403,11 @@ fd_vm_handle_input_mem_region_oob( fd_vm_t const * vm,
    region_idx. However, it will get caught for being too large of an access
    in the multi-region checks. */
 static inline ulong
-fd_vm_find_input_mem_region( fd_vm_t const * vm,
-                             ulong           offset,
-                             ulong           sz,
-                             uchar           write,
-                             ulong           sentinel ) {
+fd_vm_find_input_mem_region( fd_vm_t * vm,
+                             ulong     offset,
+                             ulong     sz,
+                             uchar     write,
+                             ulong     sentinel ) {
   if( FD_UNLIKELY( vm->input_mem_regions_cnt==0 ) ) {
     return sentinel; /* Access is too large */
   }
@@ -415,10 +436,19 @@ fd_vm_find_input_mem_region( fd_vm_t const * vm,
     return sentinel;
   }
 
-  if( FD_UNLIKELY( write && vm->input_mem_regions[ region_idx ].is_writable==0U ) ) {
+  fd_vm_input_region_t * region = &vm->input_mem_regions[ region_idx ];
+  if( FD_UNLIKELY( write && !region->is_writable && !region->is_cow ) ) {
     return sentinel; /* Illegal write */
   }
 
+  /* Writable account data regions are mapped read-only until they are
+     first written to.  The first valid write stages the account and
+     points the region at the staged copy, like Agave's copy-on-write
+     memory regions. */
+  if( FD_UNLIKELY( write && region->is_cow ) ) {
+    fd_vm_input_region_stage( vm, region );
+  }
+
   ulong start_region_idx = region_idx;
 
   ulong adjusted_haddr = vm->input_mem_regions[ start_region_idx ].haddr + offset - vm->input_mem_regions[ start_region_idx ].vaddr_offset;
@@ -427,7 +457,7 @@ fd_vm_find_input_mem_region( fd_vm_t const * vm,
 
 
 static inline ulong
-fd_vm_mem_haddr( fd_vm_t const * vm,
+fd_vm_mem_haddr( fd_vm_t *       vm,
                  ulong           vaddr,
                  ulong           sz,
                  ulong const *   vm_region_haddr, /* indexed [0,6) */
@@ -477,7 +507,7 @@ fd_vm_mem_haddr( fd_vm_t const * vm,
 }
 
 static inline ulong
-fd_vm_mem_haddr_fast( fd_vm_t const * vm,
+fd_vm_mem_haddr_fast( fd_vm_t *       vm,
                       ulong           vaddr,
                       ulong   const * vm_region_haddr ) { /* indexed [0,6) */
   ulong region   = FD_VADDR_TO_REGION( vaddr );
@@ -316,14 +316,16 @@ fd_vm_cpi_update_caller_account_region( fd_vm_t *                    vm,
   /* https://github.com/anza-xyz/agave/blob/v3.0.4/syscalls/src/cpi.rs#L1159-L1164 */
   if( address_space_reserved_for_account > 0UL ) {
     /* Note that we don't special-case direct mapping here, as Agave does,
-       because we do not create regions using CoW upon resize like Agave does.
+       because we have already created all the regions for each account
+       at serialization time.
 
        Therefore we do not need the logic in the Agave code to create a new
-       region, as we have already created all the regions for each account.
-
-       Therefore we do not have equivalents of Agave's
-       modify_memory_region_of_account and create_memory_region_of_account
-       functions, but we instead inline this logic directly below. */
+       region, and we inline the equivalent of Agave's
+       modify_memory_region_of_account directly below.  With direct
+       mapping, the callee may have staged or grown the account, so the
+       region is pointed at the account's current data (with room for
+       the region's reserved address space) and stays copy-on-write
+       only if the account was left untouched. */
     fd_vm_acc_region_meta_t * acc_region_meta = &vm->acc_region_metas[instr_acc_idx];
     fd_vm_input_region_t *    region          = &vm->input_mem_regions[acc_region_meta->region_idx + 1UL];
 
@@ -332,9 +334,16 @@ fd_vm_cpi_update_caller_account_region( fd_vm_t *                    vm,
     region->region_sz = (uint)fd_borrowed_account_get_data_len( borrowed_account );
 
     int err;
-    int is_writable = fd_borrowed_account_can_data_be_changed( borrowed_account, &err );
+    int is_writable = fd_borrowed_account_can_data_be_changed( borrowed_account, &err ) && ( err == FD_EXECUTOR_INSTR_SUCCESS );
+    int is_cow      = 0;
+    if( vm->direct_mapping ) {
+      is_cow        = is_writable && fd_txn_account_is_cow( borrowed_account->acct );
+      if( is_writable && !is_cow ) fd_txn_account_reserve( borrowed_account->acct, region->address_space_reserved );
+      region->haddr = (ulong)fd_borrowed_account_get_data( borrowed_account );
+    }
 
-    region->is_writable = (uchar)is_writable && ( err == FD_EXECUTOR_INSTR_SUCCESS );
+    region->is_writable = (uchar)( is_writable && !is_cow );
+    region->is_cow      = (uchar)is_cow;
   }
 
   return FD_VM_SUCCESS;
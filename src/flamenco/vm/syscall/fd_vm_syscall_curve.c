@@ -317,7 +317,9 @@ invalid_error:
    Specifically it takes as input byte arrays and takes care of scalars
    validation and points decompression.  It then invokes ballet MSM
    function fd_ed25519_multi_scalar_mul.  To avoid dynamic allocation,
-   the full MSM is done in batches of FD_BALLET_CURVE25519_MSM_BATCH_SZ. */
+   the full MSM is done in batches of
+   FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ, so that large inputs use
+   the bucket method. */
 
 static fd_ed25519_point_t *
 multi_scalar_mul_edwards( fd_ed25519_point_t * r,
@@ -333,11 +335,11 @@ multi_scalar_mul_edwards( fd_ed25519_point_t * r,
 
   /* Static allocation of a batch of decompressed points */
   fd_ed25519_point_t tmp[1];
-  fd_ed25519_point_t A[ FD_BALLET_CURVE25519_MSM_BATCH_SZ ];
+  fd_ed25519_point_t A[ FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ ];
 
   fd_ed25519_point_set_zero( r );
-  for( ulong i=0UL; i<cnt; i+=FD_BALLET_CURVE25519_MSM_BATCH_SZ ) {
-    ulong batch_cnt = fd_ulong_min( cnt-i, FD_BALLET_CURVE25519_MSM_BATCH_SZ );
+  for( ulong i=0UL; i<cnt; i+=FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ ) {
+    ulong batch_cnt = fd_ulong_min( cnt-i, FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ );
 
     /* Decompress (and validate) points */
     for( ulong j=0UL; j<batch_cnt; j++ ) {
@@ -373,11 +375,11 @@ multi_scalar_mul_ristretto( fd_ristretto255_point_t * r,
 
   /* Static allocation of a batch of decompressed points */
   fd_ristretto255_point_t tmp[1];
-  fd_ristretto255_point_t A[ FD_BALLET_CURVE25519_MSM_BATCH_SZ ];
+  fd_ristretto255_point_t A[ FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ ];
 
   fd_ristretto255_point_set_zero( r );
-  for( ulong i=0UL; i<cnt; i+=FD_BALLET_CURVE25519_MSM_BATCH_SZ ) {
-    ulong batch_cnt = fd_ulong_min( cnt-i, FD_BALLET_CURVE25519_MSM_BATCH_SZ );
+  for( ulong i=0UL; i<cnt; i+=FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ ) {
+    ulong batch_cnt = fd_ulong_min( cnt-i, FD_BALLET_CURVE25519_MSM_PIPPENGER_BATCH_SZ );
 
     /* Decompress (and validate) points */
     for( ulong j=0UL; j<batch_cnt; j++ ) {
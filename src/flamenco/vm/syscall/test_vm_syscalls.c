@@ -1,5 +1,7 @@
 #include "fd_vm_syscall.h"
 #include "../test_vm_util.h"
+#include "../../runtime/fd_acc_mgr.h"
+#include "../../runtime/fd_runtime.h"
 
 static inline void set_memory_region( uchar * mem, ulong sz ) { for( ulong i=0UL; i<sz; i++ ) mem[i] = (uchar)(i & 0xffUL); }
 
@@ -194,6 +196,87 @@ test_vm_syscall_sol_log_data( char const *            test_case_name,
   FD_LOG_NOTICE(( "Passed test program (%s)", test_case_name ));
 }
 
+/* test_vm_syscall_cow_account_grow checks a syscall that translates
+   several pointers into a copy-on-write account that it both stages
+   (first write) and grows (write past the end of its data).  The
+   account must not move between the two translations. */
+
+static uchar cow_stage_mem[ FD_ACC_TOT_SZ_MAX ] __attribute__((aligned(16)));
+
+static void
+test_vm_syscall_cow_account_grow( fd_vm_t *    vm,
+                                  fd_alloc_t * alloc ) {
+  ulong const dlen = 32UL;
+
+  struct __attribute__((aligned(16))) {
+    fd_account_meta_t meta;
+    uchar             data[ 32 ];
+  } rec = {0};
+  rec.meta.dlen     = (uint)dlen;
+  rec.meta.lamports = 1UL;
+  memset( rec.data, 0xAB, dlen );
+
+  fd_pubkey_t      pubkey = {{ 1 }};
+  fd_txn_account_t acct_[1];
+  fd_txn_account_t * acct = fd_txn_account_join( fd_txn_account_new( acct_, &pubkey, &rec.meta, 1 ) );
+  FD_TEST( acct );
+  fd_txn_account_set_stage_mem  ( acct, cow_stage_mem );
+  fd_txn_account_set_stage_alloc( acct, alloc );
+
+  /* Region 0 is the program id, region 1 the account's data, mapped
+     the way direct mapping maps an unstaged writable account */
+
+  fd_pubkey_t program_id = {{ 2 }};
+  fd_vm_input_region_t regions[2] = {
+    { .haddr = (ulong)&program_id, .region_sz = 32U, .address_space_reserved = 32UL, .vaddr_offset = 0UL },
+    { .haddr = (ulong)rec.data, .region_sz = (uint)dlen, .address_space_reserved = dlen+MAX_PERMITTED_DATA_INCREASE,
+      .is_cow = 1, .vaddr_offset = 32UL, .acc_region_meta_idx = 0UL } };
+  fd_vm_acc_region_meta_t metas[1] = {{ .region_idx = 0U, .acct = acct }};
+
+  fd_vm_input_region_t *    saved_regions     = vm->input_mem_regions;
+  uint                      saved_regions_cnt = vm->input_mem_regions_cnt;
+  fd_vm_acc_region_meta_t * saved_metas       = vm->acc_region_metas;
+  vm->input_mem_regions     = regions;
+  vm->input_mem_regions_cnt = 2U;
+  vm->acc_region_metas      = metas;
+  vm->cu                    = FD_VM_COMPUTE_UNIT_LIMIT;
+  vm->instr_ctx->txn_ctx->accounts_resize_delta = 0UL;
+
+  /* The bump seed is written to the first data byte (staging the
+     account), the address right past the end of the data (growing it) */
+
+  ulong data_vaddr = FD_VM_MEM_MAP_INPUT_REGION_START + 32UL;
+  ulong ret = 1UL;
+  FD_TEST( !fd_vm_syscall_sol_try_find_program_address( vm, 0UL, 0UL, FD_VM_MEM_MAP_INPUT_REGION_START,
+                                                        data_vaddr+dlen, data_vaddr, &ret ) );
+  FD_TEST( !ret );
+
+  uchar const * data = fd_txn_account_get_data( acct );
+  FD_TEST( !fd_txn_account_is_cow( acct ) );
+  FD_TEST( fd_txn_account_is_dirty( acct ) );
+  FD_TEST( acct->stage_val );
+  FD_TEST( regions[1].haddr==(ulong)data );
+  FD_TEST( regions[1].is_writable && !regions[1].is_cow );
+  FD_TEST( fd_txn_account_get_data_len( acct )==regions[1].region_sz );
+  FD_TEST( regions[1].region_sz>dlen+sizeof(fd_pubkey_t) );
+
+  /* Both writes landed in the account's current data and the record
+     was left untouched */
+
+  uchar bump[1] = { data[0] };
+  fd_pubkey_t derived[1];
+  FD_TEST( !fd_vm_derive_pda( vm, &program_id, NULL, NULL, 0UL, bump, derived ) );
+  FD_TEST( fd_memeq( data+dlen, derived, sizeof(fd_pubkey_t) ) );
+  for( ulong i=1UL; i<dlen; i++ ) FD_TEST( data[i]==0xAB );
+  for( ulong i=0UL; i<dlen; i++ ) FD_TEST( rec.data[i]==0xAB );
+
+  fd_txn_account_release_stage_val( acct );
+
+  vm->input_mem_regions     = saved_regions;
+  vm->input_mem_regions_cnt = saved_regions_cnt;
+  vm->acc_region_metas      = saved_metas;
+}
+
 static void
 dump_syscall_table( void ) {
   fd_sbpf_syscalls_t _syscalls[ 1UL<<FD_SBPF_SYSCALLS_LG_SLOT_CNT ] = {0};
@@ -781,6 +864,17 @@ main( int     argc,
 
 # undef APPEND
 
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( FD_SHMEM_NORMAL_PAGE_SZ, 1024UL, fd_log_cpu_id(), "wksp", 0UL );
+  FD_TEST( wksp );
+  fd_alloc_t * alloc = fd_alloc_join( fd_alloc_new( fd_wksp_alloc_laddr( wksp, fd_alloc_align(), fd_alloc_footprint(), 1UL ), 1UL ), 0UL );
+  FD_TEST( alloc );
+
+  test_vm_syscall_toggle_direct_mapping( vm, 1 ); /* enable direct mapping */
+  test_vm_syscall_cow_account_grow( vm, alloc );
+
+  fd_wksp_free_laddr( fd_alloc_delete( fd_alloc_leave( alloc ) ) );
+  fd_wksp_delete_anonymous( wksp );
+
   fd_vm_delete    ( fd_vm_leave    ( vm  ) );
   fd_sha256_delete( fd_sha256_leave( sha ) );
   fd_rng_delete   ( fd_rng_leave   ( rng ) );
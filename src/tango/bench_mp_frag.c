@@ -0,0 +1,194 @@
+#include "fd_tango.h"
+
+#if FD_HAS_HOSTED && FD_HAS_ATOMIC
+
+/* bench_mp_frag compares two ways of fanning in the frags of tx_cnt
+   producer tiles into a single consumer tile (this tile):
+
+     --mode sp: each producer has its own mcache (i.e. tx_cnt single
+                producer links) and the consumer polls them round
+                robin, returning credits on one fseq per link.
+
+     --mode mp: all producers share a single multi-producer mcache (see
+                fd_mcache_new_mp) and the consumer polls it like any
+                other mcache, returning credits on a single fseq.
+
+   Frags are metadata only (no dcache).  Every producer publishes
+   --frag-cnt frags and the consumer checks that it sees every frag of
+   every producer exactly once and in order.  The run time from the
+   start signal to the last frag consumed is reported. */
+
+#define TX_MAX (64UL)
+
+struct bench_cfg {
+  int              mp;
+  ulong            frag_cnt;
+  fd_frag_meta_t * mcache[ TX_MAX ];
+  ulong *          fseq  [ TX_MAX ];
+  int              go;
+};
+
+typedef struct bench_cfg bench_cfg_t;
+
+static int
+tx_tile_main( int     argc,
+              char ** argv ) {
+  ulong         tx_idx = (ulong)(uint)argc;
+  bench_cfg_t * cfg    = (bench_cfg_t *)fd_type_pun( argv );
+
+  fd_frag_meta_t * mcache = cfg->mcache[ cfg->mp ? 0UL : tx_idx ];
+  ulong const *    fseq   = cfg->fseq  [ cfg->mp ? 0UL : tx_idx ];
+  ulong            depth  = fd_mcache_depth( mcache );
+  ulong *          _next  = cfg->mp ? fd_mcache_mp_next_laddr( mcache ) : NULL;
+
+  while( !FD_VOLATILE_CONST( cfg->go ) ) FD_SPIN_PAUSE();
+
+  ulong seq     = 0UL;
+  ulong seq_max = fd_seq_inc( fd_fseq_query( fseq ), depth );
+  for( ulong frag_idx=0UL; frag_idx<cfg->frag_cnt; frag_idx++ ) {
+    ulong sig = (tx_idx<<48) | frag_idx;
+    if( _next ) {
+      while( FD_UNLIKELY( !fd_mcache_mp_try_claim( _next, seq_max, 1UL, &seq ) ) ) {
+        FD_SPIN_PAUSE();
+        seq_max = fd_seq_inc( fd_fseq_query( fseq ), depth );
+      }
+    } else {
+      while( FD_UNLIKELY( fd_seq_ge( seq, seq_max ) ) ) {
+        FD_SPIN_PAUSE();
+        seq_max = fd_seq_inc( fd_fseq_query( fseq ), depth );
+      }
+    }
+    fd_mcache_publish( mcache, depth, seq, sig, 0UL, 0UL, 0UL, 0UL, 0UL );
+    if( !_next ) seq = fd_seq_inc( seq, 1UL );
+  }
+
+  return 0;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
+  if( cpu_idx>=fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "gigantic"                 );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 1UL                        );
+  ulong        numa_idx = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx", NULL, fd_shmem_numa_idx(cpu_idx) );
+  char const * _mode    = fd_env_strip_cmdline_cstr ( &argc, &argv, "--mode",     NULL, "mp"                       );
+  ulong        tx_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--tx-cnt",   NULL, 4UL                        );
+  ulong        depth    = fd_env_strip_cmdline_ulong( &argc, &argv, "--depth",    NULL, 4096UL                     );
+  ulong        frag_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--frag-cnt", NULL, 10000000UL                 );
+
+  int mp;
+  if(      !strcmp( _mode, "mp" ) ) mp = 1;
+  else if( !strcmp( _mode, "sp" ) ) mp = 0;
+  else FD_LOG_ERR(( "--mode should be sp or mp" ));
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz                       ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+  if( FD_UNLIKELY( (!tx_cnt) | (tx_cnt>TX_MAX)    ) ) FD_LOG_ERR(( "--tx-cnt should be in [1,%lu]", TX_MAX ));
+  if( FD_UNLIKELY( !fd_mcache_footprint( depth, 0UL ) ) ) FD_LOG_ERR(( "bad --depth" ));
+  if( FD_UNLIKELY( frag_cnt>=(1UL<<48)            ) ) FD_LOG_ERR(( "--frag-cnt too large" ));
+  if( FD_UNLIKELY( fd_tile_cnt()<tx_cnt+1UL       ) ) FD_LOG_ERR(( "this bench requires at least %lu tiles", tx_cnt+1UL ));
+
+  FD_LOG_NOTICE(( "Creating workspace with --page-cnt %lu --page-sz %s pages on --numa-idx %lu", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  static bench_cfg_t cfg[1];
+  cfg->mp       = mp;
+  cfg->frag_cnt = frag_cnt;
+  cfg->go       = 0;
+
+  ulong link_cnt = mp ? 1UL : tx_cnt;
+  for( ulong link_idx=0UL; link_idx<link_cnt; link_idx++ ) {
+    void * mcache_mem = fd_wksp_alloc_laddr( wksp, fd_mcache_align(), fd_mcache_footprint( depth, 0UL ), 1UL );
+    void * fseq_mem   = fd_wksp_alloc_laddr( wksp, fd_fseq_align(),   fd_fseq_footprint(),               1UL );
+    FD_TEST( mcache_mem && fseq_mem );
+    cfg->mcache[ link_idx ] = fd_mcache_join( fd_mcache_new_mp( mcache_mem, depth, 0UL, 0UL, mp ? tx_cnt : 1UL ) );
+    cfg->fseq  [ link_idx ] = fd_fseq_join  ( fd_fseq_new     ( fseq_mem,   0UL                                 ) );
+    FD_TEST( cfg->mcache[ link_idx ] && cfg->fseq[ link_idx ] );
+  }
+
+  for( ulong tx_idx=0UL; tx_idx<tx_cnt; tx_idx++ )
+    FD_TEST( fd_tile_exec_new( tx_idx+1UL, tx_tile_main, (int)(uint)tx_idx, (char **)fd_type_pun( cfg ) ) );
+
+  FD_LOG_NOTICE(( "Running (--mode %s --tx-cnt %lu --depth %lu --frag-cnt %lu)", _mode, tx_cnt, depth, frag_cnt ));
+
+  static ulong expect[ TX_MAX ];
+  ulong        seq   [ TX_MAX ] = {0};
+  ulong        credit_mask = fd_ulong_max( depth>>2, 1UL ) - 1UL; /* depth is a power of 2 */
+  ulong        rem         = tx_cnt*frag_cnt;
+  ulong        poll_idx    = 0UL;
+  ulong        empty_cnt   = 0UL;
+
+  long tic = fd_log_wallclock();
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cfg->go ) = 1;
+  FD_COMPILER_MFENCE();
+
+  while( rem ) {
+    fd_frag_meta_t const * mline     = cfg->mcache[ poll_idx ] + fd_mcache_line_idx( seq[ poll_idx ], depth );
+    ulong                  seq_found = fd_frag_meta_seq_query( mline );
+    if( FD_UNLIKELY( !fd_seq_eq( seq_found, seq[ poll_idx ] ) ) ) {
+      FD_TEST( fd_seq_lt( seq_found, seq[ poll_idx ] ) ); /* producers honor flow control */
+      empty_cnt++;
+      poll_idx++; if( poll_idx>=link_cnt ) poll_idx = 0UL;
+      continue;
+    }
+
+    FD_COMPILER_MFENCE();
+    ulong sig = mline->sig;
+    FD_COMPILER_MFENCE();
+    FD_TEST( fd_seq_eq( fd_frag_meta_seq_query( mline ), seq_found ) );
+
+    ulong tx_idx = sig>>48;
+    FD_TEST( tx_idx<tx_cnt );
+    FD_TEST( (sig & ((1UL<<48)-1UL))==expect[ tx_idx ] );
+    expect[ tx_idx ]++;
+    rem--;
+
+    seq[ poll_idx ] = fd_seq_inc( seq[ poll_idx ], 1UL );
+    if( FD_UNLIKELY( !(seq[ poll_idx ] & credit_mask) ) ) fd_fseq_update( cfg->fseq[ poll_idx ], seq[ poll_idx ] );
+
+    poll_idx++; if( poll_idx>=link_cnt ) poll_idx = 0UL;
+  }
+
+  long toc = fd_log_wallclock();
+
+  for( ulong tx_idx=0UL; tx_idx<tx_cnt; tx_idx++ ) {
+    int ret;
+    FD_TEST( !fd_tile_exec_delete( fd_tile_exec( tx_idx+1UL ), &ret ) );
+    FD_TEST( !ret );
+    FD_TEST( expect[ tx_idx ]==frag_cnt );
+  }
+
+  double ns = (double)(toc-tic);
+  FD_LOG_NOTICE(( "--mode %s: %lu frags in %.3f ms (%.3f Mfrag/s, %.2f ns/frag, %lu empty polls)",
+                  _mode, tx_cnt*frag_cnt, ns*1e-6, 1e3*(double)(tx_cnt*frag_cnt)/ns, ns/(double)(tx_cnt*frag_cnt), empty_cnt ));
+
+  for( ulong link_idx=0UL; link_idx<link_cnt; link_idx++ ) {
+    fd_wksp_free_laddr( fd_mcache_delete( fd_mcache_leave( cfg->mcache[ link_idx ] ) ) );
+    fd_wksp_free_laddr( fd_fseq_delete  ( fd_fseq_leave  ( cfg->fseq  [ link_idx ] ) ) );
+  }
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED and FD_HAS_ATOMIC capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
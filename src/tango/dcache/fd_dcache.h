@@ -269,6 +269,41 @@ fd_dcache_compact_next( ulong chunk,    /* Assumed in [chunk0,wmark] */
   return fd_ulong_if( chunk>wmark, chunk0, chunk );                 /* If that goes over the high water mark, wrap to zero */
 }
 
+/* fd_dcache_compact_part_{chunk0,wmark} split the data region of a
+   dcache shared by part_cnt (positive) producers (e.g. the producers of
+   a multi-producer mcache, see fd_mcache_new_mp) into part_cnt equal
+   and disjoint parts and return the chunk0 and wmark of part part_idx
+   (in [0,part_cnt)).  Each producer writes into its own part with
+   fd_dcache_compact_next as above using the part's chunk0 and wmark.
+
+   As one producer might have all the depth frags visible to consumers
+   of a multi-producer mcache, every part must be large enough for the
+   full depth, i.e. the dcache data region should be at least
+   part_cnt*fd_dcache_req_data_sz( mtu, depth, burst, 1 ) bytes.  These
+   assume the same as fd_dcache_compact_{chunk0,wmark} above. */
+
+FD_FN_PURE static inline ulong
+fd_dcache_compact_part_chunk0( void const * base,
+                               void const * dcache,
+                               ulong        part_idx,
+                               ulong        part_cnt ) {
+  ulong chunk0   = fd_dcache_compact_chunk0( base, dcache );
+  ulong part_cnk = ((fd_dcache_compact_chunk1( base, dcache ) - chunk0) / part_cnt) & ~1UL; /* double chunk aligned */
+  return chunk0 + part_idx*part_cnk;
+}
+
+FD_FN_PURE static inline ulong
+fd_dcache_compact_part_wmark( void const * base,
+                              void const * dcache,
+                              ulong        mtu,
+                              ulong        part_idx,
+                              ulong        part_cnt ) {
+  ulong chunk0    = fd_dcache_compact_chunk0( base, dcache );
+  ulong part_cnk  = ((fd_dcache_compact_chunk1( base, dcache ) - chunk0) / part_cnt) & ~1UL;
+  ulong chunk_mtu = ((mtu + 2UL*FD_CHUNK_SZ-1UL) >> (1+FD_CHUNK_LG_SZ)) << 1;
+  return chunk0 + (part_idx+1UL)*part_cnk - chunk_mtu;
+}
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_tango_dcache_fd_dcache_h */
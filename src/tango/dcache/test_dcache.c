@@ -203,6 +203,26 @@ main( int     argc,
       ulong fp    = fd_ulong_align_up( sz, 2UL*FD_CHUNK_SZ ) >> FD_CHUNK_LG_SZ;
       FD_TEST( next==fd_ulong_if( (chunk+fp)>wmark, chunk0, chunk+fp ) );
     }
+
+    /* Test partitioning among multiple producers */
+
+    for( ulong part_cnt=1UL; part_cnt<=8UL; part_cnt++ ) {
+      if( data_sz < part_cnt*fd_dcache_req_data_sz( mtu, depth, 1UL /*burst*/, 1 /*compact*/ ) ) break;
+      ulong part_end = chunk0;
+      for( ulong part_idx=0UL; part_idx<part_cnt; part_idx++ ) {
+        ulong part_chunk0 = fd_dcache_compact_part_chunk0( ref, dcache,      part_idx, part_cnt );
+        ulong part_wmark  = fd_dcache_compact_part_wmark ( ref, dcache, mtu, part_idx, part_cnt );
+        FD_TEST( fd_ulong_is_aligned( part_chunk0-chunk0, 2UL ) );
+        FD_TEST( part_chunk0>=part_end ); /* disjoint */
+        FD_TEST( part_chunk0<=part_wmark ); FD_TEST( part_wmark<=wmark );
+        part_end = part_wmark + chunk_mtu;
+      }
+      FD_TEST( part_end<=chunk1 );
+      if( part_cnt==1UL ) {
+        FD_TEST( fd_dcache_compact_part_chunk0( ref, dcache,      0UL, 1UL )==chunk0 );
+        FD_TEST( fd_dcache_compact_part_wmark ( ref, dcache, mtu, 0UL, 1UL )==(chunk0 + ((chunk1-chunk0) & ~1UL) - chunk_mtu) );
+      }
+    }
   }
 
   /* Test mcache destruction */
@@ -33,6 +33,15 @@ fd_mcache_new( void * shmem,
                ulong  depth,
                ulong  app_sz,
                ulong  seq0 ) {
+  return fd_mcache_new_mp( shmem, depth, app_sz, seq0, 1UL );
+}
+
+void *
+fd_mcache_new_mp( void * shmem,
+                  ulong  depth,
+                  ulong  app_sz,
+                  ulong  seq0,
+                  ulong  prod_cnt ) {
 
   if( FD_UNLIKELY( !shmem ) ) {
     FD_LOG_WARNING(( "NULL shmem" ));
@@ -50,6 +59,11 @@ fd_mcache_new( void * shmem,
     return NULL;
   }
 
+  if( FD_UNLIKELY( !prod_cnt ) ) {
+    FD_LOG_WARNING(( "zero prod_cnt" ));
+    return NULL;
+  }
+
   fd_memset( shmem, 0, footprint );
 
   fd_mcache_private_hdr_t * hdr = (fd_mcache_private_hdr_t *)shmem;
@@ -58,8 +72,10 @@ fd_mcache_new( void * shmem,
   hdr->app_sz   = app_sz;
   hdr->seq0     = seq0;
   hdr->app_off  = sizeof(fd_mcache_private_hdr_t) + fd_ulong_align_up( depth*sizeof(fd_frag_meta_t), FD_MCACHE_ALIGN );
+  hdr->prod_cnt = prod_cnt;
 
-  hdr->seq[0] = seq0;
+  hdr->seq[0]                     = seq0;
+  hdr->seq[FD_MCACHE_SEQ_MP_NEXT] = seq0;
 
   fd_frag_meta_t * mcache = fd_mcache_private_mcache( hdr );
 
@@ -146,6 +162,11 @@ fd_mcache_app_sz( fd_frag_meta_t const * mcache ) {
   return fd_mcache_private_hdr_const( mcache )->app_sz;
 }
 
+ulong
+fd_mcache_prod_cnt( fd_frag_meta_t const * mcache ) {
+  return fd_mcache_private_hdr_const( mcache )->prod_cnt;
+}
+
 ulong
 fd_mcache_seq0( fd_frag_meta_t const * mcache ) {
   return fd_mcache_private_hdr_const( mcache )->seq0;
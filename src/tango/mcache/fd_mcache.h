@@ -27,6 +27,13 @@
 
 #define FD_MCACHE_SEQ_CNT (16UL)
 
+/* FD_MCACHE_SEQ_MP_NEXT is the index in the mcache's seq storage region
+   of the next sequence number to be claimed by the producers of a
+   multi-producer mcache (see fd_mcache_mp_claim below).  It is on a
+   different cache line than seq[0]. */
+
+#define FD_MCACHE_SEQ_MP_NEXT (8UL)
+
 /* FD_MCACHE_{LG_BLOCK,LG_INTERLEAVE,BLOCK} specifies how recent
    fragment meta data should be packed into mcaches.  LG_BLOCK should be
    in [1,64).  LG_INTERLEAVE should be in [0,FD_MCACHE_BLOCK).  BLOCK ==
@@ -92,6 +99,18 @@ fd_mcache_new( void * shmem,
                ulong  app_sz,
                ulong  seq0 );
 
+/* fd_mcache_new_mp is the same as fd_mcache_new but formats a mcache
+   that will be shared by prod_cnt (positive) producers.  See the
+   multi-producer API below for details.  fd_mcache_new is equivalent
+   to fd_mcache_new_mp with a prod_cnt of 1. */
+
+void *
+fd_mcache_new_mp( void * shmem,
+                  ulong  depth,
+                  ulong  app_sz,
+                  ulong  seq0,
+                  ulong  prod_cnt );
+
 /* fd_mcache_join joins the caller to the mcache.  shmcache points to
    the first byte of the memory region backing the mcache in the
    caller's address space.
@@ -131,12 +150,14 @@ fd_mcache_delete( void * shmcache );
 
 /* Accessor API */
 
-/* fd_mcache_{depth,seq0} return the values corresponding to those use
-   at the mcache's construction.  Assume mcache is a current local join. */
+/* fd_mcache_{depth,app_sz,seq0,prod_cnt} return the values
+   corresponding to those use at the mcache's construction.  Assume
+   mcache is a current local join. */
 
-FD_FN_PURE ulong fd_mcache_depth ( fd_frag_meta_t const * mcache );
-FD_FN_PURE ulong fd_mcache_app_sz( fd_frag_meta_t const * mcache );
-FD_FN_PURE ulong fd_mcache_seq0  ( fd_frag_meta_t const * mcache );
+FD_FN_PURE ulong fd_mcache_depth   ( fd_frag_meta_t const * mcache );
+FD_FN_PURE ulong fd_mcache_app_sz  ( fd_frag_meta_t const * mcache );
+FD_FN_PURE ulong fd_mcache_seq0    ( fd_frag_meta_t const * mcache );
+FD_FN_PURE ulong fd_mcache_prod_cnt( fd_frag_meta_t const * mcache );
 
 /* fd_mcache_seq_laddr returns location in the caller's local address
    space of mcache's sequence array.  This array is indexed
@@ -730,6 +751,121 @@ fd_mcache_publish_avx( fd_frag_meta_t * mcache,   /* Assumed a current local joi
 
 #endif
 
+/* Multi-producer API
+
+   A mcache with a prod_cnt larger than 1 is shared by multiple
+   producers, typically to fan-in many producers (e.g. verify tiles)
+   into a single consumer (e.g. a dedup tile) without the consumer
+   having to poll one mcache per producer.  Consumers of such a mcache
+   are exactly the same as for a single producer mcache (e.g. they wait
+   for sequence numbers in order with FD_MCACHE_WAIT and return flow
+   control credits with an fseq).
+
+   Producers claim sequence numbers atomically from the shared counter
+   at seq[FD_MCACHE_SEQ_MP_NEXT] (e.g. with fd_mcache_mp_claim) and then
+   publish their claimed sequence numbers with any of the
+   fd_mcache_publish variants.  Producers publish concurrently and thus
+   potentially out of order.  This is safe as every claimed sequence
+   number maps to its own line (as long as producers honor flow
+   control) and consumers only act on a line once it holds the exact
+   sequence number they are waiting for.  Note that a producer that
+   claimed a sequence number but has not published it yet (e.g. it was
+   descheduled) stalls consumers at that sequence number, so producers
+   should publish promptly after claiming.
+
+   Flow control works against the shared counter: a producer may only
+   claim sequence number seq if it is less than cons_seq+depth, where
+   cons_seq is the sequence number the slowest reliable consumer is
+   waiting for.  fd_mcache_mp_try_claim enforces this exactly.
+   Producers that cannot tolerate a failed claim (e.g. because they
+   check for credits before preparing a burst of frags) can instead
+   query the available credits with fd_mcache_mp_cr_avail and claim
+   with fd_mcache_mp_claim, treating each other producer's potential
+   burst as consumed (see fd_mcache_mp_cr_avail).
+
+   seq[0] is not maintained by the producers of a multi-producer mcache
+   (no single producer knows a lower bound of what was published).
+   fd_mcache_mp_query gives an upper bound instead.  Claiming requires
+   FD_HAS_ATOMIC. */
+
+/* fd_mcache_mp_next_laddr returns the location in the caller's local
+   address space of the shared claim counter of mcache (i.e.
+   fd_mcache_seq_laddr( mcache )+FD_MCACHE_SEQ_MP_NEXT). */
+
+static inline ulong *
+fd_mcache_mp_next_laddr( fd_frag_meta_t * mcache ) {
+  return fd_mcache_seq_laddr( mcache ) + FD_MCACHE_SEQ_MP_NEXT;
+}
+
+/* fd_mcache_mp_query returns the next sequence number that will be
+   claimed (all sequence numbers before it cyclic have been claimed,
+   but not necessarily published yet). */
+
+static inline ulong
+fd_mcache_mp_query( ulong const * _next ) {
+  FD_COMPILER_MFENCE();
+  ulong next = FD_VOLATILE_CONST( *_next );
+  FD_COMPILER_MFENCE();
+  return next;
+}
+
+#if FD_HAS_ATOMIC
+
+/* fd_mcache_mp_claim atomically claims cnt consecutive sequence numbers
+   and returns the first one.  This does not check flow control.  This
+   acts as a compiler memory fence. */
+
+static inline ulong
+fd_mcache_mp_claim( ulong * _next,
+                    ulong   cnt ) {
+  return FD_ATOMIC_FETCH_AND_ADD( _next, cnt );
+}
+
+/* fd_mcache_mp_try_claim atomically claims cnt consecutive sequence
+   numbers if all of them are before seq_max cyclic (e.g. cons_seq+depth
+   where cons_seq is the sequence number the slowest reliable consumer
+   is waiting for).  On success, returns 1 and the first claimed
+   sequence number is in *_seq.  Returns 0 if the claim would exceed
+   seq_max (the producer is backpressured).  This acts as a compiler
+   memory fence. */
+
+static inline int
+fd_mcache_mp_try_claim( ulong * _next,
+                        ulong   seq_max,
+                        ulong   cnt,
+                        ulong * _seq ) {
+  for(;;) {
+    ulong seq = fd_mcache_mp_query( _next );
+    if( FD_UNLIKELY( fd_seq_gt( fd_seq_inc( seq, cnt ), seq_max ) ) ) return 0;
+    if( FD_LIKELY( FD_ATOMIC_CAS( _next, seq, fd_seq_inc( seq, cnt ) )==seq ) ) {
+      *_seq = seq;
+      return 1;
+    }
+    FD_SPIN_PAUSE();
+  }
+}
+
+#endif /* FD_HAS_ATOMIC */
+
+/* fd_mcache_mp_cr_avail returns the number of sequence numbers a
+   producer can claim with fd_mcache_mp_claim without checking again,
+   given that the shared claim counter is at next, the slowest reliable
+   consumer is waiting for cons_seq (typically a possibly stale
+   observation of its fseq, which only makes the result conservative)
+   and each of the prod_cnt-1 other producers might have up to burst
+   sequence numbers claimed concurrently based on a similar observation.
+   Returns 0 if the producer is backpressured. */
+
+FD_FN_CONST static inline ulong
+fd_mcache_mp_cr_avail( ulong next,
+                       ulong cons_seq,
+                       ulong depth,
+                       ulong prod_cnt,
+                       ulong burst ) {
+  long used = fd_long_max( fd_seq_diff( next, cons_seq ), 0L ) + (long)( (prod_cnt-1UL)*burst );
+  return (ulong)fd_long_max( (long)depth - used, 0L );
+}
+
 /* fd_mcache_query returns seq_query if seq_query is still in the mcache
    (assumed to be a current local mcache join) with depth entries (depth
    is assumed to be an integer power of two of at least
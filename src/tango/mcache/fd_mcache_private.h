@@ -20,6 +20,7 @@ struct __attribute__((aligned(FD_MCACHE_ALIGN))) fd_mcache_private_hdr {
   ulong app_sz;  /* Size of the application region in bytes */
   ulong seq0;    /* Initial sequence number passed on creation */
   ulong app_off; /* Location of the application region relative to the first byte of the header */
+  ulong prod_cnt; /* Number of producers sharing the mcache, 1 for a single producer mcache */
 
   /* Padding to FD_MCACHE_ALIGN here (lots of room for additional static data here) */
 
@@ -58,6 +58,7 @@ main( int     argc,
   FD_TEST( fd_mcache_new( NULL,      depth, app_sz, seq0 )==NULL ); /* null shmem */
   FD_TEST( fd_mcache_new( shmem+1UL, depth, app_sz, seq0 )==NULL ); /* misaligned shmem */
   FD_TEST( fd_mcache_new( shmem,     0,     app_sz, seq0 )==NULL ); /* zero depth */
+  FD_TEST( fd_mcache_new_mp( shmem, depth, app_sz, seq0, 0UL )==NULL ); /* zero prod_cnt */
 
   /* Test mcache creation */
 
@@ -85,9 +86,10 @@ main( int     argc,
 
   /* Test mcache accessors */
 
-  FD_TEST( fd_mcache_depth ( mcache )==depth  );
-  FD_TEST( fd_mcache_app_sz( mcache )==app_sz );
-  FD_TEST( fd_mcache_seq0  ( mcache )==seq0   );
+  FD_TEST( fd_mcache_depth   ( mcache )==depth  );
+  FD_TEST( fd_mcache_app_sz  ( mcache )==app_sz );
+  FD_TEST( fd_mcache_seq0    ( mcache )==seq0   );
+  FD_TEST( fd_mcache_prod_cnt( mcache )==1UL    );
 
   ulong const * _seq_const = fd_mcache_seq_laddr_const( mcache );
   ulong       * _seq       = fd_mcache_seq_laddr      ( mcache );
@@ -102,7 +104,7 @@ main( int     argc,
   /* Test mcache initial state */
 
   FD_TEST( fd_mcache_seq_query( _seq_const )==seq0 );
-  for( ulong idx=1UL; idx<FD_MCACHE_SEQ_CNT; idx++ ) FD_TEST( !_seq[idx] );
+  for( ulong idx=1UL; idx<FD_MCACHE_SEQ_CNT; idx++ ) FD_TEST( _seq[idx]==fd_ulong_if( idx==FD_MCACHE_SEQ_MP_NEXT, seq0, 0UL ) );
 
   uchar * p = _app;
   for( ulong rem=app_sz; rem; rem-- ) { FD_TEST( !*p ); *p = (uchar)'a'; p++; }
@@ -200,7 +202,7 @@ main( int     argc,
   FD_TEST( fd_mcache_app_laddr_const( mcache )==_app_const );
   FD_TEST( fd_mcache_app_laddr      ( mcache )==_app       );
 
-  for( ulong idx=1UL; idx<FD_MCACHE_SEQ_CNT; idx++ ) FD_TEST( !_seq[idx] );
+  for( ulong idx=1UL; idx<FD_MCACHE_SEQ_CNT; idx++ ) FD_TEST( _seq[idx]==fd_ulong_if( idx==FD_MCACHE_SEQ_MP_NEXT, seq0, 0UL ) );
 
   uchar const * q = _app_const;
   for( ulong rem=app_sz; rem; rem-- ) { FD_TEST( (*q)==(uchar)'a' ); q++; }
@@ -221,6 +223,69 @@ main( int     argc,
 
   FD_TEST( fd_mcache_delete( shmcache )==shmem );
 
+# if FD_HAS_ATOMIC
+
+  /* Test multi-producer mcache */
+
+  ulong prod_cnt = 4UL;
+  shmcache = fd_mcache_new_mp( shmem, depth, app_sz, seq0, prod_cnt ); FD_TEST( shmcache );
+  mcache   = fd_mcache_join( shmcache );                               FD_TEST( mcache   );
+  FD_TEST( fd_mcache_prod_cnt( mcache )==prod_cnt );
+
+  ulong * _next = fd_mcache_mp_next_laddr( mcache );
+  FD_TEST( _next==fd_mcache_seq_laddr( mcache )+FD_MCACHE_SEQ_MP_NEXT );
+  FD_TEST( fd_mcache_mp_query( _next )==seq0 );
+
+  /* Producers claim bursts up to the flow control limit and publish
+     them in random order.  The consumer should see every sequence
+     number exactly once and in order. */
+
+  static ulong claimed[ DEPTH_MAX ];
+  ulong cons_seq = seq0;
+  ulong seq;
+  for( ulong iter=0UL; iter<10000UL; iter++ ) {
+    ulong seq_max = fd_seq_inc( cons_seq, depth );
+    ulong burst   = 1UL + fd_rng_ulong_roll( rng, 4UL );
+    ulong cnt     = 0UL;
+    while( fd_mcache_mp_try_claim( _next, seq_max, burst, &seq ) ) {
+      for( ulong idx=0UL; idx<burst; idx++ ) claimed[ cnt++ ] = fd_seq_inc( seq, idx );
+    }
+    ulong next = fd_mcache_mp_query( _next );
+    FD_TEST( fd_seq_le( next, seq_max ) ); FD_TEST( fd_seq_gt( fd_seq_inc( next, burst ), seq_max ) );
+    FD_TEST( fd_seq_eq( next, fd_seq_inc( cons_seq, cnt ) ) );
+
+    for( ulong idx=cnt-1UL; idx>0UL && idx<cnt; idx-- ) {
+      ulong swap = fd_rng_ulong_roll( rng, idx+1UL );
+      seq = claimed[ idx ]; claimed[ idx ] = claimed[ swap ]; claimed[ swap ] = seq;
+    }
+
+    for( ulong idx=0UL; idx<cnt; idx++ ) {
+      fd_mcache_publish( mcache, depth, claimed[ idx ], claimed[ idx ], 1UL, 2UL, 3UL, 4UL, 5UL );
+      for(;;) {
+        fd_frag_meta_t const * meta = mcache + fd_mcache_line_idx( cons_seq, depth );
+        if( !fd_seq_eq( meta->seq, cons_seq ) ) { FD_TEST( fd_seq_lt( meta->seq, cons_seq ) ); break; }
+        FD_TEST( meta->sig==cons_seq );
+        cons_seq = fd_seq_inc( cons_seq, 1UL );
+      }
+    }
+    FD_TEST( fd_seq_eq( cons_seq, next ) );
+  }
+
+  seq = fd_mcache_mp_query( _next );
+  FD_TEST( fd_mcache_mp_claim( _next, 3UL )==seq );
+  FD_TEST( fd_mcache_mp_query( _next )==fd_seq_inc( seq, 3UL ) );
+
+  FD_TEST( fd_mcache_mp_cr_avail( fd_seq_inc( seq0, 10UL ), seq0,                      64UL, 1UL, 4UL )==54UL );
+  FD_TEST( fd_mcache_mp_cr_avail( fd_seq_inc( seq0, 10UL ), seq0,                      64UL, 4UL, 4UL )==42UL );
+  FD_TEST( fd_mcache_mp_cr_avail( seq0,                     fd_seq_inc( seq0, 5UL ),   64UL, 4UL, 4UL )==52UL );
+  FD_TEST( fd_mcache_mp_cr_avail( fd_seq_inc( seq0, 60UL ), seq0,                      64UL, 4UL, 4UL )== 0UL );
+  FD_TEST( fd_mcache_mp_cr_avail( fd_seq_inc( seq0, 64UL ), seq0,                      64UL, 1UL, 4UL )== 0UL );
+
+  FD_TEST( fd_mcache_leave( mcache )==shmcache );
+  FD_TEST( fd_mcache_delete( shmcache )==shmem );
+
+# endif
+
   fd_rng_delete( fd_rng_leave( rng ) );
 
   FD_LOG_NOTICE(( "pass" ));
@@ -1,4 +1,4 @@
-$(call add-hdrs,fd_bplus.c fd_deque.c fd_deque_dynamic.c fd_dlist.c fd_heap.c fd_map.c fd_map_chain.c fd_map_dynamic.c fd_map_giant.c fd_map_chain_para.c fd_map_slot_para.c fd_pool.c fd_pool_para.c fd_prq.c fd_queue.c fd_queue_dynamic.c fd_redblack.c fd_set.c fd_set_dynamic.c fd_smallset.c fd_sort.c fd_stack.c fd_treap.c fd_vec.c fd_voff.c)
+$(call add-hdrs,fd_bplus.c fd_deque.c fd_deque_dynamic.c fd_dlist.c fd_heap.c fd_map.c fd_map_chain.c fd_map_dynamic.c fd_map_giant.c fd_map_chain_para.c fd_map_slot_para.c fd_map_swiss.c fd_pool.c fd_pool_para.c fd_prq.c fd_queue.c fd_queue_dynamic.c fd_redblack.c fd_set.c fd_set_dynamic.c fd_smallset.c fd_sort.c fd_sort_radix.c fd_stack.c fd_treap.c fd_vec.c fd_voff.c)
 $(call add-objs,fd_map_util,fd_util)
 $(call make-unit-test,test_bplus,test_bplus,fd_util)
 $(call make-unit-test,test_deque,test_deque,fd_util)
@@ -18,6 +18,8 @@ endif
 $(call make-unit-test,test_map_perfect,test_map_perfect,fd_util)
 $(call make-unit-test,test_map_chain_para,test_map_chain_para,fd_util)
 $(call make-unit-test,test_map_slot_para,test_map_slot_para,fd_util)
+$(call make-unit-test,test_map_swiss,test_map_swiss,fd_util)
+$(call make-unit-test,bench_map_swiss,bench_map_swiss,fd_util)
 $(call make-unit-test,test_pool,test_pool,fd_util)
 $(call make-unit-test,test_pool_para,test_pool_para,fd_util)
 $(call make-unit-test,test_prq,test_prq,fd_util)
@@ -30,6 +32,7 @@ $(call make-unit-test,test_set_dynamic,test_set_dynamic,fd_util)
 $(call make-unit-test,test_smallset,test_smallset,fd_util)
 $(call make-unit-test,test_sort,test_sort,fd_util)
 $(call make-unit-test,test_sort_para,test_sort_para,fd_util)
+$(call make-unit-test,test_sort_radix,test_sort_radix,fd_util)
 $(call make-unit-test,test_stack,test_stack,fd_util)
 $(call make-unit-test,test_treap,test_treap,fd_util)
 $(call make-unit-test,test_vec,test_vec,fd_util)
@@ -48,6 +51,7 @@ $(call run-unit-test,test_map_giant,)
 $(call run-unit-test,test_map_giant_mem,)
 $(call run-unit-test,test_map_chain_para,)
 $(call run-unit-test,test_map_slot_para,)
+$(call run-unit-test,test_map_swiss,)
 # FIXME: MAP_PERFECT?
 $(call run-unit-test,test_pool,)
 $(call run-unit-test,test_pool_para,)
@@ -60,6 +64,7 @@ $(call run-unit-test,test_set,)
 $(call run-unit-test,test_set_dynamic,)
 $(call run-unit-test,test_smallset,)
 $(call run-unit-test,test_sort,)
+$(call run-unit-test,test_sort_radix,)
 $(call run-unit-test,test_stack,)
 $(call run-unit-test,test_treap,)
 $(call run-unit-test,test_vec,)
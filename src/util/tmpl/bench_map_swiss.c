@@ -0,0 +1,292 @@
+#include "../fd_util.h"
+
+/* bench_map_swiss compares fd_map_swiss against fd_map_dynamic and
+   fd_map_slot_para for maps keyed by 32-byte account addresses at
+   various load factors.  For each map and load factor, it measures
+   queries for keys in the map (hit), queries for keys not in the map
+   (miss) and insert / remove churn at a constant key count. */
+
+union bench_key {
+  uchar b [ 32 ];
+  ulong ul[  4 ];
+};
+
+typedef union bench_key bench_key_t;
+
+static bench_key_t const bench_key_null = {0};
+
+static inline int
+bench_key_eq( bench_key_t const * k0,
+              bench_key_t const * k1 ) {
+  return !((k0->ul[0]^k1->ul[0]) | (k0->ul[1]^k1->ul[1]) | (k0->ul[2]^k1->ul[2]) | (k0->ul[3]^k1->ul[3]));
+}
+
+struct swiss_ele {
+  bench_key_t key;
+  ulong       val;
+};
+
+typedef struct swiss_ele swiss_ele_t;
+
+#define MAP_NAME              swiss
+#define MAP_ELE_T             swiss_ele_t
+#define MAP_KEY_T             bench_key_t
+#define MAP_KEY_EQ(k0,k1)     bench_key_eq( (k0), (k1) )
+#define MAP_KEY_HASH(key,s)   fd_ulong_hash( (key)->ul[0] ^ (s) )
+#include "fd_map_swiss.c"
+
+struct dyn_ele {
+  bench_key_t key;
+  ulong       val;
+};
+
+typedef struct dyn_ele dyn_ele_t;
+
+#define MAP_NAME              dyn
+#define MAP_T                 dyn_ele_t
+#define MAP_KEY_T             bench_key_t
+#define MAP_KEY_NULL          bench_key_null
+#define MAP_KEY_EQUAL(k0,k1)  bench_key_eq( &(k0), &(k1) )
+#define MAP_KEY_INVAL(k)      MAP_KEY_EQUAL( (k), MAP_KEY_NULL )
+#define MAP_KEY_EQUAL_IS_SLOW 1
+#define MAP_MEMOIZE           0
+#define MAP_KEY_HASH(key)     ((uint)fd_ulong_hash( (key).ul[0] ))
+#include "fd_map_dynamic.c"
+
+struct para_ele {
+  bench_key_t key;
+  ulong       val;
+  ulong       used;
+};
+
+typedef struct para_ele para_ele_t;
+
+#define MAP_NAME               para
+#define MAP_ELE_T              para_ele_t
+#define MAP_KEY_T              bench_key_t
+#define MAP_KEY_EQ(k0,k1)      bench_key_eq( (k0), (k1) )
+#define MAP_KEY_HASH(key,s)    fd_ulong_hash( (key)->ul[0] ^ (s) )
+#define MAP_ELE_IS_FREE(c,e)   (!(e)->used)
+#define MAP_ELE_FREE(c,e)      (e)->used = 0UL
+#define MAP_ELE_MOVE(c,d,s)    do { para_ele_t * _s = (s); *(d) = *_s; _s->used = 0UL; } while(0)
+#define MAP_IMPL_STYLE         0
+#include "fd_map_slot_para.c"
+
+static void
+bench_log( char const * map,
+           char const * op,
+           double       load,
+           long         dt,
+           ulong        op_cnt,
+           ulong        chk ) {
+  FD_LOG_NOTICE(( "%-10s %-10s load %.3f: %7.2f ns/op (checksum %lu)", map, op, load, (double)dt / (double)op_cnt, chk ));
+}
+
+/* keys[0,key_cnt) are inserted into the map, keys[key_cnt,2 key_cnt)
+   are never inserted until the churn benchmark.  idx holds iter_cnt
+   random indices in [0,key_cnt). */
+
+static void
+bench_swiss( void *              mem,
+             ulong               ele_max,
+             bench_key_t const * keys,
+             ulong               key_cnt,
+             ulong const *       idx,
+             ulong               iter_cnt,
+             double              load ) {
+  swiss_t * map = swiss_join( swiss_new( mem, ele_max, 1234UL ) ); FD_TEST( map );
+
+  long dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<key_cnt; i++ ) swiss_insert( map, keys+i )->val = i;
+  dt += fd_log_wallclock();
+  bench_log( "swiss", "insert", load, dt, key_cnt, swiss_key_cnt( map ) );
+
+  ulong chk = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<iter_cnt; i++ ) chk += swiss_query_const( map, keys + idx[i], NULL )->val;
+  dt += fd_log_wallclock();
+  bench_log( "swiss", "query_hit", load, dt, iter_cnt, chk );
+
+  chk = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<iter_cnt; i++ ) chk += (ulong)!swiss_query_const( map, keys + key_cnt + idx[i], NULL );
+  dt += fd_log_wallclock();
+  bench_log( "swiss", "query_miss", load, dt, iter_cnt, chk );
+
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<iter_cnt; i++ ) {
+    ulong j   = i % key_cnt;
+    ulong old = ((i / key_cnt) & 1UL) * key_cnt; /* Alternate rounds swap keys[j] out for keys[key_cnt+j] and back */
+    swiss_remove( map, swiss_query( map, keys + old + j, NULL ) );
+    swiss_insert( map, keys + key_cnt - old + j )->val = j;
+  }
+  dt += fd_log_wallclock();
+  bench_log( "swiss", "churn", load, dt, iter_cnt, swiss_key_cnt( map ) );
+
+  FD_TEST( !swiss_verify( map ) );
+  FD_TEST( swiss_delete( swiss_leave( map ) )==mem );
+}
+
+static void
+bench_dyn( void *              mem,
+           ulong               ele_max,
+           bench_key_t const * keys,
+           ulong               key_cnt,
+           ulong const *       idx,
+           ulong               iter_cnt,
+           double              load ) {
+  dyn_ele_t * map = dyn_join( dyn_new( mem, fd_ulong_find_msb( ele_max ) ) ); FD_TEST( map );
+
+  long dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<key_cnt; i++ ) dyn_insert( map, keys[i] )->val = i;
+  dt += fd_log_wallclock();
+  bench_log( "dynamic", "insert", load, dt, key_cnt, dyn_key_cnt( map ) );
+
+  ulong chk = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<iter_cnt; i++ ) chk += dyn_query( map, keys[ idx[i] ], NULL )->val;
+  dt += fd_log_wallclock();
+  bench_log( "dynamic", "query_hit", load, dt, iter_cnt, chk );
+
+  chk = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<iter_cnt; i++ ) chk += (ulong)!dyn_query( map, keys[ key_cnt + idx[i] ], NULL );
+  dt += fd_log_wallclock();
+  bench_log( "dynamic", "query_miss", load, dt, iter_cnt, chk );
+
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<iter_cnt; i++ ) {
+    ulong j   = i % key_cnt;
+    ulong old = ((i / key_cnt) & 1UL) * key_cnt;
+    dyn_remove( map, dyn_query( map, keys[ old + j ], NULL ) );
+    dyn_insert( map, keys[ key_cnt - old + j ] )->val = j;
+  }
+  dt += fd_log_wallclock();
+  bench_log( "dynamic", "churn", load, dt, iter_cnt, dyn_key_cnt( map ) );
+
+  FD_TEST( dyn_delete( dyn_leave( map ) )==mem );
+}
+
+static void
+bench_para( void *              mem,
+            void *              ele_mem,
+            ulong               ele_max,
+            bench_key_t const * keys,
+            ulong               key_cnt,
+            ulong const *       idx,
+            ulong               iter_cnt,
+            double              load ) {
+  para_ele_t * ele0 = (para_ele_t *)ele_mem;
+  for( ulong i=0UL; i<ele_max; i++ ) ele0[i].used = 0UL;
+
+  ulong  lock_cnt  = para_lock_cnt_est( ele_max );
+  void * shmap     = para_new( mem, ele_max, lock_cnt, ele_max, 1234UL ); FD_TEST( shmap );
+  para_t join[1];
+  para_t * map     = para_join( join, shmap, ele_mem ); FD_TEST( map );
+  para_query_t query[1];
+
+  long dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<key_cnt; i++ ) {
+    FD_TEST( !para_prepare( map, keys+i, NULL, query, FD_MAP_FLAG_BLOCKING ) );
+    para_ele_t * ele = para_query_ele( query );
+    ele->key = keys[i]; ele->val = i; ele->used = 1UL;
+    para_publish( query );
+  }
+  dt += fd_log_wallclock();
+  bench_log( "slot_para", "insert", load, dt, key_cnt, key_cnt );
+
+  ulong chk = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<iter_cnt; i++ ) {
+    FD_TEST( !para_query_try( map, keys + idx[i], NULL, query, 0 ) );
+    ulong val = para_query_ele_const( query )->val;
+    FD_TEST( !para_query_test( query ) );
+    chk += val;
+  }
+  dt += fd_log_wallclock();
+  bench_log( "slot_para", "query_hit", load, dt, iter_cnt, chk );
+
+  chk = 0UL;
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<iter_cnt; i++ ) chk += (ulong)(para_query_try( map, keys + key_cnt + idx[i], NULL, query, 0 )==FD_MAP_ERR_KEY);
+  dt += fd_log_wallclock();
+  bench_log( "slot_para", "query_miss", load, dt, iter_cnt, chk );
+
+  dt = -fd_log_wallclock();
+  for( ulong i=0UL; i<iter_cnt; i++ ) {
+    ulong j   = i % key_cnt;
+    ulong old = ((i / key_cnt) & 1UL) * key_cnt;
+    FD_TEST( !para_remove( map, keys + old + j, NULL, FD_MAP_FLAG_BLOCKING ) );
+    FD_TEST( !para_prepare( map, keys + key_cnt - old + j, NULL, query, FD_MAP_FLAG_BLOCKING ) );
+    para_ele_t * ele = para_query_ele( query );
+    ele->key = keys[ key_cnt - old + j ]; ele->val = j; ele->used = 1UL;
+    para_publish( query );
+  }
+  dt += fd_log_wallclock();
+  bench_log( "slot_para", "churn", load, dt, iter_cnt, key_cnt );
+
+  FD_TEST( para_leave( map )==join );
+  FD_TEST( para_delete( shmap )==mem );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz    = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",    NULL,      "gigantic" );
+  ulong        page_cnt    = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",   NULL,             1UL );
+  ulong        near_cpu    = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",   NULL, fd_log_cpu_id() );
+  int          lg_ele_max  = fd_env_strip_cmdline_int  ( &argc, &argv, "--lg-ele-max", NULL,              20 );
+  ulong        iter_cnt    = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter",       NULL,       1048576UL );
+  uint         rng_seed    = fd_env_strip_cmdline_uint ( &argc, &argv, "--rng-seed",   NULL,           1234U );
+
+  if( FD_UNLIKELY( lg_ele_max<5 || lg_ele_max>30 ) ) FD_LOG_ERR(( "--lg-ele-max should be in [5,30]" ));
+  if( FD_UNLIKELY( !iter_cnt ) ) FD_LOG_ERR(( "--iter should be positive" ));
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+
+  ulong ele_max = 1UL<<lg_ele_max;
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --near-cpu %lu)", page_cnt, _page_sz, near_cpu ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( fd_shmem_numa_idx( near_cpu ) ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  ulong para_foot = para_footprint( ele_max, para_lock_cnt_est( ele_max ), ele_max );
+  ulong map_foot  = fd_ulong_max( fd_ulong_max( swiss_footprint( ele_max ), dyn_footprint( lg_ele_max ) ), para_foot );
+  ulong map_align = fd_ulong_max( fd_ulong_max( swiss_align(), dyn_align() ), para_align() );
+
+  void *        mem     = fd_wksp_alloc_laddr( wksp, map_align,           map_foot,                         1UL );
+  void *        ele_mem = fd_wksp_alloc_laddr( wksp, alignof(para_ele_t), ele_max*sizeof(para_ele_t),       1UL );
+  bench_key_t * keys    = fd_wksp_alloc_laddr( wksp, alignof(bench_key_t), 2UL*ele_max*sizeof(bench_key_t), 1UL );
+  ulong *       idx     = fd_wksp_alloc_laddr( wksp, alignof(ulong),       iter_cnt*sizeof(ulong),          1UL );
+  if( FD_UNLIKELY( !mem || !ele_mem || !keys || !idx ) ) FD_LOG_ERR(( "workspace too small, increase --page-cnt" ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, rng_seed, 0UL ) );
+
+  for( ulong i=0UL; i<2UL*ele_max; i++ ) for( ulong j=0UL; j<4UL; j++ ) keys[i].ul[j] = fd_rng_ulong( rng );
+
+  static double const load[3] = { 0.5, 0.75, 0.875 };
+  for( ulong l=0UL; l<3UL; l++ ) {
+    ulong key_cnt = (ulong)(load[l]*(double)ele_max);
+    if( l==2UL ) key_cnt--; /* fd_map_dynamic holds at most ele_max-1 keys */
+    for( ulong i=0UL; i<iter_cnt; i++ ) idx[i] = fd_rng_ulong_roll( rng, key_cnt );
+
+    FD_LOG_NOTICE(( "Benchmarking %lu keys in %lu slots (--iter %lu)", key_cnt, ele_max, iter_cnt ));
+    bench_swiss( mem,          ele_max, keys, key_cnt, idx, iter_cnt, load[l] );
+    bench_dyn  ( mem,          ele_max, keys, key_cnt, idx, iter_cnt, load[l] );
+    bench_para ( mem, ele_mem, ele_max, keys, key_cnt, idx, iter_cnt, load[l] );
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_wksp_free_laddr( idx     );
+  fd_wksp_free_laddr( keys    );
+  fd_wksp_free_laddr( ele_mem );
+  fd_wksp_free_laddr( mem     );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
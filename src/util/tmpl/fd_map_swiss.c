@@ -0,0 +1,800 @@
+/* Generate prototypes and inlines for ultra high performance fixed
+   capacity persistent shared maps based on open addressing with SIMD
+   group probing (aka "Swiss tables").  Notably:
+
+   - Each element slot has a one byte control tag that says whether the
+     slot is empty, deleted or full and, if full, holds 7 bits of the
+     key's hash.  Tags are stored contiguously in groups of
+     MAP_GROUP_SZ (16 or 32).  A probe compares the tag of a key
+     against all the tags in a group at once (SSE / AVX when available)
+     and only does a full key comparison on the (typically zero or one)
+     slots whose tags match.  Thus, a query for a large key (e.g. a 32
+     byte account address) typically costs one cache line of tags plus
+     one key compare, even at high fill ratios.
+
+   - A probe starts at the group selected by the key's hash and visits
+     groups in triangular order until it finds a group with an empty
+     slot, so probe sequences stay short at fill ratios up to the
+     maximum of 7/8.
+
+   - Does not require a key sentinel.  The element store is owned by
+     the map and elements can move when tombstones are purged.
+
+   - Optionally (MAP_CONCURRENT), a single writer can modify the map
+     while an arbitrary number of readers query it concurrently with no
+     atomic operations (readers speculatively copy elements out and
+     retry if they raced with a modification).
+
+   A map can be persisted beyond the lifetime of the creating process,
+   be used inter-process, relocated in memory, be naively
+   serialized/deserialized, be moved between hosts, etc.
+
+   Typical usage:
+
+     struct myele {
+       ulong key;  // Technically "MAP_KEY_T MAP_KEY" (default is ulong key)
+       ... key can be located arbitrarily in the element.  The mapping
+       ... of a key to an element in the element store is arbitrary and
+       ... can change while the key is in the map.
+     };
+
+     typedef struct myele myele_t;
+
+     #define MAP_NAME  mymap
+     #define MAP_ELE_T myele_t
+     #include "tmpl/fd_map_swiss.c"
+
+   will declare the following APIs as a header only style library in
+   the compilation unit:
+
+     // A mymap_t is an opaque handle to a join to a mymap.
+
+     typedef struct mymap_private mymap_t;
+
+     // mymap_{align,footprint} returns the alignment and footprint
+     // needed for a memory region to be used as a mymap with space for
+     // ele_max elements.  footprint returns 0 if ele_max is not an
+     // integer power-of-two of at least MAP_GROUP_SZ.  At most
+     // mymap_key_max() (7/8 of ele_max) keys can be in the map at any
+     // time.
+     //
+     // mymap_new formats a memory region with the required alignment
+     // and footprint into a mymap.  seed is an arbitrary value used to
+     // seed the key hash function.  Returns shmem on success and NULL
+     // on failure (logs details).  The map will be empty on return.
+     //
+     // mymap_join joins the caller to a mymap.  Returns a handle to the
+     // caller's join on success and NULL on failure (logs details).
+     //
+     // mymap_leave leaves a current join.  Returns shmap on success and
+     // NULL on failure (logs details).
+     //
+     // mymap_delete unformats a memory region used as a mymap.  Returns
+     // shmem on success and NULL on failure (logs details).
+
+     ulong     mymap_align    ( void );
+     ulong     mymap_footprint( ulong ele_max );
+     void *    mymap_new      ( void * shmem, ulong ele_max, ulong seed );
+     mymap_t * mymap_join     ( void * shmap );
+     void *    mymap_leave    ( mymap_t * join );
+     void *    mymap_delete   ( void * shmap );
+
+     // mymap_{ele_max,key_max,key_cnt,seed} return the element store
+     // capacity, the maximum number of keys, the current number of
+     // keys and the hash seed of a mymap.
+
+     ulong mymap_ele_max( mymap_t const * join );
+     ulong mymap_key_max( mymap_t const * join );
+     ulong mymap_key_cnt( mymap_t const * join );
+     ulong mymap_seed   ( mymap_t const * join );
+
+     // mymap_key_{eq,hash} expose the key comparison and hash
+     // functions used by the map.
+
+     int   mymap_key_eq  ( ulong const * k0, ulong const * k1 );
+     ulong mymap_key_hash( ulong const * key, ulong seed );
+
+     // mymap_ele returns a pointer in the caller's address space to the
+     // element store, indexed [0,ele_max).  mymap_ele_used returns 1 if
+     // element ele_idx holds a key and 0 otherwise.  Together these
+     // allow iterating over the map contents (in arbitrary order).
+
+     myele_t *       mymap_ele      ( mymap_t *       join );
+     myele_t const * mymap_ele_const( mymap_t const * join );
+     int             mymap_ele_used ( mymap_t const * join, ulong ele_idx );
+
+     // mymap_hint prefetches the control group a probe for key starts
+     // with.  Useful for overlapping the cache misses of a batch of
+     // queries.
+
+     void mymap_hint( mymap_t const * join, ulong const * key );
+
+     // mymap_insert inserts key into the map.  Returns a pointer to the
+     // element holding key on success and NULL if key is already in
+     // the map or if the map is full.  The caller should not change the
+     // key of the element but is free to initialize the rest of it.
+     // The returned pointer is valid until the next insert or remove.
+     // Removing keys from full groups leaves tombstones behind.  Once
+     // keys and tombstones together use up 15/16 of the slots, the
+     // next insert reclaims the tombstones with an O(ele_max) in place
+     // rehash (amortized O(1) as at least ele_max/16 removes happen
+     // between rehashes).
+
+     myele_t * mymap_insert( mymap_t * join, ulong const * key );
+
+     // mymap_remove removes the element pointed to by ele (which must
+     // hold a key currently in the map) from the map.
+
+     void mymap_remove( mymap_t * join, myele_t * ele );
+
+     // mymap_query returns a pointer to the element holding key, or
+     // sentinel if key is not in the map.  The returned pointer is
+     // valid until the next insert or remove.
+
+     myele_t *       mymap_query      ( mymap_t *       join, ulong const * key, myele_t *       sentinel );
+     myele_t const * mymap_query_const( mymap_t const * join, ulong const * key, myele_t const * sentinel );
+
+     // mymap_reset removes all keys from the map.
+
+     void mymap_reset( mymap_t * join );
+
+     // mymap_verify returns 0 if the map seems valid and -1 otherwise
+     // (logs details).
+
+     int mymap_verify( mymap_t const * join );
+
+   If MAP_CONCURRENT is non-zero, all the above modifying operations
+   (insert, remove, reset and any modification of an element returned
+   by insert or query) must be done by a single writer (or be otherwise
+   serialized by the caller), and insert and remove bracket their
+   changes with a version number so that other threads can query the
+   map concurrently.  insert makes the key visible to readers before
+   the caller initializes the rest of the element, so the caller must
+   wrap the insert and the initialization in modify_{begin,end}:
+
+     mymap_modify_begin( map );
+     myele_t * ele = mymap_insert( map, &key );
+     if( ele ) ele->val = val;
+     mymap_modify_end( map );
+
+   Readers query with:
+
+     // mymap_query_try copies the element holding key into *ele and
+     // returns FD_MAP_SUCCESS.  Returns FD_MAP_ERR_KEY if key is not in
+     // the map and FD_MAP_ERR_AGAIN if the query raced with a
+     // modification (*ele is clobbered and the caller should retry).
+
+     int mymap_query_try( mymap_t const * join, ulong const * key, myele_t * ele );
+
+     // mymap_modify_{begin,end} bracket modifications of an element in
+     // place by the writer so that concurrent query_try see either the
+     // old or new element.  Brackets nest, so they can enclose insert,
+     // remove and reset.
+
+     void mymap_modify_begin( mymap_t * join );
+     void mymap_modify_end  ( mymap_t * join );
+
+   You can do this as often as you like in a compilation unit to get
+   different types of maps.  Since it is all static inline, it is fine
+   to do this in a header too. */
+
+#include "fd_map.h"
+#include "../bits/fd_bits.h"
+#include "../log/fd_log.h" /* Used by constructors and verify */
+
+#if FD_HAS_SSE
+#include "../simd/fd_sse.h"
+#endif
+#if FD_HAS_AVX
+#include "../simd/fd_avx.h"
+#endif
+
+/* MAP_NAME gives the API prefix to use for map */
+
+#ifndef MAP_NAME
+#error "Define MAP_NAME"
+#endif
+
+/* MAP_ELE_T is the map element type. */
+
+#ifndef MAP_ELE_T
+#error "Define MAP_ELE_T"
+#endif
+
+/* MAP_KEY_T is the map key type */
+
+#ifndef MAP_KEY_T
+#define MAP_KEY_T ulong
+#endif
+
+/* MAP_KEY is the MAP_ELE_T key field */
+
+#ifndef MAP_KEY
+#define MAP_KEY key
+#endif
+
+/* MAP_KEY_EQ returns 0/1 if *k0 is the same/different as *k1 */
+
+#ifndef MAP_KEY_EQ
+#define MAP_KEY_EQ(k0,k1) ((*(k0))==(*(k1)))
+#endif
+
+/* MAP_KEY_HASH returns a random mapping of *key into ulong.  The
+   mapping is parameterized by the 64-bit ulong seed.  The low 7 bits
+   are used as the key's tag and the remaining bits select the group
+   the probe starts at, so all bits should be of good quality. */
+
+#ifndef MAP_KEY_HASH
+#define MAP_KEY_HASH(key,seed) fd_ulong_hash( (*(key)) ^ (seed) )
+#endif
+
+/* MAP_KEY_MOVE moves the user provided key *ks into the element key kd
+   on insert.  Defaults to shallow copy. */
+
+#ifndef MAP_KEY_MOVE
+#define MAP_KEY_MOVE(kd,ks) (kd) = *(ks)
+#endif
+
+/* MAP_ELE_MOVE moves the contents of element *s into element *d when
+   tombstones are purged.  Defaults to shallow copy. */
+
+#ifndef MAP_ELE_MOVE
+#define MAP_ELE_MOVE(d,s) (*(d)) = (*(s))
+#endif
+
+/* MAP_GROUP_SZ is the number of control tags probed at once.  Should
+   be 16 (one SSE register) or 32 (one AVX register).  Portable code
+   is used on targets without the corresponding vector extension. */
+
+#ifndef MAP_GROUP_SZ
+#define MAP_GROUP_SZ 16
+#endif
+
+/* MAP_CONCURRENT enables concurrent queries by readers while a single
+   writer modifies the map (see above). */
+
+#ifndef MAP_CONCURRENT
+#define MAP_CONCURRENT 0
+#endif
+
+/* MAP_MAGIC is the magic number to use for the structure to aid in
+   persistent and/or IPC usage. */
+
+#ifndef MAP_MAGIC
+#define MAP_MAGIC (0xf17eda2c375a1550UL) /* firedancer swiss version 0 */
+#endif
+
+#if (MAP_GROUP_SZ!=16) && (MAP_GROUP_SZ!=32)
+#error "MAP_GROUP_SZ should be 16 or 32"
+#endif
+
+/* Implementation *****************************************************/
+
+#define MAP_(n) FD_EXPAND_THEN_CONCAT3(MAP_NAME,_,n)
+
+/* Control tags.  Full slots hold the low 7 bits of their key's hash, so
+   empty and deleted slots are exactly the ones with the high bit set. */
+
+#define MAP_CTRL_EMPTY   ((uchar)0x80)
+#define MAP_CTRL_DELETED ((uchar)0xfe)
+
+struct __attribute__((aligned(128))) MAP_(private) {
+  ulong magic;       /* == MAP_MAGIC */
+  ulong ele_max;     /* Element store capacity, power of 2, at least MAP_GROUP_SZ */
+  ulong group_mask;  /* == ele_max/MAP_GROUP_SZ - 1 */
+  ulong key_max;     /* == ele_max - ele_max/8 */
+  ulong used_max;    /* == ele_max - ele_max/16, max key_cnt + tomb_cnt */
+  ulong seed;        /* Key hash seed */
+  ulong key_cnt;     /* Number of full slots */
+  ulong tomb_cnt;    /* Number of deleted slots */
+  ulong version;     /* Odd while the writer is modifying the map (MAP_CONCURRENT) */
+  ulong write_depth; /* Nesting depth of writer modifications (MAP_CONCURRENT) */
+
+  /* Padding to 128 alignment here */
+
+  /* uchar     ctrl[ ele_max ] here, MAP_GROUP_SZ aligned
+     MAP_ELE_T ele [ ele_max ] here */
+};
+
+typedef struct MAP_(private) MAP_(t);
+
+FD_PROTOTYPES_BEGIN
+
+/* Private APIs *******************************************************/
+
+FD_FN_CONST static inline ulong
+MAP_(private_ele_off)( ulong ele_max ) {
+  return fd_ulong_align_up( sizeof(MAP_(t)) + ele_max, alignof(MAP_ELE_T) );
+}
+
+FD_FN_CONST static inline uchar *
+MAP_(private_ctrl)( MAP_(t) * map ) {
+  return (uchar *)(map+1);
+}
+
+FD_FN_CONST static inline uchar const *
+MAP_(private_ctrl_const)( MAP_(t) const * map ) {
+  return (uchar const *)(map+1);
+}
+
+FD_FN_PURE static inline MAP_ELE_T *
+MAP_(private_ele)( MAP_(t) * map ) {
+  return (MAP_ELE_T *)((ulong)map + MAP_(private_ele_off)( map->ele_max ));
+}
+
+FD_FN_PURE static inline MAP_ELE_T const *
+MAP_(private_ele_const)( MAP_(t) const * map ) {
+  return (MAP_ELE_T const *)((ulong)map + MAP_(private_ele_off)( map->ele_max ));
+}
+
+/* private_match returns a bit mask with bit i set if tag i of the group
+   starting at g (MAP_GROUP_SZ aligned) is equal to tag.  private_free
+   returns a bit mask of the group's empty and deleted slots. */
+
+#if MAP_GROUP_SZ==16 && FD_HAS_SSE
+
+FD_FN_PURE static inline uint
+MAP_(private_match)( uchar const * g,
+                     uchar         tag ) {
+  return (uint)_mm_movemask_epi8( vb_eq( vb_ld( g ), vb_bcast( tag ) ) );
+}
+
+FD_FN_PURE static inline uint
+MAP_(private_free)( uchar const * g ) {
+  return (uint)_mm_movemask_epi8( vb_ld( g ) );
+}
+
+#elif MAP_GROUP_SZ==32 && FD_HAS_AVX
+
+FD_FN_PURE static inline uint
+MAP_(private_match)( uchar const * g,
+                     uchar         tag ) {
+  return (uint)_mm256_movemask_epi8( wb_eq( wb_ld( g ), wb_bcast( tag ) ) );
+}
+
+FD_FN_PURE static inline uint
+MAP_(private_free)( uchar const * g ) {
+  return (uint)_mm256_movemask_epi8( wb_ld( g ) );
+}
+
+#else
+
+FD_FN_PURE static inline uint
+MAP_(private_match)( uchar const * g,
+                     uchar         tag ) {
+  uint m = 0U;
+  for( ulong i=0UL; i<MAP_GROUP_SZ; i++ ) m |= ((uint)(g[i]==tag)) << i;
+  return m;
+}
+
+FD_FN_PURE static inline uint
+MAP_(private_free)( uchar const * g ) {
+  uint m = 0U;
+  for( ulong i=0UL; i<MAP_GROUP_SZ; i++ ) m |= ((uint)(g[i]>>7)) << i;
+  return m;
+}
+
+#endif
+
+FD_FN_PURE static inline uint
+MAP_(private_empty)( uchar const * g ) {
+  return MAP_(private_match)( g, MAP_CTRL_EMPTY );
+}
+
+FD_FN_CONST static inline uchar MAP_(private_tag)  ( ulong hash                   ) { return (uchar)(hash & 0x7fUL);   }
+FD_FN_CONST static inline ulong MAP_(private_group)( ulong hash, ulong group_mask ) { return (hash >> 7) & group_mask; }
+
+/* private_find returns the index of the slot holding key (with the
+   given hash) or ULONG_MAX if key is not in the map.  Groups are
+   probed in triangular order (start, start+1, start+3, start+6, ...),
+   which visits every group when the number of groups is a power of 2.
+   Since at least ele_max/16 slots are always empty, the probe always
+   finds an empty slot eventually. */
+
+FD_FN_PURE static inline ulong
+MAP_(private_find)( MAP_(t) const *   map,
+                    MAP_KEY_T const * key,
+                    ulong             hash ) {
+  uchar const *     ctrl       = MAP_(private_ctrl_const)( map );
+  MAP_ELE_T const * ele        = MAP_(private_ele_const)( map );
+  ulong             group_mask = map->group_mask;
+  uchar             tag        = MAP_(private_tag)( hash );
+  ulong             group      = MAP_(private_group)( hash, group_mask );
+  for( ulong probe=1UL; probe<=group_mask+1UL; probe++ ) {
+    uchar const * g = ctrl + group*MAP_GROUP_SZ;
+    for( uint m=MAP_(private_match)( g, tag ); m; m &= m-1U ) {
+      ulong slot = group*MAP_GROUP_SZ + (ulong)fd_uint_find_lsb( m );
+      if( FD_LIKELY( MAP_KEY_EQ( &ele[ slot ].MAP_KEY, key ) ) ) return slot;
+    }
+    if( FD_LIKELY( MAP_(private_empty)( g ) ) ) break;
+    group = (group + probe) & group_mask;
+  }
+  return ULONG_MAX;
+}
+
+/* private_find_free returns the index of the first empty or deleted
+   slot on the probe sequence for hash. */
+
+FD_FN_PURE static inline ulong
+MAP_(private_find_free)( MAP_(t) const * map,
+                         ulong           hash ) {
+  uchar const * ctrl       = MAP_(private_ctrl_const)( map );
+  ulong         group_mask = map->group_mask;
+  ulong         group      = MAP_(private_group)( hash, group_mask );
+  for( ulong probe=1UL;; probe++ ) {
+    uint m = MAP_(private_free)( ctrl + group*MAP_GROUP_SZ );
+    if( FD_LIKELY( m ) ) return group*MAP_GROUP_SZ + (ulong)fd_uint_find_lsb( m );
+    group = (group + probe) & group_mask;
+  }
+}
+
+static inline void
+MAP_(private_write_begin)( MAP_(t) * map ) {
+# if MAP_CONCURRENT
+  if( map->write_depth++ ) return;
+  FD_VOLATILE( map->version ) = map->version + 1UL;
+  FD_COMPILER_MFENCE();
+# else
+  (void)map;
+# endif
+}
+
+static inline void
+MAP_(private_write_end)( MAP_(t) * map ) {
+# if MAP_CONCURRENT
+  if( --map->write_depth ) return;
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( map->version ) = map->version + 1UL;
+# else
+  (void)map;
+# endif
+}
+
+/* private_purge drops all tombstones from the map, rehashing elements
+   in place.  Every full slot is first marked deleted (and every deleted
+   slot empty).  Then, each element still marked deleted is moved to the
+   first free slot on its probe sequence: if that slot is in the
+   element's current group, it stays put; if it is empty, the element
+   moves there; otherwise the slot holds another element yet to be
+   rehashed, which is swapped in and processed next.  O(ele_max). */
+
+FD_FN_UNUSED static void /* Work around -Winline */
+MAP_(private_purge)( MAP_(t) * map ) {
+  uchar *     ctrl    = MAP_(private_ctrl)( map );
+  MAP_ELE_T * ele     = MAP_(private_ele)( map );
+  ulong       ele_max = map->ele_max;
+  ulong       seed    = map->seed;
+
+  for( ulong slot=0UL; slot<ele_max; slot++ ) ctrl[ slot ] = (ctrl[ slot ] & 0x80) ? MAP_CTRL_EMPTY : MAP_CTRL_DELETED;
+
+  for( ulong slot=0UL; slot<ele_max; slot++ ) {
+    if( ctrl[ slot ]!=MAP_CTRL_DELETED ) continue;
+
+    ulong hash = MAP_KEY_HASH( &ele[ slot ].MAP_KEY, seed );
+    uchar tag  = MAP_(private_tag)( hash );
+    ulong dst  = MAP_(private_find_free)( map, hash );
+
+    if( dst/MAP_GROUP_SZ==slot/MAP_GROUP_SZ ) {
+      ctrl[ slot ] = tag;
+    } else if( ctrl[ dst ]==MAP_CTRL_EMPTY ) {
+      MAP_ELE_MOVE( ele+dst, ele+slot );
+      ctrl[ dst  ] = tag;
+      ctrl[ slot ] = MAP_CTRL_EMPTY;
+    } else {
+      MAP_ELE_T tmp[1];
+      MAP_ELE_MOVE( tmp,      ele+dst  );
+      MAP_ELE_MOVE( ele+dst,  ele+slot );
+      MAP_ELE_MOVE( ele+slot, tmp      );
+      ctrl[ dst ] = tag;
+      slot--; /* Process the element swapped into slot (wraps to ULONG_MAX at 0, which is fine) */
+    }
+  }
+
+  map->tomb_cnt = 0UL;
+}
+
+/* Public APIs ********************************************************/
+
+FD_FN_CONST static inline ulong
+MAP_(align)( void ) {
+  return fd_ulong_max( alignof(MAP_(t)), alignof(MAP_ELE_T) );
+}
+
+FD_FN_CONST static inline ulong
+MAP_(footprint)( ulong ele_max ) {
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( ele_max ) || ele_max<MAP_GROUP_SZ ) ) return 0UL;
+  ulong ele_off = MAP_(private_ele_off)( ele_max );
+  if( FD_UNLIKELY( ele_max > (ULONG_MAX - ele_off - MAP_(align)()) / sizeof(MAP_ELE_T) ) ) return 0UL;
+  return fd_ulong_align_up( ele_off + ele_max*sizeof(MAP_ELE_T), MAP_(align)() );
+}
+
+FD_FN_PURE static inline ulong MAP_(ele_max)( MAP_(t) const * join ) { return join->ele_max; }
+FD_FN_PURE static inline ulong MAP_(key_max)( MAP_(t) const * join ) { return join->key_max; }
+FD_FN_PURE static inline ulong MAP_(key_cnt)( MAP_(t) const * join ) { return join->key_cnt; }
+FD_FN_PURE static inline ulong MAP_(seed)   ( MAP_(t) const * join ) { return join->seed;    }
+
+FD_FN_PURE static inline MAP_ELE_T *       MAP_(ele)      ( MAP_(t) *       join ) { return MAP_(private_ele)      ( join ); }
+FD_FN_PURE static inline MAP_ELE_T const * MAP_(ele_const)( MAP_(t) const * join ) { return MAP_(private_ele_const)( join ); }
+
+FD_FN_PURE static inline int
+MAP_(ele_used)( MAP_(t) const * join,
+                ulong           ele_idx ) {
+  return !(MAP_(private_ctrl_const)( join )[ ele_idx ] & 0x80);
+}
+
+FD_FN_PURE static inline int
+MAP_(key_eq)( MAP_KEY_T const * k0,
+              MAP_KEY_T const * k1 ) {
+  return !!(MAP_KEY_EQ( (k0), (k1) ));
+}
+
+FD_FN_PURE static inline ulong
+MAP_(key_hash)( MAP_KEY_T const * key,
+                ulong             seed ) {
+  return (MAP_KEY_HASH( (key), (seed) ));
+}
+
+static inline void *
+MAP_(new)( void * shmem,
+           ulong  ele_max,
+           ulong  seed ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, MAP_(align)() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !MAP_(footprint)( ele_max ) ) ) {
+    FD_LOG_WARNING(( "ele_max must be a power of 2 of at least %lu", (ulong)MAP_GROUP_SZ ));
+    return NULL;
+  }
+
+  MAP_(t) * map = (MAP_(t) *)shmem;
+
+  map->ele_max     = ele_max;
+  map->group_mask  = ele_max/MAP_GROUP_SZ - 1UL;
+  map->key_max     = ele_max - ele_max/8UL;
+  map->used_max    = ele_max - ele_max/16UL;
+  map->seed        = seed;
+  map->key_cnt     = 0UL;
+  map->tomb_cnt    = 0UL;
+  map->version     = 0UL;
+  map->write_depth = 0UL;
+
+  fd_memset( MAP_(private_ctrl)( map ), MAP_CTRL_EMPTY, ele_max );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( map->magic ) = MAP_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+static inline MAP_(t) *
+MAP_(join)( void * shmap ) {
+  MAP_(t) * map = (MAP_(t) *)shmap;
+
+  if( FD_UNLIKELY( !map ) ) {
+    FD_LOG_WARNING(( "NULL shmap" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)map, MAP_(align)() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmap" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( map->magic!=MAP_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return map;
+}
+
+static inline void *
+MAP_(leave)( MAP_(t) * join ) {
+  if( FD_UNLIKELY( !join ) ) {
+    FD_LOG_WARNING(( "NULL join" ));
+    return NULL;
+  }
+  return (void *)join;
+}
+
+static inline void *
+MAP_(delete)( void * shmap ) {
+  MAP_(t) * map = (MAP_(t) *)shmap;
+
+  if( FD_UNLIKELY( !map ) ) {
+    FD_LOG_WARNING(( "NULL shmap" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)map, MAP_(align)() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmap" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( map->magic!=MAP_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( map->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shmap;
+}
+
+static inline void
+MAP_(hint)( MAP_(t) const *   join,
+            MAP_KEY_T const * key ) {
+  ulong hash = MAP_(key_hash)( key, join->seed );
+  __builtin_prefetch( MAP_(private_ctrl_const)( join ) + MAP_(private_group)( hash, join->group_mask )*MAP_GROUP_SZ );
+}
+
+FD_FN_PURE static inline MAP_ELE_T *
+MAP_(query)( MAP_(t) *         join,
+             MAP_KEY_T const * key,
+             MAP_ELE_T *       sentinel ) {
+  ulong slot = MAP_(private_find)( join, key, MAP_(key_hash)( key, join->seed ) );
+  return FD_LIKELY( slot!=ULONG_MAX ) ? MAP_(private_ele)( join ) + slot : sentinel;
+}
+
+FD_FN_PURE static inline MAP_ELE_T const *
+MAP_(query_const)( MAP_(t) const *   join,
+                   MAP_KEY_T const * key,
+                   MAP_ELE_T const * sentinel ) {
+  ulong slot = MAP_(private_find)( join, key, MAP_(key_hash)( key, join->seed ) );
+  return FD_LIKELY( slot!=ULONG_MAX ) ? MAP_(private_ele_const)( join ) + slot : sentinel;
+}
+
+FD_FN_UNUSED static MAP_ELE_T * /* Work around -Winline */
+MAP_(insert)( MAP_(t) *         join,
+              MAP_KEY_T const * key ) {
+  ulong hash = MAP_(key_hash)( key, join->seed );
+  if( FD_UNLIKELY( MAP_(private_find)( join, key, hash )!=ULONG_MAX ) ) return NULL;
+  if( FD_UNLIKELY( join->key_cnt>=join->key_max ) ) return NULL;
+
+  uchar * ctrl = MAP_(private_ctrl)( join );
+  ulong   slot = MAP_(private_find_free)( join, hash );
+
+  MAP_(private_write_begin)( join );
+
+  /* Filling an empty slot uses up capacity.  If there is none left,
+     it is held by tombstones, which we reclaim. */
+
+  if( FD_UNLIKELY( ctrl[ slot ]==MAP_CTRL_EMPTY && join->key_cnt+join->tomb_cnt>=join->used_max ) ) {
+    MAP_(private_purge)( join );
+    slot = MAP_(private_find_free)( join, hash );
+  }
+
+  join->tomb_cnt -= (ulong)(ctrl[ slot ]==MAP_CTRL_DELETED);
+  join->key_cnt++;
+
+  MAP_ELE_T * ele = MAP_(private_ele)( join ) + slot;
+  MAP_KEY_MOVE( ele->MAP_KEY, key );
+  ctrl[ slot ] = MAP_(private_tag)( hash );
+
+  MAP_(private_write_end)( join );
+
+  return ele;
+}
+
+static inline void
+MAP_(remove)( MAP_(t) *   join,
+              MAP_ELE_T * ele ) {
+  ulong slot = (ulong)(ele - MAP_(private_ele)( join ));
+# if FD_TMPL_USE_HANDHOLDING
+  if( FD_UNLIKELY( slot>=join->ele_max || !MAP_(ele_used)( join, slot ) ) ) FD_LOG_CRIT(( "ele not in map" ));
+# endif
+
+  /* If the slot's group still has an empty slot, it has never been
+     full since it was last empty, so no probe sequence continues past
+     it and the slot can be emptied outright.  Otherwise, probes for
+     keys further along might go through this slot, so it has to become
+     a tombstone. */
+
+  uchar * ctrl  = MAP_(private_ctrl)( join );
+  int     empty = !!MAP_(private_empty)( ctrl + (slot & ~(ulong)(MAP_GROUP_SZ-1)) );
+
+  MAP_(private_write_begin)( join );
+  ctrl[ slot ] = empty ? MAP_CTRL_EMPTY : MAP_CTRL_DELETED;
+  join->tomb_cnt += (ulong)!empty;
+  join->key_cnt--;
+  MAP_(private_write_end)( join );
+}
+
+static inline void
+MAP_(reset)( MAP_(t) * join ) {
+  MAP_(private_write_begin)( join );
+  fd_memset( MAP_(private_ctrl)( join ), MAP_CTRL_EMPTY, join->ele_max );
+  join->key_cnt  = 0UL;
+  join->tomb_cnt = 0UL;
+  MAP_(private_write_end)( join );
+}
+
+#if MAP_CONCURRENT
+
+static inline void MAP_(modify_begin)( MAP_(t) * join ) { MAP_(private_write_begin)( join ); }
+static inline void MAP_(modify_end)  ( MAP_(t) * join ) { MAP_(private_write_end)  ( join ); }
+
+FD_FN_UNUSED static int /* Work around -Winline */
+MAP_(query_try)( MAP_(t) const *   join,
+                 MAP_KEY_T const * key,
+                 MAP_ELE_T *       ele ) {
+  ulong version = FD_VOLATILE_CONST( join->version );
+  if( FD_UNLIKELY( version & 1UL ) ) return FD_MAP_ERR_AGAIN;
+  FD_COMPILER_MFENCE();
+
+  ulong slot = MAP_(private_find)( join, key, MAP_(key_hash)( key, join->seed ) );
+  if( FD_LIKELY( slot!=ULONG_MAX ) ) MAP_ELE_MOVE( ele, MAP_(private_ele_const)( join ) + slot );
+
+  FD_COMPILER_MFENCE();
+  if( FD_UNLIKELY( FD_VOLATILE_CONST( join->version )!=version ) ) return FD_MAP_ERR_AGAIN;
+  return FD_LIKELY( slot!=ULONG_MAX ) ? FD_MAP_SUCCESS : FD_MAP_ERR_KEY;
+}
+
+#endif
+
+FD_FN_UNUSED static int
+MAP_(verify)( MAP_(t) const * join ) {
+
+# define MAP_TEST(c) do {                                                      \
+    if( FD_UNLIKELY( !(c) ) ) { FD_LOG_WARNING(( "FAIL: %s", #c )); return -1; } \
+  } while(0)
+
+  MAP_TEST( join );
+  MAP_TEST( join->magic==MAP_MAGIC );
+  MAP_TEST( fd_ulong_is_pow2( join->ele_max ) && join->ele_max>=MAP_GROUP_SZ );
+  MAP_TEST( join->group_mask==join->ele_max/MAP_GROUP_SZ-1UL );
+  MAP_TEST( join->key_max==join->ele_max-join->ele_max/8UL );
+  MAP_TEST( join->used_max==join->ele_max-join->ele_max/16UL );
+  MAP_TEST( join->key_cnt<=join->key_max );
+  MAP_TEST( join->key_cnt+join->tomb_cnt<=join->used_max );
+
+  uchar const *     ctrl     = MAP_(private_ctrl_const)( join );
+  MAP_ELE_T const * ele      = MAP_(private_ele_const)( join );
+  ulong             key_cnt  = 0UL;
+  ulong             tomb_cnt = 0UL;
+  for( ulong slot=0UL; slot<join->ele_max; slot++ ) {
+    uchar c = ctrl[ slot ];
+    if( c==MAP_CTRL_EMPTY   ) continue;
+    if( c==MAP_CTRL_DELETED ) { tomb_cnt++; continue; }
+    MAP_TEST( !(c & 0x80) );
+    key_cnt++;
+    ulong hash = MAP_(key_hash)( &ele[ slot ].MAP_KEY, join->seed );
+    MAP_TEST( c==MAP_(private_tag)( hash ) );
+    MAP_TEST( MAP_(private_find)( join, &ele[ slot ].MAP_KEY, hash )==slot );
+  }
+  MAP_TEST( key_cnt ==join->key_cnt  );
+  MAP_TEST( tomb_cnt==join->tomb_cnt );
+
+# undef MAP_TEST
+
+  return 0;
+}
+
+FD_PROTOTYPES_END
+
+#undef MAP_CTRL_DELETED
+#undef MAP_CTRL_EMPTY
+#undef MAP_
+
+#undef MAP_MAGIC
+#undef MAP_CONCURRENT
+#undef MAP_GROUP_SZ
+#undef MAP_ELE_MOVE
+#undef MAP_KEY_MOVE
+#undef MAP_KEY_HASH
+#undef MAP_KEY_EQ
+#undef MAP_KEY
+#undef MAP_KEY_T
+#undef MAP_ELE_T
+#undef MAP_NAME
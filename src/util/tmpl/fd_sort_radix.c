@@ -0,0 +1,404 @@
+/* Declares a family of functions for radix sorting POD types keyed by
+   wide fixed width byte strings (e.g. 32-byte pubkeys or (stake,pubkey)
+   tuples) in high performance contexts.  For such keys, a comparison
+   sort spends most of its time in memcmp-like comparisons while a
+   radix sort touches each key byte at most once per element and
+   typically only needs the first few bytes of each key.  Example usage:
+
+     #define SORT_NAME          sort_pubkey
+     #define SORT_KEY_T         fd_pubkey_t
+     #define SORT_RADIX_SZ      32UL
+     #define SORT_RADIX_BYTE(k,i) ((k).uc[(i)])
+     #include "util/tmpl/fd_sort_radix.c"
+
+   will create the following API for use in the local compile unit:
+
+     // Return the alignment and footprint required for a scratch region
+     // adequate for stable sorting up to cnt elements.  (E.g. a
+     // declaration "fd_pubkey_t scratch[ cnt ];" will be fine as a
+     // scratch region.)
+
+     ulong sort_pubkey_stable_scratch_align    ( void      );
+     ulong sort_pubkey_stable_scratch_footprint( ulong cnt );
+
+     // Sort key[i] for i in [0,cnt) stable using scratch as a scratch
+     // region of suitable alignment and footprint in O(N K) worst case
+     // operations (K==SORT_RADIX_SZ).  Returns key.
+
+     fd_pubkey_t *
+     sort_pubkey_stable( fd_pubkey_t * key,
+                         ulong         cnt,
+                         void *        scratch );
+
+     // Sort key[i] for i in [0,cnt) in place (unstable, no scratch) in
+     // O(N K) worst case operations.  Returns key.
+
+     fd_pubkey_t *
+     sort_pubkey_inplace( fd_pubkey_t * key,
+                          ulong         cnt );
+
+     // sort_pubkey_{stable,inplace}_para are the same as above but
+     // parallelized over the caller (typically tpool thread t0) and
+     // tpool threads (t0,t1).  Assumes tpool is valid and tpool threads
+     // (t0,t1) are idle (or soon to be idle).  These are only available
+     // if SORT_PARALLEL was requested.
+
+     fd_pubkey_t *
+     sort_pubkey_stable_para( fd_tpool_t * tpool, ulong t0, ulong t1,
+                              fd_pubkey_t * key,
+                              ulong         cnt,
+                              void *        scratch );
+
+     fd_pubkey_t *
+     sort_pubkey_inplace_para( fd_tpool_t * tpool, ulong t0, ulong t1,
+                               fd_pubkey_t * key,
+                               ulong         cnt );
+
+   Keys are ordered lexicographically by their radix bytes
+   SORT_RADIX_BYTE(k,0), SORT_RADIX_BYTE(k,1), ... (i.e. byte 0 is the
+   most significant).  Descending orders, big integers, tuples, etc are
+   expressed through SORT_RADIX_BYTE (e.g. use ~byte to sort
+   descending).
+
+   The implementation is a most significant digit first radix sort.
+   Each pass histograms one byte of a range of keys and scatters the
+   keys into 256 buckets (out of place into the scratch for stable
+   sorts, by cycle leader permutation for in place sorts), then
+   recurses into the buckets.  A pass is skipped outright when all keys
+   in the range share the byte (e.g. the zero high bytes of small
+   integers) and buckets with at most SORT_RADIX_THRESH keys are
+   finished with an insertion sort.  Thus, cnt uniform random pubkeys
+   are typically sorted with ~log_256(cnt) scatter passes.
+
+   It is fine to include this template multiple times in a compilation
+   unit.  Just provide the specification before each inclusion. */
+
+/* SORT_NAME gives the name of the function to declare (and the base
+   name of auxiliary and/or variant functions). */
+
+#ifndef SORT_NAME
+#error "SORT_NAME must be defined"
+#endif
+
+/* SORT_KEY_T gives the POD datatype to sort. */
+
+#ifndef SORT_KEY_T
+#error "SORT_KEY_T must be defined"
+#endif
+
+/* SORT_RADIX_SZ gives the number of radix bytes in a key. */
+
+#ifndef SORT_RADIX_SZ
+#error "SORT_RADIX_SZ must be defined"
+#endif
+
+/* SORT_RADIX_BYTE(k,i) returns radix byte i in [0,SORT_RADIX_SZ) of
+   key k as a uchar.  Byte 0 is the most significant. */
+
+#ifndef SORT_RADIX_BYTE
+#error "SORT_RADIX_BYTE must be defined"
+#endif
+
+/* SORT_BEFORE(a,b) evaluates to 1 if a<b is strictly true.  Used by the
+   insertion sort that finishes small buckets.  Should be consistent
+   with SORT_RADIX_BYTE.  Defaults to comparing the radix bytes but
+   applications often can provide something faster (e.g. memcmp). */
+
+#ifndef SORT_BEFORE
+#define SORT_BEFORE(a,b) SORT_(private_before)( &(a), &(b) )
+#endif
+
+/* SORT_RADIX_THRESH gives the largest bucket size where insertion sort
+   will be used.  Should be at least 1. */
+
+#ifndef SORT_RADIX_THRESH
+#define SORT_RADIX_THRESH 32UL
+#endif
+
+/* SORT_PARALLEL will generate thread parallel versions of the sorts.
+   Requires tpool. */
+
+#ifndef SORT_PARALLEL
+#define SORT_PARALLEL 0
+#endif
+
+/* Implementation *****************************************************/
+
+#define SORT_(x)FD_EXPAND_THEN_CONCAT3(SORT_NAME,_,x)
+
+#if SORT_PARALLEL
+#include "../tpool/fd_tpool.h"
+#else
+#include "../bits/fd_bits.h"
+#endif
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST static inline ulong SORT_(stable_scratch_align)    ( void )      { return alignof(SORT_KEY_T); }
+FD_FN_CONST static inline ulong SORT_(stable_scratch_footprint)( ulong cnt ) { return sizeof (SORT_KEY_T)*cnt; }
+
+FD_FN_PURE FD_FN_UNUSED static int
+SORT_(private_before)( SORT_KEY_T const * a,
+                       SORT_KEY_T const * b ) {
+  for( ulong i=0UL; i<(ulong)(SORT_RADIX_SZ); i++ ) {
+    uint ai = (uint)(uchar)SORT_RADIX_BYTE( *a, i );
+    uint bi = (uint)(uchar)SORT_RADIX_BYTE( *b, i );
+    if( ai!=bi ) return ai<bi;
+  }
+  return 0;
+}
+
+/* private_insert stable sorts key[i] for i in [0,cnt) in place. */
+
+static inline void
+SORT_(private_insert)( SORT_KEY_T * key,
+                       ulong        cnt ) {
+  for( ulong i=1UL; i<cnt; i++ ) {
+    SORT_KEY_T k = key[i];
+    ulong      j = i;
+    for( ; j && (SORT_BEFORE( k, key[j-1UL] )); j-- ) key[j] = key[j-1UL];
+    key[j] = k;
+  }
+}
+
+/* private_hist computes the histogram of radix byte d over key[i] for
+   i in [0,cnt) into off[b] and returns 1 if all keys share the same
+   byte (0 otherwise).  Byte extraction from arbitrary key layouts does
+   not vectorize but counting into 4 interleaved sub-histograms breaks
+   the store to load dependency chains between consecutive keys with
+   the same byte (common for skewed keys like stakes). */
+
+FD_FN_UNUSED static int /* Work around -Winline */
+SORT_(private_hist)( SORT_KEY_T const * key,
+                     ulong              cnt,
+                     ulong              d,
+                     ulong *            off ) {
+  ulong hist[ 4 ][ 256 ];
+  memset( hist, 0, sizeof(hist) );
+
+  ulong i = 0UL;
+  for( ; i+4UL<=cnt; i+=4UL ) {
+    hist[0][ (uchar)SORT_RADIX_BYTE( key[i    ], d ) ]++;
+    hist[1][ (uchar)SORT_RADIX_BYTE( key[i+1UL], d ) ]++;
+    hist[2][ (uchar)SORT_RADIX_BYTE( key[i+2UL], d ) ]++;
+    hist[3][ (uchar)SORT_RADIX_BYTE( key[i+3UL], d ) ]++;
+  }
+  for( ; i<cnt; i++ ) hist[0][ (uchar)SORT_RADIX_BYTE( key[i], d ) ]++;
+
+  for( ulong b=0UL; b<256UL; b++ ) off[b] = hist[0][b] + hist[1][b] + hist[2][b] + hist[3][b];
+
+  return off[ (uchar)SORT_RADIX_BYTE( key[0], d ) ]==cnt;
+}
+
+/* private_scan converts the histogram in off[0,256) into bucket
+   offsets in off[0,257). */
+
+static inline void
+SORT_(private_scan)( ulong * off,
+                     ulong   cnt ) {
+  ulong sum = 0UL;
+  for( ulong i=0UL; i<256UL; i++ ) { ulong c = off[i]; off[i] = sum; sum += c; }
+  off[256] = cnt;
+}
+
+/* private_scatter stable copies the keys at a into their radix byte d
+   buckets at b. */
+
+static inline void
+SORT_(private_scatter)( SORT_KEY_T const * a,
+                        SORT_KEY_T *       b,
+                        ulong              d,
+                        ulong const *      off ) {
+  ulong head[ 256 ];
+  memcpy( head, off, 256UL*sizeof(ulong) );
+  ulong cnt = off[256];
+  for( ulong i=0UL; i<cnt; i++ ) b[ head[ (uchar)SORT_RADIX_BYTE( a[i], d ) ]++ ] = a[i];
+}
+
+/* private_permute moves the keys at key into their radix byte d
+   buckets in place by following cycles: take the first misplaced key
+   of bucket i, swap it into the next open slot of its own bucket, and
+   so on until a key for bucket i comes back. */
+
+static inline void
+SORT_(private_permute)( SORT_KEY_T *  key,
+                        ulong         d,
+                        ulong const * off ) {
+  ulong head[ 256 ];
+  memcpy( head, off, 256UL*sizeof(ulong) );
+  for( ulong i=0UL; i<256UL; i++ ) {
+    ulong tail = off[i+1UL];
+    while( head[i]<tail ) {
+      SORT_KEY_T k = key[ head[i] ];
+      ulong      j = (uchar)SORT_RADIX_BYTE( k, d );
+      while( j!=i ) {
+        SORT_KEY_T t = key[ head[j] ];
+        key[ head[j]++ ] = k;
+        k = t;
+        j = (uchar)SORT_RADIX_BYTE( k, d );
+      }
+      key[ head[i]++ ] = k;
+    }
+  }
+}
+
+/* private_stable sorts the cnt keys at a, which share their first d
+   radix bytes, stable.  b is a scratch region of cnt keys.  On return,
+   the sorted keys are at a if to_a is non-zero and at b otherwise. */
+
+FD_FN_UNUSED static void
+SORT_(private_stable)( SORT_KEY_T * a,
+                       SORT_KEY_T * b,
+                       ulong        cnt,
+                       ulong        d,
+                       int          to_a ) {
+  ulong off[ 257 ];
+  for(;;) {
+    if( cnt<=(ulong)(SORT_RADIX_THRESH) || d>=(ulong)(SORT_RADIX_SZ) ) {
+      SORT_(private_insert)( a, cnt );
+      if( !to_a ) memcpy( b, a, cnt*sizeof(SORT_KEY_T) );
+      return;
+    }
+    if( !SORT_(private_hist)( a, cnt, d, off ) ) break;
+    d++; /* All keys share byte d */
+  }
+
+  SORT_(private_scan)( off, cnt );
+  SORT_(private_scatter)( a, b, d, off );
+
+  for( ulong i=0UL; i<256UL; i++ ) {
+    ulong bucket_cnt = off[i+1UL] - off[i];
+    if( bucket_cnt ) SORT_(private_stable)( b + off[i], a + off[i], bucket_cnt, d+1UL, !to_a );
+  }
+}
+
+/* private_inplace sorts the cnt keys at key, which share their first d
+   radix bytes, in place. */
+
+FD_FN_UNUSED static void
+SORT_(private_inplace)( SORT_KEY_T * key,
+                        ulong        cnt,
+                        ulong        d ) {
+  ulong off[ 257 ];
+  for(;;) {
+    if( cnt<=(ulong)(SORT_RADIX_THRESH) || d>=(ulong)(SORT_RADIX_SZ) ) {
+      SORT_(private_insert)( key, cnt );
+      return;
+    }
+    if( !SORT_(private_hist)( key, cnt, d, off ) ) break;
+    d++;
+  }
+
+  SORT_(private_scan)( off, cnt );
+  SORT_(private_permute)( key, d, off );
+
+  for( ulong i=0UL; i<256UL; i++ ) {
+    ulong bucket_cnt = off[i+1UL] - off[i];
+    if( bucket_cnt>1UL ) SORT_(private_inplace)( key + off[i], bucket_cnt, d+1UL );
+  }
+}
+
+static inline SORT_KEY_T *
+SORT_(stable)( SORT_KEY_T * key,
+               ulong        cnt,
+               void *       scratch ) {
+  if( FD_UNLIKELY( cnt<2UL ) ) return key;
+  SORT_(private_stable)( key, (SORT_KEY_T *)scratch, cnt, 0UL, 1 );
+  return key;
+}
+
+static inline SORT_KEY_T *
+SORT_(inplace)( SORT_KEY_T * key,
+                ulong        cnt ) {
+  if( FD_UNLIKELY( cnt<2UL ) ) return key;
+  SORT_(private_inplace)( key, cnt, 0UL );
+  return key;
+}
+
+#if SORT_PARALLEL
+
+/* The parallel sorts do the first distinguishing pass on the caller
+   and then sort the resulting buckets in parallel.  Buckets are
+   assigned to threads by partitioning the key index range: the thread
+   processing index block [i0,i1) sorts the buckets that start in it. */
+
+static FD_FOR_ALL_BEGIN( SORT_(private_bucket_para), 1L ) {
+  SORT_KEY_T *  key     = (SORT_KEY_T *) arg[0];
+  SORT_KEY_T *  scratch = (SORT_KEY_T *) arg[1];
+  ulong const * off     = (ulong const *)arg[2];
+  ulong         d       =                arg[3];
+
+  for( ulong i=0UL; i<256UL; i++ ) {
+    ulong i0 = off[i];
+    ulong n  = off[i+1UL] - i0;
+    if( (long)i0<block_i0 || (long)i0>=block_i1 || !n ) continue;
+    if( scratch ) SORT_(private_stable)( scratch + i0, key + i0, n, d, 0 );
+    else if( n>1UL ) SORT_(private_inplace)( key + i0, n, d );
+  }
+} FD_FOR_ALL_END
+
+/* private_para_split finds the first radix byte d (starting at d0) that
+   distinguishes keys and fills off with its bucket offsets.  Returns
+   SORT_RADIX_SZ if all keys are equal. */
+
+FD_FN_UNUSED static ulong
+SORT_(private_para_split)( SORT_KEY_T const * key,
+                           ulong              cnt,
+                           ulong *            off ) {
+  ulong d = 0UL;
+  for( ; d<(ulong)(SORT_RADIX_SZ); d++ ) if( !SORT_(private_hist)( key, cnt, d, off ) ) break;
+  if( d<(ulong)(SORT_RADIX_SZ) ) SORT_(private_scan)( off, cnt );
+  return d;
+}
+
+static inline SORT_KEY_T *
+SORT_(stable_para)( fd_tpool_t * tpool,
+                    ulong        t0,
+                    ulong        t1,
+                    SORT_KEY_T * key,
+                    ulong        cnt,
+                    void *       scratch ) {
+  if( t1-t0<2UL || cnt<=(ulong)(SORT_RADIX_THRESH) ) return SORT_(stable)( key, cnt, scratch );
+
+  ulong off[ 257 ];
+  ulong d = SORT_(private_para_split)( key, cnt, off );
+  if( FD_UNLIKELY( d>=(ulong)(SORT_RADIX_SZ) ) ) return key;
+
+  SORT_KEY_T * tmp = (SORT_KEY_T *)scratch;
+  SORT_(private_scatter)( key, tmp, d, off );
+
+  FD_FOR_ALL( SORT_(private_bucket_para), tpool,t0,t1, 0L,(long)cnt, key, tmp, off, d+1UL );
+  return key;
+}
+
+static inline SORT_KEY_T *
+SORT_(inplace_para)( fd_tpool_t * tpool,
+                     ulong        t0,
+                     ulong        t1,
+                     SORT_KEY_T * key,
+                     ulong        cnt ) {
+  if( t1-t0<2UL || cnt<=(ulong)(SORT_RADIX_THRESH) ) return SORT_(inplace)( key, cnt );
+
+  ulong off[ 257 ];
+  ulong d = SORT_(private_para_split)( key, cnt, off );
+  if( FD_UNLIKELY( d>=(ulong)(SORT_RADIX_SZ) ) ) return key;
+
+  SORT_(private_permute)( key, d, off );
+
+  FD_FOR_ALL( SORT_(private_bucket_para), tpool,t0,t1, 0L,(long)cnt, key, NULL, off, d+1UL );
+  return key;
+}
+
+#endif /* SORT_PARALLEL */
+
+FD_PROTOTYPES_END
+
+#undef SORT_
+
+#undef SORT_PARALLEL
+#undef SORT_RADIX_THRESH
+#undef SORT_BEFORE
+#undef SORT_RADIX_BYTE
+#undef SORT_RADIX_SZ
+#undef SORT_KEY_T
+#undef SORT_NAME
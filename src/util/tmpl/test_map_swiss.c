@@ -0,0 +1,181 @@
+#include "../fd_util.h"
+
+struct myele {
+  ulong mykey;
+  uint  val;
+};
+
+typedef struct myele myele_t;
+
+/* Note: macros are deliberately written sloppy (generator should be
+   robust against this) */
+
+#define MAP_NAME          mymap
+#define MAP_ELE_T         myele_t
+#define MAP_KEY           mykey
+#define MAP_KEY_HASH(k,s) fd_ulong_hash( s ^ *k )
+#define MAP_KEY_EQ(k0,k1) *k0==*k1
+#include "fd_map_swiss.c"
+
+/* Deliberately terrible hash so probe sequences get long and groups
+   fill up, exercising tombstones and purges */
+
+#define MAP_NAME          badmap
+#define MAP_ELE_T         myele_t
+#define MAP_KEY           mykey
+#define MAP_KEY_HASH(k,s) ((*k)*0x9e3779b97f4a7c15UL ^ (s)) & 0x3ffUL
+#define MAP_GROUP_SZ      32
+#define MAP_CONCURRENT    1
+#include "fd_map_swiss.c"
+
+FD_STATIC_ASSERT( FD_MAP_SUCCESS  == 0, unit_test );
+FD_STATIC_ASSERT( FD_MAP_ERR_AGAIN==-2, unit_test );
+FD_STATIC_ASSERT( FD_MAP_ERR_KEY  ==-6, unit_test );
+
+#define ELE_MAX (1024UL)
+#define KEY_MAX (2UL*ELE_MAX)
+
+static uchar shmem [ 131072 ] __attribute__((aligned(128)));
+static uint  ref   [ KEY_MAX ]; /* 0 if key not in map, val otherwise */
+
+#define TEST_MAP(map_) do {                                                                     \
+    FD_TEST( map_##_align()==128UL );                                                            \
+    FD_TEST( !map_##_footprint( 0UL            ) );                                              \
+    FD_TEST( !map_##_footprint( 8UL            ) );                                              \
+    FD_TEST( !map_##_footprint( ELE_MAX+1UL    ) );                                              \
+    FD_TEST( !map_##_footprint( 1UL<<63        ) );                                              \
+    ulong footprint = map_##_footprint( ELE_MAX );                                               \
+    FD_TEST( footprint && footprint<=sizeof(shmem) );                                            \
+                                                                                                 \
+    FD_TEST( !map_##_new( NULL,     ELE_MAX, 0UL ) );                                            \
+    FD_TEST( !map_##_new( shmem+1,  ELE_MAX, 0UL ) );                                            \
+    FD_TEST( !map_##_new( shmem,    3UL,     0UL ) );                                            \
+    ulong seed = fd_rng_ulong( rng );                                                            \
+    void * shmap = map_##_new( shmem, ELE_MAX, seed ); FD_TEST( shmap==shmem );                  \
+                                                                                                 \
+    FD_TEST( !map_##_join( NULL    ) );                                                          \
+    FD_TEST( !map_##_join( shmem+1 ) );                                                          \
+    map_##_t * map = map_##_join( shmap ); FD_TEST( map );                                       \
+                                                                                                 \
+    FD_TEST( map_##_ele_max( map )==ELE_MAX                   );                                 \
+    FD_TEST( map_##_key_max( map )==ELE_MAX - ELE_MAX/8UL     );                                 \
+    FD_TEST( map_##_key_cnt( map )==0UL                       );                                 \
+    FD_TEST( map_##_seed   ( map )==seed                      );                                 \
+    FD_TEST( !map_##_verify( map ) );                                                            \
+                                                                                                 \
+    fd_memset( ref, 0, sizeof(ref) );                                                            \
+    ulong key_cnt = 0UL;                                                                         \
+    myele_t sentinel[1];                                                                         \
+    for( ulong iter=0UL; iter<(1UL<<20); iter++ ) {                                              \
+      ulong key = fd_rng_ulong_roll( rng, KEY_MAX );                                             \
+      uint  r   = fd_rng_uint( rng );                                                            \
+      map_##_hint( map, &key );                                                                  \
+      myele_t * ele = map_##_query( map, &key, sentinel );                                       \
+      FD_TEST( (ele!=sentinel)==(!!ref[ key ]) );                                                \
+      FD_TEST( map_##_query_const( map, &key, sentinel )==ele );                                 \
+      if( ele!=sentinel ) {                                                                      \
+        FD_TEST( ele->mykey==key && ele->val==ref[ key ] );                                      \
+        FD_TEST( !map_##_insert( map, &key ) );                                                  \
+        if( r & 1U ) { map_##_remove( map, ele ); ref[ key ] = 0U; key_cnt--; }                  \
+      } else {                                                                                   \
+        ele = map_##_insert( map, &key );                                                        \
+        if( key_cnt<map_##_key_max( map ) ) {                                                    \
+          FD_TEST( ele && ele->mykey==key );                                                     \
+          ele->val = r | 1U; ref[ key ] = r | 1U; key_cnt++;                                     \
+        } else {                                                                                 \
+          FD_TEST( !ele );                                                                       \
+        }                                                                                        \
+      }                                                                                          \
+      FD_TEST( map_##_key_cnt( map )==key_cnt );                                                 \
+      if( FD_UNLIKELY( !(iter & 0xffffUL) ) ) {                                                  \
+        FD_TEST( !map_##_verify( map ) );                                                        \
+        ulong used_cnt = 0UL;                                                                    \
+        myele_t const * ele0 = map_##_ele_const( map );                                          \
+        for( ulong idx=0UL; idx<ELE_MAX; idx++ ) {                                               \
+          if( !map_##_ele_used( map, idx ) ) continue;                                           \
+          FD_TEST( ref[ ele0[ idx ].mykey ]==ele0[ idx ].val );                                  \
+          used_cnt++;                                                                            \
+        }                                                                                        \
+        FD_TEST( used_cnt==key_cnt );                                                            \
+      }                                                                                          \
+    }                                                                                            \
+                                                                                                 \
+    /* Fill to capacity and drain */                                                             \
+                                                                                                 \
+    for( ulong key=0UL; key<KEY_MAX; key++ ) {                                                   \
+      if( ref[ key ] ) continue;                                                                 \
+      myele_t * ele = map_##_insert( map, &key );                                                \
+      if( key_cnt<map_##_key_max( map ) ) { FD_TEST( ele ); ele->val = 1U; ref[ key ] = 1U; key_cnt++; } \
+      else                                  FD_TEST( !ele );                                     \
+    }                                                                                            \
+    FD_TEST( map_##_key_cnt( map )==map_##_key_max( map ) );                                     \
+    FD_TEST( !map_##_verify( map ) );                                                            \
+    for( ulong key=0UL; key<KEY_MAX; key++ ) {                                                   \
+      myele_t * ele = map_##_query( map, &key, NULL );                                           \
+      FD_TEST( (!!ele)==(!!ref[ key ]) );                                                        \
+      if( ele ) { map_##_remove( map, ele ); ref[ key ] = 0U; }                                  \
+    }                                                                                            \
+    FD_TEST( !map_##_key_cnt( map ) );                                                           \
+    FD_TEST( !map_##_verify( map ) );                                                            \
+                                                                                                 \
+    ulong key = 1UL;                                                                             \
+    FD_TEST( map_##_insert( map, &key ) );                                                       \
+    map_##_reset( map );                                                                         \
+    FD_TEST( !map_##_key_cnt( map ) );                                                           \
+    FD_TEST( !map_##_query( map, &key, NULL ) );                                                 \
+    FD_TEST( !map_##_verify( map ) );                                                            \
+                                                                                                 \
+    FD_TEST( !map_##_leave( NULL ) );                                                            \
+    FD_TEST( map_##_leave( map )==shmap );                                                       \
+    FD_TEST( !map_##_delete( NULL    ) );                                                        \
+    FD_TEST( !map_##_delete( shmem+1 ) );                                                        \
+    FD_TEST( map_##_delete( shmap )==shmem );                                                    \
+    FD_TEST( !map_##_join  ( shmap ) );                                                          \
+    FD_TEST( !map_##_delete( shmap ) );                                                          \
+  } while(0)
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_LOG_NOTICE(( "Testing group size 16" ));
+  TEST_MAP( mymap );
+
+  FD_LOG_NOTICE(( "Testing group size 32 (concurrent, colliding hashes)" ));
+  TEST_MAP( badmap );
+
+  /* query_try */
+
+  badmap_t * map = badmap_join( badmap_new( shmem, ELE_MAX, 0UL ) ); FD_TEST( map );
+  myele_t ele[1];
+  for( ulong key=0UL; key<64UL; key++ ) {
+    badmap_modify_begin( map );
+    badmap_insert( map, &key )->val = (uint)key + 1U;
+    FD_TEST( badmap_query_try( map, &key, ele )==FD_MAP_ERR_AGAIN ); /* not visible before init */
+    badmap_modify_end( map );
+  }
+
+  for( ulong key=0UL; key<128UL; key++ ) {
+    int err = badmap_query_try( map, &key, ele );
+    if( key<64UL ) { FD_TEST( err==FD_MAP_SUCCESS ); FD_TEST( ele->mykey==key && ele->val==(uint)key + 1U ); }
+    else             FD_TEST( err==FD_MAP_ERR_KEY );
+  }
+
+  ulong key = 3UL;
+  badmap_modify_begin( map );
+  FD_TEST( badmap_query_try( map, &key, ele )==FD_MAP_ERR_AGAIN );
+  badmap_query( map, &key, NULL )->val = 42U;
+  badmap_modify_end( map );
+  FD_TEST( badmap_query_try( map, &key, ele )==FD_MAP_SUCCESS && ele->val==42U );
+
+  FD_TEST( badmap_delete( badmap_leave( map ) )==shmem );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
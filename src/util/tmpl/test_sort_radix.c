@@ -0,0 +1,167 @@
+#include "../fd_util.h"
+
+/* Elements mimic stake weights: a 32-byte pubkey and a stake, sorted by
+   stake descending then pubkey descending (like the leader schedule and
+   turbine orders) or by pubkey ascending.  idx records the original
+   position to check stability. */
+
+struct myele {
+  uchar key[ 32 ];
+  ulong stake;
+  ulong idx;
+};
+
+typedef struct myele myele_t;
+
+#define STAKE_BEFORE(a,b) ((a).stake>(b).stake ? 1 : ((a).stake<(b).stake ? 0 : memcmp( (a).key, (b).key, 32UL )>0))
+#define KEY_BEFORE(a,b)   (memcmp( (a).key, (b).key, 32UL )<0)
+
+#define STAKE_BYTE(e,i) ((uchar)~((i)<8UL ? (uchar)((e).stake >> (56UL-8UL*(i))) : (e).key[(i)-8UL]))
+
+#define SORT_NAME        ref_stake
+#define SORT_KEY_T       myele_t
+#define SORT_BEFORE(a,b) STAKE_BEFORE(a,b)
+#include "fd_sort.c"
+
+#define SORT_NAME        ref_key
+#define SORT_KEY_T       myele_t
+#define SORT_BEFORE(a,b) KEY_BEFORE(a,b)
+#include "fd_sort.c"
+
+#define SORT_NAME          radix_stake
+#define SORT_KEY_T         myele_t
+#define SORT_RADIX_SZ      40UL
+#define SORT_RADIX_BYTE(e,i) STAKE_BYTE(e,i)
+#define SORT_BEFORE(a,b)   STAKE_BEFORE(a,b)
+#define SORT_PARALLEL      1
+#include "fd_sort_radix.c"
+
+/* Default SORT_BEFORE and tiny threshold to get deep recursion */
+
+#define SORT_NAME          radix_key
+#define SORT_KEY_T         myele_t
+#define SORT_RADIX_SZ      32UL
+#define SORT_RADIX_BYTE(e,i) ((e).key[(i)])
+#define SORT_RADIX_THRESH  1UL
+#define SORT_PARALLEL      1
+#include "fd_sort_radix.c"
+
+#define MAX (16384UL)
+
+static myele_t src[ MAX ];
+static myele_t ref[ MAX ];
+static myele_t tst[ MAX ];
+static myele_t tmp[ MAX ];
+
+/* gen fills src with cnt elements.  style 0 is uniform random, 1 is
+   keys sharing long prefixes with a handful of distinct stakes and 2
+   has many exact duplicates. */
+
+static void
+gen( fd_rng_t * rng,
+     ulong      cnt,
+     int        style ) {
+  for( ulong i=0UL; i<cnt; i++ ) {
+    myele_t * e = src + i;
+    for( ulong j=0UL; j<32UL; j++ ) e->key[j] = fd_rng_uchar( rng );
+    e->stake = fd_rng_ulong( rng ) >> fd_rng_uint_roll( rng, 64U );
+    e->idx   = i;
+    if( style==1 ) {
+      memset( e->key, 0x5a, 24UL );
+      e->key[24] = (uchar)fd_rng_uint_roll( rng, 4U );
+      e->stake   = 1000000UL * fd_rng_ulong_roll( rng, 8UL );
+    } else if( style==2 ) {
+      memset( e->key, 0, 32UL );
+      e->key[ fd_rng_uint_roll( rng, 32U ) ] = (uchar)fd_rng_uint_roll( rng, 3U );
+      e->stake = fd_rng_ulong_roll( rng, 3UL );
+    }
+  }
+}
+
+/* same returns 1 if a and b hold the same sort keys (including the
+   original positions if stable) */
+
+static int
+same( myele_t const * a,
+      myele_t const * b,
+      ulong           cnt,
+      int             by_stake,
+      int             stable ) {
+  for( ulong i=0UL; i<cnt; i++ ) {
+    if( memcmp( a[i].key, b[i].key, 32UL ) ) return 0;
+    if( by_stake && a[i].stake!=b[i].stake ) return 0;
+    if( stable   && a[i].idx  !=b[i].idx   ) return 0;
+  }
+  return 1;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong iter_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-max", NULL, 1000UL );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  ulong thread_cnt = fd_tile_cnt();
+  static uchar _tpool[ FD_TPOOL_FOOTPRINT( FD_TILE_MAX ) ] __attribute__((aligned(FD_TPOOL_ALIGN)));
+  fd_tpool_t * tpool = fd_tpool_init( _tpool, thread_cnt, 0UL ); FD_TEST( tpool );
+  for( ulong thread_idx=1UL; thread_idx<thread_cnt; thread_idx++ ) FD_TEST( fd_tpool_worker_push( tpool, thread_idx ) );
+
+  FD_TEST( radix_key_stable_scratch_align()==alignof(myele_t) );
+  FD_TEST( radix_key_stable_scratch_footprint( 3UL )==3UL*sizeof(myele_t) );
+
+  FD_LOG_NOTICE(( "Testing (--iter-max %lu, %lu threads)", iter_max, thread_cnt ));
+
+  for( ulong iter=0UL; iter<iter_max; iter++ ) {
+    ulong cnt   = fd_rng_ulong_roll( rng, (iter & 1UL) ? MAX+1UL : 129UL );
+    int   style = (int)fd_rng_uint_roll( rng, 3U );
+    ulong t0    = 0UL;
+    ulong t1    = 1UL + fd_rng_ulong_roll( rng, thread_cnt );
+    gen( rng, cnt, style );
+
+    memcpy( ref, src, cnt*sizeof(myele_t) ); ref_stake_stable( ref, cnt, tmp );
+
+    memcpy( tst, src, cnt*sizeof(myele_t) );
+    FD_TEST( radix_stake_stable( tst, cnt, tmp )==tst && same( tst, ref, cnt, 1, 1 ) );
+    memcpy( tst, src, cnt*sizeof(myele_t) );
+    FD_TEST( radix_stake_inplace( tst, cnt )==tst && same( tst, ref, cnt, 1, 0 ) );
+    memcpy( tst, src, cnt*sizeof(myele_t) );
+    FD_TEST( radix_stake_stable_para( tpool,t0,t1, tst, cnt, tmp )==tst && same( tst, ref, cnt, 1, 1 ) );
+    memcpy( tst, src, cnt*sizeof(myele_t) );
+    FD_TEST( radix_stake_inplace_para( tpool,t0,t1, tst, cnt )==tst && same( tst, ref, cnt, 1, 0 ) );
+
+    memcpy( ref, src, cnt*sizeof(myele_t) ); ref_key_stable( ref, cnt, tmp );
+
+    memcpy( tst, src, cnt*sizeof(myele_t) );
+    FD_TEST( radix_key_stable( tst, cnt, tmp )==tst && same( tst, ref, cnt, 0, 1 ) );
+    memcpy( tst, src, cnt*sizeof(myele_t) );
+    FD_TEST( radix_key_inplace( tst, cnt )==tst && same( tst, ref, cnt, 0, 0 ) );
+    memcpy( tst, src, cnt*sizeof(myele_t) );
+    FD_TEST( radix_key_stable_para( tpool,t0,t1, tst, cnt, tmp )==tst && same( tst, ref, cnt, 0, 1 ) );
+    memcpy( tst, src, cnt*sizeof(myele_t) );
+    FD_TEST( radix_key_inplace_para( tpool,t0,t1, tst, cnt )==tst && same( tst, ref, cnt, 0, 0 ) );
+  }
+
+  /* Compare against the comparison sorts for stake weights */
+
+  gen( rng, MAX, 0 );
+  long dt_ref = 0L; long dt_stable = 0L; long dt_inplace = 0L;
+  for( ulong rep=0UL; rep<16UL; rep++ ) {
+    memcpy( tst, src, MAX*sizeof(myele_t) ); dt_ref     -= fd_log_wallclock(); ref_stake_inplace  ( tst, MAX      ); dt_ref     += fd_log_wallclock();
+    memcpy( tst, src, MAX*sizeof(myele_t) ); dt_stable  -= fd_log_wallclock(); radix_stake_stable ( tst, MAX, tmp ); dt_stable  += fd_log_wallclock();
+    memcpy( tst, src, MAX*sizeof(myele_t) ); dt_inplace -= fd_log_wallclock(); radix_stake_inplace( tst, MAX      ); dt_inplace += fd_log_wallclock();
+  }
+  double norm = 1. / (16.*(double)MAX);
+  FD_LOG_NOTICE(( "stake weights (%lu): quick %.1f ns/ele, radix stable %.1f ns/ele, radix inplace %.1f ns/ele",
+                  MAX, (double)dt_ref*norm, (double)dt_stable*norm, (double)dt_inplace*norm ));
+
+  for( ulong thread_idx=1UL; thread_idx<thread_cnt; thread_idx++ ) FD_TEST( fd_tpool_worker_pop( tpool ) );
+  fd_tpool_fini( tpool );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -19,6 +19,7 @@ $(call make-unit-test,test_http_server,test_http_server,fd_waltz fd_ballet fd_ut
 $(call run-unit-test,test_http_server)
 
 $(call make-unit-test,test_live_http_server,test_live_http_server,fd_waltz fd_ballet fd_util)
+$(call make-unit-test,bench_http_server,bench_http_server,fd_waltz fd_ballet fd_util)
 
 $(call make-fuzz-test,fuzz_picohttpparser,fuzz_picohttpparser,fd_waltz fd_util)
 $(call make-fuzz-test,fuzz_httpserver,fuzz_httpserver,fd_waltz fd_ballet fd_util)
@@ -0,0 +1,219 @@
+#define _GNU_SOURCE
+#include "fd_http_server.h"
+#include "../../util/fd_util.h"
+#include "../../util/net/fd_ip4.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+/* bench_http_server runs an HTTP server and a load generator in this
+   process over loopback.  It opens --conn-cnt client connections, and
+   then measures
+
+     - the cost of fd_http_server_poll while all of them are idle, which
+       should not depend on --conn-cnt, and
+     - the throughput of --active-cnt of them each sending --pipeline-cnt
+       keep-alive requests back to back, for --round-cnt rounds.
+
+   --conn-cnt is clamped to what RLIMIT_NOFILE allows (each connection
+   takes a client and a server file descriptor), so it might be
+   necessary to raise it (ulimit -n) to bench 100k connections. */
+
+static char const expected_response[] =
+  "HTTP/1.1 200 OK\r\nContent-Length: 5\r\nContent-Type: text/plain\r\n\r\nhello";
+
+static char const request_keep_alive[] = "GET /hello HTTP/1.1\r\nHost: localhost\r\n\r\n";
+static char const request_close[]      = "GET /hello HTTP/1.0\r\nHost: localhost\r\n\r\n";
+
+static fd_http_server_t * http;
+
+static fd_http_server_response_t
+request( fd_http_server_request_t const * request ) {
+  (void)request;
+  fd_http_server_printf( http, "hello" );
+  fd_http_server_response_t response = {
+    .status       = 200,
+    .content_type = "text/plain",
+  };
+  FD_TEST( !fd_http_server_stage_body( http, &response ) );
+  return response;
+}
+
+static ulong close_cnt;
+
+static void
+http_close( ulong  conn_id,
+            int    reason,
+            void * ctx ) {
+  (void)conn_id; (void)ctx;
+  if( FD_UNLIKELY( reason!=FD_HTTP_SERVER_CONNECTION_CLOSE_OK ) )
+    FD_LOG_ERR(( "unexpected close (%s)", fd_http_server_connection_close_reason_str( reason ) ));
+  close_cnt++;
+}
+
+static int
+client_connect( ushort port ) {
+  int fd = socket( AF_INET, SOCK_STREAM|SOCK_CLOEXEC, 0 );
+  if( FD_UNLIKELY( -1==fd ) ) FD_LOG_ERR(( "socket failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  struct sockaddr_in addr = {
+    .sin_family      = AF_INET,
+    .sin_port        = fd_ushort_bswap( port ),
+    .sin_addr.s_addr = FD_IP4_ADDR( 127, 0, 0, 1 ),
+  };
+  if( FD_UNLIKELY( -1==connect( fd, fd_type_pun( &addr ), sizeof(addr) ) ) )
+    FD_LOG_ERR(( "connect failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  return fd;
+}
+
+static void
+client_send( int          fd,
+             char const * req,
+             ulong        req_len,
+             ulong        cnt ) {
+  static char buf[ 1UL<<16 ];
+  FD_TEST( req_len*cnt<=sizeof(buf) );
+  for( ulong i=0UL; i<cnt; i++ ) fd_memcpy( buf+i*req_len, req, req_len );
+  FD_TEST( send( fd, buf, req_len*cnt, MSG_NOSIGNAL )==(long)(req_len*cnt) );
+}
+
+/* client_recv drives the server until cnt responses were received on
+   each of the fd_cnt clients in fds. */
+
+static void
+client_recv( int const * fds,
+             ulong       fd_cnt,
+             ulong       cnt ) {
+  static char  buf[ 1UL<<16 ];
+  static ulong recv_sz[ 1UL<<16 ];
+  ulong        response_sz = sizeof(expected_response)-1UL;
+  FD_TEST( response_sz*cnt<=sizeof(buf) && fd_cnt<=(1UL<<16) );
+
+  for( ulong i=0UL; i<fd_cnt; i++ ) recv_sz[ i ] = 0UL;
+  ulong rem = fd_cnt;
+  while( rem ) {
+    fd_http_server_poll( http, 0 );
+    for( ulong i=0UL; i<fd_cnt; i++ ) {
+      if( recv_sz[ i ]==response_sz*cnt ) continue;
+      long sz = recv( fds[ i ], buf+recv_sz[ i ], response_sz*cnt-recv_sz[ i ], MSG_DONTWAIT );
+      if( FD_UNLIKELY( -1==sz && errno==EAGAIN ) ) continue;
+      if( FD_UNLIKELY( sz<=0L ) ) FD_LOG_ERR(( "recv failed (%li, %i-%s)", sz, errno, fd_io_strerror( errno ) ));
+      recv_sz[ i ] += (ulong)sz;
+      if( FD_LIKELY( recv_sz[ i ]==response_sz*cnt ) ) {
+        for( ulong j=0UL; j<cnt; j++ ) FD_TEST( fd_memeq( buf+j*response_sz, expected_response, response_sz ) );
+        rem--;
+      }
+    }
+  }
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong conn_cnt     = fd_env_strip_cmdline_ulong( &argc, &argv, "--conn-cnt",     NULL, 10000UL );
+  ulong active_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--active-cnt",   NULL,    64UL );
+  ulong pipeline_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--pipeline-cnt", NULL,    16UL );
+  ulong round_cnt    = fd_env_strip_cmdline_ulong( &argc, &argv, "--round-cnt",    NULL,  1000UL );
+  ulong idle_cnt     = fd_env_strip_cmdline_ulong( &argc, &argv, "--idle-cnt",     NULL, 10000UL );
+
+  struct rlimit rlim;
+  FD_TEST( !getrlimit( RLIMIT_NOFILE, &rlim ) );
+  ulong conn_max = rlim.rlim_cur>64UL ? ((ulong)rlim.rlim_cur-64UL)/2UL : 1UL;
+  if( FD_UNLIKELY( conn_cnt>conn_max ) ) {
+    FD_LOG_WARNING(( "clamping --conn-cnt %lu to %lu for RLIMIT_NOFILE %lu", conn_cnt, conn_max, (ulong)rlim.rlim_cur ));
+    conn_cnt = conn_max;
+  }
+  conn_cnt     = fd_ulong_max( conn_cnt, 2UL );
+  active_cnt   = fd_ulong_min( fd_ulong_max( active_cnt, 1UL ), conn_cnt-1UL );
+  pipeline_cnt = fd_ulong_max( pipeline_cnt, 1UL );
+
+  fd_http_server_params_t params = {
+    .max_connection_cnt    = conn_cnt,
+    .max_ws_connection_cnt = 0UL,
+    .max_request_len       = 2048UL,
+    .max_ws_recv_frame_len = 2048UL,
+    .max_ws_send_frame_cnt = 1UL,
+    .outgoing_buffer_sz    = 1UL<<20,
+  };
+  fd_http_server_callbacks_t callbacks = {
+    .request = request,
+    .close   = http_close,
+  };
+
+  void * mem = aligned_alloc( fd_http_server_align(), fd_ulong_align_up( fd_http_server_footprint( params ), fd_http_server_align() ) );
+  FD_TEST( mem );
+  http = fd_http_server_join( fd_http_server_new( mem, params, callbacks, NULL ) );
+  FD_TEST( http );
+  FD_TEST( fd_http_server_listen( http, FD_IP4_ADDR( 127, 0, 0, 1 ), 0 ) );
+
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  FD_TEST( !getsockname( fd_http_server_fd( http ), fd_type_pun( &addr ), &addr_len ) );
+  ushort port = fd_ushort_bswap( addr.sin_port );
+
+  FD_LOG_NOTICE(( "Opening %lu connections", conn_cnt ));
+  int * fds = malloc( conn_cnt*sizeof(int) );
+  FD_TEST( fds );
+  for( ulong i=0UL; i<conn_cnt; i++ ) {
+    fds[ i ] = client_connect( port );
+    if( FD_UNLIKELY( !((i+1UL)%64UL) ) ) fd_http_server_poll( http, 0 ); /* Keep the listen backlog from filling */
+  }
+  while( fd_http_server_poll( http, 0 ) );
+
+  /* Pipelined keep-alive requests are answered in order on the same
+     connection, and an HTTP/1.0 request gets a Connection: close
+     response after which the server closes the connection. */
+
+  client_send( fds[ 0 ], request_keep_alive, sizeof(request_keep_alive)-1UL, 3UL );
+  client_recv( fds, 1UL, 3UL );
+
+  client_send( fds[ conn_cnt-1UL ], request_close, sizeof(request_close)-1UL, 1UL );
+  char close_buf[ 256 ] = {0};
+  ulong close_sz = 0UL;
+  for(;;) {
+    fd_http_server_poll( http, 0 );
+    long sz = recv( fds[ conn_cnt-1UL ], close_buf+close_sz, sizeof(close_buf)-1UL-close_sz, MSG_DONTWAIT );
+    if( -1==sz && errno==EAGAIN ) continue;
+    FD_TEST( sz>=0L );
+    if( !sz ) break;
+    close_sz += (ulong)sz;
+  }
+  FD_TEST( close_cnt==1UL );
+  FD_TEST( strstr( close_buf, "Connection: close\r\n" ) );
+  FD_TEST( !close( fds[ conn_cnt-1UL ] ) );
+
+  /* Idle poll cost */
+
+  long dt = -fd_log_wallclock();
+  ulong busy_cnt = 0UL;
+  for( ulong i=0UL; i<idle_cnt; i++ ) busy_cnt += (ulong)fd_http_server_poll( http, 0 );
+  dt += fd_log_wallclock();
+  FD_TEST( !busy_cnt );
+  FD_LOG_NOTICE(( "idle poll with %lu open connections: %.1f ns/poll", conn_cnt-1UL, (double)dt/(double)idle_cnt ));
+
+  /* Keep-alive pipelined throughput */
+
+  dt = -fd_log_wallclock();
+  for( ulong round=0UL; round<round_cnt; round++ ) {
+    for( ulong i=0UL; i<active_cnt; i++ ) client_send( fds[ i ], request_keep_alive, sizeof(request_keep_alive)-1UL, pipeline_cnt );
+    client_recv( fds, active_cnt, pipeline_cnt );
+  }
+  dt += fd_log_wallclock();
+  ulong req_cnt = round_cnt*active_cnt*pipeline_cnt;
+  FD_LOG_NOTICE(( "%lu keep-alive requests over %lu connections (%lu pipelined): %.3f Mreq/s, %.1f ns/req",
+                  req_cnt, active_cnt, pipeline_cnt, 1e3*(double)req_cnt/(double)dt, (double)dt/(double)req_cnt ));
+
+  for( ulong i=0UL; i<conn_cnt-1UL; i++ ) FD_TEST( !close( fds[ i ] ) );
+  free( fds );
+  fd_http_server_unlisten( http );
+  free( fd_http_server_delete( fd_http_server_leave( http ) ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -13,8 +13,10 @@
 #include <poll.h>
 #include <stdlib.h>
 #include <strings.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 
 #if FD_HAS_ZSTD
 #define FD_HTTP_ZSTD_COMPRESSION_LEVEL 3
@@ -58,6 +60,11 @@
 
 #define FD_HTTP_SERVER_DEBUG 0
 
+/* FD_HTTP_SERVER_EPOLL_EVENT_MAX is the max number of socket events
+   handled per fd_http_server_poll. */
+
+#define FD_HTTP_SERVER_EPOLL_EVENT_MAX (256UL)
+
 FD_FN_CONST char const *
 fd_http_server_connection_close_reason_str( int reason ) {
   switch( reason ) {
@@ -84,6 +91,7 @@ fd_http_server_connection_close_reason_str( int reason ) {
     case FD_HTTP_SERVER_CONNECTION_CLOSE_WS_EXPECTED_TEXT_OPCODE:      return "WS_EXPECTED_TEXT_OPCODE-Expected text opcode in websocket frame";
     case FD_HTTP_SERVER_CONNECTION_CLOSE_WS_CONTROL_FRAME_TOO_LARGE:   return "WS_CONTROL_FRAME_TOO_LARGE-Websocket control frame was too large";
     case FD_HTTP_SERVER_CONNECTION_CLOSE_WS_CHANGED_OPCODE:            return "FD_HTTP_SERVER_CONNECTION_CLOSE_WS_CHANGED_OPCODE-Websocket frame type changed unexpectedly";
+    case FD_HTTP_SERVER_CONNECTION_CLOSE_IDLE_TIMEOUT:                 return "FD_HTTP_SERVER_CONNECTION_CLOSE_IDLE_TIMEOUT-Connection was idle for too long";
     default: break;
   }
 
@@ -116,6 +124,7 @@ fd_http_server_footprint( fd_http_server_params_t params ) {
   l = FD_LAYOUT_APPEND( l, conn_treap_align(),                        conn_treap_footprint( params.max_connection_cnt )                                                  );
   l = FD_LAYOUT_APPEND( l, ws_conn_treap_align(),                     ws_conn_treap_footprint( params.max_ws_connection_cnt )                                            );
   l = FD_LAYOUT_APPEND( l, alignof( struct pollfd ),                  (params.max_connection_cnt+params.max_ws_connection_cnt+1UL)*sizeof( struct pollfd )               );
+  l = FD_LAYOUT_APPEND( l, alignof( uint ),                           2UL*(params.max_connection_cnt+params.max_ws_connection_cnt)*sizeof( uint )                        );
   l = FD_LAYOUT_APPEND( l, 1UL,                                       params.max_request_len*params.max_connection_cnt                                                   );
   l = FD_LAYOUT_APPEND( l, 1UL,                                       params.max_ws_recv_frame_len*params.max_ws_connection_cnt                                          );
   l = FD_LAYOUT_APPEND( l, alignof( struct fd_http_server_ws_frame ), params.max_ws_send_frame_cnt*params.max_ws_connection_cnt*sizeof( struct fd_http_server_ws_frame ) );
@@ -153,6 +162,7 @@ fd_http_server_new( void *                     shmem,
   http->conn_treap        = FD_SCRATCH_ALLOC_APPEND( l,  conn_treap_align(),                           conn_treap_footprint( params.max_connection_cnt )                                    );
   http->ws_conn_treap     = FD_SCRATCH_ALLOC_APPEND( l,  ws_conn_treap_align(),                        ws_conn_treap_footprint( params.max_ws_connection_cnt )                              );
   http->pollfds           = FD_SCRATCH_ALLOC_APPEND( l,  alignof(struct pollfd),                       (params.max_connection_cnt+params.max_ws_connection_cnt+1UL)*sizeof( struct pollfd ) );
+  http->write_pending     = FD_SCRATCH_ALLOC_APPEND( l,  alignof(uint),                                2UL*(params.max_connection_cnt+params.max_ws_connection_cnt)*sizeof( uint )          );
   char * _request_bytes   = FD_SCRATCH_ALLOC_APPEND( l,  1UL,                                          params.max_request_len*params.max_connection_cnt                                     );
   uchar * _ws_recv_bytes  = FD_SCRATCH_ALLOC_APPEND( l,  1UL,                                          params.max_ws_recv_frame_len*params.max_ws_connection_cnt                            );
   struct fd_http_server_ws_frame * _ws_send_frames = FD_SCRATCH_ALLOC_APPEND( l, alignof(struct fd_http_server_ws_frame), params.max_ws_send_frame_cnt*params.max_ws_connection_cnt*sizeof(struct fd_http_server_ws_frame) );
@@ -160,6 +170,8 @@ fd_http_server_new( void *                     shmem,
 #if FD_HAS_ZSTD
   uchar * _zstd_ctx       = FD_SCRATCH_ALLOC_APPEND( l,  16UL,                                         ZSTD_estimateCCtxSize( FD_HTTP_ZSTD_COMPRESSION_LEVEL )                              );
 #endif
+  http->socket_fd      = -1;
+  http->epoll_fd       = -1;
   http->oring_sz       = params.outgoing_buffer_sz;
   http->stage_err      = 0;
   http->stage_off      = 0UL;
@@ -170,12 +182,16 @@ fd_http_server_new( void *                     shmem,
   http->callback_ctx          = callback_ctx;
   http->evict_conn_id         = 0UL;
   http->evict_ws_conn_id      = 0UL;
+  http->idle_timeout          = (long)params.idle_timeout_ms*1000L*1000L;
+  http->idle_sweep_next       = 0L;
   http->max_conns             = params.max_connection_cnt;
   http->max_ws_conns          = params.max_ws_connection_cnt;
   http->max_request_len       = params.max_request_len;
   http->max_ws_recv_frame_len = params.max_ws_recv_frame_len;
   http->max_ws_send_frame_cnt = params.max_ws_send_frame_cnt;
   http->compress_websocket    = params.compress_websocket;
+  http->write_pending_cnt     = 0UL;
+  http->write_blocked         = 0;
 
 #if FD_HAS_ZSTD
   http->zstd_ctx = ZSTD_initStaticCCtx( _zstd_ctx, ZSTD_estimateCCtxSize( FD_HTTP_ZSTD_COMPRESSION_LEVEL ) );
@@ -195,7 +211,7 @@ fd_http_server_new( void *                     shmem,
 
   for( ulong i=0UL; i<params.max_connection_cnt; i++ ) {
     http->pollfds[ i ].fd = -1;
-    http->pollfds[ i ].events = POLLIN | POLLOUT;
+    http->pollfds[ i ].events = 0;
     http->conns[ i ] = (struct fd_http_server_connection){
       .request_bytes = _request_bytes+i*params.max_request_len,
       .parent = http->conns[ i ].parent,
@@ -204,7 +220,7 @@ fd_http_server_new( void *                     shmem,
 
   for( ulong i=0UL; i<params.max_ws_connection_cnt; i++ ) {
     http->pollfds[ params.max_connection_cnt+i ].fd = -1;
-    http->pollfds[ params.max_connection_cnt+i ].events = POLLIN | POLLOUT;
+    http->pollfds[ params.max_connection_cnt+i ].events = 0;
     http->ws_conns[ i ] = (struct fd_http_server_ws_connection){
       .recv_bytes = _ws_recv_bytes+i*params.max_ws_recv_frame_len,
       .send_frames = _ws_send_frames+i*params.max_ws_send_frame_cnt,
@@ -213,7 +229,7 @@ fd_http_server_new( void *                     shmem,
   }
 
   http->pollfds[ params.max_connection_cnt+params.max_ws_connection_cnt ].fd     = -1;
-  http->pollfds[ params.max_connection_cnt+params.max_ws_connection_cnt ].events = POLLIN | POLLOUT;
+  http->pollfds[ params.max_connection_cnt+params.max_ws_connection_cnt ].events = 0;
 
   FD_COMPILER_MFENCE();
   FD_VOLATILE( http->magic ) = FD_HTTP_SERVER_MAGIC;
@@ -288,6 +304,51 @@ fd_http_server_fd( fd_http_server_t * http ) {
   return http->socket_fd;
 }
 
+int
+fd_http_server_epoll_fd( fd_http_server_t * http ) {
+  return http->epoll_fd;
+}
+
+/* The server waits for socket events with a level triggered epoll(7)
+   instance, so the work done by fd_http_server_poll scales with the
+   number of active connections rather than with the number of open
+   ones.  Sockets are registered for EPOLLIN, except HTTP connections
+   that are blocked writing a response (so that pipelined requests stay
+   queued in the kernel meanwhile), and are only registered for EPOLLOUT
+   while a send would block.  Output that becomes ready to send is put
+   on the write_pending list instead, and is sent on the next poll
+   without any epoll_ctl(2) in the common case where the socket buffer
+   has room. */
+
+static void
+epoll_update( fd_http_server_t * http,
+              ulong              conn_idx,
+              int                op,
+              short              events ) {
+  struct epoll_event event = { .events = (uint)(ushort)events, .data.u64 = conn_idx };
+  if( FD_UNLIKELY( -1==epoll_ctl( http->epoll_fd, op, http->pollfds[ conn_idx ].fd, &event ) ) )
+    FD_LOG_ERR(( "epoll_ctl failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  http->pollfds[ conn_idx ].events = events;
+}
+
+static inline void
+set_events( fd_http_server_t * http,
+            ulong              conn_idx,
+            short              events ) {
+  if( FD_LIKELY( http->pollfds[ conn_idx ].events==events ) ) return;
+  epoll_update( http, conn_idx, EPOLL_CTL_MOD, events );
+}
+
+static void
+write_pending_push( fd_http_server_t * http,
+                    ulong              conn_idx ) {
+  int * write_pending = conn_idx<http->max_conns ? &http->conns[ conn_idx ].write_pending :
+                                                   &http->ws_conns[ conn_idx-http->max_conns ].write_pending;
+  if( FD_LIKELY( *write_pending ) ) return;
+  *write_pending = 1;
+  http->write_pending[ http->write_pending_cnt++ ] = (uint)conn_idx;
+}
+
 fd_http_server_t *
 fd_http_server_listen( fd_http_server_t * http,
                        uint               address,
@@ -299,6 +360,13 @@ fd_http_server_listen( fd_http_server_t * http,
   if( FD_UNLIKELY( -1==setsockopt( sockfd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof( optval ) ) ) )
     FD_LOG_ERR(( "setsockopt failed (%i-%s)", errno, strerror( errno ) ));
 
+  /* Responses on persistent connections are written as a header and a
+     body send, so Nagle's algorithm would hold back the body until the
+     client's delayed ACK of the header.  Accepted sockets inherit the
+     option from the listening socket. */
+  if( FD_UNLIKELY( -1==setsockopt( sockfd, IPPROTO_TCP, TCP_NODELAY, &optval, sizeof( optval ) ) ) )
+    FD_LOG_ERR(( "setsockopt failed (%i-%s)", errno, strerror( errno ) ));
+
   struct sockaddr_in addr = {
     .sin_family      = AF_INET,
     .sin_port        = fd_ushort_bswap( port ),
@@ -312,8 +380,13 @@ fd_http_server_listen( fd_http_server_t * http,
   }
   if( FD_UNLIKELY( -1==listen( sockfd, (int)http->max_conns ) ) ) FD_LOG_ERR(( "listen failed (%i-%s)", errno, fd_io_strerror( errno ) ));
 
+  int epollfd = epoll_create1( EPOLL_CLOEXEC );
+  if( FD_UNLIKELY( -1==epollfd ) ) FD_LOG_ERR(( "epoll_create1 failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+
   http->socket_fd = sockfd;
+  http->epoll_fd  = epollfd;
   http->pollfds[ http->max_conns+http->max_ws_conns ].fd = http->socket_fd;
+  epoll_update( http, http->max_conns+http->max_ws_conns, EPOLL_CTL_ADD, EPOLLIN );
 
   return http;
 }
@@ -364,6 +437,27 @@ fd_http_server_ws_close( fd_http_server_t * http,
   close_conn( http, http->max_conns+ws_conn_id, reason );
 }
 
+void
+fd_http_server_unlisten( fd_http_server_t * http ) {
+  if( FD_UNLIKELY( -1==http->socket_fd ) ) return;
+
+  for( ulong conn_idx=0UL; conn_idx<http->max_conns+http->max_ws_conns; conn_idx++ ) {
+    if( FD_LIKELY( -1!=http->pollfds[ conn_idx ].fd ) ) close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_OK );
+  }
+  for( ulong i=0UL; i<http->write_pending_cnt; i++ ) {
+    ulong conn_idx = http->write_pending[ i ];
+    if( FD_LIKELY( conn_idx<http->max_conns ) ) http->conns[ conn_idx ].write_pending = 0;
+    else                                        http->ws_conns[ conn_idx-http->max_conns ].write_pending = 0;
+  }
+  http->write_pending_cnt = 0UL;
+
+  if( FD_UNLIKELY( -1==close( http->socket_fd ) ) ) FD_LOG_ERR(( "close failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  if( FD_UNLIKELY( -1==close( http->epoll_fd  ) ) ) FD_LOG_ERR(( "close failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  http->socket_fd = -1;
+  http->epoll_fd  = -1;
+  http->pollfds[ http->max_conns+http->max_ws_conns ].fd = -1;
+}
+
 /* These are the expected network errors which just mean the connection
    should be closed.  Any errors from an accept(2), read(2), or send(2)
    that are not expected here will be considered fatal and terminate the
@@ -404,18 +498,35 @@ accept_conns( fd_http_server_t * http ) {
         ulong conn_id = conn_treap_fwd_iter_idx( it );
         close_conn( http, conn_id, FD_HTTP_SERVER_CONNECTION_CLOSE_EVICTED );
       } else {
-        /* If nobody is slow to read, just evict round robin */
-        close_conn( http, http->evict_conn_id, FD_HTTP_SERVER_CONNECTION_CLOSE_EVICTED );
-        http->evict_conn_id = (http->evict_conn_id+1UL) % http->max_conns;
+        /* If nobody is slow to read, evict the connection that has
+           been waiting for a request the longest, as an idle
+           keep-alive connection is the cheapest one to lose.  If
+           every connection is writing a static body, evict round
+           robin. */
+        ulong idle_id = ULONG_MAX;
+        for( ulong i=0UL; i<http->max_conns; i++ ) {
+          if( FD_UNLIKELY( http->conns[ i ].state!=FD_HTTP_SERVER_CONNECTION_STATE_READING ) ) continue;
+          if( idle_id==ULONG_MAX || http->conns[ i ].last_active<http->conns[ idle_id ].last_active ) idle_id = i;
+        }
+        if( FD_LIKELY( idle_id!=ULONG_MAX ) ) {
+          close_conn( http, idle_id, FD_HTTP_SERVER_CONNECTION_CLOSE_EVICTED );
+        } else {
+          close_conn( http, http->evict_conn_id, FD_HTTP_SERVER_CONNECTION_CLOSE_EVICTED );
+          http->evict_conn_id = (http->evict_conn_id+1UL) % http->max_conns;
+        }
       }
     }
 
     ulong conn_id = conn_pool_idx_acquire( http->conns );
 
     http->pollfds[ conn_id ].fd = fd;
+    epoll_update( http, conn_id, EPOLL_CTL_ADD, EPOLLIN );
     http->conns[ conn_id ].state                  = FD_HTTP_SERVER_CONNECTION_STATE_READING;
+    http->conns[ conn_id ].keep_alive             = 0;
+    http->conns[ conn_id ].request_bytes_len      = 0UL;
     http->conns[ conn_id ].request_bytes_read     = 0UL;
     http->conns[ conn_id ].response_bytes_written = 0UL;
+    http->conns[ conn_id ].last_active            = fd_log_wallclock();
 
     if( FD_UNLIKELY( http->callbacks.open ) ) {
       http->callbacks.open( conn_id, fd, http->callback_ctx );
@@ -427,31 +538,18 @@ accept_conns( fd_http_server_t * http ) {
   }
 }
 
+/* parse_conn_http parses the request bytes read so far on HTTP
+   connection conn_idx, and if they hold a complete request, dispatches
+   it to the request callback and queues the response to be written.
+   last_len is the number of request bytes that were already parsed
+   (unsuccessfully) before. */
+
 static void
-read_conn_http( fd_http_server_t * http,
-                ulong              conn_idx ) {
+parse_conn_http( fd_http_server_t * http,
+                 ulong              conn_idx,
+                 ulong              last_len ) {
   struct fd_http_server_connection * conn = &http->conns[ conn_idx ];
 
-  if( FD_UNLIKELY( conn->state!=FD_HTTP_SERVER_CONNECTION_STATE_READING ) ) {
-    close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_EXPECTED_EOF );
-    return;
-  }
-
-  long sz = read( http->pollfds[ conn_idx ].fd, conn->request_bytes+conn->request_bytes_read, http->max_request_len-conn->request_bytes_read );
-  if( FD_UNLIKELY( -1==sz && errno==EAGAIN ) ) return; /* No data to read, continue. */
-  else if( FD_UNLIKELY( !sz || (-1==sz && is_expected_network_error( errno ) ) ) ) {
-    close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_PEER_RESET );
-    return;
-  }
-  else if( FD_UNLIKELY( -1==sz ) ) FD_LOG_ERR(( "read failed (%i-%s)", errno, strerror( errno ) )); /* Unexpected programmer error, abort */
-
-  /* New data was read... process it */
-  conn->request_bytes_read += (ulong)sz;
-  if( FD_UNLIKELY( conn->request_bytes_read==http->max_request_len ) ) {
-    close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_LARGE_REQUEST );
-    return;
-  }
-
   char const * method;
   ulong method_len;
   char const * path;
@@ -465,7 +563,7 @@ read_conn_http( fd_http_server_t * http,
                                   &path, &path_len,
                                   &minor_version,
                                   headers, &num_headers,
-                                  conn->request_bytes_read - (ulong)sz );
+                                  last_len );
   if( FD_UNLIKELY( -2==result ) ) return; /* Request still partial, wait for more data */
   else if( FD_UNLIKELY( -1==result ) ) {
     close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_BAD_REQUEST );
@@ -566,10 +664,24 @@ read_conn_http( fd_http_server_t * http,
     }
   }
 
+  /* HTTP/1.1 connections are persistent unless the client asks to
+     close them, HTTP/1.0 ones only if the client asks to keep them. */
+  conn->keep_alive = minor_version==1;
+  for( ulong i=0UL; i<num_headers; i++ ) {
+    if( FD_LIKELY( headers[ i ].name_len==10UL && !strncasecmp( headers[ i ].name, "Connection", 10UL ) ) ) {
+      if(      headers[ i ].value_len==5UL  && !strncasecmp( headers[ i ].value, "close",      5UL  ) ) conn->keep_alive = 0;
+      else if( headers[ i ].value_len==10UL && !strncasecmp( headers[ i ].value, "keep-alive", 10UL ) ) conn->keep_alive = 1;
+      break;
+    }
+  }
+
+  /* Any bytes past the request are the start of the next (pipelined)
+     request, or of the first WebSocket frame after an upgrade. */
+  conn->request_bytes_len = (ulong)result+content_len;
+
   conn->upgrade_websocket = 0;
   int compress_websocket = 0;
   if( FD_UNLIKELY( upgrade_key && !strncmp( upgrade_key, "websocket", 9UL ) ) ) {
-    conn->request_bytes_len = (ulong)result;
     conn->upgrade_websocket = 1;
 
 #if FD_HAS_ZSTD
@@ -651,6 +763,39 @@ read_conn_http( fd_http_server_t * http,
 #endif
 
   if( FD_LIKELY( !conn->response.static_body ) ) conn_treap_ele_insert( http->conn_treap, conn, http->conns );
+  write_pending_push( http, conn_idx );
+}
+
+static void
+read_conn_http( fd_http_server_t * http,
+                ulong              conn_idx ) {
+  struct fd_http_server_connection * conn = &http->conns[ conn_idx ];
+
+  /* A pipelined request arrived before the response to the previous one
+     was written, leave it queued in the socket until then. */
+  if( FD_UNLIKELY( conn->state!=FD_HTTP_SERVER_CONNECTION_STATE_READING ) ) return;
+
+  long sz = read( http->pollfds[ conn_idx ].fd, conn->request_bytes+conn->request_bytes_read, http->max_request_len-conn->request_bytes_read );
+  if( FD_UNLIKELY( -1==sz && errno==EAGAIN ) ) return; /* No data to read, continue. */
+  else if( FD_UNLIKELY( !sz && !conn->request_bytes_read && conn->keep_alive ) ) {
+    close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_EXPECTED_EOF ); /* Client closed a persistent connection between requests */
+    return;
+  }
+  else if( FD_UNLIKELY( !sz || (-1==sz && is_expected_network_error( errno ) ) ) ) {
+    close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_PEER_RESET );
+    return;
+  }
+  else if( FD_UNLIKELY( -1==sz ) ) FD_LOG_ERR(( "read failed (%i-%s)", errno, strerror( errno ) )); /* Unexpected programmer error, abort */
+
+  /* New data was read... process it */
+  conn->request_bytes_read += (ulong)sz;
+  conn->last_active         = fd_log_wallclock();
+  if( FD_UNLIKELY( conn->request_bytes_read==http->max_request_len ) ) {
+    close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_LARGE_REQUEST );
+    return;
+  }
+
+  parse_conn_http( http, conn_idx, conn->request_bytes_read-(ulong)sz );
 }
 
 static void
@@ -741,6 +886,7 @@ again:
       conn->pong_data_len = payload_len;
       FD_TEST( payload_len<=125UL );
       memcpy( conn->pong_data, conn->recv_bytes+conn->recv_bytes_parsed, payload_len );
+      write_pending_push( http, conn_idx );
     }
     if( FD_UNLIKELY( conn->recv_bytes_read-frame_len ) ) {
       memmove( conn->recv_bytes, conn->recv_bytes+conn->recv_bytes_parsed+frame_len, conn->recv_bytes_read-frame_len );
@@ -844,7 +990,7 @@ write_conn_http( fd_http_server_t * http,
             FD_TEST( fd_cstr_printf_check( header_buf, sizeof( header_buf ), &response_len, "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: %.*s\r\n", (int)encoded_len, sec_websocket_accept_base64 ) );
           } else {
             ulong body_len = conn->response.static_body ? conn->response.static_body_len : conn->response._body_len;
-            FD_TEST( fd_cstr_printf_check( header_buf, sizeof( header_buf ), &response_len, "HTTP/1.1 200 OK\r\nContent-Length: %lu\r\nConnection: close\r\n", body_len ) );
+            FD_TEST( fd_cstr_printf_check( header_buf, sizeof( header_buf ), &response_len, "HTTP/1.1 200 OK\r\nContent-Length: %lu\r\n", body_len ) );
           }
           break;
         case 204: {
@@ -871,6 +1017,12 @@ write_conn_http( fd_http_server_t * http,
           break;
       }
 
+      if( FD_LIKELY( !conn->keep_alive && !conn->response.upgrade_websocket ) ) {
+        ulong connection_len;
+        FD_TEST( fd_cstr_printf_check( header_buf+response_len, sizeof( header_buf )-response_len, &connection_len, "Connection: close\r\n" ) );
+        response_len += connection_len;
+      }
+
       if( FD_LIKELY( conn->response.compress_websocket ) ) {
         ulong compress_websocket_len;
         FD_TEST( fd_cstr_printf_check( header_buf+response_len, sizeof( header_buf )-response_len, &compress_websocket_len, "Sec-WebSocket-Protocol: compress-zstd\r\n" ) );
@@ -929,8 +1081,16 @@ write_conn_http( fd_http_server_t * http,
       FD_LOG_ERR(( "invalid server state (%d)", conn->state ));
   }
 
-  long sz = send( http->pollfds[ conn_idx ].fd, response+conn->response_bytes_written, response_len-conn->response_bytes_written, MSG_NOSIGNAL );
-  if( FD_UNLIKELY( -1==sz && errno==EAGAIN ) ) return; /* No data was written, continue. */
+  /* Let the kernel coalesce the header with the body that follows. */
+  int flags = MSG_NOSIGNAL;
+  if( FD_LIKELY( conn->state==FD_HTTP_SERVER_CONNECTION_STATE_WRITING_HEADER && !conn->response.upgrade_websocket &&
+                 (conn->response.static_body ? conn->response.static_body_len : conn->response._body_len) ) ) flags |= MSG_MORE;
+
+  long sz = send( http->pollfds[ conn_idx ].fd, response+conn->response_bytes_written, response_len-conn->response_bytes_written, flags );
+  if( FD_UNLIKELY( -1==sz && errno==EAGAIN ) ) { /* No data was written, continue. */
+    http->write_blocked = 1;
+    return;
+  }
   if( FD_UNLIKELY( -1==sz && is_expected_network_error( errno ) ) ) {
     close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_PEER_RESET );
     return;
@@ -967,6 +1127,7 @@ write_conn_http( fd_http_server_t * http,
 
           ulong ws_conn_id = ws_conn_pool_idx_acquire( http->ws_conns );
           http->pollfds[ http->max_conns+ws_conn_id ].fd = fd;
+          epoll_update( http, http->max_conns+ws_conn_id, EPOLL_CTL_MOD, EPOLLIN );
 
           http->ws_conns[ ws_conn_id ].pong_state               = FD_HTTP_SERVER_PONG_STATE_NONE;
           http->ws_conns[ ws_conn_id ].send_frame_cnt           = 0UL;
@@ -997,9 +1158,26 @@ write_conn_http( fd_http_server_t * http,
           conn->response_bytes_written = 0UL;
         }
         break;
-      case FD_HTTP_SERVER_CONNECTION_STATE_WRITING_BODY:
-        close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_OK );
+      case FD_HTTP_SERVER_CONNECTION_STATE_WRITING_BODY: {
+        if( FD_UNLIKELY( !conn->keep_alive ) ) {
+          close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_OK );
+          break;
+        }
+
+        /* Persistent connection, start reading the next request, which
+           might already be (partially) buffered if it was pipelined. */
+        if( FD_LIKELY( !conn->response.static_body ) ) conn_treap_ele_remove( http->conn_treap, conn, http->conns );
+        FD_TEST( conn->request_bytes_read>=conn->request_bytes_len );
+        ulong pipelined_len = conn->request_bytes_read-conn->request_bytes_len;
+        if( FD_UNLIKELY( pipelined_len ) ) memmove( conn->request_bytes, conn->request_bytes+conn->request_bytes_len, pipelined_len );
+        conn->state                  = FD_HTTP_SERVER_CONNECTION_STATE_READING;
+        conn->request_bytes_read     = pipelined_len;
+        conn->request_bytes_len      = 0UL;
+        conn->response_bytes_written = 0UL;
+        conn->last_active            = fd_log_wallclock();
+        if( FD_UNLIKELY( pipelined_len ) ) parse_conn_http( http, conn_idx, 0UL );
         break;
+      }
     }
   }
 }
@@ -1028,7 +1206,10 @@ maybe_write_pong( fd_http_server_t * http,
   fd_memcpy( frame+2UL, conn->pong_data, conn->pong_data_len );
 
   long sz = send( http->pollfds[ conn_idx ].fd, frame+conn->pong_bytes_written, 2UL+conn->pong_data_len-conn->pong_bytes_written, MSG_NOSIGNAL );
-  if( FD_UNLIKELY( -1==sz && errno==EAGAIN ) ) return 1; /* No data was written, continue. */
+  if( FD_UNLIKELY( -1==sz && errno==EAGAIN ) ) { /* No data was written, continue. */
+    http->write_blocked = 1;
+    return 1;
+  }
   else if( FD_UNLIKELY( -1==sz && is_expected_network_error( errno ) ) ) {
     close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_PEER_RESET );
     return 1;
@@ -1080,7 +1261,10 @@ write_conn_ws( fd_http_server_t * http,
       }
 
       long sz = send( http->pollfds[ conn_idx ].fd, header+conn->send_frame_bytes_written, header_len-conn->send_frame_bytes_written, MSG_NOSIGNAL );
-      if( FD_UNLIKELY( -1==sz && errno==EAGAIN ) ) return; /* No data was written, continue. */
+      if( FD_UNLIKELY( -1==sz && errno==EAGAIN ) ) { /* No data was written, continue. */
+        http->write_blocked = 1;
+        return;
+      }
       else if( FD_UNLIKELY( -1==sz && is_expected_network_error( errno ) ) ) {
         close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_PEER_RESET );
         return;
@@ -1100,7 +1284,10 @@ write_conn_ws( fd_http_server_t * http,
       ulong data_sz = frame->len-conn->send_frame_bytes_written;
 
       long sz = send( http->pollfds[ conn_idx ].fd, data, data_sz, MSG_NOSIGNAL );
-      if( FD_UNLIKELY( -1==sz && errno==EAGAIN ) ) return; /* No data was written, continue. */
+      if( FD_UNLIKELY( -1==sz && errno==EAGAIN ) ) { /* No data was written, continue. */
+        http->write_blocked = 1;
+        return;
+      }
       else if( FD_UNLIKELY( -1==sz && is_expected_network_error( errno ) ) ) {
         close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_PEER_RESET );
         return;
@@ -1122,35 +1309,104 @@ write_conn_ws( fd_http_server_t * http,
   }
 }
 
+static inline int
+conn_has_output( fd_http_server_t * http,
+                 ulong              conn_idx ) {
+  if( FD_LIKELY( conn_idx<http->max_conns ) ) {
+    int state = http->conns[ conn_idx ].state;
+    return state==FD_HTTP_SERVER_CONNECTION_STATE_WRITING_HEADER || state==FD_HTTP_SERVER_CONNECTION_STATE_WRITING_BODY;
+  } else {
+    struct fd_http_server_ws_connection * conn = &http->ws_conns[ conn_idx-http->max_conns ];
+    return conn->pong_state!=FD_HTTP_SERVER_PONG_STATE_NONE || conn->send_frame_cnt;
+  }
+}
+
+/* write_conn writes as much of the pending output of the connection as
+   the socket accepts, and then updates its epoll registration so that
+   it is only woken up for EPOLLOUT if the socket buffer filled up. */
+
 static void
 write_conn( fd_http_server_t * http,
             ulong              conn_idx ) {
-  if( FD_LIKELY( conn_idx<http->max_conns ) ) write_conn_http( http, conn_idx );
-  else                                        write_conn_ws(   http, conn_idx );
+  http->write_blocked = 0;
+  while( FD_LIKELY( http->pollfds[ conn_idx ].fd!=-1 && conn_has_output( http, conn_idx ) && !http->write_blocked ) ) {
+    if( FD_LIKELY( conn_idx<http->max_conns ) ) write_conn_http( http, conn_idx );
+    else                                        write_conn_ws(   http, conn_idx );
+  }
+
+  /* The connection might have been closed, or upgraded to a WebSocket
+     connection which was registered by the upgrade. */
+  if( FD_UNLIKELY( http->pollfds[ conn_idx ].fd==-1 ) ) return;
+
+  short events = EPOLLIN;
+  if( FD_UNLIKELY( conn_has_output( http, conn_idx ) ) ) events = (short)( conn_idx<http->max_conns ? EPOLLOUT : (EPOLLIN|EPOLLOUT) );
+  set_events( http, conn_idx, events );
+}
+
+/* close_idle closes the HTTP connections that have been waiting for a
+   request for longer than the idle timeout.  Connections are only
+   looked for every eighth of the timeout, so a connection is closed
+   at most 1.125 timeouts after it went idle (if the server is polled). */
+
+static void
+close_idle( fd_http_server_t * http ) {
+  long now = fd_log_wallclock();
+  if( FD_LIKELY( now<http->idle_sweep_next ) ) return;
+  http->idle_sweep_next = now+fd_long_max( http->idle_timeout/8L, 1L );
+
+  for( ulong conn_idx=0UL; conn_idx<http->max_conns; conn_idx++ ) {
+    struct fd_http_server_connection const * conn = &http->conns[ conn_idx ];
+    if( FD_LIKELY( -1==http->pollfds[ conn_idx ].fd || conn->state!=FD_HTTP_SERVER_CONNECTION_STATE_READING ) ) continue;
+    if( FD_UNLIKELY( now-conn->last_active>=http->idle_timeout ) ) close_conn( http, conn_idx, FD_HTTP_SERVER_CONNECTION_CLOSE_IDLE_TIMEOUT );
+  }
 }
 
 int
 fd_http_server_poll( fd_http_server_t * http,
                      int                poll_timeout ) {
-  int nfds = fd_syscall_poll( http->pollfds, (uint)( http->max_conns+http->max_ws_conns+1UL ), poll_timeout );
-  if( FD_UNLIKELY( 0==nfds ) ) return 0;
-  else if( FD_UNLIKELY( -1==nfds && errno==EINTR ) ) return 0;
-  else if( FD_UNLIKELY( -1==nfds ) ) FD_LOG_ERR(( "poll failed (%i-%s)", errno, strerror( errno ) ));
-
-  /* Poll existing connections for new data. */
-  for( ulong i=0UL; i<http->max_conns+http->max_ws_conns+1UL; i++ ) {
-    if( FD_UNLIKELY( -1==http->pollfds[ i ].fd ) ) continue;
-    if( FD_UNLIKELY( i==http->max_conns+http->max_ws_conns ) ) {
+  /* Don't sleep if there is output waiting to be written. */
+  if( FD_UNLIKELY( http->write_pending_cnt ) ) poll_timeout = 0;
+
+  struct epoll_event events[ FD_HTTP_SERVER_EPOLL_EVENT_MAX ];
+  int nfds = epoll_pwait( http->epoll_fd, events, (int)FD_HTTP_SERVER_EPOLL_EVENT_MAX, poll_timeout, NULL );
+  if( FD_UNLIKELY( -1==nfds && errno==EINTR ) ) nfds = 0;
+  else if( FD_UNLIKELY( -1==nfds ) ) FD_LOG_ERR(( "epoll_pwait failed (%i-%s)", errno, strerror( errno ) ));
+
+  ulong listen_idx = http->max_conns+http->max_ws_conns;
+  for( ulong i=0UL; i<(ulong)nfds; i++ ) {
+    ulong conn_idx = events[ i ].data.u64;
+    uint  revents  = events[ i ].events;
+    if( FD_UNLIKELY( conn_idx==listen_idx ) ) {
       accept_conns( http );
-    } else {
-      if( FD_LIKELY( http->pollfds[ i ].revents & POLLIN  ) ) read_conn(  http, i );
-      if( FD_UNLIKELY( -1==http->pollfds[ i ].fd ) ) continue;
-      if( FD_LIKELY( http->pollfds[ i ].revents & POLLOUT ) ) write_conn( http, i );
-      /* No need to handle POLLHUP, read() will return 0 soon enough. */
+      continue;
     }
+
+    /* The connection might have been closed (and the slot even reused)
+       while handling an earlier event of this batch, in which case the
+       registered events tell what the slot is waiting on now. */
+    if( FD_UNLIKELY( -1==http->pollfds[ conn_idx ].fd ) ) continue;
+    if( FD_LIKELY( (revents & (EPOLLIN|EPOLLERR|EPOLLHUP)) && (http->pollfds[ conn_idx ].events & EPOLLIN) ) ) read_conn( http, conn_idx );
+    if( FD_UNLIKELY( -1==http->pollfds[ conn_idx ].fd ) ) continue;
+    if( FD_UNLIKELY( (revents & (EPOLLOUT|EPOLLERR|EPOLLHUP)) && (http->pollfds[ conn_idx ].events & EPOLLOUT) ) ) write_conn( http, conn_idx );
   }
 
-  return 1;
+  /* Write output that was staged since the last poll.  Connections
+     pushed while draining (e.g. a pipelined request answered
+     synchronously) are left for the next poll. */
+  ulong pending_cnt = http->write_pending_cnt;
+  for( ulong i=0UL; i<pending_cnt; i++ ) {
+    ulong conn_idx = http->write_pending[ i ];
+    if( FD_LIKELY( conn_idx<http->max_conns ) ) http->conns[ conn_idx ].write_pending = 0;
+    else                                        http->ws_conns[ conn_idx-http->max_conns ].write_pending = 0;
+    if( FD_UNLIKELY( -1==http->pollfds[ conn_idx ].fd ) ) continue;
+    write_conn( http, conn_idx );
+  }
+  http->write_pending_cnt -= pending_cnt;
+  if( FD_UNLIKELY( http->write_pending_cnt ) ) memmove( http->write_pending, http->write_pending+pending_cnt, http->write_pending_cnt*sizeof(uint) );
+
+  if( FD_UNLIKELY( http->idle_timeout ) ) close_idle( http );
+
+  return nfds>0 || pending_cnt>0UL;
 }
 
 static void
@@ -1296,6 +1552,7 @@ fd_http_server_ws_send( fd_http_server_t * http,
   if( FD_LIKELY( conn->send_frame_cnt==1UL ) ) {
     ws_conn_treap_ele_insert( http->ws_conn_treap, conn, http->ws_conns );
   }
+  write_pending_push( http, http->max_conns+ws_conn_id );
 
   http->stage_off += http->stage_len+http->stage_comp_len;
   http->stage_len = 0;
@@ -1304,6 +1561,37 @@ fd_http_server_ws_send( fd_http_server_t * http,
   return 0;
 }
 
+/* ws_enqueue queues the staged frame for sending on WebSocket
+   connection ws_conn_id.  compressed indicates whether the staging
+   buffer holds a compressed copy of the frame (see
+   fd_http_ws_compress_maybe), which is sent instead if the connection
+   negotiated compression. */
+
+static void
+ws_enqueue( fd_http_server_t * http,
+            ulong              ws_conn_id,
+            int                compressed ) {
+  struct fd_http_server_ws_connection * conn = &http->ws_conns[ ws_conn_id ];
+  if( FD_UNLIKELY( conn->send_frame_cnt==http->max_ws_send_frame_cnt ) ) {
+    close_conn( http, ws_conn_id+http->max_conns, FD_HTTP_SERVER_CONNECTION_CLOSE_WS_CLIENT_TOO_SLOW );
+    return;
+  }
+
+  fd_http_server_ws_frame_t frame = {
+    .off = fd_ulong_if(conn->compress_websocket && compressed, http->stage_off+http->stage_len, http->stage_off),
+    .len = fd_ulong_if(conn->compress_websocket && compressed, http->stage_comp_len, http->stage_len),
+    .compressed = conn->compress_websocket && compressed,
+  };
+
+  conn->send_frames[ (conn->send_frame_idx+conn->send_frame_cnt) % http->max_ws_send_frame_cnt ] = frame;
+  conn->send_frame_cnt++;
+
+  if( FD_LIKELY( conn->send_frame_cnt==1UL ) ) {
+    ws_conn_treap_ele_insert( http->ws_conn_treap, conn, http->ws_conns );
+  }
+  write_pending_push( http, http->max_conns+ws_conn_id );
+}
+
 int
 fd_http_server_ws_broadcast( fd_http_server_t * http ) {
   int compressed = fd_http_ws_compress_maybe( http );
@@ -1317,27 +1605,41 @@ fd_http_server_ws_broadcast( fd_http_server_t * http ) {
 
   for( ulong i=0UL; i<http->max_ws_conns; i++ ) {
     if( FD_LIKELY( http->pollfds[ http->max_conns+i ].fd==-1 ) ) continue;
+    ws_enqueue( http, i, compressed );
+  }
 
-    struct fd_http_server_ws_connection * conn = &http->ws_conns[ i ];
-    if( FD_UNLIKELY( conn->send_frame_cnt==http->max_ws_send_frame_cnt ) ) {
-      close_conn( http, i+http->max_conns, FD_HTTP_SERVER_CONNECTION_CLOSE_WS_CLIENT_TOO_SLOW );
-      continue;
-    }
-
-    fd_http_server_ws_frame_t frame = {
-      .off = fd_ulong_if(conn->compress_websocket && compressed, http->stage_off+http->stage_len, http->stage_off),
-      .len = fd_ulong_if(conn->compress_websocket && compressed, http->stage_comp_len, http->stage_len),
-      .compressed = conn->compress_websocket && compressed,
-    };
+  http->stage_off += http->stage_len+http->stage_comp_len;
+  http->stage_len = 0;
+  http->stage_comp_len = 0;
 
-    conn->send_frames[ (conn->send_frame_idx+conn->send_frame_cnt) % http->max_ws_send_frame_cnt ] = frame;
-    conn->send_frame_cnt++;
+  return 0;
+}
 
-    if( FD_LIKELY( conn->send_frame_cnt==1UL ) ) {
-      ws_conn_treap_ele_insert( http->ws_conn_treap, conn, http->ws_conns );
+int
+fd_http_server_ws_multicast( fd_http_server_t * http,
+                             ulong const *      ws_conn_ids,
+                             ulong              ws_conn_cnt ) {
+  /* Only compress if some recipient can take it */
+  int compressed = 0;
+  for( ulong i=0UL; i<ws_conn_cnt; i++ ) {
+    if( FD_UNLIKELY( http->ws_conns[ ws_conn_ids[ i ] ].compress_websocket ) ) {
+      compressed = fd_http_ws_compress_maybe( http );
+      break;
     }
   }
 
+  if( FD_UNLIKELY( http->stage_err ) ) {
+    http->stage_err = 0;
+    http->stage_len = 0;
+    http->stage_comp_len = 0;
+    return -1;
+  }
+
+  for( ulong i=0UL; i<ws_conn_cnt; i++ ) {
+    if( FD_UNLIKELY( http->pollfds[ http->max_conns+ws_conn_ids[ i ] ].fd==-1 ) ) continue;
+    ws_enqueue( http, ws_conn_ids[ i ], compressed );
+  }
+
   http->stage_off += http->stage_len+http->stage_comp_len;
   http->stage_len = 0;
   http->stage_comp_len = 0;
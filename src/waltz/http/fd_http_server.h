@@ -61,6 +61,7 @@
 #define FD_HTTP_SERVER_CONNECTION_CLOSE_WS_EXPECTED_TEXT_OPCODE      (-21)
 #define FD_HTTP_SERVER_CONNECTION_CLOSE_WS_CONTROL_FRAME_TOO_LARGE   (-22)
 #define FD_HTTP_SERVER_CONNECTION_CLOSE_WS_CHANGED_OPCODE            (-23)
+#define FD_HTTP_SERVER_CONNECTION_CLOSE_IDLE_TIMEOUT                (-24)
 
 /* Given a FD_HTTP_SERVER_CONNECTION_CLOSE_* reason code, a reason that
    a HTTP connection a client was closed, produce a human readable
@@ -78,13 +79,14 @@ fd_http_server_method_str( uchar method );
 /* Parameters needed for constructing an HTTP server.  */
 
 struct fd_http_server_params {
-  ulong max_connection_cnt;    /* Maximum number of concurrent HTTP/1.1 connections open.  Connections are not persistent and will be closed after one request is served */
+  ulong max_connection_cnt;    /* Maximum number of concurrent HTTP/1.1 connections open.  HTTP/1.1 connections are persistent (and may pipeline requests) unless the client sends Connection: close, HTTP/1.0 connections are closed after one request unless the client sends Connection: keep-alive */
   ulong max_ws_connection_cnt; /* Maximum number of concurrent websocket connections open */
   ulong max_request_len;       /* Maximum total length of an HTTP request, including the terminating \r\n\r\n and any body in the case of a POST */
   ulong max_ws_recv_frame_len; /* Maximum size of an incoming websocket frame from the client.  Must be >= max_request_len */
   ulong max_ws_send_frame_cnt; /* Maximum number of outgoing websocket frames that can be queued before the client is disconnected */
   ulong outgoing_buffer_sz;    /* Size of the outgoing data ring, which is used to stage outgoing HTTP response bodies and WebSocket frames */
   int   compress_websocket;    /* True if large websocket messages are compressed and sent as binary websocket frames */
+  ulong idle_timeout_ms;       /* HTTP connections that have waited this many milliseconds for a request are closed, or 0 to keep them open until evicted */
 };
 
 typedef struct fd_http_server_params fd_http_server_params_t;
@@ -254,8 +256,8 @@ FD_PROTOTYPES_BEGIN
 
    fd_http_server_delete unformats a memory region that holds a http
    server state.  Assumes shhttp points on the caller to the first
-   byte of the memory region holding the state and that nobody is
-   joined.  Returns a pointer to the memory region on success and NULL
+   byte of the memory region holding the state, that nobody is joined,
+   and that the server is not listening (see fd_http_server_unlisten).  Returns a pointer to the memory region on success and NULL
    on failure (logs details).  The caller has ownership of the memory
    region on successful return. */
 
@@ -287,11 +289,28 @@ fd_http_server_delete( void * shhttp );
 int
 fd_http_server_fd( fd_http_server_t * http );
 
+/* fd_http_server_epoll_fd returns the epoll(7) file descriptor the
+   server waits on for socket events, or -1 if the server is not
+   listening yet.  It is created by fd_http_server_listen, and needs to
+   be allowed through sandboxes along with fd_http_server_fd. */
+
+int
+fd_http_server_epoll_fd( fd_http_server_t * http );
+
 fd_http_server_t *
 fd_http_server_listen( fd_http_server_t * http,
                        uint               address,
                        ushort             port );
 
+/* fd_http_server_unlisten closes all open connections (invoking the
+   close and ws_close callbacks with FD_HTTP_SERVER_CONNECTION_CLOSE_OK),
+   then the listening socket and the epoll file descriptor.  Afterwards
+   the server can listen again or be deleted.  Does nothing if the
+   server is not listening. */
+
+void
+fd_http_server_unlisten( fd_http_server_t * http );
+
 /* Close an active connection.  The connection ID must be an open
    open connection in [0, max_connection_cnt).  The connection will
    be forcibly (ungracefully) terminated.  The connection ID is released
@@ -425,10 +444,31 @@ fd_http_server_ws_send( fd_http_server_t * http,
 int
 fd_http_server_ws_broadcast( fd_http_server_t * http );
 
+/* Send the contents of the staging buffer as a WebSocket message to the
+   ws_conn_cnt clients in ws_conn_ids, which must be connection IDs in
+   [0, max_ws_connection_cnt).  Connections that are not open are
+   skipped.  The message is staged and (if any recipient negotiated
+   compression) compressed once, however many recipients there are.
+   The staging buffer is then cleared.  Returns -1 on failure if the
+   ring buffer is an error state, and then clears the error state.
+
+   As with fd_http_server_ws_broadcast, recipients that read too slowly
+   are force disconnected. */
+
+int
+fd_http_server_ws_multicast( fd_http_server_t * http,
+                             ulong const *      ws_conn_ids,
+                             ulong              ws_conn_cnt );
+
 /* fd_http_server_poll needs to be continuously called in a spin loop to
-   drive the HTTP server forward.  Setting poll_timeout==0 makes it a
-   non-blocking socket ppoll(2).   Returns 1 if there was any work to do
-   on the HTTP server, or 0 otherwise. */
+   drive the HTTP server forward.  It waits up to poll_timeout
+   milliseconds for socket events with epoll_pwait(2), handles them, and
+   writes out any responses or WebSocket frames staged since the last
+   call.  Setting poll_timeout==0 makes it non-blocking, and it does not
+   block either while staged output is waiting to be written.  The cost
+   of a call scales with the number of connections that are active,
+   not with the number that are open.  Returns 1 if there was any work
+   to do on the HTTP server, or 0 otherwise. */
 
 int
 fd_http_server_poll( fd_http_server_t * http,
@@ -23,26 +23,30 @@
 
 struct fd_http_server_connection {
   int          state;
+  int          keep_alive;    /* 1 if the connection stays open after the current response */
+  int          write_pending; /* 1 if the connection is on the write_pending list */
 
   int          upgrade_websocket;
   int          compress_websocket;
+
+  /* The treap fields, placed here to fill the padding after the ints */
+  ushort left;
+  ushort right;
+  ushort parent;
+  ushort prio;
+  ushort prev;
+  ushort next;
+
   ulong        request_bytes_len;
   char const * sec_websocket_key;
 
   char * request_bytes;
   ulong  request_bytes_read;
+  long   last_active;   /* fd_log_wallclock() of the last request bytes read, or of going back to reading */
 
   fd_http_server_response_t response;
   ulong response_bytes_written;
 
-  /* The treap fields */
-  ushort left;
-  ushort right;
-  ushort parent;
-  ushort prio;
-  ushort prev;
-  ushort next;
-
   /* The memory for the request is placed at the end of the struct here...
   char request[ ]; */
 };
@@ -74,6 +78,7 @@ struct fd_http_server_ws_connection {
   fd_http_server_ws_frame_t * send_frames;
 
   int compress_websocket;
+  int write_pending; /* 1 if the connection is on the write_pending list */
 
   /* The treap fields */
   ushort left;
@@ -93,6 +98,7 @@ struct fd_http_server_hcache_private {
 struct __attribute__((aligned(FD_HTTP_SERVER_ALIGN))) fd_http_server_private {
 
   int   socket_fd;
+  int   epoll_fd;
 
   uchar * oring;
   ulong   oring_sz;
@@ -133,6 +139,9 @@ struct __attribute__((aligned(FD_HTTP_SERVER_ALIGN))) fd_http_server_private {
   ulong evict_conn_id;
   ulong evict_ws_conn_id;
 
+  long idle_timeout;    /* In nanoseconds, 0 if connections never time out */
+  long idle_sweep_next; /* fd_log_wallclock() when idle connections are next looked for */
+
   void * callback_ctx;
   fd_http_server_callbacks_t callbacks;
 
@@ -141,8 +150,23 @@ struct __attribute__((aligned(FD_HTTP_SERVER_ALIGN))) fd_http_server_private {
 
   struct fd_http_server_connection *    conns;
   struct fd_http_server_ws_connection * ws_conns;
+
+  /* pollfds[ i ].fd is the socket of connection i (HTTP connections
+     first, then WebSocket connections, then the listen socket), or -1
+     if the connection is not open.  pollfds[ i ].events is the epoll
+     event mask the socket is currently registered for with epoll_fd
+     (EPOLLIN and EPOLLOUT have the same values as POLLIN and POLLOUT). */
   struct pollfd *                       pollfds;
 
+  /* Connections with output ready to send, which is sent on the next
+     fd_http_server_poll without waiting for EPOLLOUT.  A connection is
+     on the list at most once while its write_pending flag is set, but
+     may be pushed again while the list is being drained, hence the list
+     has room for twice the number of connections. */
+  uint *                                write_pending;
+  ulong                                 write_pending_cnt;
+  int                                   write_blocked; /* 1 if the last send of a write step would have blocked */
+
   void * conn_treap;
   void * ws_conn_treap;
 
@@ -151,7 +175,8 @@ struct __attribute__((aligned(FD_HTTP_SERVER_ALIGN))) fd_http_server_private {
 
   struct fd_http_server_connection    conns[ ];
   struct fd_http_server_ws_connection ws_conns[ ];
-  struct pollfd                       pollfds[ ]; */
+  struct pollfd                       pollfds[ ];
+  uint                                write_pending[ ]; */
 };
 
 #endif /* HEADER_fd_src_waltz_http_fd_http_server_private_h */
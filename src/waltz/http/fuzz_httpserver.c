@@ -349,11 +349,7 @@ void close_reset_clients_fd(fd_http_server_t * http) {
   }
   clients_fd_cnt = 0;
 
-  for (ulong conn_idx = 0; conn_idx < (PARAMS.max_connection_cnt + PARAMS.max_ws_connection_cnt); ++conn_idx) {
-    if (http->pollfds[ conn_idx ].fd != -1) {
-        close(http->pollfds[ conn_idx ].fd);
-    }
-  }
+  fd_http_server_unlisten(http);
 }
 
 int *reserve_client_fd(void) {
@@ -694,7 +690,6 @@ LLVMFuzzerTestOneInput( uchar const * data,
     pthread_join(thread, NULL);
 
     close_reset_clients_fd(http_server);
-    close(fd_http_server_fd(http_server));
     fd_http_server_delete(fd_http_server_leave(http_server));
     free( shmem );
   }
@@ -1,6 +1,15 @@
 #include "fd_http_server.h"
 #include "fd_http_server_private.h"
 #include "../../util/fd_util.h"
+#include "../../util/net/fd_ip4.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
 
 void
 test_oring( void ) {
@@ -21,8 +30,8 @@ test_oring( void ) {
     .ws_message = NULL,
   };
 
-  uchar scratch[ 1632896 ] __attribute__((aligned(128UL)));
-  FD_TEST( fd_http_server_footprint( params )==1632896 );
+  uchar scratch[ 1633152 ] __attribute__((aligned(128UL)));
+  FD_TEST( fd_http_server_footprint( params )==1633152 );
   fd_http_server_t * http = fd_http_server_join( fd_http_server_new( scratch, params, callbacks, NULL ) );
 
   http->stage_off = 6UL;
@@ -82,12 +91,142 @@ test_oring( void ) {
   FD_TEST( http->stage_comp_len==0UL );
 }
 
+static ulong open_cnt;
+static ulong close_cnt;
+static ulong close_conn_id;
+static int   close_reason;
+
+static void
+test_open_cb( ulong  conn_id,
+              int    sockfd,
+              void * ctx ) {
+  (void)conn_id; (void)sockfd; (void)ctx;
+  open_cnt++;
+}
+
+static void
+test_close_cb( ulong  conn_id,
+               int    reason,
+               void * ctx ) {
+  (void)ctx;
+  close_cnt++;
+  close_conn_id = conn_id;
+  close_reason  = reason;
+}
+
+/* client_connect connects to the server on loopback and polls it until
+   it has accepted the connection. */
+
+static int
+client_connect( fd_http_server_t * http ) {
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  FD_TEST( !getsockname( fd_http_server_fd( http ), fd_type_pun( &addr ), &addr_len ) );
+
+  int fd = socket( AF_INET, SOCK_STREAM|SOCK_CLOEXEC, 0 );
+  FD_TEST( fd>=0 );
+  FD_TEST( !connect( fd, fd_type_pun( &addr ), sizeof(addr) ) );
+  ulong cnt = open_cnt;
+  while( open_cnt==cnt ) fd_http_server_poll( http, 1 );
+  return fd;
+}
+
+void
+test_listen( void ) {
+  fd_http_server_params_t params = {
+    .max_connection_cnt    = 2UL,
+    .max_ws_connection_cnt = 0UL,
+    .max_request_len       = 1024UL,
+    .max_ws_recv_frame_len = 1024UL,
+    .max_ws_send_frame_cnt = 1UL,
+    .outgoing_buffer_sz    = 4096UL,
+    .idle_timeout_ms       = 0UL,
+  };
+
+  fd_http_server_callbacks_t callbacks = {
+    .open  = test_open_cb,
+    .close = test_close_cb,
+  };
+
+  void * mem = aligned_alloc( fd_http_server_align(), fd_ulong_align_up( fd_http_server_footprint( params ), fd_http_server_align() ) );
+  FD_TEST( mem );
+  fd_http_server_t * http = fd_http_server_join( fd_http_server_new( mem, params, callbacks, NULL ) );
+  FD_TEST( http );
+  FD_TEST( fd_http_server_epoll_fd( http )==-1 );
+  fd_http_server_unlisten( http ); /* Not listening, no-op */
+
+  /* Unlisten closes the listening socket and the epoll fd, so
+     listening over and over does not run out of file descriptors. */
+
+  for( ulong i=0UL; i<4096UL; i++ ) {
+    FD_TEST( fd_http_server_listen( http, FD_IP4_ADDR( 127, 0, 0, 1 ), 0 ) );
+    int sock_fd  = fd_http_server_fd( http );
+    int epoll_fd = fd_http_server_epoll_fd( http );
+    FD_TEST( epoll_fd>=0 );
+    fd_http_server_unlisten( http );
+    FD_TEST( fd_http_server_fd( http )==-1 && fd_http_server_epoll_fd( http )==-1 );
+    FD_TEST( -1==fcntl( sock_fd,  F_GETFD ) && errno==EBADF );
+    FD_TEST( -1==fcntl( epoll_fd, F_GETFD ) && errno==EBADF );
+  }
+
+  /* With a full connection table, the connection that has waited for
+     a request the longest is evicted. */
+
+  FD_TEST( fd_http_server_listen( http, FD_IP4_ADDR( 127, 0, 0, 1 ), 0 ) );
+  int a = client_connect( http );
+  int b = client_connect( http );
+  FD_TEST( send( a, "GET", 3UL, MSG_NOSIGNAL )==3L );
+  while( !http->conns[ 0 ].request_bytes_read ) fd_http_server_poll( http, 1 );
+  FD_TEST( http->conns[ 0 ].last_active>=http->conns[ 1 ].last_active );
+
+  close_cnt = 0UL;
+  int c = client_connect( http );
+  FD_TEST( close_cnt==1UL && close_conn_id==1UL && close_reason==FD_HTTP_SERVER_CONNECTION_CLOSE_EVICTED );
+
+  /* Unlisten closes the open connections */
+
+  fd_http_server_unlisten( http );
+  FD_TEST( close_cnt==3UL && close_reason==FD_HTTP_SERVER_CONNECTION_CLOSE_OK );
+  FD_TEST( http->pollfds[ 0 ].fd==-1 && http->pollfds[ 1 ].fd==-1 );
+  FD_TEST( !close( a ) && !close( b ) && !close( c ) );
+
+  free( fd_http_server_delete( fd_http_server_leave( http ) ) );
+
+  /* Connections that have not sent anything for the idle timeout are
+     closed. */
+
+  params.idle_timeout_ms = 20UL;
+  mem = aligned_alloc( fd_http_server_align(), fd_ulong_align_up( fd_http_server_footprint( params ), fd_http_server_align() ) );
+  FD_TEST( mem );
+  http = fd_http_server_join( fd_http_server_new( mem, params, callbacks, NULL ) );
+  FD_TEST( http );
+  FD_TEST( fd_http_server_listen( http, FD_IP4_ADDR( 127, 0, 0, 1 ), 0 ) );
+
+  close_cnt = 0UL;
+  long start = fd_log_wallclock();
+  a = client_connect( http );
+  while( !close_cnt ) {
+    fd_http_server_poll( http, 1 );
+    FD_TEST( fd_log_wallclock()-start<10L*1000L*1000L*1000L );
+  }
+  FD_TEST( close_conn_id==0UL && close_reason==FD_HTTP_SERVER_CONNECTION_CLOSE_IDLE_TIMEOUT );
+  FD_TEST( fd_log_wallclock()-start>=20L*1000L*1000L );
+
+  char buf[ 1 ];
+  FD_TEST( !recv( a, buf, sizeof(buf), 0 ) );
+  FD_TEST( !close( a ) );
+
+  fd_http_server_unlisten( http );
+  free( fd_http_server_delete( fd_http_server_leave( http ) ) );
+}
+
 int
 main( int     argc,
       char ** argv ) {
   fd_boot( &argc, &argv );
 
   test_oring();
+  test_listen();
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
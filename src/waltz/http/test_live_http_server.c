@@ -158,6 +158,7 @@ main( int     argc,
     }
   }
 
+  fd_http_server_unlisten( state.http );
   free( fd_http_server_delete( fd_http_server_leave( state.http ) ) );
 
   FD_LOG_NOTICE(( "pass" ));